@@ -0,0 +1,49 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <time.h>
+#include "fsl_common.h"
+#include "fsl_debug_console.h"
+#include "board.h"
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/* Initialize debug console: the standard input and output of the process. */
+void BOARD_InitDebugConsole(void)
+{
+    status_t result = DbgConsole_Init();
+
+    assert(result == kStatus_Success);
+    (void)result;
+}
+
+static uint64_t s_runTimeStart;
+
+static uint64_t BOARD_GetMonotonicUs(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000U + (uint64_t)now.tv_nsec / 1000U;
+}
+
+/* Start the run time counter of FreeRTOS: the monotonic clock, in
+ * micro-seconds since the start of the scheduler. */
+void BOARD_InitRunTimeCounter(void)
+{
+    s_runTimeStart = BOARD_GetMonotonicUs();
+}
+
+/* Get the run time counter, called by the kernel at every context switch,
+ * from the tick signal handler too: clock_gettime() is async-signal-safe. */
+uint32_t BOARD_GetRunTimeCounter(void)
+{
+    return (uint32_t)(BOARD_GetMonotonicUs() - s_runTimeStart);
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _BOARD_H_
+#define _BOARD_H_
+
+#include <stdint.h>
+
+/*
+ * The "board" of the host (Linux) build: the interrupts are the simulated
+ * interrupts of the FreeRTOS POSIX port, numbered from 2 (0 and 1 are the
+ * yield and the tick of the port).
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief The board name */
+#define BOARD_NAME "LINUX_HOST"
+
+/*! @brief Debug console receive interrupt. */
+#define BOARD_DEBUG_CONSOLE_IRQ 2U
+/*! @brief SDIO card interrupt of the simulated wifi card. */
+#define BOARD_SDIO_CARD_IRQ 3U
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+void BOARD_InitDebugConsole(void);
+
+/* Run time counter of FreeRTOS, see FreeRTOSConfig.h */
+void BOARD_InitRunTimeCounter(void);
+uint32_t BOARD_GetRunTimeCounter(void);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* _BOARD_H_ */
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FSL_COMMON_H_
+#define _FSL_COMMON_H_
+
+/*
+ * Host (Linux) stand-in for the SDK fsl_common.h: only what the middleware
+ * built for the host uses. There is no device header: __CORTEX_M is not
+ * defined, which is what the host code paths of the middleware test.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*! @brief Construct a status code value from a group and code number. */
+#define MAKE_STATUS(group, code) ((((group)*100) + (code)))
+
+/*! @brief Status group numbers. */
+enum _status_groups
+{
+    kStatusGroup_Generic = 0, /*!< Group number for generic status codes. */
+};
+
+/*! @brief Generic status return codes. */
+enum
+{
+    kStatus_Success         = MAKE_STATUS(kStatusGroup_Generic, 0),
+    kStatus_Fail            = MAKE_STATUS(kStatusGroup_Generic, 1),
+    kStatus_ReadOnly        = MAKE_STATUS(kStatusGroup_Generic, 2),
+    kStatus_OutOfRange      = MAKE_STATUS(kStatusGroup_Generic, 3),
+    kStatus_InvalidArgument = MAKE_STATUS(kStatusGroup_Generic, 4),
+    kStatus_Timeout         = MAKE_STATUS(kStatusGroup_Generic, 5),
+    kStatus_NoTransferInProgress = MAKE_STATUS(kStatusGroup_Generic, 6),
+};
+
+/*! @brief Type used for all status and error return values. */
+typedef int32_t status_t;
+
+/*! @brief Macro to define a variable with alignbytes alignment */
+#define SDK_ALIGN(var, alignbytes) var __attribute__((aligned(alignbytes)))
+
+/*! @brief Macro to get the size of a variable rounded up to alignbytes */
+#define SDK_SIZEALIGN(var, alignbytes) \
+    ((unsigned int)((var) + ((alignbytes)-1U)) & (unsigned int)(~(unsigned int)((alignbytes)-1U)))
+
+#ifndef ARRAY_SIZE
+#define ARRAY_SIZE(x) (sizeof(x) / sizeof((x)[0]))
+#endif
+
+#ifndef MIN
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+
+#ifndef MAX
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+
+/*! @brief CMSIS core: the active exception, here non zero in the simulated
+ *  interrupts of the FreeRTOS POSIX port. */
+static inline uint32_t __get_IPSR(void)
+{
+    extern long xPortIsInsideInterrupt(void);
+
+    return (uint32_t)xPortIsInsideInterrupt();
+}
+
+#endif /* _FSL_COMMON_H_ */
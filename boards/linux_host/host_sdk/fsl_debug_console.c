@@ -0,0 +1,181 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "board.h"
+#include "fsl_debug_console.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Characters buffered between the input thread and the receive interrupt, and
+ * between the receive interrupt and the reading task. */
+#define DEBUG_CONSOLE_RX_RING_SIZE  256U
+#define DEBUG_CONSOLE_RX_QUEUE_SIZE 256U
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static pthread_mutex_t s_outputLock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Written by the input thread only. */
+static volatile uint32_t s_rxRingHead;
+/* Written by the receive interrupt only. */
+static volatile uint32_t s_rxRingTail;
+static int16_t s_rxRing[DEBUG_CONSOLE_RX_RING_SIZE];
+
+static QueueHandle_t s_rxQueue;
+
+static struct termios s_savedTermios;
+static bool s_termiosSaved;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+int DbgConsole_Printf(const char *formatString, ...)
+{
+    va_list ap;
+    int ret;
+    UBaseType_t mask;
+
+    /* A task switched out while holding the stdio lock would block the
+     * next task that prints: the output is not interrupted. */
+    mask = taskENTER_CRITICAL_FROM_ISR();
+    pthread_mutex_lock(&s_outputLock);
+
+    va_start(ap, formatString);
+    ret = vprintf(formatString, ap);
+    va_end(ap);
+    fflush(stdout);
+
+    pthread_mutex_unlock(&s_outputLock);
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+
+    return ret;
+}
+
+int DbgConsole_Putchar(int ch)
+{
+    return DbgConsole_Printf("%c", ch);
+}
+
+int DbgConsole_Getchar(void)
+{
+    int16_t ch;
+
+    /* Polled, as a UART in polling mode: the CLI reads the console from the
+     * idle task, which must not block. Between two polls the thread sleeps,
+     * as the core would wait for an interrupt. */
+    while (xQueueReceive(s_rxQueue, &ch, 0) != pdTRUE)
+    {
+        (void)usleep(1000U);
+    }
+
+    return ch;
+}
+
+static uint32_t DbgConsole_RxIRQHandler(void)
+{
+    BaseType_t woken = pdFALSE;
+    uint32_t tail    = s_rxRingTail;
+
+    while (tail != __atomic_load_n(&s_rxRingHead, __ATOMIC_ACQUIRE))
+    {
+        if (xQueueSendFromISR(s_rxQueue, &s_rxRing[tail % DEBUG_CONSOLE_RX_RING_SIZE], &woken) != pdTRUE)
+        {
+            /* The task reads slower than the input comes: keep the rest in
+             * the ring, the input thread raises the interrupt again. */
+            break;
+        }
+        tail++;
+    }
+    __atomic_store_n(&s_rxRingTail, tail, __ATOMIC_RELEASE);
+
+    return (uint32_t)woken;
+}
+
+static void DbgConsole_RxPut(int16_t ch)
+{
+    /* Wait for room, as a UART with hardware flow control. */
+    while ((s_rxRingHead - __atomic_load_n(&s_rxRingTail, __ATOMIC_ACQUIRE)) >= DEBUG_CONSOLE_RX_RING_SIZE)
+    {
+        vPortGenerateSimulatedInterrupt(BOARD_DEBUG_CONSOLE_IRQ);
+        usleep(1000);
+    }
+
+    s_rxRing[s_rxRingHead % DEBUG_CONSOLE_RX_RING_SIZE] = ch;
+    __atomic_store_n(&s_rxRingHead, s_rxRingHead + 1U, __ATOMIC_RELEASE);
+    vPortGenerateSimulatedInterrupt(BOARD_DEBUG_CONSOLE_IRQ);
+}
+
+static void *DbgConsole_InputThread(void *arg)
+{
+    unsigned char ch;
+
+    (void)arg;
+
+    while (read(STDIN_FILENO, &ch, 1) == 1)
+    {
+        /* The console of the target sends CR at the end of a line. */
+        DbgConsole_RxPut((ch == '\n') ? (int16_t)'\r' : (int16_t)ch);
+    }
+
+    /* At the end of the input the line just stays idle, as a disconnected
+     * UART: a script ends the application with a command. */
+    return NULL;
+}
+
+static void DbgConsole_RestoreTerminal(void)
+{
+    if (s_termiosSaved)
+    {
+        (void)tcsetattr(STDIN_FILENO, TCSANOW, &s_savedTermios);
+    }
+}
+
+status_t DbgConsole_Init(void)
+{
+    struct termios raw;
+
+    s_rxQueue = xQueueCreate(DEBUG_CONSOLE_RX_QUEUE_SIZE, sizeof(int16_t));
+    if (s_rxQueue == NULL)
+    {
+        return kStatus_Fail;
+    }
+
+    /* The CLI echoes the characters and handles the line editing itself, as
+     * on a UART: character mode without echo. Ctrl-C still ends the process. */
+    if (isatty(STDIN_FILENO) && (tcgetattr(STDIN_FILENO, &s_savedTermios) == 0))
+    {
+        s_termiosSaved = true;
+        atexit(DbgConsole_RestoreTerminal);
+        raw = s_savedTermios;
+        raw.c_lflag &= ~(tcflag_t)(ICANON | ECHO);
+        raw.c_cc[VMIN]  = 1;
+        raw.c_cc[VTIME] = 0;
+        (void)tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+    }
+
+    vPortSetInterruptHandler(BOARD_DEBUG_CONSOLE_IRQ, DbgConsole_RxIRQHandler);
+
+    if (xPortCreateSimulatedDeviceThread(DbgConsole_InputThread, NULL) != pdPASS)
+    {
+        return kStatus_Fail;
+    }
+
+    return kStatus_Success;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FSL_DEBUGCONSOLE_H_
+#define _FSL_DEBUGCONSOLE_H_
+
+/*
+ * Host (Linux) stand-in for the SDK debug console: the console is the
+ * standard input and output of the process.
+ *
+ * The output of tasks, interrupts and simulated devices is serialized. The
+ * input is read by a thread outside FreeRTOS, as a UART receives characters,
+ * so that a task waiting for a character blocks in FreeRTOS, not in read().
+ */
+
+#include "fsl_common.h"
+
+#define PRINTF  DbgConsole_Printf
+#define PUTCHAR DbgConsole_Putchar
+#define GETCHAR DbgConsole_Getchar
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Start reading the standard input. Call before the scheduler starts.
+ *
+ * @return kStatus_Success, or kStatus_Fail if the input thread can't be created.
+ */
+status_t DbgConsole_Init(void);
+
+/*!
+ * @brief Writes formatted output to the standard output.
+ *
+ * @return Returns the number of characters printed, or a negative value if an error occurs.
+ */
+int DbgConsole_Printf(const char *formatString, ...) __attribute__((format(printf, 1, 2)));
+
+/*!
+ * @brief Writes a character to the standard output.
+ *
+ * @return Returns the character written, or a negative value if an error occurs.
+ */
+int DbgConsole_Putchar(int ch);
+
+/*!
+ * @brief Reads a character from the standard input, polling until there is one.
+ *
+ * As with a UART in polling mode, this does not block in FreeRTOS, and can be called from the idle task.
+ *
+ * @return Returns the character read. At the end of the input, it polls forever.
+ */
+int DbgConsole_Getchar(void);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* _FSL_DEBUGCONSOLE_H_ */
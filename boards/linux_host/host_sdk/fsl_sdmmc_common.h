@@ -0,0 +1,21 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FSL_SDMMC_COMMON_H_
+#define _FSL_SDMMC_COMMON_H_
+
+/*
+ * Host (Linux) stand-in for the SDMMC middleware: there is no SDIO host
+ * controller, the card is simulated by the wifi middleware (wifidriver/sim).
+ */
+
+#include "fsl_common.h"
+
+/*! @brief Default block size */
+#define FSL_SDMMC_DEFAULT_BLOCK_SIZE (512U)
+
+#endif /* _FSL_SDMMC_COMMON_H_ */
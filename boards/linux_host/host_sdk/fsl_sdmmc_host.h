@@ -0,0 +1,17 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FSL_SDMMC_HOST_H_
+#define _FSL_SDMMC_HOST_H_
+
+/*
+ * Host (Linux) stand-in for the SDMMC host layer: see fsl_sdmmc_common.h.
+ */
+
+#include "fsl_sdmmc_common.h"
+
+#endif /* _FSL_SDMMC_HOST_H_ */
@@ -0,0 +1,86 @@
+/*
+FreeRTOS Kernel V10.3.0
+Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ http://aws.amazon.com/freertos
+ http://www.FreeRTOS.org
+*/
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+ * Application specific definitions.
+ *
+ * These definitions should be adjusted for your particular hardware and
+ * application requirements.
+ *
+ * THESE PARAMETERS ARE DESCRIBED WITHIN THE 'CONFIGURATION' SECTION OF THE
+ * FreeRTOS API DOCUMENTATION AVAILABLE ON THE FreeRTOS.org WEB SITE.
+ *
+ * See http://www.freertos.org/a00110.html.
+ *----------------------------------------------------------*/
+
+/*
+ * Host (Linux) heap replay: only the heap (heap_x.c) is built, against the
+ * FreeRTOS POSIX port headers, and the scheduler does not run. The heap scheme,
+ * its size and the bins of heap_6.c are set by CMakeLists.txt.
+ */
+
+#define configUSE_PREEMPTION                    1
+#define configUSE_IDLE_HOOK                     0
+#define configUSE_TICK_HOOK                     0
+#define configCPU_CLOCK_HZ                      (1000000UL)
+#define configTICK_RATE_HZ                      ((TickType_t)1000)
+#define configMAX_PRIORITIES                    5
+#define configMINIMAL_STACK_SIZE                ((unsigned short)128)
+#define configMAX_TASK_NAME_LEN                 10
+#define configUSE_16_BIT_TICKS                  0
+
+/* Used memory allocation (heap_x.c) */
+#define configFRTOS_MEMORY_SCHEME HEAP_REPLAY_SCHEME
+
+/* Memory allocation related definitions. */
+#define configSUPPORT_STATIC_ALLOCATION  0
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#define configTOTAL_HEAP_SIZE            ((size_t)(HEAP_REPLAY_SIZE))
+#define configAPPLICATION_ALLOCATED_HEAP 0
+#define configUSE_MALLOC_FAILED_HOOK     0
+
+/* heap_6.c: the tags of the trace are kept, up to 16 */
+#define configHEAP_BIN_MAX_SIZE HEAP_REPLAY_BIN_MAX_SIZE
+#define configHEAP_TAG_COUNT    16
+
+/* Report the failed assertion and abort */
+void vAssertCalled(const char *file, unsigned long line);
+#define configASSERT(x)                          \
+    if ((x) == 0)                                \
+    {                                            \
+        vAssertCalled(__FILE__, __LINE__);       \
+    }
+
+#define INCLUDE_vTaskPrioritySet  0
+#define INCLUDE_uxTaskPriorityGet 0
+#define INCLUDE_vTaskDelete       0
+#define INCLUDE_vTaskSuspend      0
+#define INCLUDE_vTaskDelayUntil   0
+#define INCLUDE_vTaskDelay        0
+
+#endif /* FREERTOS_CONFIG_H */
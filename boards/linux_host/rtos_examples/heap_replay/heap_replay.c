@@ -0,0 +1,330 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/* heap_replay: replays a heap trace, recorded on the target with the os-trace
+ * CLI command and written by middleware/wifi/scripts/os_trace_convert.py
+ * --heap, against the FreeRTOS heap scheme the program is built with:
+ * heap_replay_4 with heap_4.c, heap_replay_6 with heap_6.c. It reports the
+ * time of the allocations and of the frees, the failed allocations, and the
+ * fragmentation of the heap when its free space is the lowest.
+ *
+ * The scheduler does not run: vTaskSuspendAll(), xTaskResumeAll() and the
+ * critical sections are empty, the times are those of the allocator alone. */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define REPLAY_PASSES 100
+
+/* An operation of the trace */
+typedef struct _replay_op
+{
+    char kind; /* 'a' allocate, 'f' free */
+    uint8_t tag;
+    uint32_t block;
+    uint32_t size;
+} replay_op_t;
+
+/* Times of the allocations or of the frees, in nanoseconds */
+typedef struct _replay_times
+{
+    uint32_t *ns;
+    size_t count;
+} replay_times_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static replay_op_t *s_ops;
+static size_t s_opCount;
+static uint32_t s_blockCount;
+static void **s_blocks;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/* The scheduler does not run: the heap is only used by this thread */
+void vTaskSuspendAll(void)
+{
+}
+
+BaseType_t xTaskResumeAll(void)
+{
+    return pdFALSE;
+}
+
+void vPortEnterCritical(void)
+{
+}
+
+void vPortExitCritical(void)
+{
+}
+
+void vAssertCalled(const char *file, unsigned long line)
+{
+    fprintf(stderr, "ASSERT! Line %lu, file %s\n", line, file);
+    abort();
+}
+
+static void *replay_malloc(uint32_t size, uint8_t tag)
+{
+#if configFRTOS_MEMORY_SCHEME == 6
+    return pvPortMallocTagged(size, tag < configHEAP_TAG_COUNT ? tag : 0U);
+#else
+    (void)tag;
+    return pvPortMalloc(size);
+#endif
+}
+
+static uint64_t replay_now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000U + (uint64_t)now.tv_nsec;
+}
+
+static int replay_load(const char *path)
+{
+    FILE *trace;
+    char line[128];
+    size_t capacity = 0U;
+    unsigned long block, size, tag;
+    replay_op_t op;
+
+    trace = fopen(path, "r");
+    if (trace == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), trace) != NULL)
+    {
+        memset(&op, 0, sizeof(op));
+        if (sscanf(line, "a %lu %lu %lu", &block, &size, &tag) == 3)
+        {
+            op.kind = 'a';
+            op.size = (uint32_t)size;
+            op.tag  = (uint8_t)tag;
+        }
+        else if (sscanf(line, "f %lu", &block) == 1)
+        {
+            op.kind = 'f';
+        }
+        else
+        {
+            /* Comments and empty lines */
+            continue;
+        }
+        op.block = (uint32_t)block;
+
+        if (s_opCount == capacity)
+        {
+            capacity = capacity ? capacity * 2U : 1024U;
+            s_ops    = realloc(s_ops, capacity * sizeof(replay_op_t));
+            if (s_ops == NULL)
+            {
+                fclose(trace);
+                return -1;
+            }
+        }
+        s_ops[s_opCount++] = op;
+        if (op.block >= s_blockCount)
+        {
+            s_blockCount = op.block + 1U;
+        }
+    }
+    fclose(trace);
+
+    s_blocks = calloc(s_blockCount ? s_blockCount : 1U, sizeof(void *));
+    return s_blocks != NULL ? 0 : -1;
+}
+
+static int compare_ns(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+
+    return x < y ? -1 : x > y;
+}
+
+static void print_times(const char *name, replay_times_t *times)
+{
+    uint64_t total = 0U;
+    size_t i;
+
+    if (times->count == 0U)
+    {
+        return;
+    }
+
+    qsort(times->ns, times->count, sizeof(uint32_t), compare_ns);
+    for (i = 0U; i < times->count; i++)
+    {
+        total += times->ns[i];
+    }
+    printf("%-6s %10zu %8.1f %8u %8u %8u\n", name, times->count, (double)total / times->count,
+           times->ns[times->count / 2U], times->ns[(times->count * 99U) / 100U], times->ns[times->count - 1U]);
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+            "Usage: %s [-n passes] trace\n"
+            "  trace       heap trace of os_trace_convert.py --heap\n"
+            "  -n passes   number of times the trace is replayed, %d by default\n",
+            name, REPLAY_PASSES);
+}
+
+int main(int argc, char **argv)
+{
+    replay_times_t mallocs = {NULL, 0U}, frees = {NULL, 0U};
+    HeapStats_t stats, lowest;
+    size_t failed = 0U, firstFailed = 0U, lowestFree = (size_t)-1;
+    unsigned long passes = REPLAY_PASSES, pass;
+    uint64_t start, overhead;
+    size_t i;
+    int option;
+    replay_op_t *op;
+    void *block;
+
+    while ((option = getopt(argc, argv, "n:h")) != -1)
+    {
+        switch (option)
+        {
+            case 'n':
+                passes = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                usage(argv[0]);
+                return option == 'h' ? 0 : 1;
+        }
+    }
+    if (optind != argc - 1 || passes == 0U)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (replay_load(argv[optind]) != 0)
+    {
+        fprintf(stderr, "%s: cannot load the trace\n", argv[optind]);
+        return 1;
+    }
+
+    mallocs.ns = malloc(s_opCount * passes * sizeof(uint32_t));
+    frees.ns   = malloc(s_opCount * passes * sizeof(uint32_t));
+    if (s_opCount == 0U || mallocs.ns == NULL || frees.ns == NULL)
+    {
+        fprintf(stderr, "%s: no operation to replay\n", argv[optind]);
+        return 1;
+    }
+
+    /* The time of a read of the clock, included in the times below */
+    start = replay_now();
+    for (i = 0U; i < 1000U; i++)
+    {
+        (void)replay_now();
+    }
+    overhead = (replay_now() - start) / 1000U;
+
+    memset(&lowest, 0, sizeof(lowest));
+    for (pass = 0U; pass < passes; pass++)
+    {
+        for (i = 0U, op = s_ops; i < s_opCount; i++, op++)
+        {
+            if (op->kind == 'a')
+            {
+                start                       = replay_now();
+                block                       = replay_malloc(op->size, op->tag);
+                mallocs.ns[mallocs.count++] = (uint32_t)(replay_now() - start);
+                s_blocks[op->block]         = block;
+                if (block == NULL)
+                {
+                    failed++;
+                    if (pass == 0U)
+                    {
+                        firstFailed++;
+                    }
+                }
+                else if (xPortGetFreeHeapSize() < lowestFree)
+                {
+                    /* The fragmentation when the free space is the lowest */
+                    lowestFree = xPortGetFreeHeapSize();
+                    vPortGetHeapStats(&lowest);
+                }
+            }
+            else if (s_blocks[op->block] != NULL)
+            {
+                start = replay_now();
+                vPortFree(s_blocks[op->block]);
+                frees.ns[frees.count++] = (uint32_t)(replay_now() - start);
+                s_blocks[op->block]     = NULL;
+            }
+        }
+
+        /* Free the blocks the trace leaves allocated, for the next pass */
+        for (i = 0U; i < s_blockCount; i++)
+        {
+            vPortFree(s_blocks[i]);
+            s_blocks[i] = NULL;
+        }
+    }
+
+    printf("heap_%d, %u bytes, %zu operations, %lu passes\n", configFRTOS_MEMORY_SCHEME,
+           (unsigned int)configTOTAL_HEAP_SIZE, s_opCount, passes);
+    printf("failed allocations: %zu in the first pass, %zu in all\n", firstFailed, failed);
+    if (lowest.xAvailableHeapSpaceInBytes != 0U)
+    {
+        printf("lowest free space:  %zu bytes, largest free block %zu bytes (%.1f%%), in %zu blocks\n",
+               lowest.xAvailableHeapSpaceInBytes, lowest.xSizeOfLargestFreeBlockInBytes,
+               100.0 * lowest.xSizeOfLargestFreeBlockInBytes / lowest.xAvailableHeapSpaceInBytes,
+               lowest.xNumberOfFreeBlocks);
+    }
+    vPortGetHeapStats(&stats);
+    printf("at the end:         %zu bytes free in %zu blocks\n", stats.xAvailableHeapSpaceInBytes,
+           stats.xNumberOfFreeBlocks);
+
+#if configFRTOS_MEMORY_SCHEME == 6
+    {
+        HeapBinStats_t bins;
+        HeapTagStats_t tag;
+        UBaseType_t t;
+
+        vPortGetHeapBinStats(&bins);
+        printf("bins (%u bytes):    %zu hits, %zu misses, %zu flushes\n", (unsigned int)configHEAP_BIN_MAX_SIZE,
+               bins.xNumberOfBinHits, bins.xNumberOfBinMisses, bins.xNumberOfBinFlushes);
+        for (t = 0U; t < configHEAP_TAG_COUNT; t++)
+        {
+            vPortGetHeapTagStats(t, &tag);
+            if (tag.xNumberOfAllocations != 0U || tag.xNumberOfFailedAllocations != 0U)
+            {
+                printf("tag %-2u              %zu bytes at the peak, %zu allocations\n", (unsigned int)t,
+                       tag.xPeakBytes, tag.xNumberOfAllocations / passes);
+            }
+        }
+    }
+#endif
+
+    printf("\ntimes in ns, the reads of the clock included (%u ns)\n", (unsigned int)overhead);
+    printf("%-6s %10s %8s %8s %8s %8s\n", "", "count", "mean", "median", "99%", "max");
+    print_times("malloc", &mallocs);
+    print_times("free", &frees);
+
+    return 0;
+}
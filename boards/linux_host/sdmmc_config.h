@@ -0,0 +1,20 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _SDMMC_CONFIG_H_
+#define _SDMMC_CONFIG_H_
+
+#include "fsl_sdmmc_host.h"
+#include "fsl_sdmmc_common.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* The SDIO card of the host is simulated in memory: no DMA alignment. */
+#define BOARD_SDMMC_DATA_BUFFER_ALIGN_SIZE (1U)
+
+#endif /* _SDMMC_CONFIG_H_ */
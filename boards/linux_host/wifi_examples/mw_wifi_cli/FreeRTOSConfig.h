@@ -0,0 +1,156 @@
+/*
+FreeRTOS Kernel V10.3.0
+Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ http://aws.amazon.com/freertos
+ http://www.FreeRTOS.org
+*/
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+ * Application specific definitions.
+ *
+ * These definitions should be adjusted for your particular hardware and
+ * application requirements.
+ *
+ * THESE PARAMETERS ARE DESCRIBED WITHIN THE 'CONFIGURATION' SECTION OF THE
+ * FreeRTOS API DOCUMENTATION AVAILABLE ON THE FreeRTOS.org WEB SITE.
+ *
+ * See http://www.freertos.org/a00110.html.
+ *----------------------------------------------------------*/
+
+/*
+ * Host (Linux) build, FreeRTOS POSIX port: the same scheduling configuration
+ * as the rdmw320_r0 mw_wifi_cli example, so that the middleware runs as on the
+ * target. The differences are marked "Host:".
+ */
+
+#define configUSE_PREEMPTION                    1
+/* Host: the idle task waits for a signal instead of spinning */
+#define configUSE_TICKLESS_IDLE                 1
+#define configCPU_CLOCK_HZ                      (1000000UL)
+#define configTICK_RATE_HZ                      ((TickType_t)1000)
+#define configMAX_PRIORITIES                    5
+/* Host: in words of 8 bytes, the tasks run on the stacks of their threads */
+#define configMINIMAL_STACK_SIZE                ((unsigned short)128)
+#define configMAX_TASK_NAME_LEN                 10
+#define configUSE_16_BIT_TICKS                  0
+#define configIDLE_SHOULD_YIELD                 1
+#define configUSE_TASK_NOTIFICATIONS            1
+#define configUSE_MUTEXES                       1
+#define configUSE_RECURSIVE_MUTEXES             1
+#define configUSE_COUNTING_SEMAPHORES           1
+#define configUSE_ALTERNATIVE_API               0 /* Deprecated! */
+#define configQUEUE_REGISTRY_SIZE               8
+#define configUSE_QUEUE_SETS                    0
+#define configUSE_TIME_SLICING                  0
+#define configUSE_NEWLIB_REENTRANT              0
+#define configENABLE_BACKWARD_COMPATIBILITY     1
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 5
+#define configUSE_APPLICATION_TASK_TAG          0
+
+/* Used memory allocation (heap_x.c) */
+#define configFRTOS_MEMORY_SCHEME 4
+/* Tasks.c additions (e.g. Thread Aware Debug capability) */
+#define configINCLUDE_FREERTOS_TASK_C_ADDITIONS_H 1
+
+/* Memory allocation related definitions. */
+#define configSUPPORT_STATIC_ALLOCATION  0
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+/* Host: pointers and stack words are twice as large as on the target */
+#define configTOTAL_HEAP_SIZE            ((size_t)(256 * 1024))
+#define configAPPLICATION_ALLOCATED_HEAP 0
+/* heap_6.c (scheme 6, not the default until replays of target traces show
+   no more failures than heap_4): the allocations of up to 256 bytes are
+   served by bins of free blocks per size, and the heap accounts the
+   allocations per caller tag */
+#if configFRTOS_MEMORY_SCHEME == 6
+#define configHEAP_BIN_MAX_SIZE 256
+#define configHEAP_TAG_COUNT    3
+#define configHEAP_TAG_WIFI     1
+#define configHEAP_TAG_MBEDTLS  2
+#define configHEAP_TAG_NAMES    {"kernel", "wifi", "mbedtls"}
+#endif
+
+/* Hook function related definitions. */
+#define configUSE_IDLE_HOOK                1
+#define configUSE_TICK_HOOK                1
+#define configCHECK_FOR_STACK_OVERFLOW     0
+#define configUSE_MALLOC_FAILED_HOOK       0
+#define configUSE_DAEMON_TASK_STARTUP_HOOK 0
+
+/* Run time and task stats gathering related definitions. */
+#define configGENERATE_RUN_TIME_STATS        1
+#define configUSE_TRACE_FACILITY             1
+#define configUSE_STATS_FORMATTING_FUNCTIONS 1
+
+/* Co-routine related definitions. */
+#define configUSE_CO_ROUTINES           0
+#define configMAX_CO_ROUTINE_PRIORITIES 2
+
+/* Software timer related definitions. */
+#define configUSE_TIMERS             1
+#define configTIMER_TASK_PRIORITY    4
+#define configTIMER_QUEUE_LENGTH     5
+#define configTIMER_TASK_STACK_DEPTH (configMINIMAL_STACK_SIZE)
+
+/* Host: report the failed assertion and abort, for the debugger or the core */
+void vAssertCalled(const char *file, unsigned long line);
+#define configASSERT(x)                          \
+    if ((x) == 0)                                \
+    {                                            \
+        vAssertCalled(__FILE__, __LINE__);       \
+    }
+
+/* Optional functions - most linkers will remove unused functions anyway. */
+#define INCLUDE_vTaskPrioritySet            1
+#define INCLUDE_uxTaskPriorityGet           1
+#define INCLUDE_vTaskDelete                 1
+#define INCLUDE_vTaskSuspend                1
+#define INCLUDE_xResumeFromISR              1
+#define INCLUDE_vTaskDelayUntil             1
+#define INCLUDE_vTaskDelay                  1
+#define INCLUDE_xTaskGetSchedulerState      1
+#define INCLUDE_xTaskGetCurrentTaskHandle   1
+#define INCLUDE_uxTaskGetStackHighWaterMark 0
+#define INCLUDE_xTaskGetIdleTaskHandle      0
+#define INCLUDE_eTaskGetState               0
+#define INCLUDE_xEventGroupSetBitFromISR    1
+#define INCLUDE_xTimerPendFunctionCall      1
+#define INCLUDE_xTaskAbortDelay             0
+#define INCLUDE_xTaskGetHandle              0
+#define INCLUDE_xTaskResumeFromISR          1
+
+/* Host: the run time counter is the monotonic clock of the host, in
+   micro-seconds, see board.c */
+#include <stdint.h>
+#define BOARD_RUN_TIME_COUNTER_HZ (1000000U)
+void BOARD_InitRunTimeCounter(void);
+uint32_t BOARD_GetRunTimeCounter(void);
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() BOARD_InitRunTimeCounter()
+#define portGET_RUN_TIME_COUNTER_VALUE()         BOARD_GetRunTimeCounter()
+
+/* Scheduling trace of the wifi middleware (CONFIG_OS_TRACE in wifi_config.h):
+   the recorder defines the trace macros */
+#include "os_trace.h"
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,41 @@
+/* @file lwippools.h
+ *
+ *  @brief This file contains custom LwIP memory pool definitions
+ *
+ *  Copyright 2008-2020 NXP
+ *
+ *  NXP CONFIDENTIAL
+ *  The source code contained or described herein and all documents related to
+ *  the source code ("Materials") are owned by NXP, its
+ *  suppliers and/or its licensors. Title to the Materials remains with NXP,
+ *  its suppliers and/or its licensors. The Materials contain
+ *  trade secrets and proprietary and confidential information of NXP, its
+ *  suppliers and/or its licensors. The Materials are protected by worldwide copyright
+ *  and trade secret laws and treaty provisions. No part of the Materials may be
+ *  used, copied, reproduced, modified, published, uploaded, posted,
+ *  transmitted, distributed, or disclosed in any way without NXP's prior
+ *  express written permission.
+ *
+ *  No license under any patent, copyright, trade secret or other intellectual
+ *  property right is granted to or conferred upon you by disclosure or delivery
+ *  of the Materials, either expressly, by implication, inducement, estoppel or
+ *  otherwise. Any license under such intellectual property rights must be
+ *  express and approved by NXP in writing.
+ *
+ */
+
+#ifndef __LWIPPOOLS_H__
+#define __LWIPPOOLS_H__
+
+#ifdef MEMP_USE_CUSTOM_POOLS
+/*
+ * We explicitly move certain large LwIP memory pools to the custom defined
+ * .wlan_data section in (flash) memory to avoid memory overflow in the
+ * m_data section (RAM).
+ */
+extern unsigned char __attribute__((section(".wlan_data"))) memp_memory_PBUF_POOL_base[];
+extern unsigned char __attribute__((section(".wlan_data"))) memp_memory_TCP_PCB_POOL_base[];
+
+#endif /* MEMP_USE_CUSTOM_POOLS */
+
+#endif /* __LWIPPOOLS_H__ */
@@ -0,0 +1,403 @@
+/** @file main.c
+ *
+ *  @brief main file of the host (Linux) build
+ *
+ *  Copyright 2026 NXP
+ *
+ *  NXP CONFIDENTIAL
+ *  The source code contained or described herein and all documents related to
+ *  the source code ("Materials") are owned by NXP, its
+ *  suppliers and/or its licensors. Title to the Materials remains with NXP,
+ *  its suppliers and/or its licensors. The Materials contain
+ *  trade secrets and proprietary and confidential information of NXP, its
+ *  suppliers and/or its licensors. The Materials are protected by worldwide copyright
+ *  and trade secret laws and treaty provisions. No part of the Materials may be
+ *  used, copied, reproduced, modified, published, uploaded, posted,
+ *  transmitted, distributed, or disclosed in any way without NXP's prior
+ *  express written permission.
+ *
+ *  No license under any patent, copyright, trade secret or other intellectual
+ *  property right is granted to or conferred upon you by disclosure or delivery
+ *  of the Materials, either expressly, by implication, inducement, estoppel or
+ *  otherwise. Any license under such intellectual property rights must be
+ *  express and approved by NXP in writing.
+ *
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+//  Includes
+///////////////////////////////////////////////////////////////////////////////
+
+#include <assert.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// SDK Included Files
+#include "board.h"
+#include "fsl_debug_console.h"
+
+#include "wlan.h"
+#include "wifi.h"
+#include "wifi_sim.h"
+#include "wm_net.h"
+#include <wm_os.h>
+#include "dhcp-server.h"
+#include "cli.h"
+#include "ping.h"
+#include "iperf.h"
+#include "os_bench.h"
+#include "os_trace_cli.h"
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static void simLinkLoss(int argc, char **argv);
+static void simRxCheck(int argc, char **argv);
+static void exitCommand(int argc, char **argv);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static struct wlan_network sta_network;
+static struct wlan_network uap_network;
+
+static struct cli_command simCommands[] = {
+    {"wlan-sim-link-loss", NULL, simLinkLoss},
+    {"wlan-sim-rx-check", "[count]", simRxCheck},
+    {"exit", NULL, exitCommand},
+};
+
+const int TASK_MAIN_PRIO       = OS_PRIO_3;
+const int TASK_MAIN_STACK_SIZE = 800;
+
+portSTACK_TYPE *task_main_stack = NULL;
+TaskHandle_t task_main_task_handler;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static void printSeparator(void)
+{
+    PRINTF("----------------------------------------\r\n");
+}
+
+/* configASSERT() */
+void vAssertCalled(const char *file, unsigned long line)
+{
+    taskDISABLE_INTERRUPTS();
+    fprintf(stderr, "ASSERT: %s:%lu\n", file, line);
+    abort();
+}
+
+static void simLinkLoss(int argc, char **argv)
+{
+    if (wifi_sim_link_loss() != WM_SUCCESS)
+    {
+        PRINTF("Error: not associated\r\n");
+    }
+}
+
+static void simRxCheck(int argc, char **argv)
+{
+    struct wifi_sim_rx_check result;
+    unsigned int count = 256;
+#ifdef CONFIG_WIFI_RX_BATCH
+    struct net_rx_batch_stats stats;
+
+    net_reset_rx_batch_stats();
+#endif
+
+    if (argc > 1)
+    {
+        count = strtoul(argv[1], NULL, 0);
+    }
+
+    if (wifi_sim_rx_check(count, &result) != WM_SUCCESS)
+    {
+        PRINTF("Error: not associated to the simulated gateway\r\n");
+        return;
+    }
+
+    PRINTF("rx-check: %u sent, %u echoed, %u mismatched, digest %08x\r\n", result.sent, result.echoed,
+           result.mismatched, (unsigned int)result.digest);
+#ifdef CONFIG_WIFI_RX_BATCH
+    net_get_rx_batch_stats(&stats);
+    PRINTF("rx batch: %u queued, %u dropped, %u bursts, max burst %u\r\n", (unsigned int)stats.queued,
+           (unsigned int)stats.dropped, (unsigned int)stats.bursts, (unsigned int)stats.max_burst);
+#endif
+}
+
+static void exitCommand(int argc, char **argv)
+{
+    /* main() returns */
+    vTaskEndScheduler();
+}
+
+/* Callback Function passed to WLAN Connection Manager. The callback function
+ * gets called when there are WLAN Events that need to be handled by the
+ * application.
+ */
+int wlan_event_callback(enum wlan_event_reason reason, void *data)
+{
+    int ret;
+    struct wlan_ip_config addr;
+    char ip[16];
+    static int auth_fail = 0;
+
+    printSeparator();
+    PRINTF("app_cb: WLAN: received event %d\r\n", reason);
+    printSeparator();
+
+    switch (reason)
+    {
+        case WLAN_REASON_INITIALIZED:
+            PRINTF("app_cb: WLAN initialized\r\n");
+            printSeparator();
+
+            ret = wlan_basic_cli_init();
+            if (ret != WM_SUCCESS)
+            {
+                PRINTF("Failed to initialize BASIC WLAN CLIs\r\n");
+                return 0;
+            }
+
+            ret = wlan_cli_init();
+            if (ret != WM_SUCCESS)
+            {
+                PRINTF("Failed to initialize WLAN CLIs\r\n");
+                return 0;
+            }
+            PRINTF("WLAN CLIs are initialized\r\n");
+            printSeparator();
+
+            ret = ping_cli_init();
+            if (ret != WM_SUCCESS)
+            {
+                PRINTF("Failed to initialize PING CLI\r\n");
+                return 0;
+            }
+
+            ret = iperf_cli_init();
+            if (ret != WM_SUCCESS)
+            {
+                PRINTF("Failed to initialize IPERF CLI\r\n");
+                return 0;
+            }
+
+            ret = os_bench_cli_init();
+            if (ret != WM_SUCCESS)
+            {
+                PRINTF("Failed to initialize OS-BENCH CLI\r\n");
+                return 0;
+            }
+
+#ifdef CONFIG_OS_TRACE
+            ret = os_trace_cli_init();
+            if (ret != WM_SUCCESS)
+            {
+                PRINTF("Failed to initialize OS-TRACE CLI\r\n");
+                return 0;
+            }
+#endif
+
+            ret = dhcpd_cli_init();
+            if (ret != WM_SUCCESS)
+            {
+                PRINTF("Failed to initialize DHCP Server CLI\r\n");
+                return 0;
+            }
+
+            if (cli_register_commands(simCommands, sizeof(simCommands) / sizeof(struct cli_command)))
+            {
+                return -WM_FAIL;
+            }
+
+            PRINTF("CLIs Available:\r\n");
+            printSeparator();
+            help_command(0, NULL);
+            printSeparator();
+            break;
+        case WLAN_REASON_INITIALIZATION_FAILED:
+            PRINTF("app_cb: WLAN: initialization failed\r\n");
+            break;
+        case WLAN_REASON_SUCCESS:
+            PRINTF("app_cb: WLAN: connected to network\r\n");
+            ret = wlan_get_address(&addr);
+            if (ret != WM_SUCCESS)
+            {
+                PRINTF("failed to get IP address\r\n");
+                return 0;
+            }
+
+            net_inet_ntoa(addr.ipv4.address, ip);
+
+            ret = wlan_get_current_network(&sta_network);
+            if (ret != WM_SUCCESS)
+            {
+                PRINTF("Failed to get External AP network\r\n");
+                return 0;
+            }
+
+            PRINTF("Connected to following BSS:\r\n");
+            PRINTF("SSID = [%s], IP = [%s]\r\n", sta_network.ssid, ip);
+            auth_fail = 0;
+            break;
+        case WLAN_REASON_CONNECT_FAILED:
+            PRINTF("app_cb: WLAN: connect failed\r\n");
+            break;
+        case WLAN_REASON_NETWORK_NOT_FOUND:
+            PRINTF("app_cb: WLAN: network not found\r\n");
+            break;
+        case WLAN_REASON_NETWORK_AUTH_FAILED:
+            PRINTF("app_cb: WLAN: network authentication failed\r\n");
+            auth_fail++;
+            if (auth_fail >= 3)
+            {
+                PRINTF("Authentication Failed. Disconnecting ... \r\n");
+                wlan_disconnect();
+                auth_fail = 0;
+            }
+            break;
+        case WLAN_REASON_ADDRESS_SUCCESS:
+            PRINTF("network mgr: DHCP new lease\r\n");
+            break;
+        case WLAN_REASON_ADDRESS_FAILED:
+            PRINTF("app_cb: failed to obtain an IP address\r\n");
+            break;
+        case WLAN_REASON_USER_DISCONNECT:
+            PRINTF("app_cb: disconnected\r\n");
+            auth_fail = 0;
+            break;
+        case WLAN_REASON_LINK_LOST:
+            PRINTF("app_cb: WLAN: link lost\r\n");
+            break;
+        case WLAN_REASON_CHAN_SWITCH:
+            PRINTF("app_cb: WLAN: channel switch\r\n");
+            break;
+        case WLAN_REASON_UAP_SUCCESS:
+            PRINTF("app_cb: WLAN: UAP Started\r\n");
+            ret = wlan_get_current_uap_network(&uap_network);
+
+            if (ret != WM_SUCCESS)
+            {
+                PRINTF("Failed to get Soft AP network\r\n");
+                return 0;
+            }
+
+            printSeparator();
+            PRINTF("Soft AP \"%s\" started successfully\r\n", uap_network.ssid);
+            printSeparator();
+            if (dhcp_server_start(net_get_uap_handle()))
+                PRINTF("Error in starting dhcp server\r\n");
+
+            PRINTF("DHCP Server started successfully\r\n");
+            printSeparator();
+            break;
+        case WLAN_REASON_UAP_STOPPED:
+            PRINTF("app_cb: WLAN: UAP Stopped\r\n");
+            printSeparator();
+            PRINTF("Soft AP \"%s\" stopped successfully\r\n", uap_network.ssid);
+            printSeparator();
+
+            dhcp_server_stop();
+
+            PRINTF("DHCP Server stopped successfully\r\n");
+            printSeparator();
+            break;
+        case WLAN_REASON_PS_ENTER:
+            PRINTF("app_cb: WLAN: PS_ENTER\r\n");
+            break;
+        case WLAN_REASON_PS_EXIT:
+            PRINTF("app_cb: WLAN: PS EXIT\r\n");
+            break;
+        default:
+            PRINTF("app_cb: WLAN: Unknown Event: %d\r\n", reason);
+    }
+    return 0;
+}
+
+void task_main(void *param)
+{
+    int32_t result = 0;
+
+    PRINTF("Initialize CLI\r\n");
+    printSeparator();
+
+    result = cli_init();
+    if (WM_SUCCESS != result)
+    {
+        assert(false);
+    }
+
+    PRINTF("Initialize WLAN Driver\r\n");
+    printSeparator();
+
+    /* Initialize WIFI Driver, with the firmware of the simulated card */
+    result = wlan_init(wifi_sim_fw_image, wifi_sim_fw_image_len);
+    if (WM_SUCCESS != result)
+    {
+        assert(false);
+    }
+
+    result = wlan_start(wlan_event_callback);
+    if (WM_SUCCESS != result)
+    {
+        assert(false);
+    }
+
+    while (1)
+    {
+        /* wait for interface up */
+        os_thread_sleep(os_msec_to_ticks(5000));
+    }
+}
+
+static void usage(const char *name)
+{
+    printf("Usage: %s [-t <tap interface>]\n", name);
+    printf("  -t  send the frames of the station to a TAP interface of the host,\n");
+    printf("      instead of the gateway of the simulation (" WIFI_SIM_GATEWAY_IP ")\n");
+}
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    BaseType_t result = 0;
+    int opt;
+    (void)result;
+
+    while ((opt = getopt(argc, argv, "t:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 't':
+                if (wifi_sim_set_tap(optarg) != WM_SUCCESS)
+                {
+                    printf("Error: can't attach to TAP interface %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    BOARD_InitDebugConsole();
+
+    printSeparator();
+    PRINTF("wifi cli demo\r\n");
+    printSeparator();
+
+    result =
+        xTaskCreate(task_main, "main", TASK_MAIN_STACK_SIZE, task_main_stack, TASK_MAIN_PRIO, &task_main_task_handler);
+    assert(pdPASS == result);
+
+    vTaskStartScheduler();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,32 @@
+#!/bin/sh
+# Receive path check of the host build: each example given connects to the
+# simulated open network, gets its address from the built-in gateway, and
+# echoes a burst of ICMP echo requests (wlan-sim-rx-check). All the requests
+# must be echoed in order, and the examples must agree on the replies, which
+# compares builds with and without CONFIG_WIFI_RX_BATCH.
+#
+#   sh rx_check.sh build/mw_wifi_cli build/mw_wifi_cli_rx_unbatched
+
+COUNT=${COUNT:-1024}
+ref=
+
+for cli in "$@"; do
+    line=$( (sleep 2; printf 'wlan-add sim ssid nxp_sim_open\r'; printf 'wlan-connect sim\r'; sleep 3;
+             printf 'wlan-sim-rx-check %s\r' "$COUNT"; sleep 5; printf 'exit\r') |
+            timeout 60 "$cli" | tr -d '\r' | grep '^rx-check:')
+    echo "$cli: $line"
+
+    case "$line" in
+        "rx-check: $COUNT sent, $COUNT echoed, 0 mismatched, "*) ;;
+        *) echo "FAIL: $cli"; exit 1 ;;
+    esac
+
+    if [ -z "$ref" ]; then
+        ref=$line
+    elif [ "$line" != "$ref" ]; then
+        echo "FAIL: $cli does not deliver the same frames"
+        exit 1
+    fi
+done
+
+echo "PASS"
@@ -0,0 +1,65 @@
+#ifndef _WIFI_CONFIG_H_
+#define _WIFI_CONFIG_H_
+
+#define SD8801
+
+/* Host: pointers of the driver (t_ptr) are as wide as those of the host */
+#if defined(__LP64__)
+#define MLAN_64BIT
+#endif
+
+#define CONFIG_WIFI_MAX_PRIO (configMAX_PRIORITIES - 1)
+
+#define CONFIG_MAX_AP_ENTRIES 10
+
+#define CONFIG_FLASH_PARTITION_COUNT 16
+
+#define CONFIG_IPV6 1
+
+/*
+ * Queue received frames in a ring and hand them to the tcpip thread in
+ * bursts instead of one mailbox message per frame. The mw_wifi_cli_rx_unbatched
+ * target is built without, for the rx_batch test (rx_check.sh).
+ */
+#ifndef WIFI_CLI_RX_UNBATCHED
+#define CONFIG_WIFI_RX_BATCH 1
+#endif
+
+/*
+ * Count the fast and slow paths of the reader-writer locks, see
+ * wlan-ps-lock-stats for the power save lock taken by every transmit
+ */
+#define CONFIG_OS_RWLOCK_STATS 1
+
+/*
+ * Record the context switches and the blocking of the tasks in a ring, see
+ * os-trace and os_trace.h. 8 bytes per record.
+ */
+#define CONFIG_OS_TRACE         1
+#define CONFIG_OS_TRACE_RECORDS 2048U
+
+/* Logs */
+#define CONFIG_ENABLE_ERROR_LOGS 1
+#define CONFIG_ENABLE_WARNING_LOGS 1
+
+/* WLCMGR debug */
+#undef CONFIG_WLCMGR_DEBUG
+
+/*
+ * Wifi extra debug options
+ */
+#undef CONFIG_WIFI_EXTRA_DEBUG
+#undef CONFIG_WIFI_EVENTS_DEBUG
+#undef CONFIG_WIFI_CMD_RESP_DEBUG
+#undef CONFIG_WIFI_SCAN_DEBUG
+#undef CONFIG_WIFI_IO_INFO_DUMP
+#undef CONFIG_WIFI_IO_DEBUG
+#undef CONFIG_WIFI_IO_DUMP
+#undef CONFIG_WIFI_MEM_DEBUG
+#undef CONFIG_WIFI_AMPDU_DEBUG
+#undef CONFIG_WIFI_TIMER_DEBUG
+#undef CONFIG_WIFI_SDIO_DEBUG
+#undef CONFIG_WIFI_FW_DEBUG
+#undef CONFIG_WIFI_SIM_DEBUG
+
+#endif /* _WIFI_CONFIG_H_ */
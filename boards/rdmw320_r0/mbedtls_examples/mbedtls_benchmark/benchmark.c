@@ -123,12 +123,19 @@ int main(void)
 #endif
 
 #include "fsl_aes.h"
+#include "bench_core.h"
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
 #define CORE_CLK_FREQ             CLOCK_GetCoreBusFreq()
 #define CLOCK_GetCoreSysClkFreq() CORE_CLK_FREQ
 
+/* Set to 1 to run the benchmarks of bench_core.c and print them as JSON, see
+ * middleware/mbedtls/scripts/bench_compare.py to compare two runs */
+#ifndef BENCHMARK_JSON_OUTPUT
+#define BENCHMARK_JSON_OUTPUT 0
+#endif
+
 /*
  * For heap usage estimates, we need an estimate of the overhead per allocated
  * block. ptmalloc2/3 (used in gnu libc for instance) uses 2 size_t per block,
@@ -292,15 +299,16 @@ static int myrand( void *rng_state, unsigned char *output, size_t len )
 #if defined(MBEDTLS_ECP_C)
 void ecp_clear_precomputed( mbedtls_ecp_group *grp )
 {
-    if( grp->T != NULL )
+    /* a table with T_size == 0 is static (in flash), and never recomputed */
+    if( grp->T != NULL && grp->T_size != 0 )
     {
         size_t i;
         for( i = 0; i < grp->T_size; i++ )
             mbedtls_ecp_point_free( &grp->T[i] );
         mbedtls_free( grp->T );
+        grp->T = NULL;
+        grp->T_size = 0;
     }
-    grp->T = NULL;
-    grp->T_size = 0;
 }
 #else
 #define ecp_clear_precomputed( g )
@@ -364,6 +372,25 @@ static void benchmark_mbedtls_poll_alarm(void)
 }
 #endif
 
+#if BENCHMARK_JSON_OUTPUT
+static void benchmark_json_output(const char *s)
+{
+    PRINTF("%s", s);
+}
+
+static void benchmark_json_run(void)
+{
+    bench_platform platform;
+
+    platform.name         = "rdmw320_r0";
+    platform.hardclock    = benchmark_mbedtls_timing_hardclock;
+    platform.hardclock_hz = CLOCK_GetCoreSysClkFreq();
+    platform.output       = benchmark_json_output;
+
+    (void)bench_run(&platform, NULL, 1000U);
+}
+#endif
+
 static int bench_print_features(void)
 {
     char *text;
@@ -492,6 +519,11 @@ int main( int argc, char *argv[] )
     SysTick_Config(CLOCK_GetCoreSysClkFreq() / 1000U); /* 1 ms period */
 #endif
     bench_print_features();
+#if BENCHMARK_JSON_OUTPUT
+    /* The JSON report replaces the benchmarks below */
+    benchmark_json_run();
+    goto exit;
+#endif
 #if 0 /* We need to run all tests*/
     if( argc <= 1 )
     {
@@ -1271,6 +1303,9 @@ int main( int argc, char *argv[] )
     mbedtls_memory_buffer_alloc_free();
 #endif
 
+#if BENCHMARK_JSON_OUTPUT
+exit:
+#endif
 #if defined(_WIN32)
     mbedtls_printf( "  Press Enter to exit this program.\n" );
     fflush( stdout ); getchar();
@@ -70,6 +70,17 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define configSUPPORT_DYNAMIC_ALLOCATION 1
 #define configTOTAL_HEAP_SIZE            ((size_t)(60 * 1024))
 #define configAPPLICATION_ALLOCATED_HEAP 0
+/* heap_6.c (scheme 6, not the default until replays of target traces show
+   no more failures than heap_4): the allocations of up to 256 bytes are
+   served by bins of free blocks per size, and the heap accounts the
+   allocations per caller tag */
+#if configFRTOS_MEMORY_SCHEME == 6
+#define configHEAP_BIN_MAX_SIZE 256
+#define configHEAP_TAG_COUNT    3
+#define configHEAP_TAG_WIFI     1
+#define configHEAP_TAG_MBEDTLS  2
+#define configHEAP_TAG_NAMES    {"kernel", "wifi", "mbedtls"}
+#endif
 
 /* Hook function related definitions. */
 #define configUSE_IDLE_HOOK                1
@@ -79,7 +90,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define configUSE_DAEMON_TASK_STARTUP_HOOK 0
 
 /* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS        0
+#define configGENERATE_RUN_TIME_STATS        1
 #define configUSE_TRACE_FACILITY             1
 #define configUSE_STATS_FORMATTING_FUNCTIONS 1
 
@@ -127,6 +138,19 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
     /* Clock manager provides in this variable system core clock frequency */
     #include <stdint.h>
     extern uint32_t SystemCoreClock;
+
+    /* Run time counter: GPT1, free running at 1 MHz, see board.c. It wraps
+       around after 71 minutes, the run time stats are wrong after that. It
+       doesn't count in the low power modes that stop the system clock. */
+    #define BOARD_RUN_TIME_COUNTER_HZ (1000000U)
+    void BOARD_InitRunTimeCounter(void);
+    uint32_t BOARD_GetRunTimeCounter(void);
+    #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() BOARD_InitRunTimeCounter()
+    #define portGET_RUN_TIME_COUNTER_VALUE()         BOARD_GetRunTimeCounter()
+
+    /* Scheduling trace of the wifi middleware (CONFIG_OS_TRACE in
+       wifi_config.h): the recorder defines the trace macros */
+    #include "os_trace.h"
 #endif
 
 /* Interrupt nesting behaviour configuration. Cortex-M specific. */
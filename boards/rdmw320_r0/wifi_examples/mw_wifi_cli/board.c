@@ -9,11 +9,17 @@
 #include "fsl_common.h"
 #include "fsl_debug_console.h"
 #include "fsl_clock.h"
+#include "fsl_gpt.h"
 #include "board.h"
+#include "FreeRTOSConfig.h"
 
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
+/* Run time counter of FreeRTOS, see FreeRTOSConfig.h */
+#define BOARD_RUN_TIME_COUNTER_GPT      GPT1
+#define BOARD_RUN_TIME_COUNTER_CLK      kSYS_CLK_to_GPT1
+#define BOARD_RUN_TIME_COUNTER_INSTANCE 1U
 
 /*******************************************************************************
  * Variables
@@ -38,3 +44,26 @@ void BOARD_InitDebugConsole(void)
 
     DbgConsole_Init(BOARD_DEBUG_UART_INSTANCE, BOARD_DEBUG_UART_BAUDRATE, BOARD_DEBUG_UART_TYPE, uartClkSrcFreq);
 }
+
+/* Start the run time counter: GPT1, free running at BOARD_RUN_TIME_COUNTER_HZ. */
+void BOARD_InitRunTimeCounter(void)
+{
+    gpt_config_t config;
+
+    CLOCK_AttachClk(BOARD_RUN_TIME_COUNTER_CLK);
+
+    GPT_GetDefaultConfig(&config);
+    /* The system clock is a multiple of 1 MHz, up to 256 MHz */
+    config.prescale = (uint8_t)(CLOCK_GetGptClkFreq(BOARD_RUN_TIME_COUNTER_INSTANCE) / BOARD_RUN_TIME_COUNTER_HZ - 1U);
+    /* Read the count of every tick: the counter clock is well below the APB
+     * clock */
+    config.cntUpdateMode = kGPT_CntUpdateMode_Fast;
+    (void)GPT_Init(BOARD_RUN_TIME_COUNTER_GPT, &config);
+    GPT_StartTimer(BOARD_RUN_TIME_COUNTER_GPT);
+}
+
+/* Get the run time counter, called by the kernel at every context switch. */
+uint32_t BOARD_GetRunTimeCounter(void)
+{
+    return GPT_GetCurrentTimerCount(BOARD_RUN_TIME_COUNTER_GPT);
+}
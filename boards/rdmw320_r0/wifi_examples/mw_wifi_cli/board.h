@@ -103,6 +103,10 @@ extern "C" {
 
 void BOARD_InitDebugConsole(void);
 
+/* Run time counter of FreeRTOS, see FreeRTOSConfig.h */
+void BOARD_InitRunTimeCounter(void);
+uint32_t BOARD_GetRunTimeCounter(void);
+
 /* Only used for mbedtls entropy, implemented in board_hash.c */
 void BOARD_GetHash(uint8_t *buf, uint32_t *len);
 
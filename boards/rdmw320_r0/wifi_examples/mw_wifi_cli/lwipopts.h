@@ -322,6 +322,12 @@
  */
 #define TCP_MSS 1460
 
+/**
+ * LWIP_CHECKSUM_ON_COPY==1: Calculate checksum when copying data from
+ * application buffers to pbufs (uses the port's LWIP_CHKSUM_COPY).
+ */
+#define LWIP_CHECKSUM_ON_COPY 1
+
 /*
    ---------------------------------
    ---------- RAW options ----------
@@ -496,4 +502,26 @@
 #define TCP_RESOURCE_FAIL_RETRY_LIMIT 50
 
 #define LWIP_COMPAT_MUTEX_ALLOWED 1
+
+/*
+   ------------------------------------
+   ---------- SNTP options ----------
+   ------------------------------------
+*/
+/**
+ * SNTP_CLOCK_DISCIPLINE==1: slew the SNTP clock towards the server instead
+ * of setting the time on every response. SNTP_SET_SYSTEM_TIME is still
+ * called on the first sync and on each step. Only used when the lwIP SNTP
+ * component is part of the project; it then needs two more entries in
+ * MEMP_NUM_SYS_TIMEOUT.
+ */
+#define SNTP_CLOCK_DISCIPLINE 1
+
+/**
+ * SNTP_CLOCK_GET_LOCAL_US: microseconds since boot from the SysTick counter
+ * (wm_os.h), wrapping at 32 bits.
+ */
+unsigned int os_get_timestamp(void);
+#define SNTP_CLOCK_GET_LOCAL_US() ((u32_t)os_get_timestamp())
+
 #endif /* __LWIPOPTS_H__ */
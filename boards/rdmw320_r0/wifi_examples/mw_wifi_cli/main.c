@@ -43,6 +43,9 @@
 #include "cli.h"
 #include "ping.h"
 #include "iperf.h"
+#include "tls_prof.h"
+#include "os_bench.h"
+#include "os_trace_cli.h"
 #include "partition.h"
 #include "boot_flags.h"
 #include "network_flash_storage.h"
@@ -398,6 +401,29 @@ int wlan_event_callback(enum wlan_event_reason reason, void *data)
                 return 0;
             }
 
+            ret = tls_prof_cli_init();
+            if (ret != WM_SUCCESS)
+            {
+                PRINTF("Failed to initialize TLS-PROF CLI\r\n");
+                return 0;
+            }
+
+            ret = os_bench_cli_init();
+            if (ret != WM_SUCCESS)
+            {
+                PRINTF("Failed to initialize OS-BENCH CLI\r\n");
+                return 0;
+            }
+
+#ifdef CONFIG_OS_TRACE
+            ret = os_trace_cli_init();
+            if (ret != WM_SUCCESS)
+            {
+                PRINTF("Failed to initialize OS-TRACE CLI\r\n");
+                return 0;
+            }
+#endif
+
             ret = dhcpd_cli_init();
             if (ret != WM_SUCCESS)
             {
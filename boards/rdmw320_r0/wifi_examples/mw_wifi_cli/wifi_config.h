@@ -11,6 +11,25 @@
 
 #define CONFIG_IPV6 1
 
+/*
+ * Queue received frames in a ring and hand them to the tcpip thread in
+ * bursts instead of one mailbox message per frame
+ */
+#undef CONFIG_WIFI_RX_BATCH
+
+/*
+ * Count the fast and slow paths of the reader-writer locks, see
+ * wlan-ps-lock-stats for the power save lock taken by every transmit
+ */
+#define CONFIG_OS_RWLOCK_STATS 1
+
+/*
+ * Record the context switches and the blocking of the tasks in a ring, see
+ * os-trace and os_trace.h. 8 bytes per record.
+ */
+#define CONFIG_OS_TRACE         1
+#define CONFIG_OS_TRACE_RECORDS 2048U
+
 /* Logs */
 #define CONFIG_ENABLE_ERROR_LOGS 1
 #define CONFIG_ENABLE_WARNING_LOGS 1
@@ -291,6 +291,12 @@
  */
 #define TCP_MSS 1460
 
+/**
+ * LWIP_CHECKSUM_ON_COPY==1: Calculate checksum when copying data from
+ * application buffers to pbufs (uses the port's LWIP_CHKSUM_COPY).
+ */
+#define LWIP_CHECKSUM_ON_COPY 1
+
 /*
    ---------------------------------
    ---------- RAW options ----------
@@ -13,6 +13,12 @@
 #define CONFIG_5GHz_SUPPORT 1
 #endif
 
+/*
+ * Queue received frames in a ring and hand them to the tcpip thread in
+ * bursts instead of one mailbox message per frame
+ */
+#undef CONFIG_WIFI_RX_BATCH
+
 /* Logs */
 #define CONFIG_ENABLE_ERROR_LOGS   1
 #define CONFIG_ENABLE_WARNING_LOGS 1
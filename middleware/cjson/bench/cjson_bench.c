@@ -0,0 +1,748 @@
+/*
+  Copyright 2026 NXP
+
+  SPDX-License-Identifier: MIT
+*/
+
+/* Host benchmark of the cJSON parser and object lookups.
+ *
+ * Build and run from middleware/cjson:
+ *   cc -O2 -I. bench/cjson_bench.c cJSON.c cJSON_Stream.c cJSON_Utils.c -lm -o cjson_bench
+ *   ./cjson_bench [-n iterations] [file.json ...]
+ *
+ * Without files it parses a generated 3 KB document shaped like the webconfig and cloud
+ * payloads. Every parser is run on the same input; the heap figures count what goes
+ * through the cJSON hooks.
+ *
+ * Then it looks up keys and applies patches on objects of 100 to 10000 keys: build it a
+ * second time with -DCJSON_OBJECT_INDEX to compare with the key index.
+ *
+ * Last, it prints and parses arrays of numbers, compared with the printf and strtod way
+ * cJSON printed and parsed them before. */
+
+#include <locale.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cJSON.h"
+#include "cJSON_Stream.h"
+#include "cJSON_Utils.h"
+
+#define BENCH_DEFAULT_ITERATIONS 20000
+/* chunk size of the streaming parser, as read from a socket */
+#define BENCH_STREAM_CHUNK 64
+
+/* heap accounting through the cJSON hooks */
+typedef union
+{
+    size_t size;
+    double align;
+} heap_header;
+
+static size_t heap_current;
+static size_t heap_peak;
+static size_t heap_allocations;
+
+static void *bench_malloc(size_t size)
+{
+    heap_header *header = (heap_header*)malloc(sizeof(heap_header) + size);
+
+    if (header == NULL)
+    {
+        return NULL;
+    }
+    header->size = size;
+    heap_current += size;
+    if (heap_current > heap_peak)
+    {
+        heap_peak = heap_current;
+    }
+    heap_allocations++;
+
+    return header + 1;
+}
+
+static void bench_free(void *pointer)
+{
+    heap_header *header = NULL;
+
+    if (pointer == NULL)
+    {
+        return;
+    }
+    header = (heap_header*)pointer - 1;
+    heap_current -= header->size;
+    free(header);
+}
+
+static void heap_reset(void)
+{
+    heap_peak = heap_current;
+    heap_allocations = 0;
+}
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+static size_t count_nodes(const cJSON *item)
+{
+    size_t nodes = 0;
+
+    for (; item != NULL; item = item->next)
+    {
+        nodes += 1 + count_nodes(item->child);
+    }
+
+    return nodes;
+}
+
+/* a webconfig/cloud shaped document of about 3 KB */
+static char *generate_document(void)
+{
+    cJSON *root = cJSON_CreateObject();
+    cJSON *networks = cJSON_AddArrayToObject(root, "networks");
+    cJSON *telemetry = cJSON_AddArrayToObject(root, "telemetry");
+    cJSON *device = cJSON_AddObjectToObject(root, "device");
+    char *text = NULL;
+    char name[32];
+    int i = 0;
+
+    cJSON_AddStringToObject(device, "id", "mw320-5c:f8:21:00:3a:7e");
+    cJSON_AddStringToObject(device, "firmware", "1.4.2 \"field\"\\build");
+    cJSON_AddNumberToObject(device, "uptime", 862411);
+    cJSON_AddTrueToObject(device, "provisioned");
+    cJSON_AddNullToObject(device, "owner");
+
+    for (i = 0; i < 12; i++)
+    {
+        cJSON *network = cJSON_CreateObject();
+        cJSON_AddItemToArray(networks, network);
+        sprintf(name, "ssid-%02d caf\xc3\xa9\t", i);
+        cJSON_AddStringToObject(network, "ssid", name);
+        cJSON_AddStringToObject(network, "security", (i & 1) ? "wpa2-psk" : "wpa3-sae");
+        cJSON_AddNumberToObject(network, "channel", 1 + (i % 11));
+        cJSON_AddNumberToObject(network, "rssi", -40 - i);
+        cJSON_AddBoolToObject(network, "hidden", i == 7);
+        cJSON_AddStringToObject(network, "bssid", "5c:f8:21:10:22:31");
+    }
+
+    for (i = 0; i < 40; i++)
+    {
+        cJSON *sample = cJSON_CreateObject();
+        cJSON_AddItemToArray(telemetry, sample);
+        cJSON_AddNumberToObject(sample, "t", 1700000000 + (i * 60));
+        cJSON_AddNumberToObject(sample, "temp", 21 + (i % 5));
+        cJSON_AddNumberToObject(sample, "rx", 1000 * i);
+    }
+
+    text = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+
+    return text;
+}
+
+static char *read_file(const char *path, size_t *length)
+{
+    FILE *file = fopen(path, "rb");
+    char *text = NULL;
+    long size = 0;
+
+    if (file == NULL)
+    {
+        return NULL;
+    }
+    if ((fseek(file, 0, SEEK_END) == 0) && ((size = ftell(file)) >= 0) && (fseek(file, 0, SEEK_SET) == 0))
+    {
+        text = (char*)malloc((size_t)size + 1);
+        if ((text != NULL) && (fread(text, 1, (size_t)size, file) != (size_t)size))
+        {
+            free(text);
+            text = NULL;
+        }
+    }
+    fclose(file);
+    if (text != NULL)
+    {
+        text[size] = '\0';
+        *length = (size_t)size;
+    }
+
+    return text;
+}
+
+typedef enum
+{
+    PARSE_DOM,
+    PARSE_ARENA_ALLOCATED,
+    PARSE_ARENA,
+    PARSE_ARENA_IN_PLACE,
+    PARSE_STREAM,
+    PARSE_STREAM_SELECT
+} parse_mode;
+
+static const char *const mode_names[] = { "cJSON_Parse", "arena (allocated)", "arena", "arena in place", "stream events", "stream to DOM" };
+
+/* events of the streaming parser that are nodes, i.e. not ends of objects and arrays */
+static size_t stream_nodes;
+
+static int stream_count(void *arg, const cJSONStream_Event *event)
+{
+    (void)arg;
+    if (!event->end && !event->partial)
+    {
+        stream_nodes++;
+    }
+
+    return 0;
+}
+
+/* feed the text in chunks, returns the whole tree if select is set, else a dummy non NULL item when all nodes were seen */
+static cJSON *parse_stream(const char *text, size_t length, cJSON_bool select)
+{
+    static cJSON counted;
+    const char *const paths[] = { "" };
+    cJSONStream_Selection selection;
+    cJSONStream stream;
+    cJSON *tree = NULL;
+    size_t offset = 0;
+
+    cJSONStream_InitSelection(&selection, paths, &tree, 1);
+    cJSONStream_Init(&stream, select ? cJSONStream_Select : stream_count, &selection);
+    stream_nodes = 0;
+    for (offset = 0; offset < length; offset += BENCH_STREAM_CHUNK)
+    {
+        size_t chunk = ((length - offset) < BENCH_STREAM_CHUNK) ? (length - offset) : BENCH_STREAM_CHUNK;
+        if (cJSONStream_Feed(&stream, text + offset, chunk) != CJSON_STREAM_OK)
+        {
+            break;
+        }
+    }
+    if (cJSONStream_Finish(&stream) != CJSON_STREAM_OK)
+    {
+        cJSON_Delete(tree);
+        return NULL;
+    }
+
+    return select ? tree : &counted;
+}
+
+/* parse once, return the tree and the nodes in it; work is the copy of the input for in place parsing */
+static cJSON *parse(parse_mode mode, const char *text, size_t length, char *work, void *arena, size_t arena_size)
+{
+    switch (mode)
+    {
+        case PARSE_DOM:
+            return cJSON_Parse(text);
+        case PARSE_ARENA_ALLOCATED:
+            return cJSON_ParseArena(text, length, NULL, 0, NULL);
+        case PARSE_ARENA:
+            return cJSON_ParseArena(text, length, arena, arena_size, NULL);
+        case PARSE_ARENA_IN_PLACE:
+            memcpy(work, text, length);
+            return cJSON_ParseArenaInPlace(work, length, arena, arena_size, NULL);
+        case PARSE_STREAM:
+            return parse_stream(text, length, 0);
+        case PARSE_STREAM_SELECT:
+            return parse_stream(text, length, 1);
+    }
+
+    return NULL;
+}
+
+static void release(parse_mode mode, cJSON *tree)
+{
+    if ((mode == PARSE_DOM) || (mode == PARSE_ARENA_ALLOCATED) || (mode == PARSE_STREAM_SELECT))
+    {
+        cJSON_Delete(tree);
+    }
+}
+
+static int bench_document(const char *label, const char *text, size_t length, long iterations)
+{
+    cJSON *reference = NULL;
+    size_t arena_size = cJSON_ArenaSize(text, length, 0);
+    void *arena = malloc(arena_size);
+    char *work = (char*)malloc(length + 1);
+    size_t nodes = 0;
+    int mode = 0;
+    int status = 0;
+
+    reference = cJSON_Parse(text);
+    if ((reference == NULL) || (arena == NULL) || (work == NULL))
+    {
+        printf("%s: cannot parse\n", label);
+        status = 1;
+        goto out;
+    }
+    nodes = count_nodes(reference);
+
+    printf("%s: %lu bytes, %lu nodes, arena %lu bytes (%lu in place), stream state %lu bytes\n", label, (unsigned long)length,
+           (unsigned long)nodes, (unsigned long)arena_size, (unsigned long)cJSON_ArenaSize(text, length, 1), (unsigned long)sizeof(cJSONStream));
+    printf("  %-18s %12s %10s %12s %12s\n", "parser", "nodes/s", "MB/s", "allocs/parse", "peak heap");
+
+    for (mode = PARSE_DOM; mode <= PARSE_STREAM_SELECT; mode++)
+    {
+        double start = 0;
+        double elapsed = 0;
+        size_t allocations = 0;
+        size_t peak = 0;
+        cJSON *tree = NULL;
+        long i = 0;
+
+        /* one parse checked against the reference, measuring its heap use */
+        heap_reset();
+        tree = parse((parse_mode)mode, text, length, work, arena, arena_size);
+        if ((tree == NULL) || ((mode == PARSE_STREAM) ? (stream_nodes != nodes) : !cJSON_Compare(tree, reference, 1)))
+        {
+            printf("  %-18s tree differs from cJSON_Parse\n", mode_names[mode]);
+            status = 1;
+            release((parse_mode)mode, tree);
+            continue;
+        }
+        release((parse_mode)mode, tree);
+        allocations = heap_allocations;
+        peak = heap_peak - heap_current;
+
+        start = now_seconds();
+        for (i = 0; i < iterations; i++)
+        {
+            release((parse_mode)mode, parse((parse_mode)mode, text, length, work, arena, arena_size));
+        }
+        elapsed = now_seconds() - start;
+
+        printf("  %-18s %12.0f %10.1f %12lu %12lu\n", mode_names[mode], ((double)nodes * (double)iterations) / elapsed,
+               ((double)length * (double)iterations) / elapsed / 1e6, (unsigned long)allocations, (unsigned long)peak);
+    }
+
+out:
+    cJSON_Delete(reference);
+    free(arena);
+    free(work);
+
+    return status;
+}
+
+/* lookups of the whole benchmark, whatever the size of the object */
+#define BENCH_LOOKUPS 200000L
+/* one in BENCH_PATCH_STRIDE keys is replaced, removed or added by the patches */
+#define BENCH_PATCH_STRIDE 10
+
+static cJSON *create_keyed_object(size_t keys)
+{
+    cJSON *object = cJSON_CreateObject();
+    char name[32];
+    size_t i = 0;
+
+    for (i = 0; i < keys; i++)
+    {
+        sprintf(name, "sensor-%05lu", (unsigned long)i);
+        cJSON_AddNumberToObject(object, name, (double)i);
+    }
+
+    return object;
+}
+
+/* what cJSON_GetObjectItemCaseSensitive() does without an index */
+static cJSON *walk_object(const cJSON *object, const char *name)
+{
+    cJSON *child = NULL;
+
+    for (child = object->child; (child != NULL) && (strcmp(child->string, name) != 0); child = child->next)
+    {
+    }
+
+    return child;
+}
+
+/* JSON patch and merge patch replacing, removing and adding one in BENCH_PATCH_STRIDE keys */
+static void create_patches(size_t keys, cJSON **patches, cJSON **merge_patch)
+{
+    char name[32];
+    char path[40];
+    size_t i = 0;
+
+    *patches = cJSON_CreateArray();
+    *merge_patch = cJSON_CreateObject();
+    for (i = 0; i < keys; i += BENCH_PATCH_STRIDE)
+    {
+        cJSON *patch = cJSON_CreateObject();
+        size_t which = (i / BENCH_PATCH_STRIDE) % 3;
+
+        sprintf(name, "sensor-%05lu", (unsigned long)((which == 2) ? (keys + i) : i));
+        sprintf(path, "/%s", name);
+        cJSON_AddStringToObject(patch, "op", (which == 0) ? "replace" : ((which == 1) ? "remove" : "add"));
+        cJSON_AddStringToObject(patch, "path", path);
+        if (which == 1)
+        {
+            cJSON_AddNullToObject(*merge_patch, name);
+        }
+        else
+        {
+            cJSON_AddNumberToObject(patch, "value", -1);
+            cJSON_AddNumberToObject(*merge_patch, name, -1);
+        }
+        cJSON_AddItemToArray(*patches, patch);
+    }
+}
+
+static int bench_lookups(size_t keys)
+{
+    cJSON *object = create_keyed_object(keys);
+    cJSON *patches = NULL;
+    cJSON *merge_patch = NULL;
+    char name[32];
+    long rounds = BENCH_LOOKUPS / (long)keys;
+    double start = 0;
+    double walk_time = 0;
+    double lookup_time = 0;
+    double patch_time = 0;
+    double merge_time = 0;
+    size_t heap_before = 0;
+    size_t index_heap = 0;
+    long round = 0;
+    size_t i = 0;
+    int status = 0;
+
+    /* create_keyed_object() has indexed it already, if at all: index it again to see what that takes */
+    cJSON_InvalidateIndex(object);
+    heap_before = heap_current;
+    cJSON_IndexObject(object);
+    index_heap = heap_current - heap_before;
+    for (i = 0; i < keys; i++)
+    {
+        sprintf(name, "sensor-%05lu", (unsigned long)i);
+        if (cJSON_GetObjectItemCaseSensitive(object, name) != walk_object(object, name))
+        {
+            status = 1;
+        }
+    }
+
+    start = now_seconds();
+    for (round = 0; round < rounds; round++)
+    {
+        for (i = 0; i < keys; i++)
+        {
+            sprintf(name, "sensor-%05lu", (unsigned long)i);
+            if (walk_object(object, name) == NULL)
+            {
+                status = 1;
+            }
+        }
+    }
+    walk_time = now_seconds() - start;
+
+    start = now_seconds();
+    for (round = 0; round < rounds; round++)
+    {
+        for (i = 0; i < keys; i++)
+        {
+            sprintf(name, "sensor-%05lu", (unsigned long)i);
+            if (cJSON_GetObjectItemCaseSensitive(object, name) == NULL)
+            {
+                status = 1;
+            }
+        }
+    }
+    lookup_time = now_seconds() - start;
+
+    /* each patch applied to a fresh copy, indexed by cJSON_Duplicate() */
+    create_patches(keys, &patches, &merge_patch);
+    rounds = (rounds + 9) / 10;
+    for (round = 0; round < rounds; round++)
+    {
+        cJSON *copy = cJSON_Duplicate(object, 1);
+
+        start = now_seconds();
+        if (cJSONUtils_ApplyPatchesCaseSensitive(copy, patches) != 0)
+        {
+            status = 1;
+        }
+        patch_time += now_seconds() - start;
+        cJSON_Delete(copy);
+
+        copy = cJSON_Duplicate(object, 1);
+        start = now_seconds();
+        copy = cJSONUtils_MergePatchCaseSensitive(copy, merge_patch);
+        merge_time += now_seconds() - start;
+        cJSON_Delete(copy);
+    }
+
+    printf("  %6lu keys %12.1f %12.1f %12.1f %12.1f %12lu\n", (unsigned long)keys,
+           (walk_time * 1e9) / ((double)(BENCH_LOOKUPS / (long)keys) * (double)keys),
+           (lookup_time * 1e9) / ((double)(BENCH_LOOKUPS / (long)keys) * (double)keys),
+           (patch_time * 1e6) / (double)rounds, (merge_time * 1e6) / (double)rounds, (unsigned long)index_heap);
+    if (status != 0)
+    {
+        printf("  %6lu keys: lookups or patches failed\n", (unsigned long)keys);
+    }
+
+    cJSON_Delete(patches);
+    cJSON_Delete(merge_patch);
+    cJSON_Delete(object);
+
+    return status;
+}
+
+/* numbers of the number benchmark: integers, sensor readings and any doubles */
+#define BENCH_NUMBERS 999
+
+/* what print_number() did for doubles before: "%1.15g", checked with sscanf, else "%1.17g" */
+static size_t print_number_printf(char *buffer, double number)
+{
+    double test = 0;
+    int length = sprintf(buffer, "%1.15g", number);
+
+    if ((sscanf(buffer, "%lg", &test) != 1) || (test != number))
+    {
+        length = sprintf(buffer, "%1.17g", number);
+    }
+
+    return (size_t)length;
+}
+
+/* what parse_number() did before: copy the number with the decimal point of the locale and strtod it,
+ * behind the same checks and cJSON item as cJSON_ParseNumber() */
+static size_t parse_number_strtod(const char *value, size_t length, double *number)
+{
+    char number_c_string[64];
+    char *after_end = NULL;
+    char decimal_point = *localeconv()->decimal_point;
+    cJSON item;
+    size_t i = 0;
+
+    if ((value == NULL) || (number == NULL) || (length == 0) || ((value[0] != '-') && ((value[0] < '0') || (value[0] > '9'))))
+    {
+        return 0;
+    }
+
+    memset(&item, '\0', sizeof(item));
+    for (i = 0; (i < (sizeof(number_c_string) - 1)) && (i < length); i++)
+    {
+        if (((value[i] >= '0') && (value[i] <= '9')) || (value[i] == '+') || (value[i] == '-') || (value[i] == 'e') || (value[i] == 'E'))
+        {
+            number_c_string[i] = value[i];
+        }
+        else if (value[i] == '.')
+        {
+            number_c_string[i] = decimal_point;
+        }
+        else
+        {
+            break;
+        }
+    }
+    number_c_string[i] = '\0';
+
+    item.valuedouble = strtod(number_c_string, &after_end);
+    if (after_end == number_c_string)
+    {
+        return 0;
+    }
+    if (item.valuedouble >= 2147483647.0)
+    {
+        item.valueint = 2147483647;
+    }
+    else if (item.valuedouble <= -2147483648.0)
+    {
+        item.valueint = -2147483647 - 1;
+    }
+    else
+    {
+        item.valueint = (int)item.valuedouble;
+    }
+    item.type = cJSON_Number;
+    *number = item.valuedouble;
+
+    return (size_t)(after_end - number_c_string);
+}
+
+/* parse the numbers of text, an array printed by cJSON, adding them to sum; returns how many differ from expected */
+static int parse_numbers(size_t (*parse)(const char *, size_t, double *), const char *text, const cJSON *expected, double *sum)
+{
+    const char *end = text + strlen(text);
+    const char *number = text + 1;
+    int mismatches = 0;
+
+    for (; expected != NULL; expected = expected->next)
+    {
+        double value = 0;
+        size_t length = parse(number, (size_t)(end - number), &value);
+
+        if ((length == 0) || (value != expected->valuedouble))
+        {
+            mismatches++;
+        }
+        *sum += value;
+        /* skip the ',' or ']' */
+        number += length + 1;
+    }
+
+    return mismatches;
+}
+
+static int bench_numbers(long iterations)
+{
+    cJSON *array = cJSON_CreateArray();
+    cJSON *parsed = NULL;
+    char *text = NULL;
+    char buffer[32];
+    unsigned long random = 12345;
+    double start = 0;
+    double print_time = 0;
+    double printf_time = 0;
+    double parse_time = 0;
+    double parse_number_time = 0;
+    double strtod_time = 0;
+    double sum = 0;
+    int mismatches = 0;
+    long i = 0;
+    int status = 0;
+    int n = 0;
+
+    for (n = 0; n < BENCH_NUMBERS; n++)
+    {
+        random = (random * 1103515245UL) + 12345UL;
+        switch (n % 3)
+        {
+            case 0:
+                cJSON_AddItemToArray(array, cJSON_CreateNumber((double)(random % 100000)));
+                break;
+            case 1:
+                cJSON_AddItemToArray(array, cJSON_CreateNumber((double)((long)(random % 10000) - 4000) / 100));
+                break;
+            default:
+                cJSON_AddItemToArray(array, cJSON_CreateNumber((double)random / 7.0e3 * ((n & 8) ? 1e-9 : 1e9)));
+                break;
+        }
+    }
+
+    iterations = (iterations / 20) + 1;
+    start = now_seconds();
+    for (i = 0; i < iterations; i++)
+    {
+        cJSON_free(text);
+        text = cJSON_PrintUnformatted(array);
+    }
+    print_time = now_seconds() - start;
+
+    start = now_seconds();
+    for (i = 0; i < iterations; i++)
+    {
+        const cJSON *item = NULL;
+
+        for (item = array->child; item != NULL; item = item->next)
+        {
+            sum += (double)print_number_printf(buffer, item->valuedouble);
+        }
+    }
+    printf_time = now_seconds() - start;
+
+    start = now_seconds();
+    for (i = 0; i < iterations; i++)
+    {
+        cJSON_Delete(parsed);
+        parsed = cJSON_Parse(text);
+    }
+    parse_time = now_seconds() - start;
+
+    /* the number parsers alone, on the numbers of the parsed text */
+    start = now_seconds();
+    for (i = 0; i < iterations; i++)
+    {
+        mismatches += parse_numbers(cJSON_ParseNumber, text, array->child, &sum);
+    }
+    parse_number_time = now_seconds() - start;
+
+    start = now_seconds();
+    for (i = 0; i < iterations; i++)
+    {
+        mismatches += parse_numbers(parse_number_strtod, text, array->child, &sum);
+    }
+    strtod_time = now_seconds() - start;
+
+    if ((parsed == NULL) || !cJSON_Compare(parsed, array, 1) || (mismatches != 0))
+    {
+        printf("numbers: round trip failed\n");
+        status = 1;
+    }
+
+    printf("numbers: %d in %lu bytes (checksum %g)\n", BENCH_NUMBERS, (unsigned long)strlen(text), sum);
+    printf("  %-18s %12s\n", "", "ns/number");
+    printf("  %-18s %12.1f\n", "print", (print_time * 1e9) / ((double)iterations * BENCH_NUMBERS));
+    printf("  %-18s %12.1f\n", "printf reference", (printf_time * 1e9) / ((double)iterations * BENCH_NUMBERS));
+    printf("  %-18s %12.1f\n", "parse", (parse_time * 1e9) / ((double)iterations * BENCH_NUMBERS));
+    printf("  %-18s %12.1f\n", "parse_number", (parse_number_time * 1e9) / ((double)iterations * BENCH_NUMBERS));
+    printf("  %-18s %12.1f\n", "strtod reference", (strtod_time * 1e9) / ((double)iterations * BENCH_NUMBERS));
+
+    cJSON_free(text);
+    cJSON_Delete(parsed);
+    cJSON_Delete(array);
+
+    return status;
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t lookup_keys[] = { 100, 1000, 10000 };
+    cJSON_Hooks hooks = { bench_malloc, bench_free };
+    long iterations = BENCH_DEFAULT_ITERATIONS;
+    int status = 0;
+    int files = 0;
+    int i = 0;
+
+    cJSON_InitHooks(&hooks);
+
+    for (i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-n") == 0) && ((i + 1) < argc))
+        {
+            iterations = strtol(argv[++i], NULL, 10);
+        }
+        else
+        {
+            size_t length = 0;
+            char *text = read_file(argv[i], &length);
+
+            files++;
+            if (text == NULL)
+            {
+                printf("%s: cannot read\n", argv[i]);
+                status = 1;
+                continue;
+            }
+            status |= bench_document(argv[i], text, length, iterations);
+            free(text);
+        }
+    }
+
+    if (files == 0)
+    {
+        char *text = generate_document();
+
+        status |= bench_document("generated", text, strlen(text), iterations);
+        cJSON_free(text);
+    }
+
+#ifdef CJSON_OBJECT_INDEX
+    printf("object lookups, with key index (CJSON_OBJECT_INDEX_MIN %d)\n", CJSON_OBJECT_INDEX_MIN);
+#else
+    printf("object lookups, without key index\n");
+#endif
+    printf("  %11s %12s %12s %12s %12s %12s\n", "object", "walk ns", "lookup ns", "patch us", "merge us", "index heap");
+    for (i = 0; i < (int)(sizeof(lookup_keys) / sizeof(lookup_keys[0])); i++)
+    {
+        status |= bench_lookups(lookup_keys[i]);
+    }
+
+    status |= bench_numbers(iterations);
+
+    return status;
+}
@@ -0,0 +1,401 @@
+/*
+  Copyright 2026 NXP
+
+  SPDX-License-Identifier: MIT
+*/
+
+/* Host benchmark of the bindings generated by scripts/cjson_bindgen.py against the DOM path.
+ *
+ * Build and run from middleware/cjson:
+ *   python3 scripts/cjson_bindgen.py bench/cjson_demo.schema.json -o bindings
+ *   python3 scripts/cjson_bindgen.py bench/webconfig_scan.schema.json -o bindings
+ *   cc -O2 -I. -Ibindings bench/cjson_bind_bench.c bindings/cjson_demo.c bindings/webconfig_scan.c cJSON_Bind.c cJSON.c -lm -o cjson_bind_bench
+ *   ./cjson_bind_bench [-n iterations]
+ *
+ * The documents are the ones of the cjson demo and of the webconfig scan reply (16 networks). The DOM path
+ * prints by building cJSON items and calling cJSON_PrintPreallocated(), and parses by calling cJSON_Parse() and
+ * walking the tree with cJSON_GetObjectItemCaseSensitive() and type checks into the same structures, as the
+ * applications do by hand. Both paths must give the same text and the same structures. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cJSON.h"
+#include "cjson_demo.h"
+#include "webconfig_scan.h"
+
+#define BENCH_DEFAULT_ITERATIONS 20000
+
+/* heap accounting through the cJSON hooks */
+typedef union
+{
+    size_t size;
+    double align;
+} heap_header;
+
+static size_t heap_current;
+static size_t heap_peak;
+static size_t heap_allocations;
+
+static void *bench_malloc(size_t size)
+{
+    heap_header *header = (heap_header*)malloc(sizeof(heap_header) + size);
+
+    if (header == NULL)
+    {
+        return NULL;
+    }
+    header->size = size;
+    heap_current += size;
+    if (heap_current > heap_peak)
+    {
+        heap_peak = heap_current;
+    }
+    heap_allocations++;
+
+    return header + 1;
+}
+
+static void bench_free(void *pointer)
+{
+    heap_header *header = NULL;
+
+    if (pointer == NULL)
+    {
+        return;
+    }
+    header = (heap_header*)pointer - 1;
+    heap_current -= header->size;
+    free(header);
+}
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+/* copy a string item into a buffer, as the applications do */
+static int copy_string(const cJSON *item, char *buffer, size_t size)
+{
+    if (!cJSON_IsString(item) || (strlen(item->valuestring) >= size))
+    {
+        return 0;
+    }
+    strcpy(buffer, item->valuestring);
+
+    return 1;
+}
+
+static void fill_demo(cjson_demo *demo)
+{
+    static const char *const strings[] = { "This", "is", "cJSON", "demo" };
+    size_t i = 0;
+
+    memset(demo, 0, sizeof(*demo));
+    demo->sdk_version = 2;
+    strcpy(demo->cjson_version, cJSON_Version());
+    strcpy(demo->example_info.category, "demo_apps");
+    strcpy(demo->example_info.name, "cjson");
+    demo->demo_strings_count = 4;
+    for (i = 0; i < 4; i++)
+    {
+        strcpy(demo->demo_strings[i], strings[i]);
+    }
+}
+
+static cJSON *demo_to_dom(const cjson_demo *demo)
+{
+    cJSON *root = cJSON_CreateObject();
+    cJSON *info = NULL;
+    cJSON *strings = NULL;
+    size_t i = 0;
+
+    cJSON_AddNumberToObject(root, "sdk version", demo->sdk_version);
+    cJSON_AddStringToObject(root, "cJSON version", demo->cjson_version);
+    info = cJSON_AddObjectToObject(root, "example info");
+    cJSON_AddStringToObject(info, "category", demo->example_info.category);
+    cJSON_AddStringToObject(info, "name", demo->example_info.name);
+    strings = cJSON_AddArrayToObject(root, "demo strings");
+    for (i = 0; i < demo->demo_strings_count; i++)
+    {
+        cJSON_AddItemToArray(strings, cJSON_CreateString(demo->demo_strings[i]));
+    }
+
+    return root;
+}
+
+static int demo_from_dom(const cJSON *root, cjson_demo *demo)
+{
+    const cJSON *version = cJSON_GetObjectItemCaseSensitive(root, "sdk version");
+    const cJSON *info = cJSON_GetObjectItemCaseSensitive(root, "example info");
+    const cJSON *strings = cJSON_GetObjectItemCaseSensitive(root, "demo strings");
+    const cJSON *string = NULL;
+
+    memset(demo, 0, sizeof(*demo));
+    if (!cJSON_IsNumber(version) || !cJSON_IsObject(info) || !cJSON_IsArray(strings)
+        || !copy_string(cJSON_GetObjectItemCaseSensitive(root, "cJSON version"), demo->cjson_version, sizeof(demo->cjson_version))
+        || !copy_string(cJSON_GetObjectItemCaseSensitive(info, "category"), demo->example_info.category, sizeof(demo->example_info.category))
+        || !copy_string(cJSON_GetObjectItemCaseSensitive(info, "name"), demo->example_info.name, sizeof(demo->example_info.name)))
+    {
+        return 0;
+    }
+    demo->sdk_version = version->valueint;
+    cJSON_ArrayForEach(string, strings)
+    {
+        if ((demo->demo_strings_count == 4) || !copy_string(string, demo->demo_strings[demo->demo_strings_count], sizeof(demo->demo_strings[0])))
+        {
+            return 0;
+        }
+        demo->demo_strings_count++;
+    }
+
+    return 1;
+}
+
+static void fill_scan(webconfig_scan *scan)
+{
+    static const char *const securities[] = { "WPA2 ", "WPA WPA2 ", "WPA3_SAE ", "", "WPA2_ENTP WPA2 " };
+    size_t i = 0;
+
+    memset(scan, 0, sizeof(*scan));
+    scan->networks_count = 16;
+    for (i = 0; i < scan->networks_count; i++)
+    {
+        webconfig_network *network = &scan->networks[i];
+
+        snprintf(network->ssid, sizeof(network->ssid), (i == 3) ? "Cafe \"Le Wi\\Fi\" %u" : "nxp-guest-%u", (unsigned)i);
+        snprintf(network->bssid, sizeof(network->bssid), "A4:2B:B0:%02X:%02X:%02X", (unsigned)((i * 7) & 0xFF),
+                 (unsigned)((i * 13) & 0xFF), (unsigned)((i * 29) & 0xFF));
+        snprintf(network->signal, sizeof(network->signal), "-%udBm", 40 + ((unsigned)i * 3) % 60);
+        network->channel = 1 + (int32_t)((i * 5) % 13);
+        strcpy(network->security, securities[i % 5]);
+    }
+}
+
+static cJSON *scan_to_dom(const webconfig_scan *scan)
+{
+    cJSON *root = cJSON_CreateObject();
+    cJSON *networks = cJSON_AddArrayToObject(root, "networks");
+    size_t i = 0;
+
+    for (i = 0; i < scan->networks_count; i++)
+    {
+        const webconfig_network *network = &scan->networks[i];
+        cJSON *item = cJSON_CreateObject();
+
+        cJSON_AddStringToObject(item, "ssid", network->ssid);
+        cJSON_AddStringToObject(item, "bssid", network->bssid);
+        cJSON_AddStringToObject(item, "signal", network->signal);
+        cJSON_AddNumberToObject(item, "channel", network->channel);
+        cJSON_AddStringToObject(item, "security", network->security);
+        cJSON_AddItemToArray(networks, item);
+    }
+
+    return root;
+}
+
+static int scan_from_dom(const cJSON *root, webconfig_scan *scan)
+{
+    const cJSON *networks = cJSON_GetObjectItemCaseSensitive(root, "networks");
+    const cJSON *item = NULL;
+
+    memset(scan, 0, sizeof(*scan));
+    if (!cJSON_IsArray(networks))
+    {
+        return 0;
+    }
+    cJSON_ArrayForEach(item, networks)
+    {
+        webconfig_network *network = &scan->networks[scan->networks_count];
+        const cJSON *channel = cJSON_GetObjectItemCaseSensitive(item, "channel");
+
+        if ((scan->networks_count == 16) || !cJSON_IsNumber(channel)
+            || !copy_string(cJSON_GetObjectItemCaseSensitive(item, "ssid"), network->ssid, sizeof(network->ssid))
+            || !copy_string(cJSON_GetObjectItemCaseSensitive(item, "bssid"), network->bssid, sizeof(network->bssid))
+            || !copy_string(cJSON_GetObjectItemCaseSensitive(item, "signal"), network->signal, sizeof(network->signal))
+            || !copy_string(cJSON_GetObjectItemCaseSensitive(item, "security"), network->security, sizeof(network->security)))
+        {
+            return 0;
+        }
+        network->channel = channel->valueint;
+        scan->networks_count++;
+    }
+
+    return 1;
+}
+
+/* one document through both paths */
+typedef struct
+{
+    const char *label;
+    size_t size; /* of the structure */
+    size_t print_size; /* <NAME>_PRINT_SIZE */
+    void (*fill)(void *value);
+    cJSON *(*to_dom)(const void *value);
+    int (*from_dom)(const cJSON *root, void *value);
+    int (*parse)(void *value, const char *json, size_t length);
+    int (*print)(const void *value, char *buffer, size_t size);
+} bench_document;
+
+/* adapters to the void pointers */
+static void fill_demo_v(void *value) { fill_demo((cjson_demo*)value); }
+static cJSON *demo_to_dom_v(const void *value) { return demo_to_dom((const cjson_demo*)value); }
+static int demo_from_dom_v(const cJSON *root, void *value) { return demo_from_dom(root, (cjson_demo*)value); }
+static int demo_parse_v(void *value, const char *json, size_t length) { return cjson_demo_parse((cjson_demo*)value, json, length); }
+static int demo_print_v(const void *value, char *buffer, size_t size) { return cjson_demo_print((const cjson_demo*)value, buffer, size); }
+static void fill_scan_v(void *value) { fill_scan((webconfig_scan*)value); }
+static cJSON *scan_to_dom_v(const void *value) { return scan_to_dom((const webconfig_scan*)value); }
+static int scan_from_dom_v(const cJSON *root, void *value) { return scan_from_dom(root, (webconfig_scan*)value); }
+static int scan_parse_v(void *value, const char *json, size_t length) { return webconfig_scan_parse((webconfig_scan*)value, json, length); }
+static int scan_print_v(const void *value, char *buffer, size_t size) { return webconfig_scan_print((const webconfig_scan*)value, buffer, size); }
+
+static int bench(const bench_document *document, long iterations)
+{
+    void *value = calloc(1, document->size);
+    void *parsed = calloc(1, document->size);
+    char *dom_text = (char*)malloc(document->print_size + 5);
+    char *bind_text = (char*)malloc(document->print_size);
+    size_t length = 0;
+    double start = 0;
+    double dom_print = 0;
+    double bind_print = 0;
+    double dom_parse = 0;
+    double bind_parse = 0;
+    size_t print_heap = 0;
+    size_t print_allocations = 0;
+    size_t parse_heap = 0;
+    size_t parse_allocations = 0;
+    long i = 0;
+    int status = 0;
+
+    document->fill(value);
+
+    /* both paths give the same text and the same structure */
+    {
+        cJSON *root = document->to_dom(value);
+        int printed = 0;
+
+        cJSON_PrintPreallocated(root, dom_text, (int)document->print_size + 5, 0);
+        cJSON_Delete(root);
+        printed = document->print(value, bind_text, document->print_size);
+        if ((printed < 0) || (strcmp(dom_text, bind_text) != 0))
+        {
+            fprintf(stderr, "%s: printed\n%s\ninstead of\n%s\n", document->label, bind_text, dom_text);
+            status = 1;
+        }
+        length = strlen(dom_text);
+        if ((document->parse(parsed, dom_text, length) != CJSON_BIND_OK) || (memcmp(parsed, value, document->size) != 0))
+        {
+            fprintf(stderr, "%s: parsed differently\n", document->label);
+            status = 1;
+        }
+        root = cJSON_Parse(dom_text);
+        if (!document->from_dom(root, parsed) || (memcmp(parsed, value, document->size) != 0))
+        {
+            fprintf(stderr, "%s: DOM walk parsed differently\n", document->label);
+            status = 1;
+        }
+        cJSON_Delete(root);
+        /* and a buffer one byte too small is an error */
+        if (document->print(value, bind_text, length) != CJSON_BIND_ERROR_BUFFER)
+        {
+            fprintf(stderr, "%s: printed into a too small buffer\n", document->label);
+            status = 1;
+        }
+    }
+
+    heap_peak = heap_current;
+    heap_allocations = 0;
+    start = now_seconds();
+    for (i = 0; i < iterations; i++)
+    {
+        cJSON *root = document->to_dom(value);
+
+        cJSON_PrintPreallocated(root, dom_text, (int)document->print_size + 5, 0);
+        cJSON_Delete(root);
+    }
+    dom_print = now_seconds() - start;
+    print_heap = heap_peak - heap_current;
+    print_allocations = heap_allocations / (size_t)iterations;
+
+    start = now_seconds();
+    for (i = 0; i < iterations; i++)
+    {
+        document->print(value, bind_text, document->print_size);
+    }
+    bind_print = now_seconds() - start;
+
+    heap_peak = heap_current;
+    heap_allocations = 0;
+    start = now_seconds();
+    for (i = 0; i < iterations; i++)
+    {
+        cJSON *root = cJSON_Parse(dom_text);
+
+        document->from_dom(root, parsed);
+        cJSON_Delete(root);
+    }
+    dom_parse = now_seconds() - start;
+    parse_heap = heap_peak - heap_current;
+    parse_allocations = heap_allocations / (size_t)iterations;
+
+    start = now_seconds();
+    for (i = 0; i < iterations; i++)
+    {
+        document->parse(parsed, dom_text, length);
+    }
+    bind_parse = now_seconds() - start;
+
+    printf("%s: %u bytes of JSON, %u bytes of structure, print buffer bound %u bytes\n", document->label,
+           (unsigned)length, (unsigned)document->size, (unsigned)document->print_size);
+    printf("  print  DOM %8.0f ns (heap peak %5u bytes, %3u allocations)   bindings %8.0f ns   x%.1f\n",
+           dom_print * 1e9 / (double)iterations, (unsigned)print_heap, (unsigned)print_allocations,
+           bind_print * 1e9 / (double)iterations, dom_print / bind_print);
+    printf("  parse  DOM %8.0f ns (heap peak %5u bytes, %3u allocations)   bindings %8.0f ns   x%.1f\n",
+           dom_parse * 1e9 / (double)iterations, (unsigned)parse_heap, (unsigned)parse_allocations,
+           bind_parse * 1e9 / (double)iterations, dom_parse / bind_parse);
+
+    free(value);
+    free(parsed);
+    free(dom_text);
+    free(bind_text);
+
+    return status;
+}
+
+int main(int argc, char **argv)
+{
+    static const bench_document documents[] =
+    {
+        { "cjson demo", sizeof(cjson_demo), CJSON_DEMO_PRINT_SIZE, fill_demo_v, demo_to_dom_v, demo_from_dom_v, demo_parse_v, demo_print_v },
+        { "webconfig scan", sizeof(webconfig_scan), WEBCONFIG_SCAN_PRINT_SIZE, fill_scan_v, scan_to_dom_v, scan_from_dom_v, scan_parse_v, scan_print_v }
+    };
+    cJSON_Hooks hooks = { bench_malloc, bench_free };
+    long iterations = BENCH_DEFAULT_ITERATIONS;
+    int status = 0;
+    size_t i = 0;
+
+    if ((argc == 3) && (strcmp(argv[1], "-n") == 0))
+    {
+        iterations = strtol(argv[2], NULL, 10);
+    }
+    if (iterations < 1)
+    {
+        iterations = 1;
+    }
+
+    cJSON_InitHooks(&hooks);
+
+    for (i = 0; i < sizeof(documents) / sizeof(documents[0]); i++)
+    {
+        status |= bench(&documents[i], iterations);
+    }
+
+    return status;
+}
@@ -0,0 +1,253 @@
+/*
+  Copyright 2026 NXP
+
+  SPDX-License-Identifier: MIT
+*/
+
+/* Host round trip test of the cJSON number printer and parser.
+ *
+ * Build and run from middleware/cjson:
+ *   cc -O2 -I. bench/cjson_number_fuzz.c cJSON.c -lm -o cjson_number_fuzz
+ *   ./cjson_number_fuzz [-n iterations] [-s seed]
+ *
+ * Every printed number must parse back to the same double, and every number text must
+ * parse to what strtod reads from it, consuming as many characters. It also counts the
+ * printed numbers that have more digits than the shortest ones that read back (found with
+ * printf and strtod): there are a few, Grisu2 is not always optimal. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "cJSON.h"
+
+#define FUZZ_DEFAULT_ITERATIONS 1000000L
+/* longer number texts are cut by parse_number(), unlike strtod */
+#define FUZZ_MAX_TEXT 62
+
+static unsigned long long fuzz_state = 88172645463325252ULL;
+
+/* xorshift64 */
+static unsigned long long fuzz_random(void)
+{
+    fuzz_state ^= fuzz_state << 13;
+    fuzz_state ^= fuzz_state >> 7;
+    fuzz_state ^= fuzz_state << 17;
+
+    return fuzz_state;
+}
+
+static long printed;
+static long not_shortest;
+
+/* fewest significant digits that read back to number */
+static int shortest_digits(double number)
+{
+    char text[32];
+    int digits = 0;
+
+    for (digits = 1; digits < 17; digits++)
+    {
+        sprintf(text, "%.*e", digits - 1, number);
+        if (strtod(text, NULL) == number)
+        {
+            break;
+        }
+    }
+
+    return digits;
+}
+
+/* significant digits of a printed number */
+static int printed_digits(const char *text)
+{
+    const char *end = strchr(text, 'e');
+    const char *first = text;
+    int digits = 0;
+
+    if (end == NULL)
+    {
+        end = text + strlen(text);
+    }
+    /* without leading and trailing zeros */
+    while ((first < end) && ((*first == '-') || (*first == '0') || (*first == '.')))
+    {
+        first++;
+    }
+    while ((end > first) && ((end[-1] == '0') || (end[-1] == '.')))
+    {
+        end--;
+    }
+    for (; first < end; first++)
+    {
+        if (*first != '.')
+        {
+            digits++;
+        }
+    }
+
+    return digits;
+}
+
+static int check_print(double number)
+{
+    cJSON *item = cJSON_CreateNumber(number);
+    cJSON *parsed = NULL;
+    char *text = NULL;
+    int status = 0;
+
+    text = cJSON_PrintUnformatted(item);
+    if (text == NULL)
+    {
+        printf("cannot print %.17g\n", number);
+        cJSON_Delete(item);
+        return 1;
+    }
+
+    parsed = cJSON_Parse(text);
+    if ((number * 0) != 0)
+    {
+        if (strcmp(text, "null") != 0)
+        {
+            printf("%.17g printed as %s\n", number, text);
+            status = 1;
+        }
+    }
+    else if ((parsed == NULL) || (parsed->valuedouble != number))
+    {
+        printf("%.17g printed as %s reads back as %.17g\n", number, text, (parsed != NULL) ? parsed->valuedouble : 0.0);
+        status = 1;
+    }
+    else if (strlen(text) > 24)
+    {
+        printf("%.17g printed as %s, too long\n", number, text);
+        status = 1;
+    }
+    else if ((number != 0) && (number != (double)item->valueint))
+    {
+        printed++;
+        if (printed_digits(text) > shortest_digits(number))
+        {
+            not_shortest++;
+        }
+    }
+
+    cJSON_free(text);
+    cJSON_Delete(item);
+    cJSON_Delete(parsed);
+
+    return status;
+}
+
+static int check_parse(const char *text)
+{
+    const char *end = NULL;
+    char *strtod_end = NULL;
+    cJSON *item = cJSON_ParseWithOpts(text, &end, 0);
+    double expected = strtod(text, &strtod_end);
+    int status = 0;
+
+    if (item == NULL)
+    {
+        /* parse_value() only takes numbers that start with '-' or a digit */
+        if ((strtod_end != text) && ((text[0] == '-') || ((text[0] >= '0') && (text[0] <= '9'))))
+        {
+            printf("%s rejected\n", text);
+            status = 1;
+        }
+        return status;
+    }
+
+    if ((memcmp(&item->valuedouble, &expected, sizeof(expected)) != 0) || (end != strtod_end))
+    {
+        printf("%s parsed as %.17g (%d characters), strtod %.17g (%d characters)\n", text, item->valuedouble,
+               (int)(end - text), expected, (int)(strtod_end - text));
+        status = 1;
+    }
+    cJSON_Delete(item);
+
+    return status;
+}
+
+int main(int argc, char **argv)
+{
+    static const double numbers[] =
+    {
+        0.0, -0.0, 1.0, -1.0, 0.1, 0.2, 0.3, 1.5, 100.0, 1e-4, 1e-5, 1e-7, 1e16, 1e17, 1e21, 1e22, 1e23,
+        5e-324, 2.2250738585072009e-308, 2.2250738585072014e-308, 1.7976931348623157e308,
+        9007199254740992.0, 9007199254740993.0, 2147483647.0, 2147483648.0, -2147483648.0, -2147483649.0
+    };
+    static const char *const texts[] =
+    {
+        "0", "-0", "1.", "-.5", "01", "1e", "1e+", "1e-2x", "1.2.3", "1E5", "0.1e1", "0e99999", "1e99999",
+        "-", "-x", "1e22", "1e23", "123e-22", "123e-23", "9007199254740992", "9007199254740993",
+        "1234567890123456789", "12345678901234567890", "4.9e-324", "1.7976931348623157e308"
+    };
+    static const char number_characters[] = "0123456789.eE+-0123456789";
+    long iterations = FUZZ_DEFAULT_ITERATIONS;
+    long i = 0;
+    int status = 0;
+
+    for (i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-n") == 0) && ((i + 1) < argc))
+        {
+            iterations = strtol(argv[++i], NULL, 10);
+        }
+        else if ((strcmp(argv[i], "-s") == 0) && ((i + 1) < argc))
+        {
+            fuzz_state = strtoull(argv[++i], NULL, 10) | 1;
+        }
+    }
+
+    for (i = 0; i < (long)(sizeof(numbers) / sizeof(numbers[0])); i++)
+    {
+        status |= check_print(numbers[i]);
+    }
+    for (i = 0; i < (long)(sizeof(texts) / sizeof(texts[0])); i++)
+    {
+        status |= check_parse(texts[i]);
+    }
+
+    for (i = 0; (i < iterations) && (status == 0); i++)
+    {
+        unsigned long long bits = fuzz_random();
+        char text[FUZZ_MAX_TEXT + 1];
+        size_t length = 0;
+        size_t j = 0;
+        double number = 0;
+
+        /* any double, including NaN, infinities and subnormals */
+        memcpy(&number, &bits, sizeof(number));
+        status |= check_print(number);
+
+        /* decimals as sensors report them, after some arithmetic */
+        number = ((double)(long long)(fuzz_random() % 2000000001ULL) / pow(10, (double)(fuzz_random() % 12))) - 1000;
+        status |= check_print(number);
+        status |= check_print((double)(int)fuzz_random());
+        status |= check_print((double)(long long)(fuzz_random() >> (fuzz_random() % 64)));
+
+        /* texts of number characters */
+        length = 1 + (size_t)(fuzz_random() % 30);
+        for (j = 0; j < length; j++)
+        {
+            text[j] = number_characters[fuzz_random() % (sizeof(number_characters) - 1)];
+        }
+        text[length] = '\0';
+        status |= check_parse(text);
+
+        /* numbers printed by printf */
+        number *= pow(10, (double)(int)(fuzz_random() % 80) - 40);
+        if ((number * 0) == 0)
+        {
+            sprintf(text, "%.*g", 1 + (int)(fuzz_random() % 17), number);
+            status |= check_parse(text);
+        }
+    }
+
+    printf("%ld iterations: %s, %ld of %ld printed non integers longer than the shortest\n", i, (status == 0) ? "ok" : "FAILED",
+           not_shortest, printed);
+
+    return status;
+}
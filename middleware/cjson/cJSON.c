@@ -43,6 +43,8 @@
 #include <stdlib.h>
 #include <limits.h>
 #include <ctype.h>
+#include <float.h>
+#include <stdint.h>
 
 #ifdef ENABLE_LOCALES
 #include <locale.h>
@@ -210,6 +212,205 @@ static cJSON *cJSON_New_Item(const internal_hooks * const hooks)
     return node;
 }
 
+#ifdef CJSON_OBJECT_INDEX
+/* Key index of an object: open addressing with linear probing on a hash of the lower cased key, so that the case
+ * sensitive and the case insensitive lookups share it. Items are never moved within the table and removed ones leave
+ * their slot behind, so the items with the same key are met in the order of the list, and the first one found is the
+ * one a walk of the list would have returned. */
+typedef struct
+{
+    unsigned long hash;
+    cJSON *item;
+} key_index_slot;
+
+typedef struct cJSON_KeyIndex
+{
+    /* number of slots, a power of two */
+    size_t size;
+    /* slots taken, including the ones of removed items */
+    size_t used;
+    /* last child of the object, for appending without walking the list */
+    cJSON *last;
+    key_index_slot *slots;
+} cJSON_KeyIndex;
+
+/* the index of the items of an arena, which must not get one as they are never cJSON_Delete()d */
+static cJSON_KeyIndex no_key_index;
+/* the item of a slot whose item was removed */
+static cJSON removed_key;
+
+static unsigned long hash_key(const unsigned char *key)
+{
+    unsigned long hash = 2166136261UL;
+
+    for (; *key != '\0'; key++)
+    {
+        hash = (hash ^ (unsigned long)tolower(*key)) * 16777619UL;
+    }
+
+    return hash;
+}
+
+static cJSON_bool has_key_index(const cJSON * const object)
+{
+    return (object->key_index != NULL) && (object->key_index != &no_key_index);
+}
+
+static void key_index_free(cJSON * const object)
+{
+    if (has_key_index(object))
+    {
+        global_hooks.deallocate(object->key_index);
+        object->key_index = NULL;
+    }
+}
+
+/* add item after the items with the same hash, fails if the index would get too full */
+static cJSON_bool key_index_insert(cJSON_KeyIndex * const index, cJSON * const item)
+{
+    unsigned long hash = 0;
+    size_t slot = 0;
+
+    if (item->string == NULL)
+    {
+        /* can't be looked up */
+        return true;
+    }
+    if (((index->used + 1) * 4) > (index->size * 3))
+    {
+        return false;
+    }
+
+    hash = hash_key((const unsigned char*)item->string);
+    for (slot = hash & (index->size - 1); index->slots[slot].item != NULL; slot = (slot + 1) & (index->size - 1))
+    {
+    }
+    index->slots[slot].hash = hash;
+    index->slots[slot].item = item;
+    index->used++;
+
+    return true;
+}
+
+/* index object if it has at least min_children children and no index yet */
+static cJSON_bool key_index_build(cJSON * const object, const size_t min_children)
+{
+    cJSON_KeyIndex *index = NULL;
+    cJSON *child = NULL;
+    size_t count = 0;
+    size_t size = 2 * CJSON_OBJECT_INDEX_MIN;
+
+    if (!cJSON_IsObject(object) || (object->type & cJSON_IsReference) || (object->key_index != NULL))
+    {
+        /* a reference shares the children of another object, which would not keep its index up to date */
+        return has_key_index(object);
+    }
+
+    for (child = object->child; child != NULL; child = child->next)
+    {
+        count++;
+    }
+    if (count < min_children)
+    {
+        return false;
+    }
+    /* at most half full */
+    while (size < (2 * count))
+    {
+        size *= 2;
+    }
+
+    index = (cJSON_KeyIndex*)global_hooks.allocate(sizeof(cJSON_KeyIndex) + (size * sizeof(key_index_slot)));
+    if (index == NULL)
+    {
+        /* lookups keep walking the list */
+        return false;
+    }
+    index->size = size;
+    index->used = 0;
+    index->last = NULL;
+    index->slots = (key_index_slot*)(index + 1);
+    memset(index->slots, '\0', size * sizeof(key_index_slot));
+
+    for (child = object->child; child != NULL; child = child->next)
+    {
+        key_index_insert(index, child);
+        index->last = child;
+    }
+
+    object->key_index = index;
+
+    return true;
+}
+
+static cJSON *key_index_find(const cJSON_KeyIndex * const index, const char * const name, const cJSON_bool case_sensitive)
+{
+    unsigned long hash = hash_key((const unsigned char*)name);
+    size_t slot = 0;
+
+    for (slot = hash & (index->size - 1); index->slots[slot].item != NULL; slot = (slot + 1) & (index->size - 1))
+    {
+        const cJSON *item = index->slots[slot].item;
+
+        if ((item == &removed_key) || (index->slots[slot].hash != hash))
+        {
+            continue;
+        }
+        if ((case_sensitive && (strcmp(name, item->string) == 0))
+            || (!case_sensitive && (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)item->string) == 0)))
+        {
+            return index->slots[slot].item;
+        }
+    }
+
+    return NULL;
+}
+
+/* item is being detached from object (replacement is NULL) or replaced */
+static void key_index_unlink(cJSON * const object, const cJSON * const item, cJSON * const replacement)
+{
+    cJSON_KeyIndex *index = object->key_index;
+    unsigned long hash = 0;
+    size_t slot = 0;
+
+    if (!has_key_index(object))
+    {
+        return;
+    }
+
+    if (index->last == item)
+    {
+        index->last = (replacement != NULL) ? replacement : item->prev;
+    }
+    if (item->string == NULL)
+    {
+        if ((replacement != NULL) && (replacement->string != NULL))
+        {
+            key_index_free(object);
+        }
+        return;
+    }
+
+    hash = hash_key((const unsigned char*)item->string);
+    for (slot = hash & (index->size - 1); index->slots[slot].item != NULL; slot = (slot + 1) & (index->size - 1))
+    {
+        if (index->slots[slot].item == item)
+        {
+            break;
+        }
+    }
+
+    if ((index->slots[slot].item != item)
+        || ((replacement != NULL) && ((replacement->string == NULL) || (hash_key((const unsigned char*)replacement->string) != hash))))
+    {
+        /* the replacement would be out of order with the items of its key */
+        key_index_free(object);
+        return;
+    }
+    index->slots[slot].item = (replacement != NULL) ? replacement : &removed_key;
+}
+#endif
+
 /* Delete a cJSON structure. */
 CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
 {
@@ -217,6 +418,9 @@ CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
     while (item != NULL)
     {
         next = item->next;
+#ifdef CJSON_OBJECT_INDEX
+        key_index_free(item);
+#endif
         if (!(item->type & cJSON_IsReference) && (item->child != NULL))
         {
             cJSON_Delete(item->child);
@@ -245,6 +449,14 @@ static unsigned char get_decimal_point(void)
 #endif
 }
 
+/* Memory of cJSON_ParseArena(): items are taken from the start, strings from the end. */
+typedef struct
+{
+    unsigned char *items;
+    unsigned char *strings;
+    unsigned char *in_place; /* writable input to unescape the strings into, or NULL */
+} parse_arena;
+
 typedef struct
 {
     const unsigned char *content;
@@ -252,6 +464,7 @@ typedef struct
     size_t offset;
     size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
     internal_hooks hooks;
+    parse_arena *arena; /* NULL to allocate every item and string with the hooks */
 } parse_buffer;
 
 /* check if the given size is left to read in a given parse buffer (starting with 1) */
@@ -262,10 +475,207 @@ typedef struct
 /* get a pointer to the buffer at the position */
 #define buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
 
+/* allocate an item for the parser, from the arena if there is one */
+static cJSON *parse_new_item(parse_buffer * const input_buffer)
+{
+    parse_arena *arena = input_buffer->arena;
+    cJSON *item = NULL;
+
+    if (arena == NULL)
+    {
+        return cJSON_New_Item(&(input_buffer->hooks));
+    }
+
+    if ((size_t)(arena->strings - arena->items) < sizeof(cJSON))
+    {
+        return NULL; /* arena too small */
+    }
+
+    item = (cJSON*)arena->items;
+    arena->items += sizeof(cJSON);
+    memset(item, '\0', sizeof(cJSON));
+#ifdef CJSON_OBJECT_INDEX
+    item->key_index = &no_key_index;
+#endif
+
+    return item;
+}
+
+/* free what the parser allocated, nothing to do in an arena */
+static void parse_delete(cJSON *item, const parse_buffer * const input_buffer)
+{
+    if (input_buffer->arena == NULL)
+    {
+        cJSON_Delete(item);
+    }
+}
+
+/* Scaling by a power of ten is correctly rounded only if it is done in double precision, not e.g. in the
+ * extended precision of the x87. */
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0)
+#define exact_double_scaling
+#endif
+
+#ifdef exact_double_scaling
+/* the powers of ten that are exact doubles */
+static const double exact_powers_of_ten[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+#endif
+
+/* Compute significand * 10^exponent if that is exact: for significands up to 2^53 (integers) or, with
+ * exact_double_scaling, up to 2^53 multiplied or divided by an exact power of ten, which is a single correctly
+ * rounded operation. */
+static cJSON_bool decimal_to_double_exact(const uint64_t significand, const int exponent, double * const value)
+{
+    if (significand > (((uint64_t)1) << 53))
+    {
+        return false;
+    }
+
+    if ((significand == 0) || (exponent == 0))
+    {
+        *value = (double)significand;
+    }
+#ifdef exact_double_scaling
+    else if ((exponent > 0) && (exponent <= 22))
+    {
+        *value = (double)significand * exact_powers_of_ten[exponent];
+    }
+    else if ((exponent < 0) && (exponent >= -22))
+    {
+        *value = (double)significand / exact_powers_of_ten[-exponent];
+    }
+#endif
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/* Parse a number without strtod if its value is exact, see decimal_to_double_exact(). Accepts the same text
+ * as strtod does, of at most max_length characters. Returns false to leave the number to strtod. */
+static cJSON_bool parse_number_exact(const parse_buffer * const input_buffer, size_t max_length, double * const number, size_t * const length)
+{
+    const unsigned char *input = buffer_at_offset(input_buffer);
+    size_t available = input_buffer->length - input_buffer->offset;
+    size_t position = 0;
+    uint64_t significand = 0;
+    int significant_digits = 0;
+    int exponent = 0;
+    cJSON_bool negative = false;
+    cJSON_bool has_digits = false;
+    cJSON_bool truncated = false;
+    double value = 0;
+
+    if (available > max_length)
+    {
+        available = max_length;
+        truncated = true;
+    }
+
+    if ((position < available) && (input[position] == '-'))
+    {
+        negative = true;
+        position++;
+    }
+
+    /* integral and fractional digits, the fractional ones lowering the exponent */
+    for (; position < available; position++)
+    {
+        unsigned char digit = input[position];
+
+        if (digit == '.')
+        {
+            if (exponent != 0)
+            {
+                break;
+            }
+            exponent = -1;
+            continue;
+        }
+        if ((digit < '0') || (digit > '9'))
+        {
+            break;
+        }
+        has_digits = true;
+        if ((significand != 0) || (digit != '0'))
+        {
+            if (significant_digits == 19)
+            {
+                /* could overflow */
+                return false;
+            }
+            significand = (significand * 10) + (uint64_t)(digit - '0');
+            significant_digits++;
+        }
+        if (exponent < 0)
+        {
+            exponent--;
+        }
+    }
+    if (!has_digits)
+    {
+        return false;
+    }
+    if (exponent < 0)
+    {
+        /* one too low for the '.' */
+        exponent++;
+    }
+
+    /* the exponent is only part of the number if it has digits */
+    if ((position < available) && ((input[position] == 'e') || (input[position] == 'E')))
+    {
+        size_t exponent_position = position + 1;
+        cJSON_bool negative_exponent = false;
+        int explicit_exponent = 0;
+
+        if ((exponent_position < available) && ((input[exponent_position] == '+') || (input[exponent_position] == '-')))
+        {
+            negative_exponent = input[exponent_position] == '-';
+            exponent_position++;
+        }
+        if ((exponent_position < available) && (input[exponent_position] >= '0') && (input[exponent_position] <= '9'))
+        {
+            for (; (exponent_position < available) && (input[exponent_position] >= '0') && (input[exponent_position] <= '9'); exponent_position++)
+            {
+                if (explicit_exponent < 10000)
+                {
+                    explicit_exponent = (explicit_exponent * 10) + (input[exponent_position] - '0');
+                }
+            }
+            exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+            position = exponent_position;
+        }
+    }
+
+    if (truncated && (position == available))
+    {
+        /* the number may go on past max_length */
+        return false;
+    }
+
+    if (!decimal_to_double_exact(significand, exponent, &value))
+    {
+        return false;
+    }
+
+    *number = negative ? -value : value;
+    *length = position;
+
+    return true;
+}
+
 /* Parse the input text to generate a number, and populate the result into item. */
 static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_buffer)
 {
     double number = 0;
+    size_t length = 0;
     unsigned char *after_end = NULL;
     unsigned char number_c_string[64];
     unsigned char decimal_point = get_decimal_point();
@@ -276,6 +686,11 @@ static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_bu
         return false;
     }
 
+    if (parse_number_exact(input_buffer, sizeof(number_c_string) - 1, &number, &length))
+    {
+        goto parsed;
+    }
+
     /* copy the number into a temporary buffer and replace '.' with the decimal point
      * of the current locale (for strtod)
      * This also takes care of '\0' not necessarily being available for marking the end of the input */
@@ -316,7 +731,9 @@ loop_end:
     {
         return false; /* parse_error */
     }
+    length = (size_t)(after_end - number_c_string);
 
+parsed:
     item->valuedouble = number;
 
     /* use saturation in case of overflow */
@@ -335,7 +752,7 @@ loop_end:
 
     item->type = cJSON_Number;
 
-    input_buffer->offset += (size_t)(after_end - number_c_string);
+    input_buffer->offset += length;
     return true;
 }
 
@@ -435,106 +852,519 @@ static unsigned char* ensure(printbuffer * const p, size_t needed)
     }
     else
     {
-        /* otherwise reallocate manually */
-        newbuffer = (unsigned char*)p->hooks.allocate(newsize);
-        if (!newbuffer)
-        {
-            p->hooks.deallocate(p->buffer);
-            p->length = 0;
-            p->buffer = NULL;
+        /* otherwise reallocate manually */
+        newbuffer = (unsigned char*)p->hooks.allocate(newsize);
+        if (!newbuffer)
+        {
+            p->hooks.deallocate(p->buffer);
+            p->length = 0;
+            p->buffer = NULL;
+
+            return NULL;
+        }
+        if (newbuffer)
+        {
+            memcpy(newbuffer, p->buffer, p->offset + 1);
+        }
+        p->hooks.deallocate(p->buffer);
+    }
+    p->length = newsize;
+    p->buffer = newbuffer;
+
+    return newbuffer + p->offset;
+}
+
+/* calculate the new length of the string in a printbuffer and update the offset */
+static void update_offset(printbuffer * const buffer)
+{
+    const unsigned char *buffer_pointer = NULL;
+    if ((buffer == NULL) || (buffer->buffer == NULL))
+    {
+        return;
+    }
+    buffer_pointer = buffer->buffer + buffer->offset;
+
+    buffer->offset += strlen((const char*)buffer_pointer);
+}
+
+/* Shortest round trip printing of doubles with Grisu2 (Florian Loitsch, "Printing Floating-Point Numbers Quickly
+ * and Accurately with Integers", PLDI 2010): the digits are the fewest that parse back to the same double in
+ * nearly all cases, and one more in the rest, never more than 17. Only integer arithmetic is used. */
+
+/* a floating point number f * 2^e with a 64 bit significand */
+typedef struct
+{
+    uint64_t f;
+    int e;
+} diy_fp;
+
+/* 10^k as a normalized diy_fp, the significand split for C89 */
+typedef struct
+{
+    unsigned long f_high;
+    unsigned long f_low;
+    short e;
+    short k;
+} cached_power;
+
+/* 10^-300, 10^-292, ... 10^324 */
+static const cached_power cached_powers[] =
+{
+    { 0xAB70FE17UL, 0xC79AC6CAUL, -1060, -300 },
+    { 0xFF77B1FCUL, 0xBEBCDC4FUL, -1034, -292 },
+    { 0xBE5691EFUL, 0x416BD60CUL, -1007, -284 },
+    { 0x8DD01FADUL, 0x907FFC3CUL, -980, -276 },
+    { 0xD3515C28UL, 0x31559A83UL, -954, -268 },
+    { 0x9D71AC8FUL, 0xADA6C9B5UL, -927, -260 },
+    { 0xEA9C2277UL, 0x23EE8BCBUL, -901, -252 },
+    { 0xAECC4991UL, 0x4078536DUL, -874, -244 },
+    { 0x823C1279UL, 0x5DB6CE57UL, -847, -236 },
+    { 0xC2109436UL, 0x4DFB5637UL, -821, -228 },
+    { 0x9096EA6FUL, 0x3848984FUL, -794, -220 },
+    { 0xD77485CBUL, 0x25823AC7UL, -768, -212 },
+    { 0xA086CFCDUL, 0x97BF97F4UL, -741, -204 },
+    { 0xEF340A98UL, 0x172AACE5UL, -715, -196 },
+    { 0xB23867FBUL, 0x2A35B28EUL, -688, -188 },
+    { 0x84C8D4DFUL, 0xD2C63F3BUL, -661, -180 },
+    { 0xC5DD4427UL, 0x1AD3CDBAUL, -635, -172 },
+    { 0x936B9FCEUL, 0xBB25C996UL, -608, -164 },
+    { 0xDBAC6C24UL, 0x7D62A584UL, -582, -156 },
+    { 0xA3AB6658UL, 0x0D5FDAF6UL, -555, -148 },
+    { 0xF3E2F893UL, 0xDEC3F126UL, -529, -140 },
+    { 0xB5B5ADA8UL, 0xAAFF80B8UL, -502, -132 },
+    { 0x87625F05UL, 0x6C7C4A8BUL, -475, -124 },
+    { 0xC9BCFF60UL, 0x34C13053UL, -449, -116 },
+    { 0x964E858CUL, 0x91BA2655UL, -422, -108 },
+    { 0xDFF97724UL, 0x70297EBDUL, -396, -100 },
+    { 0xA6DFBD9FUL, 0xB8E5B88FUL, -369, -92 },
+    { 0xF8A95FCFUL, 0x88747D94UL, -343, -84 },
+    { 0xB9447093UL, 0x8FA89BCFUL, -316, -76 },
+    { 0x8A08F0F8UL, 0xBF0F156BUL, -289, -68 },
+    { 0xCDB02555UL, 0x653131B6UL, -263, -60 },
+    { 0x993FE2C6UL, 0xD07B7FACUL, -236, -52 },
+    { 0xE45C10C4UL, 0x2A2B3B06UL, -210, -44 },
+    { 0xAA242499UL, 0x697392D3UL, -183, -36 },
+    { 0xFD87B5F2UL, 0x8300CA0EUL, -157, -28 },
+    { 0xBCE50864UL, 0x92111AEBUL, -130, -20 },
+    { 0x8CBCCC09UL, 0x6F5088CCUL, -103, -12 },
+    { 0xD1B71758UL, 0xE219652CUL, -77, -4 },
+    { 0x9C400000UL, 0x00000000UL, -50, 4 },
+    { 0xE8D4A510UL, 0x00000000UL, -24, 12 },
+    { 0xAD78EBC5UL, 0xAC620000UL, 3, 20 },
+    { 0x813F3978UL, 0xF8940984UL, 30, 28 },
+    { 0xC097CE7BUL, 0xC90715B3UL, 56, 36 },
+    { 0x8F7E32CEUL, 0x7BEA5C70UL, 83, 44 },
+    { 0xD5D238A4UL, 0xABE98068UL, 109, 52 },
+    { 0x9F4F2726UL, 0x179A2245UL, 136, 60 },
+    { 0xED63A231UL, 0xD4C4FB27UL, 162, 68 },
+    { 0xB0DE6538UL, 0x8CC8ADA8UL, 189, 76 },
+    { 0x83C7088EUL, 0x1AAB65DBUL, 216, 84 },
+    { 0xC45D1DF9UL, 0x42711D9AUL, 242, 92 },
+    { 0x924D692CUL, 0xA61BE758UL, 269, 100 },
+    { 0xDA01EE64UL, 0x1A708DEAUL, 295, 108 },
+    { 0xA26DA399UL, 0x9AEF774AUL, 322, 116 },
+    { 0xF209787BUL, 0xB47D6B85UL, 348, 124 },
+    { 0xB454E4A1UL, 0x79DD1877UL, 375, 132 },
+    { 0x865B8692UL, 0x5B9BC5C2UL, 402, 140 },
+    { 0xC83553C5UL, 0xC8965D3DUL, 428, 148 },
+    { 0x952AB45CUL, 0xFA97A0B3UL, 455, 156 },
+    { 0xDE469FBDUL, 0x99A05FE3UL, 481, 164 },
+    { 0xA59BC234UL, 0xDB398C25UL, 508, 172 },
+    { 0xF6C69A72UL, 0xA3989F5CUL, 534, 180 },
+    { 0xB7DCBF53UL, 0x54E9BECEUL, 561, 188 },
+    { 0x88FCF317UL, 0xF22241E2UL, 588, 196 },
+    { 0xCC20CE9BUL, 0xD35C78A5UL, 614, 204 },
+    { 0x98165AF3UL, 0x7B2153DFUL, 641, 212 },
+    { 0xE2A0B5DCUL, 0x971F303AUL, 667, 220 },
+    { 0xA8D9D153UL, 0x5CE3B396UL, 694, 228 },
+    { 0xFB9B7CD9UL, 0xA4A7443CUL, 720, 236 },
+    { 0xBB764C4CUL, 0xA7A44410UL, 747, 244 },
+    { 0x8BAB8EEFUL, 0xB6409C1AUL, 774, 252 },
+    { 0xD01FEF10UL, 0xA657842CUL, 800, 260 },
+    { 0x9B10A4E5UL, 0xE9913129UL, 827, 268 },
+    { 0xE7109BFBUL, 0xA19C0C9DUL, 853, 276 },
+    { 0xAC2820D9UL, 0x623BF429UL, 880, 284 },
+    { 0x80444B5EUL, 0x7AA7CF85UL, 907, 292 },
+    { 0xBF21E440UL, 0x03ACDD2DUL, 933, 300 },
+    { 0x8E679C2FUL, 0x5E44FF8FUL, 960, 308 },
+    { 0xD433179DUL, 0x9C8CB841UL, 986, 316 },
+    { 0x9E19DB92UL, 0xB4E31BA9UL, 1013, 324 }};
+#define cached_powers_min_k (-300)
+#define cached_powers_k_step 8
+
+/* the digit generation needs a product whose exponent is within [alpha, gamma] */
+#define grisu_alpha (-60)
+#define grisu_gamma (-32)
+
+static diy_fp diy_fp_make(uint64_t f, int e)
+{
+    diy_fp result;
+
+    result.f = f;
+    result.e = e;
+
+    return result;
+}
+
+/* rounded upper 64 bits of the 128 bit product */
+static diy_fp diy_fp_multiply(const diy_fp x, const diy_fp y)
+{
+    const uint64_t x_low = x.f & 0xFFFFFFFFUL;
+    const uint64_t x_high = x.f >> 32;
+    const uint64_t y_low = y.f & 0xFFFFFFFFUL;
+    const uint64_t y_high = y.f >> 32;
+    const uint64_t low_low = x_low * y_low;
+    const uint64_t low_high = x_low * y_high;
+    const uint64_t high_low = x_high * y_low;
+    const uint64_t high_high = x_high * y_high;
+    uint64_t middle = (low_low >> 32) + (low_high & 0xFFFFFFFFUL) + (high_low & 0xFFFFFFFFUL);
+
+    middle += ((uint64_t)1) << 31;
+
+    return diy_fp_make(high_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32), x.e + y.e + 64);
+}
+
+static diy_fp diy_fp_normalize(diy_fp x)
+{
+    while ((x.f >> 63) == 0)
+    {
+        x.f <<= 1;
+        x.e--;
+    }
+
+    return x;
+}
+
+/* Move the last digit of the shortest digits towards w, the value being printed, as long as they stay
+ * within the rounding interval of width delta: rest is the distance from the digits to the upper bound,
+ * dist the one from w to it, and ten_k the weight of the last digit. */
+static void grisu2_round(unsigned char * const digits, const size_t length, const uint64_t dist, const uint64_t delta, uint64_t rest, const uint64_t ten_k)
+{
+    while ((rest < dist) && ((delta - rest) >= ten_k) && (((rest + ten_k) < dist) || ((dist - rest) > ((rest + ten_k) - dist))))
+    {
+        digits[length - 1]--;
+        rest += ten_k;
+    }
+}
+
+/* Generate the digits of a number in [m_minus, m_plus], as close as possible to w. Returns their count and
+ * adds the exponent of the last one to decimal_exponent. */
+static size_t grisu2_digits(unsigned char * const digits, int * const decimal_exponent, const diy_fp m_minus, const diy_fp w, const diy_fp m_plus)
+{
+    uint64_t delta = m_plus.f - m_minus.f;
+    uint64_t dist = m_plus.f - w.f;
+    const int shift = -m_plus.e;
+    const uint64_t one = ((uint64_t)1) << shift;
+    /* as gamma <= -32, the integral part fits in 32 bits */
+    uint32_t integral = (uint32_t)(m_plus.f >> shift);
+    uint64_t fractional = m_plus.f & (one - 1);
+    uint32_t power = 1;
+    int remaining = 1;
+    size_t length = 0;
+
+    while ((remaining < 10) && ((integral / 10) >= power))
+    {
+        power *= 10;
+        remaining++;
+    }
+
+    while (remaining > 0)
+    {
+        uint64_t rest = 0;
+
+        digits[length++] = (unsigned char)('0' + (integral / power));
+        integral %= power;
+        remaining--;
+
+        rest = (((uint64_t)integral) << shift) + fractional;
+        if (rest <= delta)
+        {
+            *decimal_exponent += remaining;
+            grisu2_round(digits, length, dist, delta, rest, ((uint64_t)power) << shift);
+            return length;
+        }
+        power /= 10;
+    }
+
+    for (;;)
+    {
+        fractional *= 10;
+        delta *= 10;
+        dist *= 10;
+        digits[length++] = (unsigned char)('0' + (fractional >> shift));
+        fractional &= one - 1;
+        (*decimal_exponent)--;
+        if (fractional <= delta)
+        {
+            break;
+        }
+    }
+    grisu2_round(digits, length, dist, delta, fractional, one);
+
+    return length;
+}
+
+/* The shortest digits of a positive finite number, whose value is digits * 10^decimal_exponent. */
+static size_t grisu2(unsigned char * const digits, int * const decimal_exponent, const double number)
+{
+    uint64_t bits = 0;
+    uint64_t significand = 0;
+    int biased_exponent = 0;
+    diy_fp v;
+    diy_fp m_plus;
+    diy_fp m_minus;
+    diy_fp power;
+    const cached_power *cached = NULL;
+    int f = 0;
+    int k = 0;
+
+    memcpy(&bits, &number, sizeof(bits));
+    significand = bits & ((((uint64_t)1) << 52) - 1);
+    biased_exponent = (int)((bits >> 52) & 0x7FF);
+    if (biased_exponent == 0)
+    {
+        /* subnormal */
+        v = diy_fp_make(significand, 1 - 1075);
+    }
+    else
+    {
+        v = diy_fp_make(significand | (((uint64_t)1) << 52), biased_exponent - 1075);
+    }
+
+    /* the bounds of the numbers that round to v: halfway to its neighbours, the lower one being closer for
+     * powers of two */
+    m_plus = diy_fp_normalize(diy_fp_make((v.f << 1) + 1, v.e - 1));
+    if ((significand == 0) && (biased_exponent > 1))
+    {
+        m_minus = diy_fp_make((v.f << 2) - 1, v.e - 2);
+    }
+    else
+    {
+        m_minus = diy_fp_make((v.f << 1) - 1, v.e - 1);
+    }
+    m_minus.f <<= m_minus.e - m_plus.e;
+    m_minus.e = m_plus.e;
+    v = diy_fp_normalize(v);
+
+    /* scale by the cached power 10^-k that brings the exponent of m_plus within [alpha, gamma] */
+    f = grisu_alpha - m_plus.e - 1;
+    k = ((f * 78913) / (1 << 18)) + (f > 0);
+    cached = &cached_powers[(-cached_powers_min_k + k + (cached_powers_k_step - 1)) / cached_powers_k_step];
+    power = diy_fp_make((((uint64_t)cached->f_high) << 32) | cached->f_low, cached->e);
+
+    v = diy_fp_multiply(v, power);
+    m_plus = diy_fp_multiply(m_plus, power);
+    m_minus = diy_fp_multiply(m_minus, power);
+    /* the products are off by up to one unit: keep the bounds safe */
+    m_plus.f--;
+    m_minus.f++;
+
+    *decimal_exponent = -cached->k;
+
+    return grisu2_digits(digits, decimal_exponent, m_minus, v, m_plus);
+}
+
+/* Grisu2 misses the shortest digits when they are at the very edge of the rounding interval, and gives e.g.
+ * 997.7304799999999 for 997.73048: round the run of 9 or 0 before the last digit off, if the result is exactly
+ * the number. */
+static size_t grisu2_shorten(unsigned char * const digits, size_t length, int * const decimal_exponent, const double number)
+{
+    unsigned char run = 0;
+    size_t start = 0;
+    uint64_t significand = 0;
+    uint64_t rest = 0;
+    int exponent = 0;
+    double value = 0;
+    size_t i = 0;
+
+    if (length < 6)
+    {
+        return length;
+    }
+    /* the run, up to the last digit */
+    run = digits[length - 2];
+    if ((run != '0') && (run != '9'))
+    {
+        return length;
+    }
+    for (start = length - 2; (start > 0) && (digits[start - 1] == run); start--)
+    {
+    }
+
+    for (i = 0; i < start; i++)
+    {
+        significand = (significand * 10) + (uint64_t)(digits[i] - '0');
+    }
+    if (run == '9')
+    {
+        significand++;
+    }
+    exponent = *decimal_exponent + (int)(length - start);
+    if (!decimal_to_double_exact(significand, exponent, &value) || (value != number))
+    {
+        return length;
+    }
+
+    while ((significand % 10) == 0)
+    {
+        significand /= 10;
+        exponent++;
+    }
+    for (length = 0, rest = significand; rest != 0; length++)
+    {
+        rest /= 10;
+    }
+    for (i = length; i > 0; i--)
+    {
+        digits[i - 1] = (unsigned char)('0' + (significand % 10));
+        significand /= 10;
+    }
+    *decimal_exponent = exponent;
+
+    return length;
+}
+
+/* Print a double with its shortest digits, in decimal notation for exponents from -4 to 16 (as %g does from -4
+ * up to its precision), else in exponential notation. The output is at most 24 characters. */
+static size_t print_double(unsigned char * const output, double number)
+{
+    unsigned char *digits = output;
+    int decimal_exponent = 0;
+    int point = 0;
+    size_t length = 0;
+
+    if (number == 0)
+    {
+        output[0] = '0';
+        return 1;
+    }
+    if (number < 0)
+    {
+        *digits++ = '-';
+        number = -number;
+    }
+
+    length = grisu2(digits, &decimal_exponent, number);
+    length = grisu2_shorten(digits, length, &decimal_exponent, number);
+    /* the value is 0.digits * 10^point */
+    point = (int)length + decimal_exponent;
+
+    if (((int)length <= point) && (point <= 17))
+    {
+        /* integer: digits followed by zeros */
+        memset(digits + length, '0', (size_t)point - length);
+        length = (size_t)point;
+    }
+    else if ((0 < point) && (point <= 17))
+    {
+        /* digits with a decimal point in between */
+        memmove(digits + point + 1, digits + point, length - (size_t)point);
+        digits[point] = '.';
+        length++;
+    }
+    else if ((-4 < point) && (point <= 0))
+    {
+        /* 0.000digits */
+        memmove(digits + 2 - point, digits, length);
+        digits[0] = '0';
+        digits[1] = '.';
+        memset(digits + 2, '0', (size_t)-point);
+        length += (size_t)(2 - point);
+    }
+    else
+    {
+        /* d.ddde+XX */
+        int exponent = point - 1;
 
-            return NULL;
+        if (length > 1)
+        {
+            memmove(digits + 2, digits + 1, length - 1);
+            digits[1] = '.';
+            length++;
         }
-        if (newbuffer)
+        digits[length++] = 'e';
+        digits[length++] = (exponent < 0) ? '-' : '+';
+        if (exponent < 0)
         {
-            memcpy(newbuffer, p->buffer, p->offset + 1);
+            exponent = -exponent;
         }
-        p->hooks.deallocate(p->buffer);
+        if (exponent >= 100)
+        {
+            digits[length++] = (unsigned char)('0' + (exponent / 100));
+            exponent %= 100;
+        }
+        digits[length++] = (unsigned char)('0' + (exponent / 10));
+        digits[length++] = (unsigned char)('0' + (exponent % 10));
     }
-    p->length = newsize;
-    p->buffer = newbuffer;
 
-    return newbuffer + p->offset;
+    return (size_t)(digits - output) + length;
 }
 
-/* calculate the new length of the string in a printbuffer and update the offset */
-static void update_offset(printbuffer * const buffer)
+/* Print an integer, including INT_MIN. */
+static size_t print_integer(unsigned char * const output, const int number)
 {
-    const unsigned char *buffer_pointer = NULL;
-    if ((buffer == NULL) || (buffer->buffer == NULL))
+    unsigned char reversed[sizeof(int) * 3];
+    unsigned int magnitude = (number < 0) ? (0U - (unsigned int)number) : (unsigned int)number;
+    size_t count = 0;
+    size_t length = 0;
+
+    do
     {
-        return;
+        reversed[count++] = (unsigned char)('0' + (magnitude % 10));
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    if (number < 0)
+    {
+        output[length++] = '-';
+    }
+    while (count > 0)
+    {
+        output[length++] = reversed[--count];
     }
-    buffer_pointer = buffer->buffer + buffer->offset;
 
-    buffer->offset += strlen((const char*)buffer_pointer);
+    return length;
 }
 
 /* Render the number nicely from the given item into a string. */
 static cJSON_bool print_number(const cJSON * const item, printbuffer * const output_buffer)
 {
     unsigned char *output_pointer = NULL;
-    int value = item->valueint;
-    int length = 0;
-    size_t i = 0;
+    double d = item->valuedouble;
+    size_t length = 0;
     unsigned char number_buffer[26]; /* temporary buffer to print the number into */
-    unsigned char decimal_point = get_decimal_point();
 
     if (output_buffer == NULL)
     {
         return false;
     }
 
-#if 0
     /* This checks for NaN and Infinity */
     if ((d * 0) != 0)
     {
-        length = sprintf((char*)number_buffer, "null");
+        memcpy(number_buffer, "null", sizeof("null") - 1);
+        length = sizeof("null") - 1;
     }
-    else
+    else if (d == (double)item->valueint)
     {
-        /* Try 15 decimal places of precision to avoid nonsignificant nonzero digits */
-        length = sprintf((char*)number_buffer, "%1.15g", d);
-
-        /* Check whether the original double can be recovered */
-        if ((sscanf((char*)number_buffer, "%lg", &test) != 1) || ((double)test != d))
-        {
-            /* If not, print with 17 decimal places of precision */
-            length = sprintf((char*)number_buffer, "%1.17g", d);
-        }
+        length = print_integer(number_buffer, item->valueint);
     }
-#else
-    length = sprintf((char*)number_buffer, "%d", value);
-#endif
-
-    /* sprintf failed or buffer overrun occured */
-    if ((length < 0) || (length > (int)(sizeof(number_buffer) - 1)))
+    else
     {
-        return false;
+        length = print_double(number_buffer, d);
     }
 
     /* reserve appropriate space in the output */
-    output_pointer = ensure(output_buffer, (size_t)length + sizeof(""));
+    output_pointer = ensure(output_buffer, length + sizeof(""));
     if (output_pointer == NULL)
     {
         return false;
     }
 
-    /* copy the printed number to the output and replace locale
-     * dependent decimal point with '.' */
-    for (i = 0; i < ((size_t)length); i++)
-    {
-        if (number_buffer[i] == decimal_point)
-        {
-            output_pointer[i] = '.';
-            continue;
-        }
-
-        output_pointer[i] = number_buffer[i];
-    }
-    output_pointer[i] = '\0';
+    memcpy(output_pointer, number_buffer, length);
+    output_pointer[length] = '\0';
 
-    output_buffer->offset += (size_t)length;
+    output_buffer->offset += length;
 
     return true;
 }
@@ -706,7 +1536,7 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
     unsigned char *output = NULL;
 
     /* not a string */
-    if (buffer_at_offset(input_buffer)[0] != '\"')
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '\"'))
     {
         goto fail;
     }
@@ -737,7 +1567,21 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
 
         /* This is at most how much we need for the output */
         allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
-        output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
+        if (input_buffer->arena == NULL)
+        {
+            output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
+        }
+        else if (input_buffer->arena->in_place != NULL)
+        {
+            /* unescaping never makes a string longer, and the terminator takes the place of the closing quote */
+            output = input_buffer->arena->in_place + (input_pointer - input_buffer->content);
+        }
+        else if ((size_t)(input_buffer->arena->strings - input_buffer->arena->items) >= allocation_length)
+        {
+            /* allocation_length counts the opening quote, which leaves room for the terminator */
+            input_buffer->arena->strings -= allocation_length;
+            output = input_buffer->arena->strings;
+        }
         if (output == NULL)
         {
             goto fail; /* allocation failure */
@@ -813,7 +1657,7 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
     return true;
 
 fail:
-    if (output != NULL)
+    if ((output != NULL) && (input_buffer->arena == NULL))
     {
         input_buffer->hooks.deallocate(output);
     }
@@ -975,7 +1819,8 @@ static parse_buffer *buffer_skip_whitespace(parse_buffer * const buffer)
        buffer->offset++;
     }
 
-    if (buffer->offset == buffer->length)
+    /* step back to the terminating '\0', input of cJSON_ParseArena() may not have one */
+    if ((buffer->offset == buffer->length) && (buffer->content[buffer->offset - 1] == '\0'))
     {
         buffer->offset--;
     }
@@ -999,10 +1844,34 @@ static parse_buffer *skip_utf8_bom(parse_buffer * const buffer)
     return buffer;
 }
 
+/* remember where parsing value failed for cJSON_GetErrorPtr() */
+static void set_parse_error(const char *value, const parse_buffer * const buffer, const char **return_parse_end)
+{
+    error local_error;
+    local_error.json = (const unsigned char*)value;
+    local_error.position = 0;
+
+    if (buffer->offset < buffer->length)
+    {
+        local_error.position = buffer->offset;
+    }
+    else if (buffer->length > 0)
+    {
+        local_error.position = buffer->length - 1;
+    }
+
+    if (return_parse_end != NULL)
+    {
+        *return_parse_end = (const char*)local_error.json + local_error.position;
+    }
+
+    global_error = local_error;
+}
+
 /* Parse an object - create a new root, and populate. */
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated)
 {
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 }, NULL };
     cJSON *item = NULL;
 
     /* reset error position */
@@ -1055,34 +1924,201 @@ fail:
 
     if (value != NULL)
     {
-        error local_error;
-        local_error.json = (const unsigned char*)value;
-        local_error.position = 0;
+        set_parse_error(value, &buffer, return_parse_end);
+    }
 
-        if (buffer.offset < buffer.length)
-        {
-            local_error.position = buffer.offset;
-        }
-        else if (buffer.length > 0)
+    return NULL;
+}
+
+/* Default options for cJSON_Parse */
+CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
+{
+    return cJSON_ParseWithOpts(value, 0, 0);
+}
+
+/* alignment of the items in an arena */
+#define arena_alignment sizeof(double)
+
+CJSON_PUBLIC(size_t) cJSON_ArenaSize(const char *value, size_t length, cJSON_bool in_place)
+{
+    const unsigned char *input = (const unsigned char*)value;
+    size_t items = 0;
+    size_t string_bytes = 0;
+    size_t i = 0;
+    cJSON_bool in_scalar = false;
+
+    if (value == NULL)
+    {
+        return 0;
+    }
+
+    /* Count the values and the bytes of the strings without parsing: every '{', '[',
+     * string that isn't followed by ':' and run of other characters (numbers, literals)
+     * is an item. This is exact for valid JSON, and the parser fails cleanly when
+     * invalid JSON needs more. */
+    while ((i < length) && (input[i] != '\0'))
+    {
+        switch (input[i])
         {
-            local_error.position = buffer.length - 1;
+            case '\"':
+            {
+                size_t start = i;
+                size_t next = 0;
+
+                for (i++; (i < length) && (input[i] != '\"'); i++)
+                {
+                    if (input[i] == '\\')
+                    {
+                        i++;
+                    }
+                }
+                /* the unescaped string and its terminator take at most as much as the quoted string */
+                string_bytes += i - start;
+
+                for (next = i + 1; (next < length) && (input[next] != '\0') && (input[next] <= 32); next++)
+                {
+                }
+                if ((next >= length) || (input[next] != ':'))
+                {
+                    items++;
+                }
+                in_scalar = false;
+                break;
+            }
+
+            case '{':
+            case '[':
+                items++;
+                in_scalar = false;
+                break;
+
+            case '}':
+            case ']':
+            case ',':
+            case ':':
+                in_scalar = false;
+                break;
+
+            default:
+                if (input[i] <= 32)
+                {
+                    in_scalar = false;
+                }
+                else if (!in_scalar)
+                {
+                    items++;
+                    in_scalar = true;
+                }
+                break;
         }
+        i++;
+    }
+
+    if (in_place)
+    {
+        string_bytes = 0;
+    }
+
+    return (arena_alignment - 1) + (items * sizeof(cJSON)) + string_bytes;
+}
+
+static cJSON *parse_arena_root(const char *value, unsigned char *in_place, size_t length, void *memory, size_t size, const char **return_parse_end)
+{
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 }, NULL };
+    parse_arena arena = { NULL, NULL, NULL };
+    unsigned char *allocated = NULL;
+    size_t padding = 0;
+    cJSON *item = NULL;
 
-        if (return_parse_end != NULL)
+    /* reset error position */
+    global_error.json = NULL;
+    global_error.position = 0;
+
+    if ((value == NULL) || (length == 0))
+    {
+        goto fail;
+    }
+
+    if (memory == NULL)
+    {
+        /* a single block of the size the input can take at most */
+        size = cJSON_ArenaSize(value, length, in_place != NULL);
+        allocated = (unsigned char*)global_hooks.allocate(size);
+        if (allocated == NULL)
         {
-            *return_parse_end = (const char*)local_error.json + local_error.position;
+            goto fail;
         }
+        memory = allocated;
+    }
+
+    padding = (arena_alignment - ((size_t)memory % arena_alignment)) % arena_alignment;
+    if (size < padding)
+    {
+        goto fail;
+    }
+    arena.items = (unsigned char*)memory + padding;
+    arena.strings = (unsigned char*)memory + size;
+    arena.in_place = in_place;
+
+    buffer.content = (const unsigned char*)value;
+    buffer.length = length;
+    buffer.offset = 0;
+    buffer.hooks = global_hooks;
+    buffer.arena = &arena;
+
+    item = parse_new_item(&buffer);
+    if (item == NULL) /* arena too small */
+    {
+        goto fail;
+    }
+
+    if (!parse_value(item, buffer_skip_whitespace(skip_utf8_bom(&buffer))))
+    {
+        /* parse failure. ep is set. */
+        goto fail;
+    }
+
+    /* only whitespace may follow the value, up to the end of the input or a terminating '\0' */
+    while ((buffer.offset < buffer.length) && (buffer_at_offset(&buffer)[0] != '\0') && (buffer_at_offset(&buffer)[0] <= 32))
+    {
+        buffer.offset++;
+    }
+    if ((buffer.offset < buffer.length) && (buffer_at_offset(&buffer)[0] != '\0'))
+    {
+        goto fail;
+    }
+    if (return_parse_end)
+    {
+        *return_parse_end = (const char*)buffer_at_offset(&buffer);
+    }
+
+    /* the root owns nothing but itself: cJSON_Delete() releases just the block it starts */
+    item->type |= cJSON_IsReference;
 
-        global_error = local_error;
+    return item;
+
+fail:
+    if (allocated != NULL)
+    {
+        global_hooks.deallocate(allocated);
+    }
+
+    if (value != NULL)
+    {
+        set_parse_error(value, &buffer, return_parse_end);
     }
 
     return NULL;
 }
 
-/* Default options for cJSON_Parse */
-CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
+CJSON_PUBLIC(cJSON *) cJSON_ParseArena(const char *value, size_t length, void *arena, size_t arena_size, const char **return_parse_end)
 {
-    return cJSON_ParseWithOpts(value, 0, 0);
+    return parse_arena_root(value, NULL, length, arena, arena_size, return_parse_end);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseArenaInPlace(char *value, size_t length, void *arena, size_t arena_size, const char **return_parse_end)
+{
+    return parse_arena_root(value, (unsigned char*)value, length, arena, arena_size, return_parse_end);
 }
 
 #define cjson_min(a, b) ((a < b) ? a : b)
@@ -1211,6 +2247,57 @@ CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buf, const i
     return print_value(item, &p);
 }
 
+CJSON_PUBLIC(size_t) cJSON_PrintNumber(double number, char *buffer)
+{
+    size_t length = 0;
+
+    if (buffer == NULL)
+    {
+        return 0;
+    }
+
+    /* as print_number() does for an item set with cJSON_SetNumberValue() */
+    if ((number * 0) != 0)
+    {
+        memcpy(buffer, "null", sizeof("null") - 1);
+        length = sizeof("null") - 1;
+    }
+    else if ((number >= INT_MIN) && (number <= INT_MAX) && (number == (double)(int)number))
+    {
+        length = print_integer((unsigned char*)buffer, (int)number);
+    }
+    else
+    {
+        length = print_double((unsigned char*)buffer, number);
+    }
+    buffer[length] = '\0';
+
+    return length;
+}
+
+CJSON_PUBLIC(size_t) cJSON_ParseNumber(const char *value, size_t length, double *number)
+{
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 }, NULL };
+    cJSON item;
+
+    /* parse_value() only takes numbers that start with '-' or a digit */
+    if ((value == NULL) || (number == NULL) || (length == 0) || ((value[0] != '-') && ((value[0] < '0') || (value[0] > '9'))))
+    {
+        return 0;
+    }
+
+    memset(&item, '\0', sizeof(item));
+    buffer.content = (const unsigned char*)value;
+    buffer.length = length;
+    if (!parse_number(&item, &buffer))
+    {
+        return 0;
+    }
+    *number = item.valuedouble;
+
+    return buffer.offset;
+}
+
 /* Parser core - when encountering text, process appropriately. */
 static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer)
 {
@@ -1379,7 +2466,7 @@ static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buf
     do
     {
         /* allocate next item */
-        cJSON *new_item = cJSON_New_Item(&(input_buffer->hooks));
+        cJSON *new_item = parse_new_item(input_buffer);
         if (new_item == NULL)
         {
             goto fail; /* allocation failure */
@@ -1428,7 +2515,7 @@ success:
 fail:
     if (head != NULL)
     {
-        cJSON_Delete(head);
+        parse_delete(head, input_buffer);
     }
 
     return false;
@@ -1533,7 +2620,7 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
     do
     {
         /* allocate next item */
-        cJSON *new_item = cJSON_New_Item(&(input_buffer->hooks));
+        cJSON *new_item = parse_new_item(input_buffer);
         if (new_item == NULL)
         {
             goto fail; /* allocation failure */
@@ -1592,6 +2679,9 @@ success:
 
     item->type = cJSON_Object;
     item->child = head;
+#ifdef CJSON_OBJECT_INDEX
+    key_index_build(item, CJSON_OBJECT_INDEX_MIN);
+#endif
 
     input_buffer->offset++;
     return true;
@@ -1599,7 +2689,7 @@ success:
 fail:
     if (head != NULL)
     {
-        cJSON_Delete(head);
+        parse_delete(head, input_buffer);
     }
 
     return false;
@@ -1772,6 +2862,10 @@ CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index)
     return get_array_item(array, (size_t)index);
 }
 
+#ifdef CJSON_OBJECT_INDEX
+static void* cast_away_const(const void* string);
+#endif
+
 static cJSON *get_object_item(const cJSON * const object, const char * const name, const cJSON_bool case_sensitive)
 {
     cJSON *current_element = NULL;
@@ -1781,6 +2875,13 @@ static cJSON *get_object_item(const cJSON * const object, const char * const nam
         return NULL;
     }
 
+#ifdef CJSON_OBJECT_INDEX
+    if (has_key_index(object))
+    {
+        return key_index_find(object->key_index, name, case_sensitive);
+    }
+#endif
+
     current_element = object->child;
     if (case_sensitive)
     {
@@ -1839,6 +2940,9 @@ static cJSON *create_reference(const cJSON *item, const internal_hooks * const h
 
     memcpy(reference, item, sizeof(cJSON));
     reference->string = NULL;
+#ifdef CJSON_OBJECT_INDEX
+    reference->key_index = NULL;
+#endif
     reference->type |= cJSON_IsReference;
     reference->next = reference->prev = NULL;
     return reference;
@@ -1847,6 +2951,9 @@ static cJSON *create_reference(const cJSON *item, const internal_hooks * const h
 static cJSON_bool add_item_to_array(cJSON *array, cJSON *item)
 {
     cJSON *child = NULL;
+#ifdef CJSON_OBJECT_INDEX
+    size_t count = 1;
+#endif
 
     if ((item == NULL) || (array == NULL))
     {
@@ -1854,6 +2961,20 @@ static cJSON_bool add_item_to_array(cJSON *array, cJSON *item)
     }
 
     child = array->child;
+#ifdef CJSON_OBJECT_INDEX
+    if (has_key_index(array))
+    {
+        /* append after the last child the index knows */
+        child = array->key_index->last;
+        array->key_index->last = item;
+        if (!key_index_insert(array->key_index, item))
+        {
+            /* full, rebuilt bigger below */
+            key_index_free(array);
+            count = CJSON_OBJECT_INDEX_MIN;
+        }
+    }
+#endif
 
     if (child == NULL)
     {
@@ -1866,10 +2987,23 @@ static cJSON_bool add_item_to_array(cJSON *array, cJSON *item)
         while (child->next)
         {
             child = child->next;
+#ifdef CJSON_OBJECT_INDEX
+            count++;
+#endif
         }
         suffix_object(child, item);
+#ifdef CJSON_OBJECT_INDEX
+        count++;
+#endif
     }
 
+#ifdef CJSON_OBJECT_INDEX
+    if (count >= CJSON_OBJECT_INDEX_MIN)
+    {
+        key_index_build(array, CJSON_OBJECT_INDEX_MIN);
+    }
+#endif
+
     return true;
 }
 
@@ -2078,6 +3212,10 @@ CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const it
         return NULL;
     }
 
+#ifdef CJSON_OBJECT_INDEX
+    key_index_unlink(parent, item, NULL);
+#endif
+
     if (item->prev != NULL)
     {
         /* not the first element */
@@ -2157,6 +3295,11 @@ CJSON_PUBLIC(void) cJSON_InsertItemInArray(cJSON *array, int which, cJSON *newit
         return;
     }
 
+#ifdef CJSON_OBJECT_INDEX
+    /* the index can't put newitem before the items with the same key that follow it */
+    key_index_free(array);
+#endif
+
     newitem->next = after_inserted;
     newitem->prev = after_inserted->prev;
     after_inserted->prev = newitem;
@@ -2182,6 +3325,10 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON
         return true;
     }
 
+#ifdef CJSON_OBJECT_INDEX
+    key_index_unlink(parent, item, replacement);
+#endif
+
     replacement->next = item->next;
     replacement->prev = item->prev;
 
@@ -2205,6 +3352,34 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON
     return true;
 }
 
+CJSON_PUBLIC(cJSON_bool) cJSON_IndexObject(cJSON *object)
+{
+#ifdef CJSON_OBJECT_INDEX
+    if (object == NULL)
+    {
+        return false;
+    }
+
+    key_index_free(object);
+    return key_index_build(object, 0);
+#else
+    (void)object;
+    return false;
+#endif
+}
+
+CJSON_PUBLIC(void) cJSON_InvalidateIndex(cJSON *object)
+{
+#ifdef CJSON_OBJECT_INDEX
+    if (object != NULL)
+    {
+        key_index_free(object);
+    }
+#else
+    (void)object;
+#endif
+}
+
 CJSON_PUBLIC(void) cJSON_ReplaceItemInArray(cJSON *array, int which, cJSON *newitem)
 {
     if (which < 0)
@@ -2617,6 +3792,9 @@ CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
         }
         child = child->next;
     }
+#ifdef CJSON_OBJECT_INDEX
+    key_index_build(newitem, CJSON_OBJECT_INDEX_MIN);
+#endif
 
     return newitem;
 
@@ -49,6 +49,16 @@ extern "C"
 #define cJSON_IsReference 256
 #define cJSON_StringIsConst 512
 
+/* Define CJSON_OBJECT_INDEX (for every file including cJSON.h, as it adds a member to the cJSON structure) to have
+ * cJSON_GetObjectItem() and friends look keys up in a hash index of the object instead of walking its children.
+ * An object with at least CJSON_OBJECT_INDEX_MIN children gets its index when it is parsed, duplicated or added to,
+ * and any object by cJSON_IndexObject(). The index is kept up to date by the functions of cJSON.c that add, detach
+ * and replace items, and is released by cJSON_Delete(). Lookups only read it, and walk the children of an object
+ * without one, so they may run concurrently on a tree nobody modifies. */
+#ifndef CJSON_OBJECT_INDEX_MIN
+#define CJSON_OBJECT_INDEX_MIN 16
+#endif
+
 /* The cJSON structure: */
 typedef struct cJSON
 {
@@ -70,6 +80,11 @@ typedef struct cJSON
 
     /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
     char *string;
+
+#ifdef CJSON_OBJECT_INDEX
+    /* private: key index of an object, see CJSON_OBJECT_INDEX */
+    struct cJSON_KeyIndex *key_index;
+#endif
 } cJSON;
 
 typedef struct cJSON_Hooks
@@ -142,6 +157,19 @@ CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value);
 /* If you supply a ptr in return_parse_end and parsing fails, then return_parse_end will contain a pointer to the error so will match cJSON_GetErrorPtr(). */
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated);
 
+/* Parse length bytes of JSON (up to a '\0' if there is one) into a single block of memory instead of allocating every item and string with the hooks.
+ * The block is the arena of arena_size bytes, or if arena is NULL one allocated with the hooks, of the size cJSON_ArenaSize() computes.
+ * Only whitespace may follow the value, as with require_null_terminated. The items are laid out from the start of the arena and the strings from its end.
+ * The returned tree must not be modified, and is released in one go: drop the arena, or cJSON_Delete() (or cJSON_free()) the root if the arena was allocated.
+ * Never cJSON_Delete() any other item of the tree. Use cJSON_Duplicate() to get a subtree that outlives the arena. */
+CJSON_PUBLIC(cJSON *) cJSON_ParseArena(const char *value, size_t length, void *arena, size_t arena_size, const char **return_parse_end);
+/* Same as cJSON_ParseArena(), but unescapes the strings into value itself, which the tree then references: the arena only has to hold the items.
+ * value is modified even if parsing fails, and must outlive the tree. */
+CJSON_PUBLIC(cJSON *) cJSON_ParseArenaInPlace(char *value, size_t length, void *arena, size_t arena_size, const char **return_parse_end);
+/* Returns an arena size that is large enough for cJSON_ParseArena() (in_place = 0) or cJSON_ParseArenaInPlace() (in_place = 1) to parse value, whatever the alignment of the arena.
+ * It is computed with a quick scan of the input, without allocating anything. */
+CJSON_PUBLIC(size_t) cJSON_ArenaSize(const char *value, size_t length, cJSON_bool in_place);
+
 /* Render a cJSON entity to text for transfer/storage. */
 CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item);
 /* Render a cJSON entity to text for transfer/storage without any formatting. */
@@ -151,6 +179,12 @@ CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON
 /* Render a cJSON entity to text using a buffer already allocated in memory with given length. Returns 1 on success and 0 on failure. */
 /* NOTE: cJSON is not always 100% accurate in estimating how much memory it will use, so to be safe allocate 5 bytes more than you actually need */
 CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, const int length, const cJSON_bool format);
+/* Longest text of a number printed by cJSON (e.g. -2.2250738585072014e-308), without the '\0'. */
+#define CJSON_NUMBER_LENGTH_MAX 24
+/* Print a number as cJSON_Print does (NaN and infinities as null) into a buffer of at least CJSON_NUMBER_LENGTH_MAX + 1 bytes. Returns the length of the '\0' terminated text. */
+CJSON_PUBLIC(size_t) cJSON_PrintNumber(double number, char *buffer);
+/* Parse the number at the start of value (length bytes) as cJSON_Parse does. Returns the number of bytes it takes, 0 if value doesn't start with a number. */
+CJSON_PUBLIC(size_t) cJSON_ParseNumber(const char *value, size_t length, double *number);
 /* Delete a cJSON entity and all subentities. */
 CJSON_PUBLIC(void) cJSON_Delete(cJSON *c);
 
@@ -232,6 +266,10 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON
 CJSON_PUBLIC(void) cJSON_ReplaceItemInArray(cJSON *array, int which, cJSON *newitem);
 CJSON_PUBLIC(void) cJSON_ReplaceItemInObject(cJSON *object,const char *string,cJSON *newitem);
 CJSON_PUBLIC(void) cJSON_ReplaceItemInObjectCaseSensitive(cJSON *object,const char *string,cJSON *newitem);
+/* (Re)build the key index of object (see CJSON_OBJECT_INDEX), whatever its number of children. Returns false if object can't be indexed, e.g. it is not an object, lives in an arena or CJSON_OBJECT_INDEX is not defined. */
+CJSON_PUBLIC(cJSON_bool) cJSON_IndexObject(cJSON *object);
+/* Drop the key index of object (see CJSON_OBJECT_INDEX). Call it after changing the children of an object other than through the functions above, e.g. by setting child, next or string directly, then cJSON_IndexObject() to index it again. */
+CJSON_PUBLIC(void) cJSON_InvalidateIndex(cJSON *object);
 
 /* Duplicate a cJSON item */
 CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse);
@@ -0,0 +1,738 @@
+/*
+  Copyright 2026 NXP
+
+  SPDX-License-Identifier: MIT
+*/
+
+/* Runtime of the bindings generated by scripts/cjson_bindgen.py */
+
+#include <string.h>
+
+#include "cJSON_Bind.h"
+
+/* define our own boolean type */
+#ifdef true
+#undef true
+#endif
+#define true ((cJSON_bool)1)
+
+#ifdef false
+#undef false
+#endif
+#define false ((cJSON_bool)0)
+
+static cJSON_bool fail(cJSONBind_Parser * const parser, const int result)
+{
+    if (parser->result == CJSON_BIND_OK)
+    {
+        parser->result = result;
+    }
+
+    return false;
+}
+
+/* skip whitespace, returns the next byte or -1 at the end */
+static int peek(cJSONBind_Parser * const parser)
+{
+    while ((parser->offset < parser->length) && (parser->content[parser->offset] <= 32))
+    {
+        parser->offset++;
+    }
+    if (parser->offset == parser->length)
+    {
+        return -1;
+    }
+
+    return parser->content[parser->offset];
+}
+
+static cJSON_bool parse_hex4(const unsigned char * const input, unsigned long * const value)
+{
+    size_t i = 0;
+
+    *value = 0;
+    for (i = 0; i < 4; i++)
+    {
+        *value <<= 4;
+        if ((input[i] >= '0') && (input[i] <= '9'))
+        {
+            *value += (unsigned long)(input[i] - '0');
+        }
+        else if ((input[i] >= 'A') && (input[i] <= 'F'))
+        {
+            *value += (unsigned long)(10 + input[i] - 'A');
+        }
+        else if ((input[i] >= 'a') && (input[i] <= 'f'))
+        {
+            *value += (unsigned long)(10 + input[i] - 'a');
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Parse the string at the offset (after peek()), unescaping it into output (when it is not NULL) while it fits in
+ * size bytes with the '\0'. *length receives the unescaped length, and *has_null whether it has a "\u0000". */
+static cJSON_bool parse_string(cJSONBind_Parser * const parser, char *output, const size_t size, size_t * const length, cJSON_bool * const has_null)
+{
+    const unsigned char *input = parser->content;
+    size_t position = parser->offset + 1;
+    size_t written = 0;
+
+    *has_null = false;
+    while (position < parser->length)
+    {
+        unsigned char utf8[4];
+        size_t utf8_length = 1;
+
+        if (input[position] == '\"')
+        {
+            if ((output != NULL) && (written < size))
+            {
+                output[written] = '\0';
+            }
+            *length = written;
+            parser->offset = position + 1;
+
+            return true;
+        }
+
+        if (input[position] != '\\')
+        {
+            /* copy the characters up to the next escape, '\0' or the end in one go */
+            size_t run = 1;
+
+            if (input[position] == '\0')
+            {
+                *has_null = true;
+            }
+            while (((position + run) < parser->length) && (input[position + run] != '\"') && (input[position + run] != '\\') && (input[position + run] != '\0'))
+            {
+                run++;
+            }
+            if ((output != NULL) && ((written + run) < size))
+            {
+                memcpy(output + written, input + position, run);
+            }
+            written += run;
+            position += run;
+            continue;
+        }
+        else
+        {
+            if ((position + 1) >= parser->length)
+            {
+                break;
+            }
+            switch (input[position + 1])
+            {
+                case 'b':
+                    utf8[0] = '\b';
+                    break;
+                case 'f':
+                    utf8[0] = '\f';
+                    break;
+                case 'n':
+                    utf8[0] = '\n';
+                    break;
+                case 'r':
+                    utf8[0] = '\r';
+                    break;
+                case 't':
+                    utf8[0] = '\t';
+                    break;
+                case '\"':
+                case '\\':
+                case '/':
+                    utf8[0] = input[position + 1];
+                    break;
+                case 'u':
+                {
+                    unsigned long codepoint = 0;
+                    unsigned long low_surrogate = 0;
+
+                    if (((position + 6) > parser->length) || !parse_hex4(input + position + 2, &codepoint) || ((codepoint >= 0xDC00) && (codepoint <= 0xDFFF)))
+                    {
+                        return fail(parser, CJSON_BIND_ERROR_SYNTAX);
+                    }
+                    if ((codepoint >= 0xD800) && (codepoint <= 0xDBFF))
+                    {
+                        /* UTF16 surrogate pair */
+                        if (((position + 12) > parser->length) || (input[position + 6] != '\\') || (input[position + 7] != 'u')
+                            || !parse_hex4(input + position + 8, &low_surrogate) || (low_surrogate < 0xDC00) || (low_surrogate > 0xDFFF))
+                        {
+                            return fail(parser, CJSON_BIND_ERROR_SYNTAX);
+                        }
+                        codepoint = 0x10000 + (((codepoint & 0x3FF) << 10) | (low_surrogate & 0x3FF));
+                        position += 6;
+                    }
+
+                    /* encode as UTF-8 */
+                    if (codepoint < 0x80)
+                    {
+                        utf8[0] = (unsigned char)codepoint;
+                    }
+                    else if (codepoint < 0x800)
+                    {
+                        utf8[0] = (unsigned char)(0xC0 | (codepoint >> 6));
+                        utf8[1] = (unsigned char)(0x80 | (codepoint & 0x3F));
+                        utf8_length = 2;
+                    }
+                    else if (codepoint < 0x10000)
+                    {
+                        utf8[0] = (unsigned char)(0xE0 | (codepoint >> 12));
+                        utf8[1] = (unsigned char)(0x80 | ((codepoint >> 6) & 0x3F));
+                        utf8[2] = (unsigned char)(0x80 | (codepoint & 0x3F));
+                        utf8_length = 3;
+                    }
+                    else
+                    {
+                        utf8[0] = (unsigned char)(0xF0 | (codepoint >> 18));
+                        utf8[1] = (unsigned char)(0x80 | ((codepoint >> 12) & 0x3F));
+                        utf8[2] = (unsigned char)(0x80 | ((codepoint >> 6) & 0x3F));
+                        utf8[3] = (unsigned char)(0x80 | (codepoint & 0x3F));
+                        utf8_length = 4;
+                    }
+                    /* the 2 below make the 6 of \uXXXX */
+                    position += 4;
+                    break;
+                }
+                default:
+                    return fail(parser, CJSON_BIND_ERROR_SYNTAX);
+            }
+            position += 2;
+        }
+
+        if (utf8[0] == '\0')
+        {
+            *has_null = true;
+        }
+        if ((output != NULL) && ((written + utf8_length) < size))
+        {
+            memcpy(output + written, utf8, utf8_length);
+        }
+        written += utf8_length;
+    }
+
+    /* no closing quote */
+    parser->offset = parser->length;
+
+    return fail(parser, CJSON_BIND_ERROR_SYNTAX);
+}
+
+/* Parse one of the literals true, false and null. */
+static cJSON_bool parse_literal(cJSONBind_Parser * const parser, const char * const literal)
+{
+    size_t length = strlen(literal);
+
+    if (((parser->length - parser->offset) < length) || (memcmp(parser->content + parser->offset, literal, length) != 0))
+    {
+        return fail(parser, CJSON_BIND_ERROR_SYNTAX);
+    }
+    parser->offset += length;
+
+    return true;
+}
+
+/* Parse the number at the offset (after peek()). */
+static cJSON_bool parse_number(cJSONBind_Parser * const parser, double * const number)
+{
+    size_t length = cJSON_ParseNumber((const char*)parser->content + parser->offset, parser->length - parser->offset, number);
+
+    if (length == 0)
+    {
+        return fail(parser, CJSON_BIND_ERROR_SYNTAX);
+    }
+    parser->offset += length;
+
+    return true;
+}
+
+/* Whether a byte starts a value of the given type, or a value of another type (a schema error), or no value at
+ * all (a syntax error). */
+static cJSON_bool expect(cJSONBind_Parser * const parser, const char * const starts)
+{
+    int next = peek(parser);
+
+    if ((next != -1) && (strchr(starts, next) != NULL))
+    {
+        return true;
+    }
+    if ((next != -1) && (strchr("{[\"tfn-0123456789", next) != NULL))
+    {
+        return fail(parser, CJSON_BIND_ERROR_SCHEMA);
+    }
+
+    return fail(parser, CJSON_BIND_ERROR_SYNTAX);
+}
+
+CJSON_PUBLIC(void) cJSONBind_InitParser(cJSONBind_Parser * const parser, const char *json, size_t length)
+{
+    parser->content = (const unsigned char*)json;
+    parser->length = (json != NULL) ? length : 0;
+    parser->offset = 0;
+    parser->result = CJSON_BIND_OK;
+    parser->first = false;
+
+    /* skip the UTF-8 BOM as cJSON_Parse does */
+    if ((parser->length >= 3) && (memcmp(json, "\xEF\xBB\xBF", 3) == 0))
+    {
+        parser->offset = 3;
+    }
+}
+
+CJSON_PUBLIC(int) cJSONBind_EndParser(cJSONBind_Parser * const parser)
+{
+    if ((parser->result == CJSON_BIND_OK) && (peek(parser) != -1))
+    {
+        fail(parser, CJSON_BIND_ERROR_SYNTAX);
+    }
+
+    return parser->result;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSONBind_ObjectStart(cJSONBind_Parser * const parser)
+{
+    if (!expect(parser, "{"))
+    {
+        return false;
+    }
+    parser->offset++;
+    parser->first = true;
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSONBind_ObjectNext(cJSONBind_Parser * const parser, char *key, size_t key_size, size_t *key_length)
+{
+    int next = peek(parser);
+    cJSON_bool has_null = false;
+    size_t length = 0;
+
+    if (parser->result != CJSON_BIND_OK)
+    {
+        return false;
+    }
+    if (next == '}')
+    {
+        parser->offset++;
+        parser->first = false;
+        return false;
+    }
+    if (!parser->first)
+    {
+        if (next != ',')
+        {
+            return fail(parser, CJSON_BIND_ERROR_SYNTAX);
+        }
+        parser->offset++;
+        next = peek(parser);
+    }
+    parser->first = false;
+
+    if (next != '\"')
+    {
+        return fail(parser, CJSON_BIND_ERROR_SYNTAX);
+    }
+    if (!parse_string(parser, key, key_size, &length, &has_null))
+    {
+        return false;
+    }
+    if (peek(parser) != ':')
+    {
+        return fail(parser, CJSON_BIND_ERROR_SYNTAX);
+    }
+    parser->offset++;
+
+    if (key_length != NULL)
+    {
+        /* a key with a '\0' matches none */
+        *key_length = ((length < key_size) && !has_null) ? length : key_size;
+    }
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSONBind_ArrayStart(cJSONBind_Parser * const parser)
+{
+    if (!expect(parser, "["))
+    {
+        return false;
+    }
+    parser->offset++;
+    parser->first = true;
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSONBind_ArrayNext(cJSONBind_Parser * const parser)
+{
+    int next = peek(parser);
+
+    if (parser->result != CJSON_BIND_OK)
+    {
+        return false;
+    }
+    if (next == ']')
+    {
+        parser->offset++;
+        parser->first = false;
+        return false;
+    }
+    if (!parser->first)
+    {
+        if (next != ',')
+        {
+            return fail(parser, CJSON_BIND_ERROR_SYNTAX);
+        }
+        parser->offset++;
+    }
+    parser->first = false;
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSONBind_String(cJSONBind_Parser * const parser, char *string, size_t size)
+{
+    size_t start = 0;
+    size_t length = 0;
+    cJSON_bool has_null = false;
+
+    if (!expect(parser, "\""))
+    {
+        return false;
+    }
+    start = parser->offset;
+    if (!parse_string(parser, string, size, &length, &has_null))
+    {
+        return false;
+    }
+    if ((length >= size) || has_null)
+    {
+        parser->offset = start;
+        return fail(parser, CJSON_BIND_ERROR_SCHEMA);
+    }
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSONBind_Integer(cJSONBind_Parser * const parser, int32_t *integer, int32_t minimum, int32_t maximum)
+{
+    size_t start = 0;
+    double number = 0;
+
+    if (!expect(parser, "-0123456789"))
+    {
+        return false;
+    }
+    start = parser->offset;
+    if (!parse_number(parser, &number))
+    {
+        return false;
+    }
+    /* a double has all int32_t exactly */
+    if ((number < (double)minimum) || (number > (double)maximum) || (number != (double)(int32_t)number))
+    {
+        parser->offset = start;
+        return fail(parser, CJSON_BIND_ERROR_SCHEMA);
+    }
+    *integer = (int32_t)number;
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSONBind_Number(cJSONBind_Parser * const parser, double *number)
+{
+    if (!expect(parser, "-0123456789"))
+    {
+        return false;
+    }
+
+    return parse_number(parser, number);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSONBind_Bool(cJSONBind_Parser * const parser, cJSON_bool *boolean)
+{
+    if (!expect(parser, "tf"))
+    {
+        return false;
+    }
+    *boolean = (parser->content[parser->offset] == 't');
+
+    return parse_literal(parser, *boolean ? "true" : "false");
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSONBind_Enum(cJSONBind_Parser * const parser, const char * const *names, size_t count, int *value)
+{
+    char string[CJSON_BIND_ENUM_SIZE];
+    size_t start = 0;
+    size_t i = 0;
+
+    if (!expect(parser, "\""))
+    {
+        return false;
+    }
+    start = parser->offset;
+    if (!cJSONBind_String(parser, string, sizeof(string)))
+    {
+        return false;
+    }
+    for (i = 0; i < count; i++)
+    {
+        if (strcmp(string, names[i]) == 0)
+        {
+            *value = (int)i;
+            return true;
+        }
+    }
+    parser->offset = start;
+
+    return fail(parser, CJSON_BIND_ERROR_SCHEMA);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSONBind_Skip(cJSONBind_Parser * const parser)
+{
+    /* one bit per nesting level: object (1) or array (0) */
+    unsigned char objects[(CJSON_NESTING_LIMIT + 7) / 8];
+    size_t depth = 0;
+    cJSON_bool has_null = false;
+    size_t length = 0;
+    double number = 0;
+
+    for (;;)
+    {
+        cJSON_bool more = false;
+
+        /* a value */
+        switch (peek(parser))
+        {
+            case '{':
+            case '[':
+                if (depth == CJSON_NESTING_LIMIT)
+                {
+                    return fail(parser, CJSON_BIND_ERROR_SYNTAX);
+                }
+                if (parser->content[parser->offset] == '{')
+                {
+                    objects[depth / 8] = (unsigned char)(objects[depth / 8] | (1U << (depth % 8)));
+                    more = cJSONBind_ObjectStart(parser) && cJSONBind_ObjectNext(parser, NULL, 0, NULL);
+                }
+                else
+                {
+                    objects[depth / 8] = (unsigned char)(objects[depth / 8] & ~(1U << (depth % 8)));
+                    more = cJSONBind_ArrayStart(parser) && cJSONBind_ArrayNext(parser);
+                }
+                if (more)
+                {
+                    depth++;
+                    continue;
+                }
+                break;
+            case '\"':
+                parse_string(parser, NULL, 0, &length, &has_null);
+                break;
+            case 't':
+                parse_literal(parser, "true");
+                break;
+            case 'f':
+                parse_literal(parser, "false");
+                break;
+            case 'n':
+                parse_literal(parser, "null");
+                break;
+            default:
+                parse_number(parser, &number);
+                break;
+        }
+
+        /* close the objects and arrays that have no more members */
+        while (parser->result == CJSON_BIND_OK)
+        {
+            if (depth == 0)
+            {
+                return true;
+            }
+            if ((objects[(depth - 1) / 8] & (1U << ((depth - 1) % 8))) != 0)
+            {
+                more = cJSONBind_ObjectNext(parser, NULL, 0, NULL);
+            }
+            else
+            {
+                more = cJSONBind_ArrayNext(parser);
+            }
+            if (more)
+            {
+                break;
+            }
+            depth--;
+        }
+        if (parser->result != CJSON_BIND_OK)
+        {
+            return false;
+        }
+    }
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSONBind_SchemaError(cJSONBind_Parser * const parser)
+{
+    return fail(parser, CJSON_BIND_ERROR_SCHEMA);
+}
+
+CJSON_PUBLIC(void) cJSONBind_InitWriter(cJSONBind_Writer * const writer, char *buffer, size_t size)
+{
+    writer->buffer = buffer;
+    writer->size = (buffer != NULL) ? size : 0;
+    writer->length = 0;
+    writer->result = CJSON_BIND_OK;
+}
+
+CJSON_PUBLIC(int) cJSONBind_EndWriter(cJSONBind_Writer * const writer)
+{
+    if ((writer->result == CJSON_BIND_OK) && (writer->length >= writer->size))
+    {
+        writer->result = CJSON_BIND_ERROR_BUFFER;
+    }
+    if (writer->result != CJSON_BIND_OK)
+    {
+        if (writer->size > 0)
+        {
+            writer->buffer[0] = '\0';
+        }
+        return writer->result;
+    }
+    writer->buffer[writer->length] = '\0';
+
+    return (int)writer->length;
+}
+
+CJSON_PUBLIC(void) cJSONBind_PutRaw(cJSONBind_Writer * const writer, const char *text, size_t length)
+{
+    if (writer->result != CJSON_BIND_OK)
+    {
+        return;
+    }
+    if (length > (writer->size - writer->length))
+    {
+        writer->result = CJSON_BIND_ERROR_BUFFER;
+        return;
+    }
+    memcpy(writer->buffer + writer->length, text, length);
+    writer->length += length;
+}
+
+CJSON_PUBLIC(void) cJSONBind_PutString(cJSONBind_Writer * const writer, const char *string, size_t max_length)
+{
+    static const char hex[] = "0123456789abcdef";
+    const unsigned char *input = (const unsigned char*)string;
+    const unsigned char *end = input + max_length;
+    size_t run = 0;
+
+    cJSONBind_PutRaw(writer, "\"", 1);
+    for (;;)
+    {
+        char escaped[6] = { '\\', 'u', '0', '0', 0, 0 };
+        size_t escaped_length = 2;
+
+        /* copy the characters that don't need escaping in one go */
+        while (((input + run) < end) && (input[run] > 31) && (input[run] != '\"') && (input[run] != '\\'))
+        {
+            run++;
+        }
+        cJSONBind_PutRaw(writer, (const char*)input, run);
+        if (((input + run) == end) || (input[run] == '\0'))
+        {
+            break;
+        }
+
+        /* escape as print_string_ptr() does */
+        switch (input[run])
+        {
+            case '\"':
+            case '\\':
+                escaped[1] = (char)input[run];
+                break;
+            case '\b':
+                escaped[1] = 'b';
+                break;
+            case '\f':
+                escaped[1] = 'f';
+                break;
+            case '\n':
+                escaped[1] = 'n';
+                break;
+            case '\r':
+                escaped[1] = 'r';
+                break;
+            case '\t':
+                escaped[1] = 't';
+                break;
+            default:
+                escaped[4] = hex[input[run] >> 4];
+                escaped[5] = hex[input[run] & 0xF];
+                escaped_length = 6;
+                break;
+        }
+        cJSONBind_PutRaw(writer, escaped, escaped_length);
+        input += run + 1;
+        run = 0;
+    }
+    cJSONBind_PutRaw(writer, "\"", 1);
+}
+
+CJSON_PUBLIC(void) cJSONBind_PutInteger(cJSONBind_Writer * const writer, int32_t integer)
+{
+    char text[CJSON_NUMBER_LENGTH_MAX + 1];
+
+    cJSONBind_PutRaw(writer, text, cJSON_PrintNumber((double)integer, text));
+}
+
+CJSON_PUBLIC(void) cJSONBind_PutNumber(cJSONBind_Writer * const writer, double number)
+{
+    char text[CJSON_NUMBER_LENGTH_MAX + 1];
+
+    cJSONBind_PutRaw(writer, text, cJSON_PrintNumber(number, text));
+}
+
+CJSON_PUBLIC(void) cJSONBind_PutBool(cJSONBind_Writer * const writer, cJSON_bool boolean)
+{
+    if (boolean)
+    {
+        cJSONBind_PutRaw(writer, "true", sizeof("true") - 1);
+    }
+    else
+    {
+        cJSONBind_PutRaw(writer, "false", sizeof("false") - 1);
+    }
+}
+
+CJSON_PUBLIC(void) cJSONBind_PutEnum(cJSONBind_Writer * const writer, const char * const *names, size_t count, int value)
+{
+    if ((value < 0) || ((size_t)value >= count))
+    {
+        if (writer->result == CJSON_BIND_OK)
+        {
+            writer->result = CJSON_BIND_ERROR_SCHEMA;
+        }
+        return;
+    }
+    cJSONBind_PutString(writer, names[value], strlen(names[value]));
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSONBind_PutArrayStart(cJSONBind_Writer * const writer, size_t count, size_t max_count)
+{
+    if (count > max_count)
+    {
+        if (writer->result == CJSON_BIND_OK)
+        {
+            writer->result = CJSON_BIND_ERROR_SCHEMA;
+        }
+        return false;
+    }
+    cJSONBind_PutRaw(writer, "[", 1);
+
+    return writer->result == CJSON_BIND_OK;
+}
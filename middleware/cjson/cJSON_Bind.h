@@ -0,0 +1,106 @@
+/*
+  Copyright 2026 NXP
+
+  SPDX-License-Identifier: MIT
+*/
+
+#ifndef cJSON_Bind__h
+#define cJSON_Bind__h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+#include "cJSON.h"
+
+/* Runtime of the bindings generated by scripts/cjson_bindgen.py from a JSON schema: the generated functions parse
+ * a document straight into C structures, and print C structures straight into a caller buffer, without building
+ * cJSON items. Nothing is allocated. Applications call the generated functions, not these. */
+
+/* Results of the generated parse and print functions. */
+#define CJSON_BIND_OK 0
+#define CJSON_BIND_ERROR_SYNTAX (-1) /* invalid JSON */
+#define CJSON_BIND_ERROR_SCHEMA (-2) /* valid JSON, but not of the schema: wrong type, missing member, out of range */
+#define CJSON_BIND_ERROR_BUFFER (-3) /* the print buffer is too small */
+
+/* Size of the buffer enum strings are read into, i.e. maximum length of an enum string plus one. */
+#ifndef CJSON_BIND_ENUM_SIZE
+#define CJSON_BIND_ENUM_SIZE 32
+#endif
+
+/* Longest (escaped) text of a value, without the '\0', to compute print buffer sizes at compile time. Strings are
+ * counted as if every byte was a control character, printed as \u00XX. */
+#define CJSON_BIND_STRING_LENGTH_MAX(max_length) (2 + (6 * (max_length)))
+#define CJSON_BIND_INTEGER_LENGTH_MAX 11
+#define CJSON_BIND_NUMBER_LENGTH_MAX CJSON_NUMBER_LENGTH_MAX
+#define CJSON_BIND_BOOL_LENGTH_MAX 5
+
+typedef struct cJSONBind_Parser
+{
+    const unsigned char *content;
+    size_t length;
+    /* position of the next byte: on an error, of the offending value */
+    size_t offset;
+    int result;
+    /* just after the '{' or '[' of an object or array */
+    cJSON_bool first;
+} cJSONBind_Parser;
+
+typedef struct cJSONBind_Writer
+{
+    char *buffer;
+    size_t size;
+    size_t length;
+    int result;
+} cJSONBind_Writer;
+
+/* Parsing: the functions return false on an error, which is kept in parser->result. */
+CJSON_PUBLIC(void) cJSONBind_InitParser(cJSONBind_Parser * const parser, const char *json, size_t length);
+/* Check that only whitespace is left, returns parser->result. */
+CJSON_PUBLIC(int) cJSONBind_EndParser(cJSONBind_Parser * const parser);
+/* Objects: after cJSONBind_ObjectStart(), cJSONBind_ObjectNext() reads the next key (unescaped into key, of
+ * key_size bytes) and its ':', until it returns false at the '}' or on an error. *key_length is the length of the
+ * key, or key_size if the key doesn't fit. */
+CJSON_PUBLIC(cJSON_bool) cJSONBind_ObjectStart(cJSONBind_Parser * const parser);
+CJSON_PUBLIC(cJSON_bool) cJSONBind_ObjectNext(cJSONBind_Parser * const parser, char *key, size_t key_size, size_t *key_length);
+/* Arrays: after cJSONBind_ArrayStart(), cJSONBind_ArrayNext() returns true before each element, and false at the
+ * ']' or on an error. */
+CJSON_PUBLIC(cJSON_bool) cJSONBind_ArrayStart(cJSONBind_Parser * const parser);
+CJSON_PUBLIC(cJSON_bool) cJSONBind_ArrayNext(cJSONBind_Parser * const parser);
+/* Values: a string that doesn't fit in size bytes (with its '\0'), or has a '\0', is a schema error. */
+CJSON_PUBLIC(cJSON_bool) cJSONBind_String(cJSONBind_Parser * const parser, char *string, size_t size);
+CJSON_PUBLIC(cJSON_bool) cJSONBind_Integer(cJSONBind_Parser * const parser, int32_t *integer, int32_t minimum, int32_t maximum);
+CJSON_PUBLIC(cJSON_bool) cJSONBind_Number(cJSONBind_Parser * const parser, double *number);
+CJSON_PUBLIC(cJSON_bool) cJSONBind_Bool(cJSONBind_Parser * const parser, cJSON_bool *boolean);
+/* A string that must be one of names, *value receives its index. */
+CJSON_PUBLIC(cJSON_bool) cJSONBind_Enum(cJSONBind_Parser * const parser, const char * const *names, size_t count, int *value);
+/* Skip a value of any type (a member not in the schema), up to CJSON_NESTING_LIMIT deep. */
+CJSON_PUBLIC(cJSON_bool) cJSONBind_Skip(cJSONBind_Parser * const parser);
+/* Report a schema error, such as a missing member or too many elements. */
+CJSON_PUBLIC(cJSON_bool) cJSONBind_SchemaError(cJSONBind_Parser * const parser);
+
+/* Printing: the functions print unformatted JSON, as cJSON_PrintUnformatted does. A buffer overflow, or a value
+ * out of the schema (CJSON_BIND_ERROR_SCHEMA), is kept in writer->result, and the functions do nothing after it. */
+CJSON_PUBLIC(void) cJSONBind_InitWriter(cJSONBind_Writer * const writer, char *buffer, size_t size);
+/* '\0' terminate the text, returns its length or writer->result. */
+CJSON_PUBLIC(int) cJSONBind_EndWriter(cJSONBind_Writer * const writer);
+/* Punctuation and keys, as they are (already escaped). */
+CJSON_PUBLIC(void) cJSONBind_PutRaw(cJSONBind_Writer * const writer, const char *text, size_t length);
+/* Strings stop at their '\0' or after max_length bytes, so that they are never longer than their schema says. */
+CJSON_PUBLIC(void) cJSONBind_PutString(cJSONBind_Writer * const writer, const char *string, size_t max_length);
+CJSON_PUBLIC(void) cJSONBind_PutInteger(cJSONBind_Writer * const writer, int32_t integer);
+CJSON_PUBLIC(void) cJSONBind_PutNumber(cJSONBind_Writer * const writer, double number);
+CJSON_PUBLIC(void) cJSONBind_PutBool(cJSONBind_Writer * const writer, cJSON_bool boolean);
+/* A value out of 0 .. count - 1 is a schema error. */
+CJSON_PUBLIC(void) cJSONBind_PutEnum(cJSONBind_Writer * const writer, const char * const *names, size_t count, int value);
+/* Print the '[' of an array, returns false if count is more than max_count (a schema error). */
+CJSON_PUBLIC(cJSON_bool) cJSONBind_PutArrayStart(cJSONBind_Writer * const writer, size_t count, size_t max_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
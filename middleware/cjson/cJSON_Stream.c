@@ -0,0 +1,876 @@
+/*
+  Copyright 2026 NXP
+
+  SPDX-License-Identifier: MIT
+*/
+
+/* disable warnings about old C89 functions in MSVC */
+#if !defined(_CRT_SECURE_NO_DEPRECATE) && defined(_MSC_VER)
+#define _CRT_SECURE_NO_DEPRECATE
+#endif
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "cJSON_Stream.h"
+
+/* define our own boolean type */
+#define true ((cJSON_bool)1)
+#define false ((cJSON_bool)0)
+
+/* what the parser expects next */
+enum
+{
+    stream_value,       /* a value */
+    stream_first_value, /* a value or ']', after '[' */
+    stream_first_key,   /* a key or '}', after '{' */
+    stream_key,         /* a key, after ',' in an object */
+    stream_colon,       /* ':' after a key */
+    stream_next,        /* ',' or the end of the object or array, after a value */
+    stream_string,      /* the next character of a string */
+    stream_escape,      /* the character after '\' */
+    stream_unicode,     /* the hex digits of \uXXXX */
+    stream_low_escape,  /* '\' of the low surrogate after a high one */
+    stream_low_u,       /* 'u' of the low surrogate */
+    stream_number,      /* the next character of a number */
+    stream_literal,     /* the next character of true, false or null */
+    stream_done,        /* only whitespace after the root value */
+    stream_error
+};
+
+CJSON_PUBLIC(void) cJSONStream_Init(cJSONStream * const stream, cJSONStream_Callback callback, void *arg)
+{
+    memset(stream, '\0', sizeof(*stream));
+    stream->callback = callback;
+    stream->arg = arg;
+    stream->state = stream_value;
+    stream->result = CJSON_STREAM_OK;
+}
+
+static int fail(cJSONStream * const stream, int result)
+{
+    stream->state = stream_error;
+    stream->result = result;
+
+    return result;
+}
+
+/* append to the path, escaping '~' and '/' as in RFC6901 when escape is set */
+static cJSON_bool path_append(cJSONStream * const stream, size_t *length, const char *string, cJSON_bool escape)
+{
+    for (; *string != '\0'; string++)
+    {
+        const char *sequence = string;
+        size_t sequence_length = 1;
+
+        if (escape && (*string == '~'))
+        {
+            sequence = "~0";
+            sequence_length = 2;
+        }
+        else if (escape && (*string == '/'))
+        {
+            sequence = "~1";
+            sequence_length = 2;
+        }
+
+        if ((*length + sequence_length) >= sizeof(stream->path))
+        {
+            return false;
+        }
+        memcpy(stream->path + *length, sequence, sequence_length);
+        *length += sequence_length;
+    }
+    stream->path[*length] = '\0';
+
+    return true;
+}
+
+/* set the path to the one of the value about to be reported, within the innermost object or array */
+static cJSON_bool path_of_value(cJSONStream * const stream)
+{
+    char index[12];
+    size_t length = 0;
+    size_t position = sizeof(index) - 1;
+    unsigned long number = 0;
+
+    if (stream->depth == 0)
+    {
+        stream->path[0] = '\0';
+        return true;
+    }
+
+    length = stream->path_length[stream->depth - 1];
+    if (!path_append(stream, &length, "/", false))
+    {
+        return false;
+    }
+    if (stream->object[stream->depth - 1])
+    {
+        return path_append(stream, &length, stream->key, true);
+    }
+
+    number = stream->index[stream->depth - 1];
+    index[position] = '\0';
+    do
+    {
+        index[--position] = (char)('0' + (number % 10));
+        number /= 10;
+    }
+    while (number != 0);
+
+    return path_append(stream, &length, index + position, false);
+}
+
+/* report a value and continue after it */
+static int emit(cJSONStream * const stream, cJSONStream_Event * const event)
+{
+    event->depth = stream->depth;
+    event->key = NULL;
+    if (!event->end && (stream->depth > 0) && stream->object[stream->depth - 1])
+    {
+        event->key = stream->key;
+    }
+    if (!event->end && !path_of_value(stream))
+    {
+        return fail(stream, CJSON_STREAM_ERROR_LIMIT);
+    }
+    event->path = stream->path;
+
+    if (stream->callback(stream->arg, event) != 0)
+    {
+        return fail(stream, CJSON_STREAM_ERROR_ABORTED);
+    }
+
+    return CJSON_STREAM_OK;
+}
+
+/* state after a complete value */
+static void value_done(cJSONStream * const stream)
+{
+    stream->state = (stream->depth == 0) ? stream_done : stream_next;
+}
+
+static int emit_scalar(cJSONStream * const stream, int type, double number)
+{
+    cJSONStream_Event event;
+
+    memset(&event, '\0', sizeof(event));
+    event.type = type;
+    event.number = number;
+    if (emit(stream, &event) != CJSON_STREAM_OK)
+    {
+        return stream->result;
+    }
+    value_done(stream);
+
+    return CJSON_STREAM_OK;
+}
+
+/* report a string value, or the piece of it in the buffer */
+static int emit_string(cJSONStream * const stream, cJSON_bool partial)
+{
+    cJSONStream_Event event;
+    int result = CJSON_STREAM_OK;
+
+    memset(&event, '\0', sizeof(event));
+    event.type = cJSON_String;
+    event.partial = partial;
+    stream->string[stream->string_length] = '\0';
+    event.string = stream->string;
+    event.length = stream->string_length;
+
+    result = emit(stream, &event);
+    stream->string_length = 0;
+
+    return result;
+}
+
+static int start_container(cJSONStream * const stream, cJSON_bool object)
+{
+    cJSONStream_Event event;
+
+    if (stream->depth == CJSON_STREAM_DEPTH)
+    {
+        return fail(stream, CJSON_STREAM_ERROR_LIMIT);
+    }
+
+    memset(&event, '\0', sizeof(event));
+    event.type = object ? cJSON_Object : cJSON_Array;
+    if (emit(stream, &event) != CJSON_STREAM_OK)
+    {
+        return stream->result;
+    }
+
+    stream->object[stream->depth] = (unsigned char)object;
+    stream->index[stream->depth] = 0;
+    stream->path_length[stream->depth] = strlen(stream->path);
+    stream->depth++;
+    stream->state = object ? stream_first_key : stream_first_value;
+
+    return CJSON_STREAM_OK;
+}
+
+static int end_container(cJSONStream * const stream)
+{
+    cJSONStream_Event event;
+
+    memset(&event, '\0', sizeof(event));
+    event.type = stream->object[stream->depth - 1] ? cJSON_Object : cJSON_Array;
+    event.end = true;
+    stream->depth--;
+    stream->path[stream->path_length[stream->depth]] = '\0';
+    if (emit(stream, &event) != CJSON_STREAM_OK)
+    {
+        return stream->result;
+    }
+    value_done(stream);
+
+    return CJSON_STREAM_OK;
+}
+
+/* add a decoded byte to the key or the value */
+static int string_add(cJSONStream * const stream, unsigned char byte)
+{
+    if (stream->in_key)
+    {
+        if ((stream->key_length + 1) >= sizeof(stream->key))
+        {
+            return fail(stream, CJSON_STREAM_ERROR_LIMIT);
+        }
+        stream->key[stream->key_length++] = (char)byte;
+        return CJSON_STREAM_OK;
+    }
+
+    if ((stream->string_length + 1) >= sizeof(stream->string))
+    {
+        if (emit_string(stream, true) != CJSON_STREAM_OK)
+        {
+            return stream->result;
+        }
+    }
+    stream->string[stream->string_length++] = (char)byte;
+
+    return CJSON_STREAM_OK;
+}
+
+static int string_add_codepoint(cJSONStream * const stream, unsigned long codepoint)
+{
+    unsigned char utf8[4];
+    size_t length = 0;
+    size_t i = 0;
+
+    if (codepoint < 0x80)
+    {
+        utf8[length++] = (unsigned char)codepoint;
+    }
+    else if (codepoint < 0x800)
+    {
+        utf8[length++] = (unsigned char)(0xC0 | (codepoint >> 6));
+        utf8[length++] = (unsigned char)(0x80 | (codepoint & 0x3F));
+    }
+    else if (codepoint < 0x10000)
+    {
+        utf8[length++] = (unsigned char)(0xE0 | (codepoint >> 12));
+        utf8[length++] = (unsigned char)(0x80 | ((codepoint >> 6) & 0x3F));
+        utf8[length++] = (unsigned char)(0x80 | (codepoint & 0x3F));
+    }
+    else
+    {
+        utf8[length++] = (unsigned char)(0xF0 | (codepoint >> 18));
+        utf8[length++] = (unsigned char)(0x80 | ((codepoint >> 12) & 0x3F));
+        utf8[length++] = (unsigned char)(0x80 | ((codepoint >> 6) & 0x3F));
+        utf8[length++] = (unsigned char)(0x80 | (codepoint & 0x3F));
+    }
+
+    for (i = 0; i < length; i++)
+    {
+        if (string_add(stream, utf8[i]) != CJSON_STREAM_OK)
+        {
+            return stream->result;
+        }
+    }
+
+    return CJSON_STREAM_OK;
+}
+
+static int string_end(cJSONStream * const stream)
+{
+    if (stream->in_key)
+    {
+        stream->key[stream->key_length] = '\0';
+        stream->in_key = false;
+        stream->state = stream_colon;
+        return CJSON_STREAM_OK;
+    }
+
+    if (emit_string(stream, false) != CJSON_STREAM_OK)
+    {
+        return stream->result;
+    }
+    value_done(stream);
+
+    return CJSON_STREAM_OK;
+}
+
+/* the \uXXXX sequence in codepoint is complete */
+static int unicode_done(cJSONStream * const stream)
+{
+    unsigned long code = stream->codepoint;
+
+    if (stream->high_surrogate != 0)
+    {
+        if ((code < 0xDC00) || (code > 0xDFFF))
+        {
+            return fail(stream, CJSON_STREAM_ERROR_SYNTAX); /* invalid second half of the surrogate pair */
+        }
+        code = 0x10000 + (((stream->high_surrogate & 0x3FF) << 10) | (code & 0x3FF));
+        stream->high_surrogate = 0;
+    }
+    else if ((code >= 0xDC00) && (code <= 0xDFFF))
+    {
+        return fail(stream, CJSON_STREAM_ERROR_SYNTAX);
+    }
+    else if ((code >= 0xD800) && (code <= 0xDBFF))
+    {
+        stream->high_surrogate = code;
+        stream->state = stream_low_escape;
+        return CJSON_STREAM_OK;
+    }
+
+    stream->state = stream_string;
+
+    return string_add_codepoint(stream, code);
+}
+
+/* check the number against the JSON grammar: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)? */
+static cJSON_bool number_valid(const char *number)
+{
+    if (*number == '-')
+    {
+        number++;
+    }
+    if (*number == '0')
+    {
+        number++;
+    }
+    else if ((*number >= '1') && (*number <= '9'))
+    {
+        while ((*number >= '0') && (*number <= '9'))
+        {
+            number++;
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    if (*number == '.')
+    {
+        number++;
+        if ((*number < '0') || (*number > '9'))
+        {
+            return false;
+        }
+        while ((*number >= '0') && (*number <= '9'))
+        {
+            number++;
+        }
+    }
+
+    if ((*number == 'e') || (*number == 'E'))
+    {
+        number++;
+        if ((*number == '+') || (*number == '-'))
+        {
+            number++;
+        }
+        if ((*number < '0') || (*number > '9'))
+        {
+            return false;
+        }
+        while ((*number >= '0') && (*number <= '9'))
+        {
+            number++;
+        }
+    }
+
+    return *number == '\0';
+}
+
+static int number_end(cJSONStream * const stream)
+{
+    stream->string[stream->string_length] = '\0';
+    stream->string_length = 0;
+    if (!number_valid(stream->string))
+    {
+        return fail(stream, CJSON_STREAM_ERROR_SYNTAX);
+    }
+
+    return emit_scalar(stream, cJSON_Number, strtod(stream->string, NULL));
+}
+
+static cJSON_bool is_whitespace(unsigned char c)
+{
+    return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r');
+}
+
+static int hex_value(unsigned char c)
+{
+    if ((c >= '0') && (c <= '9'))
+    {
+        return c - '0';
+    }
+    if ((c >= 'a') && (c <= 'f'))
+    {
+        return 10 + c - 'a';
+    }
+    if ((c >= 'A') && (c <= 'F'))
+    {
+        return 10 + c - 'A';
+    }
+
+    return -1;
+}
+
+/* start a value with its first character */
+static int value_start(cJSONStream * const stream, unsigned char c)
+{
+    switch (c)
+    {
+        case '{':
+            return start_container(stream, true);
+
+        case '[':
+            return start_container(stream, false);
+
+        case '\"':
+            stream->in_key = false;
+            stream->string_length = 0;
+            stream->state = stream_string;
+            return CJSON_STREAM_OK;
+
+        case 't':
+            stream->literal = "true";
+            break;
+
+        case 'f':
+            stream->literal = "false";
+            break;
+
+        case 'n':
+            stream->literal = "null";
+            break;
+
+        default:
+            if ((c == '-') || ((c >= '0') && (c <= '9')))
+            {
+                stream->string[0] = (char)c;
+                stream->string_length = 1;
+                stream->state = stream_number;
+                return CJSON_STREAM_OK;
+            }
+            return fail(stream, CJSON_STREAM_ERROR_SYNTAX);
+    }
+
+    stream->literal_length = 1;
+    stream->state = stream_literal;
+
+    return CJSON_STREAM_OK;
+}
+
+/* parse one character, returns whether it was consumed (a number ends with the character after it) */
+static cJSON_bool parse_character(cJSONStream * const stream, unsigned char c)
+{
+    switch (stream->state)
+    {
+        case stream_value:
+        case stream_first_value:
+            if (is_whitespace(c))
+            {
+                break;
+            }
+            if ((stream->state == stream_first_value) && (c == ']'))
+            {
+                end_container(stream);
+                break;
+            }
+            value_start(stream, c);
+            break;
+
+        case stream_first_key:
+        case stream_key:
+            if (is_whitespace(c))
+            {
+                break;
+            }
+            if ((stream->state == stream_first_key) && (c == '}'))
+            {
+                end_container(stream);
+                break;
+            }
+            if (c != '\"')
+            {
+                fail(stream, CJSON_STREAM_ERROR_SYNTAX);
+                break;
+            }
+            stream->in_key = true;
+            stream->key_length = 0;
+            stream->state = stream_string;
+            break;
+
+        case stream_colon:
+            if (is_whitespace(c))
+            {
+                break;
+            }
+            if (c != ':')
+            {
+                fail(stream, CJSON_STREAM_ERROR_SYNTAX);
+                break;
+            }
+            stream->state = stream_value;
+            break;
+
+        case stream_next:
+            if (is_whitespace(c))
+            {
+                break;
+            }
+            if (c == ',')
+            {
+                if (stream->object[stream->depth - 1])
+                {
+                    stream->state = stream_key;
+                }
+                else
+                {
+                    stream->index[stream->depth - 1]++;
+                    stream->state = stream_value;
+                }
+                break;
+            }
+            if (c == (stream->object[stream->depth - 1] ? '}' : ']'))
+            {
+                end_container(stream);
+                break;
+            }
+            fail(stream, CJSON_STREAM_ERROR_SYNTAX);
+            break;
+
+        case stream_string:
+            if (c == '\"')
+            {
+                string_end(stream);
+            }
+            else if (c == '\\')
+            {
+                stream->state = stream_escape;
+            }
+            else if (c < 0x20)
+            {
+                fail(stream, CJSON_STREAM_ERROR_SYNTAX); /* control characters must be escaped */
+            }
+            else
+            {
+                string_add(stream, c);
+            }
+            break;
+
+        case stream_escape:
+            stream->state = stream_string;
+            switch (c)
+            {
+                case 'b':
+                    string_add(stream, '\b');
+                    break;
+                case 'f':
+                    string_add(stream, '\f');
+                    break;
+                case 'n':
+                    string_add(stream, '\n');
+                    break;
+                case 'r':
+                    string_add(stream, '\r');
+                    break;
+                case 't':
+                    string_add(stream, '\t');
+                    break;
+                case '\"':
+                case '\\':
+                case '/':
+                    string_add(stream, c);
+                    break;
+                case 'u':
+                    stream->codepoint = 0;
+                    stream->hex_digits = 0;
+                    stream->state = stream_unicode;
+                    break;
+                default:
+                    fail(stream, CJSON_STREAM_ERROR_SYNTAX);
+                    break;
+            }
+            break;
+
+        case stream_unicode:
+            if (hex_value(c) < 0)
+            {
+                fail(stream, CJSON_STREAM_ERROR_SYNTAX);
+                break;
+            }
+            stream->codepoint = (stream->codepoint << 4) | (unsigned long)hex_value(c);
+            if (++stream->hex_digits == 4)
+            {
+                unicode_done(stream);
+            }
+            break;
+
+        case stream_low_escape:
+            if (c != '\\')
+            {
+                fail(stream, CJSON_STREAM_ERROR_SYNTAX); /* missing second half of the surrogate pair */
+                break;
+            }
+            stream->state = stream_low_u;
+            break;
+
+        case stream_low_u:
+            if (c != 'u')
+            {
+                fail(stream, CJSON_STREAM_ERROR_SYNTAX);
+                break;
+            }
+            stream->codepoint = 0;
+            stream->hex_digits = 0;
+            stream->state = stream_unicode;
+            break;
+
+        case stream_number:
+            if (((c >= '0') && (c <= '9')) || (c == '.') || (c == 'e') || (c == 'E') || (c == '+') || (c == '-'))
+            {
+                if ((stream->string_length + 1) >= sizeof(stream->string))
+                {
+                    fail(stream, CJSON_STREAM_ERROR_LIMIT);
+                    break;
+                }
+                stream->string[stream->string_length++] = (char)c;
+                break;
+            }
+            number_end(stream);
+            /* c comes after the number */
+            return false;
+
+        case stream_literal:
+            if (c != (unsigned char)stream->literal[stream->literal_length])
+            {
+                fail(stream, CJSON_STREAM_ERROR_SYNTAX);
+                break;
+            }
+            if (stream->literal[++stream->literal_length] == '\0')
+            {
+                switch (stream->literal[0])
+                {
+                    case 't':
+                        emit_scalar(stream, cJSON_True, 1);
+                        break;
+                    case 'f':
+                        emit_scalar(stream, cJSON_False, 0);
+                        break;
+                    default:
+                        emit_scalar(stream, cJSON_NULL, 0);
+                        break;
+                }
+            }
+            break;
+
+        case stream_done:
+            if (!is_whitespace(c))
+            {
+                fail(stream, CJSON_STREAM_ERROR_SYNTAX); /* more than one value */
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return true;
+}
+
+CJSON_PUBLIC(int) cJSONStream_Feed(cJSONStream * const stream, const char *data, size_t length)
+{
+    const unsigned char *input = (const unsigned char*)data;
+    size_t i = 0;
+
+    while ((i < length) && (stream->state != stream_error))
+    {
+        if (parse_character(stream, input[i]) && (stream->state != stream_error))
+        {
+            i++;
+            stream->position++;
+        }
+    }
+
+    return stream->result;
+}
+
+CJSON_PUBLIC(int) cJSONStream_Finish(cJSONStream * const stream)
+{
+    /* a number at the root ends with the input */
+    if ((stream->state == stream_number) && (stream->depth == 0))
+    {
+        number_end(stream);
+    }
+
+    if (stream->state == stream_error)
+    {
+        return stream->result;
+    }
+    if (stream->state != stream_done)
+    {
+        return fail(stream, CJSON_STREAM_ERROR_SYNTAX);
+    }
+
+    return CJSON_STREAM_OK;
+}
+
+CJSON_PUBLIC(void) cJSONStream_InitSelection(cJSONStream_Selection * const selection, const char * const *paths, cJSON **results, size_t count)
+{
+    size_t i = 0;
+
+    memset(selection, '\0', sizeof(*selection));
+    selection->paths = paths;
+    selection->results = results;
+    selection->count = count;
+    for (i = 0; i < count; i++)
+    {
+        results[i] = NULL;
+    }
+}
+
+/* append a piece to a string being built */
+static cJSON_bool selection_append(cJSON * const item, const cJSONStream_Event * const event)
+{
+    size_t length = strlen(item->valuestring);
+    char *string = (char*)cJSON_malloc(length + event->length + 1);
+
+    if (string == NULL)
+    {
+        return false;
+    }
+    memcpy(string, item->valuestring, length);
+    memcpy(string + length, event->string, event->length + 1);
+    cJSON_free(item->valuestring);
+    item->valuestring = string;
+
+    return true;
+}
+
+static cJSON *selection_create(const cJSONStream_Event * const event)
+{
+    switch (event->type)
+    {
+        case cJSON_Object:
+            return cJSON_CreateObject();
+        case cJSON_Array:
+            return cJSON_CreateArray();
+        case cJSON_String:
+            return cJSON_CreateString(event->string);
+        case cJSON_Number:
+            return cJSON_CreateNumber(event->number);
+        case cJSON_True:
+            return cJSON_CreateTrue();
+        case cJSON_False:
+            return cJSON_CreateFalse();
+        default:
+            return cJSON_CreateNull();
+    }
+}
+
+CJSON_PUBLIC(int) cJSONStream_Select(void *arg, const cJSONStream_Event *event)
+{
+    cJSONStream_Selection * const selection = (cJSONStream_Selection*)arg;
+    cJSON *item = NULL;
+    size_t i = 0;
+
+    /* the next piece of a string */
+    if (selection->string != NULL)
+    {
+        if (!selection_append(selection->string, event))
+        {
+            return 1;
+        }
+        if (!event->partial)
+        {
+            selection->string = NULL;
+        }
+        return 0;
+    }
+
+    if (event->end)
+    {
+        if (selection->depth > 0)
+        {
+            selection->depth--;
+        }
+        return 0;
+    }
+
+    if (selection->depth == 0)
+    {
+        /* not within a selected value: is this one? */
+        for (i = 0; i < selection->count; i++)
+        {
+            if ((selection->results[i] == NULL) && (strcmp(selection->paths[i], event->path) == 0))
+            {
+                break;
+            }
+        }
+        if (i == selection->count)
+        {
+            return 0;
+        }
+
+        item = selection_create(event);
+        if (item == NULL)
+        {
+            return 1;
+        }
+        selection->results[i] = item;
+    }
+    else
+    {
+        cJSON *parent = selection->stack[selection->depth - 1];
+
+        item = selection_create(event);
+        if (item == NULL)
+        {
+            return 1;
+        }
+        if (cJSON_IsObject(parent))
+        {
+            cJSON_AddItemToObject(parent, event->key, item);
+            if (item->string == NULL)
+            {
+                cJSON_Delete(item); /* allocation failure */
+                return 1;
+            }
+        }
+        else
+        {
+            cJSON_AddItemToArray(parent, item);
+        }
+    }
+
+    if ((event->type == cJSON_Object) || (event->type == cJSON_Array))
+    {
+        selection->stack[selection->depth++] = item;
+    }
+    else if (event->partial)
+    {
+        selection->string = item;
+    }
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+/*
+  Copyright 2026 NXP
+
+  SPDX-License-Identifier: MIT
+*/
+
+#ifndef cJSON_Stream__h
+#define cJSON_Stream__h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "cJSON.h"
+
+/* Incremental (SAX style) parser: the JSON text is fed in chunks of any size, and every value is reported to a
+ * callback as soon as it is complete, with its JSON pointer (RFC6901) path. Nothing is allocated: the parser state,
+ * including the buffers below, lives in the cJSONStream structure. */
+
+/* Maximum nesting of arrays and objects. */
+#ifndef CJSON_STREAM_DEPTH
+#define CJSON_STREAM_DEPTH 16
+#endif
+/* Size of the path buffer, i.e. maximum length of a JSON pointer plus one. */
+#ifndef CJSON_STREAM_PATH_SIZE
+#define CJSON_STREAM_PATH_SIZE 128
+#endif
+/* Size of the key buffer, i.e. maximum length of a (unescaped) key plus one. */
+#ifndef CJSON_STREAM_KEY_SIZE
+#define CJSON_STREAM_KEY_SIZE 64
+#endif
+/* Size of the value buffer: strings that don't fit are reported in several pieces. Numbers must fit. */
+#ifndef CJSON_STREAM_STRING_SIZE
+#define CJSON_STREAM_STRING_SIZE 128
+#endif
+
+/* Results of cJSONStream_Feed() and cJSONStream_Finish(). */
+#define CJSON_STREAM_OK 0
+#define CJSON_STREAM_ERROR_SYNTAX (-1) /* invalid or (on finish) incomplete JSON */
+#define CJSON_STREAM_ERROR_LIMIT (-2) /* input exceeds one of the limits above */
+#define CJSON_STREAM_ERROR_ABORTED (-3) /* the callback returned non zero */
+
+/* A value reported by the parser. */
+typedef struct cJSONStream_Event
+{
+    /* cJSON_Object, cJSON_Array, cJSON_String, cJSON_Number, cJSON_True, cJSON_False or cJSON_NULL */
+    int type;
+    /* objects and arrays are reported twice: when they start (end = 0), and when they end (end = 1) */
+    cJSON_bool end;
+    /* a string longer than the value buffer comes in consecutive events, all but the last one being partial.
+     * Pieces are cut at byte boundaries, which may be within a UTF-8 sequence. */
+    cJSON_bool partial;
+    /* JSON pointer of the value: "" for the root, "/networks/0/ssid" for a member of an array element */
+    const char *path;
+    /* name of the value in its object (unescaped), NULL in arrays, at the root and at the end of objects and arrays */
+    const char *key;
+    /* number of objects and arrays the value is in */
+    size_t depth;
+    /* the string ('\0' terminated, but may contain '\0' from "\u0000") */
+    const char *string;
+    size_t length;
+    /* the number */
+    double number;
+} cJSONStream_Event;
+
+/* Called for each value, returns non zero to stop parsing. */
+typedef int (*cJSONStream_Callback)(void *arg, const cJSONStream_Event *event);
+
+/* Parser state, to be treated as opaque but for position. */
+typedef struct cJSONStream
+{
+    cJSONStream_Callback callback;
+    void *arg;
+    /* number of bytes fed and accepted so far: on an error, position of the offending byte */
+    size_t position;
+    int state;
+    int result;
+    cJSON_bool in_key;
+    const char *literal;
+    unsigned char literal_length;
+    unsigned char hex_digits;
+    unsigned long codepoint;
+    unsigned long high_surrogate;
+    size_t depth;
+    unsigned char object[CJSON_STREAM_DEPTH];
+    unsigned long index[CJSON_STREAM_DEPTH];
+    size_t path_length[CJSON_STREAM_DEPTH];
+    size_t key_length;
+    size_t string_length;
+    char path[CJSON_STREAM_PATH_SIZE];
+    char key[CJSON_STREAM_KEY_SIZE];
+    char string[CJSON_STREAM_STRING_SIZE];
+} cJSONStream;
+
+/* Prepare parsing a document. */
+CJSON_PUBLIC(void) cJSONStream_Init(cJSONStream * const stream, cJSONStream_Callback callback, void *arg);
+/* Parse the next length bytes of the document. Returns CJSON_STREAM_OK or an error, which is sticky. */
+CJSON_PUBLIC(int) cJSONStream_Feed(cJSONStream * const stream, const char *data, size_t length);
+/* Tell the input is over. Returns CJSON_STREAM_OK if it was exactly one JSON value (and whitespace). */
+CJSON_PUBLIC(int) cJSONStream_Finish(cJSONStream * const stream);
+
+/* Selective DOM builder: use cJSONStream_Select as the callback, with a cJSONStream_Selection as its argument, to
+ * build cJSON trees of only the given paths. Paths are JSON pointers as in cJSONStream_Event ("" for the whole
+ * document), results[i] receives the tree of paths[i], or stays NULL when the document doesn't have it (or it is
+ * within the tree of another path). The caller owns the results, also on error, and releases them with
+ * cJSON_Delete(). */
+typedef struct cJSONStream_Selection
+{
+    const char * const *paths;
+    cJSON **results;
+    size_t count;
+    /* private: the object or array being built, and its containers up to the selected one */
+    size_t depth;
+    cJSON *stack[CJSON_STREAM_DEPTH];
+    /* string being built from partial events */
+    cJSON *string;
+} cJSONStream_Selection;
+
+CJSON_PUBLIC(void) cJSONStream_InitSelection(cJSONStream_Selection * const selection, const char * const *paths, cJSON **results, size_t count);
+CJSON_PUBLIC(int) cJSONStream_Select(void *selection, const cJSONStream_Event *event);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
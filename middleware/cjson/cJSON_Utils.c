@@ -278,6 +278,48 @@ static cJSON_bool decode_array_index_from_pointer(const unsigned char * const po
     return 1;
 }
 
+/* GetObjectItem with the next token of a pointer as the name, unescaped to go through the key index of the object */
+static cJSON *get_object_item_from_pointer(const cJSON * const object, const char *pointer, const cJSON_bool case_sensitive)
+{
+    char key[64];
+    size_t length = 0;
+    const char *token = pointer;
+    cJSON *current_element = NULL;
+
+    for (; (pointer[0] != '\0') && (pointer[0] != '/') && (length < (sizeof(key) - 1)); (void)pointer++, length++)
+    {
+        if (pointer[0] == '~')
+        {
+            if ((pointer[1] != '0') && (pointer[1] != '1'))
+            {
+                /* invalid escape sequence, matches nothing */
+                return NULL;
+            }
+            key[length] = (pointer[1] == '0') ? '~' : '/';
+            pointer++;
+        }
+        else
+        {
+            key[length] = pointer[0];
+        }
+    }
+
+    if ((pointer[0] == '\0') || (pointer[0] == '/'))
+    {
+        key[length] = '\0';
+        return case_sensitive ? cJSON_GetObjectItemCaseSensitive(object, key) : cJSON_GetObjectItem(object, key);
+    }
+
+    /* key too long for the buffer, compare with the pointer itself */
+    current_element = object->child;
+    while ((current_element != NULL) && !compare_pointers((unsigned char*)current_element->string, (const unsigned char*)token, case_sensitive))
+    {
+        current_element = current_element->next;
+    }
+
+    return current_element;
+}
+
 static cJSON *get_item_from_pointer(cJSON * const object, const char * pointer, const cJSON_bool case_sensitive)
 {
     cJSON *current_element = object;
@@ -303,12 +345,7 @@ static cJSON *get_item_from_pointer(cJSON * const object, const char * pointer,
         }
         else if (cJSON_IsObject(current_element))
         {
-            current_element = current_element->child;
-            /* GetObjectItem. */
-            while ((current_element != NULL) && !compare_pointers((unsigned char*)current_element->string, (const unsigned char*)pointer, case_sensitive))
-            {
-                current_element = current_element->next;
-            }
+            current_element = get_object_item_from_pointer(current_element, pointer, case_sensitive);
         }
         else
         {
@@ -574,6 +611,13 @@ static void sort_object(cJSON * const object, const cJSON_bool case_sensitive)
         return;
     }
     object->child = sort_list(object->child, case_sensitive);
+    cJSON_InvalidateIndex(object);
+#ifdef CJSON_OBJECT_INDEX
+    if (cJSON_GetArraySize(object) >= CJSON_OBJECT_INDEX_MIN)
+    {
+        cJSON_IndexObject(object);
+    }
+#endif
 }
 
 static cJSON_bool compare_json(cJSON *a, cJSON *b, const cJSON_bool case_sensitive)
@@ -775,6 +819,7 @@ static void overwrite_item(cJSON * const root, const cJSON replacement)
     {
         cJSON_Delete(root->child);
     }
+    cJSON_InvalidateIndex(root);
 
     memcpy(root, &replacement, sizeof(cJSON));
 }
@@ -815,7 +860,11 @@ static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_
     {
         if (opcode == REMOVE)
         {
-            static const cJSON invalid = { NULL, NULL, NULL, cJSON_Invalid, NULL, 0, 0, NULL};
+            static const cJSON invalid = { NULL, NULL, NULL, cJSON_Invalid, NULL, 0, 0, NULL
+#ifdef CJSON_OBJECT_INDEX
+                , NULL
+#endif
+            };
 
             overwrite_item(object, invalid);
 
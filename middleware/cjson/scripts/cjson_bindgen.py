@@ -0,0 +1,587 @@
+#!/usr/bin/env python3
+"""
+This file is part of cJSON
+
+Copyright 2026 NXP
+
+Purpose
+
+Generate C bindings of a JSON document from its JSON schema: a structure per
+object, a function parsing a document straight into the structures, and a
+function printing the structures straight into a caller buffer, both on top
+of cJSON_Bind.c. No cJSON items are built and nothing is allocated, and the
+buffer size that is always enough to print a document is a compile time
+constant (<NAME>_PRINT_SIZE).
+
+Supported schemas (other keywords are ignored):
+  object   "properties" (at most 32), "required"; a member that is not
+           required has a cJSON_bool has_<member> flag
+  array    "items" (not an array), "maxItems" (needed), "minItems"
+  string   "maxLength" (needed), or "enum" (strings of at most 31 bytes)
+  integer  int32_t, "minimum", "maximum"
+  number   double
+  boolean  cJSON_bool
+The root must be an object. An object type is named after its "title", or
+after its container and its member. "x-c-name" renames a member.
+
+Parsing skips members that are not in the schema; a wrong type, a missing
+required member, a too long string or too many elements is an error.
+
+Example, from middleware/cjson:
+  python3 scripts/cjson_bindgen.py bench/webconfig_scan.schema.json -o bindings
+writes bindings/webconfig_scan.h and bindings/webconfig_scan.c.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+MAX_MEMBERS = 32
+ENUM_SIZE = 32
+
+
+class SchemaError(Exception):
+    pass
+
+
+def c_identifier(name):
+    """A C identifier made of name."""
+    identifier = re.sub(r'[^0-9A-Za-z_]', '_', name).strip('_').lower()
+    if not identifier:
+        identifier = 'value'
+    if identifier[0].isdigit():
+        identifier = '_' + identifier
+    return identifier
+
+
+def c_string(data):
+    """A C string literal of bytes, and its length."""
+    out = ''
+    for byte in data:
+        char = chr(byte)
+        if char in '"\\':
+            out += '\\' + char
+        elif 32 <= byte < 127 and char != '?':
+            out += char
+        else:
+            out += '\\%03o' % byte
+    return '"%s"' % out, len(data)
+
+
+def json_key(name):
+    """The key as cJSON prints it (see cJSONBind_PutString())."""
+    escapes = {'"': '\\"', '\\': '\\\\', '\b': '\\b', '\f': '\\f',
+               '\n': '\\n', '\r': '\\r', '\t': '\\t'}
+    out = ''
+    for char in name:
+        if char in escapes:
+            out += escapes[char]
+        elif ord(char) < 32:
+            out += '\\u%04x' % ord(char)
+        else:
+            out += char
+    return '"%s"' % out
+
+
+class Member:
+    """A property of an object."""
+
+    def __init__(self, key, schema, required, owner):
+        self.key = key
+        self.name = c_identifier(schema.get('x-c-name', key))
+        self.required = required
+        self.node = Node.create(schema, '%s_%s' % (owner, self.name),
+                                'member "%s" of %s' % (key, owner))
+
+
+class Node:
+    """A value of the schema."""
+
+    @staticmethod
+    def create(schema, type_name, where):
+        if not isinstance(schema, dict):
+            raise SchemaError('%s: not a schema' % where)
+        kind = schema.get('type')
+        if kind == 'object':
+            return ObjectNode(schema, type_name, where)
+        if kind == 'array':
+            return ArrayNode(schema, type_name, where)
+        if kind == 'string' and 'enum' in schema:
+            return EnumNode(schema, type_name, where)
+        if kind in ('string', 'integer', 'number', 'boolean'):
+            return ScalarNode(schema, kind, where)
+        raise SchemaError('%s: unsupported type %r' % (where, kind))
+
+
+class ScalarNode(Node):
+
+    def __init__(self, schema, kind, where):
+        self.kind = kind
+        if kind == 'string':
+            if not isinstance(schema.get('maxLength'), int) or schema['maxLength'] < 0:
+                raise SchemaError('%s: a string needs a maxLength' % where)
+            self.max_length = schema['maxLength']
+        if kind == 'integer':
+            self.minimum = int(schema.get('minimum', -2 ** 31))
+            self.maximum = int(schema.get('maximum', 2 ** 31 - 1))
+            if not -2 ** 31 <= self.minimum <= self.maximum <= 2 ** 31 - 1:
+                raise SchemaError('%s: integers must fit in int32_t' % where)
+
+    def types(self):
+        return []
+
+    def declare(self, name):
+        if self.kind == 'string':
+            return 'char %s[%d];' % (name, self.max_length + 1)
+        return '%s %s;' % ({'integer': 'int32_t', 'number': 'double',
+                            'boolean': 'cJSON_bool'}[self.kind], name)
+
+    def length_max(self):
+        if self.kind == 'string':
+            return 'CJSON_BIND_STRING_LENGTH_MAX(%d)' % self.max_length
+        return {'integer': 'CJSON_BIND_INTEGER_LENGTH_MAX',
+                'number': 'CJSON_BIND_NUMBER_LENGTH_MAX',
+                'boolean': 'CJSON_BIND_BOOL_LENGTH_MAX'}[self.kind]
+
+    def parse(self, target):
+        if self.kind == 'string':
+            return 'cJSONBind_String(parser, %s, sizeof(%s))' % (target, target)
+        if self.kind == 'integer':
+            minimum = 'INT32_MIN' if self.minimum == -2 ** 31 else str(self.minimum)
+            maximum = 'INT32_MAX' if self.maximum == 2 ** 31 - 1 else str(self.maximum)
+            return 'cJSONBind_Integer(parser, &%s, %s, %s)' % (target, minimum, maximum)
+        if self.kind == 'number':
+            return 'cJSONBind_Number(parser, &%s)' % target
+        return 'cJSONBind_Bool(parser, &%s)' % target
+
+    def print(self, source, indent):
+        if self.kind == 'string':
+            call = 'cJSONBind_PutString(writer, %s, sizeof(%s) - 1);' % (source, source)
+        else:
+            call = 'cJSONBind_Put%s(writer, %s);' % ({'integer': 'Integer', 'number': 'Number',
+                                                      'boolean': 'Bool'}[self.kind], source)
+        return [indent + call]
+
+
+class EnumNode(Node):
+
+    def __init__(self, schema, type_name, where):
+        self.type_name = c_identifier(schema.get('title', type_name))
+        self.values = schema['enum']
+        if not self.values or not all(isinstance(value, str) for value in self.values):
+            raise SchemaError('%s: enum needs strings' % where)
+        for value in self.values:
+            if len(value.encode('utf-8')) >= ENUM_SIZE or '\0' in value:
+                raise SchemaError('%s: enum string %r is too long' % (where, value))
+        self.constants = [('%s_%s' % (self.type_name, c_identifier(value))).upper()
+                          for value in self.values]
+        if len(set(self.constants)) != len(self.constants):
+            raise SchemaError('%s: enum strings make the same C names' % where)
+
+    def types(self):
+        return [self]
+
+    def define(self):
+        lines = ['typedef enum %s' % self.type_name, '{']
+        for index, (constant, value) in enumerate(zip(self.constants, self.values)):
+            separator = ',' if index < len(self.values) - 1 else ''
+            lines.append('    %s%s /* %s */' % (constant, separator, json_key(value).replace('*/', '*\\/')))
+        lines.append('} %s;' % self.type_name)
+        return lines
+
+    def names(self):
+        lines = ['static const char *const %s_names[] =' % self.type_name, '{']
+        lines += ['    %s,' % c_string(value.encode('utf-8'))[0] for value in self.values]
+        lines.append('};')
+        return lines
+
+    def declare(self, name):
+        return '%s %s;' % (self.type_name, name)
+
+    def length_max(self):
+        return str(max(len(json_key(value).encode('utf-8')) for value in self.values))
+
+    def parse(self, target):
+        # through an int, the size of an enum depends on the compiler
+        return 'parse_%s(parser, &%s)' % (self.type_name, target)
+
+    def print(self, source, indent):
+        return [indent + 'cJSONBind_PutEnum(writer, %s_names, %d, (int)%s);'
+                % (self.type_name, len(self.values), source)]
+
+
+class ArrayNode(Node):
+
+    def __init__(self, schema, type_name, where):
+        if not isinstance(schema.get('maxItems'), int) or schema['maxItems'] < 1:
+            raise SchemaError('%s: an array needs a maxItems' % where)
+        self.max_items = schema['maxItems']
+        self.min_items = int(schema.get('minItems', 0))
+        items = schema.get('items')
+        if isinstance(items, dict) and items.get('type') == 'array':
+            raise SchemaError('%s: arrays of arrays are not supported' % where)
+        self.items = Node.create(items, type_name + '_item', where + ' items')
+
+    def types(self):
+        return self.items.types()
+
+    def declare(self, name):
+        return 'size_t %s_count;\n    %s' % (name, self.items.declare('%s[%d]' % (name, self.max_items)))
+
+    def length_max(self):
+        return '(2 + (%d * %s) + %d)' % (self.max_items, self.items.length_max(), self.max_items - 1)
+
+    def parse_lines(self, target, indent):
+        count = target + '_count'
+        element = '%s[%s]' % (target, count)
+        lines = ['%s = 0;' % count,
+                 'if (!cJSONBind_ArrayStart(parser))',
+                 '{',
+                 '    return false;',
+                 '}',
+                 'while (cJSONBind_ArrayNext(parser))',
+                 '{',
+                 '    if (%s == %d)' % (count, self.max_items),
+                 '    {',
+                 '        return cJSONBind_SchemaError(parser);',
+                 '    }',
+                 '    if (!%s)' % self.items.parse(element),
+                 '    {',
+                 '        return false;',
+                 '    }',
+                 '    %s++;' % count,
+                 '}',
+                 'if (parser->result != CJSON_BIND_OK)',
+                 '{',
+                 '    return false;',
+                 '}']
+        if self.min_items > 0:
+            lines += ['if (%s < %d)' % (count, self.min_items),
+                      '{',
+                      '    return cJSONBind_SchemaError(parser);',
+                      '}']
+        return [indent + line for line in lines]
+
+    def print(self, source, indent):
+        count = source + '_count'
+        lines = [indent + 'if (cJSONBind_PutArrayStart(writer, %s, %d))' % (count, self.max_items),
+                 indent + '{',
+                 indent + '    for (i = 0; i < %s; i++)' % count,
+                 indent + '    {',
+                 indent + '        if (i != 0)',
+                 indent + '        {',
+                 indent + '            cJSONBind_PutRaw(writer, ",", 1);',
+                 indent + '        }']
+        lines += self.items.print('%s[i]' % source, indent + '        ')
+        lines += [indent + '    }',
+                  indent + '}',
+                  indent + 'cJSONBind_PutRaw(writer, "]", 1);']
+        return lines
+
+
+class ObjectNode(Node):
+
+    def __init__(self, schema, type_name, where):
+        self.type_name = c_identifier(schema.get('title', type_name))
+        properties = schema.get('properties', {})
+        required = schema.get('required', [])
+        if len(properties) > MAX_MEMBERS:
+            raise SchemaError('%s: more than %d properties' % (where, MAX_MEMBERS))
+        for key in required:
+            if key not in properties:
+                raise SchemaError('%s: required "%s" is not a property' % (where, key))
+        self.members = [Member(key, value, key in required, self.type_name)
+                        for key, value in properties.items()]
+        names = [member.name for member in self.members]
+        names += ['has_' + member.name for member in self.members if not member.required]
+        if len(set(names)) != len(names):
+            raise SchemaError('%s: properties make the same C names, use x-c-name' % where)
+
+    def types(self):
+        types = []
+        for member in self.members:
+            for node in member.node.types():
+                if node not in types:
+                    types.append(node)
+        return types + [self]
+
+    def define(self):
+        lines = ['typedef struct %s' % self.type_name, '{']
+        for member in self.members:
+            if not member.required:
+                lines.append('    cJSON_bool has_%s;' % member.name)
+            lines.append('    ' + member.node.declare(member.name))
+        if not self.members:
+            lines.append('    char unused;')
+        lines.append('} %s;' % self.type_name)
+        return lines
+
+    def length_macro(self):
+        return self.type_name.upper() + '_LENGTH_MAX'
+
+    def length_expression(self):
+        """Every member, the keys with their '"', ':' and ','."""
+        if not self.members:
+            return '2'
+        punctuation = 2 + len(self.members) - 1
+        terms = [str(punctuation + sum(len(json_key(member.key).encode('utf-8')) + 1
+                                       for member in self.members))]
+        terms += [member.node.length_max() for member in self.members]
+        return '(%s)' % ' + '.join(terms)
+
+    def declare(self, name):
+        return '%s %s;' % (self.type_name, name)
+
+    def length_max(self):
+        return self.length_macro()
+
+    def parse(self, target):
+        return 'parse_%s(parser, &%s)' % (self.type_name, target)
+
+    def print(self, source, indent):
+        return [indent + 'print_%s(writer, &%s);' % (self.type_name, source)]
+
+    def parse_function(self):
+        lines = ['static cJSON_bool parse_%s(cJSONBind_Parser * const parser, %s * const value)'
+                 % (self.type_name, self.type_name), '{']
+        if not self.members:
+            lines += ['    (void)value;', '',
+                      '    if (!cJSONBind_ObjectStart(parser))',
+                      '    {',
+                      '        return false;',
+                      '    }',
+                      '    while (cJSONBind_ObjectNext(parser, NULL, 0, NULL))',
+                      '    {',
+                      '        if (!cJSONBind_Skip(parser))',
+                      '        {',
+                      '            return false;',
+                      '        }',
+                      '    }',
+                      '',
+                      '    return parser->result == CJSON_BIND_OK;',
+                      '}']
+            return lines
+        key_size = max(len(member.key.encode('utf-8')) for member in self.members) + 1
+        required_mask = 0
+        for index, member in enumerate(self.members):
+            if member.required:
+                required_mask |= 1 << index
+        lines += ['    char key[%d];' % key_size,
+                  '    size_t key_length = 0;']
+        if required_mask:
+            lines.append('    unsigned long found = 0;')
+        lines += ['',
+                  '    if (!cJSONBind_ObjectStart(parser))',
+                  '    {',
+                  '        return false;',
+                  '    }',
+                  '    while (cJSONBind_ObjectNext(parser, key, sizeof(key), &key_length))',
+                  '    {']
+        for index, member in enumerate(self.members):
+            key = member.key.encode('utf-8')
+            literal, length = c_string(key)
+            target = 'value->' + member.name
+            lines += ['        %sif ((key_length == %d) && (memcmp(key, %s, %d) == 0))'
+                      % ('' if index == 0 else 'else ', length, literal, length),
+                      '        {']
+            if member.required:
+                lines.append('            found |= 0x%XUL;' % (1 << index))
+            else:
+                lines.append('            value->has_%s = true;' % member.name)
+            if isinstance(member.node, ArrayNode):
+                lines += member.node.parse_lines(target, '            ')
+            else:
+                lines += ['            if (!%s)' % member.node.parse(target),
+                          '            {',
+                          '                return false;',
+                          '            }']
+            lines.append('        }')
+        lines += ['        else if (!cJSONBind_Skip(parser))',
+                  '        {',
+                  '            return false;',
+                  '        }',
+                  '    }',
+                  '    if (parser->result != CJSON_BIND_OK)',
+                  '    {',
+                  '        return false;',
+                  '    }']
+        if required_mask:
+            lines += ['    if ((found & 0x%XUL) != 0x%XUL)' % (required_mask, required_mask),
+                      '    {',
+                      '        return cJSONBind_SchemaError(parser);',
+                      '    }']
+        lines += ['', '    return true;', '}']
+        return lines
+
+    def print_function(self):
+        lines = ['static void print_%s(cJSONBind_Writer * const writer, const %s * const value)'
+                 % (self.type_name, self.type_name), '{']
+        body = []
+        has_arrays = any(isinstance(member.node, ArrayNode) for member in self.members)
+        # whether a ',' goes before the next member: True, False, or None when
+        # it depends on the optional members printed before (the comma variable)
+        comma = False
+        uses_comma = False
+        pending = '{'
+        for index, member in enumerate(self.members):
+            key = json_key(member.key) + ':'
+            last = index == len(self.members) - 1
+            indent = '    '
+            if not member.required:
+                if pending:
+                    body.append(self.put_raw(pending, indent))
+                    pending = ''
+                body += ['    if (value->has_%s)' % member.name, '    {']
+                indent = '        '
+            if comma is None:
+                uses_comma = True
+                body.append(indent + 'cJSONBind_PutRaw(writer, ",", comma);')
+                text = pending + key
+            else:
+                text = pending + (',' if comma else '') + key
+            if not member.required and comma is not True and not last:
+                body.append(indent + 'comma = 1;')
+            body.append(self.put_raw(text, indent))
+            pending = ''
+            body += member.node.print('value->' + member.name, indent)
+            if member.required:
+                comma = True
+            else:
+                body.append('    }')
+                comma = True if comma is True else None
+        body.append(self.put_raw(pending + '}', '    '))
+        if has_arrays:
+            lines.append('    size_t i = 0;')
+        if uses_comma:
+            lines.append('    size_t comma = 0;')
+        if has_arrays or uses_comma:
+            lines.append('')
+        if not self.members:
+            lines += ['    (void)value;', '']
+        return lines + body + ['}']
+
+    @staticmethod
+    def put_raw(text, indent):
+        literal, length = c_string(text.encode('utf-8'))
+        return '%scJSONBind_PutRaw(writer, %s, %d);' % (indent, literal, length)
+
+
+def generate(schema, name, source):
+    """Return the header and the source of the bindings."""
+    if schema.get('type') != 'object':
+        raise SchemaError('the root must be an object')
+    root = ObjectNode(schema, name, 'root')
+    name = root.type_name
+    guard = name.upper() + '_H'
+    banner = '/* Generated by cjson_bindgen.py from %s, do not edit. */' % os.path.basename(source)
+    types = root.types()
+    objects = [node for node in types if isinstance(node, ObjectNode)]
+    enums = [node for node in types if isinstance(node, EnumNode)]
+
+    header = [banner, '',
+              '#ifndef %s' % guard,
+              '#define %s' % guard, '',
+              '#ifdef __cplusplus',
+              'extern "C"',
+              '{',
+              '#endif', '',
+              '#include <stddef.h>', '',
+              '#include "cJSON_Bind.h"', '']
+    for node in types:
+        header += node.define() + ['']
+    header.append('/* Longest printed text of each object, without the \'\\0\'. */')
+    for node in objects:
+        header.append('#define %s %s' % (node.length_macro(), node.length_expression()))
+    header += ['/* Print buffer size that is always enough. */',
+               '#define %s_PRINT_SIZE (%s + 1)' % (name.upper(), root.length_macro()), '',
+               '/* Parse the JSON text (of length bytes) into *value, which is cleared first. Returns CJSON_BIND_OK,',
+               ' * CJSON_BIND_ERROR_SYNTAX or CJSON_BIND_ERROR_SCHEMA. */',
+               'int %s_parse(%s *value, const char *json, size_t length);' % (name, name),
+               '/* Print *value as unformatted JSON into buffer (of size bytes, %s_PRINT_SIZE is always enough).'
+               % name.upper(),
+               ' * Returns the length of the \'\\0\' terminated text, CJSON_BIND_ERROR_BUFFER, or CJSON_BIND_ERROR_SCHEMA',
+               ' * when an array count or an enum is out of range. */',
+               'int %s_print(const %s *value, char *buffer, size_t size);' % (name, name), '',
+               '#ifdef __cplusplus',
+               '}',
+               '#endif', '',
+               '#endif']
+
+    code = [banner, '',
+            '#include <string.h>', '',
+            '#include "%s.h"' % name, '',
+            '#ifdef true',
+            '#undef true',
+            '#endif',
+            '#define true ((cJSON_bool)1)', '',
+            '#ifdef false',
+            '#undef false',
+            '#endif',
+            '#define false ((cJSON_bool)0)', '']
+    for node in enums:
+        code += node.names() + ['']
+        code += ['static cJSON_bool parse_%s(cJSONBind_Parser * const parser, %s * const value)'
+                 % (node.type_name, node.type_name),
+                 '{',
+                 '    int index = 0;', '',
+                 '    if (!cJSONBind_Enum(parser, %s_names, %d, &index))' % (node.type_name, len(node.values)),
+                 '    {',
+                 '        return false;',
+                 '    }',
+                 '    *value = (%s)index;' % node.type_name, '',
+                 '    return true;',
+                 '}', '']
+    for node in objects:
+        code += node.parse_function() + ['']
+        code += node.print_function() + ['']
+    code += ['int %s_parse(%s *value, const char *json, size_t length)' % (name, name),
+             '{',
+             '    cJSONBind_Parser parser;', '',
+             '    memset(value, 0, sizeof(*value));',
+             '    cJSONBind_InitParser(&parser, json, length);',
+             '    parse_%s(&parser, value);' % name, '',
+             '    return cJSONBind_EndParser(&parser);',
+             '}', '',
+             'int %s_print(const %s *value, char *buffer, size_t size)' % (name, name),
+             '{',
+             '    cJSONBind_Writer writer;', '',
+             '    cJSONBind_InitWriter(&writer, buffer, size);',
+             '    print_%s(&writer, value);' % name, '',
+             '    return cJSONBind_EndWriter(&writer);',
+             '}']
+    return name, '\n'.join(header) + '\n', '\n'.join(code) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('Purpose')[1],
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('schema', help='JSON schema file')
+    parser.add_argument('-n', '--name', default=None,
+                        help='C name of the root (default: its title, or the file name)')
+    parser.add_argument('-o', '--output', default='.',
+                        help='directory of the generated .h and .c (default: .)')
+    args = parser.parse_args()
+
+    with open(args.schema, encoding='utf-8') as f:
+        schema = json.load(f)
+    name = args.name
+    if name is None:
+        name = schema.get('title', os.path.basename(args.schema).split('.')[0])
+    if args.name is not None:
+        schema = dict(schema, title=args.name)
+
+    try:
+        name, header, code = generate(schema, name, args.schema)
+    except SchemaError as error:
+        sys.exit('%s: %s' % (args.schema, error))
+
+    os.makedirs(args.output, exist_ok=True)
+    for extension, text in (('.h', header), ('.c', code)):
+        with open(os.path.join(args.output, name + extension), 'w', encoding='utf-8') as f:
+            f.write(text)
+
+
+if __name__ == '__main__':
+    main()
@@ -65,6 +65,7 @@
 #define TCP_LISTEN_BACKLOG         1
 
 #define LWIP_COMPAT_SOCKETS        1
+#define LWIP_SOCKET_MMSG           1
 #define LWIP_SO_RCVTIMEO           1
 #define LWIP_SO_RCVBUF             1
 
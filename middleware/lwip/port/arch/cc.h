@@ -106,4 +106,28 @@ typedef u32_t          mem_ptr_t;
 // fatal, print message and abandon execution.
 #define LWIP_PLATFORM_ASSERT(x)                   sys_assert( x )
 
+// Optimized Internet checksum and copy-with-checksum (chksum.c).
+// Can be disabled in lwipopts.h to fall back to lwIP's generic algorithm.
+#ifndef LWIP_CHKSUM_ARCH
+#define LWIP_CHKSUM_ARCH 1
+#endif
+
+#if LWIP_CHKSUM_ARCH
+#include <stdint.h>
+
+#define LWIP_CHKSUM                               lwip_chksum_arch
+#define LWIP_CHKSUM_COPY(dst, src, len)           lwip_chksum_copy_arch(dst, src, len)
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+uint16_t lwip_chksum_arch(const void *dataptr, int len);
+uint16_t lwip_chksum_copy_arch(void *dst, const void *src, uint16_t len);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+#endif /* LWIP_CHKSUM_ARCH */
+
 #endif /* __CC_H__ */
@@ -0,0 +1,264 @@
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Optimized Internet checksum (RFC 1071) for Cortex-M4.
+ *
+ * The generic lwIP implementation (LWIP_CHKSUM_ALGORITHM 2) adds one 16-bit
+ * halfword per loop iteration. This one aligns the buffer to a word boundary,
+ * then sums 32-byte blocks as 32-bit words with end-around carry, so the inner
+ * loop costs roughly one instruction per word. On Thumb-2 targets built with
+ * GCC compatible compilers the block loop is written in assembly using an
+ * ADDS/ADCS chain; everywhere else (including host builds used by the unit
+ * tests) a portable C version with a 64-bit accumulator is used.
+ *
+ * It is enabled from arch/cc.h by LWIP_CHKSUM_ARCH, which routes both
+ * LWIP_CHKSUM and LWIP_CHKSUM_COPY here.
+ */
+
+#include "lwip/opt.h"
+#include "lwip/def.h"
+#include "lwip/inet_chksum.h"
+
+#include <string.h>
+
+#ifndef LWIP_CHKSUM_ARCH
+#define LWIP_CHKSUM_ARCH 0
+#endif
+
+#if LWIP_CHKSUM_ARCH
+
+/* Number of bytes summed by one iteration of the block loop (8 words). */
+#define CHKSUM_BLOCK_SIZE 32U
+
+#if defined(__GNUC__) && defined(__thumb2__)
+
+/* Sum nblocks (> 0) 32-byte blocks from word aligned pw into sum. */
+static u32_t
+chksum_blocks(const u32_t *pw, u32_t nblocks, u32_t sum)
+{
+  u32_t w0, w1, w2, w3;
+
+  __asm__ volatile(
+    "1:                                   \n\t"
+    "ldrd   %[w0], %[w1], [%[pw]], #8      \n\t"
+    "ldrd   %[w2], %[w3], [%[pw]], #8      \n\t"
+    "adds   %[sum], %[sum], %[w0]          \n\t"
+    "adcs   %[sum], %[sum], %[w1]          \n\t"
+    "adcs   %[sum], %[sum], %[w2]          \n\t"
+    "adcs   %[sum], %[sum], %[w3]          \n\t"
+    "ldrd   %[w0], %[w1], [%[pw]], #8      \n\t"
+    "ldrd   %[w2], %[w3], [%[pw]], #8      \n\t"
+    "adcs   %[sum], %[sum], %[w0]          \n\t"
+    "adcs   %[sum], %[sum], %[w1]          \n\t"
+    "adcs   %[sum], %[sum], %[w2]          \n\t"
+    "adcs   %[sum], %[sum], %[w3]          \n\t"
+    "adc    %[sum], %[sum], #0             \n\t"
+    "subs   %[n], %[n], #1                 \n\t"
+    "bne    1b                             \n\t"
+    : [sum] "+r"(sum), [pw] "+r"(pw), [n] "+r"(nblocks),
+      [w0] "=&r"(w0), [w1] "=&r"(w1), [w2] "=&r"(w2), [w3] "=&r"(w3)
+    :
+    : "cc", "memory");
+
+  return sum;
+}
+
+#else /* __GNUC__ && __thumb2__ */
+
+/* Sum nblocks (> 0) 32-byte blocks from word aligned pw into sum. */
+static u32_t
+chksum_blocks(const u32_t *pw, u32_t nblocks, u32_t sum)
+{
+  /* A 64-bit accumulator defers the end-around carry: 2^32 words of 2^32 - 1
+     cannot overflow it, and a checksummed buffer is at most 64k. */
+  u64_t acc = sum;
+
+  do {
+    acc += pw[0];
+    acc += pw[1];
+    acc += pw[2];
+    acc += pw[3];
+    acc += pw[4];
+    acc += pw[5];
+    acc += pw[6];
+    acc += pw[7];
+    pw += 8;
+  } while (--nblocks);
+
+  acc = (acc >> 32) + (acc & 0xffffffffUL);
+  acc = (acc >> 32) + (acc & 0xffffffffUL);
+  return (u32_t)acc;
+}
+
+#endif /* __GNUC__ && __thumb2__ */
+
+/**
+ * Optimized lwip checksum, drop-in replacement for lwip_standard_chksum().
+ *
+ * @param dataptr points to start of data to be summed at any boundary
+ * @param len length of data to be summed
+ * @return host order (!) lwip checksum (non-inverted Internet sum)
+ */
+u16_t
+lwip_chksum_arch(const void *dataptr, int len)
+{
+  const u8_t *pb = (const u8_t *)dataptr;
+  u16_t t = 0;
+  u32_t sum = 0;
+  u32_t w;
+  /* starts at odd byte address? */
+  int odd = ((mem_ptr_t)pb & 1);
+
+  if (odd && len > 0) {
+    ((u8_t *)&t)[1] = *pb++;
+    len--;
+  }
+
+  /* get aligned to u32_t */
+  if (((mem_ptr_t)pb & 2) && len > 1) {
+    sum += *(const u16_t *)(const void *)pb;
+    pb += 2;
+    len -= 2;
+  }
+
+  if (len >= (int)CHKSUM_BLOCK_SIZE) {
+    sum = chksum_blocks((const u32_t *)(const void *)pb, (u32_t)len / CHKSUM_BLOCK_SIZE, sum);
+    pb += (u32_t)len & ~(CHKSUM_BLOCK_SIZE - 1U);
+    len &= (int)(CHKSUM_BLOCK_SIZE - 1U);
+  }
+
+  /* up to 7 whole words remaining */
+  while (len > 3) {
+    w = *(const u32_t *)(const void *)pb;
+    sum += w;
+    if (sum < w) {
+      sum++;                    /* add back carry */
+    }
+    pb += 4;
+    len -= 4;
+  }
+
+  /* make room in upper bits */
+  sum = FOLD_U32T(sum);
+
+  /* 16-bit aligned word remaining? */
+  if (len > 1) {
+    sum += *(const u16_t *)(const void *)pb;
+    pb += 2;
+    len -= 2;
+  }
+
+  /* dangling tail byte remaining? */
+  if (len > 0) {
+    ((u8_t *)&t)[0] = *pb;
+  }
+
+  sum += t;
+
+  /* Fold 32-bit sum to 16 bits */
+  sum = FOLD_U32T(sum);
+  sum = FOLD_U32T(sum);
+
+  if (odd) {
+    sum = SWAP_BYTES_IN_WORD(sum);
+  }
+
+  return (u16_t)sum;
+}
+
+/**
+ * Copy len bytes from src to dst and return their lwip checksum, as
+ * LWIP_CHKSUM_COPY expects (used by pbuf_fill_chksum(), tcp_write() and
+ * lwip_sendto() when LWIP_CHECKSUM_ON_COPY is enabled).
+ *
+ * When both buffers share the same word alignment the data is moved and
+ * summed in a single pass, otherwise it falls back to MEMCPY followed by
+ * lwip_chksum_arch() on the (now cache hot) destination.
+ */
+u16_t
+lwip_chksum_copy_arch(void *dst, const void *src, u16_t len)
+{
+  const u8_t *ps = (const u8_t *)src;
+  u8_t *pd = (u8_t *)dst;
+  const u32_t *psw;
+  u32_t *pdw;
+  u64_t acc = 0;
+  u32_t head, nwords, w;
+  u16_t head_sum = 0;
+  u16_t sum;
+
+  if ((((mem_ptr_t)ps ^ (mem_ptr_t)pd) & 3) != 0) {
+    MEMCPY(dst, src, len);
+    return lwip_chksum_arch(dst, len);
+  }
+
+  /* bytes needed to reach word alignment */
+  head = (u32_t)(-(mem_ptr_t)ps) & 3U;
+  if (head > len) {
+    head = len;
+  }
+  if (head > 0) {
+    MEMCPY(pd, ps, head);
+    head_sum = lwip_chksum_arch(pd, (int)head);
+    ps += head;
+    pd += head;
+    len = (u16_t)(len - head);
+  }
+
+  psw = (const u32_t *)(const void *)ps;
+  pdw = (u32_t *)(void *)pd;
+  for (nwords = (u32_t)len >> 2; nwords >= 4; nwords -= 4) {
+    w = psw[0];
+    pdw[0] = w;
+    acc += w;
+    w = psw[1];
+    pdw[1] = w;
+    acc += w;
+    w = psw[2];
+    pdw[2] = w;
+    acc += w;
+    w = psw[3];
+    pdw[3] = w;
+    acc += w;
+    psw += 4;
+    pdw += 4;
+  }
+  while (nwords--) {
+    w = *psw++;
+    *pdw++ = w;
+    acc += w;
+  }
+
+  ps = (const u8_t *)psw;
+  pd = (u8_t *)pdw;
+  len &= 3;
+  if (len > 0) {
+    /* the tail starts at an even offset from the word aligned body */
+    MEMCPY(pd, ps, len);
+    acc += lwip_chksum_arch(pd, len);
+  }
+
+  acc = (acc >> 32) + (acc & 0xffffffffUL);
+  acc = (acc >> 32) + (acc & 0xffffffffUL);
+  acc = FOLD_U32T(acc);
+  acc = FOLD_U32T(acc);
+  sum = (u16_t)acc;
+
+  if (head > 0) {
+    /* the body started at byte offset 'head' relative to dst */
+    if (head & 1) {
+      sum = (u16_t)SWAP_BYTES_IN_WORD(sum);
+    }
+    acc = (u32_t)sum + head_sum;
+    sum = (u16_t)FOLD_U32T(acc);
+  }
+
+  return sum;
+}
+
+#endif /* LWIP_CHKSUM_ARCH */
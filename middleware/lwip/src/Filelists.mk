@@ -174,7 +174,8 @@ LWIPERFFILES=$(LWIPDIR)/apps/lwiperf/lwiperf.c
 SMTPFILES=$(LWIPDIR)/apps/smtp/smtp.c
 
 # SNTPFILES: SNTP client
-SNTPFILES=$(LWIPDIR)/apps/sntp/sntp.c
+SNTPFILES=$(LWIPDIR)/apps/sntp/sntp.c \
+	$(LWIPDIR)/apps/sntp/sntp_clock.c
 
 # MDNSFILES: MDNS responder
 MDNSFILES=$(LWIPDIR)/apps/mdns/mdns.c \
@@ -1527,45 +1527,45 @@ lwip_netconn_do_listen(void *m)
 #endif /* LWIP_TCP */
 
 /**
- * Send some data on a RAW or UDP pcb contained in a netconn
- * Called from netconn_send
+ * Send one netbuf on the RAW or UDP pcb of a netconn.
+ * Called from lwip_netconn_do_send and lwip_netconn_do_send_multi
  *
- * @param m the api_msg pointing to the connection
+ * @param conn the RAW or UDP netconn
+ * @param buf the netbuf to send
+ * @return ERR_OK if sent, any other err_t on error
  */
-void
-lwip_netconn_do_send(void *m)
+static err_t
+lwip_netconn_send_netbuf(struct netconn *conn, struct netbuf *buf)
 {
-  struct api_msg *msg = (struct api_msg *)m;
-
-  err_t err = netconn_err(msg->conn);
+  err_t err = netconn_err(conn);
   if (err == ERR_OK) {
-    if (msg->conn->pcb.tcp != NULL) {
-      switch (NETCONNTYPE_GROUP(msg->conn->type)) {
+    if (conn->pcb.tcp != NULL) {
+      switch (NETCONNTYPE_GROUP(conn->type)) {
 #if LWIP_RAW
         case NETCONN_RAW:
-          if (ip_addr_isany(&msg->msg.b->addr) || IP_IS_ANY_TYPE_VAL(msg->msg.b->addr)) {
-            err = raw_send(msg->conn->pcb.raw, msg->msg.b->p);
+          if (ip_addr_isany(&buf->addr) || IP_IS_ANY_TYPE_VAL(buf->addr)) {
+            err = raw_send(conn->pcb.raw, buf->p);
           } else {
-            err = raw_sendto(msg->conn->pcb.raw, msg->msg.b->p, &msg->msg.b->addr);
+            err = raw_sendto(conn->pcb.raw, buf->p, &buf->addr);
           }
           break;
 #endif
 #if LWIP_UDP
         case NETCONN_UDP:
 #if LWIP_CHECKSUM_ON_COPY
-          if (ip_addr_isany(&msg->msg.b->addr) || IP_IS_ANY_TYPE_VAL(msg->msg.b->addr)) {
-            err = udp_send_chksum(msg->conn->pcb.udp, msg->msg.b->p,
-                                  msg->msg.b->flags & NETBUF_FLAG_CHKSUM, msg->msg.b->toport_chksum);
+          if (ip_addr_isany(&buf->addr) || IP_IS_ANY_TYPE_VAL(buf->addr)) {
+            err = udp_send_chksum(conn->pcb.udp, buf->p,
+                                  buf->flags & NETBUF_FLAG_CHKSUM, buf->toport_chksum);
           } else {
-            err = udp_sendto_chksum(msg->conn->pcb.udp, msg->msg.b->p,
-                                    &msg->msg.b->addr, msg->msg.b->port,
-                                    msg->msg.b->flags & NETBUF_FLAG_CHKSUM, msg->msg.b->toport_chksum);
+            err = udp_sendto_chksum(conn->pcb.udp, buf->p,
+                                    &buf->addr, buf->port,
+                                    buf->flags & NETBUF_FLAG_CHKSUM, buf->toport_chksum);
           }
 #else /* LWIP_CHECKSUM_ON_COPY */
-          if (ip_addr_isany_val(msg->msg.b->addr) || IP_IS_ANY_TYPE_VAL(msg->msg.b->addr)) {
-            err = udp_send(msg->conn->pcb.udp, msg->msg.b->p);
+          if (ip_addr_isany_val(buf->addr) || IP_IS_ANY_TYPE_VAL(buf->addr)) {
+            err = udp_send(conn->pcb.udp, buf->p);
           } else {
-            err = udp_sendto(msg->conn->pcb.udp, msg->msg.b->p, &msg->msg.b->addr, msg->msg.b->port);
+            err = udp_sendto(conn->pcb.udp, buf->p, &buf->addr, buf->port);
           }
 #endif /* LWIP_CHECKSUM_ON_COPY */
           break;
@@ -1578,6 +1578,45 @@ lwip_netconn_do_send(void *m)
       err = ERR_CONN;
     }
   }
+  return err;
+}
+
+/**
+ * Send some data on a RAW or UDP pcb contained in a netconn
+ * Called from netconn_send
+ *
+ * @param m the api_msg pointing to the connection
+ */
+void
+lwip_netconn_do_send(void *m)
+{
+  struct api_msg *msg = (struct api_msg *)m;
+
+  msg->err = lwip_netconn_send_netbuf(msg->conn, msg->msg.b);
+  TCPIP_APIMSG_ACK(msg);
+}
+
+/**
+ * Send an array of netbufs on a RAW or UDP pcb contained in a netconn,
+ * stopping at the first error.
+ * Called from netconn_send_multi
+ *
+ * @param m the api_msg pointing to the connection
+ */
+void
+lwip_netconn_do_send_multi(void *m)
+{
+  struct api_msg *msg = (struct api_msg *)m;
+  err_t err = ERR_OK;
+  u16_t i;
+
+  for (i = 0; i < msg->msg.bm.count; i++) {
+    err = lwip_netconn_send_netbuf(msg->conn, &msg->msg.bm.bufs[i]);
+    if (err != ERR_OK) {
+      break;
+    }
+  }
+  msg->msg.bm.sent = i;
   msg->err = err;
   TCPIP_APIMSG_ACK(msg);
 }
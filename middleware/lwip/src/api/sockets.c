@@ -1315,6 +1315,26 @@ lwip_recv(int s, void *mem, size_t len, int flags)
   return lwip_recvfrom(s, mem, len, flags, NULL, NULL);
 }
 
+/* Helper function to validate the IO vectors of a msghdr for receiving.
+ * Returns the total buffer length or -1 if a vector is invalid.
+ */
+static ssize_t
+lwip_recvmsg_iov_len(const struct msghdr *message)
+{
+  msg_iovlen_t i;
+  ssize_t buflen = 0;
+
+  for (i = 0; i < message->msg_iovlen; i++) {
+    if ((message->msg_iov[i].iov_base == NULL) || ((ssize_t)message->msg_iov[i].iov_len <= 0) ||
+        ((size_t)(ssize_t)message->msg_iov[i].iov_len != message->msg_iov[i].iov_len) ||
+        ((ssize_t)(buflen + (ssize_t)message->msg_iov[i].iov_len) <= 0)) {
+      return -1;
+    }
+    buflen = (ssize_t)(buflen + (ssize_t)message->msg_iov[i].iov_len);
+  }
+  return buflen;
+}
+
 ssize_t
 lwip_recvmsg(int s, struct msghdr *message, int flags)
 {
@@ -1338,16 +1358,11 @@ lwip_recvmsg(int s, struct msghdr *message, int flags)
   }
 
   /* check for valid vectors */
-  buflen = 0;
-  for (i = 0; i < message->msg_iovlen; i++) {
-    if ((message->msg_iov[i].iov_base == NULL) || ((ssize_t)message->msg_iov[i].iov_len <= 0) ||
-        ((size_t)(ssize_t)message->msg_iov[i].iov_len != message->msg_iov[i].iov_len) ||
-        ((ssize_t)(buflen + (ssize_t)message->msg_iov[i].iov_len) <= 0)) {
-      set_errno(err_to_errno(ERR_VAL));
-      done_socket(sock);
-      return -1;
-    }
-    buflen = (ssize_t)(buflen + (ssize_t)message->msg_iov[i].iov_len);
+  buflen = lwip_recvmsg_iov_len(message);
+  if (buflen < 0) {
+    set_errno(err_to_errno(ERR_VAL));
+    done_socket(sock);
+    return -1;
   }
 
   if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) == NETCONN_TCP) {
@@ -1456,6 +1471,118 @@ lwip_send(int s, const void *data, size_t size, int flags)
   return (err == ERR_OK ? (ssize_t)written : -1);
 }
 
+#if LWIP_UDP || LWIP_RAW
+/* Helper function to build the netbuf for sending a msghdr on a udp or raw
+ * netconn: destination from msg_name, data from the IO vectors.
+ * On error, chain_buf is freed and an errno value is returned.
+ */
+static int
+lwip_sendmsg_udp_raw_netbuf(const struct msghdr *msg, struct netbuf *chain_buf, ssize_t *datagram_size)
+{
+  msg_iovlen_t i;
+  ssize_t size = 0;
+  err_t err = ERR_OK;
+
+  /* initialize chain buffer with destination */
+  memset(chain_buf, 0, sizeof(struct netbuf));
+
+  LWIP_ERROR("lwip_sendmsg: invalid msghdr name", (((msg->msg_name == NULL) && (msg->msg_namelen == 0)) ||
+             IS_SOCK_ADDR_LEN_VALID(msg->msg_namelen)),
+             return err_to_errno(ERR_ARG););
+
+  if (msg->msg_name) {
+    u16_t remote_port;
+    SOCKADDR_TO_IPADDR_PORT((const struct sockaddr *)msg->msg_name, &chain_buf->addr, remote_port);
+    netbuf_fromport(chain_buf) = remote_port;
+  }
+#if LWIP_NETIF_TX_SINGLE_PBUF
+  for (i = 0; i < msg->msg_iovlen; i++) {
+    size += msg->msg_iov[i].iov_len;
+    if ((msg->msg_iov[i].iov_len > INT_MAX) || (size < (int)msg->msg_iov[i].iov_len)) {
+      /* overflow */
+      goto sendmsg_emsgsize;
+    }
+  }
+  if (size > 0xFFFF) {
+    /* overflow */
+    goto sendmsg_emsgsize;
+  }
+  /* Allocate a new netbuf and copy the data into it. */
+  if (netbuf_alloc(chain_buf, (u16_t)size) == NULL) {
+    err = ERR_MEM;
+  } else {
+    /* flatten the IO vectors */
+    size_t offset = 0;
+    for (i = 0; i < msg->msg_iovlen; i++) {
+      MEMCPY(&((u8_t *)chain_buf->p->payload)[offset], msg->msg_iov[i].iov_base, msg->msg_iov[i].iov_len);
+      offset += msg->msg_iov[i].iov_len;
+    }
+#if LWIP_CHECKSUM_ON_COPY
+    {
+      /* This can be improved by using LWIP_CHKSUM_COPY() and aggregating the checksum for each IO vector */
+      u16_t chksum = ~inet_chksum_pbuf(chain_buf->p);
+      netbuf_set_chksum(chain_buf, chksum);
+    }
+#endif /* LWIP_CHECKSUM_ON_COPY */
+    err = ERR_OK;
+  }
+#else /* LWIP_NETIF_TX_SINGLE_PBUF */
+  /* create a chained netbuf from the IO vectors. NOTE: we assemble a pbuf chain
+     manually to avoid having to allocate, chain, and delete a netbuf for each iov */
+  for (i = 0; i < msg->msg_iovlen; i++) {
+    struct pbuf *p;
+    if (msg->msg_iov[i].iov_len > 0xFFFF) {
+      /* overflow */
+      goto sendmsg_emsgsize;
+    }
+    p = pbuf_alloc(PBUF_TRANSPORT, 0, PBUF_REF);
+    if (p == NULL) {
+      err = ERR_MEM; /* let netbuf_delete() cleanup chain_buf */
+      break;
+    }
+    p->payload = msg->msg_iov[i].iov_base;
+    p->len = p->tot_len = (u16_t)msg->msg_iov[i].iov_len;
+    /* netbuf empty, add new pbuf */
+    if (chain_buf->p == NULL) {
+      chain_buf->p = chain_buf->ptr = p;
+      /* add pbuf to existing pbuf chain */
+    } else {
+      if (chain_buf->p->tot_len + p->len > 0xffff) {
+        /* overflow */
+        pbuf_free(p);
+        goto sendmsg_emsgsize;
+      }
+      pbuf_cat(chain_buf->p, p);
+    }
+  }
+  /* save size of total chain */
+  if (err == ERR_OK) {
+    size = netbuf_len(chain_buf);
+  }
+#endif /* LWIP_NETIF_TX_SINGLE_PBUF */
+
+  if (err != ERR_OK) {
+    netbuf_free(chain_buf);
+    return err_to_errno(err);
+  }
+
+#if LWIP_IPV4 && LWIP_IPV6
+  /* Dual-stack: Unmap IPv4 mapped IPv6 addresses */
+  if (IP_IS_V6_VAL(chain_buf->addr) && ip6_addr_isipv4mappedipv6(ip_2_ip6(&chain_buf->addr))) {
+    unmap_ipv4_mapped_ipv6(ip_2_ip4(&chain_buf->addr), ip_2_ip6(&chain_buf->addr));
+    IP_SET_TYPE_VAL(chain_buf->addr, IPADDR_TYPE_V4);
+  }
+#endif /* LWIP_IPV4 && LWIP_IPV6 */
+
+  *datagram_size = size;
+  return 0;
+
+sendmsg_emsgsize:
+  netbuf_free(chain_buf);
+  return EMSGSIZE;
+}
+#endif /* LWIP_UDP || LWIP_RAW */
+
 ssize_t
 lwip_sendmsg(int s, const struct msghdr *msg, int flags)
 {
@@ -1506,99 +1633,19 @@ lwip_sendmsg(int s, const struct msghdr *msg, int flags)
 #if LWIP_UDP || LWIP_RAW
   {
     struct netbuf chain_buf;
-    msg_iovlen_t i;
     ssize_t size = 0;
+    int sock_errno;
 
     LWIP_UNUSED_ARG(flags);
-    LWIP_ERROR("lwip_sendmsg: invalid msghdr name", (((msg->msg_name == NULL) && (msg->msg_namelen == 0)) ||
-               IS_SOCK_ADDR_LEN_VALID(msg->msg_namelen)),
-               set_errno(err_to_errno(ERR_ARG)); done_socket(sock); return -1;);
-
-    /* initialize chain buffer with destination */
-    memset(&chain_buf, 0, sizeof(struct netbuf));
-    if (msg->msg_name) {
-      u16_t remote_port;
-      SOCKADDR_TO_IPADDR_PORT((const struct sockaddr *)msg->msg_name, &chain_buf.addr, remote_port);
-      netbuf_fromport(&chain_buf) = remote_port;
-    }
-#if LWIP_NETIF_TX_SINGLE_PBUF
-    for (i = 0; i < msg->msg_iovlen; i++) {
-      size += msg->msg_iov[i].iov_len;
-      if ((msg->msg_iov[i].iov_len > INT_MAX) || (size < (int)msg->msg_iov[i].iov_len)) {
-        /* overflow */
-        goto sendmsg_emsgsize;
-      }
-    }
-    if (size > 0xFFFF) {
-      /* overflow */
-      goto sendmsg_emsgsize;
-    }
-    /* Allocate a new netbuf and copy the data into it. */
-    if (netbuf_alloc(&chain_buf, (u16_t)size) == NULL) {
-      err = ERR_MEM;
-    } else {
-      /* flatten the IO vectors */
-      size_t offset = 0;
-      for (i = 0; i < msg->msg_iovlen; i++) {
-        MEMCPY(&((u8_t *)chain_buf.p->payload)[offset], msg->msg_iov[i].iov_base, msg->msg_iov[i].iov_len);
-        offset += msg->msg_iov[i].iov_len;
-      }
-#if LWIP_CHECKSUM_ON_COPY
-      {
-        /* This can be improved by using LWIP_CHKSUM_COPY() and aggregating the checksum for each IO vector */
-        u16_t chksum = ~inet_chksum_pbuf(chain_buf.p);
-        netbuf_set_chksum(&chain_buf, chksum);
-      }
-#endif /* LWIP_CHECKSUM_ON_COPY */
-      err = ERR_OK;
-    }
-#else /* LWIP_NETIF_TX_SINGLE_PBUF */
-    /* create a chained netbuf from the IO vectors. NOTE: we assemble a pbuf chain
-       manually to avoid having to allocate, chain, and delete a netbuf for each iov */
-    for (i = 0; i < msg->msg_iovlen; i++) {
-      struct pbuf *p;
-      if (msg->msg_iov[i].iov_len > 0xFFFF) {
-        /* overflow */
-        goto sendmsg_emsgsize;
-      }
-      p = pbuf_alloc(PBUF_TRANSPORT, 0, PBUF_REF);
-      if (p == NULL) {
-        err = ERR_MEM; /* let netbuf_delete() cleanup chain_buf */
-        break;
-      }
-      p->payload = msg->msg_iov[i].iov_base;
-      p->len = p->tot_len = (u16_t)msg->msg_iov[i].iov_len;
-      /* netbuf empty, add new pbuf */
-      if (chain_buf.p == NULL) {
-        chain_buf.p = chain_buf.ptr = p;
-        /* add pbuf to existing pbuf chain */
-      } else {
-        if (chain_buf.p->tot_len + p->len > 0xffff) {
-          /* overflow */
-          pbuf_free(p);
-          goto sendmsg_emsgsize;
-        }
-        pbuf_cat(chain_buf.p, p);
-      }
-    }
-    /* save size of total chain */
-    if (err == ERR_OK) {
-      size = netbuf_len(&chain_buf);
+    sock_errno = lwip_sendmsg_udp_raw_netbuf(msg, &chain_buf, &size);
+    if (sock_errno != 0) {
+      set_errno(sock_errno);
+      done_socket(sock);
+      return -1;
     }
-#endif /* LWIP_NETIF_TX_SINGLE_PBUF */
 
-    if (err == ERR_OK) {
-#if LWIP_IPV4 && LWIP_IPV6
-      /* Dual-stack: Unmap IPv4 mapped IPv6 addresses */
-      if (IP_IS_V6_VAL(chain_buf.addr) && ip6_addr_isipv4mappedipv6(ip_2_ip6(&chain_buf.addr))) {
-        unmap_ipv4_mapped_ipv6(ip_2_ip4(&chain_buf.addr), ip_2_ip6(&chain_buf.addr));
-        IP_SET_TYPE_VAL(chain_buf.addr, IPADDR_TYPE_V4);
-      }
-#endif /* LWIP_IPV4 && LWIP_IPV6 */
-
-      /* send the data */
-      err = netconn_send(sock->conn, &chain_buf);
-    }
+    /* send the data */
+    err = netconn_send(sock->conn, &chain_buf);
 
     /* deallocated the buffer */
     netbuf_free(&chain_buf);
@@ -1606,11 +1653,6 @@ lwip_sendmsg(int s, const struct msghdr *msg, int flags)
     set_errno(err_to_errno(err));
     done_socket(sock);
     return (err == ERR_OK ? size : -1);
-sendmsg_emsgsize:
-    set_errno(EMSGSIZE);
-    netbuf_free(&chain_buf);
-    done_socket(sock);
-    return -1;
   }
 #else /* LWIP_UDP || LWIP_RAW */
   set_errno(err_to_errno(ERR_ARG));
@@ -1719,6 +1761,220 @@ lwip_sendto(int s, const void *data, size_t size, int flags,
   return (err == ERR_OK ? short_size : -1);
 }
 
+#if LWIP_SOCKET_MMSG
+/**
+ * Receive several datagrams from a UDP or RAW socket with one call, filling
+ * msgvec[i].msg_hdr like lwip_recvmsg() and msgvec[i].msg_len with the
+ * datagram length.
+ *
+ * Without MSG_DONTWAIT, blocks until vlen datagrams were received (or the
+ * receive timeout expires). MSG_WAITFORONE turns on MSG_DONTWAIT after the
+ * first datagram. A netconn error after the first datagram is kept for the
+ * next receive call on the socket, which returns it.
+ *
+ * @return number of datagrams received or -1 on error (errno set) if none
+ */
+int
+lwip_recvmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+  struct lwip_sock *sock;
+  unsigned int i;
+  int recv_flags = flags & ~MSG_WAITFORONE;
+  int sock_errno = 0;
+#if LWIP_UDP || LWIP_RAW
+  err_t conn_err = ERR_OK;
+  SYS_ARCH_DECL_PROTECT(lev);
+#endif /* LWIP_UDP || LWIP_RAW */
+
+  LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_recvmmsg(%d, msgvec=%p, vlen=%u, flags=0x%x)\n", s, (void *)msgvec, vlen, flags));
+  LWIP_ERROR("lwip_recvmmsg: invalid msgvec pointer", (msgvec != NULL) || (vlen == 0),
+             set_errno(err_to_errno(ERR_ARG)); return -1;);
+  LWIP_ERROR("lwip_recvmmsg: unsupported flags", (flags & ~(MSG_DONTWAIT | MSG_WAITFORONE)) == 0,
+             set_errno(EOPNOTSUPP); return -1;);
+
+  sock = get_socket(s);
+  if (!sock) {
+    return -1;
+  }
+
+  if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) == NETCONN_TCP) {
+    set_errno(EOPNOTSUPP);
+    done_socket(sock);
+    return -1;
+  }
+#if LWIP_UDP || LWIP_RAW
+  if (vlen > INT_MAX) {
+    vlen = INT_MAX;
+  }
+  for (i = 0; i < vlen; i++) {
+    struct msghdr *message = &msgvec[i].msg_hdr;
+    u16_t datagram_len = 0;
+    ssize_t buflen;
+    err_t err;
+
+    if ((message->msg_iovlen <= 0) || (message->msg_iovlen > IOV_MAX)) {
+      sock_errno = EMSGSIZE;
+      break;
+    }
+    buflen = lwip_recvmsg_iov_len(message);
+    if (buflen < 0) {
+      sock_errno = err_to_errno(ERR_VAL);
+      break;
+    }
+    err = lwip_recvfrom_udp_raw(sock, recv_flags, message, &datagram_len, s);
+    if (err != ERR_OK) {
+      LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_recvmmsg[UDP/RAW](%d): datagram %u, error is \"%s\"!\n",
+                                  s, i, lwip_strerr(err)));
+      if (err != ERR_WOULDBLOCK) {
+        conn_err = err;
+      }
+      sock_errno = err_to_errno(err);
+      break;
+    }
+    if (datagram_len > buflen) {
+      message->msg_flags |= MSG_TRUNC;
+    }
+    msgvec[i].msg_len = datagram_len;
+
+    if (flags & MSG_WAITFORONE) {
+      recv_flags |= MSG_DONTWAIT;
+    }
+  }
+
+  if ((i > 0) && (conn_err != ERR_OK)) {
+    /* The datagrams received so far are returned: keep the error of the
+       netconn for the next receive call, which reports it once no datagram
+       is queued. A bad msg_iov fails again on its own. */
+    SYS_ARCH_PROTECT(lev);
+    if (sock->conn->pending_err == ERR_OK) {
+      sock->conn->pending_err = conn_err;
+    }
+    SYS_ARCH_UNPROTECT(lev);
+  }
+  done_socket(sock);
+  if ((i == 0) && (sock_errno != 0)) {
+    set_errno(sock_errno);
+    return -1;
+  }
+  set_errno(0);
+  return (int)i;
+#else /* LWIP_UDP || LWIP_RAW */
+  LWIP_UNUSED_ARG(i);
+  LWIP_UNUSED_ARG(recv_flags);
+  LWIP_UNUSED_ARG(sock_errno);
+  set_errno(err_to_errno(ERR_ARG));
+  done_socket(sock);
+  return -1;
+#endif /* LWIP_UDP || LWIP_RAW */
+}
+
+/**
+ * Send several messages with one call, setting msgvec[i].msg_len to the
+ * bytes sent for each one.
+ *
+ * For UDP and RAW sockets, up to LWIP_SOCKET_MMSG_BATCH datagrams are passed
+ * to the tcpip thread with a single netconn_send_multi() call, i.e. one
+ * message (or one core lock with LWIP_TCPIP_CORE_LOCKING) per batch instead
+ * of one per datagram. TCP sockets send the messages one after another.
+ *
+ * @return number of messages sent or -1 on error (errno set) if none
+ */
+int
+lwip_sendmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+  struct lwip_sock *sock;
+  unsigned int done = 0;
+  msg_iovlen_t iovlen;
+  int sock_errno = 0;
+
+  LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_sendmmsg(%d, msgvec=%p, vlen=%u, flags=0x%x)\n", s, (void *)msgvec, vlen, flags));
+  LWIP_ERROR("lwip_sendmmsg: invalid msgvec pointer", (msgvec != NULL) || (vlen == 0),
+             set_errno(err_to_errno(ERR_ARG)); return -1;);
+  LWIP_ERROR("lwip_sendmmsg: unsupported flags", (flags & ~(MSG_DONTWAIT | MSG_MORE)) == 0,
+             set_errno(EOPNOTSUPP); return -1;);
+
+  sock = get_socket(s);
+  if (!sock) {
+    return -1;
+  }
+  if (vlen > INT_MAX) {
+    vlen = INT_MAX;
+  }
+
+  if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) == NETCONN_TCP) {
+#if LWIP_TCP
+    done_socket(sock);
+    for (done = 0; done < vlen; done++) {
+      ssize_t ret = lwip_sendmsg(s, &msgvec[done].msg_hdr, flags);
+      if (ret < 0) {
+        /* errno is set by lwip_sendmsg() */
+        return (done == 0) ? -1 : (int)done;
+      }
+      msgvec[done].msg_len = (unsigned int)ret;
+    }
+    return (int)done;
+#else /* LWIP_TCP */
+    set_errno(err_to_errno(ERR_ARG));
+    done_socket(sock);
+    return -1;
+#endif /* LWIP_TCP */
+  }
+  /* else, UDP and RAW NETCONNs */
+#if LWIP_UDP || LWIP_RAW
+  while ((done < vlen) && (sock_errno == 0)) {
+    struct netbuf bufs[LWIP_SOCKET_MMSG_BATCH];
+    u16_t count = 0;
+    u16_t sent = 0;
+    u16_t i;
+
+    /* prepare a batch of netbufs */
+    while ((count < LWIP_SOCKET_MMSG_BATCH) && (done + count < vlen)) {
+      const struct msghdr *msg = &msgvec[done + count].msg_hdr;
+      ssize_t size = 0;
+
+      iovlen = msg->msg_iovlen;
+      if ((msg->msg_iov == NULL) || (iovlen <= 0) || (iovlen > IOV_MAX)) {
+        sock_errno = EMSGSIZE;
+        break;
+      }
+      sock_errno = lwip_sendmsg_udp_raw_netbuf(msg, &bufs[count], &size);
+      if (sock_errno != 0) {
+        break;
+      }
+      msgvec[done + count].msg_len = (unsigned int)size;
+      count++;
+    }
+
+    if (count > 0) {
+      /* send the whole batch with one call into the stack */
+      err_t err = netconn_send_multi(sock->conn, bufs, count, &sent);
+      for (i = 0; i < count; i++) {
+        netbuf_free(&bufs[i]);
+      }
+      done += sent;
+      if ((err != ERR_OK) && (sock_errno == 0)) {
+        sock_errno = err_to_errno(err);
+      }
+    }
+  }
+
+  done_socket(sock);
+  if ((done == 0) && (sock_errno != 0)) {
+    set_errno(sock_errno);
+    return -1;
+  }
+  set_errno(0);
+  return (int)done;
+#else /* LWIP_UDP || LWIP_RAW */
+  LWIP_UNUSED_ARG(iovlen);
+  LWIP_UNUSED_ARG(sock_errno);
+  set_errno(err_to_errno(ERR_ARG));
+  done_socket(sock);
+  return -1;
+#endif /* LWIP_UDP || LWIP_RAW */
+}
+#endif /* LWIP_SOCKET_MMSG */
+
 int
 lwip_socket(int domain, int type, int protocol)
 {
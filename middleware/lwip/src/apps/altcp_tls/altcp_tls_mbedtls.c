@@ -61,6 +61,7 @@
 #include "lwip/altcp.h"
 #include "lwip/altcp_tls.h"
 #include "lwip/priv/altcp_priv.h"
+#include "lwip/timeouts.h"
 
 #include "altcp_tls_mbedtls_structs.h"
 #include "altcp_tls_mbedtls_mem.h"
@@ -78,6 +79,10 @@
 #include "mbedtls/memory_buffer_alloc.h"
 #include "mbedtls/ssl_cache.h"
 #include "mbedtls/ssl_ticket.h"
+#include "mbedtls/ecp.h"
+#include "mbedtls/x509_verify_cache.h"
+#include "mbedtls/x509_crt_bundle.h"
+#include "mbedtls/profile.h"
 
 #include "mbedtls/ssl_internal.h" /* to call mbedtls_flush_output after ERR_MEM */
 
@@ -90,6 +95,18 @@
 #define ALTCP_MBEDTLS_ENTROPY_LEN   0
 #endif
 
+#if ALTCP_MBEDTLS_ECP_MAX_OPS && !defined(MBEDTLS_ECP_RESTARTABLE)
+#error "ALTCP_MBEDTLS_ECP_MAX_OPS needs MBEDTLS_ECP_RESTARTABLE in mbedTLS config"
+#endif
+
+#if ALTCP_MBEDTLS_USE_VERIFY_CACHE && !defined(MBEDTLS_X509_VERIFY_CACHE_C)
+#error "ALTCP_MBEDTLS_USE_VERIFY_CACHE needs MBEDTLS_X509_VERIFY_CACHE_C in mbedTLS config"
+#endif
+
+#if ALTCP_MBEDTLS_HANDSHAKE_PROFILE && !defined(MBEDTLS_SSL_HANDSHAKE_PROFILE)
+#error "ALTCP_MBEDTLS_HANDSHAKE_PROFILE needs MBEDTLS_SSL_HANDSHAKE_PROFILE in mbedTLS config"
+#endif
+
 /* Variable prototype, the actual declaration is at the end of this file
    since it contains pointers to static functions declared here */
 extern const struct altcp_functions altcp_mbedtls_functions;
@@ -104,6 +121,10 @@ struct altcp_tls_config {
   u8_t pkey_count;
   u8_t pkey_max;
   mbedtls_x509_crt *ca;
+#if defined(MBEDTLS_X509_CRT_BUNDLE_C)
+  /** CA bundle in flash, used instead of ca */
+  mbedtls_x509_crt_bundle ca_bundle;
+#endif
 #if defined(MBEDTLS_SSL_CACHE_C) && ALTCP_MBEDTLS_USE_SESSION_CACHE
   /** Inter-connection cache for fast connection startup */
   struct mbedtls_ssl_cache_context cache;
@@ -121,6 +142,33 @@ struct altcp_tls_entropy_rng {
 };
 static struct altcp_tls_entropy_rng *altcp_tls_entropy_rng;
 
+#if ALTCP_MBEDTLS_USE_VERIFY_CACHE
+/** Verified server chains, shared by all client configurations: the cache key
+ * covers the CA certificates, so configurations with different CAs can't
+ * get each other's results */
+static mbedtls_x509_verify_cache altcp_tls_verify_cache;
+static u8_t altcp_tls_verify_cache_initialized;
+
+static void
+altcp_mbedtls_init_verify_cache(void)
+{
+  if (!altcp_tls_verify_cache_initialized) {
+    mbedtls_x509_verify_cache_init(&altcp_tls_verify_cache);
+#if defined(MBEDTLS_HAVE_TIME)
+    mbedtls_x509_verify_cache_set_timeout(&altcp_tls_verify_cache, ALTCP_MBEDTLS_VERIFY_CACHE_TIMEOUT_SECONDS);
+#endif
+    altcp_tls_verify_cache_initialized = 1;
+  }
+}
+#endif
+
+#if ALTCP_MBEDTLS_HANDSHAKE_PROFILE
+/** Profile of the last completed handshake, for altcp_tls_get_last_handshake_profile() */
+static struct altcp_tls_handshake_profile altcp_tls_last_profile;
+static altcp_tls_handshake_profile_fn altcp_tls_profile_fn;
+static void *altcp_tls_profile_arg;
+#endif
+
 static err_t altcp_mbedtls_lower_recv(void *arg, struct altcp_pcb *inner_conn, struct pbuf *p, err_t err);
 static err_t altcp_mbedtls_setup(void *conf, struct altcp_pcb *conn, struct altcp_pcb *inner_conn);
 static err_t altcp_mbedtls_lower_recv_process(struct altcp_pcb *conn, altcp_mbedtls_state_t *state);
@@ -263,12 +311,97 @@ altcp_mbedtls_lower_recv(void *arg, struct altcp_pcb *inner_conn, struct pbuf *p
   return altcp_mbedtls_lower_recv_process(conn, state);
 }
 
+/** Run one handshake step (until mbedTLS needs more data or, with
+ * ALTCP_MBEDTLS_ECP_MAX_OPS, until an ECC operation is interrupted)
+ */
+static int
+altcp_mbedtls_handshake_step(altcp_mbedtls_state_t *state)
+{
+  int ret;
+  altcp_mbedtls_state_t *prev_mem;
+#if ALTCP_MBEDTLS_HANDSHAKE_STATS
+  u32_t start = ALTCP_MBEDTLS_GET_TIME_US();
+  u32_t now;
+
+  if (state->hs_stats.steps == 0) {
+    state->hs_start_us = start;
+  }
+#endif
+
+  prev_mem = altcp_mbedtls_mem_enter(state, MBEDTLS_SSL_ALLOC_SCOPE_HANDSHAKE);
+  ret = mbedtls_ssl_handshake(&state->ssl_context);
+  altcp_mbedtls_mem_leave(prev_mem);
+
+#if ALTCP_MBEDTLS_HANDSHAKE_STATS
+  now = ALTCP_MBEDTLS_GET_TIME_US();
+  state->hs_stats.steps++;
+  state->hs_stats.busy_us += now - start;
+  state->hs_stats.max_step_us = LWIP_MAX(state->hs_stats.max_step_us, now - start);
+  state->hs_stats.total_us = now - state->hs_start_us;
+  if (ret == MBEDTLS_ERR_SSL_CRYPTO_IN_PROGRESS) {
+    state->hs_stats.ecp_yields++;
+  } else if (ret == 0) {
+    state->hs_stats.done = 1;
+    LWIP_DEBUGF(ALTCP_MBEDTLS_DEBUG, ("handshake done: %"U32_F" us total, %"U32_F" us busy, %"U32_F" steps, max step %"U32_F" us\n",
+                                      state->hs_stats.total_us, state->hs_stats.busy_us,
+                                      state->hs_stats.steps, state->hs_stats.max_step_us));
+  }
+#endif
+  return ret;
+}
+
+#if LWIP_TIMERS
+/** Timeout continuing an interrupted handshake step */
+static void
+altcp_mbedtls_step_timeout(void *arg)
+{
+  struct altcp_pcb *conn = (struct altcp_pcb *)arg;
+  altcp_mbedtls_state_t *state = (altcp_mbedtls_state_t *)conn->state;
+
+  LWIP_ASSERT("state != NULL", state != NULL);
+  state->flags &= ~ALTCP_MBEDTLS_FLAGS_STEP_PENDING;
+  if (!(state->flags & ALTCP_MBEDTLS_FLAGS_HANDSHAKE_DONE)) {
+    altcp_mbedtls_lower_recv_process(conn, state);
+  }
+}
+#endif
+
+/** An ECC operation was interrupted: continue the handshake from a timeout
+ * (or the next poll/recv call) so that the stack can run in between */
+static void
+altcp_mbedtls_schedule_step(struct altcp_pcb *conn, altcp_mbedtls_state_t *state)
+{
+  if (!(state->flags & ALTCP_MBEDTLS_FLAGS_STEP_PENDING)) {
+    state->flags |= ALTCP_MBEDTLS_FLAGS_STEP_PENDING;
+#if LWIP_TIMERS
+    sys_timeout(LWIP_MAX(ALTCP_MBEDTLS_HANDSHAKE_STEP_DELAY, 1), altcp_mbedtls_step_timeout, conn);
+#else
+    LWIP_UNUSED_ARG(conn);
+#endif
+  }
+}
+
+static void
+altcp_mbedtls_cancel_step(struct altcp_pcb *conn, altcp_mbedtls_state_t *state)
+{
+  if (state->flags & ALTCP_MBEDTLS_FLAGS_STEP_PENDING) {
+    state->flags &= ~ALTCP_MBEDTLS_FLAGS_STEP_PENDING;
+#if LWIP_TIMERS
+    sys_untimeout(altcp_mbedtls_step_timeout, conn);
+#else
+    LWIP_UNUSED_ARG(conn);
+#endif
+  }
+}
+
 static err_t
 altcp_mbedtls_lower_recv_process(struct altcp_pcb *conn, altcp_mbedtls_state_t *state)
 {
   if (!(state->flags & ALTCP_MBEDTLS_FLAGS_HANDSHAKE_DONE)) {
     /* handle connection setup (handshake not done) */
-    int ret = mbedtls_ssl_handshake(&state->ssl_context);
+    int ret;
+    altcp_mbedtls_cancel_step(conn, state);
+    ret = altcp_mbedtls_handshake_step(state);
     /* try to send data... */
     altcp_output(conn->inner_conn);
     if (state->bio_bytes_read) {
@@ -282,6 +415,11 @@ altcp_mbedtls_lower_recv_process(struct altcp_pcb *conn, altcp_mbedtls_state_t *
       LWIP_ASSERT("in this state, the rx chain should be empty", state->rx == NULL);
       return ERR_OK;
     }
+    if (ret == MBEDTLS_ERR_SSL_CRYPTO_IN_PROGRESS) {
+      /* ECC operation interrupted after ALTCP_MBEDTLS_ECP_MAX_OPS, continue later */
+      altcp_mbedtls_schedule_step(conn, state);
+      return ERR_OK;
+    }
     if (ret != 0) {
       LWIP_DEBUGF(ALTCP_MBEDTLS_DEBUG, ("mbedtls_ssl_handshake failed: %d\n", ret));
       /* handshake failed, connection has to be closed */
@@ -298,6 +436,7 @@ altcp_mbedtls_lower_recv_process(struct altcp_pcb *conn, altcp_mbedtls_state_t *
     LWIP_ASSERT("state", state->bio_bytes_read == 0);
     LWIP_ASSERT("state", state->bio_bytes_appl == 0);
     state->flags |= ALTCP_MBEDTLS_FLAGS_HANDSHAKE_DONE;
+    altcp_mbedtls_mem_handshake_done(state);
     /* issue "connect" callback" to upper connection (this can only happen for active open) */
     if (conn->connected) {
       err_t err;
@@ -553,6 +692,11 @@ altcp_mbedtls_lower_poll(void *arg, struct altcp_pcb *inner_conn)
     /* check if there's unreceived rx data */
     if (conn->state) {
       altcp_mbedtls_state_t *state = (altcp_mbedtls_state_t *)conn->state;
+      if (state->flags & ALTCP_MBEDTLS_FLAGS_STEP_PENDING) {
+        /* continue an interrupted handshake (upper poll is skipped this time
+           as the connection might be closed if the handshake fails) */
+        return altcp_mbedtls_lower_recv_process(conn, state);
+      }
       /* try to send more if we failed before */
       mbedtls_ssl_flush_output(&state->ssl_context);
       if (altcp_mbedtls_handle_rx_appldata(conn, state) == ERR_ABRT) {
@@ -608,6 +752,7 @@ altcp_mbedtls_setup(void *conf, struct altcp_pcb *conn, struct altcp_pcb *inner_
   int ret;
   struct altcp_tls_config *config = (struct altcp_tls_config *)conf;
   altcp_mbedtls_state_t *state;
+  altcp_mbedtls_state_t *prev_mem;
   if (!conf) {
     return ERR_ARG;
   }
@@ -620,7 +765,9 @@ altcp_mbedtls_setup(void *conf, struct altcp_pcb *conn, struct altcp_pcb *inner_
   }
   /* initialize mbedtls context: */
   mbedtls_ssl_init(&state->ssl_context);
+  prev_mem = altcp_mbedtls_mem_enter(state, MBEDTLS_SSL_ALLOC_SCOPE_SESSION);
   ret = mbedtls_ssl_setup(&state->ssl_context, &config->conf);
+  altcp_mbedtls_mem_leave(prev_mem);
   if (ret != 0) {
     LWIP_DEBUGF(ALTCP_MBEDTLS_DEBUG, ("mbedtls_ssl_setup failed\n"));
     /* @todo: convert 'ret' to err_t */
@@ -678,8 +825,11 @@ altcp_tls_set_session(struct altcp_pcb *conn, struct altcp_tls_session *session)
   if (session && conn && conn->state) {
     altcp_mbedtls_state_t *state = (altcp_mbedtls_state_t *)conn->state;
     int ret = -1;
-    if (session->data.start)
+    if (session->data.start) {
+      altcp_mbedtls_state_t *prev_mem = altcp_mbedtls_mem_enter(state, MBEDTLS_SSL_ALLOC_SCOPE_SESSION);
       ret = mbedtls_ssl_set_session(&state->ssl_context, &session->data);
+      altcp_mbedtls_mem_leave(prev_mem);
+    }
     return ret < 0 ? ERR_VAL : ERR_OK;
   }
   return ERR_ARG;
@@ -702,6 +852,125 @@ altcp_tls_context(struct altcp_pcb *conn)
   return NULL;
 }
 
+#if ALTCP_MBEDTLS_HANDSHAKE_STATS
+err_t
+altcp_tls_get_handshake_stats(struct altcp_pcb *conn, struct altcp_tls_handshake_stats *stats)
+{
+  if (stats && conn && conn->state) {
+    altcp_mbedtls_state_t *state = (altcp_mbedtls_state_t *)conn->state;
+    *stats = state->hs_stats;
+    if (!stats->done && stats->steps) {
+      stats->total_us = ALTCP_MBEDTLS_GET_TIME_US() - state->hs_start_us;
+    }
+    return ERR_OK;
+  }
+  return ERR_ARG;
+}
+#endif
+
+#if ALTCP_MBEDTLS_MEM_STATS
+err_t
+altcp_tls_get_mem_stats(struct altcp_pcb *conn, struct altcp_tls_mem_stats *stats)
+{
+  if (stats && conn && conn->state) {
+    altcp_mbedtls_state_t *state = (altcp_mbedtls_state_t *)conn->state;
+    *stats = state->mem_stats;
+#if ALTCP_MBEDTLS_MEM_ARENA
+    stats->session_arena_peak = (u32_t)state->session_arena.peak;
+    stats->handshake_arena_peak = (u32_t)state->handshake_arena.peak;
+#endif
+    return ERR_OK;
+  }
+  return ERR_ARG;
+}
+#endif
+
+#if ALTCP_MBEDTLS_HANDSHAKE_PROFILE
+static void
+altcp_mbedtls_copy_profile(struct altcp_tls_handshake_profile *dst, const mbedtls_ssl_handshake_profile *src)
+{
+  int i;
+
+  LWIP_ASSERT("state count mismatch", ALTCP_TLS_PROFILE_STATES == MBEDTLS_SSL_PROFILE_STATES);
+  LWIP_ASSERT("operation count mismatch", ALTCP_TLS_PROFILE_OPS == MBEDTLS_PROFILE_OPS);
+
+  for (i = 0; i < ALTCP_TLS_PROFILE_STATES; i++) {
+    dst->state_us[i] = src->state_us[i];
+    dst->busy_us[i] = src->busy_us[i];
+  }
+  for (i = 0; i < ALTCP_TLS_PROFILE_OPS; i++) {
+    dst->ops[i].count = src->ops[i].count;
+    dst->ops[i].total_us = src->ops[i].total_us;
+    dst->ops[i].max_us = src->ops[i].max_us;
+  }
+  dst->total_us = src->total_us;
+  dst->steps = src->steps;
+  dst->done = src->done;
+}
+
+/** Time source of the mbedTLS profiler */
+static uint32_t
+altcp_mbedtls_profile_clock(void)
+{
+  return ALTCP_MBEDTLS_GET_TIME_US();
+}
+
+/** Called by mbedTLS when a handshake is done */
+static void
+altcp_mbedtls_handshake_profile(void *arg, const mbedtls_ssl_context *ssl, const mbedtls_ssl_handshake_profile *prof)
+{
+  /* the bio context is our connection, see altcp_mbedtls_setup() */
+  struct altcp_pcb *conn = (struct altcp_pcb *)ssl->p_bio;
+  LWIP_UNUSED_ARG(arg);
+
+  altcp_mbedtls_copy_profile(&altcp_tls_last_profile, prof);
+  LWIP_DEBUGF(ALTCP_MBEDTLS_DEBUG, ("handshake profile: %"U32_F" us total, ecp %"U32_F"x %"U32_F" us, rsa %"U32_F"x %"U32_F" us, x509 %"U32_F"x %"U32_F" us\n",
+                                    altcp_tls_last_profile.total_us,
+                                    altcp_tls_last_profile.ops[ALTCP_TLS_PROFILE_OP_ECP_MUL].count,
+                                    altcp_tls_last_profile.ops[ALTCP_TLS_PROFILE_OP_ECP_MUL].total_us,
+                                    altcp_tls_last_profile.ops[ALTCP_TLS_PROFILE_OP_RSA_PUBLIC].count +
+                                    altcp_tls_last_profile.ops[ALTCP_TLS_PROFILE_OP_RSA_PRIVATE].count,
+                                    altcp_tls_last_profile.ops[ALTCP_TLS_PROFILE_OP_RSA_PUBLIC].total_us +
+                                    altcp_tls_last_profile.ops[ALTCP_TLS_PROFILE_OP_RSA_PRIVATE].total_us,
+                                    altcp_tls_last_profile.ops[ALTCP_TLS_PROFILE_OP_X509_VERIFY].count,
+                                    altcp_tls_last_profile.ops[ALTCP_TLS_PROFILE_OP_X509_VERIFY].total_us));
+  if (altcp_tls_profile_fn != NULL) {
+    altcp_tls_profile_fn(altcp_tls_profile_arg, conn, &altcp_tls_last_profile);
+  }
+}
+
+err_t
+altcp_tls_get_handshake_profile(struct altcp_pcb *conn, struct altcp_tls_handshake_profile *prof)
+{
+  if (prof && conn && conn->state) {
+    altcp_mbedtls_state_t *state = (altcp_mbedtls_state_t *)conn->state;
+    altcp_mbedtls_copy_profile(prof, mbedtls_ssl_get_handshake_profile(&state->ssl_context));
+    return ERR_OK;
+  }
+  return ERR_ARG;
+}
+
+err_t
+altcp_tls_get_last_handshake_profile(struct altcp_tls_handshake_profile *prof)
+{
+  if (prof == NULL) {
+    return ERR_ARG;
+  }
+  if (!altcp_tls_last_profile.done) {
+    return ERR_VAL;
+  }
+  *prof = altcp_tls_last_profile;
+  return ERR_OK;
+}
+
+void
+altcp_tls_set_handshake_profile_callback(altcp_tls_handshake_profile_fn fn, void *arg)
+{
+  altcp_tls_profile_fn = fn;
+  altcp_tls_profile_arg = arg;
+}
+#endif /* ALTCP_MBEDTLS_HANDSHAKE_PROFILE */
+
 #if ALTCP_MBEDTLS_LIB_DEBUG != LWIP_DBG_OFF
 static void
 altcp_mbedtls_debug(void *ctx, int level, const char *file, int line, const char *str)
@@ -827,9 +1096,21 @@ altcp_tls_create_config(int is_server, u8_t cert_count, u8_t pkey_count, int hav
   mbedtls_ssl_conf_authmode(&conf->conf, ALTCP_MBEDTLS_AUTHMODE);
 
   mbedtls_ssl_conf_rng(&conf->conf, mbedtls_ctr_drbg_random, &altcp_tls_entropy_rng->ctr_drbg);
+#if ALTCP_MBEDTLS_ECP_MAX_OPS
+  /* split ECC operations of (client) handshakes into steps */
+  mbedtls_ecp_set_max_ops(ALTCP_MBEDTLS_ECP_MAX_OPS);
+#endif
 #if ALTCP_MBEDTLS_LIB_DEBUG != LWIP_DBG_OFF
   mbedtls_ssl_conf_dbg(&conf->conf, altcp_mbedtls_debug, stdout);
 #endif
+#if ALTCP_MBEDTLS_MEM_ARENA || ALTCP_MBEDTLS_MEM_STATS
+  /* tell handshake allocations apart from the ones kept afterwards */
+  mbedtls_ssl_conf_alloc_scope(&conf->conf, altcp_mbedtls_mem_scope, NULL);
+#endif
+#if ALTCP_MBEDTLS_HANDSHAKE_PROFILE
+  mbedtls_profile_set_clock(altcp_mbedtls_profile_clock);
+  mbedtls_ssl_conf_handshake_profile(&conf->conf, altcp_mbedtls_handshake_profile, NULL);
+#endif
 #if defined(MBEDTLS_SSL_CACHE_C) && ALTCP_MBEDTLS_USE_SESSION_CACHE
   mbedtls_ssl_conf_session_cache(&conf->conf, &conf->cache, mbedtls_ssl_cache_get, mbedtls_ssl_cache_set);
   mbedtls_ssl_cache_set_timeout(&conf->cache, ALTCP_MBEDTLS_SESSION_CACHE_TIMEOUT_SECONDS);
@@ -942,7 +1223,15 @@ static struct altcp_tls_config *
 altcp_tls_create_config_client_common(const u8_t *ca, size_t ca_len, int is_2wayauth)
 {
   int ret;
-  struct altcp_tls_config *conf = altcp_tls_create_config(0, (is_2wayauth) ? 1 : 0, (is_2wayauth) ? 1 : 0, ca != NULL);
+  int ca_is_bundle = 0;
+  struct altcp_tls_config *conf;
+
+#if defined(MBEDTLS_X509_CRT_BUNDLE_C)
+  /* a CA bundle is used in place, its CAs are only parsed to verify chains */
+  ca_is_bundle = mbedtls_x509_crt_bundle_is_bundle(ca, ca_len);
+#endif
+
+  conf = altcp_tls_create_config(0, (is_2wayauth) ? 1 : 0, (is_2wayauth) ? 1 : 0, ca != NULL && !ca_is_bundle);
   if (conf == NULL) {
     return NULL;
   }
@@ -950,6 +1239,19 @@ altcp_tls_create_config_client_common(const u8_t *ca, size_t ca_len, int is_2way
   /* Initialize the CA certificate if provided
    * CA certificate is optional (to save memory) but recommended for production environment
    * Without CA certificate, connection will be prone to man-in-the-middle attacks */
+#if defined(MBEDTLS_X509_CRT_BUNDLE_C)
+  if (ca_is_bundle) {
+    mbedtls_x509_crt_bundle_init(&conf->ca_bundle);
+    ret = mbedtls_x509_crt_bundle_load(&conf->ca_bundle, ca, ca_len);
+    if (ret != 0) {
+      LWIP_DEBUGF(ALTCP_MBEDTLS_DEBUG, ("mbedtls_x509_crt_bundle_load failed: %d 0x%x", ret, -1*ret));
+      altcp_tls_free_config(conf);
+      return NULL;
+    }
+
+    mbedtls_ssl_conf_ca_cb(&conf->conf, mbedtls_x509_crt_bundle_ca_cb, &conf->ca_bundle);
+  } else
+#endif
   if (ca) {
     mbedtls_x509_crt_init(conf->ca);
     ret = mbedtls_x509_crt_parse(conf->ca, ca, ca_len);
@@ -961,6 +1263,11 @@ altcp_tls_create_config_client_common(const u8_t *ca, size_t ca_len, int is_2way
 
     mbedtls_ssl_conf_ca_chain(&conf->conf, conf->ca, NULL);
   }
+#if ALTCP_MBEDTLS_USE_VERIFY_CACHE
+  /* set after the CA chain, which would flush the cache otherwise */
+  altcp_mbedtls_init_verify_cache();
+  mbedtls_ssl_conf_verify_cache(&conf->conf, &altcp_tls_verify_cache);
+#endif
   return conf;
 }
 
@@ -1042,10 +1349,67 @@ altcp_tls_free_config(struct altcp_tls_config *conf)
   if (conf->ca) {
     mbedtls_x509_crt_free(conf->ca);
   }
+#if defined(MBEDTLS_X509_CRT_BUNDLE_C)
+  mbedtls_x509_crt_bundle_free(&conf->ca_bundle);
+#endif
   altcp_mbedtls_free_config(conf);
   altcp_mbedtls_unref_entropy();
 }
 
+#if ALTCP_MBEDTLS_USE_VERIFY_CACHE
+void
+altcp_tls_get_verify_cache_stats(struct altcp_tls_verify_cache_stats *stats)
+{
+  mbedtls_x509_verify_cache_stats s;
+
+  LWIP_ASSERT("stats != NULL", stats != NULL);
+
+  memset(&s, 0, sizeof(s));
+  if (altcp_tls_verify_cache_initialized) {
+    mbedtls_x509_verify_cache_get_stats(&altcp_tls_verify_cache, &s);
+  }
+  stats->hits = s.hits;
+  stats->misses = s.misses;
+  stats->bypassed = s.bypassed;
+  stats->stores = s.stores;
+  stats->evictions = s.evictions;
+  stats->expired = s.expired;
+  stats->invalidations = s.invalidations;
+}
+
+void
+altcp_tls_flush_verify_cache(void)
+{
+  if (altcp_tls_verify_cache_initialized) {
+    mbedtls_x509_verify_cache_clear(&altcp_tls_verify_cache);
+  }
+}
+
+err_t
+altcp_tls_save_verify_cache(u8_t *buf, size_t len, size_t *olen)
+{
+  if (!altcp_tls_verify_cache_initialized) {
+    return ERR_VAL;
+  }
+  if (mbedtls_x509_verify_cache_export(&altcp_tls_verify_cache, buf, len, olen) != 0) {
+    return ERR_BUF;
+  }
+  return ERR_OK;
+}
+
+err_t
+altcp_tls_restore_verify_cache(const u8_t *buf, size_t len)
+{
+  LWIP_ASSERT_CORE_LOCKED();
+
+  altcp_mbedtls_init_verify_cache();
+  if (mbedtls_x509_verify_cache_import(&altcp_tls_verify_cache, buf, len) != 0) {
+    return ERR_VAL;
+  }
+  return ERR_OK;
+}
+#endif /* ALTCP_MBEDTLS_USE_VERIFY_CACHE */
+
 void
 altcp_tls_free_entropy(void)
 {
@@ -1117,6 +1481,7 @@ altcp_mbedtls_listen(struct altcp_pcb *conn, u8_t backlog, err_t *err)
     /* Free members of the ssl context (not used on listening pcb). This
        includes freeing input/output buffers, so saves ~32KByte by default */
     mbedtls_ssl_free(&state->ssl_context);
+    altcp_mbedtls_mem_release(state);
 
     conn->inner_conn = lpcb;
     altcp_accept(lpcb, altcp_mbedtls_lower_accept);
@@ -1313,6 +1678,7 @@ altcp_mbedtls_dealloc(struct altcp_pcb *conn)
   if (conn) {
     altcp_mbedtls_state_t *state = (altcp_mbedtls_state_t *)conn->state;
     if (state) {
+      altcp_mbedtls_cancel_step(conn, state);
       mbedtls_ssl_free(&state->ssl_context);
       state->flags = 0;
       if (state->rx) {
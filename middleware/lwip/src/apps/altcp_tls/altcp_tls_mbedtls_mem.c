@@ -59,6 +59,7 @@
 #include "altcp_tls_mbedtls_mem.h"
 #include "altcp_tls_mbedtls_structs.h"
 #include "lwip/mem.h"
+#include "lwip/memp.h"
 
 #include "mbedtls/platform.h"
 
@@ -76,6 +77,14 @@
 #define ALTCP_MBEDTLS_PLATFORM_ALLOC 0
 #endif
 
+#if (ALTCP_MBEDTLS_MEM_ARENA || ALTCP_MBEDTLS_MEM_STATS) && !ALTCP_MBEDTLS_PLATFORM_ALLOC
+#error "ALTCP_MBEDTLS_MEM_ARENA and ALTCP_MBEDTLS_MEM_STATS need MBEDTLS_PLATFORM_MEMORY in mbedTLS config"
+#endif
+
+#if (ALTCP_MBEDTLS_MEM_ARENA || ALTCP_MBEDTLS_MEM_STATS) && !defined(MBEDTLS_SSL_ALLOC_SCOPE)
+#error "ALTCP_MBEDTLS_MEM_ARENA and ALTCP_MBEDTLS_MEM_STATS need MBEDTLS_SSL_ALLOC_SCOPE in mbedTLS config"
+#endif
+
 #if ALTCP_MBEDTLS_PLATFORM_ALLOC
 
 #ifndef ALTCP_MBEDTLS_PLATFORM_ALLOC_STATS
@@ -84,7 +93,9 @@
 
 /* This is an example/debug implementation of alloc/free functions only */
 typedef struct altcp_mbedtls_malloc_helper_s {
-  size_t c;
+  /* connection the memory was allocated for (ALTCP_MBEDTLS_MEM_ARENA or
+     ALTCP_MBEDTLS_MEM_STATS), NULL if none */
+  altcp_mbedtls_state_t *state;
   size_t len;
 } altcp_mbedtls_malloc_helper_t;
 
@@ -99,10 +110,154 @@ altcp_mbedtls_malloc_stats_t altcp_mbedtls_malloc_stats;
 volatile int altcp_mbedtls_malloc_clear_stats;
 #endif
 
+#if ALTCP_MBEDTLS_MEM_ARENA || ALTCP_MBEDTLS_MEM_STATS
+/* connection running mbedTLS (setup or handshake step) and its thread */
+static altcp_mbedtls_state_t *altcp_mbedtls_mem_current;
+static void *altcp_mbedtls_mem_thread;
+#endif
+
+#if ALTCP_MBEDTLS_MEM_ARENA
+
+#if (ALTCP_MBEDTLS_ARENA_SESSION_SIZE > 0xFFFF) || (ALTCP_MBEDTLS_ARENA_HANDSHAKE_SIZE > 0xFFFF)
+#error "ALTCP_MBEDTLS_ARENA_SESSION_SIZE and ALTCP_MBEDTLS_ARENA_HANDSHAKE_SIZE must not exceed 65535"
+#endif
+
+LWIP_MEMPOOL_DECLARE(ALTCP_TLS_SESSION_ARENA, ALTCP_MBEDTLS_ARENA_CONNECTIONS,
+                     ALTCP_MBEDTLS_ARENA_SESSION_SIZE, "ALTCP_TLS_SESSION_ARENA")
+LWIP_MEMPOOL_DECLARE(ALTCP_TLS_HANDSHAKE_ARENA, ALTCP_MBEDTLS_ARENA_HANDSHAKES,
+                     ALTCP_MBEDTLS_ARENA_HANDSHAKE_SIZE, "ALTCP_TLS_HANDSHAKE_ARENA")
+
+static u8_t altcp_mbedtls_arena_pools_initialized;
+
+/* Free block of an arena, same size as the header of an allocated block */
+typedef struct altcp_mbedtls_arena_free_s {
+  struct altcp_mbedtls_arena_free_s *next;
+  /* size including this header */
+  size_t size;
+} altcp_mbedtls_arena_free_t;
+
+/* Arena blocks are multiples of the header size, so that the rest of a split
+   block can always hold a free block header */
+#define ALTCP_MBEDTLS_ARENA_UNIT            sizeof(altcp_mbedtls_malloc_helper_t)
+#define ALTCP_MBEDTLS_ARENA_BLOCK_SIZE(len) \
+  ((((len) + 2 * ALTCP_MBEDTLS_ARENA_UNIT - 1) / ALTCP_MBEDTLS_ARENA_UNIT) * ALTCP_MBEDTLS_ARENA_UNIT)
+
+static void
+altcp_mbedtls_arena_init(struct altcp_mbedtls_arena *arena, void *block, size_t size)
+{
+  altcp_mbedtls_arena_free_t *f;
+  u8_t *mem = (u8_t *)LWIP_MEM_ALIGN(block);
+
+  size -= (size_t)(mem - (u8_t *)block);
+  size -= size % ALTCP_MBEDTLS_ARENA_UNIT;
+  arena->block = block;
+  arena->mem = mem;
+  arena->end = mem + size;
+  arena->used = 0;
+  f = (altcp_mbedtls_arena_free_t *)mem;
+  f->next = NULL;
+  f->size = size;
+  arena->free_list = f;
+}
+
+/* First fit: arenas are small and the blocks of a handshake are mostly freed
+   in reverse order, so the free list stays short */
+static altcp_mbedtls_malloc_helper_t *
+altcp_mbedtls_arena_alloc(struct altcp_mbedtls_arena *arena, size_t len)
+{
+  altcp_mbedtls_arena_free_t **prev, *f;
+  size_t size;
+
+  if (len >= (size_t)(arena->end - arena->mem)) {
+    return NULL;
+  }
+  size = ALTCP_MBEDTLS_ARENA_BLOCK_SIZE(len);
+  for (prev = (altcp_mbedtls_arena_free_t **)&arena->free_list; (f = *prev) != NULL; prev = &f->next) {
+    if (f->size >= size) {
+      if (f->size > size) {
+        altcp_mbedtls_arena_free_t *rest = (altcp_mbedtls_arena_free_t *)((u8_t *)f + size);
+        rest->next = f->next;
+        rest->size = f->size - size;
+        *prev = rest;
+      } else {
+        *prev = f->next;
+      }
+      arena->used += size;
+      arena->peak = LWIP_MAX(arena->peak, arena->used);
+      return (altcp_mbedtls_malloc_helper_t *)f;
+    }
+  }
+  return NULL;
+}
+
+static void
+altcp_mbedtls_arena_free(struct altcp_mbedtls_arena *arena, altcp_mbedtls_malloc_helper_t *hlpr)
+{
+  altcp_mbedtls_arena_free_t **prev = (altcp_mbedtls_arena_free_t **)&arena->free_list;
+  altcp_mbedtls_arena_free_t *blk = (altcp_mbedtls_arena_free_t *)hlpr;
+  altcp_mbedtls_arena_free_t *last = NULL, *next;
+  size_t size = ALTCP_MBEDTLS_ARENA_BLOCK_SIZE(hlpr->len);
+
+  arena->used -= size;
+  /* insert sorted by address, merging with the neighbours */
+  while (((next = *prev) != NULL) && (next < blk)) {
+    last = next;
+    prev = &next->next;
+  }
+  blk->size = size;
+  blk->next = next;
+  if ((next != NULL) && ((u8_t *)blk + size == (u8_t *)next)) {
+    blk->size += next->size;
+    blk->next = next->next;
+  }
+  if ((last != NULL) && ((u8_t *)last + last->size == (u8_t *)blk)) {
+    last->size += blk->size;
+    last->next = blk->next;
+  } else {
+    *prev = blk;
+  }
+}
+
+static int
+altcp_mbedtls_arena_contains(struct altcp_mbedtls_arena *arena, void *ptr)
+{
+  return (arena->mem != NULL) && ((u8_t *)ptr >= arena->mem) && ((u8_t *)ptr < arena->end);
+}
+
+static void
+altcp_mbedtls_arena_release(struct altcp_mbedtls_arena *arena, const struct memp_desc *pool)
+{
+  if (arena->block != NULL) {
+    memp_free_pool(pool, arena->block);
+    arena->block = NULL;
+    arena->mem = NULL;
+    arena->end = NULL;
+    arena->free_list = NULL;
+  }
+}
+#endif /* ALTCP_MBEDTLS_MEM_ARENA */
+
+#if ALTCP_MBEDTLS_MEM_STATS
+static void
+altcp_mbedtls_mem_count(altcp_mbedtls_state_t *state, size_t len)
+{
+  struct altcp_tls_mem_stats *stats = &state->mem_stats;
+  struct altcp_tls_mem_phase_stats *phase;
+
+  phase = &stats->phase[LWIP_MIN(state->ssl_context.state, ALTCP_TLS_MEM_PHASES - 1)];
+  stats->cur_bytes += (u32_t)len;
+  stats->peak_bytes = LWIP_MAX(stats->peak_bytes, stats->cur_bytes);
+  phase->allocs++;
+  phase->total_bytes += (u32_t)len;
+  phase->peak_bytes = LWIP_MAX(phase->peak_bytes, stats->cur_bytes);
+}
+#endif /* ALTCP_MBEDTLS_MEM_STATS */
+
 static void *
 tls_malloc(size_t c, size_t len)
 {
-  altcp_mbedtls_malloc_helper_t *hlpr;
+  altcp_mbedtls_malloc_helper_t *hlpr = NULL;
+  altcp_mbedtls_state_t *state = NULL;
   void *ret;
   size_t alloc_size;
 #if ALTCP_MBEDTLS_PLATFORM_ALLOC_STATS
@@ -111,17 +266,45 @@ tls_malloc(size_t c, size_t len)
     memset(&altcp_mbedtls_malloc_stats, 0, sizeof(altcp_mbedtls_malloc_stats));
   }
 #endif
-  alloc_size = sizeof(altcp_mbedtls_malloc_helper_t) + (c * len);
-  /* check for maximum allocation size, mainly to prevent mem_size_t overflow */
-  if (alloc_size > MEM_SIZE) {
-    LWIP_DEBUGF(ALTCP_MBEDTLS_MEM_DEBUG, ("mbedtls allocation too big: %c * %d bytes vs MEM_SIZE=%d",
-                                          (int)c, (int)len, (int)MEM_SIZE));
+  if ((len != 0) && (c > ((size_t)-1) / len)) {
     return NULL;
   }
-  hlpr = (altcp_mbedtls_malloc_helper_t *)mem_malloc((mem_size_t)alloc_size);
+#if ALTCP_MBEDTLS_MEM_ARENA || ALTCP_MBEDTLS_MEM_STATS
+  if ((altcp_mbedtls_mem_current != NULL) &&
+      (altcp_mbedtls_mem_thread == ALTCP_MBEDTLS_MEM_THREAD_ID()) &&
+      (altcp_mbedtls_mem_current->mem_scope != MBEDTLS_SSL_ALLOC_SCOPE_SHARED)) {
+    state = altcp_mbedtls_mem_current;
+  }
+#endif
+#if ALTCP_MBEDTLS_MEM_ARENA
+  if (state != NULL) {
+    struct altcp_mbedtls_arena *arena = (state->mem_scope == MBEDTLS_SSL_ALLOC_SCOPE_HANDSHAKE) ?
+                                        &state->handshake_arena : &state->session_arena;
+    if (arena->mem != NULL) {
+      hlpr = altcp_mbedtls_arena_alloc(arena, c * len);
+    }
+    if (hlpr == NULL) {
+      LWIP_DEBUGF(ALTCP_MBEDTLS_MEM_DEBUG, ("mbedtls %s region full for %d bytes, using the heap\n",
+                                            arena == &state->handshake_arena ? "handshake" : "session", (int)(c * len)));
+#if ALTCP_MBEDTLS_MEM_STATS
+      state->mem_stats.heap_fallbacks++;
+#endif
+    }
+  }
+#endif
   if (hlpr == NULL) {
-    LWIP_DEBUGF(ALTCP_MBEDTLS_MEM_DEBUG, ("mbedtls alloc callback failed for %c * %d bytes", (int)c, (int)len));
-    return NULL;
+    alloc_size = sizeof(altcp_mbedtls_malloc_helper_t) + (c * len);
+    /* check for maximum allocation size, mainly to prevent mem_size_t overflow */
+    if (alloc_size > MEM_SIZE) {
+      LWIP_DEBUGF(ALTCP_MBEDTLS_MEM_DEBUG, ("mbedtls allocation too big: %c * %d bytes vs MEM_SIZE=%d",
+                                            (int)c, (int)len, (int)MEM_SIZE));
+      return NULL;
+    }
+    hlpr = (altcp_mbedtls_malloc_helper_t *)mem_malloc((mem_size_t)alloc_size);
+    if (hlpr == NULL) {
+      LWIP_DEBUGF(ALTCP_MBEDTLS_MEM_DEBUG, ("mbedtls alloc callback failed for %c * %d bytes", (int)c, (int)len));
+      return NULL;
+    }
   }
 #if ALTCP_MBEDTLS_PLATFORM_ALLOC_STATS
   altcp_mbedtls_malloc_stats.allocCnt++;
@@ -131,8 +314,13 @@ tls_malloc(size_t c, size_t len)
   }
   altcp_mbedtls_malloc_stats.totalBytes += c * len;
 #endif
-  hlpr->c = c;
-  hlpr->len = len;
+#if ALTCP_MBEDTLS_MEM_STATS
+  if (state != NULL) {
+    altcp_mbedtls_mem_count(state, c * len);
+  }
+#endif
+  hlpr->state = state;
+  hlpr->len = c * len;
   ret = hlpr + 1;
   /* zeroing the allocated chunk is required by mbedTLS! */
   memset(ret, 0, c * len);
@@ -150,9 +338,26 @@ tls_free(void *ptr)
   hlpr = ((altcp_mbedtls_malloc_helper_t *)ptr) - 1;
 #if ALTCP_MBEDTLS_PLATFORM_ALLOC_STATS
   if (!altcp_mbedtls_malloc_clear_stats) {
-    altcp_mbedtls_malloc_stats.allocedBytes -= hlpr->c * hlpr->len;
+    altcp_mbedtls_malloc_stats.allocedBytes -= hlpr->len;
   }
 #endif
+  if (hlpr->state != NULL) {
+    altcp_mbedtls_state_t *state = hlpr->state;
+#if ALTCP_MBEDTLS_MEM_STATS
+    state->mem_stats.cur_bytes -= (u32_t)hlpr->len;
+#endif
+#if ALTCP_MBEDTLS_MEM_ARENA
+    if (altcp_mbedtls_arena_contains(&state->handshake_arena, hlpr)) {
+      altcp_mbedtls_arena_free(&state->handshake_arena, hlpr);
+      return;
+    }
+    if (altcp_mbedtls_arena_contains(&state->session_arena, hlpr)) {
+      altcp_mbedtls_arena_free(&state->session_arena, hlpr);
+      return;
+    }
+#endif
+    LWIP_UNUSED_ARG(state);
+  }
   mem_free(hlpr);
 }
 #endif /* ALTCP_MBEDTLS_PLATFORM_ALLOC*/
@@ -162,6 +367,14 @@ altcp_mbedtls_mem_init(void)
 {
   /* not much to do here when using the heap */
 
+#if ALTCP_MBEDTLS_MEM_ARENA
+  if (!altcp_mbedtls_arena_pools_initialized) {
+    altcp_mbedtls_arena_pools_initialized = 1;
+    LWIP_MEMPOOL_INIT(ALTCP_TLS_SESSION_ARENA);
+    LWIP_MEMPOOL_INIT(ALTCP_TLS_HANDSHAKE_ARENA);
+  }
+#endif
+
 #if ALTCP_MBEDTLS_PLATFORM_ALLOC
   /* set mbedtls allocation methods */
   mbedtls_platform_set_calloc_free(&tls_malloc, &tls_free);
@@ -174,6 +387,16 @@ altcp_mbedtls_alloc(void *conf)
   altcp_mbedtls_state_t *ret = (altcp_mbedtls_state_t *)mem_calloc(1, sizeof(altcp_mbedtls_state_t));
   if (ret != NULL) {
     ret->conf = conf;
+#if ALTCP_MBEDTLS_MEM_ARENA
+    {
+      void *block = LWIP_MEMPOOL_ALLOC(ALTCP_TLS_SESSION_ARENA);
+      if (block != NULL) {
+        altcp_mbedtls_arena_init(&ret->session_arena, block, ALTCP_MBEDTLS_ARENA_SESSION_SIZE);
+      } else {
+        LWIP_DEBUGF(ALTCP_MBEDTLS_MEM_DEBUG, ("no session region left, connection uses the heap\n"));
+      }
+    }
+#endif
   }
   return ret;
 }
@@ -183,9 +406,89 @@ altcp_mbedtls_free(void *conf, altcp_mbedtls_state_t *state)
 {
   LWIP_UNUSED_ARG(conf);
   LWIP_ASSERT("state != NULL", state != NULL);
+  altcp_mbedtls_mem_release(state);
   mem_free(state);
 }
 
+#if ALTCP_MBEDTLS_MEM_ARENA || ALTCP_MBEDTLS_MEM_STATS
+/** Attribute the following mbedTLS allocations to a connection, returns the
+ * connection to pass to altcp_mbedtls_mem_leave() */
+altcp_mbedtls_state_t *
+altcp_mbedtls_mem_enter(altcp_mbedtls_state_t *state, u8_t scope)
+{
+  altcp_mbedtls_state_t *prev = altcp_mbedtls_mem_current;
+
+  state->mem_scope = scope;
+#if ALTCP_MBEDTLS_MEM_ARENA
+  if ((scope == MBEDTLS_SSL_ALLOC_SCOPE_HANDSHAKE) && (state->handshake_arena.block == NULL) &&
+      !(state->flags & ALTCP_MBEDTLS_FLAGS_HANDSHAKE_DONE)) {
+    void *block = LWIP_MEMPOOL_ALLOC(ALTCP_TLS_HANDSHAKE_ARENA);
+    if (block != NULL) {
+      altcp_mbedtls_arena_init(&state->handshake_arena, block, ALTCP_MBEDTLS_ARENA_HANDSHAKE_SIZE);
+    }
+  }
+#endif
+  altcp_mbedtls_mem_current = state;
+  altcp_mbedtls_mem_thread = ALTCP_MBEDTLS_MEM_THREAD_ID();
+  return prev;
+}
+
+void
+altcp_mbedtls_mem_leave(altcp_mbedtls_state_t *prev)
+{
+  altcp_mbedtls_mem_current = prev;
+}
+
+/** mbedTLS allocation scope callback (see mbedtls_ssl_conf_alloc_scope()) */
+void
+altcp_mbedtls_mem_scope(void *arg, mbedtls_ssl_context *ssl, int scope)
+{
+  altcp_mbedtls_state_t *state = altcp_mbedtls_mem_current;
+  LWIP_UNUSED_ARG(arg);
+
+  if ((state != NULL) && (&state->ssl_context == ssl)) {
+    state->mem_scope = (u8_t)scope;
+  }
+}
+
+/** The handshake is over: give the handshake region back */
+void
+altcp_mbedtls_mem_handshake_done(altcp_mbedtls_state_t *state)
+{
+  state->mem_scope = MBEDTLS_SSL_ALLOC_SCOPE_SESSION;
+#if ALTCP_MBEDTLS_MEM_ARENA
+  if (state->handshake_arena.block != NULL) {
+    if (state->handshake_arena.used == 0) {
+      altcp_mbedtls_arena_release(&state->handshake_arena, &memp_ALTCP_TLS_HANDSHAKE_ARENA);
+    } else {
+      /* something allocated during the handshake is still in use: keep the
+         region until the connection is freed */
+      LWIP_DEBUGF(ALTCP_MBEDTLS_MEM_DEBUG, ("%d bytes left in handshake region\n",
+                                            (int)state->handshake_arena.used));
+#if ALTCP_MBEDTLS_MEM_STATS
+      state->mem_stats.handshake_leftover = (u32_t)state->handshake_arena.used;
+#endif
+    }
+  }
+#endif
+}
+
+/** Free the regions of a connection (mbedTLS context freed) */
+void
+altcp_mbedtls_mem_release(altcp_mbedtls_state_t *state)
+{
+#if ALTCP_MBEDTLS_MEM_ARENA
+  LWIP_ASSERT("mbedTLS memory left in session region", state->session_arena.used == 0);
+  LWIP_ASSERT("mbedTLS memory left in handshake region", state->handshake_arena.used == 0);
+  altcp_mbedtls_arena_release(&state->session_arena, &memp_ALTCP_TLS_SESSION_ARENA);
+  altcp_mbedtls_arena_release(&state->handshake_arena, &memp_ALTCP_TLS_HANDSHAKE_ARENA);
+#else
+  LWIP_UNUSED_ARG(state);
+#endif
+}
+
+#endif /* ALTCP_MBEDTLS_MEM_ARENA || ALTCP_MBEDTLS_MEM_STATS */
+
 void *
 altcp_mbedtls_alloc_config(size_t size)
 {
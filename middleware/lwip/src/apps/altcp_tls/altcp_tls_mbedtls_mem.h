@@ -63,6 +63,19 @@ void altcp_mbedtls_free(void *conf, altcp_mbedtls_state_t *state);
 void *altcp_mbedtls_alloc_config(size_t size);
 void altcp_mbedtls_free_config(void *item);
 
+#if ALTCP_MBEDTLS_MEM_ARENA || ALTCP_MBEDTLS_MEM_STATS
+altcp_mbedtls_state_t *altcp_mbedtls_mem_enter(altcp_mbedtls_state_t *state, u8_t scope);
+void altcp_mbedtls_mem_leave(altcp_mbedtls_state_t *prev);
+void altcp_mbedtls_mem_scope(void *arg, mbedtls_ssl_context *ssl, int scope);
+void altcp_mbedtls_mem_handshake_done(altcp_mbedtls_state_t *state);
+void altcp_mbedtls_mem_release(altcp_mbedtls_state_t *state);
+#else
+#define altcp_mbedtls_mem_enter(state, scope)   NULL
+#define altcp_mbedtls_mem_leave(prev)           LWIP_UNUSED_ARG(prev)
+#define altcp_mbedtls_mem_handshake_done(state)
+#define altcp_mbedtls_mem_release(state)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -48,6 +48,7 @@
 #if LWIP_ALTCP_TLS && LWIP_ALTCP_TLS_MBEDTLS
 
 #include "lwip/altcp.h"
+#include "lwip/altcp_tls.h"
 #include "lwip/pbuf.h"
 
 #include "mbedtls/ssl.h"
@@ -60,6 +61,23 @@ extern "C" {
 #define ALTCP_MBEDTLS_FLAGS_UPPER_CALLED      0x02
 #define ALTCP_MBEDTLS_FLAGS_RX_CLOSE_QUEUED   0x04
 #define ALTCP_MBEDTLS_FLAGS_RX_CLOSED         0x08
+#define ALTCP_MBEDTLS_FLAGS_STEP_PENDING      0x10
+
+#if ALTCP_MBEDTLS_MEM_ARENA
+/** Region of a connection mbedTLS allocations are taken from */
+struct altcp_mbedtls_arena {
+  /* memp element, NULL if the region is not allocated */
+  void *block;
+  /* usable memory */
+  u8_t *mem;
+  u8_t *end;
+  /* free blocks, sorted by address */
+  void *free_list;
+  /* bytes in use (including block headers) and their maximum */
+  size_t used;
+  size_t peak;
+};
+#endif
 
 typedef struct altcp_mbedtls_state_s {
   void *conf;
@@ -72,6 +90,21 @@ typedef struct altcp_mbedtls_state_s {
   int bio_bytes_read;
   int bio_bytes_appl;
   int overhead_bytes_adjust;
+#if ALTCP_MBEDTLS_HANDSHAKE_STATS
+  u32_t hs_start_us;
+  struct altcp_tls_handshake_stats hs_stats;
+#endif
+#if ALTCP_MBEDTLS_MEM_ARENA || ALTCP_MBEDTLS_MEM_STATS
+  /* MBEDTLS_SSL_ALLOC_SCOPE_* of the current allocations */
+  u8_t mem_scope;
+#endif
+#if ALTCP_MBEDTLS_MEM_ARENA
+  struct altcp_mbedtls_arena session_arena;
+  struct altcp_mbedtls_arena handshake_arena;
+#endif
+#if ALTCP_MBEDTLS_MEM_STATS
+  struct altcp_tls_mem_stats mem_stats;
+#endif
 } altcp_mbedtls_state_t;
 
 #ifdef __cplusplus
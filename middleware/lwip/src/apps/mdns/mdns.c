@@ -1130,8 +1130,8 @@ mdns_parse_pkt_known_answers(struct netif *netif, struct mdns_packet *pkt,
   while (pkt->answers_left) {
     struct mdns_answer ans;
     u8_t rev_v6;
-    int match;
-    u32_t rr_ttl = MDNS_TTL_120;
+    int known, match;
+    u32_t rr_ttl;
 
     res = mdns_read_answer(pkt, &ans, &pkt->answers_left);
     if (res != ERR_OK) {
@@ -1150,13 +1150,15 @@ mdns_parse_pkt_known_answers(struct netif *netif, struct mdns_packet *pkt,
     }
 
     rev_v6 = 0;
-    match = reply->host_replies & check_host(netif, &ans.info, &rev_v6);
-    if (match && (ans.ttl > (rr_ttl / 2))) {
-      /* The RR in the known answer matches an RR we are planning to send,
-       * and the TTL is less than half gone.
-       * If the payload matches we should not send that answer.
+    known = check_host(netif, &ans.info, &rev_v6);
+    match = reply->host_replies & known;
+    if (known && (ans.ttl > (MDNS_TTL_120 / 2))) {
+      /* The RR in the known answer matches one of our RRs, and the TTL is
+       * less than half gone.
+       * If the payload matches we should not send that answer, neither in
+       * the answer section nor as additional record.
        */
-      if (ans.info.type == DNS_RRTYPE_PTR) {
+      if (match && ans.info.type == DNS_RRTYPE_PTR) {
         /* Read domain and compare */
         struct mdns_domain known_ans, my_ans;
         u16_t len;
@@ -1179,20 +1181,32 @@ mdns_parse_pkt_known_answers(struct netif *netif, struct mdns_packet *pkt,
           }
 #endif
         }
-      } else if (match & REPLY_HOST_A) {
+      } else if (known & REPLY_HOST_A) {
 #if LWIP_IPV4
         if (ans.rd_length == sizeof(ip4_addr_t) &&
             pbuf_memcmp(pkt->pbuf, ans.rd_offset, netif_ip4_addr(netif), ans.rd_length) == 0) {
           LWIP_DEBUGF(MDNS_DEBUG, ("MDNS: Skipping known answer: A\n"));
           reply->host_replies &= ~REPLY_HOST_A;
+          reply->host_known |= REPLY_HOST_A;
         }
 #endif
-      } else if (match & REPLY_HOST_AAAA) {
+      } else if (known & REPLY_HOST_AAAA) {
 #if LWIP_IPV6
-        if (ans.rd_length == sizeof(ip6_addr_p_t) &&
-            /* TODO this clears all AAAA responses if first addr is set as known */
-            pbuf_memcmp(pkt->pbuf, ans.rd_offset, netif_ip6_addr(netif, 0), ans.rd_length) == 0) {
-          LWIP_DEBUGF(MDNS_DEBUG, ("MDNS: Skipping known answer: AAAA\n"));
+        u8_t valid = 0;
+        int addrindex;
+        for (addrindex = 0; addrindex < LWIP_IPV6_NUM_ADDRESSES; addrindex++) {
+          if (!ip6_addr_isvalid(netif_ip6_addr_state(netif, addrindex))) {
+            continue;
+          }
+          valid |= (1 << addrindex);
+          if (ans.rd_length == sizeof(ip6_addr_p_t) &&
+              pbuf_memcmp(pkt->pbuf, ans.rd_offset, netif_ip6_addr(netif, addrindex), ans.rd_length) == 0) {
+            LWIP_DEBUGF(MDNS_DEBUG, ("MDNS: Skipping known answer: AAAA %d\n", addrindex));
+            reply->host_known_aaaa |= (1 << addrindex);
+          }
+        }
+        /* Only drop the AAAA answer once all our addresses are known */
+        if ((reply->host_known_aaaa & valid) == valid) {
           reply->host_replies &= ~REPLY_HOST_AAAA;
         }
 #endif
@@ -1204,16 +1218,16 @@ mdns_parse_pkt_known_answers(struct netif *netif, struct mdns_packet *pkt,
       if (!service) {
         continue;
       }
-      match = reply->serv_replies[i] & check_service(service, &ans.info);
-      if (match & REPLY_SERVICE_TYPE_PTR) {
-        rr_ttl = MDNS_TTL_4500;
-      }
-      if (match && (ans.ttl > (rr_ttl / 2))) {
-        /* The RR in the known answer matches an RR we are planning to send,
-         * and the TTL is less than half gone.
-         * If the payload matches we should not send that answer.
+      known = check_service(service, &ans.info);
+      match = reply->serv_replies[i] & known;
+      rr_ttl = (match & REPLY_SERVICE_TYPE_PTR) ? MDNS_TTL_4500 : MDNS_TTL_120;
+      if (known && (ans.ttl > (rr_ttl / 2))) {
+        /* The RR in the known answer matches one of our RRs, and the TTL is
+         * less than half gone.
+         * If the payload matches we should not send that answer, neither in
+         * the answer section nor as additional record.
          */
-        if (ans.info.type == DNS_RRTYPE_PTR) {
+        if (match && ans.info.type == DNS_RRTYPE_PTR) {
           /* Read domain and compare */
           struct mdns_domain known_ans, my_ans;
           u16_t len;
@@ -1234,7 +1248,7 @@ mdns_parse_pkt_known_answers(struct netif *netif, struct mdns_packet *pkt,
               }
             }
           }
-        } else if (match & REPLY_SERVICE_SRV) {
+        } else if (known & REPLY_SERVICE_SRV) {
           /* Read and compare to my SRV record */
           u16_t field16, len, read_pos;
           struct mdns_domain known_ans, my_ans;
@@ -1266,13 +1280,15 @@ mdns_parse_pkt_known_answers(struct netif *netif, struct mdns_packet *pkt,
             }
             LWIP_DEBUGF(MDNS_DEBUG, ("MDNS: Skipping known answer: SRV\n"));
             reply->serv_replies[i] &= ~REPLY_SERVICE_SRV;
+            reply->serv_known[i] |= REPLY_SERVICE_SRV;
           } while (0);
-        } else if (match & REPLY_SERVICE_TXT) {
+        } else if (known & REPLY_SERVICE_TXT) {
           mdns_prepare_txtdata(service);
           if (service->txtdata.length == ans.rd_length &&
               pbuf_memcmp(pkt->pbuf, ans.rd_offset, service->txtdata.name, ans.rd_length) == 0) {
             LWIP_DEBUGF(MDNS_DEBUG, ("MDNS: Skipping known answer: TXT\n"));
             reply->serv_replies[i] &= ~REPLY_SERVICE_TXT;
+            reply->serv_known[i] |= REPLY_SERVICE_TXT;
           }
         }
       }
@@ -1355,6 +1371,25 @@ static void
 mdns_add_msg_to_delayed(struct mdns_outmsg *dest, struct mdns_outmsg *src)
 {
   int i;
+  int empty = !dest->host_replies;
+
+  for (i = 0; i < MDNS_MAX_SERVICES; i++) {
+    if (dest->serv_replies[i]) {
+      empty = 0;
+    }
+  }
+  /* A record may only be left out if every querier that is answered by this
+   * message knows it. */
+  if (empty) {
+    dest->host_known = src->host_known;
+    dest->host_known_aaaa = src->host_known_aaaa;
+  } else {
+    dest->host_known &= src->host_known;
+    dest->host_known_aaaa &= src->host_known_aaaa;
+  }
+  for (i = 0; i < MDNS_MAX_SERVICES; i++) {
+    dest->serv_known[i] = empty ? src->serv_known[i] : (dest->serv_known[i] & src->serv_known[i]);
+  }
 
   dest->host_questions |= src->host_questions;
   dest->host_replies |= src->host_replies;
@@ -1591,8 +1626,12 @@ mdns_handle_question(struct mdns_packet *pkt, struct netif *netif)
 
         mdns_add_msg_to_delayed(&mdns->ipv6.delayed_msg_multicast, &reply);
 
-        mdns_set_timeout(netif, MDNS_RESPONSE_DELAY, mdns_send_multicast_msg_delayed_ipv6,
-                         &mdns->ipv6.multicast_msg_waiting);
+        /* Keep the deadline of an already waiting message, so the answers
+         * are aggregated into one packet instead of postponing it. */
+        if (!mdns->ipv6.multicast_msg_waiting) {
+          mdns_set_timeout(netif, MDNS_RESPONSE_DELAY, mdns_send_multicast_msg_delayed_ipv6,
+                           &mdns->ipv6.multicast_msg_waiting);
+        }
       }
       else if (IP_IS_V6_VAL(pkt->source_addr) && reply.probe_query_recv) {
         LWIP_DEBUGF(MDNS_DEBUG, ("MDNS: add answers to probe multicast IPv6 waiting list\n"));
@@ -1617,8 +1656,12 @@ mdns_handle_question(struct mdns_packet *pkt, struct netif *netif)
 
         mdns_add_msg_to_delayed(&mdns->ipv4.delayed_msg_multicast, &reply);
 
-        mdns_set_timeout(netif, MDNS_RESPONSE_DELAY, mdns_send_multicast_msg_delayed_ipv4,
-                         &mdns->ipv4.multicast_msg_waiting);
+        /* Keep the deadline of an already waiting message, so the answers
+         * are aggregated into one packet instead of postponing it. */
+        if (!mdns->ipv4.multicast_msg_waiting) {
+          mdns_set_timeout(netif, MDNS_RESPONSE_DELAY, mdns_send_multicast_msg_delayed_ipv4,
+                           &mdns->ipv4.multicast_msg_waiting);
+        }
       }
       else if (IP_IS_V4_VAL(pkt->source_addr) && reply.probe_query_recv) {
         LWIP_DEBUGF(MDNS_DEBUG, ("MDNS: add answers to probe multicast IPv4 waiting list\n"));
@@ -1653,6 +1696,12 @@ mdns_handle_question(struct mdns_packet *pkt, struct netif *netif)
           LWIP_DEBUGF(MDNS_DEBUG, ("MDNS: we just multicasted, ignore question\n"));
           return;
         }
+        if (mdns->ipv6.multicast_msg_waiting && !reply.probe_query_recv) {
+          /* A delayed multicast answer is about to go out, add ours to it */
+          LWIP_DEBUGF(MDNS_DEBUG, ("MDNS: add answers to waiting multicast IPv6 message\n"));
+          mdns_add_msg_to_delayed(&mdns->ipv6.delayed_msg_multicast, &reply);
+          return;
+        }
         SMEMCPY(&reply.dest_addr, &v6group, sizeof(ip_addr_t));
       }
 #endif
@@ -1662,6 +1711,12 @@ mdns_handle_question(struct mdns_packet *pkt, struct netif *netif)
           LWIP_DEBUGF(MDNS_DEBUG, ("MDNS: we just multicasted, ignore question\n"));
           return;
         }
+        if (mdns->ipv4.multicast_msg_waiting && !reply.probe_query_recv) {
+          /* A delayed multicast answer is about to go out, add ours to it */
+          LWIP_DEBUGF(MDNS_DEBUG, ("MDNS: add answers to waiting multicast IPv4 message\n"));
+          mdns_add_msg_to_delayed(&mdns->ipv4.delayed_msg_multicast, &reply);
+          return;
+        }
         SMEMCPY(&reply.dest_addr, &v4group, sizeof(ip_addr_t));
       }
 #endif
@@ -1847,6 +1902,28 @@ mdns_handle_response(struct mdns_packet *pkt, struct netif *netif)
     }
 #endif
   }
+
+  /* Duplicate answer suppression (RFC6762 section 7.4): records another
+   * responder just multicast need not be repeated by our waiting message. */
+  {
+    struct mdns_outmsg *delayed = NULL;
+#if LWIP_IPV6
+    if (IP_IS_V6_VAL(pkt->source_addr) && mdns->ipv6.multicast_msg_waiting) {
+      delayed = &mdns->ipv6.delayed_msg_multicast;
+    }
+#endif
+#if LWIP_IPV4
+    if (IP_IS_V4_VAL(pkt->source_addr) && mdns->ipv4.multicast_msg_waiting) {
+      delayed = &mdns->ipv4.delayed_msg_multicast;
+    }
+#endif
+    if (delayed && pkt->answers_left) {
+      struct mdns_packet known_pkt;
+      SMEMCPY(&known_pkt, pkt, sizeof(known_pkt));
+      mdns_parse_pkt_known_answers(netif, &known_pkt, delayed);
+    }
+  }
+
   /* We need to check all resource record sections: answers, authoritative and additional */
   total_answers_left = pkt->answers_left + pkt->authoritative_left + pkt->additional_left;
   while (total_answers_left) {
@@ -2439,6 +2516,9 @@ mdns_resp_remove_netif(struct netif *netif)
       mem_free(service);
     }
   }
+#if MDNS_RESP_CACHE_SIZE
+  mdns_resp_cache_flush(mdns);
+#endif
 
   /* Leave multicast groups */
 #if LWIP_IPV4
@@ -2570,6 +2650,9 @@ mdns_resp_del_service(struct netif *netif, u8_t slot)
   srv = mdns->services[slot];
   mdns->services[slot] = NULL;
   mem_free(srv);
+#if MDNS_RESP_CACHE_SIZE
+  mdns_resp_cache_flush(mdns);
+#endif
   return ERR_OK;
 }
 
@@ -2722,6 +2805,10 @@ mdns_resp_announce(struct netif *netif)
   if (mdns == NULL) {
     return;
   }
+#if MDNS_RESP_CACHE_SIZE
+  /* Called on address changes */
+  mdns_resp_cache_flush(mdns);
+#endif
 
   /* Do not announce if the mdns responder is off, waiting to probe, probing or
    * waiting to announce. */
@@ -2768,6 +2855,10 @@ mdns_resp_restart_delay(struct netif *netif, uint32_t delay)
   }
   /* Make sure timer is not running */
   sys_untimeout(mdns_probe_and_announce, netif);
+#if MDNS_RESP_CACHE_SIZE
+  /* Hostname or services may have changed */
+  mdns_resp_cache_flush(mdns);
+#endif
 
   mdns->sent_num = 0;
   mdns->state = MDNS_STATE_PROBE_WAIT;
@@ -617,7 +617,8 @@ mdns_create_outpacket(struct netif *netif, struct mdns_outmsg *msg,
   if (msg->host_replies & REPLY_HOST_AAAA) {
     int addrindex;
     for (addrindex = 0; addrindex < LWIP_IPV6_NUM_ADDRESSES; addrindex++) {
-      if (ip6_addr_isvalid(netif_ip6_addr_state(netif, addrindex))) {
+      if (ip6_addr_isvalid(netif_ip6_addr_state(netif, addrindex)) &&
+          !(msg->host_known_aaaa & (1 << addrindex))) {
         res = mdns_add_aaaa_answer(outpkt, msg, netif, addrindex);
         if (res != ERR_OK) {
           return res;
@@ -701,7 +702,8 @@ mdns_create_outpacket(struct netif *netif, struct mdns_outmsg *msg,
     if (msg->serv_replies[i] & REPLY_SERVICE_NAME_PTR) {
       /* Our service instance requested, include SRV & TXT
        * if they are already not requested. */
-      if (!(msg->serv_replies[i] & REPLY_SERVICE_SRV)) {
+      if (!(msg->serv_replies[i] & REPLY_SERVICE_SRV) &&
+          !(msg->serv_known[i] & REPLY_SERVICE_SRV)) {
         res = mdns_add_srv_answer(outpkt, msg, mdns, service);
         if (res != ERR_OK) {
           return res;
@@ -709,7 +711,8 @@ mdns_create_outpacket(struct netif *netif, struct mdns_outmsg *msg,
         outpkt->additional++;
       }
 
-      if (!(msg->serv_replies[i] & REPLY_SERVICE_TXT)) {
+      if (!(msg->serv_replies[i] & REPLY_SERVICE_TXT) &&
+          !(msg->serv_known[i] & REPLY_SERVICE_TXT)) {
         res = mdns_add_txt_answer(outpkt, msg, service);
         if (res != ERR_OK) {
           return res;
@@ -727,7 +730,8 @@ mdns_create_outpacket(struct netif *netif, struct mdns_outmsg *msg,
       if (!(msg->host_replies & REPLY_HOST_AAAA)) {
         int addrindex;
         for (addrindex = 0; addrindex < LWIP_IPV6_NUM_ADDRESSES; addrindex++) {
-          if (ip6_addr_isvalid(netif_ip6_addr_state(netif, addrindex))) {
+          if (ip6_addr_isvalid(netif_ip6_addr_state(netif, addrindex)) &&
+              !(msg->host_known_aaaa & (1 << addrindex))) {
             res = mdns_add_aaaa_answer(outpkt, msg, netif, addrindex);
             if (res != ERR_OK) {
               return res;
@@ -739,6 +743,7 @@ mdns_create_outpacket(struct netif *netif, struct mdns_outmsg *msg,
 #endif
 #if LWIP_IPV4
       if (!(msg->host_replies & REPLY_HOST_A) &&
+          !(msg->host_known & REPLY_HOST_A) &&
           !ip4_addr_isany_val(*netif_ip4_addr(netif))) {
         res = mdns_add_a_answer(outpkt, msg, netif);
         if (res != ERR_OK) {
@@ -753,10 +758,159 @@ mdns_create_outpacket(struct netif *netif, struct mdns_outmsg *msg,
   return res;
 }
 
+#if MDNS_RESP_CACHE_SIZE
+/** FNV-1a hash over len bytes of data */
+static u32_t
+mdns_resp_cache_hash(u32_t hash, const void *data, size_t len)
+{
+  const u8_t *p = (const u8_t *)data;
+  while (len--) {
+    hash ^= *p++;
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+/**
+ * Build the cache key for an outgoing message.
+ * Only plain responses can be cached: no questions (probes, searches and
+ * legacy replies repeat the question) and no transaction id.
+ *
+ * @return 1 if the message can be cached, 0 otherwise
+ */
+static int
+mdns_resp_cache_make_key(struct netif *netif, struct mdns_outmsg *msg,
+                         struct mdns_resp_cache_key *key)
+{
+  struct mdns_host *mdns = netif_mdns_data(netif);
+  u32_t hash = 2166136261UL;
+  int i;
+
+  if (!(msg->flags & DNS_FLAG1_RESPONSE) || msg->legacy_query || msg->tx_id ||
+      msg->host_questions) {
+    return 0;
+  }
+#if LWIP_MDNS_SEARCH
+  if (msg->query) {
+    return 0;
+  }
+#endif
+
+  memset(key, 0, sizeof(*key));
+  key->flags = msg->flags;
+  key->cache_flush = msg->cache_flush;
+  key->host_replies = msg->host_replies;
+  key->host_reverse_v6_replies = msg->host_reverse_v6_replies;
+  key->host_known = msg->host_known;
+  key->host_known_aaaa = msg->host_known_aaaa;
+  for (i = 0; i < MDNS_MAX_SERVICES; i++) {
+    if (msg->serv_questions[i]) {
+      return 0;
+    }
+    key->serv_replies[i] = msg->serv_replies[i];
+    key->serv_known[i] = msg->serv_known[i];
+  }
+
+  /* Addresses may change without the responder being told, and TXT data is
+   * produced by a callback, so they are checked on each lookup. */
+#if LWIP_IPV4
+  hash = mdns_resp_cache_hash(hash, netif_ip4_addr(netif), sizeof(ip4_addr_t));
+#endif
+#if LWIP_IPV6
+  for (i = 0; i < LWIP_IPV6_NUM_ADDRESSES; i++) {
+    if (ip6_addr_isvalid(netif_ip6_addr_state(netif, i))) {
+      hash = mdns_resp_cache_hash(hash, &i, sizeof(i));
+      /* the 16 address bytes only, not the zone of LWIP_IPV6_SCOPES */
+      hash = mdns_resp_cache_hash(hash, netif_ip6_addr(netif, i)->addr, sizeof(ip6_addr_p_t));
+    }
+  }
+#endif
+  for (i = 0; i < MDNS_MAX_SERVICES; i++) {
+    struct mdns_service *service = mdns->services[i];
+    if (service && (msg->serv_replies[i] & (REPLY_SERVICE_NAME_PTR | REPLY_SERVICE_TXT))) {
+      mdns_prepare_txtdata(service);
+      hash = mdns_resp_cache_hash(hash, &service->txtdata.length, sizeof(service->txtdata.length));
+      hash = mdns_resp_cache_hash(hash, service->txtdata.name, service->txtdata.length);
+    }
+  }
+  key->state = hash;
+  return 1;
+}
+
+/**
+ * Find the cache entry for key.
+ *
+ * @param mdns The mdns host of the netif
+ * @param key Key of the message to send
+ * @param hit Set to 1 if the entry holds the response, to 0 if the returned
+ *            (least recently used) entry may be replaced by it
+ * @return The cache entry
+ */
+static struct mdns_resp_cache_entry *
+mdns_resp_cache_lookup(struct mdns_host *mdns, const struct mdns_resp_cache_key *key, u8_t *hit)
+{
+  struct mdns_resp_cache_entry *entry;
+  struct mdns_resp_cache_entry *victim = &mdns->cache[0];
+  int i;
+
+  mdns->cache_clock++;
+  for (i = 0; i < MDNS_RESP_CACHE_SIZE; i++) {
+    entry = &mdns->cache[i];
+    if (entry->data && (memcmp(&entry->key, key, sizeof(*key)) == 0)) {
+      entry->last_used = mdns->cache_clock;
+      *hit = 1;
+      return entry;
+    }
+    if (!entry->data) {
+      victim = entry;
+    } else if (victim->data &&
+               (u16_t)(mdns->cache_clock - entry->last_used) > (u16_t)(mdns->cache_clock - victim->last_used)) {
+      victim = entry;
+    }
+  }
+  *hit = 0;
+  return victim;
+}
+
+/**
+ * Drop all cached responses of a host. Called whenever the hostname or the
+ * services change.
+ */
+void
+mdns_resp_cache_flush(struct mdns_host *mdns)
+{
+  int i;
+
+  for (i = 0; i < MDNS_RESP_CACHE_SIZE; i++) {
+    if (mdns->cache[i].data) {
+      mem_free(mdns->cache[i].data);
+      mdns->cache[i].data = NULL;
+    }
+  }
+}
+
+/** Send a copy of a cached response */
+static err_t
+mdns_resp_cache_send(struct mdns_resp_cache_entry *entry, struct mdns_outmsg *msg,
+                     struct netif *netif)
+{
+  err_t res;
+  struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, entry->len, PBUF_RAM);
+  if (p == NULL) {
+    return ERR_MEM;
+  }
+  pbuf_take(p, entry->data, entry->len);
+  LWIP_DEBUGF(MDNS_DEBUG, ("MDNS: Sending cached packet, len=%d\n", entry->len));
+  res = udp_sendto_if(get_mdns_pcb(), p, &msg->dest_addr, msg->dest_port, netif);
+  pbuf_free(p);
+  return res;
+}
+#endif /* MDNS_RESP_CACHE_SIZE */
+
 /**
  * Send chosen answers as a reply
  *
- * Create the packet
+ * Create the packet, or take it from the response cache
  * Send the packet
  */
 err_t
@@ -764,6 +918,20 @@ mdns_send_outpacket(struct mdns_outmsg *msg, struct netif *netif)
 {
   struct mdns_outpacket outpkt;
   err_t res;
+#if MDNS_RESP_CACHE_SIZE
+  struct mdns_host *mdns = netif_mdns_data(netif);
+  struct mdns_resp_cache_entry *entry = NULL;
+  struct mdns_resp_cache_key key;
+  u8_t hit = 0;
+
+  if (mdns_resp_cache_make_key(netif, msg, &key)) {
+    entry = mdns_resp_cache_lookup(mdns, &key, &hit);
+    if (hit) {
+      mdns->cache_hits++;
+      return mdns_resp_cache_send(entry, msg, netif);
+    }
+  }
+#endif
 
   memset(&outpkt, 0, sizeof(outpkt));
 
@@ -788,6 +956,23 @@ mdns_send_outpacket(struct mdns_outmsg *msg, struct netif *netif)
     /* Shrink packet */
     pbuf_realloc(outpkt.pbuf, outpkt.write_offset);
 
+#if MDNS_RESP_CACHE_SIZE
+    if (entry != NULL) {
+      /* Keep the encoded packet for the next identical response */
+      if (entry->data) {
+        mem_free(entry->data);
+      }
+      entry->data = (u8_t *)mem_malloc(outpkt.write_offset);
+      if (entry->data) {
+        pbuf_copy_partial(outpkt.pbuf, entry->data, outpkt.write_offset, 0);
+        entry->len = outpkt.write_offset;
+        entry->key = key;
+        entry->last_used = mdns->cache_clock;
+        mdns->cache_misses++;
+      }
+    }
+#endif
+
     /* Send created packet */
     LWIP_DEBUGF(MDNS_DEBUG, ("MDNS: Sending packet, len=%d\n",
                 outpkt.write_offset));
@@ -883,6 +1068,8 @@ mdns_send_multicast_msg_delayed_ipv4(void *arg)
   res = mdns_send_outpacket(&mdns->ipv4.delayed_msg_multicast, netif);
   if(res != ERR_OK) {
     LWIP_DEBUGF(MDNS_DEBUG, ("MDNS: Delayed multicast send failed - IPv4\n"));
+    /* Let the next question restart the timer */
+    mdns->ipv4.multicast_msg_waiting = 0;
   }
   else {
     LWIP_DEBUGF(MDNS_DEBUG, ("MDNS: Delayed multicast send successful - IPv4\n"));
@@ -1020,6 +1207,8 @@ mdns_send_multicast_msg_delayed_ipv6(void *arg)
   res = mdns_send_outpacket(&mdns->ipv6.delayed_msg_multicast, netif);
   if(res != ERR_OK) {
     LWIP_DEBUGF(MDNS_DEBUG, ("MDNS: Delayed multicast send failed - IPv6\n"));
+    /* Let the next question restart the timer */
+    mdns->ipv6.multicast_msg_waiting = 0;
   }
   else {
     LWIP_DEBUGF(MDNS_DEBUG, ("MDNS: Delayed multicast send successful - IPv6\n"));
@@ -1098,10 +1287,13 @@ mdns_clear_outmsg(struct mdns_outmsg *outmsg)
   outmsg->host_questions = 0;
   outmsg->host_replies = 0;
   outmsg->host_reverse_v6_replies = 0;
+  outmsg->host_known = 0;
+  outmsg->host_known_aaaa = 0;
 
   for(i = 0; i < MDNS_MAX_SERVICES; i++) {
     outmsg->serv_questions[i] = 0;
     outmsg->serv_replies[i] = 0;
+    outmsg->serv_known[i] = 0;
   }
 }
 
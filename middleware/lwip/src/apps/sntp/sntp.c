@@ -52,6 +52,7 @@
  */
 
 #include "lwip/apps/sntp.h"
+#include "lwip/apps/sntp_clock.h"
 
 #include "lwip/opt.h"
 #include "lwip/timeouts.h"
@@ -148,6 +149,10 @@
  * avoid special values like 0, and to mask round-off errors that would
  * otherwise break round-trip conversion identity.
  */
+#if SNTP_CLOCK_DISCIPLINE
+# undef SNTP_GET_SYSTEM_TIME
+# define SNTP_GET_SYSTEM_TIME(sec, us) sntp_clock_get_time(&(sec), &(us))
+#endif /* SNTP_CLOCK_DISCIPLINE */
 #ifndef SNTP_GET_SYSTEM_TIME_NTP
 # define SNTP_GET_SYSTEM_TIME_NTP(s, f) do { \
     u32_t sec_, usec_; \
@@ -172,6 +177,14 @@
     SNTP_SEC_FRAC_TO_S64(lwip_ntohl((t).sec), lwip_ntohl((t).frac))
 #endif /* SNTP_COMP_ROUNDTRIP */
 
+#if SNTP_CLOCK_DISCIPLINE
+/* NTP timestamp (seconds relative to epoch 1, fraction) to microseconds since 1970 */
+# define SNTP_SEC_FRAC_TO_US(s, f) \
+    ((((s64_t)(s32_t)(s) + DIFF_SEC_1970_2036) * 1000000) + SNTP_FRAC_TO_US(f))
+# define SNTP_TIMESTAMP_TO_US(t) \
+    SNTP_SEC_FRAC_TO_US(lwip_ntohl((t).sec), lwip_ntohl((t).frac))
+#endif /* SNTP_CLOCK_DISCIPLINE */
+
 /**
  * 64-bit NTP timestamp, in network byte order.
  */
@@ -184,7 +197,7 @@ struct sntp_time {
  * Timestamps to be extracted from the NTP header.
  */
 struct sntp_timestamps {
-#if SNTP_COMP_ROUNDTRIP || SNTP_CHECK_RESPONSE >= 2
+#if SNTP_COMP_ROUNDTRIP || SNTP_CHECK_RESPONSE >= 2 || SNTP_CLOCK_DISCIPLINE
   struct sntp_time orig;
   struct sntp_time recv;
 #endif
@@ -284,6 +297,25 @@ sntp_format_time(s32_t sec)
 }
 #endif /* LWIP_DEBUG && !sntp_format_time */
 
+#if SNTP_CLOCK_DISCIPLINE
+/**
+ * Pass the disciplined time to SNTP_SET_SYSTEM_TIME, on the first sync and
+ * on each step: users of the system time keep getting it, while the small
+ * corrections are slewed by the clock only.
+ */
+static void
+sntp_set_system_time_from_clock(void)
+{
+  s32_t sec;
+  u32_t frac;
+
+  SNTP_GET_SYSTEM_TIME_NTP(sec, frac);
+  SNTP_SET_SYSTEM_TIME_NTP(sec, frac);
+  LWIP_UNUSED_ARG(frac); /* might be unused if only seconds are set */
+  LWIP_DEBUGF(SNTP_DEBUG_TRACE, ("sntp_process: stepped to %s\n", sntp_format_time(sec)));
+}
+#endif /* SNTP_CLOCK_DISCIPLINE */
+
 /**
  * SNTP processing of received timestamp
  */
@@ -293,6 +325,41 @@ sntp_process(const struct sntp_timestamps *timestamps)
   s32_t sec;
   u32_t frac;
 
+#if SNTP_CLOCK_DISCIPLINE
+  if (sntp_opmode == SNTP_OPMODE_POLL) {
+    s32_t dest_sec;
+    u32_t dest_frac;
+    s64_t t1, t2, t3, t4;
+
+    SNTP_GET_SYSTEM_TIME_NTP(dest_sec, dest_frac);
+    t4 = SNTP_SEC_FRAC_TO_US(dest_sec, dest_frac);
+    t3 = SNTP_TIMESTAMP_TO_US(timestamps->xmit);
+    t1 = SNTP_TIMESTAMP_TO_US(timestamps->orig);
+    if (timestamps->recv.sec != 0 || timestamps->recv.frac != 0) {
+      t2 = SNTP_TIMESTAMP_TO_US(timestamps->recv);
+    } else {
+      t2 = t3;
+    }
+    if (sntp_clock_sample(t1, t2, t3, t4)) {
+      sntp_set_system_time_from_clock();
+    }
+    LWIP_DEBUGF(SNTP_DEBUG_TRACE, ("sntp_process: offset %" S32_F " us\n",
+                                   (s32_t)(((t2 - t1) + (t3 - t4)) / 2)));
+    return;
+  }
+  /* broadcast mode: no round trip, step to the server time */
+  sec  = (s32_t)lwip_ntohl(timestamps->xmit.sec);
+  frac = lwip_ntohl(timestamps->xmit.frac);
+  {
+    s64_t now = sntp_clock_get_time_us();
+    s64_t t3 = SNTP_SEC_FRAC_TO_US(sec, frac);
+    if (sntp_clock_sample(now, t3, t3, now)) {
+      sntp_set_system_time_from_clock();
+    }
+  }
+  return;
+#endif /* SNTP_CLOCK_DISCIPLINE */
+
   sec  = (s32_t)lwip_ntohl(timestamps->xmit.sec);
   frac = lwip_ntohl(timestamps->xmit.frac);
 
@@ -343,7 +410,7 @@ sntp_initialize_request(struct sntp_msg *req)
   memset(req, 0, SNTP_MSG_LEN);
   req->li_vn_mode = SNTP_LI_NO_WARNING | SNTP_VERSION | SNTP_MODE_CLIENT;
 
-#if SNTP_CHECK_RESPONSE >= 2 || SNTP_COMP_ROUNDTRIP
+#if SNTP_CHECK_RESPONSE >= 2 || SNTP_COMP_ROUNDTRIP || SNTP_CLOCK_DISCIPLINE
   {
     s32_t secs;
     u32_t sec, frac;
@@ -359,7 +426,7 @@ sntp_initialize_request(struct sntp_msg *req)
     req->transmit_timestamp[0] = sec;
     req->transmit_timestamp[1] = frac;
   }
-#endif /* SNTP_CHECK_RESPONSE >= 2 || SNTP_COMP_ROUNDTRIP */
+#endif /* SNTP_CHECK_RESPONSE >= 2 || SNTP_COMP_ROUNDTRIP || SNTP_CLOCK_DISCIPLINE */
 }
 
 /**
@@ -537,7 +604,11 @@ sntp_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p, const ip_addr_t *addr,
       /* Correct response, reset retry timeout */
       SNTP_RESET_RETRY_TIMEOUT();
 
+#if SNTP_CLOCK_DISCIPLINE
+      sntp_update_delay = sntp_clock_poll_interval();
+#else
       sntp_update_delay = (u32_t)SNTP_UPDATE_DELAY;
+#endif
       sys_timeout(sntp_update_delay, sntp_request, NULL);
       LWIP_DEBUGF(SNTP_DEBUG_STATE, ("sntp_recv: Scheduled next time request: %"U32_F" ms\n",
                                      sntp_update_delay));
@@ -674,6 +745,10 @@ sntp_init(void)
   /* LWIP_ASSERT_CORE_LOCKED(); is checked by udp_new() */
   LWIP_DEBUGF(SNTP_DEBUG_TRACE, ("sntp_init: SNTP initialised\n"));
 
+#if SNTP_CLOCK_DISCIPLINE
+  sntp_clock_init();
+#endif
+
 #ifdef SNTP_SERVER_ADDRESS
 #if SNTP_SERVER_DNS
   sntp_setservername(0, SNTP_SERVER_ADDRESS);
@@ -0,0 +1,488 @@
+/**
+ * @file
+ * SNTP disciplined clock
+ */
+
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @defgroup sntp_clock Disciplined clock
+ * @ingroup sntp
+ *
+ * Software wall clock that is disciplined by the SNTP client when
+ * SNTP_CLOCK_DISCIPLINE is enabled.
+ *
+ * The clock runs on the free running local time base SNTP_CLOCK_GET_LOCAL_US():
+ *   wall = anchor_wall + elapsed + elapsed * freq + slew
+ * - freq is the frequency error of the local oscillator, estimated from the
+ *   raw offsets (server time - local time base) of the last
+ *   SNTP_CLOCK_FILTER_SIZE samples. A sample that is off the line through
+ *   them by more than SNTP_CLOCK_POLL_GATE_US (a phase jump of the server or
+ *   time base) restarts the history instead of bending the estimate.
+ * - Offsets below SNTP_CLOCK_STEP_THRESHOLD_US are slewed out at no more than
+ *   SNTP_CLOCK_SLEW_PPM, so the clock never goes backwards. Larger offsets
+ *   (and the first sample) step the clock.
+ * - Samples with a much larger round-trip delay than the recent minimum are
+ *   dropped, as the offset of a delayed packet is unreliable.
+ * - The poll interval doubles after 4 samples in a row that were in sync and
+ *   halves on each one that was not.
+ *
+ * The state is protected by SYS_ARCH_PROTECT, so the time can be read from
+ * any thread.
+ */
+
+#include "lwip/apps/sntp_clock.h"
+
+#include "lwip/def.h"
+#include "lwip/sys.h"
+#include "lwip/timeouts.h"
+
+#include <string.h>
+
+#if LWIP_UDP && SNTP_CLOCK_DISCIPLINE
+
+#if !LWIP_HAVE_INT64
+#error "SNTP clock discipline requires 64-bit arithmetic"
+#endif
+
+#if (SNTP_CLOCK_POLL_MIN < 4) || (SNTP_CLOCK_POLL_MAX < SNTP_CLOCK_POLL_MIN) || (SNTP_CLOCK_POLL_MAX > 17)
+#error "SNTP_CLOCK_POLL_MIN/MAX out of range (16 seconds .. 36 hours)"
+#endif
+
+/** Read the local time base at least this often (ms) to extend it to 64 bits,
+ * and rebase the clock so the elapsed time stays small */
+#define SNTP_CLOCK_HOUSEKEEPING_MS  600000UL
+
+/** Samples in sync needed to double the poll interval */
+#define SNTP_CLOCK_POLL_HYSTERESIS  4
+
+/** Number of consecutive high-delay samples that are dropped before the
+ * filter accepts the new delay (the path may really have changed) */
+#define SNTP_CLOCK_MAX_REJECTS      2
+
+/** Microseconds of delay a sample may exceed twice the minimum delay by */
+#define SNTP_CLOCK_DELAY_SLACK_US   20000
+
+struct sntp_clock_sample_entry {
+  /** Local time base at the sample */
+  u64_t local;
+  /** Server time - local time base */
+  s64_t raw_offset;
+  /** Round-trip delay */
+  u32_t delay;
+};
+
+struct sntp_clock_state {
+  /* Local time base extension */
+  u32_t last_raw;
+  u64_t local;
+  /* Clock model */
+  u64_t anchor_local;
+  s64_t anchor_wall;
+  s64_t slew;
+  s64_t last_wall;
+  s32_t freq;
+  /* Sample history (ring) */
+  struct sntp_clock_sample_entry filter[SNTP_CLOCK_FILTER_SIZE];
+  u8_t filter_next;
+  u8_t filter_count;
+  u8_t rejects;
+  /* Poll interval adaption */
+  u8_t poll;
+  u8_t poll_count;
+  u8_t initialized;
+  struct sntp_clock_stats stats;
+};
+
+static struct sntp_clock_state sntp_clock;
+
+static s64_t
+sntp_clock_abs(s64_t v)
+{
+  return (v < 0) ? -v : v;
+}
+
+/** v * ppb / 10^9, split to stay clear of overflow */
+static s64_t
+sntp_clock_scale(s64_t v, s32_t ppb)
+{
+  return (v / 1000000) * ppb / 1000 + ((v % 1000000) * ppb) / 1000000000;
+}
+
+/** Extend the local time base to 64 bits. Protection must be held. */
+static u64_t
+sntp_clock_local_locked(void)
+{
+  u32_t raw = (u32_t)SNTP_CLOCK_GET_LOCAL_US();
+  sntp_clock.local += (u32_t)(raw - sntp_clock.last_raw);
+  sntp_clock.last_raw = raw;
+  return sntp_clock.local;
+}
+
+/** Wall clock at the given local time, without the monotonic guard. */
+static s64_t
+sntp_clock_wall_at(u64_t local, s64_t *slewed)
+{
+  s64_t elapsed = (s64_t)(local - sntp_clock.anchor_local);
+  s64_t corr, max_slew;
+
+  corr = sntp_clock_scale(elapsed, sntp_clock.freq);
+
+  max_slew = (elapsed * SNTP_CLOCK_SLEW_PPM) / 1000000;
+  if (sntp_clock.slew >= 0) {
+    *slewed = LWIP_MIN(sntp_clock.slew, max_slew);
+  } else {
+    *slewed = -LWIP_MIN(-sntp_clock.slew, max_slew);
+  }
+  return sntp_clock.anchor_wall + elapsed + corr + *slewed;
+}
+
+/** Wall clock now, never going backwards unless stepped. Protection must be held. */
+static s64_t
+sntp_clock_now_locked(u64_t *local_out)
+{
+  s64_t slewed;
+  u64_t local = sntp_clock_local_locked();
+  s64_t wall = sntp_clock_wall_at(local, &slewed);
+
+  if (wall < sntp_clock.last_wall) {
+    wall = sntp_clock.last_wall;
+  }
+  sntp_clock.last_wall = wall;
+  if (local_out != NULL) {
+    *local_out = local;
+  }
+  return wall;
+}
+
+/** Move the anchor to now, keeping the wall clock continuous. Protection must be held. */
+static s64_t
+sntp_clock_rebase_locked(u64_t *local_out)
+{
+  s64_t slewed;
+  u64_t local = sntp_clock_local_locked();
+  s64_t wall = sntp_clock_wall_at(local, &slewed);
+
+  sntp_clock.slew -= slewed;
+  sntp_clock.anchor_local = local;
+  sntp_clock.anchor_wall = LWIP_MAX(wall, sntp_clock.last_wall);
+  sntp_clock.last_wall = sntp_clock.anchor_wall;
+  if (local_out != NULL) {
+    *local_out = local;
+  }
+  return sntp_clock.anchor_wall;
+}
+
+static void
+sntp_clock_housekeeping(void *arg)
+{
+  SYS_ARCH_DECL_PROTECT(lev);
+  LWIP_UNUSED_ARG(arg);
+
+  SYS_ARCH_PROTECT(lev);
+  sntp_clock_rebase_locked(NULL);
+  SYS_ARCH_UNPROTECT(lev);
+
+  sys_timeout(SNTP_CLOCK_HOUSEKEEPING_MS, sntp_clock_housekeeping, NULL);
+}
+
+/**
+ * @ingroup sntp_clock
+ * Initialize the clock and start its housekeeping timer. Called by
+ * sntp_init(), does nothing if the clock is running already.
+ */
+void
+sntp_clock_init(void)
+{
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  if (sntp_clock.initialized) {
+    return;
+  }
+  SYS_ARCH_PROTECT(lev);
+  sntp_clock.last_raw = (u32_t)SNTP_CLOCK_GET_LOCAL_US();
+  sntp_clock.stats.poll = SNTP_CLOCK_POLL_MIN;
+  sntp_clock.poll = SNTP_CLOCK_POLL_MIN;
+  sntp_clock.initialized = 1;
+  SYS_ARCH_UNPROTECT(lev);
+
+  sys_timeout(SNTP_CLOCK_HOUSEKEEPING_MS, sntp_clock_housekeeping, NULL);
+}
+
+/**
+ * @ingroup sntp_clock
+ * Forget the synchronization state (e.g. after the time base was changed).
+ * The clock keeps running, the next sample steps it again.
+ */
+void
+sntp_clock_reset(void)
+{
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  SYS_ARCH_PROTECT(lev);
+  sntp_clock_rebase_locked(NULL);
+  sntp_clock.slew = 0;
+  sntp_clock.freq = 0;
+  sntp_clock.filter_next = 0;
+  sntp_clock.filter_count = 0;
+  sntp_clock.rejects = 0;
+  sntp_clock.poll = SNTP_CLOCK_POLL_MIN;
+  sntp_clock.poll_count = 0;
+  memset(&sntp_clock.stats, 0, sizeof(sntp_clock.stats));
+  sntp_clock.stats.poll = SNTP_CLOCK_POLL_MIN;
+  SYS_ARCH_UNPROTECT(lev);
+}
+
+/**
+ * @ingroup sntp_clock
+ * Check if the clock has been set from a server.
+ */
+u8_t
+sntp_clock_synced(void)
+{
+  return sntp_clock.stats.synced;
+}
+
+/**
+ * @ingroup sntp_clock
+ * Current wall clock time in microseconds since 1970. Until the first
+ * sample was applied, this counts from 0 at startup.
+ */
+s64_t
+sntp_clock_get_time_us(void)
+{
+  s64_t now;
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  SYS_ARCH_PROTECT(lev);
+  now = sntp_clock_now_locked(NULL);
+  SYS_ARCH_UNPROTECT(lev);
+  return now;
+}
+
+/**
+ * @ingroup sntp_clock
+ * Current wall clock time as seconds and microseconds since 1970.
+ */
+void
+sntp_clock_get_time(u32_t *sec, u32_t *us)
+{
+  s64_t now = sntp_clock_get_time_us();
+  *sec = (u32_t)(now / 1000000);
+  *us = (u32_t)(now % 1000000);
+}
+
+/**
+ * @ingroup sntp_clock
+ * Local time base in microseconds, extended to 64 bits. This is never
+ * adjusted and suited to measure intervals.
+ */
+u64_t
+sntp_clock_get_monotonic_us(void)
+{
+  u64_t local;
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  SYS_ARCH_PROTECT(lev);
+  local = sntp_clock_local_locked();
+  SYS_ARCH_UNPROTECT(lev);
+  return local;
+}
+
+/**
+ * @ingroup sntp_clock
+ * Get a snapshot of the clock state.
+ */
+void
+sntp_clock_get_stats(struct sntp_clock_stats *stats)
+{
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  SYS_ARCH_PROTECT(lev);
+  *stats = sntp_clock.stats;
+  SYS_ARCH_UNPROTECT(lev);
+}
+
+/**
+ * Drop all samples but the newest one (at index 0). Protection must be held.
+ */
+static void
+sntp_clock_restart_filter(void)
+{
+  u8_t idx = (u8_t)((sntp_clock.filter_next + SNTP_CLOCK_FILTER_SIZE - 1) % SNTP_CLOCK_FILTER_SIZE);
+
+  sntp_clock.filter[0] = sntp_clock.filter[idx];
+  sntp_clock.filter_next = 1;
+  sntp_clock.filter_count = 1;
+}
+
+/**
+ * Add a sample to the filter and estimate the frequency error from the
+ * oldest and newest sample in it. Protection must be held.
+ */
+static void
+sntp_clock_update_freq(u64_t local, s64_t raw_offset, u32_t delay)
+{
+  struct sntp_clock_sample_entry *entry;
+  const struct sntp_clock_sample_entry *newest, *oldest;
+  s64_t interval, drift, freq;
+  u8_t idx;
+
+  if (sntp_clock.filter_count >= 2) {
+    /* A sample far off the line through the history is a phase jump (of the
+     * server or the time base), which must not bend the frequency estimate */
+    idx = (u8_t)((sntp_clock.filter_next + SNTP_CLOCK_FILTER_SIZE - 1) % SNTP_CLOCK_FILTER_SIZE);
+    newest = &sntp_clock.filter[idx];
+    interval = (s64_t)(local - newest->local);
+    drift = raw_offset - newest->raw_offset - sntp_clock_scale(interval, sntp_clock.freq);
+    if (sntp_clock_abs(drift) > SNTP_CLOCK_POLL_GATE_US) {
+      sntp_clock.filter_count = 0;
+      sntp_clock.filter_next = 0;
+    }
+  }
+
+  entry = &sntp_clock.filter[sntp_clock.filter_next];
+  entry->local = local;
+  entry->raw_offset = raw_offset;
+  entry->delay = delay;
+  sntp_clock.filter_next = (u8_t)((sntp_clock.filter_next + 1) % SNTP_CLOCK_FILTER_SIZE);
+  if (sntp_clock.filter_count < SNTP_CLOCK_FILTER_SIZE) {
+    sntp_clock.filter_count++;
+  }
+
+  if (sntp_clock.filter_count < 2) {
+    return;
+  }
+  newest = entry;
+  idx = (u8_t)((sntp_clock.filter_count < SNTP_CLOCK_FILTER_SIZE) ? 0 : sntp_clock.filter_next);
+  oldest = &sntp_clock.filter[idx];
+
+  interval = (s64_t)(newest->local - oldest->local);
+  drift = newest->raw_offset - oldest->raw_offset;
+  if (interval < 15000000) {
+    /* Too short to tell drift from noise */
+    return;
+  }
+  if (sntp_clock_abs(drift) > interval / (1000000 / SNTP_CLOCK_FREQ_MAX_PPM)) {
+    /* More than the maximum correction: the newest sample is a phase jump */
+    sntp_clock_restart_filter();
+    return;
+  }
+  freq = (drift * 1000000000) / interval;
+  sntp_clock.freq = (s32_t)freq;
+  sntp_clock.stats.freq_ppb = sntp_clock.freq;
+}
+
+/**
+ * Adapt the poll interval to the last offset. Protection must be held.
+ */
+static void
+sntp_clock_update_poll(s64_t offset, u32_t delay)
+{
+  if ((sntp_clock_abs(offset) <= SNTP_CLOCK_POLL_GATE_US) || (sntp_clock_abs(offset) <= delay)) {
+    if (++sntp_clock.poll_count >= SNTP_CLOCK_POLL_HYSTERESIS) {
+      sntp_clock.poll_count = 0;
+      if (sntp_clock.poll < SNTP_CLOCK_POLL_MAX) {
+        sntp_clock.poll++;
+      }
+    }
+  } else {
+    sntp_clock.poll_count = 0;
+    if (sntp_clock.poll > SNTP_CLOCK_POLL_MIN) {
+      sntp_clock.poll--;
+    }
+  }
+  sntp_clock.stats.poll = sntp_clock.poll;
+}
+
+/**
+ * Feed one SNTP exchange to the clock. All timestamps are microseconds
+ * since 1970.
+ *
+ * @param t1 originate timestamp (local clock when the request was sent)
+ * @param t2 receive timestamp (server clock when the request arrived)
+ * @param t3 transmit timestamp (server clock when the response was sent)
+ * @param t4 destination timestamp (local clock when the response arrived)
+ * @return 1 if the clock was stepped (which includes the first sample),
+ *         0 if the sample was slewed or dropped
+ */
+u8_t
+sntp_clock_sample(s64_t t1, s64_t t2, s64_t t3, s64_t t4)
+{
+  u8_t stepped = 0;
+  s64_t offset, delay, wall;
+  u64_t local;
+  u32_t min_delay;
+  u8_t i;
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  /* Clock offset and round-trip delay according to RFC 4330 */
+  offset = ((t2 - t1) + (t3 - t4)) / 2;
+  delay = (t4 - t1) - (t3 - t2);
+  if (delay < 0) {
+    delay = 0;
+  }
+  if (delay > 0x7fffffff) {
+    /* clock stepped while the request was in flight */
+    return 0;
+  }
+
+  SYS_ARCH_PROTECT(lev);
+  if (sntp_clock.filter_count > 0) {
+    /* Drop samples that were delayed much more than recent ones */
+    min_delay = sntp_clock.filter[0].delay;
+    for (i = 1; i < sntp_clock.filter_count; i++) {
+      min_delay = LWIP_MIN(min_delay, sntp_clock.filter[i].delay);
+    }
+    if (((u32_t)delay > 2 * min_delay + SNTP_CLOCK_DELAY_SLACK_US) &&
+        (sntp_clock.rejects < SNTP_CLOCK_MAX_REJECTS)) {
+      sntp_clock.rejects++;
+      sntp_clock.stats.rejected++;
+      SYS_ARCH_UNPROTECT(lev);
+      return 0;
+    }
+  }
+  sntp_clock.rejects = 0;
+
+  wall = sntp_clock_rebase_locked(&local);
+  sntp_clock_update_freq(local, wall + offset - (s64_t)local, (u32_t)delay);
+
+  if (!sntp_clock.stats.synced || (sntp_clock_abs(offset) > SNTP_CLOCK_STEP_THRESHOLD_US)) {
+    /* Step */
+    sntp_clock.anchor_wall += offset;
+    sntp_clock.last_wall = sntp_clock.anchor_wall;
+    sntp_clock.slew = 0;
+    sntp_clock_restart_filter();
+    sntp_clock.poll = SNTP_CLOCK_POLL_MIN;
+    sntp_clock.poll_count = 0;
+    sntp_clock.stats.poll = SNTP_CLOCK_POLL_MIN;
+    sntp_clock.stats.steps++;
+    sntp_clock.stats.synced = 1;
+    stepped = 1;
+  } else {
+    /* Slew, replacing what is left of the previous correction */
+    sntp_clock.slew = offset;
+    sntp_clock_update_poll(offset, (u32_t)delay);
+  }
+  sntp_clock.stats.samples++;
+  sntp_clock.stats.offset_us = (s32_t)LWIP_MAX(LWIP_MIN(offset, 0x7fffffff), -0x7fffffff);
+  sntp_clock.stats.delay_us = (u32_t)delay;
+  SYS_ARCH_UNPROTECT(lev);
+  return stepped;
+}
+
+/**
+ * Next poll interval in milliseconds.
+ */
+u32_t
+sntp_clock_poll_interval(void)
+{
+  return (u32_t)1000 << sntp_clock.poll;
+}
+
+#endif /* LWIP_UDP && SNTP_CLOCK_DISCIPLINE */
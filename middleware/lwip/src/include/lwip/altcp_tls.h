@@ -91,6 +91,11 @@ struct altcp_tls_config *altcp_tls_create_config_server_privkey_cert(const u8_t
 
 /** @ingroup altcp_tls
  * Create an ALTCP_TLS client configuration handle
+ * If mbedTLS is configured with MBEDTLS_X509_CRT_BUNDLE_C, the CA certificates
+ * may also be passed as a bundle generated by mbedTLS scripts/x509_crt_bundle.py.
+ * A bundle is not copied, so it must stay valid (typically in flash) as long as
+ * the configuration is used. Its CAs are only parsed while verifying a server
+ * chain they issued, instead of all of them being kept parsed in RAM.
  */
 struct altcp_tls_config *altcp_tls_create_config_client(const u8_t *cert, size_t cert_len);
 
@@ -187,6 +192,199 @@ err_t altcp_tls_set_session(struct altcp_pcb *conn, struct altcp_tls_session *fr
  */
 void altcp_tls_free_session(struct altcp_tls_session *dest);
 
+#if LWIP_ALTCP_TLS_MBEDTLS && ALTCP_MBEDTLS_HANDSHAKE_STATS
+/** @ingroup altcp_tls
+ * Handshake timing of a connection, in microseconds
+ */
+struct altcp_tls_handshake_stats {
+  /** From the first handshake step to the end of the handshake (or now) */
+  u32_t total_us;
+  /** Time spent in handshake steps (the CPU time of the handshake) */
+  u32_t busy_us;
+  /** Longest single handshake step, i.e. the worst-case latency added to the stack */
+  u32_t max_step_us;
+  /** Number of handshake steps */
+  u32_t steps;
+  /** Number of steps interrupted after ALTCP_MBEDTLS_ECP_MAX_OPS ECC operations */
+  u32_t ecp_yields;
+  /** Set once the handshake is done */
+  u8_t done;
+};
+
+/** @ingroup altcp_tls
+ * Get the handshake timing of a connection (also valid during the handshake)
+ */
+err_t altcp_tls_get_handshake_stats(struct altcp_pcb *conn, struct altcp_tls_handshake_stats *stats);
+#endif /* LWIP_ALTCP_TLS_MBEDTLS && ALTCP_MBEDTLS_HANDSHAKE_STATS */
+
+#if LWIP_ALTCP_TLS_MBEDTLS && ALTCP_MBEDTLS_USE_VERIFY_CACHE
+/** @ingroup altcp_tls
+ * Statistics of the verified certificate chain cache
+ */
+struct altcp_tls_verify_cache_stats {
+  /** Server chains accepted without checking the signatures again */
+  u32_t hits;
+  /** Server chains fully verified */
+  u32_t misses;
+  /** Verifications that could not use the cache (e.g. no CA certificate) */
+  u32_t bypassed;
+  /** Chains added to the cache */
+  u32_t stores;
+  /** Entries replaced because the cache was full */
+  u32_t evictions;
+  /** Entries dropped on timeout or certificate expiry */
+  u32_t expired;
+  /** Number of times the cache was flushed */
+  u32_t invalidations;
+};
+
+/** @ingroup altcp_tls
+ * Get the statistics of the verified certificate chain cache
+ */
+void altcp_tls_get_verify_cache_stats(struct altcp_tls_verify_cache_stats *stats);
+
+/** @ingroup altcp_tls
+ * Empty the verified certificate chain cache, e.g. after a CA certificate was
+ * revoked
+ */
+void altcp_tls_flush_verify_cache(void);
+
+/** @ingroup altcp_tls
+ * Serialize the verified certificate chain cache to keep it across reboots
+ * (e.g. in a PSM object). A buffer of MBEDTLS_X509_VERIFY_CACHE_EXPORT_MAX_SIZE
+ * bytes is always large enough.
+ * ATTENTION: whoever can modify the saved data can make any server chain pass
+ * verification, store it like the CA certificates themselves!
+ */
+err_t altcp_tls_save_verify_cache(u8_t *buf, size_t len, size_t *olen);
+
+/** @ingroup altcp_tls
+ * Restore entries saved with @ref altcp_tls_save_verify_cache
+ */
+err_t altcp_tls_restore_verify_cache(const u8_t *buf, size_t len);
+#endif /* LWIP_ALTCP_TLS_MBEDTLS && ALTCP_MBEDTLS_USE_VERIFY_CACHE */
+
+#if LWIP_ALTCP_TLS_MBEDTLS && ALTCP_MBEDTLS_MEM_STATS
+/** @ingroup altcp_tls
+ * Number of handshake phases in struct altcp_tls_mem_stats (one per mbedTLS
+ * handshake state, see mbedtls_ssl_states)
+ */
+#define ALTCP_TLS_MEM_PHASES  19
+
+/** @ingroup altcp_tls
+ * mbedTLS allocations of a connection during one handshake phase
+ */
+struct altcp_tls_mem_phase_stats {
+  /** Number of allocations */
+  u32_t allocs;
+  /** Sum of the allocated bytes */
+  u32_t total_bytes;
+  /** Highest number of bytes allocated by the connection at a time */
+  u32_t peak_bytes;
+};
+
+/** @ingroup altcp_tls
+ * mbedTLS memory usage of a connection
+ */
+struct altcp_tls_mem_stats {
+  /** Indexed by mbedTLS handshake state: phase[0] (MBEDTLS_SSL_HELLO_REQUEST)
+   * includes the record buffers allocated when the connection is created,
+   * phase[16] (MBEDTLS_SSL_HANDSHAKE_OVER) what is allocated afterwards */
+  struct altcp_tls_mem_phase_stats phase[ALTCP_TLS_MEM_PHASES];
+  /** Bytes currently allocated */
+  u32_t cur_bytes;
+  /** Highest number of bytes allocated at a time */
+  u32_t peak_bytes;
+  /** High-water mark of the session region (ALTCP_MBEDTLS_MEM_ARENA) */
+  u32_t session_arena_peak;
+  /** High-water mark of the handshake region (ALTCP_MBEDTLS_MEM_ARENA) */
+  u32_t handshake_arena_peak;
+  /** Allocations taken from the heap because a region was full or missing */
+  u32_t heap_fallbacks;
+  /** Bytes of the handshake region still in use when the handshake was done
+   * (the region is then kept until the connection is freed) */
+  u32_t handshake_leftover;
+};
+
+/** @ingroup altcp_tls
+ * Get the mbedTLS memory usage of a connection (also valid during the handshake)
+ */
+err_t altcp_tls_get_mem_stats(struct altcp_pcb *conn, struct altcp_tls_mem_stats *stats);
+#endif /* LWIP_ALTCP_TLS_MBEDTLS && ALTCP_MBEDTLS_MEM_STATS */
+
+#if LWIP_ALTCP_TLS_MBEDTLS && ALTCP_MBEDTLS_HANDSHAKE_PROFILE
+/** @ingroup altcp_tls
+ * Number of handshake states in struct altcp_tls_handshake_profile (see
+ * mbedtls_ssl_states)
+ */
+#define ALTCP_TLS_PROFILE_STATES        19
+
+/** @ingroup altcp_tls
+ * Operations in struct altcp_tls_handshake_profile
+ */
+#define ALTCP_TLS_PROFILE_OP_ECP_MUL      0
+#define ALTCP_TLS_PROFILE_OP_RSA_PUBLIC   1
+#define ALTCP_TLS_PROFILE_OP_RSA_PRIVATE  2
+#define ALTCP_TLS_PROFILE_OP_X509_VERIFY  3
+#define ALTCP_TLS_PROFILE_OPS             4
+
+/** @ingroup altcp_tls
+ * Public key operations of one type during a handshake
+ */
+struct altcp_tls_profile_op {
+  /** Number of completed operations */
+  u32_t count;
+  /** Time spent in the operations, in microseconds */
+  u32_t total_us;
+  /** Longest single call (an ECC operation split by ALTCP_MBEDTLS_ECP_MAX_OPS
+   * takes several calls), in microseconds */
+  u32_t max_us;
+};
+
+/** @ingroup altcp_tls
+ * Where the time of a handshake went, in microseconds
+ */
+struct altcp_tls_handshake_profile {
+  /** Indexed by mbedTLS handshake state: from the step entering the state to
+   * the step leaving it, i.e. including the time waiting for the peer */
+  u32_t state_us[ALTCP_TLS_PROFILE_STATES];
+  /** Indexed by mbedTLS handshake state: time spent in handshake steps */
+  u32_t busy_us[ALTCP_TLS_PROFILE_STATES];
+  /** Indexed by ALTCP_TLS_PROFILE_OP_*. X.509 verification includes the
+   * signature checks, which are also counted as ECP or RSA operations */
+  struct altcp_tls_profile_op ops[ALTCP_TLS_PROFILE_OPS];
+  /** From the first handshake step to the end of the handshake */
+  u32_t total_us;
+  /** Number of handshake steps */
+  u32_t steps;
+  /** Set once the handshake is done (total_us is only valid then) */
+  u8_t done;
+};
+
+/** @ingroup altcp_tls
+ * Function called with the profile of every completed handshake
+ */
+typedef void (*altcp_tls_handshake_profile_fn)(void *arg, struct altcp_pcb *conn,
+                                               const struct altcp_tls_handshake_profile *prof);
+
+/** @ingroup altcp_tls
+ * Get the handshake profile of a connection (also valid during the handshake)
+ */
+err_t altcp_tls_get_handshake_profile(struct altcp_pcb *conn, struct altcp_tls_handshake_profile *prof);
+
+/** @ingroup altcp_tls
+ * Get the profile of the last completed handshake of any connection (e.g.
+ * after the connection was closed). Returns ERR_VAL if there was none yet.
+ */
+err_t altcp_tls_get_last_handshake_profile(struct altcp_tls_handshake_profile *prof);
+
+/** @ingroup altcp_tls
+ * Set a function called with the profile of every completed handshake (NULL
+ * to remove it). It runs in the tcpip thread, from within the handshake.
+ */
+void altcp_tls_set_handshake_profile_callback(altcp_tls_handshake_profile_fn fn, void *arg);
+#endif /* LWIP_ALTCP_TLS_MBEDTLS && ALTCP_MBEDTLS_HANDSHAKE_PROFILE */
+
 #ifdef __cplusplus
 }
 #endif
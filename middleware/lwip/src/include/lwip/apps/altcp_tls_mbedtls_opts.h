@@ -100,12 +100,141 @@
 #define ALTCP_MBEDTLS_SESSION_TICKET_TIMEOUT_SECONDS  (60 * 60 * 24)
 #endif
 
+/** ALTCP_MBEDTLS_USE_VERIFY_CACHE==1: remember server certificate chains that
+ * verified successfully, so that later connections presenting the same chain
+ * skip the signature checks (needs MBEDTLS_X509_VERIFY_CACHE_C enabled in
+ * mbedTLS config). One cache is shared by all client configurations, see
+ * altcp_tls_get_verify_cache_stats().
+ */
+#ifndef ALTCP_MBEDTLS_USE_VERIFY_CACHE
+#define ALTCP_MBEDTLS_USE_VERIFY_CACHE                0
+#endif
+
+/** Timeout in seconds of the verified chain cache entries (only used with
+ * MBEDTLS_HAVE_TIME, entries are then also dropped when a certificate of the
+ * chain expires if MBEDTLS_HAVE_TIME_DATE is enabled)
+ */
+#ifndef ALTCP_MBEDTLS_VERIFY_CACHE_TIMEOUT_SECONDS
+#define ALTCP_MBEDTLS_VERIFY_CACHE_TIMEOUT_SECONDS    (60 * 60 * 24)
+#endif
+
 /** Certificate verification mode: MBEDTLS_SSL_VERIFY_NONE, MBEDTLS_SSL_VERIFY_OPTIONAL (default),
  * MBEDTLS_SSL_VERIFY_REQUIRED (recommended)*/
 #ifndef ALTCP_MBEDTLS_AUTHMODE
 #define ALTCP_MBEDTLS_AUTHMODE                        MBEDTLS_SSL_VERIFY_OPTIONAL
 #endif
 
+/** Maximum number of basic ECC operations (see mbedtls_ecp_set_max_ops()) a
+ * handshake step may perform before returning to the stack, 0 to run the
+ * handshake to completion in one go. Interrupted steps are continued from a
+ * timeout (see ALTCP_MBEDTLS_HANDSHAKE_STEP_DELAY), the poll callback or when
+ * new data is received, so other connections and threads get the CPU and the
+ * tcpip core lock in between.
+ * Needs MBEDTLS_ECP_RESTARTABLE enabled in mbedTLS config. Only client
+ * handshakes can be split like this (mbedTLS limitation).
+ * ATTENTION: this is a global mbedTLS setting used by all ECC operations!
+ */
+#ifndef ALTCP_MBEDTLS_ECP_MAX_OPS
+#define ALTCP_MBEDTLS_ECP_MAX_OPS                     0
+#endif
+
+/** Delay in milliseconds before continuing an interrupted handshake step.
+ * Must be at least 1 so that the tcpip thread handles its mailbox in between.
+ */
+#ifndef ALTCP_MBEDTLS_HANDSHAKE_STEP_DELAY
+#define ALTCP_MBEDTLS_HANDSHAKE_STEP_DELAY            1
+#endif
+
+/** ALTCP_MBEDTLS_HANDSHAKE_STATS==1: measure the total handshake time and the
+ * time spent in each handshake step, see altcp_tls_get_handshake_stats()
+ */
+#ifndef ALTCP_MBEDTLS_HANDSHAKE_STATS
+#define ALTCP_MBEDTLS_HANDSHAKE_STATS                 0
+#endif
+
+/** Time source in microseconds for ALTCP_MBEDTLS_HANDSHAKE_STATS, define this
+ * to a cycle counter based clock to get useful step latencies.
+ */
+#ifndef ALTCP_MBEDTLS_GET_TIME_US
+#define ALTCP_MBEDTLS_GET_TIME_US()                   (sys_now() * 1000UL)
+#endif
+
+/** ALTCP_MBEDTLS_MEM_ARENA==1: take the mbedTLS allocations of a connection
+ * from two regions instead of the heap:
+ * - a session region, kept until the connection is freed (record buffers,
+ *   peer certificate, cipher contexts)
+ * - a handshake region (bignum temporaries, X.509 verification, handshake
+ *   state) that goes back to its pool as soon as the handshake is done
+ * Both come from memp pools (static memory unless MEMP_MEM_MALLOC==1), so
+ * handshakes do not fragment the heap. Allocations that do not fit into their
+ * region are taken from the heap instead.
+ * Needs MBEDTLS_PLATFORM_MEMORY and MBEDTLS_SSL_ALLOC_SCOPE enabled in mbedTLS
+ * config.
+ * ATTENTION: the mbedTLS allocation functions are global. If other threads use
+ * mbedTLS while a TLS connection is set up, define ALTCP_MBEDTLS_MEM_THREAD_ID.
+ */
+#ifndef ALTCP_MBEDTLS_MEM_ARENA
+#define ALTCP_MBEDTLS_MEM_ARENA                       0
+#endif
+
+/** Number of session regions, i.e. of connections that can use arenas at a
+ * time (further connections use the heap)
+ */
+#ifndef ALTCP_MBEDTLS_ARENA_CONNECTIONS
+#define ALTCP_MBEDTLS_ARENA_CONNECTIONS               2
+#endif
+
+/** Number of handshake regions, i.e. of handshakes that can use an arena at a
+ * time (further handshakes use the heap)
+ */
+#ifndef ALTCP_MBEDTLS_ARENA_HANDSHAKES
+#define ALTCP_MBEDTLS_ARENA_HANDSHAKES                1
+#endif
+
+/** Size of a session region: both record buffers plus the peer certificate
+ * chain and the record protection contexts (max. 65535)
+ */
+#ifndef ALTCP_MBEDTLS_ARENA_SESSION_SIZE
+#define ALTCP_MBEDTLS_ARENA_SESSION_SIZE              (MBEDTLS_SSL_IN_CONTENT_LEN + MBEDTLS_SSL_OUT_CONTENT_LEN + 8192)
+#endif
+
+/** Size of a handshake region (max. 65535). Use ALTCP_MBEDTLS_MEM_STATS to
+ * find out what the cipher suites and certificates in use need.
+ */
+#ifndef ALTCP_MBEDTLS_ARENA_HANDSHAKE_SIZE
+#define ALTCP_MBEDTLS_ARENA_HANDSHAKE_SIZE            16384
+#endif
+
+/** Identifier of the calling thread (e.g. xTaskGetCurrentTaskHandle() on
+ * FreeRTOS) for ALTCP_MBEDTLS_MEM_ARENA and ALTCP_MBEDTLS_MEM_STATS: mbedTLS
+ * allocations of other threads than the one running the handshake then go to
+ * the heap. By default, mbedTLS must not be used by other threads while a TLS
+ * connection is set up.
+ */
+#ifndef ALTCP_MBEDTLS_MEM_THREAD_ID
+#define ALTCP_MBEDTLS_MEM_THREAD_ID()                 NULL
+#endif
+
+/** ALTCP_MBEDTLS_MEM_STATS==1: count the mbedTLS allocations of each
+ * connection per handshake phase, see altcp_tls_get_mem_stats().
+ * Needs MBEDTLS_PLATFORM_MEMORY and MBEDTLS_SSL_ALLOC_SCOPE enabled in mbedTLS
+ * config.
+ */
+#ifndef ALTCP_MBEDTLS_MEM_STATS
+#define ALTCP_MBEDTLS_MEM_STATS                       0
+#endif
+
+/** ALTCP_MBEDTLS_HANDSHAKE_PROFILE==1: record the time spent in each
+ * handshake state and in the ECP, RSA and X.509 verification operations of
+ * each connection, see altcp_tls_get_handshake_profile(). The time source is
+ * ALTCP_MBEDTLS_GET_TIME_US().
+ * Needs MBEDTLS_SSL_HANDSHAKE_PROFILE and MBEDTLS_PROFILE_C enabled in mbedTLS
+ * config.
+ */
+#ifndef ALTCP_MBEDTLS_HANDSHAKE_PROFILE
+#define ALTCP_MBEDTLS_HANDSHAKE_PROFILE               0
+#endif
+
 #endif /* LWIP_ALTCP */
 
 #endif /* LWIP_HDR_ALTCP_TLS_OPTS_H */
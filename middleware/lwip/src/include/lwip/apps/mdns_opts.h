@@ -88,6 +88,16 @@
 #define MDNS_OUTPUT_PACKET_SIZE      ((MDNS_MAX_SERVICES == 1) ? 512 : 1450)
 #endif
 
+/** Number of pre-encoded responses cached per netif (0 to disable).
+ * Responses are built from the host and service tables and name compressed
+ * once, then sent again from the cache as long as the same set of records is
+ * requested. The cache is dropped when the hostname or a service changes;
+ * address and TXT changes are detected when looking up an entry.
+ */
+#ifndef MDNS_RESP_CACHE_SIZE
+#define MDNS_RESP_CACHE_SIZE            4
+#endif
+
 /** MDNS_RESP_USENETIF_EXTCALLBACK==1: register an ext_callback on the netif
  * to automatically restart probing/announcing on status or address change.
  */
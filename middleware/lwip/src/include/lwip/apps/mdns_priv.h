@@ -156,6 +156,12 @@ struct mdns_outmsg {
   u8_t host_reverse_v6_replies;
   /* Reply bitmask per service */
   u8_t serv_replies[MDNS_MAX_SERVICES];
+  /* Bitmask of host records the querier already knows (known answers) */
+  u8_t host_known;
+  /* Bitmask of IPv6 addresses the querier already knows */
+  u8_t host_known_aaaa;
+  /* Bitmask per service of records the querier already knows */
+  u8_t serv_known[MDNS_MAX_SERVICES];
 #ifdef LWIP_MDNS_SEARCH
   /** Search query to send */
   struct mdns_request *query;
@@ -181,6 +187,33 @@ struct mdns_delayed_msg {
   struct mdns_outmsg delayed_msg_unicast;
 };
 
+#if MDNS_RESP_CACHE_SIZE
+/** Everything a cached response depends on */
+struct mdns_resp_cache_key {
+  /** Output message fields */
+  u8_t flags;
+  u8_t cache_flush;
+  u8_t host_replies;
+  u8_t host_reverse_v6_replies;
+  u8_t host_known;
+  u8_t host_known_aaaa;
+  u8_t serv_replies[MDNS_MAX_SERVICES];
+  u8_t serv_known[MDNS_MAX_SERVICES];
+  /** Hash of the netif addresses and TXT data */
+  u32_t state;
+};
+
+/** Pre-encoded response */
+struct mdns_resp_cache_entry {
+  struct mdns_resp_cache_key key;
+  /** Encoded DNS message including header, NULL if unused */
+  u8_t *data;
+  u16_t len;
+  /** For LRU replacement */
+  u16_t last_used;
+};
+#endif /* MDNS_RESP_CACHE_SIZE */
+
 /* MDNS states */
 typedef enum {
   /* MDNS module is off */
@@ -223,6 +256,15 @@ struct mdns_host {
   u8_t index;
   /** number of conflicts since startup */
   u8_t num_conflicts;
+#if MDNS_RESP_CACHE_SIZE
+  /** Pre-encoded responses */
+  struct mdns_resp_cache_entry cache[MDNS_RESP_CACHE_SIZE];
+  /** Use counter for LRU replacement */
+  u16_t cache_clock;
+  /** Responses sent from / added to the cache */
+  u32_t cache_hits;
+  u32_t cache_misses;
+#endif
 };
 
 struct mdns_host* netif_mdns_data(struct netif *netif);
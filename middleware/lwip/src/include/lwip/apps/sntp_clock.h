@@ -0,0 +1,61 @@
+/**
+ * @file
+ * SNTP disciplined clock API
+ */
+
+/*
+ * Copyright 2026 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef LWIP_HDR_APPS_SNTP_CLOCK_H
+#define LWIP_HDR_APPS_SNTP_CLOCK_H
+
+#include "lwip/apps/sntp_opts.h"
+
+#if SNTP_CLOCK_DISCIPLINE /* don't build if not configured for use in lwipopts.h */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** State of the disciplined clock, see sntp_clock_get_stats() */
+struct sntp_clock_stats {
+  /** Samples used to discipline the clock */
+  u32_t samples;
+  /** Samples dropped because of a much higher round-trip delay */
+  u32_t rejected;
+  /** Number of times the clock was stepped instead of slewed */
+  u32_t steps;
+  /** Offset of the last sample in microseconds (server - local) */
+  s32_t offset_us;
+  /** Round-trip delay of the last sample in microseconds */
+  u32_t delay_us;
+  /** Estimated frequency error of the local time base, in ppb */
+  s32_t freq_ppb;
+  /** Current poll interval as power of two in seconds */
+  u8_t poll;
+  /** Set once the first sample was applied */
+  u8_t synced;
+};
+
+void  sntp_clock_init(void);
+void  sntp_clock_reset(void);
+u8_t  sntp_clock_synced(void);
+void  sntp_clock_get_time(u32_t *sec, u32_t *us);
+s64_t sntp_clock_get_time_us(void);
+u64_t sntp_clock_get_monotonic_us(void);
+void  sntp_clock_get_stats(struct sntp_clock_stats *stats);
+
+/* Used by the SNTP client */
+u8_t  sntp_clock_sample(s64_t t1, s64_t t2, s64_t t3, s64_t t4);
+u32_t sntp_clock_poll_interval(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SNTP_CLOCK_DISCIPLINE */
+
+#endif /* LWIP_HDR_APPS_SNTP_CLOCK_H */
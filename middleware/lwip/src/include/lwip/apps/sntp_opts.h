@@ -208,6 +208,75 @@
 #define SNTP_MONITOR_SERVER_REACHABILITY 1
 #endif
 
+/** Enable the clock discipline (sntp_clock.h).
+ * Instead of setting the system time on each response, the offset and
+ * round-trip delay of every sample are fed to a software clock that
+ * estimates the frequency error of the local oscillator, slews small
+ * offsets (so the clock never jumps backwards) and adapts the poll interval
+ * between 2^SNTP_CLOCK_POLL_MIN and 2^SNTP_CLOCK_POLL_MAX seconds.
+ * SNTP_SET_SYSTEM_TIME is only called on the first sync and when the
+ * clock is stepped, and SNTP_UPDATE_DELAY is not used in this mode: read the
+ * time with sntp_clock_get_time() instead.
+ *
+ * Requires 64-bit arithmetic and one more sys_timeout
+ * (MEMP_NUM_SYS_TIMEOUT) for the housekeeping timer.
+ */
+#if !defined SNTP_CLOCK_DISCIPLINE || defined __DOXYGEN__
+#define SNTP_CLOCK_DISCIPLINE       0
+#endif
+
+/** Free running local time base of the disciplined clock, in microseconds
+ * as u32_t (allowed to wrap). It has to be read at least once per wrap
+ * (71 minutes), which the housekeeping timer takes care of.
+ * The default only has the millisecond resolution of sys_now(): ports should
+ * map it to a high resolution source, e.g. os_get_timestamp() or a RTC
+ * counter scaled to microseconds.
+ */
+#if !defined SNTP_CLOCK_GET_LOCAL_US || defined __DOXYGEN__
+#define SNTP_CLOCK_GET_LOCAL_US()   ((u32_t)(sys_now() * 1000UL))
+#endif
+
+/** Offsets above this (in microseconds) step the clock instead of slewing
+ * it. Default is 128 ms as in RFC 5905.
+ */
+#if !defined SNTP_CLOCK_STEP_THRESHOLD_US || defined __DOXYGEN__
+#define SNTP_CLOCK_STEP_THRESHOLD_US 128000
+#endif
+
+/** Maximum slew rate in ppm. Removing an offset of 128 ms takes about
+ * 4.3 minutes at the default of 500 ppm.
+ */
+#if !defined SNTP_CLOCK_SLEW_PPM || defined __DOXYGEN__
+#define SNTP_CLOCK_SLEW_PPM         500
+#endif
+
+/** Largest frequency correction (in ppm) the clock will apply */
+#if !defined SNTP_CLOCK_FREQ_MAX_PPM || defined __DOXYGEN__
+#define SNTP_CLOCK_FREQ_MAX_PPM     500
+#endif
+
+/** Shortest poll interval as power of two in seconds (64 s) */
+#if !defined SNTP_CLOCK_POLL_MIN || defined __DOXYGEN__
+#define SNTP_CLOCK_POLL_MIN         6
+#endif
+
+/** Longest poll interval as power of two in seconds (2048 s) */
+#if !defined SNTP_CLOCK_POLL_MAX || defined __DOXYGEN__
+#define SNTP_CLOCK_POLL_MAX         11
+#endif
+
+/** Offsets (in microseconds) below this, or below the round-trip delay,
+ * count as "in sync" and let the poll interval grow.
+ */
+#if !defined SNTP_CLOCK_POLL_GATE_US || defined __DOXYGEN__
+#define SNTP_CLOCK_POLL_GATE_US     10000
+#endif
+
+/** Number of samples the frequency is estimated over */
+#if !defined SNTP_CLOCK_FILTER_SIZE || defined __DOXYGEN__
+#define SNTP_CLOCK_FILTER_SIZE      8
+#endif
+
 /**
  * @}
  */
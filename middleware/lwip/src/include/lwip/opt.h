@@ -2144,6 +2144,24 @@
 #if !defined LWIP_SOCKET_POLL || defined __DOXYGEN__
 #define LWIP_SOCKET_POLL                1
 #endif
+
+/**
+ * LWIP_SOCKET_MMSG==1: enable lwip_recvmmsg() and lwip_sendmmsg()
+ * (including struct mmsghdr) to move several datagrams per call on UDP and
+ * RAW sockets
+ */
+#if !defined LWIP_SOCKET_MMSG || defined __DOXYGEN__
+#define LWIP_SOCKET_MMSG                0
+#endif
+
+/**
+ * LWIP_SOCKET_MMSG_BATCH: maximum number of datagrams lwip_sendmmsg() passes
+ * to the tcpip thread in one call. Each one needs a struct netbuf on the
+ * stack of the calling thread.
+ */
+#if !defined LWIP_SOCKET_MMSG_BATCH || defined __DOXYGEN__
+#define LWIP_SOCKET_MMSG_BATCH          8
+#endif
 /**
  * @}
  */
@@ -86,6 +86,13 @@ struct api_msg {
   union {
     /** used for lwip_netconn_do_send */
     struct netbuf *b;
+    /** used for lwip_netconn_do_send_multi */
+    struct {
+      struct netbuf *bufs;
+      u16_t count;
+      /** number of netbufs sent before an error occurred */
+      u16_t sent;
+    } bm;
     /** used for lwip_netconn_do_newconn */
     struct {
       u8_t proto;
@@ -199,6 +206,7 @@ void lwip_netconn_do_connect         (void *m);
 void lwip_netconn_do_disconnect      (void *m);
 void lwip_netconn_do_listen          (void *m);
 void lwip_netconn_do_send            (void *m);
+void lwip_netconn_do_send_multi      (void *m);
 void lwip_netconn_do_recv            (void *m);
 #if TCP_LISTEN_BACKLOG
 void lwip_netconn_do_accepted        (void *m);
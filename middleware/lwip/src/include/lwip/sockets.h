@@ -147,6 +147,15 @@ struct msghdr {
 #define MSG_TRUNC   0x04
 #define MSG_CTRUNC  0x08
 
+#if LWIP_SOCKET_MMSG
+/** Message vector element for lwip_recvmmsg()/lwip_sendmmsg() */
+struct mmsghdr {
+  struct msghdr msg_hdr;
+  /* number of bytes received or sent for this message */
+  unsigned int  msg_len;
+};
+#endif /* LWIP_SOCKET_MMSG */
+
 /* RFC 3542, Section 20: Ancillary Data */
 struct cmsghdr {
   socklen_t  cmsg_len;   /* number of bytes, including header */
@@ -272,6 +281,7 @@ struct linger {
 #define MSG_DONTWAIT   0x08    /* Nonblocking i/o for this operation only */
 #define MSG_MORE       0x10    /* Sender will send more */
 #define MSG_NOSIGNAL   0x20    /* Uninmplemented: Requests not to send the SIGPIPE signal if an attempt to send is made on a stream-oriented socket that is no longer connected. */
+#define MSG_WAITFORONE 0x40    /* recvmmsg(): turns on MSG_DONTWAIT after the first datagram has been received */
 
 
 /*
@@ -570,6 +580,10 @@ void lwip_socket_thread_cleanup(void); /* LWIP_NETCONN_SEM_PER_THREAD==1: destro
 #define lwip_send         send
 #define lwip_sendmsg      sendmsg
 #define lwip_sendto       sendto
+#if LWIP_SOCKET_MMSG
+#define lwip_recvmmsg     recvmmsg
+#define lwip_sendmmsg     sendmmsg
+#endif
 #define lwip_socket       socket
 #if LWIP_SOCKET_SELECT
 #define lwip_select       select
@@ -616,6 +630,10 @@ ssize_t lwip_send(int s, const void *dataptr, size_t size, int flags);
 ssize_t lwip_sendmsg(int s, const struct msghdr *message, int flags);
 ssize_t lwip_sendto(int s, const void *dataptr, size_t size, int flags,
     const struct sockaddr *to, socklen_t tolen);
+#if LWIP_SOCKET_MMSG
+int lwip_recvmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags);
+int lwip_sendmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags);
+#endif
 int lwip_socket(int domain, int type, int protocol);
 ssize_t lwip_write(int s, const void *dataptr, size_t size);
 ssize_t lwip_writev(int s, const struct iovec *iov, int iovcnt);
@@ -665,6 +683,12 @@ int lwip_inet_pton(int af, const char *src, void *dst);
 #define sendmsg(s,message,flags)                  lwip_sendmsg(s,message,flags)
 /** @ingroup socket */
 #define sendto(s,dataptr,size,flags,to,tolen)     lwip_sendto(s,dataptr,size,flags,to,tolen)
+#if LWIP_SOCKET_MMSG
+/** @ingroup socket */
+#define recvmmsg(s,msgvec,vlen,flags)             lwip_recvmmsg(s,msgvec,vlen,flags)
+/** @ingroup socket */
+#define sendmmsg(s,msgvec,vlen,flags)             lwip_sendmmsg(s,msgvec,vlen,flags)
+#endif
 /** @ingroup socket */
 #define socket(domain,type,protocol)              lwip_socket(domain,type,protocol)
 #if LWIP_SOCKET_SELECT
@@ -723,4 +723,170 @@ sockets_stresstest_init_client(const char *remote_ip, u16_t remote_port)
   sockets_stresstest_start_clients(addr);
 }
 
+#if LWIP_UDP && LWIP_SOCKET_MMSG
+#define TEST_UDP_DATAGRAMS    20000
+#define TEST_UDP_DATAGRAM_LEN 64
+#define TEST_UDP_BATCH        8
+#define TEST_UDP_RXWAIT_MS    1000
+
+static int
+sockets_stresstest_udp_open(struct sockaddr_in *addr)
+{
+  int s, ret;
+  socklen_t addr_len = sizeof(*addr);
+#if LWIP_SO_RCVTIMEO
+#if LWIP_SO_SNDRCVTIMEO_NONSTANDARD
+  int rcvtimeo = TEST_UDP_RXWAIT_MS;
+#else
+  struct timeval rcvtimeo;
+  rcvtimeo.tv_sec = TEST_UDP_RXWAIT_MS / 1000;
+  rcvtimeo.tv_usec = (TEST_UDP_RXWAIT_MS % 1000) * 1000;
+#endif
+#endif
+
+  s = lwip_socket(AF_INET, SOCK_DGRAM, 0);
+  LWIP_ASSERT("s >= 0", s >= 0);
+
+  memset(addr, 0, sizeof(*addr));
+  addr->sin_family = AF_INET;
+  addr->sin_addr.s_addr = inet_addr("127.0.0.1");
+  ret = lwip_bind(s, (struct sockaddr *)addr, sizeof(*addr));
+  LWIP_ASSERT("ret == 0", ret == 0);
+  ret = lwip_getsockname(s, (struct sockaddr *)addr, &addr_len);
+  LWIP_ASSERT("ret == 0", ret == 0);
+
+#if LWIP_SO_RCVTIMEO
+  /* a lost datagram must not hang the test */
+  ret = lwip_setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, &rcvtimeo, sizeof(rcvtimeo));
+  LWIP_ASSERT("setsockopt error", ret == 0);
+#endif
+  return s;
+}
+
+/* Move 'datagrams' datagrams over loopback in bursts of 'burst', either one
+   per call (sendto/recvfrom) or one burst per call (sendmmsg/recvmmsg).
+   Returns the number of datagrams received. */
+static u32_t
+sockets_stresstest_udp_transfer(int batched, u32_t datagrams, int burst, u32_t *duration_ms)
+{
+  struct sockaddr_in rx_addr, tx_addr;
+  struct mmsghdr msgs[TEST_UDP_BATCH];
+  struct iovec iovs[TEST_UDP_BATCH];
+  u8_t bufs[TEST_UDP_BATCH][TEST_UDP_DATAGRAM_LEN];
+  u32_t seq_tx = 0, seq_rx = 0, received_total = 0, start;
+  int rx, tx, ret, i;
+
+  rx = sockets_stresstest_udp_open(&rx_addr);
+  tx = sockets_stresstest_udp_open(&tx_addr);
+
+  start = sys_now();
+  while (seq_tx < datagrams) {
+    /* send a burst */
+    for (i = 0; i < burst; i++) {
+      memset(bufs[i], 0, TEST_UDP_DATAGRAM_LEN);
+      memcpy(bufs[i], &seq_tx, sizeof(seq_tx));
+      seq_tx++;
+      iovs[i].iov_base = bufs[i];
+      iovs[i].iov_len = TEST_UDP_DATAGRAM_LEN;
+      memset(&msgs[i], 0, sizeof(msgs[i]));
+      msgs[i].msg_hdr.msg_name = &rx_addr;
+      msgs[i].msg_hdr.msg_namelen = sizeof(rx_addr);
+      msgs[i].msg_hdr.msg_iov = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    if (batched) {
+      ret = lwip_sendmmsg(tx, msgs, (unsigned int)burst, 0);
+      LWIP_ASSERT("sendmmsg sent all", ret == burst);
+      for (i = 0; i < burst; i++) {
+        LWIP_ASSERT("msg_len", msgs[i].msg_len == TEST_UDP_DATAGRAM_LEN);
+      }
+    } else {
+      for (i = 0; i < burst; i++) {
+        ret = lwip_sendto(tx, bufs[i], TEST_UDP_DATAGRAM_LEN, 0, (struct sockaddr *)&rx_addr, sizeof(rx_addr));
+        LWIP_ASSERT("sendto", ret == TEST_UDP_DATAGRAM_LEN);
+      }
+    }
+
+    /* receive the burst */
+    for (i = 0; i < burst; ) {
+      int j, received;
+      if (batched) {
+        for (j = i; j < burst; j++) {
+          iovs[j].iov_base = bufs[j];
+          iovs[j].iov_len = TEST_UDP_DATAGRAM_LEN;
+          memset(&msgs[j], 0, sizeof(msgs[j]));
+          msgs[j].msg_hdr.msg_iov = &iovs[j];
+          msgs[j].msg_hdr.msg_iovlen = 1;
+        }
+        received = lwip_recvmmsg(rx, &msgs[i], (unsigned int)(burst - i), MSG_WAITFORONE);
+      } else {
+        received = (lwip_recvfrom(rx, bufs[i], TEST_UDP_DATAGRAM_LEN, 0, NULL, NULL) == TEST_UDP_DATAGRAM_LEN) ? 1 : -1;
+      }
+      if (received <= 0) {
+        /* lost datagram(s): give up on this burst */
+        break;
+      }
+      for (j = i; j < i + received; j++) {
+        u32_t seq;
+        LWIP_ASSERT("msg_len", !batched || (msgs[j].msg_len == TEST_UDP_DATAGRAM_LEN));
+        memcpy(&seq, bufs[j], sizeof(seq));
+        LWIP_ASSERT("datagrams in order", seq >= seq_rx);
+        seq_rx = seq + 1;
+      }
+      received_total += (u32_t)received;
+      i += received;
+    }
+  }
+  *duration_ms = sys_now() - start;
+
+  ret = lwip_close(tx);
+  LWIP_ASSERT("ret == 0", ret == 0);
+  ret = lwip_close(rx);
+  LWIP_ASSERT("ret == 0", ret == 0);
+  return received_total;
+}
+
+/** Run the UDP batch test in the calling thread: 'datagrams' datagrams in
+ * bursts of 'burst' (at most TEST_UDP_BATCH), first with sendto/recvfrom,
+ * then with sendmmsg/recvmmsg. Returns the number of datagrams lost.
+ */
+u32_t
+sockets_stresstest_run_udp_batch(u32_t datagrams, int burst)
+{
+  int batched;
+  u32_t lost = 0;
+
+  LWIP_ASSERT("burst", (burst > 0) && (burst <= TEST_UDP_BATCH));
+  for (batched = 0; batched <= 1; batched++) {
+    u32_t duration_ms, received;
+    received = sockets_stresstest_udp_transfer(batched, datagrams, burst, &duration_ms);
+    if (duration_ms == 0) {
+      duration_ms = 1;
+    }
+    LWIP_PLATFORM_DIAG(("sockets_stresstest_udp_batch: %s: %"U32_F" of %"U32_F" datagrams (%d bytes) in %"U32_F" ms, %"U32_F" datagrams/s\n",
+                        batched ? "sendmmsg/recvmmsg" : "sendto/recvfrom", received, datagrams,
+                        TEST_UDP_DATAGRAM_LEN, duration_ms, (u32_t)((received * 1000ULL) / duration_ms)));
+    lost += datagrams - received;
+  }
+  return lost;
+}
+
+static void
+sockets_stresstest_udp_batch(void *arg)
+{
+  LWIP_UNUSED_ARG(arg);
+
+  sockets_stresstest_run_udp_batch(TEST_UDP_DATAGRAMS, TEST_UDP_BATCH);
+}
+
+void
+sockets_stresstest_init_udp_batch(void)
+{
+  sys_thread_t t;
+
+  t = sys_thread_new("sockets_stresstest_udp_batch", sockets_stresstest_udp_batch, NULL, 0, 0);
+  LWIP_ASSERT("thread != NULL", t != 0);
+}
+#endif /* LWIP_UDP && LWIP_SOCKET_MMSG */
+
 #endif /* LWIP_SOCKET && LWIP_IPV4 */
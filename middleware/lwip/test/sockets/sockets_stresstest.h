@@ -36,5 +36,9 @@
 void sockets_stresstest_init_loopback(int addr_family);
 void sockets_stresstest_init_server(int addr_family, u16_t server_port);
 void sockets_stresstest_init_client(const char *remote_ip, u16_t remote_port);
+#if LWIP_UDP && LWIP_SOCKET_MMSG
+void sockets_stresstest_init_udp_batch(void);
+u32_t sockets_stresstest_run_udp_batch(u32_t datagrams, int burst);
+#endif
 
 #endif /* LWIP_HDR_TEST_SOCKETS_STRESSTEST */
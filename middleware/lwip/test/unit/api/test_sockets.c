@@ -10,6 +10,8 @@
 #include "lwip/priv/tcp_priv.h"
 #include "lwip/api.h"
 
+#include "../../sockets/sockets_stresstest.h"
+
 
 static int
 test_sockets_get_used_count(void)
@@ -634,6 +636,106 @@ static void test_sockets_msgapi_cmsg(int domain)
 }
 #endif /* LWIP_IPV4 */
 
+#if LWIP_SOCKET_MMSG
+/* no more than MEMP_NUM_NETBUF datagrams can be queued on the receive side */
+#define TEST_MMSG_COUNT LWIP_MIN(MEMP_NUM_NETBUF, 4)
+
+static void test_sockets_mmsg_udp(int domain)
+{
+  int s, ret, i;
+  struct sockaddr_storage addr_storage;
+  socklen_t addr_size;
+  struct mmsghdr smsgs[TEST_MMSG_COUNT];
+  struct mmsghdr rmsgs[TEST_MMSG_COUNT + 1];
+  struct iovec siovs[TEST_MMSG_COUNT];
+  struct iovec riovs[TEST_MMSG_COUNT + 1];
+  u8_t snd_buf[TEST_MMSG_COUNT][8];
+  u8_t rcv_buf[TEST_MMSG_COUNT + 1][8];
+
+  test_sockets_init_loopback_addr(domain, &addr_storage, &addr_size);
+
+  s = test_sockets_alloc_socket_nonblocking(domain, SOCK_DGRAM);
+  fail_unless(s >= 0);
+
+  ret = lwip_bind(s, (struct sockaddr*)&addr_storage, addr_size);
+  fail_unless(ret == 0);
+
+  /* Update addr with epehermal port */
+  ret = lwip_getsockname(s, (struct sockaddr*)&addr_storage, &addr_size);
+  fail_unless(ret == 0);
+
+  /* send datagrams of different length to self with one call */
+  memset(smsgs, 0, sizeof(smsgs));
+  for (i = 0; i < TEST_MMSG_COUNT; i++) {
+    memset(snd_buf[i], 0xA0 + i, sizeof(snd_buf[i]));
+    siovs[i].iov_base = snd_buf[i];
+    siovs[i].iov_len = (size_t)(i + 2);
+    smsgs[i].msg_hdr.msg_name = &addr_storage;
+    smsgs[i].msg_hdr.msg_namelen = addr_size;
+    smsgs[i].msg_hdr.msg_iov = &siovs[i];
+    smsgs[i].msg_hdr.msg_iovlen = 1;
+  }
+  ret = lwip_sendmmsg(s, smsgs, TEST_MMSG_COUNT, 0);
+  fail_unless(ret == TEST_MMSG_COUNT);
+  for (i = 0; i < TEST_MMSG_COUNT; i++) {
+    fail_unless(smsgs[i].msg_len == (unsigned int)(i + 2));
+  }
+
+  while (tcpip_thread_poll_one());
+
+  /* receive them with one call, with room for one more */
+  memset(rmsgs, 0, sizeof(rmsgs));
+  memset(rcv_buf, 0, sizeof(rcv_buf));
+  for (i = 0; i < TEST_MMSG_COUNT + 1; i++) {
+    riovs[i].iov_base = rcv_buf[i];
+    riovs[i].iov_len = sizeof(rcv_buf[i]);
+    rmsgs[i].msg_hdr.msg_iov = &riovs[i];
+    rmsgs[i].msg_hdr.msg_iovlen = 1;
+  }
+  ret = lwip_recvmmsg(s, rmsgs, TEST_MMSG_COUNT + 1, MSG_DONTWAIT);
+  fail_unless(ret == TEST_MMSG_COUNT);
+  for (i = 0; i < TEST_MMSG_COUNT; i++) {
+    fail_unless(rmsgs[i].msg_len == (unsigned int)(i + 2));
+    fail_unless(!memcmp(rcv_buf[i], snd_buf[i], (size_t)(i + 2)));
+  }
+
+  /* an error after the first datagram is returned by the next call */
+  ret = lwip_sendmmsg(s, smsgs, 1, 0);
+  fail_unless(ret == 1);
+  while (tcpip_thread_poll_one());
+  lwip_socket_dbg_get_socket(s)->conn->pending_err = ERR_RST;
+  ret = lwip_recvmmsg(s, rmsgs, 2, MSG_DONTWAIT);
+  fail_unless(ret == 1);
+  fail_unless(rmsgs[0].msg_len == 2);
+  ret = lwip_recvmmsg(s, rmsgs, 2, MSG_DONTWAIT);
+  fail_unless(ret == -1);
+  fail_unless(errno == ECONNRESET);
+
+  /* nothing left */
+  ret = lwip_recvmmsg(s, rmsgs, TEST_MMSG_COUNT + 1, MSG_DONTWAIT);
+  fail_unless(ret == -1);
+  fail_unless(errno == EWOULDBLOCK);
+
+  /* invalid flags */
+  ret = lwip_recvmmsg(s, rmsgs, TEST_MMSG_COUNT + 1, MSG_PEEK);
+  fail_unless(ret == -1);
+  fail_unless(errno == EOPNOTSUPP);
+
+  ret = lwip_close(s);
+  fail_unless(ret == 0);
+}
+
+/* run the tcpip thread while a socket call blocks */
+static int
+test_sockets_poll_tcpip(sys_sem_t *wait_sem, sys_mbox_t *wait_mbox)
+{
+  LWIP_UNUSED_ARG(wait_sem);
+  LWIP_UNUSED_ARG(wait_mbox);
+  while (tcpip_thread_poll_one());
+  return 0;
+}
+#endif /* LWIP_SOCKET_MMSG */
+
 START_TEST(test_sockets_msgapis)
 {
   LWIP_UNUSED_ARG(_i);
@@ -641,10 +743,29 @@ START_TEST(test_sockets_msgapis)
   test_sockets_msgapi_udp(AF_INET);
   test_sockets_msgapi_tcp(AF_INET);
   test_sockets_msgapi_cmsg(AF_INET);
+#if LWIP_SOCKET_MMSG
+  test_sockets_mmsg_udp(AF_INET);
+#endif
 #endif
 #if LWIP_IPV6
   test_sockets_msgapi_udp(AF_INET6);
   test_sockets_msgapi_tcp(AF_INET6);
+#if LWIP_SOCKET_MMSG
+  test_sockets_mmsg_udp(AF_INET6);
+#endif
+#endif
+}
+END_TEST
+
+/* The UDP batch test of the socket stress test, with the sendto/recvfrom
+   path and the sendmmsg/recvmmsg path, in bursts that fit in the netbufs */
+START_TEST(test_sockets_udp_batch)
+{
+  LWIP_UNUSED_ARG(_i);
+#if LWIP_IPV4 && LWIP_SOCKET_MMSG
+  test_sys_arch_wait_callback(test_sockets_poll_tcpip);
+  fail_unless(sockets_stresstest_run_udp_batch(200, TEST_MMSG_COUNT) == 0);
+  test_sys_arch_wait_callback(NULL);
 #endif
 }
 END_TEST
@@ -836,6 +957,7 @@ sockets_suite(void)
     TESTFUNC(test_sockets_basics),
     TESTFUNC(test_sockets_allfunctions_basic),
     TESTFUNC(test_sockets_msgapis),
+    TESTFUNC(test_sockets_udp_batch),
     TESTFUNC(test_sockets_select),
     TESTFUNC(test_sockets_recv_after_rst),
   };
@@ -43,6 +43,9 @@
 #include <string.h>
 
 u32_t lwip_sys_now;
+u32_t lwip_sys_local_us;
+u32_t lwip_sys_set_time_sec;
+u32_t lwip_sys_set_time_count;
 
 u32_t
 sys_jiffies(void)
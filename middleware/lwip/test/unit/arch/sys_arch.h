@@ -67,6 +67,11 @@ void test_sys_arch_wait_callback(test_sys_arch_waiting_fn waiting_fn);
 
 /* current time */
 extern u32_t lwip_sys_now;
+/* free running microsecond counter (SNTP clock tests) */
+extern u32_t lwip_sys_local_us;
+/* last time set by SNTP_SET_SYSTEM_TIME, and number of calls (SNTP tests) */
+extern u32_t lwip_sys_set_time_sec;
+extern u32_t lwip_sys_set_time_count;
 
 sys_sem_t* sys_arch_netconn_sem_get(void);
 void sys_arch_netconn_sem_alloc(void);
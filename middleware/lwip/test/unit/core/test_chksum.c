@@ -0,0 +1,222 @@
+#include "test_chksum.h"
+
+#include "lwip/def.h"
+#include "lwip/inet_chksum.h"
+
+/* The optimized MCUXpresso port checksum is built for the host here with its
+   portable C block loop, so it can be checked against the reference. */
+#undef LWIP_CHKSUM_ARCH
+#define LWIP_CHKSUM_ARCH 1
+u16_t lwip_chksum_arch(const void *dataptr, int len);
+u16_t lwip_chksum_copy_arch(void *dst, const void *src, u16_t len);
+#include "../../../port/chksum.c"
+
+#include <string.h>
+#include <time.h>
+
+/** Set to 1 to print throughput of the checksum routines */
+#ifndef CHKSUM_TEST_BENCHMARK
+#define CHKSUM_TEST_BENCHMARK 0
+#endif
+
+#define TEST_MAX_OFFSET 8
+#define TEST_BUFSIZE    (0xffff + 2 * TEST_MAX_OFFSET)
+#define GUARD_BYTE      0x5a
+
+static u8_t src_buf[TEST_BUFSIZE];
+static u8_t dst_buf[TEST_BUFSIZE];
+
+/* Setups/teardown functions */
+
+static void
+chksum_setup(void)
+{
+  size_t i;
+  u32_t x = 0x12345678;
+
+  /* fill with deterministic pseudo random data (xorshift32) */
+  for (i = 0; i < sizeof(src_buf); i++) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    src_buf[i] = (u8_t)x;
+  }
+}
+
+static void
+chksum_teardown(void)
+{
+}
+
+/** RFC 1071 reference: sum big endian 16-bit words byte by byte, return the
+ * non-inverted sum in host order like LWIP_CHKSUM */
+static u16_t
+chksum_reference(const u8_t *data, int len)
+{
+  u32_t acc = 0;
+  int i;
+
+  for (i = 0; i + 1 < len; i += 2) {
+    acc += ((u32_t)data[i] << 8) | data[i + 1];
+  }
+  if (len & 1) {
+    acc += (u32_t)data[len - 1] << 8;
+  }
+  while (acc >> 16) {
+    acc = (acc & 0xffffUL) + (acc >> 16);
+  }
+  return lwip_htons((u16_t)acc);
+}
+
+/** Ones' complement sums are equal if they only differ in the representation
+ * of zero */
+static int
+chksum_equal(u16_t a, u16_t b)
+{
+  if (a == 0xffff) {
+    a = 0;
+  }
+  if (b == 0xffff) {
+    b = 0;
+  }
+  return a == b;
+}
+
+START_TEST(test_chksum_arch_reference)
+{
+  int offset, len;
+  static const int long_lens[] = {511, 512, 513, 1023, 1460, 1461, 1500, 4095, 32768, 0xfffe, 0xffff};
+  size_t i;
+  LWIP_UNUSED_ARG(_i);
+
+  for (offset = 0; offset < TEST_MAX_OFFSET; offset++) {
+    for (len = 0; len <= 300; len++) {
+      fail_unless(chksum_equal(lwip_chksum_arch(&src_buf[offset], len),
+                               chksum_reference(&src_buf[offset], len)));
+    }
+    for (i = 0; i < LWIP_ARRAYSIZE(long_lens); i++) {
+      fail_unless(chksum_equal(lwip_chksum_arch(&src_buf[offset], long_lens[i]),
+                               chksum_reference(&src_buf[offset], long_lens[i])));
+    }
+  }
+}
+END_TEST
+
+START_TEST(test_chksum_arch_carry)
+{
+  int offset;
+  LWIP_UNUSED_ARG(_i);
+
+  /* all ones maximizes end-around carries in every accumulator stage */
+  memset(dst_buf, 0xff, sizeof(dst_buf));
+  for (offset = 0; offset < TEST_MAX_OFFSET; offset++) {
+    fail_unless(chksum_equal(lwip_chksum_arch(&dst_buf[offset], 0xffff),
+                             chksum_reference(&dst_buf[offset], 0xffff)));
+    fail_unless(chksum_equal(lwip_chksum_arch(&dst_buf[offset], 1460),
+                             chksum_reference(&dst_buf[offset], 1460)));
+  }
+}
+END_TEST
+
+START_TEST(test_chksum_copy_arch)
+{
+  int src_offset, dst_offset;
+  u16_t len;
+  u16_t sum;
+  static const u16_t lens[] = {0, 1, 2, 3, 4, 5, 7, 15, 16, 17, 31, 63, 64, 65, 536, 1459, 1460, 0xffff};
+  size_t i, j;
+  LWIP_UNUSED_ARG(_i);
+
+  for (src_offset = 0; src_offset < 4; src_offset++) {
+    for (dst_offset = 0; dst_offset < 4; dst_offset++) {
+      for (i = 0; i < LWIP_ARRAYSIZE(lens); i++) {
+        len = lens[i];
+        memset(dst_buf, GUARD_BYTE, sizeof(dst_buf));
+        sum = lwip_chksum_copy_arch(&dst_buf[dst_offset], &src_buf[src_offset], len);
+        fail_unless(chksum_equal(sum, chksum_reference(&src_buf[src_offset], len)));
+        fail_unless(!memcmp(&dst_buf[dst_offset], &src_buf[src_offset], len));
+        for (j = 0; j < (size_t)dst_offset; j++) {
+          fail_unless(dst_buf[j] == GUARD_BYTE);
+        }
+        fail_unless(dst_buf[dst_offset + len] == GUARD_BYTE);
+      }
+    }
+  }
+}
+END_TEST
+
+START_TEST(test_chksum_inet)
+{
+  int offset;
+  u16_t len;
+  LWIP_UNUSED_ARG(_i);
+
+  /* whatever LWIP_CHKSUM is configured must agree with the reference */
+  for (offset = 0; offset < 4; offset++) {
+    for (len = 0; len <= 100; len++) {
+      fail_unless(chksum_equal(inet_chksum(&src_buf[offset], len),
+                               (u16_t)~chksum_reference(&src_buf[offset], len)));
+    }
+  }
+}
+END_TEST
+
+#if CHKSUM_TEST_BENCHMARK
+typedef u16_t (*chksum_fn)(const void *dataptr, int len);
+
+static u16_t
+chksum_reference_fn(const void *dataptr, int len)
+{
+  return chksum_reference((const u8_t *)dataptr, len);
+}
+
+static void
+chksum_bench(const char *name, chksum_fn fn, int offset, int len)
+{
+  const int iterations = 20000;
+  volatile u16_t sink = 0;
+  clock_t start, ticks;
+  int i;
+
+  start = clock();
+  for (i = 0; i < iterations; i++) {
+    sink = (u16_t)(sink + fn(&src_buf[offset], len));
+  }
+  ticks = clock() - start;
+  if (ticks == 0) {
+    ticks = 1;
+  }
+  printf("chksum %-10s offset %d len %5d: %8.1f MB/s\n", name, offset, len,
+         ((double)iterations * len / (1024.0 * 1024.0)) / ((double)ticks / CLOCKS_PER_SEC));
+}
+
+START_TEST(test_chksum_benchmark)
+{
+  static const int lens[] = {40, 576, 1460};
+  size_t i;
+  LWIP_UNUSED_ARG(_i);
+
+  for (i = 0; i < LWIP_ARRAYSIZE(lens); i++) {
+    chksum_bench("reference", chksum_reference_fn, 0, lens[i]);
+    chksum_bench("arch", lwip_chksum_arch, 0, lens[i]);
+    chksum_bench("arch", lwip_chksum_arch, 1, lens[i]);
+  }
+}
+END_TEST
+#endif /* CHKSUM_TEST_BENCHMARK */
+
+/** Create the suite including all tests for this module */
+Suite *
+chksum_suite(void)
+{
+  testfunc tests[] = {
+    TESTFUNC(test_chksum_arch_reference),
+    TESTFUNC(test_chksum_arch_carry),
+    TESTFUNC(test_chksum_copy_arch),
+    TESTFUNC(test_chksum_inet),
+#if CHKSUM_TEST_BENCHMARK
+    TESTFUNC(test_chksum_benchmark),
+#endif /* CHKSUM_TEST_BENCHMARK */
+  };
+  return create_suite("CHKSUM", tests, sizeof(tests)/sizeof(testfunc), chksum_setup, chksum_teardown);
+}
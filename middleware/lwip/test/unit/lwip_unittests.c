@@ -5,6 +5,7 @@
 #include "udp/test_udp.h"
 #include "tcp/test_tcp.h"
 #include "tcp/test_tcp_oos.h"
+#include "core/test_chksum.h"
 #include "core/test_def.h"
 #include "core/test_dns.h"
 #include "core/test_mem.h"
@@ -15,6 +16,7 @@
 #include "dhcp/test_dhcp.h"
 #include "mdns/test_mdns.h"
 #include "mqtt/test_mqtt.h"
+#include "sntp/test_sntp.h"
 #include "api/test_sockets.h"
 
 #include "lwip/init.h"
@@ -78,6 +80,7 @@ int main(void)
     udp_suite,
     tcp_suite,
     tcp_oos_suite,
+    chksum_suite,
     def_suite,
     dns_suite,
     mem_suite,
@@ -88,6 +91,7 @@ int main(void)
     dhcp_suite,
     mdns_suite,
     mqtt_suite,
+    sntp_suite,
     sockets_suite
   };
   size_t num = sizeof(suites)/sizeof(void*);
@@ -48,6 +48,7 @@
 #define LWIP_NETCONN_FULLDUPLEX         LWIP_SOCKET
 #define LWIP_NETCONN_SEM_PER_THREAD     1
 #define LWIP_NETBUF_RECVINFO            1
+#define LWIP_SOCKET_MMSG                1
 #define LWIP_HAVE_LOOPIF                1
 #define TCPIP_THREAD_TEST
 
@@ -68,6 +69,9 @@
 #define TCP_RCV_SCALE                   0
 #define PBUF_POOL_SIZE                  400 /* pbuf tests need ~200KByte */
 
+/* Required on 64-bit hosts once the IPv6 timers run (MDNS responder tests) */
+#define IPV6_FRAG_COPYHEADER            1
+
 /* Enable IGMP and MDNS for MDNS tests */
 #define LWIP_IGMP                       1
 #define LWIP_MDNS_RESPONDER             1
@@ -76,6 +80,13 @@
 /* Minimal changes to opt.h required for etharp unit tests: */
 #define ETHARP_SUPPORT_STATIC_ENTRIES   1
 
+/* SNTP clock discipline runs on a simulated (drifting) time base */
+#define SNTP_CLOCK_DISCIPLINE           1
+#define SNTP_CLOCK_GET_LOCAL_US()       lwip_sys_local_us
+#define SNTP_SET_SYSTEM_TIME(sec)       do { lwip_sys_set_time_sec = (sec); lwip_sys_set_time_count++; } while (0)
+#define SNTP_CHECK_RESPONSE             2
+#define SNTP_STARTUP_DELAY              0
+
 #define MEMP_NUM_SYS_TIMEOUT            (LWIP_NUM_SYS_TIMEOUT_INTERNAL + 8)
 
 /* MIB2 stats are required to check IPv4 reassembly results */
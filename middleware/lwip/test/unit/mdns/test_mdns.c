@@ -36,6 +36,22 @@
 #include "lwip/apps/mdns.h"
 #include "lwip/apps/mdns_domain.h"
 #include "lwip/apps/mdns_priv.h"
+#include "lwip/apps/mdns_out.h"
+#include "lwip/netif.h"
+#include "lwip/ip4.h"
+#include "lwip/inet_chksum.h"
+#include "lwip/timeouts.h"
+#include "lwip/prot/ip4.h"
+#include "lwip/prot/ip6.h"
+#include "lwip/prot/udp.h"
+#include "lwip/prot/dns.h"
+#include "lwip/prot/ip.h"
+#include "lwip/prot/iana.h"
+
+#if defined MDNS_TEST_BENCHMARK
+#include <stdio.h>
+#include <time.h>
+#endif
 
 START_TEST(readname_basic)
 {
@@ -876,6 +892,369 @@ START_TEST(compress_long_match)
 }
 END_TEST
 
+#if LWIP_IPV4 && MDNS_RESP_CACHE_SIZE
+/* Responder tests: a netif that captures the mDNS messages it sends */
+static struct netif mdns_netif;
+static u8_t mdns_tx_buf[MDNS_OUTPUT_PACKET_SIZE];
+static u16_t mdns_tx_len;
+static int mdns_tx_ctr;
+
+#if LWIP_IPV6
+static const u8_t mdns_test_ip6[2][16] = {
+  { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01 },
+  { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02 }
+};
+#endif
+
+static err_t
+mdns_netif_output(struct netif *netif, struct pbuf *p, const ip4_addr_t *ipaddr)
+{
+  u16_t len = (u16_t)(p->tot_len - IP_HLEN - UDP_HLEN);
+  LWIP_UNUSED_ARG(netif);
+  LWIP_UNUSED_ARG(ipaddr);
+
+  fail_unless(len <= sizeof(mdns_tx_buf));
+  mdns_tx_len = pbuf_copy_partial(p, mdns_tx_buf, len, IP_HLEN + UDP_HLEN);
+  mdns_tx_ctr++;
+  return ERR_OK;
+}
+
+#if LWIP_IPV6
+static err_t
+mdns_netif_output_ip6(struct netif *netif, struct pbuf *p, const ip6_addr_t *ipaddr)
+{
+  LWIP_UNUSED_ARG(netif);
+  LWIP_UNUSED_ARG(p);
+  LWIP_UNUSED_ARG(ipaddr);
+  return ERR_OK;
+}
+#endif
+
+static err_t
+mdns_netif_init(struct netif *netif)
+{
+  netif->output = mdns_netif_output;
+#if LWIP_IPV6
+  netif->output_ip6 = mdns_netif_output_ip6;
+#endif
+  netif->mtu = 1500;
+  netif->flags = NETIF_FLAG_IGMP | NETIF_FLAG_MLD6 | NETIF_FLAG_LINK_UP;
+  return ERR_OK;
+}
+
+static int mdns_test_txt_extra;
+
+static void
+mdns_test_txt(struct mdns_service *service, void *txt_userdata)
+{
+  LWIP_UNUSED_ARG(txt_userdata);
+  mdns_resp_add_service_txtitem(service, "path=/", 6);
+  if (mdns_test_txt_extra) {
+    mdns_resp_add_service_txtitem(service, "v=1", 3);
+  }
+}
+
+static int
+mdns_test_contains(const u8_t *buf, u16_t len, const u8_t *needle, u16_t needle_len)
+{
+  u16_t i;
+  for (i = 0; i + needle_len <= len; i++) {
+    if (memcmp(&buf[i], needle, needle_len) == 0) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/* Advance time until probing and announcing have finished */
+static void
+mdns_test_settle(void)
+{
+  int i;
+  for (i = 0; i < 100 && netif_mdns_data(&mdns_netif)->state != MDNS_STATE_COMPLETE; i++) {
+    lwip_sys_now += 100;
+    sys_check_timeouts();
+  }
+  fail_unless(netif_mdns_data(&mdns_netif)->state == MDNS_STATE_COMPLETE);
+  /* Announcements went through the cache too, only count queries */
+  netif_mdns_data(&mdns_netif)->cache_hits = 0;
+  netif_mdns_data(&mdns_netif)->cache_misses = 0;
+}
+
+static void
+mdns_test_netif_add(void)
+{
+  static int mdns_initialized;
+  ip4_addr_t addr, netmask, gw;
+
+  if (!mdns_initialized) {
+    mdns_resp_init();
+    mdns_initialized = 1;
+  }
+  IP4_ADDR(&addr, 192,168,0,1);
+  IP4_ADDR(&netmask, 255,255,255,0);
+  IP4_ADDR(&gw, 192,168,0,254);
+  netif_add(&mdns_netif, &addr, &netmask, &gw, NULL, mdns_netif_init, ip4_input);
+#if LWIP_IPV6
+  {
+    /* Probing needs a valid source address on both IP versions */
+    int i;
+    for (i = 0; i < 2; i++) {
+      ip6_addr_t addr6;
+      memcpy(&addr6.addr, mdns_test_ip6[i], sizeof(addr6.addr));
+      ip6_addr_clear_zone(&addr6);
+      netif_ip6_addr_set(&mdns_netif, (s8_t)i, &addr6);
+      netif_ip6_addr_set_state(&mdns_netif, (s8_t)i, IP6_ADDR_PREFERRED);
+    }
+  }
+#endif
+  netif_set_up(&mdns_netif);
+
+  fail_unless(mdns_resp_add_netif(&mdns_netif, "lwip") == ERR_OK);
+  fail_unless(mdns_resp_add_service(&mdns_netif, "svc", "_http", DNSSD_PROTO_TCP, 80,
+                                    mdns_test_txt, NULL) == 0);
+  mdns_test_settle();
+}
+
+static void
+mdns_test_netif_remove(void)
+{
+  /* Let the multicast rate limiting timers run out */
+  lwip_sys_now += 60000;
+  sys_check_timeouts();
+  fail_unless(mdns_resp_remove_netif(&mdns_netif) == ERR_OK);
+  netif_remove(&mdns_netif);
+}
+
+/* Inject a query as a unicast UDP packet from 192.168.0.2:5353 */
+static void
+mdns_test_query(const u8_t *dns, u16_t len)
+{
+  struct pbuf *p;
+  struct ip_hdr *iphdr;
+  struct udp_hdr *udphdr;
+  ip4_addr_t src, dest;
+
+  p = pbuf_alloc(PBUF_RAW, (u16_t)(IP_HLEN + UDP_HLEN + len), PBUF_RAM);
+  fail_if(p == NULL);
+  iphdr = (struct ip_hdr *)p->payload;
+  udphdr = (struct udp_hdr *)((u8_t *)p->payload + IP_HLEN);
+  memset(iphdr, 0, IP_HLEN + UDP_HLEN);
+
+  IP4_ADDR(&src, 192,168,0,2);
+  IP4_ADDR(&dest, 192,168,0,1);
+  IPH_VHL_SET(iphdr, 4, IP_HLEN / 4);
+  IPH_LEN_SET(iphdr, lwip_htons(p->tot_len));
+  IPH_TTL_SET(iphdr, 255);
+  IPH_PROTO_SET(iphdr, IP_PROTO_UDP);
+  ip4_addr_copy(iphdr->src, src);
+  ip4_addr_copy(iphdr->dest, dest);
+  IPH_CHKSUM_SET(iphdr, inet_chksum(iphdr, IP_HLEN));
+
+  udphdr->src = lwip_htons(LWIP_IANA_PORT_MDNS);
+  udphdr->dest = lwip_htons(LWIP_IANA_PORT_MDNS);
+  udphdr->len = lwip_htons((u16_t)(UDP_HLEN + len));
+  MEMCPY((u8_t *)p->payload + IP_HLEN + UDP_HLEN, dns, len);
+
+  mdns_tx_len = 0;
+  ip4_input(p, &mdns_netif);
+}
+
+/* Query: ANY svc._http._tcp.local (unique records, answered immediately) */
+static const u8_t mdns_query_service[] = {
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x03, 's', 'v', 'c', 0x05, '_', 'h', 't', 't', 'p', 0x04, '_', 't', 'c', 'p',
+  0x05, 'l', 'o', 'c', 'a', 'l', 0x00,
+  0x00, 0xff, 0x00, 0x01
+};
+
+START_TEST(resp_cache_hit)
+{
+  struct mdns_host *mdns;
+  u8_t first[MDNS_OUTPUT_PACKET_SIZE];
+  u16_t first_len;
+  LWIP_UNUSED_ARG(_i);
+
+  mdns_test_netif_add();
+  mdns = netif_mdns_data(&mdns_netif);
+
+  /* First query builds the response and caches it */
+  mdns_test_query(mdns_query_service, sizeof(mdns_query_service));
+  fail_unless(mdns_tx_len > SIZEOF_DNS_HDR);
+  fail_unless(mdns->cache_misses == 1);
+  fail_unless(mdns->cache_hits == 0);
+  first_len = mdns_tx_len;
+  memcpy(first, mdns_tx_buf, first_len);
+
+  /* Same question is answered from the cache with identical bytes */
+  mdns_test_query(mdns_query_service, sizeof(mdns_query_service));
+  fail_unless(mdns->cache_hits == 1);
+  fail_unless(mdns->cache_misses == 1);
+  fail_unless(mdns_tx_len == first_len);
+  fail_if(memcmp(mdns_tx_buf, first, first_len));
+
+  /* And equal to a freshly built one */
+  mdns_resp_cache_flush(mdns);
+  mdns_test_query(mdns_query_service, sizeof(mdns_query_service));
+  fail_unless(mdns->cache_misses == 2);
+  fail_unless(mdns_tx_len == first_len);
+  fail_if(memcmp(mdns_tx_buf, first, first_len));
+
+  mdns_test_netif_remove();
+}
+END_TEST
+
+START_TEST(resp_cache_invalidate)
+{
+  struct mdns_host *mdns;
+  u8_t first[MDNS_OUTPUT_PACKET_SIZE];
+  u16_t first_len;
+  LWIP_UNUSED_ARG(_i);
+
+  mdns_test_netif_add();
+  mdns = netif_mdns_data(&mdns_netif);
+
+  mdns_test_query(mdns_query_service, sizeof(mdns_query_service));
+  first_len = mdns_tx_len;
+  memcpy(first, mdns_tx_buf, first_len);
+
+  /* Rename changes the SRV target and drops the cache */
+  fail_unless(mdns_resp_rename_netif(&mdns_netif, "other") == ERR_OK);
+  mdns_test_settle();
+  mdns_test_query(mdns_query_service, sizeof(mdns_query_service));
+  fail_unless(mdns->cache_hits == 0);
+  fail_unless(mdns_tx_len == first_len + 1);
+  fail_if(memcmp(mdns_tx_buf, first, SIZEOF_DNS_HDR));
+
+  /* TXT data produced by the callback is checked on each lookup */
+  mdns_test_txt_extra = 1;
+  mdns_test_query(mdns_query_service, sizeof(mdns_query_service));
+  fail_unless(mdns->cache_hits == 0);
+  fail_unless(mdns_tx_len == first_len + 1 + 4);
+  mdns_test_query(mdns_query_service, sizeof(mdns_query_service));
+  fail_unless(mdns->cache_hits == 1);
+  mdns_test_txt_extra = 0;
+
+  mdns_test_netif_remove();
+}
+END_TEST
+
+#if LWIP_IPV6
+START_TEST(resp_known_answer_aaaa)
+{
+  /* Query: ANY lwip.local, with the first AAAA address as known answer */
+  u8_t query[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0x04, 'l', 'w', 'i', 'p', 0x05, 'l', 'o', 'c', 'a', 'l', 0x00,
+    0x00, 0xff, 0x00, 0x01,
+    0xc0, 0x0c, 0x00, 0x1c, 0x00, 0x01, 0x00, 0x00, 0x00, 0x78, 0x00, 0x10,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  };
+  struct dns_hdr *hdr = (struct dns_hdr *)(void *)mdns_tx_buf;
+  LWIP_UNUSED_ARG(_i);
+
+  memcpy(&query[sizeof(query) - 16], mdns_test_ip6[0], 16);
+  mdns_test_netif_add();
+
+  mdns_test_query(query, sizeof(query));
+  fail_unless(mdns_tx_len > SIZEOF_DNS_HDR);
+  /* A and the second AAAA only */
+  fail_unless(lwip_ntohs(hdr->numanswers) == 2);
+  fail_unless(lwip_ntohs(hdr->numextrarr) == 0);
+  fail_unless(mdns_test_contains(mdns_tx_buf, mdns_tx_len, mdns_test_ip6[1], 16));
+  fail_if(mdns_test_contains(mdns_tx_buf, mdns_tx_len, mdns_test_ip6[0], 16));
+
+  mdns_test_netif_remove();
+}
+END_TEST
+
+START_TEST(resp_aaaa_rdlength)
+{
+  /* Query: AAAA lwip.local */
+  static const u8_t query[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x04, 'l', 'w', 'i', 'p', 0x05, 'l', 'o', 'c', 'a', 'l', 0x00,
+    0x00, 0x1c, 0x00, 0x01
+  };
+  struct dns_hdr *hdr = (struct dns_hdr *)(void *)mdns_tx_buf;
+  u16_t i, pos[2];
+  int found = 0;
+  LWIP_UNUSED_ARG(_i);
+
+#if LWIP_IPV6_SCOPES
+  /* the zone makes ip6_addr_t larger than the 16 bytes on the wire */
+  fail_unless(sizeof(ip6_addr_t) > sizeof(ip6_addr_p_t));
+#endif
+  mdns_test_netif_add();
+
+  mdns_test_query(query, sizeof(query));
+  fail_unless(lwip_ntohs(hdr->numanswers) == 2);
+  for (i = SIZEOF_DNS_HDR + 10; i + 16 <= mdns_tx_len; i++) {
+    if (!memcmp(&mdns_tx_buf[i], mdns_test_ip6[0], 16) || !memcmp(&mdns_tx_buf[i], mdns_test_ip6[1], 16)) {
+      /* type AAAA, class IN (with cache flush), ttl, rdlength 16 */
+      fail_unless(mdns_tx_buf[i - 10] == 0x00 && mdns_tx_buf[i - 9] == 0x1c);
+      fail_unless(mdns_tx_buf[i - 2] == 0x00 && mdns_tx_buf[i - 1] == 0x10);
+      if (found < 2) {
+        pos[found] = i;
+      }
+      found++;
+      i = (u16_t)(i + 15);
+    }
+  }
+  fail_unless(found == 2);
+  /* the second record (compressed name, type, class, ttl, rdlength) follows
+     the 16 bytes of the first address */
+  fail_unless(found != 2 || pos[1] == pos[0] + 16 + 2 + 10);
+
+  /* the cache key covers the address bytes only: the same query hits */
+  mdns_test_query(query, sizeof(query));
+  fail_unless(netif_mdns_data(&mdns_netif)->cache_hits == 1);
+
+  mdns_test_netif_remove();
+}
+END_TEST
+#endif /* LWIP_IPV6 */
+
+#ifdef MDNS_TEST_BENCHMARK
+#define MDNS_TEST_BENCHMARK_QUERIES 20000
+
+static void
+mdns_test_benchmark_run(const char *name, int flush)
+{
+  struct mdns_host *mdns = netif_mdns_data(&mdns_netif);
+  u32_t bytes = 0;
+  clock_t start, end;
+  double secs;
+  int i;
+
+  start = clock();
+  for (i = 0; i < MDNS_TEST_BENCHMARK_QUERIES; i++) {
+    if (flush) {
+      mdns_resp_cache_flush(mdns);
+    }
+    mdns_test_query(mdns_query_service, sizeof(mdns_query_service));
+    bytes += mdns_tx_len;
+  }
+  end = clock();
+  secs = (double)(end - start) / CLOCKS_PER_SEC;
+  printf("mdns %s: %.0f responses/s, %"U32_F" bytes per response\n", name,
+         MDNS_TEST_BENCHMARK_QUERIES / (secs > 0 ? secs : 1e-9),
+         bytes / MDNS_TEST_BENCHMARK_QUERIES);
+}
+
+START_TEST(resp_cache_benchmark)
+{
+  LWIP_UNUSED_ARG(_i);
+
+  mdns_test_netif_add();
+  mdns_test_benchmark_run("uncached", 1);
+  mdns_test_benchmark_run("cached", 0);
+  mdns_test_netif_remove();
+}
+END_TEST
+#endif /* MDNS_TEST_BENCHMARK */
+#endif /* LWIP_IPV4 && MDNS_RESP_CACHE_SIZE */
+
 Suite* mdns_suite(void)
 {
   testfunc tests[] = {
@@ -911,6 +1290,18 @@ Suite* mdns_suite(void)
     TESTFUNC(compress_2nd_label_short),
     TESTFUNC(compress_jump_to_jump),
     TESTFUNC(compress_long_match),
+
+#if LWIP_IPV4 && MDNS_RESP_CACHE_SIZE
+    TESTFUNC(resp_cache_hit),
+    TESTFUNC(resp_cache_invalidate),
+#if LWIP_IPV6
+    TESTFUNC(resp_known_answer_aaaa),
+    TESTFUNC(resp_aaaa_rdlength),
+#endif
+#ifdef MDNS_TEST_BENCHMARK
+    TESTFUNC(resp_cache_benchmark),
+#endif
+#endif
   };
   return create_suite("MDNS", tests, sizeof(tests)/sizeof(testfunc), NULL, NULL);
 }
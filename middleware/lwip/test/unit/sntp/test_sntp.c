@@ -0,0 +1,258 @@
+#include "test_sntp.h"
+
+#include "lwip/apps/sntp.h"
+#include "lwip/apps/sntp_clock.h"
+#include "lwip/udp.h"
+#include "lwip/tcpip.h"
+#include "lwip/timeouts.h"
+
+#include <string.h>
+
+#if !SNTP_CLOCK_DISCIPLINE
+#error "This tests needs SNTP_CLOCK_DISCIPLINE enabled"
+#endif
+
+/* Seconds from 1900 (NTP era 0) to 1970 */
+#define TEST_SNTP_NTP_UNIX_DIFF 2208988800UL
+
+/* Simulation step in milliseconds */
+#define TEST_SNTP_STEP_MS       100
+
+/* Simulated world: the server serves true time plus an offset, the local
+ * time base runs off by a number of ppm. */
+static struct udp_pcb *test_sntp_server;
+static u64_t test_sntp_true_us;
+static s64_t test_sntp_server_offset_us;
+static s32_t test_sntp_drift_ppm;
+static u64_t test_sntp_start_us;
+static u64_t test_sntp_local_us;
+static u32_t test_sntp_requests;
+
+static void
+test_sntp_put_time(u8_t *buf, u64_t unix_us)
+{
+  u32_t sec = (u32_t)(unix_us / 1000000 + TEST_SNTP_NTP_UNIX_DIFF);
+  u32_t frac = (u32_t)(((unix_us % 1000000) << 32) / 1000000);
+  sec = lwip_htonl(sec);
+  frac = lwip_htonl(frac);
+  memcpy(buf, &sec, 4);
+  memcpy(buf + 4, &frac, 4);
+}
+
+static void
+test_sntp_server_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p, const ip_addr_t *addr, u16_t port)
+{
+  u8_t msg[48];
+  struct pbuf *q;
+  u64_t now = test_sntp_true_us + (u64_t)test_sntp_server_offset_us;
+  LWIP_UNUSED_ARG(arg);
+
+  fail_unless(p->tot_len == sizeof(msg));
+  pbuf_copy_partial(p, msg, sizeof(msg), 0);
+  pbuf_free(p);
+  test_sntp_requests++;
+
+  /* originate = client transmit time, receive = transmit = now */
+  memcpy(&msg[24], &msg[40], 8);
+  test_sntp_put_time(&msg[32], now);
+  test_sntp_put_time(&msg[40], now);
+  msg[0] = (4 << 3) | 4; /* version 4, mode server */
+  msg[1] = 2;            /* stratum */
+
+  q = pbuf_alloc(PBUF_TRANSPORT, sizeof(msg), PBUF_RAM);
+  fail_unless(q != NULL);
+  pbuf_take(q, msg, sizeof(msg));
+  udp_sendto(pcb, q, addr, port);
+  pbuf_free(q);
+}
+
+static void
+test_sntp_update_local(void)
+{
+  /* computed from the total to avoid accumulating rounding errors */
+  s64_t drift = ((s64_t)(test_sntp_true_us - test_sntp_start_us) * test_sntp_drift_ppm) / 1000000;
+  lwip_sys_local_us = (u32_t)(test_sntp_local_us + test_sntp_true_us + (u64_t)drift);
+}
+
+/* Advance the simulated time, run the timers and deliver loopback packets */
+static void
+test_sntp_run(u32_t ms)
+{
+  u32_t t;
+  for (t = 0; t < ms; t += TEST_SNTP_STEP_MS) {
+    test_sntp_true_us += TEST_SNTP_STEP_MS * 1000;
+    lwip_sys_now += TEST_SNTP_STEP_MS;
+    test_sntp_update_local();
+    sys_check_timeouts();
+    while (tcpip_thread_poll_one());
+  }
+}
+
+/* Error of the disciplined clock against the server in microseconds */
+static s64_t
+test_sntp_error(void)
+{
+  return sntp_clock_get_time_us() - (s64_t)(test_sntp_true_us + (u64_t)test_sntp_server_offset_us);
+}
+
+/* Run for ms and check the clock never goes backwards or jumps */
+static void
+test_sntp_run_monotonic(u32_t ms, s64_t max_step_us)
+{
+  u32_t t;
+  s64_t last = sntp_clock_get_time_us();
+  s64_t now;
+  for (t = 0; t < ms; t += TEST_SNTP_STEP_MS) {
+    test_sntp_run(TEST_SNTP_STEP_MS);
+    now = sntp_clock_get_time_us();
+    fail_unless(now >= last);
+    fail_unless(now - last <= max_step_us);
+    last = now;
+  }
+}
+
+/* Setups/teardown functions */
+
+static void
+sntp_setup(void)
+{
+  ip_addr_t server = IPADDR4_INIT_BYTES(127, 0, 0, 1);
+  err_t err;
+
+  /* 2024-01-01, the local time base keeps running across tests (it is about
+   * to wrap when the first test starts) */
+  test_sntp_true_us = (u64_t)1704067200 * 1000000;
+  test_sntp_start_us = test_sntp_true_us;
+  if (lwip_sys_local_us == 0) {
+    lwip_sys_local_us = 0xfff00000UL;
+  }
+  test_sntp_local_us = (u64_t)lwip_sys_local_us - test_sntp_true_us;
+  test_sntp_server_offset_us = 0;
+  test_sntp_drift_ppm = 0;
+  test_sntp_requests = 0;
+  lwip_sys_set_time_count = 0;
+  test_sntp_update_local();
+
+  test_sntp_server = udp_new();
+  fail_unless(test_sntp_server != NULL);
+  err = udp_bind(test_sntp_server, &server, SNTP_PORT);
+  fail_unless(err == ERR_OK);
+  udp_recv(test_sntp_server, test_sntp_server_recv, NULL);
+
+  sntp_clock_init();
+  sntp_clock_reset();
+  sntp_setoperatingmode(SNTP_OPMODE_POLL);
+  sntp_setserver(0, &server);
+}
+
+static void
+sntp_teardown(void)
+{
+  sntp_stop();
+  udp_remove(test_sntp_server);
+  test_sntp_server = NULL;
+  while (tcpip_thread_poll_one());
+}
+
+/* Test functions */
+
+/** The first response steps the clock to the server time */
+START_TEST(test_sntp_clock_first_sync_steps)
+{
+  struct sntp_clock_stats stats;
+  LWIP_UNUSED_ARG(_i);
+
+  fail_if(sntp_clock_synced());
+  sntp_init();
+  while (tcpip_thread_poll_one());
+
+  fail_unless(test_sntp_requests == 1);
+  fail_unless(sntp_clock_synced());
+  sntp_clock_get_stats(&stats);
+  fail_unless(stats.samples == 1);
+  fail_unless(stats.steps == 1);
+  fail_unless(stats.poll == SNTP_CLOCK_POLL_MIN);
+  fail_unless(test_sntp_error() >= -1000 && test_sntp_error() <= 1000);
+  fail_unless(sntp_clock_poll_interval() == (1000UL << SNTP_CLOCK_POLL_MIN));
+  /* the system time is set on the first sync */
+  fail_unless(lwip_sys_set_time_count == 1);
+  fail_unless(lwip_sys_set_time_sec == (u32_t)(test_sntp_true_us / 1000000));
+
+  /* next request after the poll interval */
+  test_sntp_run((1000UL << SNTP_CLOCK_POLL_MIN) - TEST_SNTP_STEP_MS);
+  fail_unless(test_sntp_requests == 1);
+  test_sntp_run(TEST_SNTP_STEP_MS);
+  fail_unless(test_sntp_requests == 2);
+}
+END_TEST
+
+/** A drifting local oscillator is measured and corrected, the poll interval
+ * grows and the clock is never stepped again */
+START_TEST(test_sntp_clock_drift)
+{
+  struct sntp_clock_stats stats;
+  LWIP_UNUSED_ARG(_i);
+
+  test_sntp_drift_ppm = 100; /* local time base runs fast */
+  sntp_init();
+  while (tcpip_thread_poll_one());
+
+  test_sntp_run_monotonic(4 * 3600 * 1000UL, TEST_SNTP_STEP_MS * 1000 * 2);
+
+  sntp_clock_get_stats(&stats);
+  fail_unless(stats.steps == 1);
+  fail_unless(stats.rejected == 0);
+  fail_unless(stats.freq_ppb > -101000 && stats.freq_ppb < -99000);
+  fail_unless(stats.poll > SNTP_CLOCK_POLL_MIN);
+  fail_unless(test_sntp_requests < (4 * 3600) >> SNTP_CLOCK_POLL_MIN);
+  fail_unless(test_sntp_error() >= -2000 && test_sntp_error() <= 2000);
+}
+END_TEST
+
+/** Small offsets are slewed without stepping, large ones step the clock */
+START_TEST(test_sntp_clock_slew_and_step)
+{
+  struct sntp_clock_stats stats;
+  LWIP_UNUSED_ARG(_i);
+
+  sntp_init();
+  while (tcpip_thread_poll_one());
+  test_sntp_run(TEST_SNTP_STEP_MS);
+  fail_unless(sntp_clock_synced());
+
+  /* server moves 50 ms ahead: slewed at SNTP_CLOCK_SLEW_PPM */
+  test_sntp_server_offset_us = 50000;
+  test_sntp_run_monotonic(1000UL << SNTP_CLOCK_POLL_MIN,
+                          TEST_SNTP_STEP_MS * (1000 + SNTP_CLOCK_SLEW_PPM / 1000 + 1));
+  sntp_clock_get_stats(&stats);
+  fail_unless(stats.steps == 1);
+  fail_unless(stats.offset_us > 49000 && stats.offset_us < 51000);
+  /* 50 ms take 100 s at 500 ppm */
+  test_sntp_run_monotonic(200 * 1000UL, TEST_SNTP_STEP_MS * (1000 + SNTP_CLOCK_SLEW_PPM / 1000 + 1));
+  fail_unless(test_sntp_error() >= -1000 && test_sntp_error() <= 1000);
+  /* slewing does not set the system time */
+  fail_unless(lwip_sys_set_time_count == 1);
+
+  /* server moves 2 s back: stepped */
+  test_sntp_server_offset_us -= 2000000;
+  test_sntp_run(1000UL << SNTP_CLOCK_POLL_MAX);
+  sntp_clock_get_stats(&stats);
+  fail_unless(stats.steps == 2);
+  fail_unless(test_sntp_error() >= -1000 && test_sntp_error() <= 1000);
+  /* the step sets it again */
+  fail_unless(lwip_sys_set_time_count == 2);
+  fail_unless(lwip_sys_set_time_sec <= (u32_t)(test_sntp_true_us / 1000000) - 1);
+}
+END_TEST
+
+/** Create the suite including all tests for this module */
+Suite *
+sntp_suite(void)
+{
+  testfunc tests[] = {
+    TESTFUNC(test_sntp_clock_first_sync_steps),
+    TESTFUNC(test_sntp_clock_drift),
+    TESTFUNC(test_sntp_clock_slew_and_step)
+  };
+  return create_suite("SNTP", tests, sizeof(tests)/sizeof(testfunc), sntp_setup, sntp_teardown);
+}
@@ -0,0 +1,8 @@
+#ifndef LWIP_HDR_TEST_SNTP_H__
+#define LWIP_HDR_TEST_SNTP_H__
+
+#include "../lwip_check.h"
+
+Suite* sntp_suite(void);
+
+#endif
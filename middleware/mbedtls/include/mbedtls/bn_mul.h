@@ -660,6 +660,18 @@
          : "r0", "r1", "memory"                 \
          );
 
+/*
+ * (h:l) = a * b + l + h, which cannot overflow
+ */
+#define MBEDTLS_MPI_UMAAL_INIT
+
+#define MBEDTLS_MPI_UMAAL( l, h, a, b )         \
+    asm( "umaal %0, %1, %2, %3"                 \
+         : "+r" (l), "+r" (h)                   \
+         : "r" (a), "r" (b) )
+
+#define MBEDTLS_MPI_UMAAL_STOP
+
 #else
 
 #define MULADDC_INIT                                    \
@@ -913,4 +925,22 @@
 #endif /* C (generic)  */
 #endif /* C (longlong) */
 
+#if !defined(MBEDTLS_MPI_UMAAL)
+#if defined(MBEDTLS_HAVE_UDBL)
+
+#define MBEDTLS_MPI_UMAAL_INIT          \
+{                                       \
+    mbedtls_t_udbl r;
+
+#define MBEDTLS_MPI_UMAAL( l, h, a, b ) \
+    r   = (mbedtls_t_udbl) (a) * (b) + (l) + (h);   \
+    (l) = (mbedtls_mpi_uint) r;                   \
+    (h) = (mbedtls_mpi_uint)( r >> biL )
+
+#define MBEDTLS_MPI_UMAAL_STOP          \
+}
+
+#endif /* MBEDTLS_HAVE_UDBL */
+#endif /* !MBEDTLS_MPI_UMAAL */
+
 #endif /* bn_mul.h */
@@ -623,6 +623,11 @@
 #error "MBEDTLS_SSL_DTLS_BADMAC_LIMIT  defined, but not all prerequisites"
 #endif
 
+#if defined(MBEDTLS_SSL_HANDSHAKE_PROFILE) &&                             \
+    ( !defined(MBEDTLS_SSL_TLS_C) || !defined(MBEDTLS_PROFILE_C) )
+#error "MBEDTLS_SSL_HANDSHAKE_PROFILE defined, but not all prerequisites"
+#endif
+
 #if defined(MBEDTLS_SSL_ENCRYPT_THEN_MAC) &&   \
     !defined(MBEDTLS_SSL_PROTO_TLS1)   &&      \
     !defined(MBEDTLS_SSL_PROTO_TLS1_1) &&      \
@@ -694,6 +699,22 @@
 #error "MBEDTLS_X509_CRT_PARSE_C defined, but not all prerequisites"
 #endif
 
+#if defined(MBEDTLS_X509_VERIFY_CACHE_C) && \
+    ( !defined(MBEDTLS_X509_CRT_PARSE_C) || !defined(MBEDTLS_SHA256_C) )
+#error "MBEDTLS_X509_VERIFY_CACHE_C defined, but not all prerequisites"
+#endif
+
+#if defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK) && \
+    !defined(MBEDTLS_X509_CRT_PARSE_C)
+#error "MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK defined, but not all prerequisites"
+#endif
+
+#if defined(MBEDTLS_X509_CRT_BUNDLE_C) && \
+    ( !defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK) || \
+      !defined(MBEDTLS_SHA256_C) )
+#error "MBEDTLS_X509_CRT_BUNDLE_C defined, but not all prerequisites"
+#endif
+
 #if defined(MBEDTLS_X509_CRL_PARSE_C) && ( !defined(MBEDTLS_X509_USE_C) )
 #error "MBEDTLS_X509_CRL_PARSE_C defined, but not all prerequisites"
 #endif
@@ -780,6 +780,23 @@
  */
 #define MBEDTLS_ECP_NIST_OPTIM
 
+/**
+ * \def MBEDTLS_MPI_MONT_FIXED
+ *
+ * Enable the fixed-width Montgomery multiplication kernel in
+ * library/bignum.c, used by mbedtls_mpi_exp_mod() (RSA, DHM) for 256, 2048
+ * and 3072-bit moduli. Each limb of both products is accumulated in a single
+ * pass with one UMAAL instruction on ARMv6+ cores with the DSP extension
+ * (Cortex-M4/M7/M33), or with double-width C arithmetic elsewhere.
+ * Other moduli sizes use the generic code. Squarings use the same kernel as
+ * multiplications, so that their running times don't tell them apart.
+ *
+ * Requires: MBEDTLS_HAVE_ASM on ARM or a double-width integer type
+ *
+ * Comment this macro to use the generic Montgomery multiplication only.
+ */
+//#define MBEDTLS_MPI_MONT_FIXED
+
 /**
  * \def MBEDTLS_ECP_RESTARTABLE
  *
@@ -1619,6 +1636,33 @@
  */
 #define MBEDTLS_SSL_EXPORT_KEYS
 
+/**
+ * \def MBEDTLS_SSL_ALLOC_SCOPE
+ *
+ * Enable the allocation scope callback, see mbedtls_ssl_conf_alloc_scope().
+ * The SSL module then tells the application which of its allocations
+ * during the handshake are kept afterwards (peer certificate, cipher
+ * contexts, session ticket), so that an allocator can take the other ones
+ * from a region that is reset when the handshake is over.
+ *
+ * Uncomment this macro to enable the allocation scope callback
+ */
+//#define MBEDTLS_SSL_ALLOC_SCOPE
+
+/**
+ * \def MBEDTLS_SSL_HANDSHAKE_PROFILE
+ *
+ * Enable the handshake profiler, see mbedtls_ssl_conf_handshake_profile().
+ * Each SSL context then records the time spent in every handshake state,
+ * waiting for the peer and in handshake steps, as well as the number and
+ * time of the ECP, RSA and X.509 verification operations of the handshake.
+ *
+ * Requires: MBEDTLS_SSL_TLS_C, MBEDTLS_PROFILE_C
+ *
+ * Uncomment this macro to enable the handshake profiler
+ */
+//#define MBEDTLS_SSL_HANDSHAKE_PROFILE
+
 /**
  * \def MBEDTLS_SSL_SERVER_NAME_INDICATION
  *
@@ -1747,6 +1791,18 @@
  */
 #define MBEDTLS_X509_CHECK_EXTENDED_KEY_USAGE
 
+/**
+ * \def MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK
+ *
+ * Enable the query of trusted certificates through a callback, see
+ * mbedtls_x509_crt_verify_with_ca_cb() and mbedtls_ssl_conf_ca_cb().
+ * The trusted certificates can then be kept out of RAM until a chain
+ * references them, see MBEDTLS_X509_CRT_BUNDLE_C.
+ *
+ * Uncomment to enable trusted certificate callbacks.
+ */
+//#define MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK
+
 /**
  * \def MBEDTLS_X509_RSASSA_PSS_SUPPORT
  *
@@ -2149,7 +2205,7 @@
  * Requires: MBEDTLS_AES_C or MBEDTLS_DES_C
  *
  */
-//#define MBEDTLS_CMAC_C
+#define MBEDTLS_CMAC_C
 
 /**
  * \def MBEDTLS_CTR_DRBG_C
@@ -2697,6 +2753,23 @@
  */
 #define MBEDTLS_POLY1305_C
 
+/**
+ * \def MBEDTLS_PROFILE_C
+ *
+ * Enable the timing of public key operations.
+ *
+ * Module:  library/profile.c
+ * Caller:  library/ecp.c
+ *          library/rsa.c
+ *          library/ssl_tls.c
+ *          library/x509_crt.c
+ *
+ * This module measures the ECP point multiplications, the RSA operations
+ * and the X.509 chain verifications while a sink is set, see
+ * mbedtls_profile_set_sink(). It is used by MBEDTLS_SSL_HANDSHAKE_PROFILE.
+ */
+//#define MBEDTLS_PROFILE_C
+
 /**
  * \def MBEDTLS_RIPEMD160_C
  *
@@ -2948,6 +3021,38 @@
  */
 #define MBEDTLS_X509_CRT_PARSE_C
 
+/**
+ * \def MBEDTLS_X509_VERIFY_CACHE_C
+ *
+ * Enable the cache of verified certificate chains.
+ *
+ * Module:  library/x509_verify_cache.c
+ * Caller:  library/ssl_tls.c
+ *
+ * Requires: MBEDTLS_X509_CRT_PARSE_C, MBEDTLS_SHA256_C
+ *
+ * This module remembers chains that verified successfully, so that later
+ * handshakes presenting the same chain skip the signature checks, see
+ * mbedtls_ssl_conf_verify_cache(). It has no effect unless a cache is set.
+ */
+#define MBEDTLS_X509_VERIFY_CACHE_C
+
+/**
+ * \def MBEDTLS_X509_CRT_BUNDLE_C
+ *
+ * Enable trusted CA bundles kept in flash.
+ *
+ * Module:  library/x509_crt_bundle.c
+ * Caller:
+ *
+ * Requires: MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK, MBEDTLS_SHA256_C
+ *
+ * A bundle is generated on the host by scripts/x509_crt_bundle.py. It holds
+ * the DER of the CA certificates behind an index sorted by subject name hash,
+ * so a certificate is only parsed while verifying a chain it issued.
+ */
+//#define MBEDTLS_X509_CRT_BUNDLE_C
+
 /**
  * \def MBEDTLS_X509_CRL_PARSE_C
  *
@@ -3257,6 +3362,8 @@
 /* X509 options */
 //#define MBEDTLS_X509_MAX_INTERMEDIATE_CA   8   /**< Maximum number of intermediate CAs in a verification chain. */
 //#define MBEDTLS_X509_MAX_FILE_PATH_LEN     512 /**< Maximum length of a path/filename string in bytes including the null terminator character ('\0'). */
+//#define MBEDTLS_X509_VERIFY_CACHE_MAX_ENTRIES      8 /**< Maximum entries in the verified chain cache */
+//#define MBEDTLS_X509_VERIFY_CACHE_DEFAULT_TIMEOUT  86400 /**< 1 day  */
 
 /**
  * Allow SHA-1 in the default TLS configuration for certificate signing.
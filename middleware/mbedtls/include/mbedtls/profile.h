@@ -0,0 +1,127 @@
+/**
+ * \file profile.h
+ *
+ * \brief Timing of expensive public key operations
+ *
+ *        The ECP point multiplications, the RSA public and private key
+ *        operations and the X.509 chain verification report their duration
+ *        to the statistics set with mbedtls_profile_set_sink(). The SSL module
+ *        uses this to profile its handshakes, see
+ *        mbedtls_ssl_conf_handshake_profile().
+ */
+/*
+ *  Copyright 2026 NXP
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of mbed TLS (https://tls.mbed.org)
+ */
+#ifndef MBEDTLS_PROFILE_H
+#define MBEDTLS_PROFILE_H
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include <stdint.h>
+
+#define MBEDTLS_PROFILE_OP_ECP_MUL          0   /*!< mbedtls_ecp_mul(), mbedtls_ecp_muladd() */
+#define MBEDTLS_PROFILE_OP_RSA_PUBLIC       1   /*!< mbedtls_rsa_public() */
+#define MBEDTLS_PROFILE_OP_RSA_PRIVATE      2   /*!< mbedtls_rsa_private() */
+#define MBEDTLS_PROFILE_OP_X509_VERIFY      3   /*!< mbedtls_x509_crt_verify() and variants */
+#define MBEDTLS_PROFILE_OPS                 4   /*!< Number of operation types */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief          Statistics of one operation type
+ *
+ * \note           A restartable operation (MBEDTLS_ECP_RESTARTABLE) is
+ *                 counted once, when it completes, but the time of all the
+ *                 calls it took is added to \c total_us. \c max_us is the
+ *                 longest single call, i.e. the latency the operation adds.
+ *
+ * \note           The time of an X.509 verification includes the signature
+ *                 checks it does, which are also counted as ECP or RSA
+ *                 operations.
+ */
+typedef struct
+{
+    uint32_t count;     /*!< Completed operations               */
+    uint32_t total_us;  /*!< Time spent in the operations       */
+    uint32_t max_us;    /*!< Longest single call                */
+}
+mbedtls_profile_op_stats;
+
+#if defined(MBEDTLS_PROFILE_C)
+/**
+ * \brief          Set the time source of the profiler
+ *
+ * \param f_now    Function returning a free running time in microseconds
+ *                 (wrapping around is fine), or NULL to only count the
+ *                 operations
+ */
+void mbedtls_profile_set_clock( uint32_t (*f_now)( void ) );
+
+/**
+ * \brief          Get the current time of the profiler clock
+ *
+ * \return         The time in microseconds, 0 if no clock was set
+ */
+uint32_t mbedtls_profile_now( void );
+
+/**
+ * \brief          Set the statistics operations are added to
+ *
+ * \note           The sink is global: set it around the code to measure,
+ *                 and don't use public key operations from other threads
+ *                 meanwhile (they would be counted as well).
+ *
+ * \param ops      Array of MBEDTLS_PROFILE_OPS statistics indexed by
+ *                 MBEDTLS_PROFILE_OP_xxx, or NULL to stop measuring
+ *
+ * \return         The previous sink, to restore when done
+ */
+mbedtls_profile_op_stats *mbedtls_profile_set_sink( mbedtls_profile_op_stats *ops );
+
+/**
+ * \brief          Start measuring an operation (internal use)
+ *
+ * \param op       MBEDTLS_PROFILE_OP_xxx
+ *
+ * \return         The start time, to pass to mbedtls_profile_op_end()
+ */
+uint32_t mbedtls_profile_op_start( int op );
+
+/**
+ * \brief          End measuring an operation (internal use). Only the
+ *                 outermost of nested operations of a type is counted.
+ *
+ * \param op       MBEDTLS_PROFILE_OP_xxx
+ * \param start    Value returned by mbedtls_profile_op_start()
+ * \param ret      Result of the operation: an operation returning
+ *                 MBEDTLS_ERR_ECP_IN_PROGRESS is not counted (yet)
+ */
+void mbedtls_profile_op_end( int op, uint32_t start, int ret );
+#endif /* MBEDTLS_PROFILE_C */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* profile.h */
@@ -40,6 +40,14 @@
 #include "x509_crl.h"
 #endif
 
+#if defined(MBEDTLS_X509_VERIFY_CACHE_C)
+#include "x509_verify_cache.h"
+#endif
+
+#if defined(MBEDTLS_SSL_HANDSHAKE_PROFILE)
+#include "profile.h"
+#endif
+
 #if defined(MBEDTLS_DHM_C)
 #include "dhm.h"
 #endif
@@ -202,6 +210,10 @@
 #define MBEDTLS_SSL_CERT_REQ_CA_LIST_ENABLED       1
 #define MBEDTLS_SSL_CERT_REQ_CA_LIST_DISABLED      0
 
+#define MBEDTLS_SSL_ALLOC_SCOPE_HANDSHAKE   0   /*!< freed when the handshake is over */
+#define MBEDTLS_SSL_ALLOC_SCOPE_SESSION     1   /*!< kept until the context is freed */
+#define MBEDTLS_SSL_ALLOC_SCOPE_SHARED      2   /*!< outlives the context (e.g. cache) */
+
 /*
  * Default range for DTLS retransmission timer value, in milliseconds.
  * RFC 6347 4.2.4.1 says from 1 second to 60 seconds.
@@ -783,6 +795,33 @@ typedef int mbedtls_ssl_async_resume_t( mbedtls_ssl_context *ssl,
 typedef void mbedtls_ssl_async_cancel_t( mbedtls_ssl_context *ssl );
 #endif /* MBEDTLS_SSL_ASYNC_PRIVATE */
 
+#if defined(MBEDTLS_SSL_HANDSHAKE_PROFILE)
+#define MBEDTLS_SSL_PROFILE_STATES  19  /*!< Entries of mbedtls_ssl_states */
+
+/**
+ * \brief          Timing of a handshake, in microseconds of the clock set
+ *                 with mbedtls_profile_set_clock()
+ *
+ *                 The time of a handshake step is added to the state it
+ *                 started in. The time in a state lasts from the step that
+ *                 entered it to the step that left it, so state_us - busy_us
+ *                 is the time spent waiting for the peer in that state.
+ */
+typedef struct mbedtls_ssl_handshake_profile
+{
+    uint32_t state_us[MBEDTLS_SSL_PROFILE_STATES];  /*!< time in each state */
+    uint32_t busy_us[MBEDTLS_SSL_PROFILE_STATES];   /*!< time in steps of each state */
+    mbedtls_profile_op_stats ops[MBEDTLS_PROFILE_OPS]; /*!< public key operations,
+                                                         see MBEDTLS_PROFILE_OP_xxx */
+    uint32_t total_us;          /*!< first step to handshake over     */
+    uint32_t steps;             /*!< calls to mbedtls_ssl_handshake_step() */
+    uint32_t start_us;          /*!< time of the first step           */
+    uint32_t state_start_us;    /*!< time the current state was entered */
+    unsigned char done;         /*!< handshake over, total_us is set  */
+}
+mbedtls_ssl_handshake_profile;
+#endif /* MBEDTLS_SSL_HANDSHAKE_PROFILE */
+
 /*
  * This structure is used for storing current session data.
  */
@@ -892,11 +931,31 @@ struct mbedtls_ssl_config
     void *p_export_keys;            /*!< context for key export callback    */
 #endif
 
+#if defined(MBEDTLS_SSL_ALLOC_SCOPE)
+    /** Callback told about the lifetime of the following allocations      */
+    void (*f_alloc_scope)( void *, mbedtls_ssl_context *, int );
+    void *p_alloc_scope;            /*!< context for alloc scope callback   */
+#endif
+
+#if defined(MBEDTLS_SSL_HANDSHAKE_PROFILE)
+    /** Callback receiving the timing of each completed handshake          */
+    void (*f_handshake_profile)( void *, const mbedtls_ssl_context *,
+                                 const mbedtls_ssl_handshake_profile * );
+    void *p_handshake_profile;      /*!< context for profile callback       */
+#endif
+
 #if defined(MBEDTLS_X509_CRT_PARSE_C)
     const mbedtls_x509_crt_profile *cert_profile; /*!< verification profile */
     mbedtls_ssl_key_cert *key_cert; /*!< own certificate/key pair(s)        */
     mbedtls_x509_crt *ca_chain;     /*!< trusted CAs                        */
     mbedtls_x509_crl *ca_crl;       /*!< trusted CAs CRLs                   */
+#if defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK)
+    mbedtls_x509_crt_ca_cb_t f_ca_cb; /*!< trusted CAs callback         */
+    void *p_ca_cb;                  /*!< context for the CA callback        */
+#endif /* MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK */
+#if defined(MBEDTLS_X509_VERIFY_CACHE_C)
+    mbedtls_x509_verify_cache *verify_cache; /*!< verified chains       */
+#endif
 #endif /* MBEDTLS_X509_CRT_PARSE_C */
 
 #if defined(MBEDTLS_SSL_ASYNC_PRIVATE)
@@ -1176,6 +1235,10 @@ struct mbedtls_ssl_context
     char own_verify_data[MBEDTLS_SSL_VERIFY_DATA_MAX_LEN]; /*!<  previous handshake verify data */
     char peer_verify_data[MBEDTLS_SSL_VERIFY_DATA_MAX_LEN]; /*!<  previous handshake verify data */
 #endif /* MBEDTLS_SSL_RENEGOTIATION */
+
+#if defined(MBEDTLS_SSL_HANDSHAKE_PROFILE)
+    mbedtls_ssl_handshake_profile profile; /*!<  timing of the last handshake */
+#endif
 };
 
 #if defined(MBEDTLS_SSL_HW_RECORD_ACCEL)
@@ -1604,6 +1667,71 @@ void mbedtls_ssl_conf_export_keys_cb( mbedtls_ssl_config *conf,
         void *p_export_keys );
 #endif /* MBEDTLS_SSL_EXPORT_KEYS */
 
+#if defined(MBEDTLS_SSL_ALLOC_SCOPE)
+/**
+ * \brief           Configure the allocation scope callback.
+ *                  (Default: none.)
+ *
+ *                  During mbedtls_ssl_handshake(), allocations are by
+ *                  default only needed until the handshake is over
+ *                  (MBEDTLS_SSL_ALLOC_SCOPE_HANDSHAKE). Around the
+ *                  allocations that are kept afterwards the callback is
+ *                  called with MBEDTLS_SSL_ALLOC_SCOPE_SESSION (peer
+ *                  certificate, record protection contexts, session
+ *                  ticket) or MBEDTLS_SSL_ALLOC_SCOPE_SHARED (session cache
+ *                  entries), and with MBEDTLS_SSL_ALLOC_SCOPE_HANDSHAKE
+ *                  again afterwards.
+ *
+ * \note            Allocations outside of mbedtls_ssl_handshake() (e.g. the
+ *                  record buffers in mbedtls_ssl_setup()) are not reported
+ *                  and are kept until the context is freed. Memory freed in
+ *                  a scope may have been allocated in another one.
+ *
+ * \param conf      SSL configuration context
+ * \param f_alloc_scope     Callback receiving the context and the scope
+ * \param p_alloc_scope     Context for the callback
+ */
+void mbedtls_ssl_conf_alloc_scope( mbedtls_ssl_config *conf,
+        void (*f_alloc_scope)( void *, mbedtls_ssl_context *, int ),
+        void *p_alloc_scope );
+#endif /* MBEDTLS_SSL_ALLOC_SCOPE */
+
+#if defined(MBEDTLS_SSL_HANDSHAKE_PROFILE)
+/**
+ * \brief           Configure the handshake profile callback.
+ *                  (Default: none.)
+ *
+ *                  The callback is called once the handshake is over, with
+ *                  the time spent in each handshake state and in the public
+ *                  key operations of the handshake.
+ *
+ * \note            The public key operations are measured through a global
+ *                  sink (see mbedtls_profile_set_sink()): don't run
+ *                  handshakes or other public key operations in several
+ *                  threads at a time, or they are counted by each other.
+ *
+ * \param conf      SSL configuration context
+ * \param f_profile Callback receiving the context and its profile
+ * \param p_profile Context for the callback
+ */
+void mbedtls_ssl_conf_handshake_profile( mbedtls_ssl_config *conf,
+        void (*f_profile)( void *, const mbedtls_ssl_context *,
+                           const mbedtls_ssl_handshake_profile * ),
+        void *p_profile );
+
+/**
+ * \brief           Get the timing of the current or last handshake of a
+ *                  context. It is reset when a new handshake begins.
+ *
+ * \param ssl       SSL context
+ *
+ * \return          The profile (\c total_us is only valid once \c done
+ *                  is set)
+ */
+const mbedtls_ssl_handshake_profile *mbedtls_ssl_get_handshake_profile(
+        const mbedtls_ssl_context *ssl );
+#endif /* MBEDTLS_SSL_HANDSHAKE_PROFILE */
+
 #if defined(MBEDTLS_SSL_ASYNC_PRIVATE)
 /**
  * \brief           Configure asynchronous private key operation callbacks.
@@ -2022,6 +2150,84 @@ void mbedtls_ssl_conf_ca_chain( mbedtls_ssl_config *conf,
                                mbedtls_x509_crt *ca_chain,
                                mbedtls_x509_crl *ca_crl );
 
+#if defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK)
+/**
+ * \brief          Set the trusted certificate callback.
+ *
+ *                 This API allows to register the set of trusted certificates
+ *                 through a callback, instead of a linked list as configured
+ *                 by mbedtls_ssl_conf_ca_chain().
+ *
+ *                 This is useful for example in contexts where a large number
+ *                 of CAs are used, and the inefficiency of maintaining them
+ *                 in a linked list cannot be tolerated. It is also useful when
+ *                 the set of trusted CAs needs to be modified frequently.
+ *
+ *                 See the documentation of `mbedtls_x509_crt_ca_cb_t` for
+ *                 more information.
+ *
+ * \param conf     The SSL configuration to register the callback with.
+ * \param f_ca_cb  The trusted certificate callback to use when verifying
+ *                 certificate chains.
+ * \param p_ca_cb  The context to be passed to \p f_ca_cb (for example,
+ *                 a reference to a trusted CA database).
+ *
+ * \note           This API is incompatible with mbedtls_ssl_conf_ca_chain():
+ *                 Any call to this function overwrites the values set through
+ *                 earlier calls to mbedtls_ssl_conf_ca_chain() or
+ *                 mbedtls_ssl_conf_ca_cb().
+ *
+ * \note           This API is incompatible with CA indication in
+ *                 CertificateRequest messages: A server-side SSL context which
+ *                 is bound to an SSL configuration that uses a CA callback
+ *                 configured via mbedtls_ssl_conf_ca_cb(), and which requires
+ *                 client authentication, will send an empty CA list in the
+ *                 corresponding CertificateRequest message.
+ *
+ * \note           This API is incompatible with mbedtls_ssl_set_hs_ca_chain():
+ *                 If an SSL context is bound to an SSL configuration which uses
+ *                 CA callbacks configured via mbedtls_ssl_conf_ca_cb(), then
+ *                 calls to mbedtls_ssl_set_hs_ca_chain() have no effect.
+ *
+ * \note           Restartable ECC can still be used during X.509 CRT
+ *                 signature verification: the candidate CAs returned by
+ *                 \p f_ca_cb are kept until the verification completes.
+ *
+ * \warning        This API is incompatible with the use of CRLs. Any call to
+ *                 mbedtls_ssl_conf_ca_cb() unsets CRLs configured through
+ *                 earlier calls to mbedtls_ssl_conf_ca_chain().
+ *
+ * \warning        In multi-threaded environments, the callback \p f_ca_cb
+ *                 must be thread-safe, and it is the user's responsibility
+ *                 to guarantee this (for example through a mutex
+ *                 contained in the callback context pointed to by \p p_ca_cb).
+ */
+void mbedtls_ssl_conf_ca_cb( mbedtls_ssl_config *conf,
+                             mbedtls_x509_crt_ca_cb_t f_ca_cb,
+                             void *p_ca_cb );
+#endif /* MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK */
+
+#if defined(MBEDTLS_X509_VERIFY_CACHE_C)
+/**
+ * \brief          Set the cache of verified peer certificate chains.
+ *                 When the peer presents a chain that verified successfully
+ *                 before with the same trusted CAs, hostname and profile,
+ *                 its signatures are not checked again. Several
+ *                 configurations may share a cache.
+ *
+ * \note           See \c mbedtls_x509_verify_cache_verify() for the
+ *                 conditions under which a verification is cached. The
+ *                 cache is cleared by \c mbedtls_ssl_conf_ca_chain(); call
+ *                 \c mbedtls_x509_verify_cache_clear() if the trusted CAs
+ *                 are modified in place.
+ *
+ * \param conf     SSL configuration
+ * \param cache    verified chain cache, or NULL to disable it
+ */
+void mbedtls_ssl_conf_verify_cache( mbedtls_ssl_config *conf,
+                                    mbedtls_x509_verify_cache *cache );
+#endif /* MBEDTLS_X509_VERIFY_CACHE_C */
+
 /**
  * \brief          Set own certificate chain and private key
  *
@@ -658,6 +658,16 @@ int mbedtls_ssl_check_sig_hash( const mbedtls_ssl_context *ssl,
                                 mbedtls_md_type_t md );
 #endif
 
+#if defined(MBEDTLS_SSL_ALLOC_SCOPE)
+static inline void mbedtls_ssl_alloc_scope( mbedtls_ssl_context *ssl, int scope )
+{
+    if( ssl->conf->f_alloc_scope != NULL )
+        ssl->conf->f_alloc_scope( ssl->conf->p_alloc_scope, ssl, scope );
+}
+#else
+#define mbedtls_ssl_alloc_scope( ssl, scope )   ( (void) ( ssl ), (void) ( scope ) )
+#endif
+
 #if defined(MBEDTLS_X509_CRT_PARSE_C)
 static inline mbedtls_pk_context *mbedtls_ssl_own_key( mbedtls_ssl_context *ssl )
 {
@@ -0,0 +1,153 @@
+/**
+ * \file x509_crt_bundle.h
+ *
+ * \brief Flash resident bundle of trusted X.509 CA certificates
+ */
+/*
+ *  Copyright 2026 NXP
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of mbed TLS (https://tls.mbed.org)
+ */
+#ifndef MBEDTLS_X509_CRT_BUNDLE_H
+#define MBEDTLS_X509_CRT_BUNDLE_H
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include "x509_crt.h"
+
+#include <stddef.h>
+
+/*
+ * Bundle layout, all integers big endian:
+ *
+ *  magic   "XCB1"
+ *  count   4 bytes, number of certificates
+ *  index   count entries, sorted by hash:
+ *            hash    8 bytes, start of the SHA-256 of the subject name,
+ *                    in the form library/x509_crt_bundle.c hashes it
+ *            offset  4 bytes, of the certificate from the bundle start
+ *            length  4 bytes, of the certificate
+ *  data    DER encoded certificates
+ *
+ * Bundles are generated on the host by scripts/x509_crt_bundle.py.
+ */
+#define MBEDTLS_X509_CRT_BUNDLE_MAGIC           "XCB1"
+#define MBEDTLS_X509_CRT_BUNDLE_MAGIC_LEN       4
+#define MBEDTLS_X509_CRT_BUNDLE_HEADER_SIZE     8
+#define MBEDTLS_X509_CRT_BUNDLE_HASH_LEN        8
+#define MBEDTLS_X509_CRT_BUNDLE_ENTRY_SIZE      16
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief   Bundle of trusted CA certificates
+ */
+typedef struct
+{
+    const unsigned char *buf;       /*!< bundle, not copied                 */
+    size_t buflen;                  /*!< length of the bundle               */
+    size_t count;                   /*!< number of certificates             */
+    size_t parsed;                  /*!< certificates parsed by lookups     */
+}
+mbedtls_x509_crt_bundle;
+
+/**
+ * \brief          Initialize a bundle context
+ *
+ * \param bundle   bundle context
+ */
+void mbedtls_x509_crt_bundle_init( mbedtls_x509_crt_bundle *bundle );
+
+/**
+ * \brief          Free a bundle context (the bundle data is not touched)
+ *
+ * \param bundle   bundle context
+ */
+void mbedtls_x509_crt_bundle_free( mbedtls_x509_crt_bundle *bundle );
+
+/**
+ * \brief          Check whether a buffer starts like a bundle, e.g. to tell
+ *                 it apart from PEM or DER certificates.
+ *
+ * \param buf      buffer to check
+ * \param buflen   length of the buffer
+ *
+ * \return         1 if \p buf starts with the bundle magic, 0 otherwise
+ */
+int mbedtls_x509_crt_bundle_is_bundle( const unsigned char *buf,
+                                       size_t buflen );
+
+/**
+ * \brief          Attach a bundle after checking its index. No certificate
+ *                 is parsed, they are only parsed by lookups.
+ *
+ * \param bundle   bundle context
+ * \param buf      bundle data, which must stay valid (typically in flash)
+ *                 as long as \p bundle is used
+ * \param buflen   length of the bundle
+ *
+ * \return         0 if successful, or MBEDTLS_ERR_X509_INVALID_FORMAT if the
+ *                 index is malformed, unsorted or points outside \p buf
+ */
+int mbedtls_x509_crt_bundle_load( mbedtls_x509_crt_bundle *bundle,
+                                  const unsigned char *buf, size_t buflen );
+
+/**
+ * \brief          Parse the certificates of the bundle whose subject is
+ *                 \p name and add them to \p chain.
+ *
+ * \note           Names are matched by hash, with UTF8String and
+ *                 PrintableString values folded to lower case like
+ *                 mbedtls_x509_crt_verify() compares them.
+ *
+ * \param bundle   bundle context
+ * \param name     name to look up, e.g. the \c issuer of a certificate
+ * \param chain    chain to add the certificates to
+ *
+ * \return         the number of certificates added, or a negative
+ *                 X509 error code
+ */
+int mbedtls_x509_crt_bundle_find( mbedtls_x509_crt_bundle *bundle,
+                                  const mbedtls_x509_name *name,
+                                  mbedtls_x509_crt *chain );
+
+/**
+ * \brief          Trusted certificate callback providing the possible
+ *                 issuers of \p child from a bundle, see
+ *                 ::mbedtls_x509_crt_ca_cb_t, mbedtls_ssl_conf_ca_cb() and
+ *                 mbedtls_x509_crt_verify_with_ca_cb().
+ *
+ * \param p_bundle bundle context
+ * \param child    certificate whose issuer is looked up
+ * \param candidate_cas where to store the list of candidates, NULL if none
+ *
+ * \return         0 if successful, or a negative error code
+ */
+int mbedtls_x509_crt_bundle_ca_cb( void *p_bundle,
+                                   mbedtls_x509_crt const *child,
+                                   mbedtls_x509_crt **candidate_cas );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MBEDTLS_X509_CRT_BUNDLE_H */
@@ -0,0 +1,273 @@
+/**
+ * \file x509_verify_cache.h
+ *
+ * \brief Cache of successfully verified X.509 certificate chains
+ */
+/*
+ *  Copyright 2026 NXP
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of mbed TLS (https://tls.mbed.org)
+ */
+#ifndef MBEDTLS_X509_VERIFY_CACHE_H
+#define MBEDTLS_X509_VERIFY_CACHE_H
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include "x509_crt.h"
+
+#if defined(MBEDTLS_HAVE_TIME)
+#include "platform_time.h"
+#endif
+
+#if defined(MBEDTLS_THREADING_C)
+#include "threading.h"
+#endif
+
+#include <stdint.h>
+
+/**
+ * \name SECTION: Module settings
+ *
+ * The configuration options you can set for this module are in this section.
+ * Either change them in config.h or define them on the compiler command line.
+ * \{
+ */
+
+#if !defined(MBEDTLS_X509_VERIFY_CACHE_MAX_ENTRIES)
+#define MBEDTLS_X509_VERIFY_CACHE_MAX_ENTRIES      8   /*!< Maximum entries in cache */
+#endif
+
+#if !defined(MBEDTLS_X509_VERIFY_CACHE_DEFAULT_TIMEOUT)
+#define MBEDTLS_X509_VERIFY_CACHE_DEFAULT_TIMEOUT  86400   /*!< 1 day  */
+#endif
+
+/* \} name SECTION: Module settings */
+
+/** Size of one entry in the output of mbedtls_x509_verify_cache_export() */
+#define MBEDTLS_X509_VERIFY_CACHE_ENTRY_SIZE       ( 32 + 8 + 7 )
+
+/** Size of the output of mbedtls_x509_verify_cache_export() */
+#define MBEDTLS_X509_VERIFY_CACHE_EXPORT_MAX_SIZE                        \
+    ( 2 + MBEDTLS_X509_VERIFY_CACHE_MAX_ENTRIES *                       \
+          MBEDTLS_X509_VERIFY_CACHE_ENTRY_SIZE )
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief   One verified chain
+ */
+typedef struct
+{
+    unsigned char key[32];          /*!< hash of chain, anchors, name, profile */
+#if defined(MBEDTLS_HAVE_TIME)
+    mbedtls_time_t timestamp;       /*!< time of the full verification      */
+#endif
+#if defined(MBEDTLS_HAVE_TIME_DATE)
+    mbedtls_x509_time valid_to;     /*!< earliest expiry within the chain   */
+#endif
+}
+mbedtls_x509_verify_cache_entry;
+
+/**
+ * \brief   Cache statistics
+ */
+typedef struct
+{
+    uint32_t hits;                  /*!< verifications answered by the cache */
+    uint32_t misses;                /*!< full verifications done            */
+    uint32_t bypassed;              /*!< verifications not eligible (CRL,
+                                         verify callback, no anchor)       */
+    uint32_t stores;                /*!< chains added to the cache          */
+    uint32_t evictions;             /*!< entries replaced to make room      */
+    uint32_t expired;               /*!< entries dropped on timeout/expiry  */
+    uint32_t invalidations;         /*!< calls to mbedtls_x509_verify_cache_clear() */
+}
+mbedtls_x509_verify_cache_stats;
+
+/**
+ * \brief   Verified chain cache context
+ */
+typedef struct
+{
+    mbedtls_x509_verify_cache_entry entries[MBEDTLS_X509_VERIFY_CACHE_MAX_ENTRIES];
+                                    /*!< most recently used first           */
+    size_t count;                   /*!< number of entries in use           */
+#if defined(MBEDTLS_HAVE_TIME)
+    int timeout;                    /*!< entry timeout in seconds, 0 = none */
+#endif
+    mbedtls_x509_verify_cache_stats stats; /*!< statistics              */
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_threading_mutex_t mutex;    /*!< mutex                  */
+#endif
+}
+mbedtls_x509_verify_cache;
+
+/**
+ * \brief          Initialize a verified chain cache
+ *
+ * \param cache    cache context
+ */
+void mbedtls_x509_verify_cache_init( mbedtls_x509_verify_cache *cache );
+
+/**
+ * \brief          Clear memory of a verified chain cache
+ *
+ * \param cache    cache context
+ */
+void mbedtls_x509_verify_cache_free( mbedtls_x509_verify_cache *cache );
+
+#if defined(MBEDTLS_HAVE_TIME)
+/**
+ * \brief          Set the cache timeout
+ *                 (Default: MBEDTLS_X509_VERIFY_CACHE_DEFAULT_TIMEOUT (1 day))
+ *
+ *                 A timeout of 0 indicates no timeout: entries are then only
+ *                 dropped when a certificate of the chain expires (if
+ *                 MBEDTLS_HAVE_TIME_DATE is enabled), when they are evicted
+ *                 or by mbedtls_x509_verify_cache_clear().
+ *
+ * \param cache    cache context
+ * \param timeout  cache entry timeout in seconds
+ */
+void mbedtls_x509_verify_cache_set_timeout( mbedtls_x509_verify_cache *cache,
+                                            int timeout );
+#endif /* MBEDTLS_HAVE_TIME */
+
+/**
+ * \brief          Verify a certificate chain like
+ *                 mbedtls_x509_crt_verify_restartable(), skipping the
+ *                 signature checks if the same chain was verified
+ *                 successfully before.
+ *                 (Thread-safe if MBEDTLS_THREADING_C is enabled)
+ *
+ *                 The lookup key is a SHA-256 hash over the DER of every
+ *                 certificate in \p crt, the DER of the certificates in
+ *                 \p trust_ca whose subject is the issuer of one of them
+ *                 (the possible trust anchors), \p cn and \p profile.
+ *                 Adding or removing an anchor of the chain therefore
+ *                 changes the key. Only verifications that succeed with no
+ *                 flag left set are stored.
+ *
+ * \note           The cache is bypassed when \p ca_crl is not NULL, as the
+ *                 CRLs are not part of the key, and when \p f_vrfy is not
+ *                 NULL, as the callback must see every verification and may
+ *                 reject a chain it accepted before.
+ *
+ * \param cache    cache context
+ *
+ * \return         See mbedtls_x509_crt_verify_restartable().
+ */
+int mbedtls_x509_verify_cache_verify( mbedtls_x509_verify_cache *cache,
+                     mbedtls_x509_crt *crt,
+                     mbedtls_x509_crt *trust_ca,
+                     mbedtls_x509_crl *ca_crl,
+                     const mbedtls_x509_crt_profile *profile,
+                     const char *cn, uint32_t *flags,
+                     int (*f_vrfy)(void *, mbedtls_x509_crt *, int, uint32_t *),
+                     void *p_vrfy,
+                     mbedtls_x509_crt_restart_ctx *rs_ctx );
+
+#if defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK)
+/**
+ * \brief          Version of mbedtls_x509_verify_cache_verify() taking the
+ *                 trusted CAs from a callback, like
+ *                 mbedtls_x509_crt_verify_restartable_ca_cb().
+ *
+ * \note           The key covers the candidates \p f_ca_cb returns for the
+ *                 certificates of \p crt, so the callback is called for each
+ *                 of them even on a hit.
+ *
+ * \param cache    cache context
+ *
+ * \return         See mbedtls_x509_crt_verify_restartable_ca_cb().
+ */
+int mbedtls_x509_verify_cache_verify_ca_cb( mbedtls_x509_verify_cache *cache,
+                     mbedtls_x509_crt *crt,
+                     mbedtls_x509_crt_ca_cb_t f_ca_cb,
+                     void *p_ca_cb,
+                     const mbedtls_x509_crt_profile *profile,
+                     const char *cn, uint32_t *flags,
+                     int (*f_vrfy)(void *, mbedtls_x509_crt *, int, uint32_t *),
+                     void *p_vrfy,
+                     mbedtls_x509_crt_restart_ctx *rs_ctx );
+#endif /* MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK */
+
+/**
+ * \brief          Remove all entries, e.g. when the trusted CA store or the
+ *                 CRLs change. Statistics other than \c invalidations are
+ *                 kept.
+ *                 (Thread-safe if MBEDTLS_THREADING_C is enabled)
+ *
+ * \param cache    cache context
+ */
+void mbedtls_x509_verify_cache_clear( mbedtls_x509_verify_cache *cache );
+
+/**
+ * \brief          Get the cache statistics
+ *
+ * \param cache    cache context
+ * \param stats    receives the statistics
+ */
+void mbedtls_x509_verify_cache_get_stats( mbedtls_x509_verify_cache *cache,
+                                          mbedtls_x509_verify_cache_stats *stats );
+
+/**
+ * \brief          Serialize the cache entries, to keep them across reboots
+ *                 (e.g. in a PSM object).
+ *                 (Thread-safe if MBEDTLS_THREADING_C is enabled)
+ *
+ * \warning        Whoever can modify the stored data can make any chain
+ *                 pass verification. Keep it in storage only trusted code
+ *                 can write, like the trusted CA store itself.
+ *
+ * \param cache    cache context
+ * \param buf      output buffer, MBEDTLS_X509_VERIFY_CACHE_EXPORT_MAX_SIZE
+ *                 bytes are always enough
+ * \param buflen   size of \p buf
+ * \param olen     receives the number of bytes written
+ *
+ * \return         0 if successful, or MBEDTLS_ERR_X509_BUFFER_TOO_SMALL
+ */
+int mbedtls_x509_verify_cache_export( mbedtls_x509_verify_cache *cache,
+                                      unsigned char *buf, size_t buflen,
+                                      size_t *olen );
+
+/**
+ * \brief          Add entries serialized by mbedtls_x509_verify_cache_export()
+ *                 to the cache. Entries that expired meanwhile are dropped
+ *                 on lookup as usual.
+ *                 (Thread-safe if MBEDTLS_THREADING_C is enabled)
+ *
+ * \param cache    cache context
+ * \param buf      serialized entries
+ * \param len      size of \p buf
+ *
+ * \return         0 if successful, or MBEDTLS_ERR_X509_INVALID_FORMAT
+ */
+int mbedtls_x509_verify_cache_import( mbedtls_x509_verify_cache *cache,
+                                      const unsigned char *buf, size_t len );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* x509_verify_cache.h */
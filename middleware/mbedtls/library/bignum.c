@@ -1903,6 +1903,99 @@ static void mpi_montg_init( mbedtls_mpi_uint *mm, const mbedtls_mpi *N )
     *mm = ~x + 1;
 }
 
+#if defined(MBEDTLS_MPI_MONT_FIXED)
+
+#if !defined(MBEDTLS_MPI_UMAAL)
+#error "MBEDTLS_MPI_MONT_FIXED needs the UMAAL instruction or a double-width integer type"
+#endif
+
+#if defined(__GNUC__)
+#define MPI_MONT_INLINE static inline __attribute__((always_inline))
+#else
+#define MPI_MONT_INLINE static inline
+#endif
+
+/*
+ * d[0..n] = A * B * R^-1 mod N, possibly plus N (CIOS, HAC 14.36)
+ *
+ * Both products of each step are accumulated in a single pass over the
+ * limbs, with separate carries, so each limb takes two UMAAL and one
+ * load/store of d. Inputs are n limbs, d has room for n + 1 limbs and
+ * the result is below 2N. Squares go through the same loop: a dedicated
+ * square kernel would run faster than a multiplication, and give away the
+ * exponent bits in mbedtls_mpi_exp_mod().
+ */
+MPI_MONT_INLINE void mpi_mont_mul_n( size_t n, mbedtls_mpi_uint *d,
+                                     const mbedtls_mpi_uint *A,
+                                     const mbedtls_mpi_uint *B,
+                                     const mbedtls_mpi_uint *N,
+                                     mbedtls_mpi_uint mm )
+{
+    size_t i, j;
+    mbedtls_mpi_uint a, u, t, c0, c1;
+
+    MBEDTLS_MPI_UMAAL_INIT
+    memset( d, 0, ( n + 1 ) * ciL );
+
+    for( i = 0; i < n; i++ )
+    {
+        /*
+         * d = (d + a*B + u*N) / 2^biL
+         */
+        a = A[i];
+        t = d[0];
+        c0 = 0;
+        MBEDTLS_MPI_UMAAL( t, c0, a, B[0] );
+        u = t * mm;
+        c1 = 0;
+        MBEDTLS_MPI_UMAAL( t, c1, u, N[0] );
+
+        for( j = 1; j < n; j++ )
+        {
+            t = d[j];
+            MBEDTLS_MPI_UMAAL( t, c0, a, B[j] );
+            MBEDTLS_MPI_UMAAL( t, c1, u, N[j] );
+            d[j - 1] = t;
+        }
+
+        t = d[n] + c0;
+        c0 = ( t < c0 );
+        t += c1;
+        c0 += ( t < c1 );
+        d[n - 1] = t;
+        d[n] = c0;
+    }
+    MBEDTLS_MPI_UMAAL_STOP
+}
+
+/*
+ * Instantiate the kernel with a constant size so that the compiler can
+ * specialize the loops. Returns 0, or -1 if the size is not supported.
+ */
+#define MPI_MONT_CASE( bits )                                           \
+    case ( bits ) / biL:                                                \
+        mpi_mont_mul_n( ( bits ) / biL, d, A, B, N, mm );               \
+        return( 0 );
+
+static int mpi_mont_fixed( size_t n, mbedtls_mpi_uint *d,
+                           const mbedtls_mpi_uint *A,
+                           const mbedtls_mpi_uint *B,
+                           const mbedtls_mpi_uint *N,
+                           mbedtls_mpi_uint mm )
+{
+    switch( n )
+    {
+        MPI_MONT_CASE( 256 )
+        MPI_MONT_CASE( 2048 )
+        MPI_MONT_CASE( 3072 )
+        default:
+            return( -1 );
+    }
+}
+
+#undef MPI_MONT_CASE
+#endif /* MBEDTLS_MPI_MONT_FIXED */
+
 /*
  * Montgomery multiplication: A = A * B * R^-1 mod N  (HAC 14.36)
  */
@@ -1915,12 +2008,19 @@ static int mpi_montmul( mbedtls_mpi *A, const mbedtls_mpi *B, const mbedtls_mpi
     if( T->n < N->n + 1 || T->p == NULL )
         return( MBEDTLS_ERR_MPI_BAD_INPUT_DATA );
 
-    memset( T->p, 0, T->n * ciL );
-
     d = T->p;
     n = N->n;
     m = ( B->n < n ) ? B->n : n;
 
+#if defined(MBEDTLS_MPI_MONT_FIXED)
+    /* The kernel needs full size operands */
+    if( A->n > n && m == n &&
+        mpi_mont_fixed( n, d, A->p, B->p, N->p, mm ) == 0 )
+        goto reduce;
+#endif
+
+    memset( T->p, 0, T->n * ciL );
+
     for( i = 0; i < n; i++ )
     {
         /*
@@ -1935,6 +2035,9 @@ static int mpi_montmul( mbedtls_mpi *A, const mbedtls_mpi *B, const mbedtls_mpi
         *d++ = u0; d[n + 1] = 0;
     }
 
+#if defined(MBEDTLS_MPI_MONT_FIXED)
+reduce:
+#endif
     memcpy( A->p, d, ( n + 1 ) * ciL );
 
     if( mbedtls_mpi_cmp_abs( A, N ) >= 0 )
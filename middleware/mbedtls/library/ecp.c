@@ -84,6 +84,10 @@
 
 #include <string.h>
 
+#if defined(MBEDTLS_PROFILE_C)
+#include "mbedtls/profile.h"
+#endif
+
 #if !defined(MBEDTLS_ECP_ALT)
 
 /* Parameter validation macros based on platform_util.h */
@@ -594,6 +598,20 @@ void mbedtls_ecp_point_free( mbedtls_ecp_point *pt )
     mbedtls_mpi_free( &( pt->Z ) );
 }
 
+/*
+ * Is the comb table of the base point a static constant (see ecp_curves.c)?
+ * Such a table is not owned by the group and has T_size = 0.
+ */
+static int ecp_group_is_static_comb_table( const mbedtls_ecp_group *grp )
+{
+#if MBEDTLS_ECP_FIXED_POINT_OPTIM == 1
+    return( grp->T != NULL && grp->T_size == 0 );
+#else
+    (void) grp;
+    return( 0 );
+#endif
+}
+
 /*
  * Unallocate (the components of) a group
  */
@@ -613,7 +631,7 @@ void mbedtls_ecp_group_free( mbedtls_ecp_group *grp )
         mbedtls_mpi_free( &grp->N );
     }
 
-    if( grp->T != NULL )
+    if( grp->T != NULL && !ecp_group_is_static_comb_table( grp ) )
     {
         for( i = 0; i < grp->T_size; i++ )
             mbedtls_ecp_point_free( &grp->T[i] );
@@ -2009,10 +2027,12 @@ static unsigned char ecp_pick_window_size( const mbedtls_ecp_group *grp,
         w++;
 
     /*
-     * Make sure w is within bounds.
+     * Make sure w is within bounds, unless the base point table is static:
+     * its size was fixed when it was generated and costs no RAM.
      * (The last test is useful only for very small curves in the test suite.)
      */
-    if( w > MBEDTLS_ECP_WINDOW_SIZE )
+    if( w > MBEDTLS_ECP_WINDOW_SIZE &&
+        !( p_eq_g && ecp_group_is_static_comb_table( grp ) ) )
         w = MBEDTLS_ECP_WINDOW_SIZE;
     if( w >= grp->nbits )
         w = 2;
@@ -2392,12 +2412,19 @@ int mbedtls_ecp_mul_restartable( mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
     int ret = MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
 #if defined(MBEDTLS_ECP_INTERNAL_ALT)
     char is_grp_capable = 0;
+#endif
+#if defined(MBEDTLS_PROFILE_C)
+    uint32_t prof_start;
 #endif
     ECP_VALIDATE_RET( grp != NULL );
     ECP_VALIDATE_RET( R   != NULL );
     ECP_VALIDATE_RET( m   != NULL );
     ECP_VALIDATE_RET( P   != NULL );
 
+#if defined(MBEDTLS_PROFILE_C)
+    prof_start = mbedtls_profile_op_start( MBEDTLS_PROFILE_OP_ECP_MUL );
+#endif
+
 #if defined(MBEDTLS_ECP_RESTARTABLE)
     /* reset ops count for this call if top-level */
     if( rs_ctx != NULL && rs_ctx->depth++ == 0 )
@@ -2444,6 +2471,10 @@ cleanup:
         rs_ctx->depth--;
 #endif
 
+#if defined(MBEDTLS_PROFILE_C)
+    mbedtls_profile_op_end( MBEDTLS_PROFILE_OP_ECP_MUL, prof_start, ret );
+#endif
+
     return( ret );
 }
 
@@ -2566,6 +2597,9 @@ int mbedtls_ecp_muladd_restartable(
     mbedtls_ecp_point *pR = R;
 #if defined(MBEDTLS_ECP_INTERNAL_ALT)
     char is_grp_capable = 0;
+#endif
+#if defined(MBEDTLS_PROFILE_C)
+    uint32_t prof_start;
 #endif
     ECP_VALIDATE_RET( grp != NULL );
     ECP_VALIDATE_RET( R   != NULL );
@@ -2581,6 +2615,11 @@ int mbedtls_ecp_muladd_restartable(
 
     ECP_RS_ENTER( ma );
 
+#if defined(MBEDTLS_PROFILE_C)
+    /* the two multiplications are counted as part of this operation */
+    prof_start = mbedtls_profile_op_start( MBEDTLS_PROFILE_OP_ECP_MUL );
+#endif
+
 #if defined(MBEDTLS_ECP_RESTARTABLE)
     if( rs_ctx != NULL && rs_ctx->ma != NULL )
     {
@@ -2648,6 +2687,10 @@ cleanup:
 
     ECP_RS_LEAVE( ma );
 
+#if defined(MBEDTLS_PROFILE_C)
+    mbedtls_profile_op_end( MBEDTLS_PROFILE_OP_ECP_MUL, prof_start, ret );
+#endif
+
     return( ret );
 }
 
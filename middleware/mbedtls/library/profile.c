@@ -0,0 +1,92 @@
+/*
+ *  Timing of expensive public key operations
+ *
+ *  Copyright 2026 NXP
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of mbed TLS (https://tls.mbed.org)
+ */
+/*
+ * A handshake spends most of its time in a handful of public key operations.
+ * These report to a global sink rather than to a context of their own, so
+ * that neither their prototypes nor the contexts in between (pk, ecdsa,
+ * x509) need to know about profiling.
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_PROFILE_C)
+
+#include "mbedtls/profile.h"
+#include "mbedtls/ecp.h"
+
+#include <stddef.h>
+
+static uint32_t (*profile_clock)( void );
+static mbedtls_profile_op_stats *profile_sink;
+/* nesting of each operation type, e.g. mbedtls_ecp_muladd() calling
+ * mbedtls_ecp_mul() */
+static unsigned char profile_depth[MBEDTLS_PROFILE_OPS];
+
+void mbedtls_profile_set_clock( uint32_t (*f_now)( void ) )
+{
+    profile_clock = f_now;
+}
+
+uint32_t mbedtls_profile_now( void )
+{
+    return( profile_clock != NULL ? profile_clock() : 0 );
+}
+
+mbedtls_profile_op_stats *mbedtls_profile_set_sink( mbedtls_profile_op_stats *ops )
+{
+    mbedtls_profile_op_stats *prev = profile_sink;
+
+    profile_sink = ops;
+
+    return( prev );
+}
+
+uint32_t mbedtls_profile_op_start( int op )
+{
+    if( profile_depth[op]++ != 0 || profile_sink == NULL )
+        return( 0 );
+
+    return( mbedtls_profile_now() );
+}
+
+void mbedtls_profile_op_end( int op, uint32_t start, int ret )
+{
+    mbedtls_profile_op_stats *stats;
+    uint32_t elapsed;
+
+    if( --profile_depth[op] != 0 || profile_sink == NULL )
+        return;
+
+    stats = &profile_sink[op];
+    elapsed = mbedtls_profile_now() - start;
+
+    stats->total_us += elapsed;
+    if( elapsed > stats->max_us )
+        stats->max_us = elapsed;
+    if( ret != MBEDTLS_ERR_ECP_IN_PROGRESS )
+        stats->count++;
+}
+
+#endif /* MBEDTLS_PROFILE_C */
@@ -52,6 +52,10 @@
 
 #include <string.h>
 
+#if defined(MBEDTLS_PROFILE_C)
+#include "mbedtls/profile.h"
+#endif
+
 #if defined(MBEDTLS_PKCS1_V21)
 #include "mbedtls/md.h"
 #endif
@@ -732,6 +736,9 @@ int mbedtls_rsa_public( mbedtls_rsa_context *ctx,
     int ret;
     size_t olen;
     mbedtls_mpi T;
+#if defined(MBEDTLS_PROFILE_C)
+    uint32_t prof_start;
+#endif
     RSA_VALIDATE_RET( ctx != NULL );
     RSA_VALIDATE_RET( input != NULL );
     RSA_VALIDATE_RET( output != NULL );
@@ -746,6 +753,10 @@ int mbedtls_rsa_public( mbedtls_rsa_context *ctx,
         return( ret );
 #endif
 
+#if defined(MBEDTLS_PROFILE_C)
+    prof_start = mbedtls_profile_op_start( MBEDTLS_PROFILE_OP_RSA_PUBLIC );
+#endif
+
     MBEDTLS_MPI_CHK( mbedtls_mpi_read_binary( &T, input, ctx->len ) );
 
     if( mbedtls_mpi_cmp_mpi( &T, &ctx->N ) >= 0 )
@@ -759,6 +770,10 @@ int mbedtls_rsa_public( mbedtls_rsa_context *ctx,
     MBEDTLS_MPI_CHK( mbedtls_mpi_write_binary( &T, output, olen ) );
 
 cleanup:
+#if defined(MBEDTLS_PROFILE_C)
+    mbedtls_profile_op_end( MBEDTLS_PROFILE_OP_RSA_PUBLIC, prof_start, ret );
+#endif
+
 #if defined(MBEDTLS_THREADING_C)
     if( mbedtls_mutex_unlock( &ctx->mutex ) != 0 )
         return( MBEDTLS_ERR_THREADING_MUTEX_ERROR );
@@ -879,6 +894,10 @@ int mbedtls_rsa_private( mbedtls_rsa_context *ctx,
      * checked result; should be the same in the end. */
     mbedtls_mpi I, C;
 
+#if defined(MBEDTLS_PROFILE_C)
+    uint32_t prof_start;
+#endif
+
     RSA_VALIDATE_RET( ctx != NULL );
     RSA_VALIDATE_RET( input  != NULL );
     RSA_VALIDATE_RET( output != NULL );
@@ -894,6 +913,10 @@ int mbedtls_rsa_private( mbedtls_rsa_context *ctx,
         return( ret );
 #endif
 
+#if defined(MBEDTLS_PROFILE_C)
+    prof_start = mbedtls_profile_op_start( MBEDTLS_PROFILE_OP_RSA_PRIVATE );
+#endif
+
     /* MPI Initialization */
     mbedtls_mpi_init( &T );
 
@@ -1031,6 +1054,10 @@ int mbedtls_rsa_private( mbedtls_rsa_context *ctx,
     MBEDTLS_MPI_CHK( mbedtls_mpi_write_binary( &T, output, olen ) );
 
 cleanup:
+#if defined(MBEDTLS_PROFILE_C)
+    mbedtls_profile_op_end( MBEDTLS_PROFILE_OP_RSA_PRIVATE, prof_start, ret );
+#endif
+
 #if defined(MBEDTLS_THREADING_C)
     if( mbedtls_mutex_unlock( &ctx->mutex ) != 0 )
         return( MBEDTLS_ERR_THREADING_MUTEX_ERROR );
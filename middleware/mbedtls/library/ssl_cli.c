@@ -3481,7 +3481,11 @@ static int ssl_parse_new_session_ticket( mbedtls_ssl_context *ssl )
     ssl->session_negotiate->ticket = NULL;
     ssl->session_negotiate->ticket_len = 0;
 
-    if( ( ticket = mbedtls_calloc( 1, ticket_len ) ) == NULL )
+    mbedtls_ssl_alloc_scope( ssl, MBEDTLS_SSL_ALLOC_SCOPE_SESSION );
+    ticket = mbedtls_calloc( 1, ticket_len );
+    mbedtls_ssl_alloc_scope( ssl, MBEDTLS_SSL_ALLOC_SCOPE_HANDSHAKE );
+
+    if( ticket == NULL )
     {
         MBEDTLS_SSL_DEBUG_MSG( 1, ( "ticket alloc failed" ) );
         mbedtls_ssl_send_alert_message( ssl, MBEDTLS_SSL_ALERT_LEVEL_FATAL,
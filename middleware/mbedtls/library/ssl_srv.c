@@ -540,8 +540,12 @@ static int ssl_parse_session_ticket_ext( mbedtls_ssl_context *ssl,
     /*
      * Failures are ok: just ignore the ticket and proceed.
      */
-    if( ( ret = ssl->conf->f_ticket_parse( ssl->conf->p_ticket, &session,
-                                           buf, len ) ) != 0 )
+    /* The parsed session replaces the negotiated one */
+    mbedtls_ssl_alloc_scope( ssl, MBEDTLS_SSL_ALLOC_SCOPE_SESSION );
+    ret = ssl->conf->f_ticket_parse( ssl->conf->p_ticket, &session, buf, len );
+    mbedtls_ssl_alloc_scope( ssl, MBEDTLS_SSL_ALLOC_SCOPE_HANDSHAKE );
+
+    if( ret != 0 )
     {
         mbedtls_ssl_session_free( &session );
 
@@ -2484,11 +2488,18 @@ static int ssl_write_server_hello( mbedtls_ssl_context *ssl )
         ssl->renego_status == MBEDTLS_SSL_INITIAL_HANDSHAKE &&
 #endif
         ssl->session_negotiate->id_len != 0 &&
-        ssl->conf->f_get_cache != NULL &&
-        ssl->conf->f_get_cache( ssl->conf->p_cache, ssl->session_negotiate ) == 0 )
+        ssl->conf->f_get_cache != NULL )
     {
-        MBEDTLS_SSL_DEBUG_MSG( 3, ( "session successfully restored from cache" ) );
-        ssl->handshake->resume = 1;
+        /* The cached session replaces the negotiated one */
+        mbedtls_ssl_alloc_scope( ssl, MBEDTLS_SSL_ALLOC_SCOPE_SESSION );
+        ret = ssl->conf->f_get_cache( ssl->conf->p_cache, ssl->session_negotiate );
+        mbedtls_ssl_alloc_scope( ssl, MBEDTLS_SSL_ALLOC_SCOPE_HANDSHAKE );
+
+        if( ret == 0 )
+        {
+            MBEDTLS_SSL_DEBUG_MSG( 3, ( "session successfully restored from cache" ) );
+            ssl->handshake->resume = 1;
+        }
     }
 
     if( ssl->handshake->resume == 0 )
@@ -2791,6 +2802,13 @@ static int ssl_write_certificate_request( mbedtls_ssl_context *ssl )
 
     if( ssl->conf->cert_req_ca_list ==  MBEDTLS_SSL_CERT_REQ_CA_LIST_ENABLED )
     {
+#if defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK)
+        /* The trusted CAs can't be listed when they come from a callback,
+         * which takes precedence over the CA chains */
+        if( ssl->conf->f_ca_cb != NULL )
+            crt = NULL;
+        else
+#endif
 #if defined(MBEDTLS_SSL_SERVER_NAME_INDICATION)
         if( ssl->handshake->sni_ca_chain != NULL )
             crt = ssl->handshake->sni_ca_chain;
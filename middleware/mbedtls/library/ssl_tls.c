@@ -607,7 +607,7 @@ static void ssl_calc_finished_tls_sha384( mbedtls_ssl_context *, unsigned char *
 #endif
 #endif /* MBEDTLS_SSL_PROTO_TLS1_2 */
 
-int mbedtls_ssl_derive_keys( mbedtls_ssl_context *ssl )
+static int ssl_derive_keys( mbedtls_ssl_context *ssl )
 {
     int ret = 0;
     unsigned char tmp[64];
@@ -1116,6 +1116,18 @@ int mbedtls_ssl_derive_keys( mbedtls_ssl_context *ssl )
     return( 0 );
 }
 
+int mbedtls_ssl_derive_keys( mbedtls_ssl_context *ssl )
+{
+    int ret;
+
+    /* The cipher and MAC contexts of the transform outlive the handshake */
+    mbedtls_ssl_alloc_scope( ssl, MBEDTLS_SSL_ALLOC_SCOPE_SESSION );
+    ret = ssl_derive_keys( ssl );
+    mbedtls_ssl_alloc_scope( ssl, MBEDTLS_SSL_ALLOC_SCOPE_HANDSHAKE );
+
+    return( ret );
+}
+
 #if defined(MBEDTLS_SSL_PROTO_SSL3)
 void ssl_calc_verify_ssl( mbedtls_ssl_context *ssl, unsigned char hash[36] )
 {
@@ -5714,7 +5726,12 @@ int mbedtls_ssl_parse_certificate( mbedtls_ssl_context *ssl )
         return( ret );
     }
 
-    if( ( ret = ssl_parse_certificate_chain( ssl ) ) != 0 )
+    /* The peer certificate is kept in the session */
+    mbedtls_ssl_alloc_scope( ssl, MBEDTLS_SSL_ALLOC_SCOPE_SESSION );
+    ret = ssl_parse_certificate_chain( ssl );
+    mbedtls_ssl_alloc_scope( ssl, MBEDTLS_SSL_ALLOC_SCOPE_HANDSHAKE );
+
+    if( ret != 0 )
     {
 #if defined(MBEDTLS_SSL_SRV_C)
         if( ret == MBEDTLS_ERR_SSL_NO_CLIENT_CERTIFICATE &&
@@ -5741,6 +5758,7 @@ crt_verify:
     {
         mbedtls_x509_crt *ca_chain;
         mbedtls_x509_crl *ca_crl;
+        int have_ca_chain;
 
 #if defined(MBEDTLS_SSL_SERVER_NAME_INDICATION)
         if( ssl->handshake->sni_ca_chain != NULL )
@@ -5755,9 +5773,50 @@ crt_verify:
             ca_crl   = ssl->conf->ca_crl;
         }
 
+        have_ca_chain = ( ca_chain != NULL );
+
         /*
          * Main check: verify certificate
          */
+#if defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK)
+        if( ssl->conf->f_ca_cb != NULL )
+        {
+            have_ca_chain = 1;
+
+#if defined(MBEDTLS_X509_VERIFY_CACHE_C)
+            if( ssl->conf->verify_cache != NULL )
+                ret = mbedtls_x509_verify_cache_verify_ca_cb(
+                                ssl->conf->verify_cache,
+                                ssl->session_negotiate->peer_cert,
+                                ssl->conf->f_ca_cb, ssl->conf->p_ca_cb,
+                                ssl->conf->cert_profile,
+                                ssl->hostname,
+                               &ssl->session_negotiate->verify_result,
+                                ssl->conf->f_vrfy, ssl->conf->p_vrfy, rs_ctx );
+            else
+#endif
+            ret = mbedtls_x509_crt_verify_restartable_ca_cb(
+                                ssl->session_negotiate->peer_cert,
+                                ssl->conf->f_ca_cb, ssl->conf->p_ca_cb,
+                                ssl->conf->cert_profile,
+                                ssl->hostname,
+                               &ssl->session_negotiate->verify_result,
+                                ssl->conf->f_vrfy, ssl->conf->p_vrfy, rs_ctx );
+        }
+        else
+#endif /* MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK */
+#if defined(MBEDTLS_X509_VERIFY_CACHE_C)
+        if( ssl->conf->verify_cache != NULL )
+            ret = mbedtls_x509_verify_cache_verify(
+                                ssl->conf->verify_cache,
+                                ssl->session_negotiate->peer_cert,
+                                ca_chain, ca_crl,
+                                ssl->conf->cert_profile,
+                                ssl->hostname,
+                               &ssl->session_negotiate->verify_result,
+                                ssl->conf->f_vrfy, ssl->conf->p_vrfy, rs_ctx );
+        else
+#endif
         ret = mbedtls_x509_crt_verify_restartable(
                                 ssl->session_negotiate->peer_cert,
                                 ca_chain, ca_crl,
@@ -5820,7 +5879,7 @@ crt_verify:
             ret = 0;
         }
 
-        if( ca_chain == NULL && authmode == MBEDTLS_SSL_VERIFY_REQUIRED )
+        if( have_ca_chain == 0 && authmode == MBEDTLS_SSL_VERIFY_REQUIRED )
         {
             MBEDTLS_SSL_DEBUG_MSG( 1, ( "got no CA chain" ) );
             ret = MBEDTLS_ERR_SSL_CA_CHAIN_REQUIRED;
@@ -6381,8 +6440,10 @@ void mbedtls_ssl_handshake_wrapup( mbedtls_ssl_context *ssl )
         ssl->session->id_len != 0 &&
         resume == 0 )
     {
+        mbedtls_ssl_alloc_scope( ssl, MBEDTLS_SSL_ALLOC_SCOPE_SHARED );
         if( ssl->conf->f_set_cache( ssl->conf->p_cache, ssl->session ) != 0 )
             MBEDTLS_SSL_DEBUG_MSG( 1, ( "cache did not store session" ) );
+        mbedtls_ssl_alloc_scope( ssl, MBEDTLS_SSL_ALLOC_SCOPE_HANDSHAKE );
     }
 
 #if defined(MBEDTLS_SSL_PROTO_DTLS)
@@ -6728,6 +6789,10 @@ static int ssl_handshake_init( mbedtls_ssl_context *ssl )
     ssl_transform_init( ssl->transform_negotiate );
     ssl_handshake_params_init( ssl->handshake );
 
+#if defined(MBEDTLS_SSL_HANDSHAKE_PROFILE)
+    memset( &ssl->profile, 0, sizeof( ssl->profile ) );
+#endif
+
 #if defined(MBEDTLS_SSL_PROTO_DTLS)
     if( ssl->conf->transport == MBEDTLS_SSL_TRANSPORT_DATAGRAM )
     {
@@ -7289,7 +7354,47 @@ void mbedtls_ssl_conf_ca_chain( mbedtls_ssl_config *conf,
 {
     conf->ca_chain   = ca_chain;
     conf->ca_crl     = ca_crl;
+
+#if defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK)
+    /* mbedtls_ssl_conf_ca_chain() and mbedtls_ssl_conf_ca_cb()
+     * cannot be used together. */
+    conf->f_ca_cb = NULL;
+    conf->p_ca_cb = NULL;
+#endif /* MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK */
+
+#if defined(MBEDTLS_X509_VERIFY_CACHE_C)
+    if( conf->verify_cache != NULL )
+        mbedtls_x509_verify_cache_clear( conf->verify_cache );
+#endif
+}
+
+#if defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK)
+void mbedtls_ssl_conf_ca_cb( mbedtls_ssl_config *conf,
+                             mbedtls_x509_crt_ca_cb_t f_ca_cb,
+                             void *p_ca_cb )
+{
+    conf->f_ca_cb = f_ca_cb;
+    conf->p_ca_cb = p_ca_cb;
+
+    /* mbedtls_ssl_conf_ca_chain() and mbedtls_ssl_conf_ca_cb()
+     * cannot be used together. */
+    conf->ca_chain   = NULL;
+    conf->ca_crl     = NULL;
+
+#if defined(MBEDTLS_X509_VERIFY_CACHE_C)
+    if( conf->verify_cache != NULL )
+        mbedtls_x509_verify_cache_clear( conf->verify_cache );
+#endif
 }
+#endif /* MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK */
+
+#if defined(MBEDTLS_X509_VERIFY_CACHE_C)
+void mbedtls_ssl_conf_verify_cache( mbedtls_ssl_config *conf,
+                                    mbedtls_x509_verify_cache *cache )
+{
+    conf->verify_cache = cache;
+}
+#endif
 #endif /* MBEDTLS_X509_CRT_PARSE_C */
 
 #if defined(MBEDTLS_SSL_SERVER_NAME_INDICATION)
@@ -7735,6 +7840,33 @@ void mbedtls_ssl_conf_export_keys_cb( mbedtls_ssl_config *conf,
 }
 #endif
 
+#if defined(MBEDTLS_SSL_ALLOC_SCOPE)
+void mbedtls_ssl_conf_alloc_scope( mbedtls_ssl_config *conf,
+        void (*f_alloc_scope)( void *, mbedtls_ssl_context *, int ),
+        void *p_alloc_scope )
+{
+    conf->f_alloc_scope = f_alloc_scope;
+    conf->p_alloc_scope = p_alloc_scope;
+}
+#endif
+
+#if defined(MBEDTLS_SSL_HANDSHAKE_PROFILE)
+void mbedtls_ssl_conf_handshake_profile( mbedtls_ssl_config *conf,
+        void (*f_profile)( void *, const mbedtls_ssl_context *,
+                           const mbedtls_ssl_handshake_profile * ),
+        void *p_profile )
+{
+    conf->f_handshake_profile = f_profile;
+    conf->p_handshake_profile = p_profile;
+}
+
+const mbedtls_ssl_handshake_profile *mbedtls_ssl_get_handshake_profile(
+        const mbedtls_ssl_context *ssl )
+{
+    return( &ssl->profile );
+}
+#endif
+
 #if defined(MBEDTLS_SSL_ASYNC_PRIVATE)
 void mbedtls_ssl_conf_async_private_cb(
     mbedtls_ssl_config *conf,
@@ -8063,16 +8195,65 @@ int mbedtls_ssl_get_session( const mbedtls_ssl_context *ssl, mbedtls_ssl_session
 }
 #endif /* MBEDTLS_SSL_CLI_C */
 
+#if defined(MBEDTLS_SSL_HANDSHAKE_PROFILE)
+/*
+ * Add the time of a handshake step to the state it started in
+ */
+static void ssl_profile_step( mbedtls_ssl_context *ssl, int state,
+                              uint32_t start )
+{
+    mbedtls_ssl_handshake_profile *prof = &ssl->profile;
+    uint32_t now = mbedtls_profile_now();
+
+    prof->steps++;
+    if( state < 0 || state >= MBEDTLS_SSL_PROFILE_STATES )
+        return;
+
+    prof->busy_us[state] += now - start;
+    if( ssl->state == state )
+        return;
+
+    prof->state_us[state] += now - prof->state_start_us;
+    prof->state_start_us = now;
+
+    if( ssl->state == MBEDTLS_SSL_HANDSHAKE_OVER )
+    {
+        prof->total_us = now - prof->start_us;
+        prof->done = 1;
+
+        if( ssl->conf->f_handshake_profile != NULL )
+            ssl->conf->f_handshake_profile( ssl->conf->p_handshake_profile,
+                                            ssl, prof );
+    }
+}
+#endif /* MBEDTLS_SSL_HANDSHAKE_PROFILE */
+
 /*
  * Perform a single step of the SSL handshake
  */
 int mbedtls_ssl_handshake_step( mbedtls_ssl_context *ssl )
 {
     int ret = MBEDTLS_ERR_SSL_FEATURE_UNAVAILABLE;
+#if defined(MBEDTLS_SSL_HANDSHAKE_PROFILE)
+    mbedtls_profile_op_stats *prev_sink;
+    int prof_state;
+    uint32_t prof_start;
+#endif
 
     if( ssl == NULL || ssl->conf == NULL )
         return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
 
+#if defined(MBEDTLS_SSL_HANDSHAKE_PROFILE)
+    prof_state = ssl->state;
+    prof_start = mbedtls_profile_now();
+    if( ssl->profile.steps == 0 )
+    {
+        ssl->profile.start_us = prof_start;
+        ssl->profile.state_start_us = prof_start;
+    }
+    prev_sink = mbedtls_profile_set_sink( ssl->profile.ops );
+#endif
+
 #if defined(MBEDTLS_SSL_CLI_C)
     if( ssl->conf->endpoint == MBEDTLS_SSL_IS_CLIENT )
         ret = mbedtls_ssl_handshake_client_step( ssl );
@@ -8082,6 +8263,11 @@ int mbedtls_ssl_handshake_step( mbedtls_ssl_context *ssl )
         ret = mbedtls_ssl_handshake_server_step( ssl );
 #endif
 
+#if defined(MBEDTLS_SSL_HANDSHAKE_PROFILE)
+    mbedtls_profile_set_sink( prev_sink );
+    ssl_profile_step( ssl, prof_state, prof_start );
+#endif
+
     return( ret );
 }
 
@@ -510,6 +510,12 @@ static const char *features[] = {
 #if defined(MBEDTLS_SSL_EXPORT_KEYS)
     "MBEDTLS_SSL_EXPORT_KEYS",
 #endif /* MBEDTLS_SSL_EXPORT_KEYS */
+#if defined(MBEDTLS_SSL_ALLOC_SCOPE)
+    "MBEDTLS_SSL_ALLOC_SCOPE",
+#endif /* MBEDTLS_SSL_ALLOC_SCOPE */
+#if defined(MBEDTLS_SSL_HANDSHAKE_PROFILE)
+    "MBEDTLS_SSL_HANDSHAKE_PROFILE",
+#endif /* MBEDTLS_SSL_HANDSHAKE_PROFILE */
 #if defined(MBEDTLS_SSL_SERVER_NAME_INDICATION)
     "MBEDTLS_SSL_SERVER_NAME_INDICATION",
 #endif /* MBEDTLS_SSL_SERVER_NAME_INDICATION */
@@ -540,6 +546,9 @@ static const char *features[] = {
 #if defined(MBEDTLS_X509_CHECK_EXTENDED_KEY_USAGE)
     "MBEDTLS_X509_CHECK_EXTENDED_KEY_USAGE",
 #endif /* MBEDTLS_X509_CHECK_EXTENDED_KEY_USAGE */
+#if defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK)
+    "MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK",
+#endif /* MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK */
 #if defined(MBEDTLS_X509_RSASSA_PSS_SUPPORT)
     "MBEDTLS_X509_RSASSA_PSS_SUPPORT",
 #endif /* MBEDTLS_X509_RSASSA_PSS_SUPPORT */
@@ -693,6 +702,9 @@ static const char *features[] = {
 #if defined(MBEDTLS_POLY1305_C)
     "MBEDTLS_POLY1305_C",
 #endif /* MBEDTLS_POLY1305_C */
+#if defined(MBEDTLS_PROFILE_C)
+    "MBEDTLS_PROFILE_C",
+#endif /* MBEDTLS_PROFILE_C */
 #if defined(MBEDTLS_RIPEMD160_C)
     "MBEDTLS_RIPEMD160_C",
 #endif /* MBEDTLS_RIPEMD160_C */
@@ -741,6 +753,12 @@ static const char *features[] = {
 #if defined(MBEDTLS_X509_CRT_PARSE_C)
     "MBEDTLS_X509_CRT_PARSE_C",
 #endif /* MBEDTLS_X509_CRT_PARSE_C */
+#if defined(MBEDTLS_X509_VERIFY_CACHE_C)
+    "MBEDTLS_X509_VERIFY_CACHE_C",
+#endif /* MBEDTLS_X509_VERIFY_CACHE_C */
+#if defined(MBEDTLS_X509_CRT_BUNDLE_C)
+    "MBEDTLS_X509_CRT_BUNDLE_C",
+#endif /* MBEDTLS_X509_CRT_BUNDLE_C */
 #if defined(MBEDTLS_X509_CRL_PARSE_C)
     "MBEDTLS_X509_CRL_PARSE_C",
 #endif /* MBEDTLS_X509_CRL_PARSE_C */
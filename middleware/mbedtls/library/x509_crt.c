@@ -63,6 +63,10 @@
 #include "mbedtls/threading.h"
 #endif
 
+#if defined(MBEDTLS_PROFILE_C)
+#include "mbedtls/profile.h"
+#endif
+
 #if defined(_WIN32) && !defined(EFIX64) && !defined(EFI32)
 #include <windows.h>
 #else
@@ -372,6 +376,10 @@ static void x509_crt_verify_chain_reset(
     }
 
     ver_chain->len = 0;
+
+#if defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK)
+    ver_chain->trust_ca_cb_result = NULL;
+#endif /* MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK */
 }
 
 /*
@@ -2244,6 +2252,8 @@ static int x509_crt_check_ee_locally_trusted(
  * Arguments:
  *  - [in] crt: the cert list EE, C1, ..., Cn
  *  - [in] trust_ca: the trusted list R1, ..., Rp
+ *  - [in] f_ca_cb, p_ca_cb: if not NULL, callback providing the trusted
+ *         certs for each child instead of trust_ca
  *  - [in] ca_crl, profile: as in verify_with_profile()
  *  - [out] ver_chain: the built and verified chain
  *      Only valid when return value is 0, may contain garbage otherwise!
@@ -2258,6 +2268,8 @@ static int x509_crt_check_ee_locally_trusted(
 static int x509_crt_verify_chain(
                 mbedtls_x509_crt *crt,
                 mbedtls_x509_crt *trust_ca,
+                mbedtls_x509_crt_ca_cb_t f_ca_cb,
+                void *p_ca_cb,
                 mbedtls_x509_crl *ca_crl,
                 const mbedtls_x509_crt_profile *profile,
                 mbedtls_x509_crt_verify_chain *ver_chain,
@@ -2270,6 +2282,7 @@ static int x509_crt_verify_chain(
     mbedtls_x509_crt_verify_chain_item *cur;
     mbedtls_x509_crt *child;
     mbedtls_x509_crt *parent;
+    mbedtls_x509_crt *cur_trust_ca;
     int parent_is_trusted;
     int child_is_trusted;
     int signature_is_good;
@@ -2282,11 +2295,21 @@ static int x509_crt_verify_chain(
         /* restore saved state */
         *ver_chain = rs_ctx->ver_chain; /* struct copy */
         self_cnt = rs_ctx->self_cnt;
+#if defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK)
+        /* the candidate signers belong to ver_chain again */
+        rs_ctx->ver_chain.trust_ca_cb_result = NULL;
+#endif
 
         /* restore derived state */
         cur = &ver_chain->items[ver_chain->len - 1];
         child = cur->crt;
         flags = &cur->flags;
+#if defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK)
+        if( f_ca_cb != NULL )
+            cur_trust_ca = ver_chain->trust_ca_cb_result;
+        else
+#endif
+            cur_trust_ca = trust_ca;
 
         goto find_parent;
     }
@@ -2323,9 +2346,32 @@ static int x509_crt_verify_chain(
         if( x509_profile_check_pk_alg( profile, child->sig_pk ) != 0 )
             *flags |= MBEDTLS_X509_BADCERT_BAD_PK;
 
+#if defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK)
+        /* Obtain list of potential trusted signers from CA callback,
+         * or use statically provided list. */
+        if( f_ca_cb != NULL )
+        {
+            mbedtls_x509_crt_free( ver_chain->trust_ca_cb_result );
+            mbedtls_free( ver_chain->trust_ca_cb_result );
+            ver_chain->trust_ca_cb_result = NULL;
+
+            ret = f_ca_cb( p_ca_cb, child, &ver_chain->trust_ca_cb_result );
+            if( ret != 0 )
+                return( MBEDTLS_ERR_X509_FATAL_ERROR );
+
+            cur_trust_ca = ver_chain->trust_ca_cb_result;
+        }
+        else
+#endif /* MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK */
+        {
+            ((void) f_ca_cb);
+            ((void) p_ca_cb);
+            cur_trust_ca = trust_ca;
+        }
+
         /* Special case: EE certs that are locally trusted */
         if( ver_chain->len == 1 &&
-            x509_crt_check_ee_locally_trusted( child, trust_ca ) == 0 )
+            x509_crt_check_ee_locally_trusted( child, cur_trust_ca ) == 0 )
         {
             return( 0 );
         }
@@ -2334,7 +2380,7 @@ static int x509_crt_verify_chain(
 find_parent:
 #endif
         /* Look for a parent in trusted CAs or up the chain */
-        ret = x509_crt_find_parent( child, trust_ca, &parent,
+        ret = x509_crt_find_parent( child, cur_trust_ca, &parent,
                                        &parent_is_trusted, &signature_is_good,
                                        ver_chain->len - 1, self_cnt, rs_ctx );
 
@@ -2528,10 +2574,19 @@ int mbedtls_x509_crt_verify_with_profile( mbedtls_x509_crt *crt,
  *    as that isn't done as part of chain building/verification currently
  *  - builds and verifies the chain
  *  - then calls the callback and merges the flags
+ *
+ * The parameters pairs `trust_ca`, `ca_crl` and `f_ca_cb`, `p_ca_cb`
+ * are mutually exclusive: If `f_ca_cb != NULL`, it will be used by the
+ * verification routine to search for trusted signers, and CRLs will
+ * be disabled. Otherwise, `trust_ca` will be used as the static list
+ * of trusted signers, and `ca_crl` will be use as the static list
+ * of CRLs.
  */
-int mbedtls_x509_crt_verify_restartable( mbedtls_x509_crt *crt,
+static int x509_crt_verify_restartable_ca_cb( mbedtls_x509_crt *crt,
                      mbedtls_x509_crt *trust_ca,
                      mbedtls_x509_crl *ca_crl,
+                     mbedtls_x509_crt_ca_cb_t f_ca_cb,
+                     void *p_ca_cb,
                      const mbedtls_x509_crt_profile *profile,
                      const char *cn, uint32_t *flags,
                      int (*f_vrfy)(void *, mbedtls_x509_crt *, int, uint32_t *),
@@ -2542,6 +2597,11 @@ int mbedtls_x509_crt_verify_restartable( mbedtls_x509_crt *crt,
     mbedtls_pk_type_t pk_type;
     mbedtls_x509_crt_verify_chain ver_chain;
     uint32_t ee_flags;
+#if defined(MBEDTLS_PROFILE_C)
+    uint32_t prof_start;
+
+    prof_start = mbedtls_profile_op_start( MBEDTLS_PROFILE_OP_X509_VERIFY );
+#endif
 
     *flags = 0;
     ee_flags = 0;
@@ -2567,8 +2627,8 @@ int mbedtls_x509_crt_verify_restartable( mbedtls_x509_crt *crt,
         ee_flags |= MBEDTLS_X509_BADCERT_BAD_KEY;
 
     /* Check the chain */
-    ret = x509_crt_verify_chain( crt, trust_ca, ca_crl, profile,
-                                 &ver_chain, rs_ctx );
+    ret = x509_crt_verify_chain( crt, trust_ca, f_ca_cb, p_ca_cb, ca_crl,
+                                 profile, &ver_chain, rs_ctx );
 
     if( ret != 0 )
         goto exit;
@@ -2580,6 +2640,18 @@ int mbedtls_x509_crt_verify_restartable( mbedtls_x509_crt *crt,
     ret = x509_crt_merge_flags_with_cb( flags, &ver_chain, f_vrfy, p_vrfy );
 
 exit:
+#if defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK)
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_RESTARTABLE)
+    /* rs_ctx keeps the candidate signers while in progress */
+    if( rs_ctx == NULL || ret != MBEDTLS_ERR_ECP_IN_PROGRESS )
+#endif
+    {
+        mbedtls_x509_crt_free( ver_chain.trust_ca_cb_result );
+        mbedtls_free( ver_chain.trust_ca_cb_result );
+        ver_chain.trust_ca_cb_result = NULL;
+    }
+#endif /* MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK */
+
 #if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_RESTARTABLE)
     if( rs_ctx != NULL && ret != MBEDTLS_ERR_ECP_IN_PROGRESS )
         mbedtls_x509_crt_restart_free( rs_ctx );
@@ -2591,6 +2663,10 @@ exit:
     if( ret == MBEDTLS_ERR_X509_CERT_VERIFY_FAILED )
         ret = MBEDTLS_ERR_X509_FATAL_ERROR;
 
+#if defined(MBEDTLS_PROFILE_C)
+    mbedtls_profile_op_end( MBEDTLS_PROFILE_OP_X509_VERIFY, prof_start, ret );
+#endif
+
     if( ret != 0 )
     {
         *flags = (uint32_t) -1;
@@ -2603,6 +2679,57 @@ exit:
     return( 0 );
 }
 
+/*
+ * Verify the certificate validity, with profile, restartable version
+ */
+int mbedtls_x509_crt_verify_restartable( mbedtls_x509_crt *crt,
+                     mbedtls_x509_crt *trust_ca,
+                     mbedtls_x509_crl *ca_crl,
+                     const mbedtls_x509_crt_profile *profile,
+                     const char *cn, uint32_t *flags,
+                     int (*f_vrfy)(void *, mbedtls_x509_crt *, int, uint32_t *),
+                     void *p_vrfy,
+                     mbedtls_x509_crt_restart_ctx *rs_ctx )
+{
+    return( x509_crt_verify_restartable_ca_cb( crt, trust_ca, ca_crl,
+                NULL, NULL, profile, cn, flags, f_vrfy, p_vrfy, rs_ctx ) );
+}
+
+#if defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK)
+/*
+ * Verify the certificate validity (user-chosen profile, CA callback,
+ * not restartable).
+ */
+int mbedtls_x509_crt_verify_with_ca_cb( mbedtls_x509_crt *crt,
+                     mbedtls_x509_crt_ca_cb_t f_ca_cb,
+                     void *p_ca_cb,
+                     const mbedtls_x509_crt_profile *profile,
+                     const char *cn, uint32_t *flags,
+                     int (*f_vrfy)(void *, mbedtls_x509_crt *, int, uint32_t *),
+                     void *p_vrfy )
+{
+    return( x509_crt_verify_restartable_ca_cb( crt, NULL, NULL,
+                f_ca_cb, p_ca_cb, profile, cn, flags, f_vrfy, p_vrfy, NULL ) );
+}
+
+/*
+ * Verify the certificate validity (user-chosen profile, CA callback,
+ * restartable).
+ */
+int mbedtls_x509_crt_verify_restartable_ca_cb( mbedtls_x509_crt *crt,
+                     mbedtls_x509_crt_ca_cb_t f_ca_cb,
+                     void *p_ca_cb,
+                     const mbedtls_x509_crt_profile *profile,
+                     const char *cn, uint32_t *flags,
+                     int (*f_vrfy)(void *, mbedtls_x509_crt *, int, uint32_t *),
+                     void *p_vrfy,
+                     mbedtls_x509_crt_restart_ctx *rs_ctx )
+{
+    return( x509_crt_verify_restartable_ca_cb( crt, NULL, NULL,
+                f_ca_cb, p_ca_cb, profile, cn, flags, f_vrfy, p_vrfy, rs_ctx ) );
+}
+#endif /* MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK */
+
 /*
  * Initialize a certificate chain
  */
@@ -2723,6 +2850,11 @@ void mbedtls_x509_crt_restart_free( mbedtls_x509_crt_restart_ctx *ctx )
         return;
 
     mbedtls_pk_restart_free( &ctx->pk );
+#if defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK)
+    /* candidate signers of an abandoned verification */
+    mbedtls_x509_crt_free( ctx->ver_chain.trust_ca_cb_result );
+    mbedtls_free( ctx->ver_chain.trust_ca_cb_result );
+#endif
     mbedtls_x509_crt_restart_init( ctx );
 }
 #endif /* MBEDTLS_ECDSA_C && MBEDTLS_ECP_RESTARTABLE */
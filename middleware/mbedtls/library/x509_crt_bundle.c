@@ -0,0 +1,344 @@
+/*
+ *  Flash resident bundle of trusted X.509 CA certificates
+ *
+ *  Copyright 2026 NXP
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of mbed TLS (https://tls.mbed.org)
+ */
+/*
+ * A trust store parsed with mbedtls_x509_crt_parse() costs RAM for every CA
+ * (the DER copy, the names, the public key), although a handshake only needs
+ * the issuer of the peer chain. A bundle keeps the DER in flash behind an
+ * index of subject name hashes, so the trusted certificate callback parses
+ * just the CAs named as issuer by the certificate being verified, and frees
+ * them again when the verification is done.
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_X509_CRT_BUNDLE_C)
+
+#include "mbedtls/x509_crt_bundle.h"
+#include "mbedtls/asn1.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/platform_util.h"
+
+#include <string.h>
+
+#if defined(MBEDTLS_PLATFORM_C)
+#include "mbedtls/platform.h"
+#else
+#include <stdlib.h>
+#define mbedtls_free       free
+#define mbedtls_calloc    calloc
+#endif
+
+#define X509_BUNDLE_GET_UINT32( p )                             \
+    ( ( (uint32_t) (p)[0] << 24 ) | ( (uint32_t) (p)[1] << 16 ) | \
+      ( (uint32_t) (p)[2] <<  8 ) | ( (uint32_t) (p)[3]       ) )
+
+void mbedtls_x509_crt_bundle_init( mbedtls_x509_crt_bundle *bundle )
+{
+    memset( bundle, 0, sizeof( mbedtls_x509_crt_bundle ) );
+}
+
+void mbedtls_x509_crt_bundle_free( mbedtls_x509_crt_bundle *bundle )
+{
+    if( bundle == NULL )
+        return;
+
+    mbedtls_platform_zeroize( bundle, sizeof( mbedtls_x509_crt_bundle ) );
+}
+
+int mbedtls_x509_crt_bundle_is_bundle( const unsigned char *buf,
+                                       size_t buflen )
+{
+    return( buf != NULL && buflen >= MBEDTLS_X509_CRT_BUNDLE_MAGIC_LEN &&
+            memcmp( buf, MBEDTLS_X509_CRT_BUNDLE_MAGIC,
+                    MBEDTLS_X509_CRT_BUNDLE_MAGIC_LEN ) == 0 );
+}
+
+int mbedtls_x509_crt_bundle_load( mbedtls_x509_crt_bundle *bundle,
+                                  const unsigned char *buf, size_t buflen )
+{
+    size_t i, count, data_start;
+    const unsigned char *entry;
+
+    if( ! mbedtls_x509_crt_bundle_is_bundle( buf, buflen ) ||
+        buflen < MBEDTLS_X509_CRT_BUNDLE_HEADER_SIZE )
+    {
+        return( MBEDTLS_ERR_X509_INVALID_FORMAT );
+    }
+
+    count = X509_BUNDLE_GET_UINT32( buf + MBEDTLS_X509_CRT_BUNDLE_MAGIC_LEN );
+    if( count > ( buflen - MBEDTLS_X509_CRT_BUNDLE_HEADER_SIZE ) /
+                MBEDTLS_X509_CRT_BUNDLE_ENTRY_SIZE )
+    {
+        return( MBEDTLS_ERR_X509_INVALID_FORMAT );
+    }
+
+    data_start = MBEDTLS_X509_CRT_BUNDLE_HEADER_SIZE +
+                 count * MBEDTLS_X509_CRT_BUNDLE_ENTRY_SIZE;
+    entry = buf + MBEDTLS_X509_CRT_BUNDLE_HEADER_SIZE;
+
+    for( i = 0; i < count; i++, entry += MBEDTLS_X509_CRT_BUNDLE_ENTRY_SIZE )
+    {
+        size_t offset = X509_BUNDLE_GET_UINT32(
+                            entry + MBEDTLS_X509_CRT_BUNDLE_HASH_LEN );
+        size_t len = X509_BUNDLE_GET_UINT32(
+                            entry + MBEDTLS_X509_CRT_BUNDLE_HASH_LEN + 4 );
+
+        if( offset < data_start || offset > buflen ||
+            len == 0 || len > buflen - offset )
+        {
+            return( MBEDTLS_ERR_X509_INVALID_FORMAT );
+        }
+
+        /* lookups rely on the order */
+        if( i > 0 && memcmp( entry - MBEDTLS_X509_CRT_BUNDLE_ENTRY_SIZE, entry,
+                             MBEDTLS_X509_CRT_BUNDLE_HASH_LEN ) > 0 )
+        {
+            return( MBEDTLS_ERR_X509_INVALID_FORMAT );
+        }
+    }
+
+    bundle->buf = buf;
+    bundle->buflen = buflen;
+    bundle->count = count;
+
+    return( 0 );
+}
+
+/*
+ * Hash a name so that the names x509_name_cmp() finds equal hash the same:
+ * UTF8String and PrintableString values are hashed as lower case UTF8String,
+ * as issuers don't always use the string type of their subject. Each
+ * attribute is hashed as
+ *      merged (1 byte), tag (1), OID length (2), value length (2), OID, value
+ * which scripts/x509_crt_bundle.py must match.
+ */
+static int x509_bundle_name_hash( const mbedtls_x509_name *name,
+                                  unsigned char hash[32] )
+{
+    int ret;
+    size_t i, n;
+    unsigned char buf[32];
+    mbedtls_sha256_context sha;
+
+    mbedtls_sha256_init( &sha );
+
+    if( ( ret = mbedtls_sha256_starts_ret( &sha, 0 ) ) != 0 )
+        goto exit;
+
+    for( ; name != NULL; name = name->next )
+    {
+        int fold = ( name->val.tag == MBEDTLS_ASN1_UTF8_STRING ||
+                     name->val.tag == MBEDTLS_ASN1_PRINTABLE_STRING );
+
+        /* empty name */
+        if( name->oid.p == NULL )
+            continue;
+
+        buf[0] = name->next_merged;
+        buf[1] = fold ? MBEDTLS_ASN1_UTF8_STRING : (unsigned char) name->val.tag;
+        buf[2] = (unsigned char)( name->oid.len >> 8 );
+        buf[3] = (unsigned char)( name->oid.len      );
+        buf[4] = (unsigned char)( name->val.len >> 8 );
+        buf[5] = (unsigned char)( name->val.len      );
+
+        if( ( ret = mbedtls_sha256_update_ret( &sha, buf, 6 ) ) != 0 ||
+            ( ret = mbedtls_sha256_update_ret( &sha, name->oid.p,
+                                               name->oid.len ) ) != 0 )
+        {
+            goto exit;
+        }
+
+        if( ! fold )
+        {
+            if( ( ret = mbedtls_sha256_update_ret( &sha, name->val.p,
+                                                   name->val.len ) ) != 0 )
+                goto exit;
+            continue;
+        }
+
+        for( i = 0; i < name->val.len; i += n )
+        {
+            size_t j;
+
+            n = name->val.len - i < sizeof( buf ) ? name->val.len - i
+                                                  : sizeof( buf );
+            for( j = 0; j < n; j++ )
+            {
+                unsigned char c = name->val.p[i + j];
+                buf[j] = ( c >= 'A' && c <= 'Z' ) ? c + 32 : c;
+            }
+
+            if( ( ret = mbedtls_sha256_update_ret( &sha, buf, n ) ) != 0 )
+                goto exit;
+        }
+    }
+
+    ret = mbedtls_sha256_finish_ret( &sha, hash );
+
+exit:
+    mbedtls_sha256_free( &sha );
+
+    return( ret );
+}
+
+/*
+ * Find the first index entry with the hash of name, if any
+ */
+static int x509_bundle_lookup( const mbedtls_x509_crt_bundle *bundle,
+                               const mbedtls_x509_name *name,
+                               unsigned char hash[32],
+                               size_t *first )
+{
+    int ret;
+    size_t lo = 0, hi = bundle->count;
+    const unsigned char *index = bundle->buf +
+                                 MBEDTLS_X509_CRT_BUNDLE_HEADER_SIZE;
+
+    if( ( ret = x509_bundle_name_hash( name, hash ) ) != 0 )
+        return( ret );
+
+    /* lower bound */
+    while( lo < hi )
+    {
+        size_t mid = lo + ( hi - lo ) / 2;
+
+        if( memcmp( index + mid * MBEDTLS_X509_CRT_BUNDLE_ENTRY_SIZE, hash,
+                    MBEDTLS_X509_CRT_BUNDLE_HASH_LEN ) < 0 )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    *first = lo;
+
+    return( 0 );
+}
+
+static int x509_bundle_match( const mbedtls_x509_crt_bundle *bundle,
+                              size_t i, const unsigned char hash[32] )
+{
+    return( i < bundle->count &&
+            memcmp( bundle->buf + MBEDTLS_X509_CRT_BUNDLE_HEADER_SIZE +
+                    i * MBEDTLS_X509_CRT_BUNDLE_ENTRY_SIZE, hash,
+                    MBEDTLS_X509_CRT_BUNDLE_HASH_LEN ) == 0 );
+}
+
+/*
+ * Parse the certificates from index entry i on that have the given hash
+ */
+static int x509_bundle_parse( mbedtls_x509_crt_bundle *bundle, size_t i,
+                              const unsigned char hash[32],
+                              mbedtls_x509_crt *chain )
+{
+    int ret, added = 0;
+
+    for( ; x509_bundle_match( bundle, i, hash ); i++ )
+    {
+        const unsigned char *entry = bundle->buf +
+                                     MBEDTLS_X509_CRT_BUNDLE_HEADER_SIZE +
+                                     i * MBEDTLS_X509_CRT_BUNDLE_ENTRY_SIZE;
+        size_t offset = X509_BUNDLE_GET_UINT32(
+                            entry + MBEDTLS_X509_CRT_BUNDLE_HASH_LEN );
+        size_t len = X509_BUNDLE_GET_UINT32(
+                            entry + MBEDTLS_X509_CRT_BUNDLE_HASH_LEN + 4 );
+
+        ret = mbedtls_x509_crt_parse_der( chain, bundle->buf + offset, len );
+        bundle->parsed++;
+
+        /* Like mbedtls_x509_crt_parse(), skip certificates this build can't
+         * handle (e.g. disabled curves): they can't be issuers anyway */
+        if( ret == MBEDTLS_ERR_X509_ALLOC_FAILED )
+            return( ret );
+        if( ret == 0 )
+            added++;
+    }
+
+    return( added );
+}
+
+int mbedtls_x509_crt_bundle_find( mbedtls_x509_crt_bundle *bundle,
+                                  const mbedtls_x509_name *name,
+                                  mbedtls_x509_crt *chain )
+{
+    int ret;
+    size_t first;
+    unsigned char hash[32];
+
+    if( bundle == NULL || bundle->buf == NULL || name == NULL ||
+        chain == NULL )
+    {
+        return( MBEDTLS_ERR_X509_BAD_INPUT_DATA );
+    }
+
+    if( ( ret = x509_bundle_lookup( bundle, name, hash, &first ) ) != 0 )
+        return( ret );
+
+    return( x509_bundle_parse( bundle, first, hash, chain ) );
+}
+
+int mbedtls_x509_crt_bundle_ca_cb( void *p_bundle,
+                                   mbedtls_x509_crt const *child,
+                                   mbedtls_x509_crt **candidate_cas )
+{
+    int ret;
+    size_t first;
+    unsigned char hash[32];
+    mbedtls_x509_crt *list;
+    mbedtls_x509_crt_bundle *bundle = (mbedtls_x509_crt_bundle *) p_bundle;
+
+    *candidate_cas = NULL;
+
+    if( bundle == NULL || bundle->buf == NULL )
+        return( MBEDTLS_ERR_X509_BAD_INPUT_DATA );
+
+    /* most certificates looked up are not issued by a bundle CA, spare
+     * the allocation for them */
+    if( ( ret = x509_bundle_lookup( bundle, &child->issuer, hash,
+                                    &first ) ) != 0 )
+        return( ret );
+
+    if( ! x509_bundle_match( bundle, first, hash ) )
+        return( 0 );
+
+    list = mbedtls_calloc( 1, sizeof( mbedtls_x509_crt ) );
+    if( list == NULL )
+        return( MBEDTLS_ERR_X509_ALLOC_FAILED );
+
+    mbedtls_x509_crt_init( list );
+
+    ret = x509_bundle_parse( bundle, first, hash, list );
+    if( ret <= 0 )
+    {
+        mbedtls_x509_crt_free( list );
+        mbedtls_free( list );
+        return( ret );
+    }
+
+    *candidate_cas = list;
+
+    return( 0 );
+}
+
+#endif /* MBEDTLS_X509_CRT_BUNDLE_C */
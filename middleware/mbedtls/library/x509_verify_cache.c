@@ -0,0 +1,732 @@
+/*
+ *  Cache of successfully verified X.509 certificate chains
+ *
+ *  Copyright 2026 NXP
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of mbed TLS (https://tls.mbed.org)
+ */
+/*
+ * Every connection to the same server presents the same chain, and its full
+ * verification costs one public key operation per certificate. Once a chain
+ * verified cleanly, remembering a hash of everything the result depends on
+ * lets later verifications of the same chain skip the signature checks.
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_X509_VERIFY_CACHE_C)
+
+#include "mbedtls/x509_verify_cache.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/platform_util.h"
+
+#include <string.h>
+
+#if defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK)
+#if defined(MBEDTLS_PLATFORM_C)
+#include "mbedtls/platform.h"
+#else
+#include <stdlib.h>
+#define mbedtls_free       free
+#endif
+#endif /* MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK */
+
+#if MBEDTLS_X509_VERIFY_CACHE_MAX_ENTRIES < 1 || \
+    MBEDTLS_X509_VERIFY_CACHE_MAX_ENTRIES > 255
+#error "MBEDTLS_X509_VERIFY_CACHE_MAX_ENTRIES must be in 1..255"
+#endif
+
+/* Version byte of the mbedtls_x509_verify_cache_export() format */
+#define X509_VERIFY_CACHE_EXPORT_VERSION    1
+
+void mbedtls_x509_verify_cache_init( mbedtls_x509_verify_cache *cache )
+{
+    memset( cache, 0, sizeof( mbedtls_x509_verify_cache ) );
+
+#if defined(MBEDTLS_HAVE_TIME)
+    cache->timeout = MBEDTLS_X509_VERIFY_CACHE_DEFAULT_TIMEOUT;
+#endif
+
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_init( &cache->mutex );
+#endif
+}
+
+void mbedtls_x509_verify_cache_free( mbedtls_x509_verify_cache *cache )
+{
+    if( cache == NULL )
+        return;
+
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_free( &cache->mutex );
+#endif
+
+    mbedtls_platform_zeroize( cache, sizeof( mbedtls_x509_verify_cache ) );
+}
+
+#if defined(MBEDTLS_HAVE_TIME)
+void mbedtls_x509_verify_cache_set_timeout( mbedtls_x509_verify_cache *cache,
+                                            int timeout )
+{
+    if( timeout < 0 ) timeout = 0;
+
+    cache->timeout = timeout;
+}
+#endif /* MBEDTLS_HAVE_TIME */
+
+static int x509_vc_hash_len( mbedtls_sha256_context *sha, size_t len )
+{
+    unsigned char buf[4];
+
+    buf[0] = (unsigned char)( len >> 24 );
+    buf[1] = (unsigned char)( len >> 16 );
+    buf[2] = (unsigned char)( len >>  8 );
+    buf[3] = (unsigned char)( len       );
+
+    return( mbedtls_sha256_update_ret( sha, buf, sizeof( buf ) ) );
+}
+
+static int x509_vc_hash_buf( mbedtls_sha256_context *sha,
+                             const unsigned char *p, size_t len )
+{
+    int ret;
+
+    if( ( ret = x509_vc_hash_len( sha, len ) ) != 0 )
+        return( ret );
+
+    return( mbedtls_sha256_update_ret( sha, p, len ) );
+}
+
+/*
+ * Like x509_name_cmp() in x509_crt.c, but ignoring the string types and the
+ * case of all values: a looser match only adds candidates to the key.
+ */
+static int x509_vc_name_match( const mbedtls_x509_name *a,
+                               const mbedtls_x509_name *b )
+{
+    size_t i;
+
+    while( a != NULL || b != NULL )
+    {
+        if( a == NULL || b == NULL )
+            return( 0 );
+
+        if( a->oid.len != b->oid.len ||
+            memcmp( a->oid.p, b->oid.p, b->oid.len ) != 0 ||
+            a->val.len != b->val.len ||
+            a->next_merged != b->next_merged )
+        {
+            return( 0 );
+        }
+
+        for( i = 0; i < a->val.len; i++ )
+        {
+            unsigned char x = a->val.p[i], y = b->val.p[i];
+
+            if( x >= 'A' && x <= 'Z' ) x += 'a' - 'A';
+            if( y >= 'A' && y <= 'Z' ) y += 'a' - 'A';
+            if( x != y )
+                return( 0 );
+        }
+
+        a = a->next;
+        b = b->next;
+    }
+
+    return( 1 );
+}
+
+/*
+ * Is ca the issuer of any certificate of the chain? The name is all that can
+ * be checked without a signature verification; every candidate goes into the
+ * key, so replacing any of them changes it.
+ */
+static int x509_vc_is_anchor( const mbedtls_x509_crt *ca,
+                              const mbedtls_x509_crt *crt )
+{
+    for( ; crt != NULL && crt->raw.len != 0; crt = crt->next )
+    {
+        if( x509_vc_name_match( &crt->issuer, &ca->subject ) )
+            return( 1 );
+    }
+
+    return( 0 );
+}
+
+#if defined(MBEDTLS_HAVE_TIME_DATE)
+static int x509_vc_time_cmp( const mbedtls_x509_time *a,
+                             const mbedtls_x509_time *b )
+{
+    if( a->year != b->year ) return( a->year - b->year );
+    if( a->mon  != b->mon  ) return( a->mon  - b->mon  );
+    if( a->day  != b->day  ) return( a->day  - b->day  );
+    if( a->hour != b->hour ) return( a->hour - b->hour );
+    if( a->min  != b->min  ) return( a->min  - b->min  );
+    return( a->sec - b->sec );
+}
+
+static void x509_vc_min_valid_to( mbedtls_x509_time *valid_to,
+                                  const mbedtls_x509_crt *crt )
+{
+    if( valid_to->year == 0 || x509_vc_time_cmp( &crt->valid_to, valid_to ) < 0 )
+        *valid_to = crt->valid_to;
+}
+#endif /* MBEDTLS_HAVE_TIME_DATE */
+
+/*
+ * Hash the anchors of crt found in trust_ca
+ */
+static int x509_vc_hash_anchors( mbedtls_sha256_context *sha,
+                                 const mbedtls_x509_crt *crt,
+                                 const mbedtls_x509_crt *trust_ca,
+                                 mbedtls_x509_verify_cache_entry *entry,
+                                 size_t *anchors )
+{
+    int ret;
+    const mbedtls_x509_crt *cur;
+
+    for( cur = trust_ca; cur != NULL && cur->raw.len != 0; cur = cur->next )
+    {
+        if( ! x509_vc_is_anchor( cur, crt ) )
+            continue;
+
+        if( ( ret = x509_vc_hash_buf( sha, cur->raw.p, cur->raw.len ) ) != 0 )
+            return( ret );
+#if defined(MBEDTLS_HAVE_TIME_DATE)
+        x509_vc_min_valid_to( &entry->valid_to, cur );
+#else
+        (void) entry;
+#endif
+        (*anchors)++;
+    }
+
+    return( 0 );
+}
+
+#if defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK)
+/*
+ * Hash the anchors of crt the CA callback provides for its certificates
+ */
+static int x509_vc_hash_cb_anchors( mbedtls_sha256_context *sha,
+                                    const mbedtls_x509_crt *crt,
+                                    mbedtls_x509_crt_ca_cb_t f_ca_cb,
+                                    void *p_ca_cb,
+                                    mbedtls_x509_verify_cache_entry *entry,
+                                    size_t *anchors )
+{
+    int ret;
+    const mbedtls_x509_crt *cur;
+    mbedtls_x509_crt *candidates;
+
+    for( cur = crt; cur != NULL && cur->raw.len != 0; cur = cur->next )
+    {
+        if( ( ret = f_ca_cb( p_ca_cb, cur, &candidates ) ) != 0 )
+            return( ret );
+
+        ret = x509_vc_hash_anchors( sha, crt, candidates, entry, anchors );
+
+        mbedtls_x509_crt_free( candidates );
+        mbedtls_free( candidates );
+
+        if( ret != 0 )
+            return( ret );
+    }
+
+    return( 0 );
+}
+#endif /* MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK */
+
+/*
+ * Compute the key of a verification, and the earliest expiry of the
+ * certificates involved. Returns 1 if the verification can't be cached.
+ * The anchors come from f_ca_cb if it is set, from trust_ca otherwise.
+ */
+static int x509_vc_key( const mbedtls_x509_crt *crt,
+                        const mbedtls_x509_crt *trust_ca,
+                        mbedtls_x509_crt_ca_cb_t f_ca_cb,
+                        void *p_ca_cb,
+                        const mbedtls_x509_crt_profile *profile,
+                        const char *cn,
+                        mbedtls_x509_verify_cache_entry *entry )
+{
+    int ret;
+    size_t anchors = 0;
+    const mbedtls_x509_crt *cur;
+    mbedtls_sha256_context sha;
+
+    mbedtls_sha256_init( &sha );
+
+    if( ( ret = mbedtls_sha256_starts_ret( &sha, 0 ) ) != 0 )
+        goto exit;
+
+    for( cur = crt; cur != NULL && cur->raw.len != 0; cur = cur->next )
+    {
+        if( ( ret = x509_vc_hash_buf( &sha, cur->raw.p, cur->raw.len ) ) != 0 )
+            goto exit;
+#if defined(MBEDTLS_HAVE_TIME_DATE)
+        x509_vc_min_valid_to( &entry->valid_to, cur );
+#endif
+    }
+
+    /* Separate the chain from the anchors */
+    if( ( ret = x509_vc_hash_len( &sha, 0 ) ) != 0 )
+        goto exit;
+
+#if defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK)
+    if( f_ca_cb != NULL )
+        ret = x509_vc_hash_cb_anchors( &sha, crt, f_ca_cb, p_ca_cb, entry,
+                                       &anchors );
+    else
+#else
+    (void) f_ca_cb;
+    (void) p_ca_cb;
+#endif
+        ret = x509_vc_hash_anchors( &sha, crt, trust_ca, entry, &anchors );
+
+    if( ret != 0 )
+        goto exit;
+
+    if( anchors == 0 )
+    {
+        ret = 1;
+        goto exit;
+    }
+
+    if( ( ret = x509_vc_hash_len( &sha, 0 ) ) != 0 )
+        goto exit;
+
+    if( cn != NULL &&
+        ( ret = x509_vc_hash_buf( &sha, (const unsigned char *) cn,
+                                  strlen( cn ) ) ) != 0 )
+    {
+        goto exit;
+    }
+
+    if( ( ret = x509_vc_hash_len( &sha, profile->allowed_mds ) ) != 0 ||
+        ( ret = x509_vc_hash_len( &sha, profile->allowed_pks ) ) != 0 ||
+        ( ret = x509_vc_hash_len( &sha, profile->allowed_curves ) ) != 0 ||
+        ( ret = x509_vc_hash_len( &sha, profile->rsa_min_bitlen ) ) != 0 )
+    {
+        goto exit;
+    }
+
+    ret = mbedtls_sha256_finish_ret( &sha, entry->key );
+
+exit:
+    mbedtls_sha256_free( &sha );
+
+    return( ret );
+}
+
+/*
+ * Entries are kept from the most to the least recently used one
+ */
+static void x509_vc_remove( mbedtls_x509_verify_cache *cache, size_t i )
+{
+    memmove( &cache->entries[i], &cache->entries[i + 1],
+             ( cache->count - i - 1 ) * sizeof( cache->entries[0] ) );
+    cache->count--;
+    memset( &cache->entries[cache->count], 0, sizeof( cache->entries[0] ) );
+}
+
+static void x509_vc_insert( mbedtls_x509_verify_cache *cache,
+                            const mbedtls_x509_verify_cache_entry *entry )
+{
+    if( cache->count == MBEDTLS_X509_VERIFY_CACHE_MAX_ENTRIES )
+    {
+        x509_vc_remove( cache, cache->count - 1 );
+        cache->stats.evictions++;
+    }
+
+    memmove( &cache->entries[1], &cache->entries[0],
+             cache->count * sizeof( cache->entries[0] ) );
+    cache->entries[0] = *entry;
+    cache->count++;
+}
+
+#if defined(MBEDTLS_HAVE_TIME)
+/*
+ * Drop entries that timed out or whose chain expired
+ */
+static void x509_vc_expire( mbedtls_x509_verify_cache *cache )
+{
+    size_t i = 0;
+    mbedtls_time_t t = mbedtls_time( NULL );
+
+    while( i < cache->count )
+    {
+        const mbedtls_x509_verify_cache_entry *entry = &cache->entries[i];
+        int expired = 0;
+
+        if( cache->timeout != 0 &&
+            ( t < entry->timestamp || t - entry->timestamp > cache->timeout ) )
+        {
+            expired = 1;
+        }
+#if defined(MBEDTLS_HAVE_TIME_DATE)
+        if( mbedtls_x509_time_is_past( &entry->valid_to ) )
+            expired = 1;
+#endif
+
+        if( expired )
+        {
+            x509_vc_remove( cache, i );
+            cache->stats.expired++;
+        }
+        else
+            i++;
+    }
+}
+#endif /* MBEDTLS_HAVE_TIME */
+
+/*
+ * Look up a key, moving the entry to the front if found
+ */
+static int x509_vc_lookup( mbedtls_x509_verify_cache *cache,
+                           const unsigned char key[32] )
+{
+    size_t i;
+    mbedtls_x509_verify_cache_entry entry;
+
+    for( i = 0; i < cache->count; i++ )
+    {
+        if( memcmp( cache->entries[i].key, key, 32 ) == 0 )
+        {
+            entry = cache->entries[i];
+            x509_vc_remove( cache, i );
+            x509_vc_insert( cache, &entry );
+            return( 1 );
+        }
+    }
+
+    return( 0 );
+}
+
+/*
+ * Full verification, with the trusted CAs from f_ca_cb if it is set
+ */
+static int x509_vc_verify_full( mbedtls_x509_crt *crt,
+                     mbedtls_x509_crt *trust_ca,
+                     mbedtls_x509_crt_ca_cb_t f_ca_cb,
+                     void *p_ca_cb,
+                     mbedtls_x509_crl *ca_crl,
+                     const mbedtls_x509_crt_profile *profile,
+                     const char *cn, uint32_t *flags,
+                     int (*f_vrfy)(void *, mbedtls_x509_crt *, int, uint32_t *),
+                     void *p_vrfy,
+                     mbedtls_x509_crt_restart_ctx *rs_ctx )
+{
+#if defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK)
+    if( f_ca_cb != NULL )
+        return( mbedtls_x509_crt_verify_restartable_ca_cb( crt,
+                            f_ca_cb, p_ca_cb, profile, cn, flags,
+                            f_vrfy, p_vrfy, rs_ctx ) );
+#else
+    (void) f_ca_cb;
+    (void) p_ca_cb;
+#endif
+
+    return( mbedtls_x509_crt_verify_restartable( crt, trust_ca, ca_crl,
+                            profile, cn, flags, f_vrfy, p_vrfy, rs_ctx ) );
+}
+
+static int x509_vc_verify( mbedtls_x509_verify_cache *cache,
+                     mbedtls_x509_crt *crt,
+                     mbedtls_x509_crt *trust_ca,
+                     mbedtls_x509_crt_ca_cb_t f_ca_cb,
+                     void *p_ca_cb,
+                     mbedtls_x509_crl *ca_crl,
+                     const mbedtls_x509_crt_profile *profile,
+                     const char *cn, uint32_t *flags,
+                     int (*f_vrfy)(void *, mbedtls_x509_crt *, int, uint32_t *),
+                     void *p_vrfy,
+                     mbedtls_x509_crt_restart_ctx *rs_ctx )
+{
+    int ret;
+    mbedtls_x509_verify_cache_entry entry;
+
+    if( profile == NULL )
+        return( MBEDTLS_ERR_X509_BAD_INPUT_DATA );
+
+    memset( &entry, 0, sizeof( entry ) );
+
+    /* A verify callback may reject what the cache would accept */
+    if( ca_crl != NULL || f_vrfy != NULL || crt == NULL ||
+        x509_vc_key( crt, trust_ca, f_ca_cb, p_ca_cb, profile, cn,
+                     &entry ) != 0 )
+    {
+        cache->stats.bypassed++;
+        return( x509_vc_verify_full( crt, trust_ca, f_ca_cb, p_ca_cb, ca_crl,
+                            profile, cn, flags, f_vrfy, p_vrfy, rs_ctx ) );
+    }
+
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_RESTARTABLE)
+    /* Look up only once, not on every call continuing a verification */
+    if( rs_ctx == NULL || rs_ctx->in_progress == x509_crt_rs_none )
+#endif
+    {
+        int hit;
+
+#if defined(MBEDTLS_THREADING_C)
+        if( ( ret = mbedtls_mutex_lock( &cache->mutex ) ) != 0 )
+            return( ret );
+#endif
+
+#if defined(MBEDTLS_HAVE_TIME)
+        x509_vc_expire( cache );
+#endif
+
+        hit = x509_vc_lookup( cache, entry.key );
+        if( hit )
+            cache->stats.hits++;
+        else
+            cache->stats.misses++;
+
+#if defined(MBEDTLS_THREADING_C)
+        if( mbedtls_mutex_unlock( &cache->mutex ) != 0 )
+            return( MBEDTLS_ERR_THREADING_MUTEX_ERROR );
+#endif
+
+        if( hit )
+        {
+            *flags = 0;
+            return( 0 );
+        }
+    }
+
+    ret = x509_vc_verify_full( crt, trust_ca, f_ca_cb, p_ca_cb, ca_crl,
+                            profile, cn, flags, f_vrfy, p_vrfy, rs_ctx );
+
+    if( ret != 0 || *flags != 0 )
+        return( ret );
+
+#if defined(MBEDTLS_HAVE_TIME)
+    entry.timestamp = mbedtls_time( NULL );
+#endif
+
+#if defined(MBEDTLS_THREADING_C)
+    if( ( ret = mbedtls_mutex_lock( &cache->mutex ) ) != 0 )
+        return( ret );
+#endif
+
+    /* A concurrent verification of the same chain may have stored it */
+    if( ! x509_vc_lookup( cache, entry.key ) )
+    {
+        x509_vc_insert( cache, &entry );
+        cache->stats.stores++;
+    }
+
+#if defined(MBEDTLS_THREADING_C)
+    if( mbedtls_mutex_unlock( &cache->mutex ) != 0 )
+        return( MBEDTLS_ERR_THREADING_MUTEX_ERROR );
+#endif
+
+    return( 0 );
+}
+
+int mbedtls_x509_verify_cache_verify( mbedtls_x509_verify_cache *cache,
+                     mbedtls_x509_crt *crt,
+                     mbedtls_x509_crt *trust_ca,
+                     mbedtls_x509_crl *ca_crl,
+                     const mbedtls_x509_crt_profile *profile,
+                     const char *cn, uint32_t *flags,
+                     int (*f_vrfy)(void *, mbedtls_x509_crt *, int, uint32_t *),
+                     void *p_vrfy,
+                     mbedtls_x509_crt_restart_ctx *rs_ctx )
+{
+    return( x509_vc_verify( cache, crt, trust_ca, NULL, NULL, ca_crl,
+                            profile, cn, flags, f_vrfy, p_vrfy, rs_ctx ) );
+}
+
+#if defined(MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK)
+int mbedtls_x509_verify_cache_verify_ca_cb( mbedtls_x509_verify_cache *cache,
+                     mbedtls_x509_crt *crt,
+                     mbedtls_x509_crt_ca_cb_t f_ca_cb,
+                     void *p_ca_cb,
+                     const mbedtls_x509_crt_profile *profile,
+                     const char *cn, uint32_t *flags,
+                     int (*f_vrfy)(void *, mbedtls_x509_crt *, int, uint32_t *),
+                     void *p_vrfy,
+                     mbedtls_x509_crt_restart_ctx *rs_ctx )
+{
+    if( f_ca_cb == NULL )
+        return( MBEDTLS_ERR_X509_BAD_INPUT_DATA );
+
+    return( x509_vc_verify( cache, crt, NULL, f_ca_cb, p_ca_cb, NULL,
+                            profile, cn, flags, f_vrfy, p_vrfy, rs_ctx ) );
+}
+#endif /* MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK */
+
+void mbedtls_x509_verify_cache_clear( mbedtls_x509_verify_cache *cache )
+{
+#if defined(MBEDTLS_THREADING_C)
+    if( mbedtls_mutex_lock( &cache->mutex ) != 0 )
+        return;
+#endif
+
+    mbedtls_platform_zeroize( cache->entries, sizeof( cache->entries ) );
+    cache->count = 0;
+    cache->stats.invalidations++;
+
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_unlock( &cache->mutex );
+#endif
+}
+
+void mbedtls_x509_verify_cache_get_stats( mbedtls_x509_verify_cache *cache,
+                                          mbedtls_x509_verify_cache_stats *stats )
+{
+    *stats = cache->stats;
+}
+
+/*
+ * Serialized format:
+ *     version (1 byte), count (1 byte), then for each entry from the least
+ *     recently used on:
+ *         key (32 bytes)
+ *         timestamp (8 bytes, big endian, 0 without MBEDTLS_HAVE_TIME)
+ *         valid_to (7 bytes: year on 2 bytes, month, day, hour, minute,
+ *                   second; 0 without MBEDTLS_HAVE_TIME_DATE)
+ */
+int mbedtls_x509_verify_cache_export( mbedtls_x509_verify_cache *cache,
+                                      unsigned char *buf, size_t buflen,
+                                      size_t *olen )
+{
+    int ret = 0;
+    size_t i, count;
+    unsigned char *p = buf + 2;
+
+    *olen = 0;
+
+    if( buflen < 2 )
+        return( MBEDTLS_ERR_X509_BUFFER_TOO_SMALL );
+
+#if defined(MBEDTLS_THREADING_C)
+    if( ( ret = mbedtls_mutex_lock( &cache->mutex ) ) != 0 )
+        return( ret );
+#endif
+
+    for( count = cache->count; count > 0; count-- )
+    {
+        const mbedtls_x509_verify_cache_entry *entry = &cache->entries[count - 1];
+        uint64_t timestamp = 0;
+
+        if( (size_t)( buf + buflen - p ) < MBEDTLS_X509_VERIFY_CACHE_ENTRY_SIZE )
+        {
+            ret = MBEDTLS_ERR_X509_BUFFER_TOO_SMALL;
+            goto exit;
+        }
+
+        memcpy( p, entry->key, 32 );
+        p += 32;
+
+#if defined(MBEDTLS_HAVE_TIME)
+        timestamp = (uint64_t) entry->timestamp;
+#endif
+        for( i = 0; i < 8; i++ )
+            *p++ = (unsigned char)( timestamp >> ( 56 - 8 * i ) );
+
+#if defined(MBEDTLS_HAVE_TIME_DATE)
+        *p++ = (unsigned char)( entry->valid_to.year >> 8 );
+        *p++ = (unsigned char)( entry->valid_to.year      );
+        *p++ = (unsigned char)( entry->valid_to.mon  );
+        *p++ = (unsigned char)( entry->valid_to.day  );
+        *p++ = (unsigned char)( entry->valid_to.hour );
+        *p++ = (unsigned char)( entry->valid_to.min  );
+        *p++ = (unsigned char)( entry->valid_to.sec  );
+#else
+        memset( p, 0, 7 );
+        p += 7;
+#endif
+    }
+
+    buf[0] = X509_VERIFY_CACHE_EXPORT_VERSION;
+    buf[1] = (unsigned char) cache->count;
+    *olen = p - buf;
+
+exit:
+#if defined(MBEDTLS_THREADING_C)
+    if( mbedtls_mutex_unlock( &cache->mutex ) != 0 )
+        return( MBEDTLS_ERR_THREADING_MUTEX_ERROR );
+#endif
+
+    return( ret );
+}
+
+int mbedtls_x509_verify_cache_import( mbedtls_x509_verify_cache *cache,
+                                      const unsigned char *buf, size_t len )
+{
+    int ret = 0;
+    size_t i, n, count;
+    const unsigned char *p = buf + 2;
+
+    if( len < 2 || buf[0] != X509_VERIFY_CACHE_EXPORT_VERSION )
+        return( MBEDTLS_ERR_X509_INVALID_FORMAT );
+
+    count = buf[1];
+    if( len != 2 + count * MBEDTLS_X509_VERIFY_CACHE_ENTRY_SIZE )
+        return( MBEDTLS_ERR_X509_INVALID_FORMAT );
+
+#if defined(MBEDTLS_THREADING_C)
+    if( ( ret = mbedtls_mutex_lock( &cache->mutex ) ) != 0 )
+        return( ret );
+#endif
+
+    for( n = 0; n < count; n++ )
+    {
+        mbedtls_x509_verify_cache_entry entry;
+        uint64_t timestamp = 0;
+
+        memset( &entry, 0, sizeof( entry ) );
+
+        memcpy( entry.key, p, 32 );
+        p += 32;
+
+        for( i = 0; i < 8; i++ )
+            timestamp = ( timestamp << 8 ) | *p++;
+#if defined(MBEDTLS_HAVE_TIME)
+        entry.timestamp = (mbedtls_time_t) timestamp;
+#else
+        (void) timestamp;
+#endif
+
+#if defined(MBEDTLS_HAVE_TIME_DATE)
+        entry.valid_to.year = ( p[0] << 8 ) | p[1];
+        entry.valid_to.mon  = p[2];
+        entry.valid_to.day  = p[3];
+        entry.valid_to.hour = p[4];
+        entry.valid_to.min  = p[5];
+        entry.valid_to.sec  = p[6];
+#endif
+        p += 7;
+
+        if( ! x509_vc_lookup( cache, entry.key ) )
+            x509_vc_insert( cache, &entry );
+    }
+
+#if defined(MBEDTLS_THREADING_C)
+    if( mbedtls_mutex_unlock( &cache->mutex ) != 0 )
+        return( MBEDTLS_ERR_THREADING_MUTEX_ERROR );
+#endif
+
+    return( ret );
+}
+
+#endif /* MBEDTLS_X509_VERIFY_CACHE_C */
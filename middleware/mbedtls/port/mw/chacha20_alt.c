@@ -0,0 +1,357 @@
+/**
+ * \file chacha20.c
+ *
+ * \brief ChaCha20 cipher.
+ *
+ * \author Daniel King <damaki.gh@gmail.com>
+ *
+ *  Copyright (C) 2006-2016, ARM Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of mbed TLS (https://tls.mbed.org)
+ */
+
+/*
+ * Unlike library/chacha20.c, which runs the rounds on a state array and
+ * XORs the keystream byte by byte, the working state lives in sixteen local
+ * variables (the compiler keeps most of them in registers and folds the
+ * rotations into the shifted operand of EOR/ADD on ARM) and the keystream
+ * is XORed into the output word by word. All full blocks of an update are
+ * generated by one call, with the counter kept in a register.
+ *
+ * The Cortex-M4 has too few registers to interleave several blocks, so
+ * blocks are generated one after the other.
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_CHACHA20_C)
+
+#include "mbedtls/chacha20.h"
+#include "mbedtls/platform_util.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#if defined(MBEDTLS_CHACHA20_ALT)
+
+#if ( defined(__ARMCC_VERSION) || defined(_MSC_VER) ) && \
+    !defined(inline) && !defined(__cplusplus)
+#define inline __inline
+#endif
+
+/* Parameter validation macros */
+#define CHACHA20_VALIDATE_RET( cond )                                       \
+    MBEDTLS_INTERNAL_VALIDATE_RET( cond, MBEDTLS_ERR_CHACHA20_BAD_INPUT_DATA )
+#define CHACHA20_VALIDATE( cond )                                           \
+    MBEDTLS_INTERNAL_VALIDATE( cond )
+
+#define BYTES_TO_U32_LE( data, offset )                           \
+    ( (uint32_t) (data)[offset]                                   \
+      | (uint32_t) ( (uint32_t) (data)[( offset ) + 1] << 8 )     \
+      | (uint32_t) ( (uint32_t) (data)[( offset ) + 2] << 16 )    \
+      | (uint32_t) ( (uint32_t) (data)[( offset ) + 3] << 24 )    \
+    )
+
+#define ROTL32( value, amount ) \
+    ( (uint32_t) ( (value) << (amount) ) | ( (value) >> ( 32 - (amount) ) ) )
+
+#define CHACHA20_CTR_INDEX ( 12U )
+
+#define CHACHA20_BLOCK_SIZE_BYTES ( 4U * 16U )
+
+/*
+ * Unaligned little endian word access. On little endian targets the memcpy()
+ * is a single (unaligned) load or store, e.g. LDR/STR on Cortex-M3/M4.
+ */
+#if defined(__BYTE_ORDER__) && ( __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ )
+static inline uint32_t chacha20_load32( const unsigned char *p )
+{
+    uint32_t v;
+
+    memcpy( &v, p, 4 );
+
+    return( v );
+}
+
+static inline void chacha20_store32( unsigned char *p, uint32_t v )
+{
+    memcpy( p, &v, 4 );
+}
+#else
+static inline uint32_t chacha20_load32( const unsigned char *p )
+{
+    return( BYTES_TO_U32_LE( p, 0 ) );
+}
+
+static inline void chacha20_store32( unsigned char *p, uint32_t v )
+{
+    p[0] = (unsigned char)( v       );
+    p[1] = (unsigned char)( v >>  8 );
+    p[2] = (unsigned char)( v >> 16 );
+    p[3] = (unsigned char)( v >> 24 );
+}
+#endif
+
+/*
+ * ChaCha20 quarter round (RFC 7539 2.1) on local variables
+ */
+#define CHACHA20_QR( a, b, c, d )                           \
+    do                                                      \
+    {                                                       \
+        (a) += (b); (d) ^= (a); (d) = ROTL32( (d), 16 );    \
+        (c) += (d); (b) ^= (c); (b) = ROTL32( (b), 12 );    \
+        (a) += (b); (d) ^= (a); (d) = ROTL32( (d),  8 );    \
+        (c) += (d); (b) ^= (c); (b) = ROTL32( (b),  7 );    \
+    } while( 0 )
+
+/*
+ * Write keystream word i (working word x plus initial state word s), XORed
+ * with the input if there is one
+ */
+#define CHACHA20_OUT( i, x, s )                                         \
+    do                                                                  \
+    {                                                                   \
+        uint32_t w_ = (x) + (s);                                        \
+        if( input != NULL )                                             \
+            w_ ^= chacha20_load32( input + 4 * (i) );                   \
+        chacha20_store32( output + 4 * (i), w_ );                       \
+    } while( 0 )
+
+/**
+ * \brief           Generate nblocks keystream blocks and increment the
+ *                  counter accordingly.
+ *
+ * \param state     The ChaCha20 state (key, nonce, counter).
+ * \param nblocks   Number of blocks to generate.
+ * \param input     Input to XOR with the keystream, or NULL to write the
+ *                  keystream itself.
+ * \param output    Output, nblocks * 64 bytes. May be equal to \p input.
+ */
+static void chacha20_blocks( uint32_t state[16],
+                             size_t nblocks,
+                             const unsigned char *input,
+                             unsigned char *output )
+{
+    uint32_t x0, x1, x2, x3, x4, x5, x6, x7;
+    uint32_t x8, x9, x10, x11, x12, x13, x14, x15;
+    uint32_t counter = state[CHACHA20_CTR_INDEX];
+    int i;
+
+    while( nblocks-- > 0 )
+    {
+        x0  = state[ 0]; x1  = state[ 1]; x2  = state[ 2]; x3  = state[ 3];
+        x4  = state[ 4]; x5  = state[ 5]; x6  = state[ 6]; x7  = state[ 7];
+        x8  = state[ 8]; x9  = state[ 9]; x10 = state[10]; x11 = state[11];
+        x12 = counter;   x13 = state[13]; x14 = state[14]; x15 = state[15];
+
+        for( i = 0; i < 10; i++ )
+        {
+            /* Column round */
+            CHACHA20_QR( x0, x4, x8,  x12 );
+            CHACHA20_QR( x1, x5, x9,  x13 );
+            CHACHA20_QR( x2, x6, x10, x14 );
+            CHACHA20_QR( x3, x7, x11, x15 );
+
+            /* Diagonal round */
+            CHACHA20_QR( x0, x5, x10, x15 );
+            CHACHA20_QR( x1, x6, x11, x12 );
+            CHACHA20_QR( x2, x7, x8,  x13 );
+            CHACHA20_QR( x3, x4, x9,  x14 );
+        }
+
+        CHACHA20_OUT(  0, x0,  state[ 0] );
+        CHACHA20_OUT(  1, x1,  state[ 1] );
+        CHACHA20_OUT(  2, x2,  state[ 2] );
+        CHACHA20_OUT(  3, x3,  state[ 3] );
+        CHACHA20_OUT(  4, x4,  state[ 4] );
+        CHACHA20_OUT(  5, x5,  state[ 5] );
+        CHACHA20_OUT(  6, x6,  state[ 6] );
+        CHACHA20_OUT(  7, x7,  state[ 7] );
+        CHACHA20_OUT(  8, x8,  state[ 8] );
+        CHACHA20_OUT(  9, x9,  state[ 9] );
+        CHACHA20_OUT( 10, x10, state[10] );
+        CHACHA20_OUT( 11, x11, state[11] );
+        CHACHA20_OUT( 12, x12, counter   );
+        CHACHA20_OUT( 13, x13, state[13] );
+        CHACHA20_OUT( 14, x14, state[14] );
+        CHACHA20_OUT( 15, x15, state[15] );
+
+        counter++;
+        if( input != NULL )
+            input += CHACHA20_BLOCK_SIZE_BYTES;
+        output += CHACHA20_BLOCK_SIZE_BYTES;
+    }
+
+    state[CHACHA20_CTR_INDEX] = counter;
+}
+
+void mbedtls_chacha20_init( mbedtls_chacha20_context *ctx )
+{
+    CHACHA20_VALIDATE( ctx != NULL );
+
+    mbedtls_platform_zeroize( ctx->state, sizeof( ctx->state ) );
+    mbedtls_platform_zeroize( ctx->keystream8, sizeof( ctx->keystream8 ) );
+
+    /* Initially, there's no keystream bytes available */
+    ctx->keystream_bytes_used = CHACHA20_BLOCK_SIZE_BYTES;
+}
+
+void mbedtls_chacha20_free( mbedtls_chacha20_context *ctx )
+{
+    if( ctx != NULL )
+    {
+        mbedtls_platform_zeroize( ctx, sizeof( mbedtls_chacha20_context ) );
+    }
+}
+
+int mbedtls_chacha20_setkey( mbedtls_chacha20_context *ctx,
+                            const unsigned char key[32] )
+{
+    CHACHA20_VALIDATE_RET( ctx != NULL );
+    CHACHA20_VALIDATE_RET( key != NULL );
+
+    /* ChaCha20 constants - the string "expand 32-byte k" */
+    ctx->state[0] = 0x61707865;
+    ctx->state[1] = 0x3320646e;
+    ctx->state[2] = 0x79622d32;
+    ctx->state[3] = 0x6b206574;
+
+    /* Set key */
+    ctx->state[4]  = BYTES_TO_U32_LE( key, 0 );
+    ctx->state[5]  = BYTES_TO_U32_LE( key, 4 );
+    ctx->state[6]  = BYTES_TO_U32_LE( key, 8 );
+    ctx->state[7]  = BYTES_TO_U32_LE( key, 12 );
+    ctx->state[8]  = BYTES_TO_U32_LE( key, 16 );
+    ctx->state[9]  = BYTES_TO_U32_LE( key, 20 );
+    ctx->state[10] = BYTES_TO_U32_LE( key, 24 );
+    ctx->state[11] = BYTES_TO_U32_LE( key, 28 );
+
+    return( 0 );
+}
+
+int mbedtls_chacha20_starts( mbedtls_chacha20_context* ctx,
+                             const unsigned char nonce[12],
+                             uint32_t counter )
+{
+    CHACHA20_VALIDATE_RET( ctx != NULL );
+    CHACHA20_VALIDATE_RET( nonce != NULL );
+
+    /* Counter */
+    ctx->state[12] = counter;
+
+    /* Nonce */
+    ctx->state[13] = BYTES_TO_U32_LE( nonce, 0 );
+    ctx->state[14] = BYTES_TO_U32_LE( nonce, 4 );
+    ctx->state[15] = BYTES_TO_U32_LE( nonce, 8 );
+
+    mbedtls_platform_zeroize( ctx->keystream8, sizeof( ctx->keystream8 ) );
+
+    /* Initially, there's no keystream bytes available */
+    ctx->keystream_bytes_used = CHACHA20_BLOCK_SIZE_BYTES;
+
+    return( 0 );
+}
+
+int mbedtls_chacha20_update( mbedtls_chacha20_context *ctx,
+                              size_t size,
+                              const unsigned char *input,
+                              unsigned char *output )
+{
+    size_t offset = 0U;
+    size_t nblocks;
+    size_t i;
+
+    CHACHA20_VALIDATE_RET( ctx != NULL );
+    CHACHA20_VALIDATE_RET( size == 0 || input  != NULL );
+    CHACHA20_VALIDATE_RET( size == 0 || output != NULL );
+
+    /* Use leftover keystream bytes, if available */
+    while( size > 0U && ctx->keystream_bytes_used < CHACHA20_BLOCK_SIZE_BYTES )
+    {
+        output[offset] = input[offset]
+                       ^ ctx->keystream8[ctx->keystream_bytes_used];
+
+        ctx->keystream_bytes_used++;
+        offset++;
+        size--;
+    }
+
+    /* Process full blocks directly between input and output */
+    nblocks = size / CHACHA20_BLOCK_SIZE_BYTES;
+    if( nblocks > 0U )
+    {
+        chacha20_blocks( ctx->state, nblocks, &input[offset], &output[offset] );
+
+        offset += nblocks * CHACHA20_BLOCK_SIZE_BYTES;
+        size   -= nblocks * CHACHA20_BLOCK_SIZE_BYTES;
+    }
+
+    /* Last (partial) block */
+    if( size > 0U )
+    {
+        /* Generate new keystream block and increment counter */
+        chacha20_blocks( ctx->state, 1U, NULL, ctx->keystream8 );
+
+        for( i = 0U; i < size; i++)
+        {
+            output[offset + i] = input[offset + i] ^ ctx->keystream8[i];
+        }
+
+        ctx->keystream_bytes_used = size;
+    }
+
+    return( 0 );
+}
+
+int mbedtls_chacha20_crypt( const unsigned char key[32],
+                            const unsigned char nonce[12],
+                            uint32_t counter,
+                            size_t data_len,
+                            const unsigned char* input,
+                            unsigned char* output )
+{
+    mbedtls_chacha20_context ctx;
+    int ret;
+
+    CHACHA20_VALIDATE_RET( key != NULL );
+    CHACHA20_VALIDATE_RET( nonce != NULL );
+    CHACHA20_VALIDATE_RET( data_len == 0 || input  != NULL );
+    CHACHA20_VALIDATE_RET( data_len == 0 || output != NULL );
+
+    mbedtls_chacha20_init( &ctx );
+
+    ret = mbedtls_chacha20_setkey( &ctx, key );
+    if( ret != 0 )
+        goto cleanup;
+
+    ret = mbedtls_chacha20_starts( &ctx, nonce, counter );
+    if( ret != 0 )
+        goto cleanup;
+
+    ret = mbedtls_chacha20_update( &ctx, data_len, input, output );
+
+cleanup:
+    mbedtls_chacha20_free( &ctx );
+    return( ret );
+}
+
+#endif /* MBEDTLS_CHACHA20_ALT */
+
+#endif /* MBEDTLS_CHACHA20_C */
@@ -158,7 +158,12 @@ void mbedtls_hardware_init_hash(uint8_t *entropy, size_t len)
 void *pvPortCalloc(size_t num, size_t size)
 {
     void *mem;
+#ifdef configHEAP_TAG_MBEDTLS
+    /* heap_6.c: account the allocations of mbedTLS under their own tag */
+    mem = pvPortMallocTagged(num * size, configHEAP_TAG_MBEDTLS);
+#else
     mem = pvPortMalloc(num * size);
+#endif
 
     if (mem != NULL)
     {
@@ -310,14 +310,17 @@ void *pvPortCalloc(size_t num, size_t size);
 //#define MBEDTLS_CAMELLIA_ALT
 #define MBEDTLS_CCM_ALT
 #define MBEDTLS_CCM_CRYPT_ALT
+#define MBEDTLS_CHACHA20_ALT
+//#define MBEDTLS_CHACHAPOLY_ALT
 //#define MBEDTLS_CMAC_ALT
 //#define MBEDTLS_DES_ALT
 //#define MBEDTLS_DHM_ALT
 //#define MBEDTLS_ECJPAKE_ALT
-//#define MBEDTLS_GCM_ALT
+#define MBEDTLS_GCM_ALT
 //#define MBEDTLS_MD2_ALT
 //#define MBEDTLS_MD4_ALT
 //#define MBEDTLS_MD5_ALT
+#define MBEDTLS_POLY1305_ALT
 //#define MBEDTLS_RIPEMD160_ALT
 //#define MBEDTLS_RSA_ALT
 //#define MBEDTLS_SHA1_ALT
@@ -674,6 +677,47 @@ void *pvPortCalloc(size_t num, size_t size);
  */
 #define MBEDTLS_ECP_NIST_OPTIM
 
+/**
+ * \def MBEDTLS_MPI_MONT_FIXED
+ *
+ * Enable the fixed-width Montgomery multiplication kernel in
+ * library/bignum.c, used by mbedtls_mpi_exp_mod() (RSA, DHM) for 256, 2048
+ * and 3072-bit moduli. Each limb of both products is accumulated in a single
+ * pass with one UMAAL instruction on ARMv6+ cores with the DSP extension
+ * (Cortex-M4/M7/M33), or with double-width C arithmetic elsewhere.
+ * Other moduli sizes use the generic code. Squarings use the same kernel as
+ * multiplications, so that their running times don't tell them apart.
+ *
+ * Requires: MBEDTLS_HAVE_ASM on ARM or a double-width integer type
+ *
+ * Comment this macro to use the generic Montgomery multiplication only.
+ */
+#define MBEDTLS_MPI_MONT_FIXED
+
+/**
+ * \def MBEDTLS_ECP_RESTARTABLE
+ *
+ * Enable "non-blocking" ECC operations that can return early and be resumed.
+ *
+ * This allows various functions to pause by returning
+ * #MBEDTLS_ERR_ECP_IN_PROGRESS (or, for functions in the SSL module,
+ * #MBEDTLS_ERR_SSL_CRYPTO_IN_PROGRESS) and then be called later again in
+ * order to further progress and eventually complete their operation. This is
+ * controlled through mbedtls_ecp_set_max_ops() which limits the maximum
+ * number of ECC operations a function may perform before pausing; see
+ * mbedtls_ecp_set_max_ops() for more information.
+ *
+ * This is useful in non-threaded environments if you want to avoid blocking
+ * for too long on ECC (and, hence, X.509 or SSL/TLS) operations.
+ *
+ * Uncomment this macro to enable restartable ECC computations.
+ *
+ * \note  This option only works with the default software implementation of
+ *        elliptic curve functionality. It is incompatible with
+ *        MBEDTLS_ECP_ALT, MBEDTLS_ECDH_XXX_ALT and MBEDTLS_ECDSA_XXX_ALT.
+ */
+#define MBEDTLS_ECP_RESTARTABLE
+
 /**
  * \def MBEDTLS_ECDSA_DETERMINISTIC
  *
@@ -1477,6 +1521,33 @@ void *pvPortCalloc(size_t num, size_t size);
  */
 #define MBEDTLS_SSL_EXPORT_KEYS
 
+/**
+ * \def MBEDTLS_SSL_ALLOC_SCOPE
+ *
+ * Enable the allocation scope callback, see mbedtls_ssl_conf_alloc_scope().
+ * The SSL module then tells the application which of its allocations
+ * during the handshake are kept afterwards (peer certificate, cipher
+ * contexts, session ticket), so that an allocator can take the other ones
+ * from a region that is reset when the handshake is over.
+ *
+ * Uncomment this macro to enable the allocation scope callback
+ */
+#define MBEDTLS_SSL_ALLOC_SCOPE
+
+/**
+ * \def MBEDTLS_SSL_HANDSHAKE_PROFILE
+ *
+ * Enable the handshake profiler, see mbedtls_ssl_conf_handshake_profile().
+ * Each SSL context then records the time spent in every handshake state,
+ * waiting for the peer and in handshake steps, as well as the number and
+ * time of the ECP, RSA and X.509 verification operations of the handshake.
+ *
+ * Requires: MBEDTLS_SSL_TLS_C, MBEDTLS_PROFILE_C
+ *
+ * Uncomment this macro to enable the handshake profiler
+ */
+//#define MBEDTLS_SSL_HANDSHAKE_PROFILE
+
 /**
  * \def MBEDTLS_SSL_SERVER_NAME_INDICATION
  *
@@ -1605,6 +1676,18 @@ void *pvPortCalloc(size_t num, size_t size);
  */
 #define MBEDTLS_X509_CHECK_EXTENDED_KEY_USAGE
 
+/**
+ * \def MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK
+ *
+ * Enable the query of trusted certificates through a callback, see
+ * mbedtls_x509_crt_verify_with_ca_cb() and mbedtls_ssl_conf_ca_cb().
+ * The trusted certificates can then be kept out of RAM until a chain
+ * references them, see MBEDTLS_X509_CRT_BUNDLE_C.
+ *
+ * Uncomment to enable trusted certificate callbacks.
+ */
+#define MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK
+
 /**
  * \def MBEDTLS_X509_RSASSA_PSS_SUPPORT
  *
@@ -1912,6 +1995,26 @@ void *pvPortCalloc(size_t num, size_t size);
  */
 #define MBEDTLS_CERTS_C
 
+/**
+ * \def MBEDTLS_CHACHA20_C
+ *
+ * Enable the ChaCha20 stream cipher.
+ *
+ * Module:  library/chacha20.c
+ */
+#define MBEDTLS_CHACHA20_C
+
+/**
+ * \def MBEDTLS_CHACHAPOLY_C
+ *
+ * Enable the ChaCha20-Poly1305 AEAD algorithm.
+ *
+ * Module:  library/chachapoly.c
+ *
+ * This module requires: MBEDTLS_CHACHA20_C, MBEDTLS_POLY1305_C
+ */
+#define MBEDTLS_CHACHAPOLY_C
+
 /**
  * \def MBEDTLS_CIPHER_C
  *
@@ -1935,7 +2038,7 @@ void *pvPortCalloc(size_t num, size_t size);
  * Requires: MBEDTLS_AES_C or MBEDTLS_DES_C
  *
  */
-//#define MBEDTLS_CMAC_C
+#define MBEDTLS_CMAC_C
 
 /**
  * \def MBEDTLS_CTR_DRBG_C
@@ -2446,6 +2549,33 @@ void *pvPortCalloc(size_t num, size_t size);
  */
 #define MBEDTLS_PLATFORM_C
 
+/**
+ * \def MBEDTLS_POLY1305_C
+ *
+ * Enable the Poly1305 MAC algorithm.
+ *
+ * Module:  library/poly1305.c
+ * Caller:  library/chachapoly.c
+ */
+#define MBEDTLS_POLY1305_C
+
+/**
+ * \def MBEDTLS_PROFILE_C
+ *
+ * Enable the timing of public key operations.
+ *
+ * Module:  library/profile.c
+ * Caller:  library/ecp.c
+ *          library/rsa.c
+ *          library/ssl_tls.c
+ *          library/x509_crt.c
+ *
+ * This module measures the ECP point multiplications, the RSA operations
+ * and the X.509 chain verifications while a sink is set, see
+ * mbedtls_profile_set_sink(). It is used by MBEDTLS_SSL_HANDSHAKE_PROFILE.
+ */
+//#define MBEDTLS_PROFILE_C
+
 /**
  * \def MBEDTLS_RIPEMD160_C
  *
@@ -2697,6 +2827,38 @@ void *pvPortCalloc(size_t num, size_t size);
  */
 #define MBEDTLS_X509_CRT_PARSE_C
 
+/**
+ * \def MBEDTLS_X509_VERIFY_CACHE_C
+ *
+ * Enable the cache of verified certificate chains.
+ *
+ * Module:  library/x509_verify_cache.c
+ * Caller:  library/ssl_tls.c
+ *
+ * Requires: MBEDTLS_X509_CRT_PARSE_C, MBEDTLS_SHA256_C
+ *
+ * This module remembers chains that verified successfully, so that later
+ * handshakes presenting the same chain skip the signature checks, see
+ * mbedtls_ssl_conf_verify_cache(). It has no effect unless a cache is set.
+ */
+#define MBEDTLS_X509_VERIFY_CACHE_C
+
+/**
+ * \def MBEDTLS_X509_CRT_BUNDLE_C
+ *
+ * Enable trusted CA bundles kept in flash.
+ *
+ * Module:  library/x509_crt_bundle.c
+ * Caller:
+ *
+ * Requires: MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK, MBEDTLS_SHA256_C
+ *
+ * A bundle is generated on the host by scripts/x509_crt_bundle.py. It holds
+ * the DER of the CA certificates behind an index sorted by subject name hash,
+ * so a certificate is only parsed while verifying a chain it issued.
+ */
+#define MBEDTLS_X509_CRT_BUNDLE_C
+
 /**
  * \def MBEDTLS_X509_CRL_PARSE_C
  *
@@ -2878,6 +3040,8 @@ void *pvPortCalloc(size_t num, size_t size);
 /* X509 options */
 //#define MBEDTLS_X509_MAX_INTERMEDIATE_CA   8   /**< Maximum number of intermediate CAs in a verification chain. */
 //#define MBEDTLS_X509_MAX_FILE_PATH_LEN     512 /**< Maximum length of a path/filename string in bytes including the null terminator character ('\0'). */
+//#define MBEDTLS_X509_VERIFY_CACHE_MAX_ENTRIES      8 /**< Maximum entries in the verified chain cache */
+//#define MBEDTLS_X509_VERIFY_CACHE_DEFAULT_TIMEOUT  86400 /**< 1 day  */
 
 /**
  * Allow SHA-1 in the default TLS configuration for certificate signing.
@@ -0,0 +1,1251 @@
+/*
+ *  Benchmark core shared by the host and the target benchmark programs
+ *
+ *  Copyright 2026 NXP
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of mbed TLS (https://tls.mbed.org)
+ */
+
+/*
+ * Unlike benchmark.c, the benchmarks are described by a table of cases and
+ * the results are written as JSON, using no floating point formatting so
+ * that the same code runs with the reduced printf of the targets. Bulk
+ * operations process BENCH_BUFSIZE bytes, the TLS cases run a client and a
+ * server in the same thread, connected through an in-memory BIO pair.
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_PLATFORM_C)
+#include "mbedtls/platform.h"
+#else
+#include <stdio.h>
+#include <stdlib.h>
+#define mbedtls_calloc     calloc
+#define mbedtls_free       free
+#define mbedtls_snprintf   snprintf
+#endif
+
+#include <ctype.h>
+#include <string.h>
+
+#include "bench_core.h"
+
+#include "mbedtls/version.h"
+#include "mbedtls/md5.h"
+#include "mbedtls/sha1.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/sha512.h"
+#include "mbedtls/aes.h"
+#include "mbedtls/des.h"
+#include "mbedtls/gcm.h"
+#include "mbedtls/ccm.h"
+#include "mbedtls/cmac.h"
+#include "mbedtls/chachapoly.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/pk.h"
+#include "mbedtls/ecdh.h"
+#include "mbedtls/certs.h"
+#include "mbedtls/ssl.h"
+
+/*
+ * Implementation tags reported with the results. A mode implemented in
+ * software on top of an accelerated block cipher is tagged "sw+<engine>".
+ */
+#if defined(KSDK_MBEDTLS_MW_AES)
+#define BENCH_HW_AES "mw_aes"
+#elif defined(MBEDTLS_FREESCALE_LTC_AES)
+#define BENCH_HW_AES "ltc"
+#elif defined(MBEDTLS_FREESCALE_MMCAU_AES)
+#define BENCH_HW_AES "mmcau"
+#elif defined(MBEDTLS_FREESCALE_LPC_AES)
+#define BENCH_HW_AES "lpc"
+#elif defined(MBEDTLS_FREESCALE_CAU3_AES)
+#define BENCH_HW_AES "cau3"
+#elif defined(MBEDTLS_FREESCALE_DCP_AES)
+#define BENCH_HW_AES "dcp"
+#elif defined(MBEDTLS_FREESCALE_HASHCRYPT_AES)
+#define BENCH_HW_AES "hashcrypt"
+#elif defined(MBEDTLS_FREESCALE_CAAM_AES)
+#define BENCH_HW_AES "caam"
+#elif defined(MBEDTLS_AES_ALT)
+#define BENCH_HW_AES "alt"
+#endif
+
+#if defined(BENCH_HW_AES)
+#define BENCH_IMPL_AES      BENCH_HW_AES
+#define BENCH_IMPL_AES_MODE "sw+" BENCH_HW_AES
+#else
+#define BENCH_IMPL_AES      "sw"
+#define BENCH_IMPL_AES_MODE "sw"
+#endif
+
+#if defined(MBEDTLS_GCM_ALT) || defined(MBEDTLS_FREESCALE_LTC_AES_GCM) || \
+    defined(MBEDTLS_FREESCALE_LPC_AES_GCM)
+#define BENCH_IMPL_GCM BENCH_IMPL_AES
+#else
+#define BENCH_IMPL_GCM BENCH_IMPL_AES_MODE
+#endif
+
+#if defined(MBEDTLS_CCM_ALT)
+#define BENCH_IMPL_CCM BENCH_IMPL_AES
+#else
+#define BENCH_IMPL_CCM BENCH_IMPL_AES_MODE
+#endif
+
+#if defined(MBEDTLS_CMAC_ALT)
+#define BENCH_IMPL_CMAC "alt"
+#else
+#define BENCH_IMPL_CMAC BENCH_IMPL_AES_MODE
+#endif
+
+#if defined(MBEDTLS_FREESCALE_LTC_DES)
+#define BENCH_IMPL_DES "ltc"
+#elif defined(MBEDTLS_FREESCALE_MMCAU_DES)
+#define BENCH_IMPL_DES "mmcau"
+#elif defined(MBEDTLS_FREESCALE_CAU3_DES)
+#define BENCH_IMPL_DES "cau3"
+#elif defined(MBEDTLS_FREESCALE_CAAM_DES)
+#define BENCH_IMPL_DES "caam"
+#elif defined(MBEDTLS_DES_ALT)
+#define BENCH_IMPL_DES "alt"
+#else
+#define BENCH_IMPL_DES "sw"
+#endif
+
+#if defined(MBEDTLS_FREESCALE_LTC_SHA1)
+#define BENCH_IMPL_SHA1 "ltc"
+#elif defined(MBEDTLS_FREESCALE_MMCAU_SHA1)
+#define BENCH_IMPL_SHA1 "mmcau"
+#elif defined(MBEDTLS_FREESCALE_LPC_SHA1)
+#define BENCH_IMPL_SHA1 "lpc"
+#elif defined(MBEDTLS_FREESCALE_CAU3_SHA1)
+#define BENCH_IMPL_SHA1 "cau3"
+#elif defined(MBEDTLS_FREESCALE_DCP_SHA1)
+#define BENCH_IMPL_SHA1 "dcp"
+#elif defined(MBEDTLS_FREESCALE_HASHCRYPT_SHA1)
+#define BENCH_IMPL_SHA1 "hashcrypt"
+#elif defined(MBEDTLS_FREESCALE_CAAM_SHA1)
+#define BENCH_IMPL_SHA1 "caam"
+#elif defined(MBEDTLS_SHA1_ALT) || defined(MBEDTLS_SHA1_PROCESS_ALT)
+#define BENCH_IMPL_SHA1 "alt"
+#else
+#define BENCH_IMPL_SHA1 "sw"
+#endif
+
+#if defined(MBEDTLS_FREESCALE_LTC_SHA256)
+#define BENCH_IMPL_SHA256 "ltc"
+#elif defined(MBEDTLS_FREESCALE_MMCAU_SHA256)
+#define BENCH_IMPL_SHA256 "mmcau"
+#elif defined(MBEDTLS_FREESCALE_LPC_SHA256)
+#define BENCH_IMPL_SHA256 "lpc"
+#elif defined(MBEDTLS_FREESCALE_CAU3_SHA256)
+#define BENCH_IMPL_SHA256 "cau3"
+#elif defined(MBEDTLS_FREESCALE_DCP_SHA256)
+#define BENCH_IMPL_SHA256 "dcp"
+#elif defined(MBEDTLS_FREESCALE_HASHCRYPT_SHA256)
+#define BENCH_IMPL_SHA256 "hashcrypt"
+#elif defined(MBEDTLS_FREESCALE_CAAM_SHA256)
+#define BENCH_IMPL_SHA256 "caam"
+#elif defined(MBEDTLS_SHA256_ALT) || defined(MBEDTLS_SHA256_PROCESS_ALT)
+#define BENCH_IMPL_SHA256 "alt"
+#else
+#define BENCH_IMPL_SHA256 "sw"
+#endif
+
+#if defined(MBEDTLS_FREESCALE_LTC_PKHA)
+#define BENCH_IMPL_PKHA "ltc"
+#elif defined(MBEDTLS_FREESCALE_CAU3_PKHA)
+#define BENCH_IMPL_PKHA "cau3"
+#elif defined(MBEDTLS_FREESCALE_CASPER_PKHA)
+#define BENCH_IMPL_PKHA "casper"
+#elif defined(MBEDTLS_FREESCALE_CAAM_PKHA)
+#define BENCH_IMPL_PKHA "caam"
+#elif defined(MBEDTLS_ECP_ALT)
+#define BENCH_IMPL_PKHA "alt"
+#else
+#define BENCH_IMPL_PKHA "sw"
+#endif
+
+#if defined(MBEDTLS_CHACHAPOLY_ALT) || defined(MBEDTLS_CHACHA20_ALT) || \
+    defined(MBEDTLS_POLY1305_ALT)
+#define BENCH_IMPL_CHACHAPOLY "alt"
+#else
+#define BENCH_IMPL_CHACHAPOLY "sw"
+#endif
+
+/* Bytes processed by one bulk operation */
+#define BENCH_BUFSIZE       1024
+
+/* Size of each direction of the in-memory BIO pair */
+#define BENCH_PIPE_SIZE     4096
+
+/* Bound on the client/server round trips of one TLS handshake */
+#define BENCH_TLS_ROUNDS    64
+
+/* Returned by a setup function when the case can't run in this build */
+#define BENCH_SKIP          1
+
+#define BENCH_TLS_CRED_PSK  0
+#define BENCH_TLS_CRED_EC   1
+#define BENCH_TLS_CRED_RSA  2
+
+#if defined(MBEDTLS_SSL_CLI_C) && defined(MBEDTLS_SSL_SRV_C) && \
+    defined(MBEDTLS_CERTS_C) && defined(MBEDTLS_X509_CRT_PARSE_C) && \
+    defined(MBEDTLS_PK_PARSE_C) && defined(MBEDTLS_SSL_PROTO_TLS1_2)
+#define BENCH_TLS
+#endif
+
+/* One direction of the in-memory BIO pair */
+typedef struct
+{
+    unsigned char data[BENCH_PIPE_SIZE];
+    size_t head;
+    size_t len;
+}
+bench_pipe;
+
+typedef struct
+{
+    bench_pipe *rx;
+    bench_pipe *tx;
+}
+bench_bio;
+
+#if defined(BENCH_TLS)
+typedef struct
+{
+    bench_pipe c2s;
+    bench_pipe s2c;
+    bench_bio cli_bio;
+    bench_bio srv_bio;
+    mbedtls_ssl_config cli_conf;
+    mbedtls_ssl_config srv_conf;
+    mbedtls_ssl_context cli;
+    mbedtls_ssl_context srv;
+    mbedtls_x509_crt ca;
+    mbedtls_x509_crt srv_crt;
+    mbedtls_pk_context srv_key;
+    int ciphersuites[2];
+}
+bench_tls;
+#endif
+
+typedef struct
+{
+    unsigned char buf[BENCH_BUFSIZE];
+    unsigned char out[BENCH_BUFSIZE];
+    unsigned char tmp[64];
+    int arg;
+    union
+    {
+#if defined(MBEDTLS_AES_C)
+        mbedtls_aes_context aes;
+#endif
+#if defined(MBEDTLS_GCM_C)
+        mbedtls_gcm_context gcm;
+#endif
+#if defined(MBEDTLS_CCM_C)
+        mbedtls_ccm_context ccm;
+#endif
+#if defined(MBEDTLS_DES_C)
+        mbedtls_des_context des;
+        mbedtls_des3_context des3;
+#endif
+#if defined(MBEDTLS_CHACHAPOLY_C)
+        mbedtls_chachapoly_context chachapoly;
+#endif
+#if defined(MBEDTLS_CTR_DRBG_C)
+        mbedtls_ctr_drbg_context ctr_drbg;
+#endif
+#if defined(MBEDTLS_PK_PARSE_C)
+        struct
+        {
+            mbedtls_pk_context key;
+            unsigned char sig[MBEDTLS_MPI_MAX_SIZE];
+            size_t sig_len;
+        } pk;
+#endif
+#if defined(MBEDTLS_ECDH_C)
+        struct
+        {
+            mbedtls_ecp_group grp;
+            mbedtls_mpi d;
+            mbedtls_mpi z;
+            mbedtls_ecp_point Q;
+            mbedtls_ecp_point Qp;
+        } ecdh;
+#endif
+#if defined(BENCH_TLS)
+        bench_tls tls;
+#endif
+        int dummy;
+    } u;
+}
+bench_state;
+
+typedef struct
+{
+    const char *name;
+    const char *impl;
+    size_t bytes;           /* per operation, 0 if not a bulk operation */
+    int arg;                /* key size, curve, ... */
+    int (*setup)( bench_state *st );
+    int (*run)( bench_state *st );
+    void (*cleanup)( bench_state *st );
+}
+bench_case;
+
+/*
+ * Not a secure generator: a fixed sequence keeps the runs comparable.
+ */
+static uint32_t bench_rng_state;
+
+static int bench_rand( void *p_rng, unsigned char *output, size_t len )
+{
+    uint32_t x = bench_rng_state;
+    (void) p_rng;
+
+    while( len-- > 0 )
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        *output++ = (unsigned char) x;
+    }
+    bench_rng_state = x;
+
+    return( 0 );
+}
+
+static void bench_noop_cleanup( bench_state *st )
+{
+    (void) st;
+}
+
+/*
+ * Hashes
+ */
+#if defined(MBEDTLS_MD5_C)
+static int bench_md5( bench_state *st )
+{
+    return( mbedtls_md5_ret( st->buf, BENCH_BUFSIZE, st->tmp ) );
+}
+#endif
+
+#if defined(MBEDTLS_SHA1_C)
+static int bench_sha1( bench_state *st )
+{
+    return( mbedtls_sha1_ret( st->buf, BENCH_BUFSIZE, st->tmp ) );
+}
+#endif
+
+#if defined(MBEDTLS_SHA256_C)
+static int bench_sha256( bench_state *st )
+{
+    return( mbedtls_sha256_ret( st->buf, BENCH_BUFSIZE, st->tmp, 0 ) );
+}
+#endif
+
+#if defined(MBEDTLS_SHA512_C)
+static int bench_sha512( bench_state *st )
+{
+    return( mbedtls_sha512_ret( st->buf, BENCH_BUFSIZE, st->tmp, 0 ) );
+}
+#endif
+
+static int bench_none_setup( bench_state *st )
+{
+    (void) st;
+    return( 0 );
+}
+
+/*
+ * AES and its modes, st->arg is the key size in bits
+ */
+#if defined(MBEDTLS_AES_C)
+static int bench_aes_setup( bench_state *st )
+{
+    mbedtls_aes_init( &st->u.aes );
+    return( mbedtls_aes_setkey_enc( &st->u.aes, st->tmp, st->arg ) );
+}
+
+static void bench_aes_cleanup( bench_state *st )
+{
+    mbedtls_aes_free( &st->u.aes );
+}
+
+static int bench_aes_ecb( bench_state *st )
+{
+    int ret = 0;
+    size_t i;
+
+    for( i = 0; ret == 0 && i < BENCH_BUFSIZE; i += 16 )
+        ret = mbedtls_aes_crypt_ecb( &st->u.aes, MBEDTLS_AES_ENCRYPT,
+                                     st->buf + i, st->out + i );
+
+    return( ret );
+}
+
+#if defined(MBEDTLS_CIPHER_MODE_CBC)
+static int bench_aes_cbc( bench_state *st )
+{
+    return( mbedtls_aes_crypt_cbc( &st->u.aes, MBEDTLS_AES_ENCRYPT, BENCH_BUFSIZE,
+                                   st->tmp, st->buf, st->out ) );
+}
+#endif
+
+#if defined(MBEDTLS_CIPHER_MODE_CTR)
+static int bench_aes_ctr( bench_state *st )
+{
+    size_t nc_off = 0;
+
+    return( mbedtls_aes_crypt_ctr( &st->u.aes, BENCH_BUFSIZE, &nc_off, st->tmp,
+                                   st->tmp + 16, st->buf, st->out ) );
+}
+#endif
+#endif /* MBEDTLS_AES_C */
+
+#if defined(MBEDTLS_GCM_C)
+static int bench_gcm_setup( bench_state *st )
+{
+    mbedtls_gcm_init( &st->u.gcm );
+    return( mbedtls_gcm_setkey( &st->u.gcm, MBEDTLS_CIPHER_ID_AES, st->tmp, st->arg ) );
+}
+
+static int bench_gcm( bench_state *st )
+{
+    return( mbedtls_gcm_crypt_and_tag( &st->u.gcm, MBEDTLS_GCM_ENCRYPT, BENCH_BUFSIZE,
+                                       st->tmp, 12, st->tmp + 16, 13,
+                                       st->buf, st->out, 16, st->tmp + 32 ) );
+}
+
+static void bench_gcm_cleanup( bench_state *st )
+{
+    mbedtls_gcm_free( &st->u.gcm );
+}
+#endif
+
+#if defined(MBEDTLS_CCM_C)
+static int bench_ccm_setup( bench_state *st )
+{
+    mbedtls_ccm_init( &st->u.ccm );
+    return( mbedtls_ccm_setkey( &st->u.ccm, MBEDTLS_CIPHER_ID_AES, st->tmp, st->arg ) );
+}
+
+static int bench_ccm( bench_state *st )
+{
+    return( mbedtls_ccm_encrypt_and_tag( &st->u.ccm, BENCH_BUFSIZE,
+                                         st->tmp, 12, st->tmp + 16, 13,
+                                         st->buf, st->out, st->tmp + 32, 16 ) );
+}
+
+static void bench_ccm_cleanup( bench_state *st )
+{
+    mbedtls_ccm_free( &st->u.ccm );
+}
+#endif
+
+#if defined(MBEDTLS_CMAC_C) && defined(MBEDTLS_AES_C)
+static int bench_aes_cmac( bench_state *st )
+{
+    const mbedtls_cipher_info_t *info;
+
+    info = mbedtls_cipher_info_from_type( MBEDTLS_CIPHER_AES_128_ECB );
+    return( mbedtls_cipher_cmac( info, st->tmp, 128, st->buf, BENCH_BUFSIZE,
+                                 st->out ) );
+}
+#endif
+
+/*
+ * DES
+ */
+#if defined(MBEDTLS_DES_C) && defined(MBEDTLS_CIPHER_MODE_CBC)
+static int bench_des_setup( bench_state *st )
+{
+    mbedtls_des_init( &st->u.des );
+    return( mbedtls_des_setkey_enc( &st->u.des, st->tmp ) );
+}
+
+static int bench_des( bench_state *st )
+{
+    return( mbedtls_des_crypt_cbc( &st->u.des, MBEDTLS_DES_ENCRYPT, BENCH_BUFSIZE,
+                                   st->tmp + 32, st->buf, st->out ) );
+}
+
+static void bench_des_cleanup( bench_state *st )
+{
+    mbedtls_des_free( &st->u.des );
+}
+
+static int bench_des3_setup( bench_state *st )
+{
+    mbedtls_des3_init( &st->u.des3 );
+    return( mbedtls_des3_set3key_enc( &st->u.des3, st->tmp ) );
+}
+
+static int bench_des3( bench_state *st )
+{
+    return( mbedtls_des3_crypt_cbc( &st->u.des3, MBEDTLS_DES_ENCRYPT, BENCH_BUFSIZE,
+                                    st->tmp + 32, st->buf, st->out ) );
+}
+
+static void bench_des3_cleanup( bench_state *st )
+{
+    mbedtls_des3_free( &st->u.des3 );
+}
+#endif
+
+/*
+ * ChaCha20-Poly1305
+ */
+#if defined(MBEDTLS_CHACHAPOLY_C)
+static int bench_chachapoly_setup( bench_state *st )
+{
+    mbedtls_chachapoly_init( &st->u.chachapoly );
+    return( mbedtls_chachapoly_setkey( &st->u.chachapoly, st->tmp ) );
+}
+
+static int bench_chachapoly( bench_state *st )
+{
+    return( mbedtls_chachapoly_encrypt_and_tag( &st->u.chachapoly, BENCH_BUFSIZE,
+                                                st->tmp + 32, st->tmp + 48, 13,
+                                                st->buf, st->out, st->tmp + 16 ) );
+}
+
+static void bench_chachapoly_cleanup( bench_state *st )
+{
+    mbedtls_chachapoly_free( &st->u.chachapoly );
+}
+#endif
+
+/*
+ * CTR_DRBG
+ */
+#if defined(MBEDTLS_CTR_DRBG_C)
+static int bench_ctr_drbg_setup( bench_state *st )
+{
+    mbedtls_ctr_drbg_init( &st->u.ctr_drbg );
+    return( mbedtls_ctr_drbg_seed( &st->u.ctr_drbg, bench_rand, NULL, NULL, 0 ) );
+}
+
+static int bench_ctr_drbg( bench_state *st )
+{
+    return( mbedtls_ctr_drbg_random( &st->u.ctr_drbg, st->out, BENCH_BUFSIZE ) );
+}
+
+static void bench_ctr_drbg_cleanup( bench_state *st )
+{
+    mbedtls_ctr_drbg_free( &st->u.ctr_drbg );
+}
+#endif
+
+/*
+ * Signatures with the test keys of certs.c, st->arg selects the key
+ */
+#if defined(MBEDTLS_PK_PARSE_C) && defined(MBEDTLS_CERTS_C) && \
+    defined(MBEDTLS_SHA256_C)
+static int bench_pk_setup( bench_state *st )
+{
+    int ret;
+    const char *key;
+    size_t key_len;
+
+    if( st->arg == BENCH_TLS_CRED_RSA )
+    {
+        key = mbedtls_test_srv_key_rsa;
+        key_len = mbedtls_test_srv_key_rsa_len;
+    }
+    else
+    {
+        key = mbedtls_test_srv_key_ec;
+        key_len = mbedtls_test_srv_key_ec_len;
+    }
+
+    mbedtls_pk_init( &st->u.pk.key );
+    if( ( ret = mbedtls_pk_parse_key( &st->u.pk.key, (const unsigned char *) key,
+                                      key_len, NULL, 0 ) ) != 0 )
+        return( ret );
+
+    if( !mbedtls_pk_can_do( &st->u.pk.key, st->arg == BENCH_TLS_CRED_RSA ?
+                                           MBEDTLS_PK_RSA : MBEDTLS_PK_ECDSA ) )
+        return( BENCH_SKIP );
+
+    /* verify runs on this signature */
+    return( mbedtls_pk_sign( &st->u.pk.key, MBEDTLS_MD_SHA256, st->tmp, 32,
+                             st->u.pk.sig, &st->u.pk.sig_len, bench_rand, NULL ) );
+}
+
+static int bench_pk_sign( bench_state *st )
+{
+    return( mbedtls_pk_sign( &st->u.pk.key, MBEDTLS_MD_SHA256, st->tmp, 32,
+                             st->u.pk.sig, &st->u.pk.sig_len, bench_rand, NULL ) );
+}
+
+static int bench_pk_verify( bench_state *st )
+{
+    return( mbedtls_pk_verify( &st->u.pk.key, MBEDTLS_MD_SHA256, st->tmp, 32,
+                               st->u.pk.sig, st->u.pk.sig_len ) );
+}
+
+static void bench_pk_cleanup( bench_state *st )
+{
+    mbedtls_pk_free( &st->u.pk.key );
+}
+#endif
+
+/*
+ * Ephemeral ECDH: one key pair generation and one shared secret computation,
+ * st->arg is the group id
+ */
+#if defined(MBEDTLS_ECDH_C)
+static int bench_ecdh_setup( bench_state *st )
+{
+    int ret;
+
+    mbedtls_ecp_group_init( &st->u.ecdh.grp );
+    mbedtls_mpi_init( &st->u.ecdh.d );
+    mbedtls_mpi_init( &st->u.ecdh.z );
+    mbedtls_ecp_point_init( &st->u.ecdh.Q );
+    mbedtls_ecp_point_init( &st->u.ecdh.Qp );
+
+    if( mbedtls_ecp_curve_info_from_grp_id( (mbedtls_ecp_group_id) st->arg ) == NULL )
+        return( BENCH_SKIP );
+
+    if( ( ret = mbedtls_ecp_group_load( &st->u.ecdh.grp,
+                                        (mbedtls_ecp_group_id) st->arg ) ) != 0 )
+        return( ret );
+
+    /* peer public key */
+    return( mbedtls_ecdh_gen_public( &st->u.ecdh.grp, &st->u.ecdh.d, &st->u.ecdh.Qp,
+                                     bench_rand, NULL ) );
+}
+
+static int bench_ecdh( bench_state *st )
+{
+    int ret;
+
+    if( ( ret = mbedtls_ecdh_gen_public( &st->u.ecdh.grp, &st->u.ecdh.d, &st->u.ecdh.Q,
+                                         bench_rand, NULL ) ) != 0 )
+        return( ret );
+
+    return( mbedtls_ecdh_compute_shared( &st->u.ecdh.grp, &st->u.ecdh.z, &st->u.ecdh.Qp,
+                                         &st->u.ecdh.d, bench_rand, NULL ) );
+}
+
+static void bench_ecdh_cleanup( bench_state *st )
+{
+    mbedtls_ecp_group_free( &st->u.ecdh.grp );
+    mbedtls_mpi_free( &st->u.ecdh.d );
+    mbedtls_mpi_free( &st->u.ecdh.z );
+    mbedtls_ecp_point_free( &st->u.ecdh.Q );
+    mbedtls_ecp_point_free( &st->u.ecdh.Qp );
+}
+#endif
+
+/*
+ * TLS over an in-memory BIO pair
+ */
+#if defined(BENCH_TLS)
+static int bench_bio_send( void *ctx, const unsigned char *buf, size_t len )
+{
+    bench_pipe *p = ( (bench_bio *) ctx )->tx;
+    size_t tail, n, i;
+
+    if( p->len == BENCH_PIPE_SIZE )
+        return( MBEDTLS_ERR_SSL_WANT_WRITE );
+
+    n = BENCH_PIPE_SIZE - p->len;
+    if( n > len )
+        n = len;
+
+    tail = ( p->head + p->len ) % BENCH_PIPE_SIZE;
+    for( i = 0; i < n; i++ )
+        p->data[( tail + i ) % BENCH_PIPE_SIZE] = buf[i];
+    p->len += n;
+
+    return( (int) n );
+}
+
+static int bench_bio_recv( void *ctx, unsigned char *buf, size_t len )
+{
+    bench_pipe *p = ( (bench_bio *) ctx )->rx;
+    size_t n, i;
+
+    if( p->len == 0 )
+        return( MBEDTLS_ERR_SSL_WANT_READ );
+
+    n = p->len < len ? p->len : len;
+    for( i = 0; i < n; i++ )
+        buf[i] = p->data[( p->head + i ) % BENCH_PIPE_SIZE];
+    p->head = ( p->head + n ) % BENCH_PIPE_SIZE;
+    p->len -= n;
+
+    return( (int) n );
+}
+
+/* Ciphersuites of the TLS cases, indexed by bench_case.arg */
+static const struct
+{
+    const char *suite;
+    int cred;
+}
+bench_tls_suites[] =
+{
+    { "TLS-ECDHE-ECDSA-WITH-AES-128-GCM-SHA256", BENCH_TLS_CRED_EC  },
+    { "TLS-ECDHE-RSA-WITH-AES-128-GCM-SHA256",   BENCH_TLS_CRED_RSA },
+    { "TLS-PSK-WITH-AES-128-CCM",                BENCH_TLS_CRED_PSK },
+    { "TLS-ECDHE-ECDSA-WITH-AES-128-CBC-SHA256", BENCH_TLS_CRED_EC  },
+    { "TLS-ECDHE-ECDSA-WITH-CHACHA20-POLY1305-SHA256", BENCH_TLS_CRED_EC },
+};
+
+static const unsigned char bench_tls_psk[16] = { 0x42 };
+static const char bench_tls_psk_id[] = "bench";
+
+/* The test certificates have fixed validity dates, everything else is checked */
+static int bench_tls_verify( void *data, mbedtls_x509_crt *crt, int depth,
+                             uint32_t *flags )
+{
+    (void) data;
+    (void) crt;
+    (void) depth;
+
+    *flags &= ~( MBEDTLS_X509_BADCERT_EXPIRED | MBEDTLS_X509_BADCERT_FUTURE );
+
+    return( 0 );
+}
+
+static int bench_tls_handshake( bench_tls *t )
+{
+    int ret_cli, ret_srv, i;
+
+    for( i = 0; i < BENCH_TLS_ROUNDS; i++ )
+    {
+        ret_cli = mbedtls_ssl_handshake( &t->cli );
+        if( ret_cli != 0 && ret_cli != MBEDTLS_ERR_SSL_WANT_READ &&
+            ret_cli != MBEDTLS_ERR_SSL_WANT_WRITE )
+            return( ret_cli );
+
+        ret_srv = mbedtls_ssl_handshake( &t->srv );
+        if( ret_srv != 0 && ret_srv != MBEDTLS_ERR_SSL_WANT_READ &&
+            ret_srv != MBEDTLS_ERR_SSL_WANT_WRITE )
+            return( ret_srv );
+
+        if( ret_cli == 0 && ret_srv == 0 )
+            return( 0 );
+    }
+
+    return( MBEDTLS_ERR_SSL_TIMEOUT );
+}
+
+static int bench_tls_setup( bench_state *st )
+{
+    int ret, cred;
+    bench_tls *t = &st->u.tls;
+
+    memset( t, 0, sizeof( *t ) );
+    mbedtls_ssl_config_init( &t->cli_conf );
+    mbedtls_ssl_config_init( &t->srv_conf );
+    mbedtls_ssl_init( &t->cli );
+    mbedtls_ssl_init( &t->srv );
+    mbedtls_x509_crt_init( &t->ca );
+    mbedtls_x509_crt_init( &t->srv_crt );
+    mbedtls_pk_init( &t->srv_key );
+
+    t->ciphersuites[0] = mbedtls_ssl_get_ciphersuite_id( bench_tls_suites[st->arg].suite );
+    if( t->ciphersuites[0] == 0 )
+        return( BENCH_SKIP );
+    cred = bench_tls_suites[st->arg].cred;
+
+    if( ( ret = mbedtls_ssl_config_defaults( &t->cli_conf, MBEDTLS_SSL_IS_CLIENT,
+                                             MBEDTLS_SSL_TRANSPORT_STREAM,
+                                             MBEDTLS_SSL_PRESET_DEFAULT ) ) != 0 ||
+        ( ret = mbedtls_ssl_config_defaults( &t->srv_conf, MBEDTLS_SSL_IS_SERVER,
+                                             MBEDTLS_SSL_TRANSPORT_STREAM,
+                                             MBEDTLS_SSL_PRESET_DEFAULT ) ) != 0 )
+        return( ret );
+
+    mbedtls_ssl_conf_rng( &t->cli_conf, bench_rand, NULL );
+    mbedtls_ssl_conf_rng( &t->srv_conf, bench_rand, NULL );
+    mbedtls_ssl_conf_ciphersuites( &t->cli_conf, t->ciphersuites );
+    mbedtls_ssl_conf_ciphersuites( &t->srv_conf, t->ciphersuites );
+
+    if( cred == BENCH_TLS_CRED_PSK )
+    {
+#if defined(MBEDTLS_KEY_EXCHANGE__SOME__PSK_ENABLED)
+        if( ( ret = mbedtls_ssl_conf_psk( &t->cli_conf, bench_tls_psk, sizeof( bench_tls_psk ),
+                                          (const unsigned char *) bench_tls_psk_id,
+                                          sizeof( bench_tls_psk_id ) - 1 ) ) != 0 ||
+            ( ret = mbedtls_ssl_conf_psk( &t->srv_conf, bench_tls_psk, sizeof( bench_tls_psk ),
+                                          (const unsigned char *) bench_tls_psk_id,
+                                          sizeof( bench_tls_psk_id ) - 1 ) ) != 0 )
+            return( ret );
+#else
+        return( BENCH_SKIP );
+#endif
+    }
+    else
+    {
+        /* the client verifies the server chain, as it would in the field */
+        if( ( ret = mbedtls_x509_crt_parse( &t->ca, (const unsigned char *) mbedtls_test_cas_pem,
+                                            mbedtls_test_cas_pem_len ) ) != 0 )
+            return( ret );
+
+        if( cred == BENCH_TLS_CRED_RSA )
+        {
+            ret = mbedtls_x509_crt_parse( &t->srv_crt, (const unsigned char *) mbedtls_test_srv_crt_rsa,
+                                          mbedtls_test_srv_crt_rsa_len );
+            if( ret == 0 )
+                ret = mbedtls_pk_parse_key( &t->srv_key, (const unsigned char *) mbedtls_test_srv_key_rsa,
+                                            mbedtls_test_srv_key_rsa_len, NULL, 0 );
+        }
+        else
+        {
+            ret = mbedtls_x509_crt_parse( &t->srv_crt, (const unsigned char *) mbedtls_test_srv_crt_ec,
+                                          mbedtls_test_srv_crt_ec_len );
+            if( ret == 0 )
+                ret = mbedtls_pk_parse_key( &t->srv_key, (const unsigned char *) mbedtls_test_srv_key_ec,
+                                            mbedtls_test_srv_key_ec_len, NULL, 0 );
+        }
+        if( ret != 0 )
+            return( ret );
+
+        mbedtls_ssl_conf_authmode( &t->cli_conf, MBEDTLS_SSL_VERIFY_REQUIRED );
+        mbedtls_ssl_conf_ca_chain( &t->cli_conf, &t->ca, NULL );
+        mbedtls_ssl_conf_verify( &t->cli_conf, bench_tls_verify, NULL );
+        if( ( ret = mbedtls_ssl_conf_own_cert( &t->srv_conf, &t->srv_crt, &t->srv_key ) ) != 0 )
+            return( ret );
+    }
+
+    if( ( ret = mbedtls_ssl_setup( &t->cli, &t->cli_conf ) ) != 0 ||
+        ( ret = mbedtls_ssl_setup( &t->srv, &t->srv_conf ) ) != 0 )
+        return( ret );
+
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+    if( ( ret = mbedtls_ssl_set_hostname( &t->cli, "localhost" ) ) != 0 )
+        return( ret );
+#endif
+
+    t->cli_bio.rx = &t->s2c;
+    t->cli_bio.tx = &t->c2s;
+    t->srv_bio.rx = &t->c2s;
+    t->srv_bio.tx = &t->s2c;
+    mbedtls_ssl_set_bio( &t->cli, &t->cli_bio, bench_bio_send, bench_bio_recv, NULL );
+    mbedtls_ssl_set_bio( &t->srv, &t->srv_bio, bench_bio_send, bench_bio_recv, NULL );
+
+    return( 0 );
+}
+
+/* A full handshake, without session resumption */
+static int bench_tls_full_handshake( bench_state *st )
+{
+    int ret;
+    bench_tls *t = &st->u.tls;
+
+    if( ( ret = mbedtls_ssl_session_reset( &t->cli ) ) != 0 ||
+        ( ret = mbedtls_ssl_session_reset( &t->srv ) ) != 0 )
+        return( ret );
+
+    t->c2s.len = 0;
+    t->s2c.len = 0;
+
+    return( bench_tls_handshake( t ) );
+}
+
+static int bench_tls_record_setup( bench_state *st )
+{
+    int ret;
+
+    if( ( ret = bench_tls_setup( st ) ) != 0 )
+        return( ret );
+
+    return( bench_tls_handshake( &st->u.tls ) );
+}
+
+/* Client to server transfer of BENCH_BUFSIZE bytes of application data */
+static int bench_tls_record( bench_state *st )
+{
+    int ret;
+    size_t sent = 0, received = 0;
+    bench_tls *t = &st->u.tls;
+
+    while( received < BENCH_BUFSIZE )
+    {
+        if( sent < BENCH_BUFSIZE )
+        {
+            ret = mbedtls_ssl_write( &t->cli, st->buf + sent, BENCH_BUFSIZE - sent );
+            if( ret > 0 )
+                sent += ret;
+            else if( ret != MBEDTLS_ERR_SSL_WANT_WRITE )
+                return( ret );
+        }
+
+        ret = mbedtls_ssl_read( &t->srv, st->out, BENCH_BUFSIZE );
+        if( ret > 0 )
+            received += ret;
+        else if( ret != MBEDTLS_ERR_SSL_WANT_READ )
+            return( ret == 0 ? MBEDTLS_ERR_SSL_CONN_EOF : ret );
+    }
+
+    return( 0 );
+}
+
+static void bench_tls_cleanup( bench_state *st )
+{
+    bench_tls *t = &st->u.tls;
+
+    mbedtls_ssl_free( &t->cli );
+    mbedtls_ssl_free( &t->srv );
+    mbedtls_ssl_config_free( &t->cli_conf );
+    mbedtls_ssl_config_free( &t->srv_conf );
+    mbedtls_x509_crt_free( &t->ca );
+    mbedtls_x509_crt_free( &t->srv_crt );
+    mbedtls_pk_free( &t->srv_key );
+}
+#endif /* BENCH_TLS */
+
+static const bench_case bench_cases[] =
+{
+#if defined(MBEDTLS_MD5_C)
+    { "MD5", "sw", BENCH_BUFSIZE, 0,
+      bench_none_setup, bench_md5, bench_noop_cleanup },
+#endif
+#if defined(MBEDTLS_SHA1_C)
+    { "SHA-1", BENCH_IMPL_SHA1, BENCH_BUFSIZE, 0,
+      bench_none_setup, bench_sha1, bench_noop_cleanup },
+#endif
+#if defined(MBEDTLS_SHA256_C)
+    { "SHA-256", BENCH_IMPL_SHA256, BENCH_BUFSIZE, 0,
+      bench_none_setup, bench_sha256, bench_noop_cleanup },
+#endif
+#if defined(MBEDTLS_SHA512_C)
+    { "SHA-512", "sw", BENCH_BUFSIZE, 0,
+      bench_none_setup, bench_sha512, bench_noop_cleanup },
+#endif
+#if defined(MBEDTLS_AES_C)
+    { "AES-ECB-128", BENCH_IMPL_AES, BENCH_BUFSIZE, 128,
+      bench_aes_setup, bench_aes_ecb, bench_aes_cleanup },
+#if defined(MBEDTLS_CIPHER_MODE_CBC)
+    { "AES-CBC-128", BENCH_IMPL_AES, BENCH_BUFSIZE, 128,
+      bench_aes_setup, bench_aes_cbc, bench_aes_cleanup },
+    { "AES-CBC-256", BENCH_IMPL_AES, BENCH_BUFSIZE, 256,
+      bench_aes_setup, bench_aes_cbc, bench_aes_cleanup },
+#endif
+#if defined(MBEDTLS_CIPHER_MODE_CTR)
+    { "AES-CTR-128", BENCH_IMPL_AES, BENCH_BUFSIZE, 128,
+      bench_aes_setup, bench_aes_ctr, bench_aes_cleanup },
+#endif
+#endif /* MBEDTLS_AES_C */
+#if defined(MBEDTLS_GCM_C)
+    { "AES-GCM-128", BENCH_IMPL_GCM, BENCH_BUFSIZE, 128,
+      bench_gcm_setup, bench_gcm, bench_gcm_cleanup },
+    { "AES-GCM-256", BENCH_IMPL_GCM, BENCH_BUFSIZE, 256,
+      bench_gcm_setup, bench_gcm, bench_gcm_cleanup },
+#endif
+#if defined(MBEDTLS_CCM_C)
+    { "AES-CCM-128", BENCH_IMPL_CCM, BENCH_BUFSIZE, 128,
+      bench_ccm_setup, bench_ccm, bench_ccm_cleanup },
+    { "AES-CCM-256", BENCH_IMPL_CCM, BENCH_BUFSIZE, 256,
+      bench_ccm_setup, bench_ccm, bench_ccm_cleanup },
+#endif
+#if defined(MBEDTLS_CMAC_C) && defined(MBEDTLS_AES_C)
+    { "AES-CMAC-128", BENCH_IMPL_CMAC, BENCH_BUFSIZE, 0,
+      bench_none_setup, bench_aes_cmac, bench_noop_cleanup },
+#endif
+#if defined(MBEDTLS_DES_C) && defined(MBEDTLS_CIPHER_MODE_CBC)
+    { "DES-CBC", BENCH_IMPL_DES, BENCH_BUFSIZE, 0,
+      bench_des_setup, bench_des, bench_des_cleanup },
+    { "3DES-CBC", BENCH_IMPL_DES, BENCH_BUFSIZE, 0,
+      bench_des3_setup, bench_des3, bench_des3_cleanup },
+#endif
+#if defined(MBEDTLS_CHACHAPOLY_C)
+    { "ChaCha20-Poly1305", BENCH_IMPL_CHACHAPOLY, BENCH_BUFSIZE, 0,
+      bench_chachapoly_setup, bench_chachapoly, bench_chachapoly_cleanup },
+#endif
+#if defined(MBEDTLS_CTR_DRBG_C)
+    { "CTR_DRBG", BENCH_IMPL_AES, BENCH_BUFSIZE, 0,
+      bench_ctr_drbg_setup, bench_ctr_drbg, bench_ctr_drbg_cleanup },
+#endif
+#if defined(MBEDTLS_PK_PARSE_C) && defined(MBEDTLS_CERTS_C) && \
+    defined(MBEDTLS_SHA256_C)
+#if defined(MBEDTLS_RSA_C)
+    { "RSA-2048-sign", BENCH_IMPL_PKHA, 0, BENCH_TLS_CRED_RSA,
+      bench_pk_setup, bench_pk_sign, bench_pk_cleanup },
+    { "RSA-2048-verify", BENCH_IMPL_PKHA, 0, BENCH_TLS_CRED_RSA,
+      bench_pk_setup, bench_pk_verify, bench_pk_cleanup },
+#endif
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+    { "ECDSA-secp256r1-sign", BENCH_IMPL_PKHA, 0, BENCH_TLS_CRED_EC,
+      bench_pk_setup, bench_pk_sign, bench_pk_cleanup },
+    { "ECDSA-secp256r1-verify", BENCH_IMPL_PKHA, 0, BENCH_TLS_CRED_EC,
+      bench_pk_setup, bench_pk_verify, bench_pk_cleanup },
+#endif
+#endif
+#if defined(MBEDTLS_ECDH_C)
+#if defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+    { "ECDHE-secp256r1", BENCH_IMPL_PKHA, 0, MBEDTLS_ECP_DP_SECP256R1,
+      bench_ecdh_setup, bench_ecdh, bench_ecdh_cleanup },
+#endif
+#if defined(MBEDTLS_ECP_DP_SECP384R1_ENABLED)
+    { "ECDHE-secp384r1", BENCH_IMPL_PKHA, 0, MBEDTLS_ECP_DP_SECP384R1,
+      bench_ecdh_setup, bench_ecdh, bench_ecdh_cleanup },
+#endif
+#if defined(MBEDTLS_ECP_DP_CURVE25519_ENABLED)
+    { "ECDHE-x25519", BENCH_IMPL_PKHA, 0, MBEDTLS_ECP_DP_CURVE25519,
+      bench_ecdh_setup, bench_ecdh, bench_ecdh_cleanup },
+#endif
+#endif /* MBEDTLS_ECDH_C */
+#if defined(BENCH_TLS)
+    { "TLS-handshake-ECDHE-ECDSA-AES-128-GCM", BENCH_IMPL_PKHA, 0, 0,
+      bench_tls_setup, bench_tls_full_handshake, bench_tls_cleanup },
+    { "TLS-handshake-ECDHE-RSA-AES-128-GCM", BENCH_IMPL_PKHA, 0, 1,
+      bench_tls_setup, bench_tls_full_handshake, bench_tls_cleanup },
+    { "TLS-handshake-PSK-AES-128-CCM", BENCH_IMPL_CCM, 0, 2,
+      bench_tls_setup, bench_tls_full_handshake, bench_tls_cleanup },
+    { "TLS-record-AES-128-GCM", BENCH_IMPL_GCM, BENCH_BUFSIZE, 0,
+      bench_tls_record_setup, bench_tls_record, bench_tls_cleanup },
+    { "TLS-record-AES-128-CCM", BENCH_IMPL_CCM, BENCH_BUFSIZE, 2,
+      bench_tls_record_setup, bench_tls_record, bench_tls_cleanup },
+    { "TLS-record-AES-128-CBC-SHA256", BENCH_IMPL_AES, BENCH_BUFSIZE, 3,
+      bench_tls_record_setup, bench_tls_record, bench_tls_cleanup },
+    { "TLS-record-CHACHA20-POLY1305", BENCH_IMPL_CHACHAPOLY, BENCH_BUFSIZE, 4,
+      bench_tls_record_setup, bench_tls_record, bench_tls_cleanup },
+#endif /* BENCH_TLS */
+};
+
+/*
+ * JSON output
+ */
+static void bench_u64( char *buf, size_t size, uint64_t v )
+{
+    char tmp[21];
+    size_t n = 0;
+
+    do
+    {
+        tmp[n++] = (char) ( '0' + v % 10 );
+        v /= 10;
+    }
+    while( v != 0 );
+
+    while( n > 0 && size > 1 )
+    {
+        *buf++ = tmp[--n];
+        size--;
+    }
+    *buf = '\0';
+}
+
+/* num / den with three decimals, without floating point formatting */
+static void bench_ratio( char *buf, size_t size, uint64_t num, uint64_t den )
+{
+    uint64_t milli;
+    size_t n;
+
+    if( den == 0 )
+    {
+        mbedtls_snprintf( buf, size, "0" );
+        return;
+    }
+
+    /* keep num * 1000 within 64 bits */
+    while( num > UINT64_MAX / 1000 )
+    {
+        num >>= 1;
+        den = ( den >> 1 ) | 1;
+    }
+    milli = ( num * 1000 + den / 2 ) / den;
+
+    bench_u64( buf, size, milli / 1000 );
+    n = strlen( buf );
+    mbedtls_snprintf( buf + n, size - n, ".%03u", (unsigned) ( milli % 1000 ) );
+}
+
+/* Case insensitive search of the len bytes at tok in name */
+static int bench_contains( const char *name, const char *tok, size_t len )
+{
+    size_t i;
+
+    if( len == 0 )
+        return( 0 );
+
+    for( ; *name != '\0'; name++ )
+    {
+        for( i = 0; i < len && name[i] != '\0'; i++ )
+            if( tolower( (unsigned char) name[i] ) != tolower( (unsigned char) tok[i] ) )
+                break;
+        if( i == len )
+            return( 1 );
+    }
+
+    return( 0 );
+}
+
+static int bench_match( const char *name, const char *filter )
+{
+    size_t len;
+
+    if( filter == NULL || *filter == '\0' )
+        return( 1 );
+
+    while( *filter != '\0' )
+    {
+        len = strcspn( filter, "," );
+        if( bench_contains( name, filter, len ) )
+            return( 1 );
+        filter += len;
+        if( *filter == ',' )
+            filter++;
+    }
+
+    return( 0 );
+}
+
+static void bench_print_result( const bench_platform *platform, const bench_case *c,
+                                int first, int ret, uint32_t ops, uint64_t cycles )
+{
+    char line[320];
+    char ops_s[24], rate[32], per_op[24], per_byte[32];
+    uint64_t hz = platform->hardclock_hz;
+
+    if( ret != 0 )
+    {
+        mbedtls_snprintf( line, sizeof( line ),
+                          "%s    { \"name\": \"%s\", \"impl\": \"%s\", \"error\": %d }",
+                          first ? "" : ",\n", c->name, c->impl, ret );
+        platform->output( line );
+        return;
+    }
+
+    bench_u64( ops_s, sizeof( ops_s ), ops );
+    bench_ratio( rate, sizeof( rate ), (uint64_t) ops * hz, cycles );
+    bench_u64( per_op, sizeof( per_op ), cycles / ops );
+
+    if( c->bytes != 0 )
+    {
+        bench_ratio( per_byte, sizeof( per_byte ), cycles, (uint64_t) ops * c->bytes );
+        mbedtls_snprintf( line, sizeof( line ),
+                          "%s    { \"name\": \"%s\", \"impl\": \"%s\", \"bytes\": %u, "
+                          "\"ops\": %s, \"ops_per_s\": %s, \"cycles_per_op\": %s, "
+                          "\"cycles_per_byte\": %s }",
+                          first ? "" : ",\n", c->name, c->impl, (unsigned) c->bytes,
+                          ops_s, rate, per_op, per_byte );
+    }
+    else
+    {
+        mbedtls_snprintf( line, sizeof( line ),
+                          "%s    { \"name\": \"%s\", \"impl\": \"%s\", "
+                          "\"ops\": %s, \"ops_per_s\": %s, \"cycles_per_op\": %s }",
+                          first ? "" : ",\n", c->name, c->impl, ops_s, rate, per_op );
+    }
+    platform->output( line );
+}
+
+static void bench_print_header( const bench_platform *platform, uint32_t budget_ms )
+{
+    char line[320];
+    char hz[24];
+
+    bench_u64( hz, sizeof( hz ), platform->hardclock_hz );
+    mbedtls_snprintf( line, sizeof( line ),
+                      "{\n  \"benchmark\": \"mbedtls\",\n  \"version\": \"%s\",\n"
+                      "  \"platform\": \"%s\",\n  \"hardclock_hz\": %s,\n"
+                      "  \"budget_ms\": %u,\n",
+                      MBEDTLS_VERSION_STRING, platform->name, hz, (unsigned) budget_ms );
+    platform->output( line );
+
+    mbedtls_snprintf( line, sizeof( line ),
+                      "  \"impl\": { \"aes\": \"%s\", \"gcm\": \"%s\", \"ccm\": \"%s\", "
+                      "\"cmac\": \"%s\", \"des\": \"%s\", \"sha1\": \"%s\", "
+                      "\"sha256\": \"%s\", \"pk\": \"%s\", \"chachapoly\": \"%s\" },\n"
+                      "  \"results\": [\n",
+                      BENCH_IMPL_AES, BENCH_IMPL_GCM, BENCH_IMPL_CCM, BENCH_IMPL_CMAC,
+                      BENCH_IMPL_DES, BENCH_IMPL_SHA1, BENCH_IMPL_SHA256,
+                      BENCH_IMPL_PKHA, BENCH_IMPL_CHACHAPOLY );
+    platform->output( line );
+}
+
+int bench_run( const bench_platform *platform, const char *filter,
+               uint32_t budget_ms )
+{
+    size_t i;
+    int failed = 0, first = 1;
+    bench_state *st;
+    char line[64];
+
+    st = mbedtls_calloc( 1, sizeof( bench_state ) );
+    if( st == NULL )
+        return( -1 );
+
+    bench_print_header( platform, budget_ms );
+
+    for( i = 0; i < sizeof( bench_cases ) / sizeof( bench_cases[0] ); i++ )
+    {
+        const bench_case *c = &bench_cases[i];
+        uint64_t start, now, budget;
+        uint32_t ops = 0;
+        int ret;
+
+        if( !bench_match( c->name, filter ) )
+            continue;
+
+        bench_rng_state = 0x2545F491;
+        memset( st->buf, 0xAA, sizeof( st->buf ) );
+        memset( st->tmp, 0xBB, sizeof( st->tmp ) );
+        st->arg = c->arg;
+
+        ret = c->setup( st );
+        if( ret == BENCH_SKIP )
+        {
+            c->cleanup( st );
+            continue;
+        }
+
+        /* one untimed operation catches errors and warms up the caches */
+        if( ret == 0 )
+            ret = c->run( st );
+
+        budget = platform->hardclock_hz * budget_ms / 1000;
+        start = platform->hardclock();
+        now = start;
+        while( ret == 0 )
+        {
+            ret = c->run( st );
+            ops++;
+            now = platform->hardclock();
+            if( now - start >= budget )
+                break;
+        }
+
+        c->cleanup( st );
+
+        if( ret != 0 )
+            failed++;
+        bench_print_result( platform, c, first, ret, ops, now - start );
+        first = 0;
+    }
+
+    mbedtls_snprintf( line, sizeof( line ), "\n  ],\n  \"failed\": %d\n}\n", failed );
+    platform->output( line );
+
+    mbedtls_free( st );
+
+    return( failed );
+}
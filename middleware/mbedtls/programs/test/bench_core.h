@@ -0,0 +1,74 @@
+/**
+ * \file bench_core.h
+ *
+ * \brief Benchmark core shared by the host and the target benchmark
+ *        programs, reporting its results as JSON
+ */
+/*
+ *  Copyright 2026 NXP
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of mbed TLS (https://tls.mbed.org)
+ */
+#ifndef BENCH_CORE_H
+#define BENCH_CORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief          Services the benchmark core needs from the platform.
+ */
+typedef struct
+{
+    const char *name;               /*!< Platform name, reported as is. */
+    uint64_t (*hardclock)( void );  /*!< Free running cycle counter. */
+    uint64_t hardclock_hz;          /*!< Frequency of the cycle counter. */
+    void (*output)( const char *s );/*!< Writes a piece of the JSON report. */
+}
+bench_platform;
+
+/**
+ * \brief          Run the benchmarks and write one JSON document through
+ *                 \c platform->output.
+ *
+ *                 Every result holds the number of operations done within
+ *                 the time budget, the operations per second, the cycles
+ *                 per operation and, for bulk operations, the cycles per
+ *                 byte. It is tagged with the implementation in use
+ *                 ("sw" or the name of the accelerator), so that runs of
+ *                 builds with and without the ALT options can be compared
+ *                 with scripts/bench_compare.py.
+ *
+ * \param platform  The platform services.
+ * \param filter    NULL to run everything, or a comma separated list of
+ *                  case insensitive substrings of the benchmark names.
+ * \param budget_ms Time spent on each benchmark, at least one operation
+ *                  is always done.
+ *
+ * \return         The number of benchmarks that failed.
+ */
+int bench_run( const bench_platform *platform, const char *filter,
+               uint32_t budget_ms );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_CORE_H */
@@ -0,0 +1,131 @@
+/*
+ *  Benchmark program writing its results as JSON, host side of bench_core.c
+ *
+ *  Copyright 2026 NXP
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of mbed TLS (https://tls.mbed.org)
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_PLATFORM_C)
+#include "mbedtls/platform.h"
+#else
+#include <stdio.h>
+#include <stdlib.h>
+#define mbedtls_printf          printf
+#define MBEDTLS_EXIT_SUCCESS    EXIT_SUCCESS
+#define MBEDTLS_EXIT_FAILURE    EXIT_FAILURE
+#endif
+
+#if !defined(MBEDTLS_TIMING_C)
+int main( void )
+{
+    mbedtls_printf( "MBEDTLS_TIMING_C not defined.\n" );
+    return( 0 );
+}
+#else
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mbedtls/timing.h"
+
+#include "bench_core.h"
+
+#define USAGE \
+    "\n usage: bench_json [-t budget_ms] [filter]\n" \
+    "\n filter: comma separated substrings of the benchmark names\n\n"
+
+#define BENCH_DEFAULT_BUDGET_MS 1000
+
+/* Milliseconds used to measure the frequency of the hardclock */
+#define BENCH_CALIBRATION_MS    200
+
+/* mbedtls_timing_hardclock() extended to 64 bits where long is 32 bits */
+static uint64_t host_hardclock( void )
+{
+    static unsigned long last;
+    static uint64_t base;
+    unsigned long now = mbedtls_timing_hardclock();
+
+    if( sizeof( unsigned long ) < sizeof( uint64_t ) && now < last )
+        base += (uint64_t) ULONG_MAX + 1;
+    last = now;
+
+    return( base + now );
+}
+
+static uint64_t host_hardclock_hz( void )
+{
+    struct mbedtls_timing_hr_time timer;
+    unsigned long ms;
+    uint64_t start, stop;
+
+    (void) mbedtls_timing_get_timer( &timer, 1 );
+    start = host_hardclock();
+    do
+        ms = mbedtls_timing_get_timer( &timer, 0 );
+    while( ms < BENCH_CALIBRATION_MS );
+    stop = host_hardclock();
+
+    return( ( stop - start ) * 1000 / ms );
+}
+
+static void host_output( const char *s )
+{
+    fputs( s, stdout );
+    fflush( stdout );
+}
+
+int main( int argc, char *argv[] )
+{
+    bench_platform platform;
+    const char *filter = NULL;
+    unsigned long budget_ms = BENCH_DEFAULT_BUDGET_MS;
+    int i;
+
+    for( i = 1; i < argc; i++ )
+    {
+        if( strcmp( argv[i], "-t" ) == 0 && i + 1 < argc )
+            budget_ms = strtoul( argv[++i], NULL, 10 );
+        else if( argv[i][0] == '-' || filter != NULL )
+        {
+            mbedtls_printf( USAGE );
+            return( MBEDTLS_EXIT_FAILURE );
+        }
+        else
+            filter = argv[i];
+    }
+
+    platform.name = "host";
+    platform.hardclock = host_hardclock;
+    platform.hardclock_hz = host_hardclock_hz();
+    platform.output = host_output;
+
+    if( bench_run( &platform, filter, (uint32_t) budget_ms ) != 0 )
+        return( MBEDTLS_EXIT_FAILURE );
+
+    return( MBEDTLS_EXIT_SUCCESS );
+}
+
+#endif /* MBEDTLS_TIMING_C */
@@ -231,15 +231,16 @@ static int myrand( void *rng_state, unsigned char *output, size_t len )
 #if defined(MBEDTLS_ECP_C)
 void ecp_clear_precomputed( mbedtls_ecp_group *grp )
 {
-    if( grp->T != NULL )
+    /* a table with T_size == 0 is static (in flash), and never recomputed */
+    if( grp->T != NULL && grp->T_size != 0 )
     {
         size_t i;
         for( i = 0; i < grp->T_size; i++ )
             mbedtls_ecp_point_free( &grp->T[i] );
         mbedtls_free( grp->T );
+        grp->T = NULL;
+        grp->T_size = 0;
     }
-    grp->T = NULL;
-    grp->T_size = 0;
 }
 #else
 #define ecp_clear_precomputed( g )
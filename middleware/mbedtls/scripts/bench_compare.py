@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+"""
+This file is part of Mbed TLS (https://tls.mbed.org)
+
+Copyright 2026 NXP
+
+Purpose
+
+Compare two JSON reports written by the bench_core.c benchmarks (the host
+program programs/test/bench_json or the mbedtls_benchmark example of a
+board), typically a build using the ALT implementations of a port against
+a build using the software implementations. Benchmarks are matched by
+name; the speedup is the ratio of operations per second, new over base.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    """Read a report, skipping any console output before the JSON document."""
+    with open(path, encoding='utf-8', errors='replace') as f:
+        text = f.read()
+    start = text.find('{')
+    if start < 0:
+        raise ValueError('%s: no JSON document found' % path)
+    report, _ = json.JSONDecoder().raw_decode(text[start:])
+    return report
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('Purpose')[1],
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('base', help='reference report')
+    parser.add_argument('new', help='report to compare with the reference')
+    parser.add_argument('--threshold', type=float, default=0.0,
+                        help='exit with an error if a benchmark is slower than '
+                             'base by more than this fraction (e.g. 0.05)')
+    args = parser.parse_args()
+
+    base = load(args.base)
+    new = load(args.new)
+    base_results = {r['name']: r for r in base['results']}
+
+    print('%-40s %-10s %-10s %14s %14s %8s' %
+          ('benchmark', 'base', 'new', 'base ops/s', 'new ops/s', 'speedup'))
+    regressions = 0
+    for r in new['results']:
+        b = base_results.get(r['name'])
+        if b is None:
+            continue
+        if 'error' in r or 'error' in b:
+            print('%-40s %-10s %-10s %14s %14s %8s' %
+                  (r['name'], b['impl'], r['impl'],
+                   b.get('error', b.get('ops_per_s')),
+                   r.get('error', r.get('ops_per_s')), '-'))
+            continue
+        speedup = r['ops_per_s'] / b['ops_per_s'] if b['ops_per_s'] else 0.0
+        print('%-40s %-10s %-10s %14.2f %14.2f %7.2fx' %
+              (r['name'], b['impl'], r['impl'],
+               b['ops_per_s'], r['ops_per_s'], speedup))
+        if args.threshold and speedup < 1.0 - args.threshold:
+            regressions += 1
+
+    if regressions:
+        sys.stderr.write('%d benchmark(s) slower than the threshold\n' % regressions)
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
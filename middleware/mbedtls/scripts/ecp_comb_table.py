@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+"""
+This file is part of Mbed TLS (https://tls.mbed.org)
+
+Copyright 2026 NXP
+
+Purpose
+
+Generate the static comb table of the base point of an elliptic curve, as
+used by ecp_mul_comb() when MBEDTLS_ECP_FIXED_POINT_OPTIM is enabled.
+The table is printed as C code ready to be pasted into library/ecp_curves.c,
+where it lives in flash instead of being computed in heap on first use.
+
+The table layout must match ecp_precompute_comb(): with window w and
+d = ceil(nbits / w), entry i (0 <= i < 2^(w-1)) is
+    T[i] = G + i_0 2^d G + i_1 2^(2d) G + ... + i_(w-2) 2^((w-1)d) G
+in affine coordinates (Z = 1), and w must match ecp_pick_window_size()
+for P == G.
+"""
+
+import argparse
+import sys
+
+CURVES = {
+    'secp256r1': {
+        'p': 0xFFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF,
+        'a': -3,
+        'gx': 0x6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296,
+        'gy': 0x4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5,
+        'nbits': 256,
+    },
+}
+
+
+def point_add(curve, p1, p2):
+    """Add two affine points, None being the point at infinity."""
+    if p1 is None:
+        return p2
+    if p2 is None:
+        return p1
+    p = curve['p']
+    x1, y1 = p1
+    x2, y2 = p2
+    if x1 == x2:
+        if (y1 + y2) % p == 0:
+            return None
+        lam = (3 * x1 * x1 + curve['a']) * pow(2 * y1, p - 2, p) % p
+    else:
+        lam = (y2 - y1) * pow(x2 - x1, p - 2, p) % p
+    x3 = (lam * lam - x1 - x2) % p
+    y3 = (lam * (x1 - x3) - y1) % p
+    return (x3, y3)
+
+
+def point_mul(curve, k, point):
+    """Double-and-add, good enough for generating constants."""
+    result = None
+    while k:
+        if k & 1:
+            result = point_add(curve, result, point)
+        point = point_add(curve, point, point)
+        k >>= 1
+    return result
+
+
+def comb_table(curve, w):
+    """Compute the comb table like ecp_precompute_comb() does."""
+    d = (curve['nbits'] + w - 1) // w
+    base = (curve['gx'], curve['gy'])
+    powers = [point_mul(curve, 1 << (d * (k + 1)), base) for k in range(w - 1)]
+    table = []
+    for i in range(1 << (w - 1)):
+        point = base
+        for k in range(w - 1):
+            if i & (1 << k):
+                point = point_add(curve, point, powers[k])
+        table.append(point)
+    return table
+
+
+def format_mpi(name, value, nbytes):
+    """Format a number as little-endian BYTES_TO_T_UINT_8 constant array."""
+    data = value.to_bytes(nbytes, 'little')
+    lines = ['static const mbedtls_mpi_uint %s[] = {' % name]
+    for off in range(0, nbytes, 8):
+        lines.append('    BYTES_TO_T_UINT_8( %s ),' %
+                     ', '.join('0x%02X' % b for b in data[off:off + 8]))
+    lines.append('};')
+    return lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('Purpose')[1],
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('curve', nargs='?', default='secp256r1',
+                        choices=sorted(CURVES))
+    parser.add_argument('-w', '--window', type=int, default=None,
+                        help='window size (default: as ecp_pick_window_size())')
+    args = parser.parse_args()
+
+    curve = CURVES[args.curve]
+    w = args.window
+    if w is None:
+        w = (5 if curve['nbits'] >= 384 else 4) + 1
+    nbytes = (curve['nbits'] + 63) // 64 * 8
+
+    table = comb_table(curve, w)
+    out = []
+    for i, (x, y) in enumerate(table):
+        out += format_mpi('%s_T_%d_X' % (args.curve, i), x, nbytes)
+        out += format_mpi('%s_T_%d_Y' % (args.curve, i), y, nbytes)
+    out.append('static const mbedtls_ecp_point %s_T[%d] = {' %
+               (args.curve, len(table)))
+    for i in range(len(table)):
+        out.append('    ECP_POINT_INIT_XY_Z1( %s_T_%d_X, %s_T_%d_Y ),' %
+                   (args.curve, i, args.curve, i))
+    out.append('};')
+    sys.stdout.write('\n'.join(out) + '\n')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+"""
+This file is part of Mbed TLS (https://tls.mbed.org)
+
+Copyright 2026 NXP
+
+Purpose
+
+Generate a bundle of trusted CA certificates for MBEDTLS_X509_CRT_BUNDLE_C
+from PEM or DER files (a PEM file may hold several certificates, e.g. a CA
+store). The bundle is written as binary, or as a C array to be linked into
+flash and passed to mbedtls_x509_crt_bundle_load() or, with the lwIP altcp_tls
+layer, to altcp_tls_create_config_client().
+
+Layout, all integers big endian (see include/mbedtls/x509_crt_bundle.h):
+    "XCB1", count (4 bytes),
+    count index entries sorted by hash:
+        first 8 bytes of the SHA-256 of the subject name, see name_hash(),
+        offset (4 bytes) and length (4 bytes) of the certificate,
+    the DER encoded certificates.
+"""
+
+import argparse
+import base64
+import hashlib
+import re
+import struct
+import sys
+
+MAGIC = b'XCB1'
+HASH_LEN = 8
+ENTRY_SIZE = 16
+
+UTF8_STRING = 0x0C
+PRINTABLE_STRING = 0x13
+
+PEM_RE = re.compile(rb'-----BEGIN CERTIFICATE-----(.*?)-----END CERTIFICATE-----',
+                    re.DOTALL)
+
+
+def der_tlv(data, pos):
+    """Return (tag, start of value, end of TLV) of the DER element at pos."""
+    tag = data[pos]
+    length = data[pos + 1]
+    pos += 2
+    if length & 0x80:
+        count = length & 0x7F
+        if count == 0 or count > 4:
+            raise ValueError('unsupported DER length')
+        length = int.from_bytes(data[pos:pos + count], 'big')
+        pos += count
+    if pos + length > len(data):
+        raise ValueError('truncated DER element')
+    return tag, pos, pos + length
+
+
+def cert_subject(der):
+    """Return the DER encoded subject name of a certificate."""
+    tag, pos, end = der_tlv(der, 0)           # Certificate
+    if tag != 0x30 or end != len(der):
+        raise ValueError('not a DER certificate')
+    tag, pos, _ = der_tlv(der, pos)           # TBSCertificate
+    if tag != 0x30:
+        raise ValueError('bad TBSCertificate')
+    fields = []
+    while len(fields) < 5:
+        tag, _, end = der_tlv(der, pos)
+        if not fields and tag == 0xA0:        # [0] version
+            pos = end
+            continue
+        fields.append((tag, pos, end))
+        pos = end
+    # serial, signature, issuer, validity, subject
+    tag, start, end = fields[4]
+    if tag != 0x30:
+        raise ValueError('bad subject')
+    return der[start:end]
+
+
+def name_hash(name):
+    """Hash a DER encoded name like x509_bundle_name_hash() does.
+
+    Each attribute is hashed as merged flag, value tag, OID and value
+    lengths (2 bytes each), OID and value, with UTF8String and
+    PrintableString values hashed as lower case UTF8String (as
+    mbedTLS compares them)."""
+    sha = hashlib.sha256()
+    _, pos, end = der_tlv(name, 0)
+    while pos < end:
+        tag, set_pos, set_end = der_tlv(name, pos)  # RelativeDistinguishedName
+        if tag != 0x31:
+            raise ValueError('bad RDN')
+        pos = set_end
+        while set_pos < set_end:
+            _, ava_pos, ava_end = der_tlv(name, set_pos)
+            set_pos = ava_end
+            _, oid_pos, oid_end = der_tlv(name, ava_pos)
+            val_tag, val_pos, val_end = der_tlv(name, oid_end)
+            oid = name[oid_pos:oid_end]
+            value = name[val_pos:val_end]
+            if val_tag in (UTF8_STRING, PRINTABLE_STRING):
+                val_tag = UTF8_STRING
+                value = bytes(c + 32 if 0x41 <= c <= 0x5A else c for c in value)
+            merged = 1 if set_pos < set_end else 0
+            sha.update(struct.pack('>BBHH', merged, val_tag, len(oid), len(value)))
+            sha.update(oid + value)
+    return sha.digest()
+
+
+def read_certs(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    pems = PEM_RE.findall(data)
+    if pems:
+        return [base64.b64decode(b''.join(p.split())) for p in pems]
+    return [data]
+
+
+def build_bundle(certs):
+    entries = []
+    seen = set()
+    for der in certs:
+        if der in seen:
+            continue
+        seen.add(der)
+        digest = name_hash(cert_subject(der))[:HASH_LEN]
+        entries.append((digest, der))
+    entries.sort(key=lambda e: e[0])
+
+    offset = len(MAGIC) + 4 + ENTRY_SIZE * len(entries)
+    index = b''
+    data = b''
+    for digest, der in entries:
+        index += digest + struct.pack('>II', offset + len(data), len(der))
+        data += der
+    return MAGIC + struct.pack('>I', len(entries)) + index + data
+
+
+def c_array(bundle, name):
+    lines = ['/* Generated by scripts/x509_crt_bundle.py, do not edit */',
+             '#include <stddef.h>',
+             '',
+             'const unsigned char %s[] = {' % name]
+    for i in range(0, len(bundle), 12):
+        chunk = bundle[i:i + 12]
+        lines.append('    ' + ' '.join('0x%02x,' % b for b in chunk))
+    lines.append('};')
+    lines.append('const size_t %s_len = sizeof(%s);' % (name, name))
+    return '\n'.join(lines) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('Purpose')[1],
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('inputs', nargs='+',
+                        help='PEM or DER certificate files')
+    parser.add_argument('-o', '--output', default='-',
+                        help='output file (default: stdout)')
+    parser.add_argument('-c', '--c-array', metavar='NAME',
+                        help='write a C array with this name instead of binary')
+    args = parser.parse_args()
+
+    certs = []
+    for path in args.inputs:
+        certs += read_certs(path)
+    bundle = build_bundle(certs)
+
+    if args.c_array:
+        out = c_array(bundle, args.c_array).encode('ascii')
+    else:
+        out = bundle
+
+    if args.output == '-':
+        sys.stdout.buffer.write(out)
+    else:
+        with open(args.output, 'wb') as f:
+            f.write(out)
+
+    count = struct.unpack('>I', bundle[len(MAGIC):len(MAGIC) + 4])[0]
+    sys.stderr.write('%d certificates, %d bytes\n' % (count, len(bundle)))
+
+
+if __name__ == '__main__':
+    main()
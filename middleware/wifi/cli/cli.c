@@ -43,7 +43,7 @@
 #define HALT_MSG      "CLI_HALT"
 #define NUM_BUFFERS   1
 #define MAX_COMMANDS  50
-#define IN_QUEUE_SIZE 4
+#define IN_QUEUE_SIZE sizeof(void *)
 
 #define RX_WAIT   OS_WAIT_FOREVER
 #define SEND_WAIT OS_WAIT_FOREVER
@@ -0,0 +1,89 @@
+/** @file os_bench.h
+ *
+ *  @brief  This file provides the OS primitives microbenchmark
+ */
+/*
+ *  Copyright 2026 NXP
+ *
+ *  NXP CONFIDENTIAL
+ *  The source code contained or described herein and all documents related to
+ *  the source code ("Materials") are owned by NXP, its
+ *  suppliers and/or its licensors. Title to the Materials remains with NXP,
+ *  its suppliers and/or its licensors. The Materials contain
+ *  trade secrets and proprietary and confidential information of NXP, its
+ *  suppliers and/or its licensors. The Materials are protected by worldwide copyright
+ *  and trade secret laws and treaty provisions. No part of the Materials may be
+ *  used, copied, reproduced, modified, published, uploaded, posted,
+ *  transmitted, distributed, or disclosed in any way without NXP's prior
+ *  express written permission.
+ *
+ *  No license under any patent, copyright, trade secret or other intellectual
+ *  property right is granted to or conferred upon you by disclosure or delivery
+ *  of the Materials, either expressly, by implication, inducement, estoppel or
+ *  otherwise. Any license under such intellectual property rights must be
+ *  express and approved by NXP in writing.
+ *
+ */
+
+#ifndef _OS_BENCH_H_
+#define _OS_BENCH_H_
+
+/** Result of os_bench_event_flags() */
+struct os_bench_event_flags_result
+{
+    /** Number of wake ups measured */
+    unsigned int count;
+    /** Latency from os_event_flags_set() to the return of os_event_flags_get()
+     *  in the waiting thread, in micro-seconds */
+    unsigned int wake_min_us;
+    unsigned int wake_avg_us;
+    unsigned int wake_max_us;
+    /** Time of an os_event_flags_set() and os_event_flags_get() pair that
+     *  doesn't block, in nano-seconds */
+    unsigned int set_get_ns;
+};
+
+/** Measure the set to wake latency of the event flags.
+ *
+ *  A thread of priority OS_PRIO_0 waits on an event group, and the caller sets
+ *  its flag \a count times. The caller must run below OS_PRIO_0, so that every
+ *  set wakes up and switches to the waiting thread.
+ *
+ *  \param[in] count Number of wake ups to measure
+ *  \param[out] result Result of the measure
+ *
+ *  \return WM_SUCCESS if the measure is done
+ *  \return -WM_FAIL otherwise
+ */
+int os_bench_event_flags(unsigned int count, struct os_bench_event_flags_result *result);
+
+/** Measure the cost of a reader lock and unlock of a reader-writer lock
+ *  without writer, in nano-seconds.
+ *
+ *  \param[in] count Number of reader locks to measure
+ *  \param[out] read_lock_ns Average time of a reader lock and unlock pair
+ *
+ *  \return WM_SUCCESS if the measure is done
+ *  \return -WM_FAIL otherwise
+ */
+int os_bench_rwlock(unsigned int count, unsigned int *read_lock_ns);
+
+/** Register the OS primitives microbenchmark CLI command.
+ *
+ *  Register the \c os-bench command, which runs os_bench_event_flags() and
+ *  os_bench_rwlock().
+ *
+ *  \return WM_SUCCESS if the CLI command is registered
+ *  \return -WM_FAIL otherwise
+ */
+
+int os_bench_cli_init(void);
+
+/** Unregister the OS primitives microbenchmark CLI command.
+ *
+ *  \return WM_SUCCESS if the CLI command is unregistered
+ *  \return -WM_FAIL otherwise
+ */
+
+int os_bench_cli_deinit(void);
+#endif /*_OS_BENCH_H_ */
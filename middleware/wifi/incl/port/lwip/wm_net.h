@@ -399,4 +399,42 @@ void net_ipv6stack_init(struct netif * netif);
  */
 void net_stat(void);
 
+#ifdef CONFIG_WIFI_RX_BATCH
+/** Number of burst size buckets in \ref net_rx_batch_stats, bucket n
+ * counts bursts of 2^n to 2^(n+1) - 1 frames, the last one everything larger.
+ */
+#define NET_RX_BATCH_HIST_BUCKETS 6
+
+/** Wi-Fi receive batching statistics
+ *
+ * With CONFIG_WIFI_RX_BATCH the Wi-Fi driver thread queues received frames
+ * in a ring and the tcpip thread processes them in bursts. With
+ * LWIP_TCPIP_CORE_LOCKING_INPUT the driver thread passes every frame to the
+ * stack itself: the batching is inactive and the statistics stay at zero.
+ */
+struct net_rx_batch_stats
+{
+    /** Frames queued by the driver */
+    uint32_t queued;
+    /** Frames dropped because the ring was full */
+    uint32_t dropped;
+    /** Bursts processed by the tcpip thread */
+    uint32_t bursts;
+    /** Largest burst seen */
+    uint32_t max_burst;
+    /** Burst size histogram */
+    uint32_t hist[NET_RX_BATCH_HIST_BUCKETS];
+};
+
+/** Get Wi-Fi receive batching statistics
+ *
+ * \param[out] stats Statistics snapshot.
+ */
+void net_get_rx_batch_stats(struct net_rx_batch_stats * stats);
+
+/** Reset Wi-Fi receive batching statistics
+ */
+void net_reset_rx_batch_stats(void);
+#endif /* CONFIG_WIFI_RX_BATCH */
+
 #endif /* _WM_NET_H_ */
@@ -0,0 +1,225 @@
+/** @file os_trace.h
+ *
+ *  @brief  This file provides the FreeRTOS scheduling trace recorder
+ */
+/*
+ *  Copyright 2026 NXP
+ *
+ *  NXP CONFIDENTIAL
+ *  The source code contained or described herein and all documents related to
+ *  the source code ("Materials") are owned by NXP, its
+ *  suppliers and/or its licensors. Title to the Materials remains with NXP,
+ *  its suppliers and/or its licensors. The Materials contain
+ *  trade secrets and proprietary and confidential information of NXP, its
+ *  suppliers and/or its licensors. The Materials are protected by worldwide copyright
+ *  and trade secret laws and treaty provisions. No part of the Materials may be
+ *  used, copied, reproduced, modified, published, uploaded, posted,
+ *  transmitted, distributed, or disclosed in any way without NXP's prior
+ *  express written permission.
+ *
+ *  No license under any patent, copyright, trade secret or other intellectual
+ *  property right is granted to or conferred upon you by disclosure or delivery
+ *  of the Materials, either expressly, by implication, inducement, estoppel or
+ *  otherwise. Any license under such intellectual property rights must be
+ *  express and approved by NXP in writing.
+ *
+ */
+
+/* The recorder writes a record in a RAM ring at every context switch, every
+ * time a task is made ready, and every time a task blocks, with the reason it
+ * blocks. The ring keeps the last CONFIG_OS_TRACE_RECORDS records: stop the
+ * recorder after the event of interest, and dump the ring with the os-trace
+ * CLI command. middleware/wifi/scripts/os_trace_convert.py converts the dump
+ * to the Chrome trace format, which Perfetto (ui.perfetto.dev) and
+ * chrome://tracing display.
+ *
+ * It also records the allocations and the frees of the FreeRTOS heap, started
+ * with "os-trace start heap": os_trace_convert.py --heap converts them to a
+ * trace that boards/linux_host/heap_replay replays against the heap schemes.
+ *
+ * It is enabled by CONFIG_OS_TRACE in wifi_config.h. The board
+ * FreeRTOSConfig.h includes this file, for the kernel to call the recorder
+ * from its trace macros, and must provide a run time counter
+ * (configGENERATE_RUN_TIME_STATS): it timestamps the records. Its frequency is
+ * BOARD_RUN_TIME_COUNTER_HZ.
+ *
+ * This file is included by FreeRTOSConfig.h, before the FreeRTOS types are
+ * defined: it only uses the standard types. */
+
+#ifndef _OS_TRACE_H_
+#define _OS_TRACE_H_
+
+#include <stdint.h>
+
+#ifdef CONFIG_OS_TRACE
+
+/** Number of records of the ring, a power of 2 */
+#ifndef CONFIG_OS_TRACE_RECORDS
+#define CONFIG_OS_TRACE_RECORDS 2048U
+#endif
+
+/** Version of the record format, in the header of the dump */
+#define OS_TRACE_VERSION 2
+
+/* Classes of records, for os_trace_start() */
+/** The scheduling records: the tasks, the context switches and the blocking */
+#define OS_TRACE_SCHED (1U << 0)
+/** The allocations and the frees of the heap */
+#define OS_TRACE_HEAP (1U << 1)
+
+/* Records. "id" is the number of the task (uxTCBNumber, xTaskNumber in
+ * TaskStatus_t) or of the object. The blocking records are about the task
+ * switched in by the last OS_TRACE_TASK_SWITCH. */
+/** Task \a id is created, its name follows in OS_TRACE_TASK_NAME records */
+#define OS_TRACE_TASK_CREATE 1U
+/** 4 characters of the name of task \a id, in place of the timestamp, from
+ *  character \a info */
+#define OS_TRACE_TASK_NAME 2U
+/** Task \a id is deleted */
+#define OS_TRACE_TASK_DELETE 3U
+/** Task \a id is switched in */
+#define OS_TRACE_TASK_SWITCH 4U
+/** Task \a id is made ready to run */
+#define OS_TRACE_TASK_READY 5U
+/** The task delays for \a id ticks, 0xFFFF for 65535 ticks or more */
+#define OS_TRACE_DELAY 6U
+/** The task blocks to send to object \a id of type \a info */
+#define OS_TRACE_BLOCK_SEND 7U
+/** The task blocks to receive from, or take, object \a id of type \a info */
+#define OS_TRACE_BLOCK_RECEIVE 8U
+/** The task blocks to peek object \a id of type \a info */
+#define OS_TRACE_BLOCK_PEEK 9U
+/** The task blocks for a task notification */
+#define OS_TRACE_BLOCK_NOTIFY 10U
+/** The task blocks on the bits of event group \a id */
+#define OS_TRACE_BLOCK_EVENT_GROUP 11U
+/** Object \a id of type \a info is created */
+#define OS_TRACE_OBJECT_CREATE 12U
+/** The task allocates \a id bytes (0xFFFF for 65535 or more) with the heap
+ *  tag \a info, the address follows in an OS_TRACE_HEAP_ADDRESS record. With
+ *  heap_4.c, the size is that of the block, its header included, and the tag
+ *  is 0. */
+#define OS_TRACE_MALLOC 13U
+/** The task frees a block of \a id bytes, its header included, allocated with
+ *  the heap tag \a info, the address follows in an OS_TRACE_HEAP_ADDRESS
+ *  record */
+#define OS_TRACE_FREE 14U
+/** The address of the block of the previous record, in place of the
+ *  timestamp: its 32 low bits, 0 if the allocation failed */
+#define OS_TRACE_HEAP_ADDRESS 15U
+
+/* Object types: those of the queues (queueQUEUE_TYPE_* in queue.h) and the
+ * event groups */
+#define OS_TRACE_OBJECT_QUEUE           0U
+#define OS_TRACE_OBJECT_MUTEX           1U
+#define OS_TRACE_OBJECT_COUNTING_SEM    2U
+#define OS_TRACE_OBJECT_BINARY_SEM      3U
+#define OS_TRACE_OBJECT_RECURSIVE_MUTEX 4U
+#define OS_TRACE_OBJECT_EVENT_GROUP     8U
+
+/** A trace record, 8 bytes, in the byte order of the target */
+struct os_trace_record
+{
+    /** Run time counter when the record is written */
+    uint32_t timestamp;
+    /** OS_TRACE_* record type */
+    uint8_t type;
+    /** Type of the object, offset of the name characters, or heap tag */
+    uint8_t info;
+    /** Number of the task or of the object */
+    uint16_t id;
+};
+
+/** State of the recorder */
+struct os_trace_status
+{
+    /** OS_TRACE_SCHED and OS_TRACE_HEAP, the classes recorded, 0 if the
+     *  recorder is stopped */
+    uint32_t running;
+    /** Records written since the last os_trace_clear(), the ring keeps the
+     *  last CONFIG_OS_TRACE_RECORDS of them */
+    uint32_t written;
+    /** Records in the ring, that os_trace_read() reads */
+    uint32_t count;
+};
+
+/** Start recording, after the records already in the ring
+ *
+ *  \param[in] classes OS_TRACE_SCHED and OS_TRACE_HEAP, the classes of records
+ */
+void os_trace_start(uint32_t classes);
+
+/** Stop recording */
+void os_trace_stop(void);
+
+/** Empty the ring */
+void os_trace_clear(void);
+
+/** Get the state of the recorder
+ *
+ *  \param[out] status State of the recorder
+ */
+void os_trace_get_status(struct os_trace_status *status);
+
+/** Read a record of the ring. Stop the recorder first, or the record may be
+ *  overwritten while it is read.
+ *
+ *  \param[in] index Index of the record, from 0, the oldest in the ring, to
+ *             os_trace_status.count - 1
+ *  \param[out] record The record
+ *
+ *  \return 0 if the record is read
+ *  \return -1 if there is no such record
+ */
+int os_trace_read(uint32_t index, struct os_trace_record *record);
+
+/* Called by the kernel trace macros below, with the scheduler suspended or
+ * the interrupts masked */
+void os_trace_task_create(uint32_t task, const char *name);
+void os_trace_task_switch(uint32_t task);
+void os_trace_delay(uint32_t ticks);
+void os_trace_event(uint8_t type, uint8_t info, uint32_t id);
+uint32_t os_trace_object_create(uint8_t type);
+void os_trace_heap(uint8_t type, uint8_t tag, uint32_t size, const void *address);
+
+/* FreeRTOS trace macros, expanded in tasks.c, queue.c and event_groups.c */
+#define traceTASK_CREATE(pxNewTCB)            os_trace_task_create((pxNewTCB)->uxTCBNumber, (pxNewTCB)->pcTaskName)
+#define traceTASK_DELETE(pxTCB)               os_trace_event(OS_TRACE_TASK_DELETE, 0U, (pxTCB)->uxTCBNumber)
+#define traceTASK_SWITCHED_IN()               os_trace_task_switch(pxCurrentTCB->uxTCBNumber)
+#define traceMOVED_TASK_TO_READY_STATE(pxTCB) os_trace_event(OS_TRACE_TASK_READY, 0U, (pxTCB)->uxTCBNumber)
+/* vTaskDelay() has no argument for its trace macro: use its own */
+#define traceTASK_DELAY()                  os_trace_delay(xTicksToDelay)
+#define traceTASK_DELAY_UNTIL(xTimeToWake) os_trace_delay((xTimeToWake)-xTickCount)
+#define traceTASK_NOTIFY_TAKE_BLOCK()      os_trace_event(OS_TRACE_BLOCK_NOTIFY, 0U, 0U)
+#define traceTASK_NOTIFY_WAIT_BLOCK()      os_trace_event(OS_TRACE_BLOCK_NOTIFY, 0U, 0U)
+
+#define traceQUEUE_CREATE(pxNewQueue) \
+    ((pxNewQueue)->uxQueueNumber = os_trace_object_create((pxNewQueue)->ucQueueType))
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue) \
+    os_trace_event(OS_TRACE_BLOCK_SEND, (pxQueue)->ucQueueType, (pxQueue)->uxQueueNumber)
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) \
+    os_trace_event(OS_TRACE_BLOCK_RECEIVE, (pxQueue)->ucQueueType, (pxQueue)->uxQueueNumber)
+#define traceBLOCKING_ON_QUEUE_PEEK(pxQueue) \
+    os_trace_event(OS_TRACE_BLOCK_PEEK, (pxQueue)->ucQueueType, (pxQueue)->uxQueueNumber)
+
+#define traceEVENT_GROUP_CREATE(pxEventBits) \
+    ((pxEventBits)->uxEventGroupNumber = os_trace_object_create(OS_TRACE_OBJECT_EVENT_GROUP))
+#define traceEVENT_GROUP_SYNC_BLOCK(xEventGroup, uxBitsToSet, uxBitsToWaitFor) \
+    os_trace_event(OS_TRACE_BLOCK_EVENT_GROUP, OS_TRACE_OBJECT_EVENT_GROUP,    \
+                   uxEventGroupGetNumber(xEventGroup))
+#define traceEVENT_GROUP_WAIT_BITS_BLOCK(xEventGroup, uxBitsToWaitFor)         \
+    os_trace_event(OS_TRACE_BLOCK_EVENT_GROUP, OS_TRACE_OBJECT_EVENT_GROUP,    \
+                   uxEventGroupGetNumber(xEventGroup))
+
+/* heap_4.c traces the size of the block, heap_6.c the size asked for and the
+ * tag */
+#define traceMALLOC(pvAddress, uiSize) os_trace_heap(OS_TRACE_MALLOC, 0U, (uint32_t)(uiSize), (pvAddress))
+#define traceFREE(pvAddress, uiSize)   os_trace_heap(OS_TRACE_FREE, 0U, (uint32_t)(uiSize), (pvAddress))
+#define traceHEAP_MALLOC(pvAddress, xSize, uxTag) \
+    os_trace_heap(OS_TRACE_MALLOC, (uint8_t)(uxTag), (uint32_t)(xSize), (pvAddress))
+#define traceHEAP_FREE(pvAddress, xBlockSize, uxTag) \
+    os_trace_heap(OS_TRACE_FREE, (uint8_t)(uxTag), (uint32_t)(xBlockSize), (pvAddress))
+
+#endif /* CONFIG_OS_TRACE */
+
+#endif /* _OS_TRACE_H_ */
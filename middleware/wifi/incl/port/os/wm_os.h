@@ -65,6 +65,7 @@
 #include "queue.h"
 #include "semphr.h"
 #include "timers.h"
+#include "event_groups.h"
 #include "portmacro.h"
 
 #if defined(CPU_MIMXRT1062DVL6A)
@@ -80,7 +81,12 @@
 #define os_dprintf(...)
 #endif
 
+#ifdef __CORTEX_M
 #define is_isr_context() (SCB->ICSR & SCB_ICSR_VECTACTIVE_Msk) //(xPortIsInsideInterrupt())
+#else
+/* Host (FreeRTOS POSIX port): the simulated interrupts run in signal handlers */
+#define is_isr_context() (xPortIsInsideInterrupt())
+#endif
 
 /* System clock frequency. */
 extern uint32_t SystemCoreClock;
@@ -1100,12 +1106,46 @@ static inline int os_semaphore_delete(os_semaphore_t *mhandle)
  * The locking operation is timeout based.
  * Caller can give a timeout from 0 (no wait) to
  * infinite (wait forever)
+ *
+ * The readers hold rw_lock as a group, and keep holding it once the last of
+ * them is gone, until a writer asks for it. So as long as no writer comes, a
+ * reader lock and unlock only update the lock state atomically, without any
+ * kernel call: the reader mutex and the callback are only used to get rw_lock
+ * back from a writer.
  */
 
 typedef struct _rw_lock os_rw_lock_t;
 /** This is prototype of reader callback */
 typedef int (*cb_fn)(os_rw_lock_t *plock, unsigned int wait_time);
 
+/** Reader count in the state of a reader-writer lock */
+#define OS_RWLOCK_READERS_MASK 0x0000FFFFU
+/** Count of the writers waiting for the lock, which keep the readers off the
+ *  fast path */
+#define OS_RWLOCK_WRITER_ONE   0x00010000U
+#define OS_RWLOCK_WRITERS_MASK 0x00FF0000U
+/** The readers hold rw_lock */
+#define OS_RWLOCK_HELD 0x80000000U
+
+#ifdef CONFIG_OS_RWLOCK_STATS
+/** Contention statistics of a reader-writer lock */
+typedef struct os_rwlock_stats
+{
+    /** Reader locks taken without any kernel call */
+    uint32_t read_fast;
+    /** Reader locks that had to get rw_lock back from a writer */
+    uint32_t read_slow;
+    /** Reader locks that timed out */
+    uint32_t read_fail;
+    /** Writer locks taken */
+    uint32_t write;
+    /** Writer locks that had to wait for readers to leave */
+    uint32_t write_wait;
+    /** Writer locks that timed out */
+    uint32_t write_fail;
+} os_rwlock_stats_t;
+#endif
+
 struct _rw_lock
 {
     /** Mutex for reader mutual exclusion */
@@ -1118,10 +1158,13 @@ struct _rw_lock
      *  the lock
      */
     cb_fn reader_cb;
-    /** Counter to maintain number of readers
-     *  in critical section
+    /** Reader count, waiting writers and OS_RWLOCK_HELD, only updated
+     *  atomically
      */
-    unsigned int reader_count;
+    volatile uint32_t state;
+#ifdef CONFIG_OS_RWLOCK_STATS
+    os_rwlock_stats_t stats;
+#endif
 };
 
 int os_rwlock_create_with_cb(os_rw_lock_t *lock, const char *mutex_name, const char *lock_name, cb_fn r_fn);
@@ -1205,6 +1248,16 @@ int os_rwlock_read_lock(os_rw_lock_t *lock, unsigned int wait_time);
  */
 int os_rwlock_read_unlock(os_rw_lock_t *lock);
 
+#ifdef CONFIG_OS_RWLOCK_STATS
+/** Get the contention statistics of a reader-writer lock
+ *
+ * @param[in] lock pointer to the reader-writer lock handle
+ * @param[out] stats the statistics since the lock was created or reset
+ * @param[in] reset true to reset the statistics
+ */
+void os_rwlock_get_stats(os_rw_lock_t *lock, os_rwlock_stats_t *stats, bool reset);
+#endif
+
 /*** Timer Management ***/
 
 typedef xTimerHandle os_timer_t;
@@ -1463,6 +1516,15 @@ static inline int os_timer_delete(os_timer_t *timer_t)
 }
 
 /* OS Memory allocation API's */
+
+/* With heap_6.c, the allocations of the wifi middleware are accounted under
+ * their own tag, configHEAP_TAG_WIFI in FreeRTOSConfig.h */
+#ifdef configHEAP_TAG_WIFI
+#define os_mem_port_alloc(size) pvPortMallocTagged(size, configHEAP_TAG_WIFI)
+#else
+#define os_mem_port_alloc(size) pvPortMalloc(size)
+#endif
+
 #ifndef CONFIG_HEAP_DEBUG
 
 /** Allocate memory
@@ -1474,7 +1536,7 @@ static inline int os_timer_delete(os_timer_t *timer_t)
  * @return Pointer to the allocated memory
  * @return NULL if allocation fails
  */
-#define os_mem_alloc(size) pvPortMalloc(size)
+#define os_mem_alloc(size) os_mem_port_alloc(size)
 
 /** Allocate memory and zero it
  *
@@ -1488,7 +1550,7 @@ static inline int os_timer_delete(os_timer_t *timer_t)
  */
 static inline void *os_mem_calloc(size_t size)
 {
-    void *ptr = pvPortMalloc(size);
+    void *ptr = os_mem_port_alloc(size);
     if (ptr)
         memset(ptr, 0x00, size);
 
@@ -1527,7 +1589,7 @@ static inline void *os_mem_realloc(void *ptr, size_t size) WARN_UNUSED_RET;
  */
 static inline void *os_mem_alloc(size_t size)
 {
-    void *ptr = pvPortMalloc(size);
+    void *ptr = os_mem_port_alloc(size);
     if (ptr)
         PRINTF("MDC:A:%x:%d\r\n", ptr, size);
     return ptr;
@@ -1541,7 +1603,7 @@ static inline void *os_mem_alloc(size_t size)
  */
 static inline void *os_mem_calloc(size_t size)
 {
-    void *ptr = pvPortMalloc(size);
+    void *ptr = os_mem_port_alloc(size);
     if (ptr)
     {
         PRINTF("MDC:A:%x:%d\r\n", ptr, size);
@@ -1598,6 +1660,36 @@ static inline void os_dump_mem_stats(void)
     PRINTF("Min Free since system boot ----- : %d\n\r", HS.xMinimumEverFreeBytesRemaining);
     //#endif /* FREERTOS_ENABLE_MALLOC_STATS */
     os_exit_critical_section(sta);
+
+#if configFRTOS_MEMORY_SCHEME == 6
+    {
+        HeapBinStats_t bins;
+        HeapTagStats_t tag;
+        UBaseType_t i;
+#ifdef configHEAP_TAG_NAMES
+        static const char *const names[] = configHEAP_TAG_NAMES;
+#endif
+
+        vPortGetHeapBinStats(&bins);
+        PRINTF("Free bytes in the bins --------- : %u in %u blocks\n\r", (unsigned int)bins.xBinnedBytes,
+               (unsigned int)bins.xNumberOfBinnedBlocks);
+        PRINTF("Bin hits / misses / flushes ---- : %u / %u / %u\n\r", (unsigned int)bins.xNumberOfBinHits,
+               (unsigned int)bins.xNumberOfBinMisses, (unsigned int)bins.xNumberOfBinFlushes);
+        PRINTF("%-10s %10s %10s %10s %10s %8s\n\r", "tag", "bytes", "peak", "allocs", "frees", "failed");
+        for (i = 0; i < configHEAP_TAG_COUNT; i++)
+        {
+            vPortGetHeapTagStats(i, &tag);
+#ifdef configHEAP_TAG_NAMES
+            PRINTF("%-10s", i < sizeof(names) / sizeof(names[0]) ? names[i] : "");
+#else
+            PRINTF("%-10u", (unsigned int)i);
+#endif
+            PRINTF(" %10u %10u %10u %10u %8u\n\r", (unsigned int)tag.xCurrentBytes, (unsigned int)tag.xPeakBytes,
+                   (unsigned int)tag.xNumberOfAllocations, (unsigned int)tag.xNumberOfFrees,
+                   (unsigned int)tag.xNumberOfFailedAllocations);
+        }
+    }
+#endif
 }
 
 #if 0
@@ -1671,7 +1763,12 @@ static inline void os_update_tick_count(unsigned long ticks)
 }
 #endif
 
-typedef unsigned int event_group_handle_t;
+/*** Event flags ***/
+
+/* ThreadX style event flags, on a FreeRTOS event group. Only EF_FLAGS_MASK,
+ * the low 24 bits (8 bits with configUSE_16_BIT_TICKS), can be used as flags:
+ * the others are reserved by the kernel. */
+typedef EventGroupHandle_t event_group_handle_t;
 
 typedef enum flag_rtrv_option_t_
 {
@@ -1685,13 +1782,41 @@ typedef enum flag_rtrv_option_t_
 #define EF_WAIT_FOREVER 0xFFFFFFFFUL
 #define EF_NO_EVENTS    0x7
 
+#if (configUSE_16_BIT_TICKS == 1)
+#define EF_FLAGS_MASK 0x00FFU
+#else
+#define EF_FLAGS_MASK 0x00FFFFFFUL
+#endif
+
 int os_event_flags_create(event_group_handle_t *hnd);
+/**
+ * Wait for event flags
+ *
+ * With EF_AND / EF_AND_CLEAR, wait until all requested_flags are set and get
+ * all the flags of the group in actual_flags_ptr. With EF_OR / EF_OR_CLEAR,
+ * wait until one of them is set and get those of requested_flags that are
+ * set. The _CLEAR options clear requested_flags when the wait is satisfied.
+ *
+ * @param [in] wait_option : EF_NO_WAIT, EF_WAIT_FOREVER or a time in msec
+ *
+ * @return WM_SUCCESS when the wait is satisfied
+ * @return EF_NO_EVENTS on timeout
+ * @return -WM_FAIL on invalid parameters
+ */
 int os_event_flags_get(event_group_handle_t hnd,
                        unsigned requested_flags,
                        flag_rtrv_option_t option,
                        unsigned *actual_flags_ptr,
                        unsigned wait_option);
+/**
+ * Set (EF_OR) event flags, or clear (EF_AND) those not in flags_to_set
+ *
+ * This can be called from an interrupt handler: the update is then deferred
+ * to the timer daemon task, as the event group functions of FreeRTOS can't
+ * walk the waiting tasks in an interrupt.
+ */
 int os_event_flags_set(event_group_handle_t hnd, unsigned flags_to_set, flag_rtrv_option_t option);
+int os_event_flags_delete(event_group_handle_t *hnd);
 
 /**** OS init call **********/
 WEAK int os_init();
@@ -0,0 +1,50 @@
+/** @file tls_prof.h
+ *
+ *  @brief  This file provides the CLI for the TLS handshake profiler
+ */
+/*
+ *  Copyright 2026 NXP
+ *
+ *  NXP CONFIDENTIAL
+ *  The source code contained or described herein and all documents related to
+ *  the source code ("Materials") are owned by NXP, its
+ *  suppliers and/or its licensors. Title to the Materials remains with NXP,
+ *  its suppliers and/or its licensors. The Materials contain
+ *  trade secrets and proprietary and confidential information of NXP, its
+ *  suppliers and/or its licensors. The Materials are protected by worldwide copyright
+ *  and trade secret laws and treaty provisions. No part of the Materials may be
+ *  used, copied, reproduced, modified, published, uploaded, posted,
+ *  transmitted, distributed, or disclosed in any way without NXP's prior
+ *  express written permission.
+ *
+ *  No license under any patent, copyright, trade secret or other intellectual
+ *  property right is granted to or conferred upon you by disclosure or delivery
+ *  of the Materials, either expressly, by implication, inducement, estoppel or
+ *  otherwise. Any license under such intellectual property rights must be
+ *  express and approved by NXP in writing.
+ *
+ */
+
+#ifndef _TLS_PROF_H_
+#define _TLS_PROF_H_
+
+/** Register the TLS handshake profiler CLI command.
+ *
+ *  Register the \c tls-prof command, which prints where the time of the last
+ *  TLS handshake went. Nothing is registered unless lwIP is built with
+ *  LWIP_ALTCP_TLS_MBEDTLS and ALTCP_MBEDTLS_HANDSHAKE_PROFILE.
+ *
+ *  \return WM_SUCCESS if the CLI command is registered
+ *  \return -WM_FAIL otherwise
+ */
+
+int tls_prof_cli_init(void);
+
+/** Unregister the TLS handshake profiler CLI command.
+ *
+ *  \return WM_SUCCESS if the CLI command is unregistered
+ *  \return -WM_FAIL otherwise
+ */
+
+int tls_prof_cli_deinit(void);
+#endif /*_TLS_PROF_H_ */
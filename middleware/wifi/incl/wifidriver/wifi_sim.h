@@ -0,0 +1,136 @@
+/** @file wifi_sim.h
+ *
+ *  @brief  This file provides the simulated wifi card and firmware of the host build
+ */
+/*
+ *  Copyright 2026 NXP
+ *
+ *  NXP CONFIDENTIAL
+ *  The source code contained or described herein and all documents related to
+ *  the source code ("Materials") are owned by NXP, its
+ *  suppliers and/or its licensors. Title to the Materials remains with NXP,
+ *  its suppliers and/or its licensors. The Materials contain
+ *  trade secrets and proprietary and confidential information of NXP, its
+ *  suppliers and/or its licensors. The Materials are protected by worldwide copyright
+ *  and trade secret laws and treaty provisions. No part of the Materials may be
+ *  used, copied, reproduced, modified, published, uploaded, posted,
+ *  transmitted, distributed, or disclosed in any way without NXP's prior
+ *  express written permission.
+ *
+ *  No license under any patent, copyright, trade secret or other intellectual
+ *  property right is granted to or conferred upon you by disclosure or delivery
+ *  of the Materials, either expressly, by implication, inducement, estoppel or
+ *  otherwise. Any license under such intellectual property rights must be
+ *  express and approved by NXP in writing.
+ *
+ */
+
+#ifndef _WIFI_SIM_H_
+#define _WIFI_SIM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** \defgroup wifi_sim Simulated wifi card
+ *
+ * On the host (Linux) build, wifidriver/sim stands in for the SDIO bus driver
+ * (mlan_sdio.c): it models the registers and ports of an SD8801 card, and a
+ * firmware that answers the commands of the driver. The rest of the driver
+ * (wifi-sdio.c, mlan), the connection manager and the network stack run
+ * unchanged.
+ *
+ * The simulated firmware sees the networks added with wifi_sim_add_network().
+ * Once associated, the frames sent by the station go either to a TAP
+ * interface of the host (wifi_sim_set_tap()), or else to a gateway built in
+ * the simulation, which answers ARP, ICMP echo and DHCP on
+ * WIFI_SIM_GATEWAY_IP.
+ *
+ * The configuration must be done before wlan_init(), which is given
+ * wifi_sim_fw_image as firmware.
+ * @{
+ */
+
+/** Address of the built-in gateway, and of its DHCP server */
+#define WIFI_SIM_GATEWAY_IP "192.168.10.1"
+
+/** Security of a simulated network */
+enum wifi_sim_security
+{
+    /** Open */
+    WIFI_SIM_SECURITY_NONE = 0,
+    /** WPA2 personal, with the passphrase checked by the firmware */
+    WIFI_SIM_SECURITY_WPA2,
+};
+
+/** Maximum number of simulated networks */
+#define WIFI_SIM_MAX_NETWORKS 8
+
+/** Firmware image to pass to wlan_init() */
+extern const uint8_t *const wifi_sim_fw_image;
+/** Size of wifi_sim_fw_image */
+extern const size_t wifi_sim_fw_image_len;
+
+/** Add a network to the simulated air.
+ *
+ * \param[in] ssid Network name.
+ * \param[in] bssid MAC address of the access point.
+ * \param[in] channel 2.4 GHz channel, 1 to 14.
+ * \param[in] rssi Signal strength, in dBm (negative).
+ * \param[in] security Security of the network.
+ * \param[in] passphrase WPA2 passphrase, NULL for an open network.
+ *
+ * \return WM_SUCCESS on success, -WM_E_INVAL on an invalid parameter,
+ * -WM_E_NOMEM if there are already \ref WIFI_SIM_MAX_NETWORKS networks.
+ */
+int wifi_sim_add_network(
+    const char *ssid, const uint8_t *bssid, uint8_t channel, int rssi, enum wifi_sim_security security, const char *passphrase);
+
+/** Send the frames of the station to a TAP interface of the host.
+ *
+ * The interface must exist and be up (ip tuntap add dev <name> mode tap),
+ * and the process must be allowed to attach to it.
+ *
+ * \param[in] ifname Name of the interface.
+ *
+ * \return WM_SUCCESS on success, -WM_FAIL if the interface can't be attached.
+ */
+int wifi_sim_set_tap(const char *ifname);
+
+/** Make the access point drop the station, as on a beacon loss.
+ *
+ * \return WM_SUCCESS on success, -WM_FAIL if the station is not associated.
+ */
+int wifi_sim_link_loss(void);
+
+/** Result of wifi_sim_rx_check() */
+struct wifi_sim_rx_check
+{
+    /** Echo requests sent to the station */
+    unsigned int sent;
+    /** Replies of the station */
+    unsigned int echoed;
+    /** Replies out of order, or with another payload than their request */
+    unsigned int mismatched;
+    /** FNV-1a hash of the replies, in the order they were received: the
+     *  same for two builds that deliver the same frames */
+    uint32_t digest;
+};
+
+/** Check the receive path: the built-in gateway sends count ICMP echo
+ * requests of various sizes to the station, as fast as the card takes them,
+ * and checks the replies of the network stack.
+ *
+ * The station must be associated and have the address leased by the
+ * gateway. Blocks until all the replies are in, or none has come for 200 ms.
+ *
+ * \param[in] count Number of echo requests, up to 65536.
+ * \param[out] result Replies received.
+ *
+ * \return WM_SUCCESS on success, -WM_FAIL if the station is not associated
+ * or the frames go to a TAP interface.
+ */
+int wifi_sim_rx_check(unsigned int count, struct wifi_sim_rx_check *result);
+
+/** @} */
+
+#endif /* _WIFI_SIM_H_ */
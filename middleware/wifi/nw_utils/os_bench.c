@@ -0,0 +1,222 @@
+/** @file os_bench.c
+ *
+ *  @brief  This file provides the OS primitives microbenchmark
+ *
+ *  Copyright 2026 NXP
+ *
+ *  NXP CONFIDENTIAL
+ *  The source code contained or described herein and all documents related to
+ *  the source code ("Materials") are owned by NXP, its
+ *  suppliers and/or its licensors. Title to the Materials remains with NXP,
+ *  its suppliers and/or its licensors. The Materials contain
+ *  trade secrets and proprietary and confidential information of NXP, its
+ *  suppliers and/or its licensors. The Materials are protected by worldwide copyright
+ *  and trade secret laws and treaty provisions. No part of the Materials may be
+ *  used, copied, reproduced, modified, published, uploaded, posted,
+ *  transmitted, distributed, or disclosed in any way without NXP's prior
+ *  express written permission.
+ *
+ *  No license under any patent, copyright, trade secret or other intellectual
+ *  property right is granted to or conferred upon you by disclosure or delivery
+ *  of the Materials, either expressly, by implication, inducement, estoppel or
+ *  otherwise. Any license under such intellectual property rights must be
+ *  express and approved by NXP in writing.
+ *
+ */
+
+/* os_bench.c: This file measures how fast the wm_os primitives wake a thread
+ * up, or let it through. It only uses the wm_os API, so it measures the same
+ * on any port. */
+
+#include <string.h>
+#include <wm_os.h>
+#include <cli.h>
+#include <cli_utils.h>
+#include <os_bench.h>
+
+#define OS_BENCH_WAKE (1U << 0)
+#define OS_BENCH_DONE (1U << 1)
+#define OS_BENCH_STOP (1U << 2)
+
+/* Most wake ups are measured in a few micro-seconds: give up on the first one
+ * that takes a second, the waiting thread is not running */
+#define OS_BENCH_TIMEOUT_MS 1000
+
+#define OS_BENCH_COUNT_DEFAULT 1000
+#define OS_BENCH_COUNT_MAX     1000000
+
+static os_thread_stack_define(os_bench_stack, 1024);
+static os_thread_t os_bench_thread;
+static event_group_handle_t os_bench_group;
+static volatile unsigned int os_bench_woken_us;
+
+static void os_bench_waiter(os_thread_arg_t arg)
+{
+    unsigned int flags;
+
+    (void)arg;
+
+    while (os_event_flags_get(os_bench_group, OS_BENCH_WAKE | OS_BENCH_STOP, EF_OR_CLEAR, &flags,
+                              EF_WAIT_FOREVER) == WM_SUCCESS)
+    {
+        os_bench_woken_us = os_get_timestamp();
+        if (flags & OS_BENCH_STOP)
+            break;
+        (void)os_event_flags_set(os_bench_group, OS_BENCH_DONE, EF_OR);
+    }
+
+    /* The caller runs at a lower priority: it won't delete the group until
+     * we are done with it */
+    (void)os_event_flags_set(os_bench_group, OS_BENCH_DONE, EF_OR);
+    os_thread_delete(NULL);
+}
+
+int os_bench_event_flags(unsigned int count, struct os_bench_event_flags_result *result)
+{
+    unsigned int i, flags, set_us, wake_us, start_us;
+    unsigned long long total_us = 0;
+    int ret;
+
+    if (result == NULL)
+        return -WM_FAIL;
+    memset(result, 0, sizeof(*result));
+    if (count == 0)
+        return -WM_FAIL;
+    result->wake_min_us = (unsigned int)-1;
+
+    if (os_event_flags_create(&os_bench_group) != WM_SUCCESS)
+        return -WM_FAIL;
+
+    /* Without a waiting thread: the cost of the calls themselves */
+    start_us = os_get_timestamp();
+    for (i = 0; i < count; i++)
+    {
+        (void)os_event_flags_set(os_bench_group, OS_BENCH_WAKE, EF_OR);
+        (void)os_event_flags_get(os_bench_group, OS_BENCH_WAKE, EF_OR_CLEAR, &flags, EF_NO_WAIT);
+    }
+    result->set_get_ns = (unsigned int)(((unsigned long long)(os_get_timestamp() - start_us) * 1000U) / count);
+
+    ret = os_thread_create(&os_bench_thread, "os_bench", os_bench_waiter, NULL, &os_bench_stack, OS_PRIO_0);
+    if (ret != WM_SUCCESS)
+    {
+        (void)os_event_flags_delete(&os_bench_group);
+        return -WM_FAIL;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        set_us = os_get_timestamp();
+        (void)os_event_flags_set(os_bench_group, OS_BENCH_WAKE, EF_OR);
+        ret = os_event_flags_get(os_bench_group, OS_BENCH_DONE, EF_OR_CLEAR, &flags, OS_BENCH_TIMEOUT_MS);
+        if (ret != WM_SUCCESS)
+            break;
+
+        wake_us = os_bench_woken_us - set_us;
+        total_us += wake_us;
+        if (wake_us < result->wake_min_us)
+            result->wake_min_us = wake_us;
+        if (wake_us > result->wake_max_us)
+            result->wake_max_us = wake_us;
+        result->count++;
+    }
+
+    (void)os_event_flags_set(os_bench_group, OS_BENCH_STOP, EF_OR);
+    if (os_event_flags_get(os_bench_group, OS_BENCH_DONE, EF_OR_CLEAR, &flags, OS_BENCH_TIMEOUT_MS) != WM_SUCCESS)
+    {
+        /* Leak the group rather than delete it under the waiting thread */
+        os_dprintf("ERROR:os_bench thread did not stop\r\n");
+        return -WM_FAIL;
+    }
+    (void)os_event_flags_delete(&os_bench_group);
+
+    if (result->count == 0)
+        return -WM_FAIL;
+    result->wake_avg_us = (unsigned int)(total_us / result->count);
+    return result->count == count ? WM_SUCCESS : -WM_FAIL;
+}
+
+int os_bench_rwlock(unsigned int count, unsigned int *read_lock_ns)
+{
+    os_rw_lock_t lock;
+    unsigned int i, start_us;
+
+    if (count == 0 || read_lock_ns == NULL)
+        return -WM_FAIL;
+    if (os_rwlock_create(&lock, "os_bench_mutex", "os_bench_lock") != WM_SUCCESS)
+        return -WM_FAIL;
+
+    start_us = os_get_timestamp();
+    for (i = 0; i < count; i++)
+    {
+        if (os_rwlock_read_lock(&lock, OS_NO_WAIT) != WM_SUCCESS)
+            break;
+        (void)os_rwlock_read_unlock(&lock);
+    }
+    *read_lock_ns = (unsigned int)(((unsigned long long)(os_get_timestamp() - start_us) * 1000U) / count);
+
+    os_rwlock_delete(&lock);
+    return i == count ? WM_SUCCESS : -WM_FAIL;
+}
+
+/* Display the usage of os-bench */
+static void display_os_bench_usage()
+{
+    PRINTF("Usage:\r\n");
+    PRINTF("\tos-bench [count]\r\n");
+    PRINTF("\t      measure the set to wake latency of the event flags, and the reader lock\r\n");
+    PRINTF("\t      of the reader-writer locks, count times (default %u)\r\n", OS_BENCH_COUNT_DEFAULT);
+}
+
+static void cmd_os_bench(int argc, char **argv)
+{
+    struct os_bench_event_flags_result result;
+    unsigned int count = OS_BENCH_COUNT_DEFAULT;
+    unsigned int read_lock_ns;
+
+    if (argc > 2 ||
+        (argc == 2 && (get_uint(argv[1], &count, strlen(argv[1])) || count == 0 || count > OS_BENCH_COUNT_MAX)))
+    {
+        PRINTF("Incorrect usage\r\n");
+        display_os_bench_usage();
+        return;
+    }
+
+    if (os_bench_event_flags(count, &result) != WM_SUCCESS)
+    {
+        PRINTF("Event flags benchmark failed after %u wake ups\r\n", result.count);
+        return;
+    }
+
+    PRINTF("event flags: set+get %u ns, set to wake min %u us, avg %u us, max %u us (%u wake ups)\r\n",
+           result.set_get_ns, result.wake_min_us, result.wake_avg_us, result.wake_max_us, result.count);
+
+    if (os_bench_rwlock(count, &read_lock_ns) != WM_SUCCESS)
+    {
+        PRINTF("Reader-writer lock benchmark failed\r\n");
+        return;
+    }
+
+    PRINTF("rwlock: read lock+unlock %u ns\r\n", read_lock_ns);
+}
+
+static struct cli_command os_bench_cli[] = {
+    {"os-bench", "[count]", cmd_os_bench},
+};
+
+int os_bench_cli_init(void)
+{
+    unsigned int i;
+    for (i = 0; i < sizeof(os_bench_cli) / sizeof(struct cli_command); i++)
+        if (cli_register_command(&os_bench_cli[i]))
+            return -WM_FAIL;
+    return WM_SUCCESS;
+}
+
+int os_bench_cli_deinit(void)
+{
+    unsigned int i;
+    for (i = 0; i < sizeof(os_bench_cli) / sizeof(struct cli_command); i++)
+        if (cli_unregister_command(&os_bench_cli[i]))
+            return -WM_FAIL;
+    return WM_SUCCESS;
+}
@@ -0,0 +1,211 @@
+/** @file os_trace_cli.c
+ *
+ *  @brief  This file provides the CLI of the FreeRTOS scheduling trace
+ *
+ *  Copyright 2026 NXP
+ *
+ *  NXP CONFIDENTIAL
+ *  The source code contained or described herein and all documents related to
+ *  the source code ("Materials") are owned by NXP, its
+ *  suppliers and/or its licensors. Title to the Materials remains with NXP,
+ *  its suppliers and/or its licensors. The Materials contain
+ *  trade secrets and proprietary and confidential information of NXP, its
+ *  suppliers and/or its licensors. The Materials are protected by worldwide copyright
+ *  and trade secret laws and treaty provisions. No part of the Materials may be
+ *  used, copied, reproduced, modified, published, uploaded, posted,
+ *  transmitted, distributed, or disclosed in any way without NXP's prior
+ *  express written permission.
+ *
+ *  No license under any patent, copyright, trade secret or other intellectual
+ *  property right is granted to or conferred upon you by disclosure or delivery
+ *  of the Materials, either expressly, by implication, inducement, estoppel or
+ *  otherwise. Any license under such intellectual property rights must be
+ *  express and approved by NXP in writing.
+ *
+ */
+
+/* os_trace_cli.c: The dump is text, on the debug console: the UART, or the
+ * semihosting of the debugger when the debug console is redirected to it.
+ * Every line starts with "os-trace:", so that
+ * middleware/wifi/scripts/os_trace_convert.py finds the dump in a log of the
+ * console. */
+
+#include <wm_os.h>
+#include <os_trace.h>
+#include <cli.h>
+#include <cli_utils.h>
+#include <os_trace_cli.h>
+
+#ifdef CONFIG_OS_TRACE
+
+#ifndef BOARD_RUN_TIME_COUNTER_HZ
+#error "FreeRTOSConfig.h must define BOARD_RUN_TIME_COUNTER_HZ, the frequency of the run time counter"
+#endif
+
+/* Records per line of the dump, 16 hexadecimal digits each */
+#define OS_TRACE_DUMP_RECORDS 8U
+
+#ifdef configHEAP_TAG_NAMES
+static const char *const os_trace_heap_tags[] = configHEAP_TAG_NAMES;
+#endif
+
+static void os_trace_dump(void)
+{
+    struct os_trace_status status;
+    struct os_trace_record record;
+    TaskStatus_t *tasks;
+    UBaseType_t count, i;
+    uint32_t index;
+
+    os_trace_get_status(&status);
+    PRINTF("os-trace: begin %d %u %u %u\r\n", OS_TRACE_VERSION, BOARD_RUN_TIME_COUNTER_HZ, status.written,
+           status.count);
+
+    /* The tasks created before the recording have no create record: name
+     * those that are still alive */
+    count = uxTaskGetNumberOfTasks();
+    tasks = os_mem_alloc(count * sizeof(TaskStatus_t));
+    if (tasks != NULL)
+    {
+        count = uxTaskGetSystemState(tasks, count, NULL);
+        for (i = 0; i < count; i++)
+            PRINTF("os-trace: task %u %u %s\r\n", (unsigned int)tasks[i].xTaskNumber,
+                   (unsigned int)tasks[i].uxCurrentPriority, tasks[i].pcTaskName);
+        os_mem_free(tasks);
+    }
+
+#ifdef configHEAP_TAG_NAMES
+    for (i = 0; i < sizeof(os_trace_heap_tags) / sizeof(os_trace_heap_tags[0]); i++)
+        PRINTF("os-trace: heap-tag %u %s\r\n", (unsigned int)i, os_trace_heap_tags[i]);
+#endif
+
+    for (index = 0; os_trace_read(index, &record) == 0; index++)
+    {
+        if (index % OS_TRACE_DUMP_RECORDS == 0U)
+            PRINTF("%sos-trace: data ", index ? "\r\n" : "");
+        PRINTF("%08x%02x%02x%04x", (unsigned int)record.timestamp, record.type, record.info, record.id);
+    }
+    PRINTF("%sos-trace: end\r\n", index ? "\r\n" : "");
+}
+
+static void os_trace_cpu(void)
+{
+    TaskStatus_t *tasks;
+    UBaseType_t count, i;
+    uint32_t total;
+
+    count = uxTaskGetNumberOfTasks();
+    tasks = os_mem_alloc(count * sizeof(TaskStatus_t));
+    if (tasks == NULL)
+    {
+        PRINTF("Cannot allocate the list of %u tasks\r\n", (unsigned int)count);
+        return;
+    }
+
+    count = uxTaskGetSystemState(tasks, count, &total);
+    PRINTF("%-*s %4s %12s %6s %10s\r\n", configMAX_TASK_NAME_LEN, "task", "prio", "cpu us", "cpu %", "stack free");
+    for (i = 0; i < count; i++)
+    {
+        PRINTF("%-*s %4u %12u %5u%% %10u\r\n", configMAX_TASK_NAME_LEN, tasks[i].pcTaskName,
+               (unsigned int)tasks[i].uxCurrentPriority,
+               (unsigned int)(((uint64_t)tasks[i].ulRunTimeCounter * 1000000U) / BOARD_RUN_TIME_COUNTER_HZ),
+               total ? (unsigned int)(((uint64_t)tasks[i].ulRunTimeCounter * 100U) / total) : 0U,
+               (unsigned int)(tasks[i].usStackHighWaterMark * sizeof(StackType_t)));
+    }
+    os_mem_free(tasks);
+}
+
+/* Display the usage of os-trace */
+static void display_os_trace_usage()
+{
+    PRINTF("Usage:\r\n");
+    PRINTF("\tos-trace <start [sched|heap|all]|stop|clear|status|dump|cpu|heap>\r\n");
+    PRINTF("\t      start   record the context switches and the blocking of the tasks (sched),\r\n");
+    PRINTF("\t              the allocations and the frees of the heap (heap), or both (all),\r\n");
+    PRINTF("\t              in a ring of %u records. sched by default.\r\n", CONFIG_OS_TRACE_RECORDS);
+    PRINTF("\t      stop    stop recording\r\n");
+    PRINTF("\t      clear   empty the ring\r\n");
+    PRINTF("\t      status  display the state of the recorder\r\n");
+    PRINTF("\t      dump    stop recording and dump the ring, for os_trace_convert.py\r\n");
+    PRINTF("\t      cpu     display the CPU time of the tasks since the start\r\n");
+    PRINTF("\t      heap    display the state of the heap, and its accounting per tag\r\n");
+}
+
+static void cmd_os_trace(int argc, char **argv)
+{
+    struct os_trace_status status;
+
+    uint32_t classes = OS_TRACE_SCHED;
+
+    if (argc == 3 && string_equal("start", argv[1]))
+    {
+        if (string_equal("heap", argv[2]))
+            classes = OS_TRACE_HEAP;
+        else if (string_equal("all", argv[2]))
+            classes = OS_TRACE_SCHED | OS_TRACE_HEAP;
+        else if (!string_equal("sched", argv[2]))
+            classes = 0U;
+    }
+    else if (argc != 2)
+        classes = 0U;
+
+    if (classes == 0U)
+    {
+        PRINTF("Incorrect usage\r\n");
+        display_os_trace_usage();
+        return;
+    }
+
+    if (string_equal("start", argv[1]))
+        os_trace_start(classes);
+    else if (string_equal("stop", argv[1]))
+        os_trace_stop();
+    else if (string_equal("clear", argv[1]))
+        os_trace_clear();
+    else if (string_equal("status", argv[1]))
+    {
+        os_trace_get_status(&status);
+        PRINTF("os-trace: %s%s%s, %u records written, %u in the ring of %u\r\n",
+               status.running ? "running" : "stopped", (status.running & OS_TRACE_SCHED) ? " sched" : "",
+               (status.running & OS_TRACE_HEAP) ? " heap" : "", status.written, status.count,
+               CONFIG_OS_TRACE_RECORDS);
+    }
+    else if (string_equal("dump", argv[1]))
+    {
+        os_trace_stop();
+        os_trace_dump();
+    }
+    else if (string_equal("cpu", argv[1]))
+        os_trace_cpu();
+    else if (string_equal("heap", argv[1]))
+        os_dump_mem_stats();
+    else
+    {
+        PRINTF("Incorrect usage\r\n");
+        display_os_trace_usage();
+    }
+}
+
+static struct cli_command os_trace_cli[] = {
+    {"os-trace", "<start [sched|heap|all]|stop|clear|status|dump|cpu|heap>", cmd_os_trace},
+};
+
+int os_trace_cli_init(void)
+{
+    unsigned int i;
+    for (i = 0; i < sizeof(os_trace_cli) / sizeof(struct cli_command); i++)
+        if (cli_register_command(&os_trace_cli[i]))
+            return -WM_FAIL;
+    return WM_SUCCESS;
+}
+
+int os_trace_cli_deinit(void)
+{
+    unsigned int i;
+    for (i = 0; i < sizeof(os_trace_cli) / sizeof(struct cli_command); i++)
+        if (cli_unregister_command(&os_trace_cli[i]))
+            return -WM_FAIL;
+    return WM_SUCCESS;
+}
+
+#endif /* CONFIG_OS_TRACE */
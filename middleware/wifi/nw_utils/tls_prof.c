@@ -0,0 +1,192 @@
+/** @file tls_prof.c
+ *
+ *  @brief  This file provides the CLI for the TLS handshake profiler
+ *
+ *  Copyright 2026 NXP
+ *
+ *  NXP CONFIDENTIAL
+ *  The source code contained or described herein and all documents related to
+ *  the source code ("Materials") are owned by NXP, its
+ *  suppliers and/or its licensors. Title to the Materials remains with NXP,
+ *  its suppliers and/or its licensors. The Materials contain
+ *  trade secrets and proprietary and confidential information of NXP, its
+ *  suppliers and/or its licensors. The Materials are protected by worldwide copyright
+ *  and trade secret laws and treaty provisions. No part of the Materials may be
+ *  used, copied, reproduced, modified, published, uploaded, posted,
+ *  transmitted, distributed, or disclosed in any way without NXP's prior
+ *  express written permission.
+ *
+ *  No license under any patent, copyright, trade secret or other intellectual
+ *  property right is granted to or conferred upon you by disclosure or delivery
+ *  of the Materials, either expressly, by implication, inducement, estoppel or
+ *  otherwise. Any license under such intellectual property rights must be
+ *  express and approved by NXP in writing.
+ *
+ */
+
+/* tls_prof.c: This file prints where the time of the TLS handshakes went */
+
+#include <string.h>
+#include <wm_os.h>
+#include <wm_net.h>
+#include <cli.h>
+#include <cli_utils.h>
+#include <tls_prof.h>
+
+#include "lwip/altcp_tls.h"
+#include "lwip/tcpip.h"
+
+#if LWIP_ALTCP && LWIP_ALTCP_TLS && LWIP_ALTCP_TLS_MBEDTLS && ALTCP_MBEDTLS_HANDSHAKE_PROFILE
+
+/* Names of the mbedTLS handshake states (mbedtls_ssl_states) */
+static const char *const tls_prof_states[ALTCP_TLS_PROFILE_STATES] = {
+    "hello_request",
+    "client_hello",
+    "server_hello",
+    "server_certificate",
+    "server_key_exchange",
+    "certificate_request",
+    "server_hello_done",
+    "client_certificate",
+    "client_key_exchange",
+    "certificate_verify",
+    "client_change_cipher",
+    "client_finished",
+    "server_change_cipher",
+    "server_finished",
+    "flush_buffers",
+    "handshake_wrapup",
+    "handshake_over",
+    "new_session_ticket",
+    "hello_verify_request",
+};
+
+static const char *const tls_prof_ops[ALTCP_TLS_PROFILE_OPS] = {
+    "ecp_mul",
+    "rsa_public",
+    "rsa_private",
+    "x509_verify",
+};
+
+/* Display one handshake profile */
+static void display_tls_prof(const struct altcp_tls_handshake_profile *prof)
+{
+    int i;
+
+    PRINTF("TLS handshake: %u us total, %u steps\r\n", prof->total_us, prof->steps);
+    PRINTF("%-22s %10s %10s %10s\r\n", "state", "wall us", "busy us", "wait us");
+    for (i = 0; i < ALTCP_TLS_PROFILE_STATES; i++)
+    {
+        if (prof->state_us[i] == 0 && prof->busy_us[i] == 0)
+            continue;
+        PRINTF("%-22s %10u %10u %10u\r\n", tls_prof_states[i], prof->state_us[i], prof->busy_us[i],
+               prof->state_us[i] - prof->busy_us[i]);
+    }
+    PRINTF("%-22s %10s %10s %10s\r\n", "operation", "count", "total us", "max us");
+    for (i = 0; i < ALTCP_TLS_PROFILE_OPS; i++)
+    {
+        if (prof->ops[i].count == 0 && prof->ops[i].total_us == 0)
+            continue;
+        PRINTF("%-22s %10u %10u %10u\r\n", tls_prof_ops[i], prof->ops[i].count, prof->ops[i].total_us,
+               prof->ops[i].max_us);
+    }
+}
+
+/* Called by altcp_tls (in the tcpip thread) for every completed handshake */
+static void tls_prof_handshake_done(void *arg, struct altcp_pcb *conn, const struct altcp_tls_handshake_profile *prof)
+{
+    (void)arg;
+    (void)conn;
+
+    display_tls_prof(prof);
+}
+
+/* Display the usage of tls-prof */
+static void display_tls_prof_usage()
+{
+    PRINTF("Usage:\r\n");
+    PRINTF("\ttls-prof [auto <on|off>]\r\n");
+    PRINTF("\t      without argument, print the profile of the last TLS handshake\r\n");
+    PRINTF("\t      auto on: print the profile of every TLS handshake when it is done\r\n");
+}
+
+static void cmd_tls_prof(int argc, char **argv)
+{
+    struct altcp_tls_handshake_profile prof;
+    err_t err;
+
+    if (argc == 1)
+    {
+        LOCK_TCPIP_CORE();
+        err = altcp_tls_get_last_handshake_profile(&prof);
+        UNLOCK_TCPIP_CORE();
+        if (err != ERR_OK)
+        {
+            PRINTF("No TLS handshake done yet\r\n");
+            return;
+        }
+        display_tls_prof(&prof);
+        return;
+    }
+
+    if (argc == 3 && string_equal(argv[1], "auto"))
+    {
+        if (string_equal(argv[2], "on"))
+        {
+            LOCK_TCPIP_CORE();
+            altcp_tls_set_handshake_profile_callback(tls_prof_handshake_done, NULL);
+            UNLOCK_TCPIP_CORE();
+            return;
+        }
+        if (string_equal(argv[2], "off"))
+        {
+            LOCK_TCPIP_CORE();
+            altcp_tls_set_handshake_profile_callback(NULL, NULL);
+            UNLOCK_TCPIP_CORE();
+            return;
+        }
+    }
+
+    PRINTF("Incorrect usage\r\n");
+    display_tls_prof_usage();
+}
+
+static struct cli_command tls_prof_cli[] = {
+    {"tls-prof", "[auto <on|off>]", cmd_tls_prof},
+};
+
+int tls_prof_cli_init(void)
+{
+    unsigned int i;
+    for (i = 0; i < sizeof(tls_prof_cli) / sizeof(struct cli_command); i++)
+        if (cli_register_command(&tls_prof_cli[i]))
+            return -WM_FAIL;
+    return WM_SUCCESS;
+}
+
+int tls_prof_cli_deinit(void)
+{
+    unsigned int i;
+
+    LOCK_TCPIP_CORE();
+    altcp_tls_set_handshake_profile_callback(NULL, NULL);
+    UNLOCK_TCPIP_CORE();
+    for (i = 0; i < sizeof(tls_prof_cli) / sizeof(struct cli_command); i++)
+        if (cli_unregister_command(&tls_prof_cli[i]))
+            return -WM_FAIL;
+    return WM_SUCCESS;
+}
+
+#else /* ALTCP_MBEDTLS_HANDSHAKE_PROFILE */
+
+int tls_prof_cli_init(void)
+{
+    return WM_SUCCESS;
+}
+
+int tls_prof_cli_deinit(void)
+{
+    return WM_SUCCESS;
+}
+
+#endif /* ALTCP_MBEDTLS_HANDSHAKE_PROFILE */
@@ -533,5 +533,26 @@ void net_configure_dns(struct wlan_ip_config * ip, enum wlan_bss_role role)
 
 void net_stat()
 {
+#ifdef CONFIG_WIFI_RX_BATCH
+    struct net_rx_batch_stats rx_batch;
+    int i;
+#endif
+
     stats_display();
+
+#ifdef CONFIG_WIFI_RX_BATCH
+    net_get_rx_batch_stats(&rx_batch);
+    PRINTF("\r\nWi-Fi RX batching\r\n");
+    PRINTF("\tqueued: %" PRIu32 "\r\n", rx_batch.queued);
+    PRINTF("\tdropped: %" PRIu32 "\r\n", rx_batch.dropped);
+    PRINTF("\tbursts: %" PRIu32 "\r\n", rx_batch.bursts);
+    PRINTF("\tmax burst: %" PRIu32 "\r\n", rx_batch.max_burst);
+    for (i = 0; i < NET_RX_BATCH_HIST_BUCKETS; i++)
+    {
+        if (i == NET_RX_BATCH_HIST_BUCKETS - 1)
+            PRINTF("\t%u+: %" PRIu32 "\r\n", 1U << i, rx_batch.hist[i]);
+        else
+            PRINTF("\t%u-%u: %" PRIu32 "\r\n", 1U << i, (2U << i) - 1U, rx_batch.hist[i]);
+    }
+#endif
 }
@@ -32,6 +32,7 @@
 #include "lwip/opt.h"
 #include "lwip/pbuf.h"
 #include "lwip/sys.h"
+#include "lwip/tcpip.h"
 #include "lwip/udp.h"
 #ifdef CONFIG_IPV6
 #include "lwip/ethip6.h"
@@ -84,6 +85,28 @@ PACK_STRUCT_END
 
 /* The time to block waiting for input. */
 #define emacBLOCK_TIME_WAITING_FOR_INPUT ((portTickType) 100)
+
+#ifdef CONFIG_WIFI_RX_BATCH
+/*
+ * Number of received frames that can be queued for the tcpip thread when
+ * input batching is enabled. Must be a power of two.
+ */
+#ifndef CONFIG_WIFI_RX_BATCH_RING_SIZE
+#define CONFIG_WIFI_RX_BATCH_RING_SIZE 32
+#endif
+
+#if (CONFIG_WIFI_RX_BATCH_RING_SIZE & (CONFIG_WIFI_RX_BATCH_RING_SIZE - 1)) != 0
+#error "CONFIG_WIFI_RX_BATCH_RING_SIZE must be a power of two"
+#endif
+
+/*
+ * Ticks after which the drain of the queued frames is posted again to the
+ * tcpip thread, when its mailbox was full.
+ */
+#ifndef CONFIG_WIFI_RX_BATCH_RETRY_TICKS
+#define CONFIG_WIFI_RX_BATCH_RETRY_TICKS 1
+#endif
+#endif /* CONFIG_WIFI_RX_BATCH */
 /*------------------------------------------------------*/
 extern int wlan_get_mac_address(t_u8 *);
 extern void wlan_wake_up_card();
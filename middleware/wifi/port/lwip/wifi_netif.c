@@ -47,11 +47,181 @@ uint16_t g_data_snr_last;
 static struct netif * netif_arr[MAX_INTERFACES_SUPPORTED];
 static t_u8 rfc1042_eth_hdr[MLAN_MAC_ADDR_LENGTH] = { 0xaa, 0xaa, 0x03, 0x00, 0x00, 0x00 };
 /*------------------------------------------------------*/
+#if defined(CONFIG_WIFI_RX_BATCH) && !LWIP_TCPIP_CORE_LOCKING_INPUT
+static void wifi_rx_batch_init(void);
+#endif
+
 static void register_interface(struct netif * iface, mlan_bss_type iface_type)
 {
     netif_arr[iface_type] = iface;
+#if defined(CONFIG_WIFI_RX_BATCH) && !LWIP_TCPIP_CORE_LOCKING_INPUT
+    wifi_rx_batch_init();
+#endif
+}
+
+#ifdef CONFIG_WIFI_RX_BATCH
+/*
+ * Input batching: instead of posting one tcpip mailbox message per frame
+ * (one context switch per frame), the Wi-Fi driver thread queues frames in
+ * a single-producer/single-consumer ring and schedules one drain callback,
+ * which hands everything queued so far to ethernet_input() on the tcpip
+ * thread. If the tcpip mailbox is full, the callback stays owed (pending)
+ * and a one-shot timer posts it again, so that the queued frames are not
+ * left waiting for the next frame on a quiet link.
+ *
+ * With LWIP_TCPIP_CORE_LOCKING_INPUT the driver thread already calls
+ * ethernet_input() itself under the core lock, without a message: there is
+ * nothing to batch, and the frames bypass the ring (see
+ * deliver_packet_above()).
+ */
+#define WIFI_RX_BATCH_MASK (CONFIG_WIFI_RX_BATCH_RING_SIZE - 1U)
+
+#ifdef portMEMORY_BARRIER
+#define WIFI_RX_BATCH_BARRIER() portMEMORY_BARRIER()
+#else
+#define WIFI_RX_BATCH_BARRIER() __asm volatile("" ::: "memory")
+#endif
+
+struct wifi_rx_batch_slot
+{
+    struct pbuf * p;
+    int interface;
+};
+
+static struct
+{
+    struct wifi_rx_batch_slot ring[CONFIG_WIFI_RX_BATCH_RING_SIZE];
+    /* written by the producer (driver thread) only */
+    volatile u32_t head;
+    /* written by the consumer (drain) only */
+    volatile u32_t tail;
+    /* drain callback posted, or owed to the retry timer, and not yet started */
+    volatile u8_t pending;
+    /* posts the drain callback again when the tcpip mailbox was full */
+    os_timer_t retry_timer;
+    struct net_rx_batch_stats stats;
+} rx_batch;
+
+#if !LWIP_TCPIP_CORE_LOCKING_INPUT
+static void wifi_rx_batch_drain(void * ctx);
+
+static void wifi_rx_batch_post(void)
+{
+    if (tcpip_try_callback(wifi_rx_batch_drain, NULL) == ERR_OK)
+        return;
+
+    /* keep the drain pending, the frames are queued until it runs */
+    if (rx_batch.retry_timer == NULL || os_timer_activate(&rx_batch.retry_timer) != WM_SUCCESS)
+    {
+        /* no retry: the next frame posts it */
+        rx_batch.pending = 0;
+    }
+}
+
+static void wifi_rx_batch_retry(os_timer_arg_t timer)
+{
+    LWIP_UNUSED_ARG(timer);
+    wifi_rx_batch_post();
+}
+
+static void wifi_rx_batch_init(void)
+{
+    if (rx_batch.retry_timer != NULL)
+        return;
+
+    if (os_timer_create(&rx_batch.retry_timer, "wifi-rx-batch", CONFIG_WIFI_RX_BATCH_RETRY_TICKS, wifi_rx_batch_retry,
+                        NULL, OS_TIMER_ONE_SHOT, OS_TIMER_NO_ACTIVATE) != WM_SUCCESS)
+    {
+        rx_batch.retry_timer = NULL;
+        LWIP_DEBUGF(NETIF_DEBUG, ("wifi_rx_batch_init: no retry timer\n"));
+    }
+}
+
+static void wifi_rx_batch_drain(void * ctx)
+{
+    u32_t tail  = rx_batch.tail;
+    u32_t burst = 0;
+    int bucket  = 0;
+
+    LWIP_UNUSED_ARG(ctx);
+
+    /* frames queued from now on need a new callback */
+    rx_batch.pending = 0;
+    WIFI_RX_BATCH_BARRIER();
+
+    /* bound the burst so a busy link cannot starve the lwIP timers */
+    while ((tail != rx_batch.head) && (burst < CONFIG_WIFI_RX_BATCH_RING_SIZE))
+    {
+        struct wifi_rx_batch_slot * slot = &rx_batch.ring[tail & WIFI_RX_BATCH_MASK];
+        struct pbuf * p                  = slot->p;
+        struct netif * netif             = netif_arr[slot->interface];
+
+        WIFI_RX_BATCH_BARRIER();
+        rx_batch.tail = ++tail;
+
+        /* already on the tcpip thread */
+        if (ethernet_input(p, netif) != ERR_OK)
+        {
+            LINK_STATS_INC(link.proterr);
+            pbuf_free(p);
+        }
+        burst++;
+    }
+
+    if (burst == 0)
+        return;
+
+    if ((tail != rx_batch.head) && !rx_batch.pending)
+    {
+        rx_batch.pending = 1;
+        wifi_rx_batch_post();
+    }
+
+    rx_batch.stats.bursts++;
+    if (burst > rx_batch.stats.max_burst)
+        rx_batch.stats.max_burst = burst;
+    while (((burst >> (bucket + 1)) != 0U) && (bucket < NET_RX_BATCH_HIST_BUCKETS - 1))
+        bucket++;
+    rx_batch.stats.hist[bucket]++;
 }
 
+static err_t wifi_rx_batch_enqueue(struct pbuf * p, int recv_interface)
+{
+    u32_t head = rx_batch.head;
+
+    if ((head - rx_batch.tail) >= CONFIG_WIFI_RX_BATCH_RING_SIZE)
+    {
+        rx_batch.stats.dropped++;
+        return ERR_MEM;
+    }
+
+    rx_batch.ring[head & WIFI_RX_BATCH_MASK].p         = p;
+    rx_batch.ring[head & WIFI_RX_BATCH_MASK].interface = recv_interface;
+    WIFI_RX_BATCH_BARRIER();
+    rx_batch.head = head + 1U;
+    rx_batch.stats.queued++;
+
+    if (!rx_batch.pending)
+    {
+        rx_batch.pending = 1;
+        WIFI_RX_BATCH_BARRIER();
+        wifi_rx_batch_post();
+    }
+    return ERR_OK;
+}
+#endif /* !LWIP_TCPIP_CORE_LOCKING_INPUT */
+
+void net_get_rx_batch_stats(struct net_rx_batch_stats * stats)
+{
+    (void) memcpy(stats, &rx_batch.stats, sizeof(*stats));
+}
+
+void net_reset_rx_batch_stats(void)
+{
+    (void) memset(&rx_batch.stats, 0, sizeof(rx_batch.stats));
+}
+#endif /* CONFIG_WIFI_RX_BATCH */
+
 void deliver_packet_above(struct pbuf * p, int recv_interface)
 {
     err_t lwiperr = ERR_OK;
@@ -71,8 +241,13 @@ void deliver_packet_above(struct pbuf * p, int recv_interface)
                 ;
         }
 
+#if defined(CONFIG_WIFI_RX_BATCH) && !LWIP_TCPIP_CORE_LOCKING_INPUT
+        /* queue for the next burst on the tcpip_thread */
+        lwiperr = wifi_rx_batch_enqueue(p, recv_interface);
+#else
         /* full packet send to tcpip_thread to process */
         lwiperr = netif_arr[recv_interface]->input(p, netif_arr[recv_interface]);
+#endif
         if (lwiperr != ERR_OK)
         {
             LINK_STATS_INC(link.proterr);
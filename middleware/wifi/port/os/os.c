@@ -27,7 +27,13 @@
 #include <stdio.h>
 #include <wm_os.h>
 #include <wmlog.h>
+#ifdef __CORTEX_M
 #include <hkdf-sha.h>
+#else
+#include <time.h>
+#include <sys/random.h>
+#define SHA256HashSize 32
+#endif
 
 WEAK int main();
 
@@ -124,57 +130,15 @@ void os_thread_stackmark(char *name)
     /* Nothing to-do */
 }
 
-typedef struct event_wait_t
-{
-    /* parameter passed in the event get call */
-    unsigned thread_mask;
-    /* The 'get' thread will wait on this sem */
-    os_semaphore_t sem;
-    struct event_wait_t *next;
-    struct event_wait_t *prev;
-} event_wait_t;
-
-typedef struct event_group_t
-{
-    /* Main event flags will be stored here */
-    unsigned flags;
-    /* This flag is used to indicate deletion
-     * of event group */
-    bool delete_group;
-    /* to protect this structure and the waiting list */
-    os_mutex_t mutex;
-    event_wait_t *list;
-} event_group_t;
-
-static inline void os_event_flags_remove_node(event_wait_t *node, event_group_t *grp_ptr)
-{
-    if (node->prev)
-        node->prev->next = node->next;
-    if (node->next)
-        node->next->prev = node->prev;
-    /* If only one node is present */
-    if (!node->next && !node->prev)
-        grp_ptr->list = NULL;
-    os_mem_free(node);
-}
-
 int os_event_flags_create(event_group_handle_t *hnd)
 {
-    int ret;
-    event_group_t *eG = os_mem_alloc(sizeof(event_group_t));
+    EventGroupHandle_t eG = xEventGroupCreate();
     if (!eG)
     {
         os_dprintf("ERROR:Mem allocation\r\n");
         return -WM_FAIL;
     }
-    memset(eG, 0x00, sizeof(event_group_t));
-    ret = os_mutex_create(&eG->mutex, "event-flag", OS_MUTEX_INHERIT);
-    if (ret != WM_SUCCESS)
-    {
-        os_mem_free(eG);
-        return -WM_FAIL;
-    }
-    *hnd = (event_group_handle_t)eG;
+    *hnd = eG;
     return WM_SUCCESS;
 }
 
@@ -184,170 +148,76 @@ int os_event_flags_get(event_group_handle_t hnd,
                        unsigned *actual_flags_ptr,
                        unsigned wait_option)
 {
-    bool wait_done = 0;
-    unsigned status;
-    int ret;
-    *actual_flags_ptr = 0;
-    event_wait_t *tmp = NULL, *node = NULL;
-    if (hnd == 0)
+    BaseType_t wait_all, clear;
+    TickType_t ticks;
+    EventBits_t flags;
+
+    if (actual_flags_ptr == NULL)
     {
-        os_dprintf("ERROR:Invalid event flag handle\r\n");
+        os_dprintf("ERROR:Flags pointer is NULL\r\n");
         return -WM_FAIL;
     }
-    if (requested_flags == 0)
+    *actual_flags_ptr = 0;
+    if (hnd == NULL)
     {
-        os_dprintf("ERROR:Requested flag is zero\r\n");
+        os_dprintf("ERROR:Invalid event flag handle\r\n");
         return -WM_FAIL;
     }
-    if (actual_flags_ptr == NULL)
+    if (requested_flags == 0 || (requested_flags & ~EF_FLAGS_MASK))
     {
-        os_dprintf("ERROR:Flags pointer is NULL\r\n");
+        os_dprintf("ERROR:Requested flag is zero or reserved\r\n");
         return -WM_FAIL;
     }
-    event_group_t *eG = (event_group_t *)hnd;
-
-check_again:
-    os_mutex_get(&eG->mutex, OS_WAIT_FOREVER);
 
-    if ((option == EF_AND) || (option == EF_AND_CLEAR))
+    switch (option)
     {
-        if ((eG->flags & requested_flags) == requested_flags)
-            status = eG->flags;
-        else
-            status = 0;
-    }
-    else if ((option == EF_OR) || (option == EF_OR_CLEAR))
-    {
-        status = (requested_flags & eG->flags);
+        case EF_AND:
+        case EF_AND_CLEAR:
+            wait_all = pdTRUE;
+            break;
+        case EF_OR:
+        case EF_OR_CLEAR:
+            wait_all = pdFALSE;
+            break;
+        default:
+            os_dprintf("ERROR:Invalid event flag get option\r\n");
+            return -WM_FAIL;
     }
+    clear = (option == EF_AND_CLEAR || option == EF_OR_CLEAR) ? pdTRUE : pdFALSE;
+
+    if (wait_option == EF_NO_WAIT)
+        ticks = 0;
+    else if (wait_option == EF_WAIT_FOREVER)
+        ticks = portMAX_DELAY;
     else
-    {
-        os_dprintf("ERROR:Invalid event flag get option\r\n");
-        os_mutex_put(&eG->mutex);
-        return -WM_FAIL;
-    }
-    /* Check flags */
-    if (status)
-    {
-        *actual_flags_ptr = status;
+        ticks = os_msec_to_ticks(wait_option);
 
-        /* Clear the requested flags from main flag */
-        if ((option == EF_AND_CLEAR) || (option == EF_OR_CLEAR))
-            eG->flags &= ~status;
+    /* The kernel blocks the task on the event group itself: no waiter to
+     * allocate, and the flags are tested and cleared atomically. The value
+     * returned is the one before the requested flags were cleared. */
+    flags = xEventGroupWaitBits(hnd, requested_flags, clear, wait_all, ticks);
 
-        if (wait_done)
-        {
-            /*Delete the created semaphore */
-            os_semaphore_delete(&tmp->sem);
-            /* Remove ourselves from the list */
-            os_event_flags_remove_node(tmp, eG);
-        }
-        os_mutex_put(&eG->mutex);
-        return WM_SUCCESS;
+    if (wait_all)
+    {
+        if ((flags & requested_flags) != requested_flags)
+            return EF_NO_EVENTS;
+        *actual_flags_ptr = flags & EF_FLAGS_MASK;
     }
     else
     {
-        if (wait_option)
-        {
-            if (wait_done == 0)
-            {
-                /* Add to link list */
-                /* Prepare a node to add in the link list */
-                node = os_mem_alloc(sizeof(event_wait_t));
-                if (!node)
-                {
-                    os_dprintf("ERROR:memory alloc\r\n");
-                    os_mutex_put(&eG->mutex);
-                    return -WM_FAIL;
-                }
-                memset(node, 0x00, sizeof(event_wait_t));
-                /* Set the requested flag in the node */
-                node->thread_mask = requested_flags;
-                /* Create a semaophore */
-                ret = os_semaphore_create(&node->sem, "wait_thread");
-                if (ret)
-                {
-                    os_dprintf("ERROR:In creating semaphore\r\n");
-                    os_mem_free(node);
-                    os_mutex_put(&eG->mutex);
-                    return -WM_FAIL;
-                }
-                /* If there is no node present */
-                if (eG->list == NULL)
-                {
-                    eG->list = node;
-                    tmp      = eG->list;
-                }
-                else
-                {
-                    tmp = eG->list;
-                    /* Move to last node */
-                    while (tmp->next != NULL)
-                    {
-                        os_dprintf("waiting \r\n");
-                        tmp = tmp->next;
-                    }
-                    tmp->next  = node;
-                    node->prev = tmp;
-                    tmp        = tmp->next;
-                }
-                /* Take semaphore first time */
-                ret = os_semaphore_get(&tmp->sem, OS_WAIT_FOREVER);
-                if (ret != WM_SUCCESS)
-                {
-                    os_dprintf("ERROR:1st sem get error\r\n");
-                    os_mutex_put(&eG->mutex);
-                    /*Delete the created semaphore */
-                    os_semaphore_delete(&tmp->sem);
-                    /* Remove ourselves from the list */
-                    os_event_flags_remove_node(tmp, eG);
-                    return -WM_FAIL;
-                }
-            }
-            os_mutex_put(&eG->mutex);
-            /* Second time get is performed for work-around purpose
-            as in current implementation of semaphore 1st request
-            is always satisfied */
-            ret = os_semaphore_get(&tmp->sem, os_msec_to_ticks(wait_option));
-            if (ret != WM_SUCCESS)
-            {
-                os_mutex_get(&eG->mutex, OS_WAIT_FOREVER);
-                /*Delete the created semaphore */
-                os_semaphore_delete(&tmp->sem);
-                /* Remove ourselves from the list */
-                os_event_flags_remove_node(tmp, eG);
-                os_mutex_put(&eG->mutex);
-                return EF_NO_EVENTS;
-            }
-
-            /* We have woken up */
-            /* If the event group deletion has been requested */
-            if (eG->delete_group)
-            {
-                os_mutex_get(&eG->mutex, OS_WAIT_FOREVER);
-                /*Delete the created semaphore */
-                os_semaphore_delete(&tmp->sem);
-                /* Remove ourselves from the list */
-                os_event_flags_remove_node(tmp, eG);
-                os_mutex_put(&eG->mutex);
-                return -WM_FAIL;
-            }
-            wait_done = 1;
-            goto check_again;
-        }
-        else
-        {
-            os_mutex_put(&eG->mutex);
+        if ((flags & requested_flags) == 0)
             return EF_NO_EVENTS;
-        }
+        *actual_flags_ptr = flags & requested_flags;
     }
+    return WM_SUCCESS;
 }
 
 int os_event_flags_set(event_group_handle_t hnd, unsigned flags_to_set, flag_rtrv_option_t option)
 {
-    event_wait_t *tmp = NULL;
+    BaseType_t ret                      = pdPASS;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
-    if (hnd == 0)
+    if (hnd == NULL)
     {
         os_dprintf("ERROR:Invalid event flag handle\r\n");
         return -WM_FAIL;
@@ -358,107 +228,112 @@ int os_event_flags_set(event_group_handle_t hnd, unsigned flags_to_set, flag_rtr
         return -WM_FAIL;
     }
 
-    event_group_t *eG = (event_group_t *)hnd;
-
-    os_mutex_get(&eG->mutex, OS_WAIT_FOREVER);
-
-    /* Set flags according to the set_option */
     if (option == EF_OR)
-        eG->flags |= flags_to_set;
+    {
+        if (flags_to_set & ~EF_FLAGS_MASK)
+        {
+            os_dprintf("ERROR:Flags to be set are reserved\r\n");
+            return -WM_FAIL;
+        }
+        if (is_isr_context())
+        {
+            /* This call is from Cortex-M3/4 handler mode, i.e. exception
+             * context: the timer daemon task sets the flags, and wakes the
+             * waiting tasks, on our behalf. */
+            ret = xEventGroupSetBitsFromISR(hnd, flags_to_set, &xHigherPriorityTaskWoken);
+            portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
+        }
+        else
+            (void)xEventGroupSetBits(hnd, flags_to_set);
+    }
     else if (option == EF_AND)
-        eG->flags &= flags_to_set;
+    {
+        /* Clearing flags never wakes a task up */
+        if (is_isr_context())
+            ret = xEventGroupClearBitsFromISR(hnd, ~flags_to_set & EF_FLAGS_MASK);
+        else
+            (void)xEventGroupClearBits(hnd, ~flags_to_set & EF_FLAGS_MASK);
+    }
     else
     {
         os_dprintf("ERROR:Invalid flag set option\r\n");
-        os_mutex_put(&eG->mutex);
         return -WM_FAIL;
     }
 
-    if (eG->list)
-    {
-        tmp = eG->list;
-        if (tmp->next == NULL)
-        {
-            if (tmp->thread_mask & eG->flags)
-                os_semaphore_put(&tmp->sem);
-        }
-        else
-        {
-            while (tmp != NULL)
-            {
-                if (tmp->thread_mask & eG->flags)
-                    os_semaphore_put(&tmp->sem);
-                tmp = tmp->next;
-            }
-        }
-    }
-    os_mutex_put(&eG->mutex);
-    return WM_SUCCESS;
+    /* From an interrupt, the request may not fit in the timer command queue */
+    return ret == pdPASS ? WM_SUCCESS : -WM_FAIL;
 }
 
 int os_event_flags_delete(event_group_handle_t *hnd)
 {
-    int i, max_attempt = 3;
-    event_wait_t *tmp = NULL;
-
-    if (*hnd == 0)
+    if (*hnd == NULL)
     {
         os_dprintf("ERROR:Invalid event flag handle\r\n");
         return -WM_FAIL;
     }
-    event_group_t *eG = (event_group_t *)*hnd;
 
-    os_mutex_get(&eG->mutex, OS_WAIT_FOREVER);
+    /* Tasks still waiting are woken up, and get EF_NO_EVENTS */
+    vEventGroupDelete(*hnd);
+    *hnd = NULL;
+    return WM_SUCCESS;
+}
 
-    /* Set the flag to delete the group */
-    eG->delete_group = 1;
+/* Atomic operations on the state of the reader-writer locks: LDREX/STREX on
+ * Cortex-M, the compiler builtins elsewhere (host). A failed compare and swap
+ * may be spurious, callers just read the state again. */
+#ifdef __CORTEX_M
+static inline uint32_t os_rwlock_load(os_rw_lock_t *lock)
+{
+    return lock->state;
+}
 
-    if (eG->list)
+static inline bool os_rwlock_cas(os_rw_lock_t *lock, uint32_t old_state, uint32_t new_state)
+{
+    if (__LDREXW(&lock->state) != old_state)
     {
-        tmp = eG->list;
-        if (tmp->next == NULL)
-            os_semaphore_put(&tmp->sem);
-        else
-        {
-            while (tmp != NULL)
-            {
-                os_semaphore_put(&tmp->sem);
-                tmp = tmp->next;
-            }
-        }
+        __CLREX();
+        return false;
     }
-    os_mutex_put(&eG->mutex);
+    if (__STREXW(new_state, &lock->state) != 0U)
+        return false;
+    /* Keep the accesses of the critical section after the lock update */
+    __DMB();
+    return true;
+}
 
-    /* If still list is not empty then wait for 3 seconds */
-    for (i = 0; i < max_attempt; i++)
-    {
-        os_mutex_get(&eG->mutex, OS_WAIT_FOREVER);
-        if (eG->list)
-        {
-            os_mutex_put(&eG->mutex);
-            os_thread_sleep(os_msec_to_ticks(1000));
-        }
-        else
-        {
-            os_mutex_put(&eG->mutex);
-            break;
-        }
-    }
+static inline void os_rwlock_add(volatile uint32_t *value, uint32_t delta)
+{
+    uint32_t old_value;
 
-    os_mutex_get(&eG->mutex, OS_WAIT_FOREVER);
-    if (eG->list)
+    do
     {
-        os_mutex_put(&eG->mutex);
-        return -WM_FAIL;
-    }
-    else
-        os_mutex_put(&eG->mutex);
+        old_value = __LDREXW(value);
+    } while (__STREXW(old_value + delta, value) != 0U);
+    __DMB();
+}
+#else
+static inline uint32_t os_rwlock_load(os_rw_lock_t *lock)
+{
+    return __atomic_load_n(&lock->state, __ATOMIC_ACQUIRE);
+}
 
-    /* Delete the event group */
-    os_mem_free(eG);
-    *hnd = 0;
-    return WM_SUCCESS;
+static inline bool os_rwlock_cas(os_rw_lock_t *lock, uint32_t old_state, uint32_t new_state)
+{
+    return __atomic_compare_exchange_n(&lock->state, &old_state, new_state, true, __ATOMIC_ACQ_REL,
+                                       __ATOMIC_RELAXED);
+}
+
+static inline void os_rwlock_add(volatile uint32_t *value, uint32_t delta)
+{
+    (void)__atomic_fetch_add(value, delta, __ATOMIC_ACQ_REL);
 }
+#endif
+
+#ifdef CONFIG_OS_RWLOCK_STATS
+#define OS_RWLOCK_STAT_INC(lock, counter) os_rwlock_add(&(lock)->stats.counter, 1U)
+#else
+#define OS_RWLOCK_STAT_INC(lock, counter)
+#endif
 
 int os_rwlock_create(os_rw_lock_t *plock, const char *mutex_name, const char *lock_name)
 {
@@ -477,73 +352,129 @@ int os_rwlock_create_with_cb(os_rw_lock_t *plock, const char *mutex_name, const
     {
         return -WM_FAIL;
     }
-    plock->reader_count = 0;
-    plock->reader_cb    = r_fn;
+    plock->state     = 0;
+    plock->reader_cb = r_fn;
+#ifdef CONFIG_OS_RWLOCK_STATS
+    memset(&plock->stats, 0, sizeof(plock->stats));
+#endif
     return ret;
 }
 
+/* Join the readers if they hold rw_lock: while they are in, even if a writer
+ * waits for it, as the first reader always did; once they are gone, if no
+ * writer waits for it */
+static inline bool os_rwlock_read_lock_fast(os_rw_lock_t *lock)
+{
+    uint32_t state;
+
+    do
+    {
+        state = os_rwlock_load(lock);
+        if (!(state & OS_RWLOCK_HELD))
+            return false;
+        if ((state & OS_RWLOCK_READERS_MASK) == 0U && (state & OS_RWLOCK_WRITERS_MASK) != 0U)
+            return false;
+    } while (!os_rwlock_cas(lock, state, state + 1U));
+    return true;
+}
+
 int os_rwlock_read_lock(os_rw_lock_t *lock, unsigned int wait_time)
 {
     int ret = WM_SUCCESS;
-    ret     = os_mutex_get(&(lock->reader_mutex), OS_WAIT_FOREVER);
+
+    if (os_rwlock_read_lock_fast(lock))
+    {
+        OS_RWLOCK_STAT_INC(lock, read_fast);
+        return WM_SUCCESS;
+    }
+
+    ret = os_mutex_get(&(lock->reader_mutex), OS_WAIT_FOREVER);
     if (ret == -WM_FAIL)
     {
         return ret;
     }
-    lock->reader_count++;
-    if (lock->reader_count == 1)
+    /* Another reader may have got rw_lock back while we waited for the mutex */
+    if (os_rwlock_read_lock_fast(lock))
     {
-        if (lock->reader_cb)
-        {
-            ret = lock->reader_cb(lock, wait_time);
-            if (ret == -WM_FAIL)
-            {
-                lock->reader_count--;
-                os_mutex_put(&(lock->reader_mutex));
-                return ret;
-            }
-        }
-        else
-        {
-            /* If  1 it is the first reader and
-             * if writer is not active, reader will get access
-             * else reader will block.
-             */
-            ret = os_semaphore_get(&(lock->rw_lock), wait_time);
-            if (ret == -WM_FAIL)
-            {
-                lock->reader_count--;
-                os_mutex_put(&(lock->reader_mutex));
-                return ret;
-            }
-        }
+        os_mutex_put(&(lock->reader_mutex));
+        OS_RWLOCK_STAT_INC(lock, read_slow);
+        return WM_SUCCESS;
     }
+
+    /* A writer holds rw_lock, or is about to get it from the readers:
+     * get it after the writer.
+     */
+    if (lock->reader_cb)
+        ret = lock->reader_cb(lock, wait_time);
+    else
+        ret = os_semaphore_get(&(lock->rw_lock), wait_time);
+    if (ret == -WM_FAIL)
+    {
+        os_mutex_put(&(lock->reader_mutex));
+        OS_RWLOCK_STAT_INC(lock, read_fail);
+        return ret;
+    }
+    /* Nobody else can set OS_RWLOCK_HELD, as we hold rw_lock */
+    os_rwlock_add(&lock->state, OS_RWLOCK_HELD + 1U);
     os_mutex_put(&(lock->reader_mutex));
+    OS_RWLOCK_STAT_INC(lock, read_slow);
     return ret;
 }
 
 int os_rwlock_read_unlock(os_rw_lock_t *lock)
 {
-    int ret = os_mutex_get(&(lock->reader_mutex), OS_WAIT_FOREVER);
-    if (ret == -WM_FAIL)
-    {
-        return ret;
-    }
-    lock->reader_count--;
-    if (lock->reader_count == 0)
+    uint32_t state, new_state;
+
+    do
     {
-        /* This is last reader so
+        state = os_rwlock_load(lock);
+        if ((state & OS_RWLOCK_READERS_MASK) == 0U)
+            return -WM_FAIL;
+        new_state = state - 1U;
+        /* This is last reader and a writer waits, so
          * give a chance to writer now
          */
+        if ((new_state & OS_RWLOCK_READERS_MASK) == 0U && (new_state & OS_RWLOCK_WRITERS_MASK) != 0U)
+            new_state &= ~OS_RWLOCK_HELD;
+    } while (!os_rwlock_cas(lock, state, new_state));
+
+    if ((state & OS_RWLOCK_HELD) && !(new_state & OS_RWLOCK_HELD))
         os_semaphore_put(&(lock->rw_lock));
-    }
-    os_mutex_put(&(lock->reader_mutex));
-    return ret;
+    return WM_SUCCESS;
 }
 
 int os_rwlock_write_lock(os_rw_lock_t *lock, unsigned int wait_time)
 {
-    int ret = os_semaphore_get(&(lock->rw_lock), wait_time);
+    uint32_t state;
+    int ret;
+
+    /* Keep new readers off the fast path from now on */
+    os_rwlock_add(&lock->state, OS_RWLOCK_WRITER_ONE);
+
+    /* If no reader is left, but they still hold rw_lock, give it
+     * back on their behalf. Otherwise the last reader will.
+     */
+    do
+    {
+        state = os_rwlock_load(lock);
+        if (!(state & OS_RWLOCK_HELD) || (state & OS_RWLOCK_READERS_MASK) != 0U)
+            break;
+    } while (!os_rwlock_cas(lock, state, state & ~OS_RWLOCK_HELD));
+
+    if (state & OS_RWLOCK_HELD)
+    {
+        if ((state & OS_RWLOCK_READERS_MASK) == 0U)
+            os_semaphore_put(&(lock->rw_lock));
+        else
+            OS_RWLOCK_STAT_INC(lock, write_wait);
+    }
+
+    ret = os_semaphore_get(&(lock->rw_lock), wait_time);
+    os_rwlock_add(&lock->state, (uint32_t)-OS_RWLOCK_WRITER_ONE);
+    if (ret == WM_SUCCESS)
+        OS_RWLOCK_STAT_INC(lock, write);
+    else
+        OS_RWLOCK_STAT_INC(lock, write_fail);
     return ret;
 }
 
@@ -557,10 +488,28 @@ void os_rwlock_delete(os_rw_lock_t *lock)
     lock->reader_cb = NULL;
     os_semaphore_delete(&(lock->rw_lock));
     os_mutex_delete(&(lock->reader_mutex));
-    lock->reader_count = 0;
+    lock->state = 0;
+}
+
+#ifdef CONFIG_OS_RWLOCK_STATS
+void os_rwlock_get_stats(os_rw_lock_t *lock, os_rwlock_stats_t *stats, bool reset)
+{
+    /* The counters are read and reset one by one, without locking */
+    *stats = lock->stats;
+    if (reset)
+    {
+        os_rwlock_add(&lock->stats.read_fast, (uint32_t)-stats->read_fast);
+        os_rwlock_add(&lock->stats.read_slow, (uint32_t)-stats->read_slow);
+        os_rwlock_add(&lock->stats.read_fail, (uint32_t)-stats->read_fail);
+        os_rwlock_add(&lock->stats.write, (uint32_t)-stats->write);
+        os_rwlock_add(&lock->stats.write_wait, (uint32_t)-stats->write_wait);
+        os_rwlock_add(&lock->stats.write_fail, (uint32_t)-stats->write_fail);
+    }
 }
+#endif
 
 /* returns time in micro-secs since time began */
+#ifdef __CORTEX_M
 unsigned int os_get_timestamp()
 {
     uint32_t nticks;
@@ -585,12 +534,33 @@ unsigned int os_get_timestamp()
     vPortExitCritical();
     return ((CNTMAX - counter) / CPU_CLOCK_TICKSPERUSEC) + (nticks * USECSPERTICK);
 }
+#else
+unsigned int os_get_timestamp()
+{
+    struct timespec now;
 
+    /* The host has no SysTick: the monotonic clock, wrapping around at
+     * 32 bits as on the target */
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned int)((uint64_t)now.tv_sec * 1000000U + (uint64_t)now.tv_nsec / 1000U);
+}
+#endif
+
+static uint8_t u_hash_buff[SHA256HashSize];
+static uint8_t _uninit_mem_hash_len;
+
+uint8_t *get_uninit_mem_hash_buff(uint8_t offset)
+{
+	if ((_uninit_mem_hash_len == SHA256HashSize) && (offset < SHA256HashSize))
+                return u_hash_buff+offset;
+	else
+		return NULL;
+}
+
+#ifdef __CORTEX_M
 extern unsigned long __nvram_end__;
 extern unsigned long  __bss_start__;
 extern unsigned long  __HeapBase;
-static uint8_t u_hash_buff[SHA256HashSize];
-static uint8_t _uninit_mem_hash_len;
 
 /*end address of uninitialized heap memory */
 const unsigned long _uninit_heap_end = 0x0015BFFF;
@@ -603,14 +573,6 @@ const unsigned long _uninit_nvram_end = 0x480C3FFF;
 
 #define MIN_UNINIT_RAM_REQ_FOR_128BIT_ENTROPY (44 * 1024)
 
-uint8_t *get_uninit_mem_hash_buff(uint8_t offset)
-{
-	if ((_uninit_mem_hash_len == SHA256HashSize) && (offset < SHA256HashSize))
-                return u_hash_buff+offset;
-	else
-		return NULL;
-}
-
 void get_hash_from_uninit_mem()
 {
 	int uninit_len = 0;
@@ -643,3 +605,11 @@ void get_hash_from_uninit_mem()
 		_uninit_mem_hash_len = SHA256HashSize;
    return;
 }
+#else
+/* The host has no uninitialized RAM to hash: the seed comes from the kernel */
+void get_hash_from_uninit_mem()
+{
+	if (getrandom(u_hash_buff, SHA256HashSize, 0) == SHA256HashSize)
+		_uninit_mem_hash_len = SHA256HashSize;
+}
+#endif
@@ -0,0 +1,203 @@
+/** @file os_trace.c
+ *
+ *  @brief  This file provides the FreeRTOS scheduling trace recorder
+ *
+ *  Copyright 2026 NXP
+ *
+ *  NXP CONFIDENTIAL
+ *  The source code contained or described herein and all documents related to
+ *  the source code ("Materials") are owned by NXP, its
+ *  suppliers and/or its licensors. Title to the Materials remains with NXP,
+ *  its suppliers and/or its licensors. The Materials contain
+ *  trade secrets and proprietary and confidential information of NXP, its
+ *  suppliers and/or its licensors. The Materials are protected by worldwide copyright
+ *  and trade secret laws and treaty provisions. No part of the Materials may be
+ *  used, copied, reproduced, modified, published, uploaded, posted,
+ *  transmitted, distributed, or disclosed in any way without NXP's prior
+ *  express written permission.
+ *
+ *  No license under any patent, copyright, trade secret or other intellectual
+ *  property right is granted to or conferred upon you by disclosure or delivery
+ *  of the Materials, either expressly, by implication, inducement, estoppel or
+ *  otherwise. Any license under such intellectual property rights must be
+ *  express and approved by NXP in writing.
+ *
+ */
+
+/* os_trace.c: The kernel calls the recorder from its trace macros, in the
+ * context switch, with the interrupts masked, or with the scheduler
+ * suspended: a record costs a read of the run time counter and 8 bytes of
+ * stores. The records are written with the interrupts masked, since the
+ * macros called with the scheduler suspended may be interrupted by one that
+ * writes a record.
+ *
+ * The heap records are written by the trace macros of the heap, with the
+ * scheduler suspended or in a critical section, two records per allocation or
+ * free: the heap replay needs the address of the block, to match the frees to
+ * the allocations, and the timestamp places it in the scheduling trace. */
+
+#include <wm_os.h>
+#include <os_trace.h>
+
+#ifdef CONFIG_OS_TRACE
+
+#if configUSE_TRACE_FACILITY != 1
+#error "CONFIG_OS_TRACE needs configUSE_TRACE_FACILITY, for the numbers of the tasks and objects"
+#endif
+
+#if configGENERATE_RUN_TIME_STATS != 1
+#error "CONFIG_OS_TRACE needs configGENERATE_RUN_TIME_STATS, for the run time counter"
+#endif
+
+#if (CONFIG_OS_TRACE_RECORDS & (CONFIG_OS_TRACE_RECORDS - 1U)) != 0U
+#error "CONFIG_OS_TRACE_RECORDS must be a power of 2"
+#endif
+
+/* The name records carry 4 characters each */
+#define OS_TRACE_NAME_CHARS 4U
+
+static struct os_trace_record os_trace_ring[CONFIG_OS_TRACE_RECORDS];
+static volatile uint32_t os_trace_written;
+static volatile uint32_t os_trace_running;
+/* Task switched in last, not recorded again when it is switched in again */
+static uint32_t os_trace_current;
+static uint32_t os_trace_objects;
+
+/* Call with the interrupts masked */
+static void os_trace_put(uint32_t timestamp, uint8_t type, uint8_t info, uint32_t id)
+{
+    struct os_trace_record *record = &os_trace_ring[os_trace_written & (CONFIG_OS_TRACE_RECORDS - 1U)];
+
+    record->timestamp = timestamp;
+    record->type      = type;
+    record->info      = info;
+    record->id        = (uint16_t)id;
+    os_trace_written++;
+}
+
+void os_trace_event(uint8_t type, uint8_t info, uint32_t id)
+{
+    UBaseType_t mask;
+
+    if ((os_trace_running & OS_TRACE_SCHED) == 0U)
+        return;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    os_trace_put(portGET_RUN_TIME_COUNTER_VALUE(), type, info, id);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+void os_trace_task_switch(uint32_t task)
+{
+    /* The kernel switches to the same task when it yields to no other */
+    if (task == os_trace_current)
+        return;
+    os_trace_current = task;
+    os_trace_event(OS_TRACE_TASK_SWITCH, 0U, task);
+}
+
+void os_trace_delay(uint32_t ticks)
+{
+    os_trace_event(OS_TRACE_DELAY, 0U, ticks < 0xFFFFU ? ticks : 0xFFFFU);
+}
+
+void os_trace_task_create(uint32_t task, const char *name)
+{
+    UBaseType_t mask;
+    uint32_t chars;
+    unsigned int i, j;
+
+    if ((os_trace_running & OS_TRACE_SCHED) == 0U)
+        return;
+
+    /* The name records follow the create record, they are written with the
+     * interrupts masked */
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    os_trace_put(portGET_RUN_TIME_COUNTER_VALUE(), OS_TRACE_TASK_CREATE, 0U, task);
+    for (i = 0U; i < configMAX_TASK_NAME_LEN && name[i] != '\0'; i += OS_TRACE_NAME_CHARS)
+    {
+        chars = 0U;
+        for (j = 0U; j < OS_TRACE_NAME_CHARS && i + j < configMAX_TASK_NAME_LEN && name[i + j] != '\0'; j++)
+            chars |= (uint32_t)(uint8_t)name[i + j] << (8U * j);
+        os_trace_put(chars, OS_TRACE_TASK_NAME, (uint8_t)i, task);
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+uint32_t os_trace_object_create(uint8_t type)
+{
+    UBaseType_t mask;
+    uint32_t id;
+
+    /* The objects are numbered whether the recorder runs or not: they are
+     * created once, most of them before it starts */
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    id   = ++os_trace_objects;
+    if ((os_trace_running & OS_TRACE_SCHED) != 0U)
+        os_trace_put(portGET_RUN_TIME_COUNTER_VALUE(), OS_TRACE_OBJECT_CREATE, type, id);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+    return id;
+}
+
+void os_trace_heap(uint8_t type, uint8_t tag, uint32_t size, const void *address)
+{
+    UBaseType_t mask;
+
+    if ((os_trace_running & OS_TRACE_HEAP) == 0U)
+        return;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    os_trace_put(portGET_RUN_TIME_COUNTER_VALUE(), type, tag, size < 0xFFFFU ? size : 0xFFFFU);
+    os_trace_put((uint32_t)(uintptr_t)address, OS_TRACE_HEAP_ADDRESS, tag, 0U);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+void os_trace_start(uint32_t classes)
+{
+    UBaseType_t mask;
+
+    /* Record the running task, the records that follow are about it */
+    mask             = portSET_INTERRUPT_MASK_FROM_ISR();
+    os_trace_running = classes;
+    if ((classes & OS_TRACE_SCHED) != 0U)
+        os_trace_put(portGET_RUN_TIME_COUNTER_VALUE(), OS_TRACE_TASK_SWITCH, 0U, os_trace_current);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+void os_trace_stop(void)
+{
+    os_trace_running = 0U;
+}
+
+void os_trace_clear(void)
+{
+    UBaseType_t mask;
+
+    mask             = portSET_INTERRUPT_MASK_FROM_ISR();
+    os_trace_written = 0U;
+    if ((os_trace_running & OS_TRACE_SCHED) != 0U)
+        os_trace_put(portGET_RUN_TIME_COUNTER_VALUE(), OS_TRACE_TASK_SWITCH, 0U, os_trace_current);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+void os_trace_get_status(struct os_trace_status *status)
+{
+    status->running = os_trace_running;
+    status->written = os_trace_written;
+    status->count   = status->written < CONFIG_OS_TRACE_RECORDS ? status->written : CONFIG_OS_TRACE_RECORDS;
+}
+
+int os_trace_read(uint32_t index, struct os_trace_record *record)
+{
+    uint32_t written = os_trace_written;
+    uint32_t first   = written > CONFIG_OS_TRACE_RECORDS ? written - CONFIG_OS_TRACE_RECORDS : 0U;
+
+    if (index >= written - first)
+        return -1;
+
+    *record = os_trace_ring[(first + index) & (CONFIG_OS_TRACE_RECORDS - 1U)];
+    return 0;
+}
+
+#endif /* CONFIG_OS_TRACE */
@@ -0,0 +1,427 @@
+#!/usr/bin/env python3
+"""
+This file is part of the NXP wifi middleware
+
+Copyright 2026 NXP
+
+Purpose
+
+Convert a dump of the FreeRTOS scheduling trace (os-trace dump, see
+incl/port/os/os_trace.h) to the Chrome trace format, which Perfetto
+(https://ui.perfetto.dev, "Open trace file") and chrome://tracing display:
+a track per task with its running, ready and blocked slices, the reason it
+blocks (queue, semaphore, mutex, event group, notification or delay), and a
+"CPU" track with the task that runs.
+
+It also prints, per task, the CPU time, the number of times it is switched
+in, the time it spends ready but not running, and the tasks that ran while it
+was ready: those that starve it.
+
+The heap records (os-trace start heap, or all) give a "heap" counter track,
+the bytes allocated per heap tag while recording, and --heap writes them as a
+trace for boards/linux_host/rtos_examples/heap_replay, a line per operation:
+  a <block> <size> <tag>   allocate <size> bytes with <tag>, as block <block>
+  f <block>                free block <block>
+The frees of the blocks allocated before the recording, and the allocations
+that failed, are left out.
+
+The dump is read from a log of the console: the lines that do not start with
+"os-trace:" are ignored, and the last dump of the log is converted.
+
+Example, with the log of the console in console.log:
+  python3 os_trace_convert.py console.log -o trace.json
+  python3 os_trace_convert.py console.log --heap heap.txt
+"""
+
+import argparse
+import json
+import re
+import sys
+
+# Version 2 adds the heap records
+SUPPORTED_VERSIONS = (1, 2)
+
+# Record types, OS_TRACE_* in os_trace.h
+TASK_CREATE = 1
+TASK_NAME = 2
+TASK_DELETE = 3
+TASK_SWITCH = 4
+TASK_READY = 5
+DELAY = 6
+BLOCK_SEND = 7
+BLOCK_RECEIVE = 8
+BLOCK_PEEK = 9
+BLOCK_NOTIFY = 10
+BLOCK_EVENT_GROUP = 11
+OBJECT_CREATE = 12
+MALLOC = 13
+FREE = 14
+HEAP_ADDRESS = 15
+
+OBJECT_TYPES = {
+    0: 'queue',
+    1: 'mutex',
+    2: 'counting semaphore',
+    3: 'binary semaphore',
+    4: 'recursive mutex',
+    8: 'event group',
+}
+
+HEX_RE = re.compile(r'[0-9a-fA-F]*')
+
+# Track of the CPU, the tasks are numbered from 1
+CPU_TID = 0
+
+
+class Dump:
+    def __init__(self, version, hz, written):
+        self.version = version
+        self.hz = hz
+        self.written = written
+        self.tasks = {}
+        self.priorities = {}
+        self.heap_tags = {}
+        self.records = []
+
+
+def parse(lines):
+    """Return the last dump of the log, None if there is none"""
+    dump = None
+    last = None
+    for line in lines:
+        pos = line.find('os-trace: ')
+        if pos < 0:
+            continue
+        fields = line[pos + len('os-trace: '):].split()
+        if not fields:
+            continue
+        if fields[0] == 'begin' and len(fields) >= 4:
+            dump = Dump(int(fields[1]), int(fields[2]), int(fields[3]))
+        elif dump is None:
+            continue
+        elif fields[0] == 'task' and len(fields) >= 4:
+            task = int(fields[1])
+            dump.priorities[task] = int(fields[2])
+            dump.tasks[task] = ' '.join(fields[3:])
+        elif fields[0] == 'heap-tag' and len(fields) >= 3:
+            dump.heap_tags[int(fields[1])] = ' '.join(fields[2:])
+        elif fields[0] == 'data' and len(fields) >= 2:
+            # Other tasks may print in the middle of a line: keep the records
+            # before anything else
+            data = HEX_RE.match(fields[1]).group(0)
+            for pos in range(0, len(data) - 15, 16):
+                dump.records.append((int(data[pos:pos + 8], 16), int(data[pos + 8:pos + 10], 16),
+                                     int(data[pos + 10:pos + 12], 16), int(data[pos + 12:pos + 16], 16)))
+        elif fields[0] == 'end':
+            last = dump
+            dump = None
+    return last
+
+
+def object_name(info, id):
+    return '%s %d' % (OBJECT_TYPES.get(info, 'object'), id)
+
+
+def block_reason(kind, info, id, objects):
+    if kind == DELAY:
+        return 'delay' if id == 0xFFFF else 'delay %d ticks' % id
+    if kind == BLOCK_NOTIFY:
+        return 'notification'
+    if kind == BLOCK_EVENT_GROUP:
+        return 'event group %d' % id
+    name = object_name(objects.get(id, info), id)
+    if kind == BLOCK_SEND:
+        return 'send to ' + name
+    if kind == BLOCK_PEEK:
+        return 'peek ' + name
+    if info in (1, 4):
+        return 'lock ' + name
+    if info in (2, 3):
+        return 'take ' + name
+    return 'receive from ' + name
+
+
+class TaskStats:
+    def __init__(self):
+        self.running = 0.0
+        self.switches = 0
+        self.ready = 0.0
+        self.ready_max = 0.0
+        self.waits = 0
+        self.blocked = 0.0
+        # Task: time it ran while this task was ready
+        self.starved_by = {}
+
+
+class Converter:
+    def __init__(self, dump):
+        self.dump = dump
+        self.events = []
+        self.stats = {}
+        # Task: (state, since, reason)
+        self.state = {}
+        # (start, end, task) of the CPU, in time order
+        self.cpu = []
+        self.objects = {}
+        self.current = None
+        self.reason = None
+        self.deleted = set()
+        self.first = None
+        self.last = None
+        # (kind, tag, size, address) of the heap, the size of the allocations
+        # is that asked for with heap_6.c
+        self.heap = []
+        # Address: (size, tag) of the blocks allocated while recording
+        self.blocks = {}
+        self.heap_bytes = {}
+        self.heap_peak = {}
+        self.heap_failed = 0
+
+    def us(self, ticks):
+        return ticks * 1e6 / self.dump.hz
+
+    def task_stats(self, task):
+        if task not in self.stats:
+            self.stats[task] = TaskStats()
+        return self.stats[task]
+
+    def slice(self, tid, name, start, end, args=None):
+        event = {'name': name, 'ph': 'X', 'pid': 1, 'tid': tid, 'ts': start, 'dur': end - start}
+        if args:
+            event['args'] = args
+        self.events.append(event)
+
+    def close(self, task, now):
+        """End the slice of the current state of the task"""
+        state, since, reason = self.state.pop(task, (None, now, None))
+        stats = self.task_stats(task)
+        if state == 'running':
+            self.slice(task, 'running', since, now)
+            self.slice(CPU_TID, self.name(task), since, now)
+            self.cpu.append((since, now, task))
+            stats.running += now - since
+        elif state == 'ready':
+            by = self.ran_during(since, now)
+            self.slice(task, 'ready', since, now,
+                       {'ran': ', '.join('%s %.0f us' % (self.name(t), d) for t, d in by)} if by else None)
+            stats.ready += now - since
+            stats.ready_max = max(stats.ready_max, now - since)
+            stats.waits += 1
+            for t, d in by:
+                stats.starved_by[t] = stats.starved_by.get(t, 0.0) + d
+        elif state == 'blocked':
+            self.slice(task, reason, since, now)
+            stats.blocked += now - since
+
+    def ran_during(self, start, end):
+        """Tasks that ran between start and end, the longest first"""
+        ran = {}
+        for since, until, task in reversed(self.cpu):
+            if until <= start:
+                break
+            ran[task] = ran.get(task, 0.0) + min(until, end) - max(since, start)
+        return sorted(ran.items(), key=lambda item: -item[1])
+
+    def name(self, task):
+        return self.dump.tasks.get(task, 'task %d' % task)
+
+    def convert(self):
+        # The names of the tasks created while recording, those still alive
+        # are named by the dump
+        names = {}
+        for timestamp, kind, info, id in self.dump.records:
+            if kind == TASK_NAME and id not in self.dump.tasks:
+                names.setdefault(id, {})[info] = bytes((timestamp >> (8 * i)) & 0xFF for i in range(4)).rstrip(
+                    b'\0').decode('ascii', 'replace')
+        for task, parts in names.items():
+            self.dump.tasks[task] = ''.join(parts[offset] for offset in sorted(parts))
+
+        time = 0
+        previous = None
+        pending = None
+        for timestamp, kind, info, id in self.dump.records:
+            if kind == TASK_NAME:
+                continue
+            # The address of the heap operation of the previous record
+            if kind == HEAP_ADDRESS:
+                if pending is not None:
+                    self.heap_operation(pending[0], pending[1], pending[2], pending[3], timestamp)
+                pending = None
+                continue
+            # The counter wraps around at 32 bits
+            if previous is not None:
+                time += (timestamp - previous) & 0xFFFFFFFF
+            previous = timestamp
+            now = self.us(time)
+            if self.first is None:
+                self.first = now
+            self.last = now
+            if kind in (MALLOC, FREE):
+                pending = (now, kind, info, id)
+                continue
+            self.record(now, kind, info, id)
+
+        if self.last is not None:
+            for task in list(self.state):
+                self.close(task, self.last)
+        return self.events
+
+    def record(self, now, kind, info, id):
+        if kind == TASK_SWITCH:
+            if id == self.current:
+                return
+            if self.current is not None:
+                self.close(self.current, now)
+                if self.current in self.deleted:
+                    self.deleted.discard(self.current)
+                elif self.reason is not None:
+                    self.state[self.current] = ('blocked', now, self.reason)
+                else:
+                    self.state[self.current] = ('ready', now, None)
+            self.close(id, now)
+            self.state[id] = ('running', now, None)
+            self.task_stats(id).switches += 1
+            self.current = id
+            self.reason = None
+        elif kind == TASK_READY:
+            if id == self.current:
+                # Woken up before it is switched out
+                self.reason = None
+            elif self.state.get(id, (None,))[0] != 'ready':
+                self.close(id, now)
+                self.state[id] = ('ready', now, None)
+        elif kind in (DELAY, BLOCK_SEND, BLOCK_RECEIVE, BLOCK_PEEK, BLOCK_NOTIFY, BLOCK_EVENT_GROUP):
+            if self.current is not None:
+                self.reason = block_reason(kind, info, id, self.objects)
+        elif kind == TASK_CREATE:
+            self.events.append({'name': 'created', 'ph': 'i', 's': 't', 'pid': 1, 'tid': id, 'ts': now})
+        elif kind == TASK_DELETE:
+            self.events.append({'name': 'deleted', 'ph': 'i', 's': 't', 'pid': 1, 'tid': id, 'ts': now})
+            if id == self.current:
+                self.deleted.add(id)
+            else:
+                self.close(id, now)
+        elif kind == OBJECT_CREATE:
+            self.objects[id] = info
+
+    def heap_tag(self, tag):
+        return self.dump.heap_tags.get(tag, 'tag %d' % tag)
+
+    def heap_operation(self, now, kind, tag, size, address):
+        if kind == MALLOC:
+            if address == 0:
+                self.heap_failed += 1
+                return
+            self.blocks[address] = (size, tag)
+        else:
+            if address not in self.blocks:
+                # Allocated before the recording
+                return
+            size, tag = self.blocks.pop(address)
+        self.heap.append((kind, tag, size, address))
+        self.heap_bytes[tag] = self.heap_bytes.get(tag, 0) + (size if kind == MALLOC else -size)
+        self.heap_peak[tag] = max(self.heap_peak.get(tag, 0), self.heap_bytes[tag])
+        self.events.append({'name': 'heap', 'ph': 'C', 'pid': 1, 'ts': now,
+                            'args': {self.heap_tag(t): b for t, b in sorted(self.heap_bytes.items())}})
+
+    def write_heap(self, out, source):
+        """Write the heap operations as a trace for heap_replay"""
+        out.write('# heap trace of %s, os_trace_convert.py\n' % source)
+        out.write('# a <block> <size> <tag>: allocate, f <block>: free\n')
+        block = {}
+        count = 0
+        for kind, tag, size, address in self.heap:
+            if kind == MALLOC:
+                count += 1
+                block[address] = count
+                out.write('a %d %d %d\n' % (count, size, tag))
+            else:
+                out.write('f %d\n' % block.pop(address))
+
+    def metadata(self):
+        events = [{'name': 'process_name', 'ph': 'M', 'pid': 1, 'args': {'name': 'FreeRTOS'}},
+                  {'name': 'thread_name', 'ph': 'M', 'pid': 1, 'tid': CPU_TID, 'args': {'name': 'CPU'}},
+                  {'name': 'thread_sort_index', 'ph': 'M', 'pid': 1, 'tid': CPU_TID, 'args': {'sort_index': -1}}]
+        for task in sorted(set(self.stats) | set(self.dump.tasks)):
+            name = self.name(task)
+            if task in self.dump.priorities:
+                name += ' (prio %d)' % self.dump.priorities[task]
+            events.append({'name': 'thread_name', 'ph': 'M', 'pid': 1, 'tid': task, 'args': {'name': name}})
+            # The highest priorities first
+            events.append({'name': 'thread_sort_index', 'ph': 'M', 'pid': 1, 'tid': task,
+                           'args': {'sort_index': -self.dump.priorities.get(task, -1) * 1000 + task}})
+        return events
+
+    def summary(self, out):
+        total = (self.last - self.first) if self.first is not None else 0.0
+        out.write('%.0f us traced, %d records' % (total, len(self.dump.records)))
+        if self.dump.written > len(self.dump.records):
+            out.write(', the %d first are overwritten' % (self.dump.written - len(self.dump.records)))
+        out.write('\n\n%-12s %12s %6s %9s %12s %10s %12s\n' % ('task', 'running us', 'cpu %', 'switches', 'ready us',
+                                                             'ready max', 'blocked us'))
+        tasks = sorted(self.stats, key=lambda task: -self.stats[task].running)
+        for task in tasks:
+            stats = self.stats[task]
+            out.write('%-12s %12.0f %5.1f%% %9d %12.0f %10.0f %12.0f\n' %
+                      (self.name(task), stats.running, 100.0 * stats.running / total if total else 0.0,
+                       stats.switches, stats.ready, stats.ready_max, stats.blocked))
+
+        starved = [task for task in sorted(self.stats, key=lambda task: -self.stats[task].ready)
+                   if self.stats[task].ready > 0 and self.name(task) != 'IDLE']
+        if starved:
+            out.write('\nReady but not running, and the tasks that ran meanwhile:\n')
+        for task in starved:
+            stats = self.stats[task]
+            by = sorted(stats.starved_by.items(), key=lambda item: -item[1])
+            out.write('%-12s %.0f us in %d waits, max %.0f us: %s\n' %
+                      (self.name(task), stats.ready, stats.waits, stats.ready_max,
+                       ', '.join('%s %.0f%%' % (self.name(t), 100.0 * d / stats.ready) for t, d in by[:4])))
+
+        if self.heap or self.heap_failed:
+            mallocs = [size for kind, tag, size, address in self.heap if kind == MALLOC]
+            out.write('\nheap: %d allocations, %d of 256 bytes or less, %d frees, %d failed allocations\n' %
+                      (len(mallocs), len([size for size in mallocs if size <= 256]), len(self.heap) - len(mallocs),
+                       self.heap_failed))
+            for tag in sorted(self.heap_peak):
+                out.write('%-12s %8d bytes at the peak, %8d at the end\n' %
+                          (self.heap_tag(tag), self.heap_peak[tag], self.heap_bytes[tag]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('Purpose')[1],
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('log', help='log of the console with the dump, - for the standard input')
+    parser.add_argument('-o', '--output', help='Chrome trace (JSON) to write, default: the log with .json')
+    parser.add_argument('--heap', help='heap trace to write, for heap_replay')
+    parser.add_argument('-q', '--quiet', action='store_true', help='do not print the summary')
+    args = parser.parse_args()
+
+    if args.log == '-':
+        dump = parse(sys.stdin)
+    else:
+        with open(args.log, errors='replace') as log:
+            dump = parse(log)
+    if dump is None:
+        sys.exit('%s: no complete os-trace dump' % args.log)
+    if dump.version not in SUPPORTED_VERSIONS:
+        sys.exit('%s: os-trace dump version %d, %s supported' %
+                 (args.log, dump.version, ' and '.join(str(version) for version in SUPPORTED_VERSIONS)))
+
+    converter = Converter(dump)
+    events = converter.convert()
+    output = args.output or (re.sub(r'\.[^./]*$', '', args.log if args.log != '-' else 'os_trace') + '.json')
+    with open(output, 'w') as trace:
+        json.dump({'traceEvents': converter.metadata() + events, 'displayTimeUnit': 'ms'}, trace)
+    if args.heap:
+        with open(args.heap, 'w') as heap:
+            converter.write_heap(heap, args.log)
+
+    if not args.quiet:
+        converter.summary(sys.stdout)
+        print('\nwrote %s' % output)
+        if args.heap:
+            print('wrote %s' % args.heap)
+
+
+if __name__ == '__main__':
+    main()
@@ -1734,7 +1734,7 @@ int wifi_get_cal_data(wifi_cal_data_t *cal_data)
 
     cmd->command = wlan_cpu_to_le16(HostCmd_CMD_CFG_DATA);
 
-    HostCmd_DS_802_11_CFG_DATA *cfg_data_cmd = (HostCmd_DS_802_11_CFG_DATA *)((uint32_t)cmd + S_DS_GEN);
+    HostCmd_DS_802_11_CFG_DATA *cfg_data_cmd = (HostCmd_DS_802_11_CFG_DATA *)((t_u8 *)cmd + S_DS_GEN);
 
     cfg_data_cmd->action   = HostCmd_ACT_GEN_GET;
     cfg_data_cmd->type     = 0x02;
@@ -2635,7 +2635,7 @@ int wifi_set_smart_mode_cfg(char *ssid,
     HostCmd_DS_COMMAND *cmd = wifi_get_command_buffer();
 
     cmd->command                          = wlan_cpu_to_le16(HOST_CMD_SMART_MODE_CFG);
-    HostCmd_DS_SYS_CONFIG *sys_config_cmd = (HostCmd_DS_SYS_CONFIG *)((uint32_t)cmd + S_DS_GEN);
+    HostCmd_DS_SYS_CONFIG *sys_config_cmd = (HostCmd_DS_SYS_CONFIG *)((t_u8 *)cmd + S_DS_GEN);
     sys_config_cmd->action                = HostCmd_ACT_GEN_SET;
     uint8_t *tlv                          = (uint8_t *)sys_config_cmd->tlv_buffer;
 
@@ -2723,7 +2723,7 @@ int wifi_get_smart_mode_cfg()
     HostCmd_DS_COMMAND *cmd = wifi_get_command_buffer();
 
     cmd->command                          = wlan_cpu_to_le16(HOST_CMD_SMART_MODE_CFG);
-    HostCmd_DS_SYS_CONFIG *sys_config_cmd = (HostCmd_DS_SYS_CONFIG *)((uint32_t)cmd + S_DS_GEN);
+    HostCmd_DS_SYS_CONFIG *sys_config_cmd = (HostCmd_DS_SYS_CONFIG *)((t_u8 *)cmd + S_DS_GEN);
     sys_config_cmd->action                = HostCmd_ACT_GEN_GET;
 
     cmd->size    = size;
@@ -2742,7 +2742,7 @@ int wifi_start_smart_mode()
     HostCmd_DS_COMMAND *cmd = wifi_get_command_buffer();
 
     cmd->command                          = wlan_cpu_to_le16(HOST_CMD_SMART_MODE_CFG);
-    HostCmd_DS_SYS_CONFIG *sys_config_cmd = (HostCmd_DS_SYS_CONFIG *)((uint32_t)cmd + S_DS_GEN);
+    HostCmd_DS_SYS_CONFIG *sys_config_cmd = (HostCmd_DS_SYS_CONFIG *)((t_u8 *)cmd + S_DS_GEN);
     sys_config_cmd->action                = HostCmd_ACT_GEN_START;
 
     cmd->size    = size;
@@ -2761,7 +2761,7 @@ int wifi_stop_smart_mode()
     HostCmd_DS_COMMAND *cmd = wifi_get_command_buffer();
 
     cmd->command                          = wlan_cpu_to_le16(HOST_CMD_SMART_MODE_CFG);
-    HostCmd_DS_SYS_CONFIG *sys_config_cmd = (HostCmd_DS_SYS_CONFIG *)((uint32_t)cmd + S_DS_GEN);
+    HostCmd_DS_SYS_CONFIG *sys_config_cmd = (HostCmd_DS_SYS_CONFIG *)((t_u8 *)cmd + S_DS_GEN);
     sys_config_cmd->action                = HostCmd_ACT_GEN_STOP;
 
     cmd->size    = size;
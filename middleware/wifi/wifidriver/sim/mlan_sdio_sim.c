@@ -0,0 +1,501 @@
+/** @file mlan_sdio_sim.c
+ *
+ *  @brief This file provides a simulated SD8801 card for the SDIO driver API
+ */
+/*
+ *  Copyright 2026 NXP
+ *
+ *  NXP CONFIDENTIAL
+ *  The source code contained or described herein and all documents related to
+ *  the source code ("Materials") are owned by NXP, its
+ *  suppliers and/or its licensors. Title to the Materials remains with NXP,
+ *  its suppliers and/or its licensors. The Materials contain
+ *  trade secrets and proprietary and confidential information of NXP, its
+ *  suppliers and/or its licensors. The Materials are protected by worldwide copyright
+ *  and trade secret laws and treaty provisions. No part of the Materials may be
+ *  used, copied, reproduced, modified, published, uploaded, posted,
+ *  transmitted, distributed, or disclosed in any way without NXP's prior
+ *  express written permission.
+ *
+ *  No license under any patent, copyright, trade secret or other intellectual
+ *  property right is granted to or conferred upon you by disclosure or delivery
+ *  of the Materials, either expressly, by implication, inducement, estoppel or
+ *  otherwise. Any license under such intellectual property rights must be
+ *  express and approved by NXP in writing.
+ *
+ */
+
+#include <mlan_sdio_api.h>
+#include <wm_os.h>
+#include <board.h>
+#include <wifi.h>
+#include <pthread.h>
+
+#include "wifi_sim_internal.h"
+#include "wifi-sdio.h"
+
+/*
+ * The card is seen through the same API as the SDIO driver (mlan_sdio.c):
+ * CMD52 register accesses (sdio_drv_creg_*) and CMD53 port transfers
+ * (sdio_drv_read/write), in function 1. The registers are those of the
+ * SD8801 as used by wifi-sdio.c:
+ * - before the firmware is ready, CARD_TO_HOST_EVENT_REG, READ_BASE and
+ *   CARD_FW_STATUS drive the download to the I/O port.
+ * - then the host reads the interrupt status, the read and write bitmaps and
+ *   the read lengths of the ports in one CMD53 at address 0, reads the ports
+ *   with data (port 0 for command responses and events, 1 to 15 for data,
+ *   possibly aggregated), and writes commands to port 0 and data to the
+ *   others.
+ *
+ * Written commands and data are handed to the firmware at once, so the write
+ * ports are always free. The card interrupt is level triggered: it is raised
+ * as long as the host interrupt status, masked by HOST_INT_MASK_REG, is not
+ * zero, and the host has enabled it (sdio_enable_interrupt()).
+ */
+
+/** Address of port 0 */
+#define SIM_IOPORT 0x10000U
+/** Size of a firmware download chunk */
+#define SIM_FW_CHUNK_SIZE 1024U
+
+#define SIM_CTRL_QUEUE_LEN 8U
+#define SIM_DATA_QUEUE_LEN 32U
+
+struct sim_packet
+{
+    t_u16 len;
+    /** Data port the packet is in, 0 while it waits for one */
+    t_u8 port;
+    t_u8 data[WIFI_SIM_PORT_SIZE];
+};
+
+static struct
+{
+    /** Function 0 and function 1 registers */
+    t_u8 fn0[256];
+    t_u8 fn1[256];
+    bool ready;
+    wifi_sim_fw_header_t fw_header;
+    t_u32 fw_received;
+    /** Write ports freed since the last read of the interrupt status */
+    bool dn_ld;
+    struct sim_packet ctrl[SIM_CTRL_QUEUE_LEN];
+    unsigned int ctrl_head, ctrl_count;
+    struct sim_packet data[SIM_DATA_QUEUE_LEN];
+    unsigned int data_head, data_count;
+    /** Next data port to fill, as curr_rd_port in the driver */
+    t_u8 next_port;
+    bool int_enabled;
+    void (*cd_int)(int);
+} card;
+
+static pthread_mutex_t card_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* The card is shared with the threads outside FreeRTOS, hence a pthread
+ * mutex, taken with the interrupts disabled so that a task is never switched
+ * out holding it. */
+static UBaseType_t card_lock(void)
+{
+    UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+
+    pthread_mutex_lock(&card_mutex);
+    return mask;
+}
+
+static void card_unlock(UBaseType_t mask)
+{
+    pthread_mutex_unlock(&card_mutex);
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+static t_u8 card_int_status(void)
+{
+    t_u8 status = 0;
+
+    if (card.ctrl_count || card.data_count)
+        status |= UP_LD_HOST_INT_STATUS;
+    if (card.dn_ld)
+        status |= DN_LD_HOST_INT_STATUS;
+
+    return status;
+}
+
+static bool card_int_pending(void)
+{
+    return card.int_enabled && (card_int_status() & card.fn1[HOST_INT_MASK_REG]);
+}
+
+static uint32_t card_int_handler(void)
+{
+    UBaseType_t mask = card_lock();
+    bool pending     = card_int_pending();
+
+    if (pending)
+        card.int_enabled = false;
+    card_unlock(mask);
+
+    /* As SDIO_CardInterruptCallBack() */
+    if (pending && card.cd_int)
+        card.cd_int(0);
+
+    return pdFALSE;
+}
+
+static void card_raise_int(bool pending)
+{
+    if (pending)
+        vPortGenerateSimulatedInterrupt(BOARD_SDIO_CARD_IRQ);
+}
+
+int wifi_sim_card_upload(t_u16 type, const void *head, t_u16 head_len, const void *body, t_u16 body_len)
+{
+    struct sim_packet *pkt;
+    UBaseType_t mask;
+    t_u16 len = INTF_HEADER_LEN + head_len + body_len;
+    bool pending;
+
+    if (len > WIFI_SIM_PORT_SIZE)
+        return -WM_E_INVAL;
+
+    mask = card_lock();
+
+    if (type == MLAN_TYPE_DATA)
+    {
+        if (card.data_count == SIM_DATA_QUEUE_LEN)
+        {
+            card_unlock(mask);
+            return -WM_E_NOMEM;
+        }
+        pkt = &card.data[(card.data_head + card.data_count++) % SIM_DATA_QUEUE_LEN];
+    }
+    else
+    {
+        if (card.ctrl_count == SIM_CTRL_QUEUE_LEN)
+        {
+            card_unlock(mask);
+            return -WM_E_NOMEM;
+        }
+        pkt = &card.ctrl[(card.ctrl_head + card.ctrl_count++) % SIM_CTRL_QUEUE_LEN];
+    }
+
+    pkt->len  = len;
+    pkt->port = 0;
+    /* SDIO header: size and type */
+    pkt->data[0] = len & 0xff;
+    pkt->data[1] = len >> 8;
+    pkt->data[2] = type & 0xff;
+    pkt->data[3] = type >> 8;
+    memcpy(&pkt->data[INTF_HEADER_LEN], head, head_len);
+    if (body)
+        memcpy(&pkt->data[INTF_HEADER_LEN + head_len], body, body_len);
+
+    pending = card_int_pending();
+    card_unlock(mask);
+
+    card_raise_int(pending);
+
+    return WM_SUCCESS;
+}
+
+/* Put the received frames in the free data ports, in the order the driver
+ * reads them */
+static void card_fill_ports(void)
+{
+    unsigned int i;
+
+    for (i = 0; i < card.data_count; i++)
+    {
+        struct sim_packet *pkt = &card.data[(card.data_head + i) % SIM_DATA_QUEUE_LEN];
+
+        if (pkt->port)
+            continue;
+        /* All the ports are full when the next one is the first in use */
+        if (i && card.data[card.data_head].port == card.next_port)
+            break;
+
+        pkt->port = card.next_port;
+        if (++card.next_port == MAX_PORT)
+            card.next_port = 1;
+    }
+}
+
+static void card_read_mp_regs(t_u8 *regs, t_u32 len)
+{
+    t_u16 rd_bitmap = 0;
+    unsigned int i;
+    t_u8 mp_regs[MAX_MP_REGS];
+
+    card_fill_ports();
+
+    memset(mp_regs, 0, sizeof(mp_regs));
+
+    if (card.ctrl_count)
+    {
+        rd_bitmap |= CTRL_PORT_MASK;
+        mp_regs[RD_LEN_P0_L] = card.ctrl[card.ctrl_head].len & 0xff;
+        mp_regs[RD_LEN_P0_U] = card.ctrl[card.ctrl_head].len >> 8;
+    }
+    for (i = 0; i < card.data_count; i++)
+    {
+        struct sim_packet *pkt = &card.data[(card.data_head + i) % SIM_DATA_QUEUE_LEN];
+
+        if (!pkt->port)
+            break;
+        rd_bitmap |= 1U << pkt->port;
+        mp_regs[RD_LEN_P0_L + (pkt->port << 1)] = pkt->len & 0xff;
+        mp_regs[RD_LEN_P0_U + (pkt->port << 1)] = pkt->len >> 8;
+    }
+
+    mp_regs[HOST_INT_STATUS_REG] = card_int_status();
+    mp_regs[RD_BITMAP_L]         = rd_bitmap & 0xff;
+    mp_regs[RD_BITMAP_U]         = rd_bitmap >> 8;
+    mp_regs[WR_BITMAP_L]         = (CTRL_PORT_MASK | DATA_PORT_MASK) & 0xff;
+    mp_regs[WR_BITMAP_U]         = (CTRL_PORT_MASK | DATA_PORT_MASK) >> 8;
+
+    /* The interrupt status is read to clear (HOST_INT_RSR_REG) */
+    card.dn_ld = false;
+
+    memcpy(regs, mp_regs, MIN(len, sizeof(mp_regs)));
+}
+
+/* Copy one packet to the host, padded to the blocks it occupies */
+static t_u32 card_read_packet(struct sim_packet *pkt, t_u8 *buf, t_u32 len)
+{
+    t_u32 size = (pkt->len + MLAN_SDIO_BLOCK_SIZE - 1) / MLAN_SDIO_BLOCK_SIZE * MLAN_SDIO_BLOCK_SIZE;
+
+    size = MIN(size, len);
+    memset(buf, 0, size);
+    memcpy(buf, pkt->data, MIN(pkt->len, size));
+
+    return size;
+}
+
+static int card_read_port(t_u32 port, t_u8 *buf, t_u32 len)
+{
+    t_u32 off = port - SIM_IOPORT;
+    unsigned int count, i;
+    t_u8 first;
+
+    if (off == CTRL_PORT)
+    {
+        if (!card.ctrl_count)
+            return 0;
+        card_read_packet(&card.ctrl[card.ctrl_head], buf, len);
+        card.ctrl_head = (card.ctrl_head + 1) % SIM_CTRL_QUEUE_LEN;
+        card.ctrl_count--;
+        return 1;
+    }
+
+    /* Aggregated read (SDIO_MPA_ADDR_BASE): the ports bitmap counts the ports
+     * from the first one */
+    if (off & SDIO_MPA_ADDR_BASE)
+    {
+        first = off & 0xf;
+        count = __builtin_popcount((off & ~SDIO_MPA_ADDR_BASE) >> 4);
+    }
+    else
+    {
+        first = off & 0xf;
+        count = 1;
+    }
+
+    if (count > card.data_count || card.data[card.data_head].port != first)
+        return 0;
+
+    for (i = 0; i < count && card.data[card.data_head].port; i++)
+    {
+        t_u32 size = card_read_packet(&card.data[card.data_head], buf, len);
+
+        buf += size;
+        len -= size;
+        card.data_head = (card.data_head + 1) % SIM_DATA_QUEUE_LEN;
+        card.data_count--;
+    }
+
+    return i == count;
+}
+
+static t_u8 card_read_reg(int addr)
+{
+    switch (addr)
+    {
+        case CARD_TO_HOST_EVENT_REG:
+            return CARD_IO_READY | DN_LD_CARD_RDY;
+        case READ_BASE_0_REG:
+            return card.ready ? 0 : (SIM_FW_CHUNK_SIZE & 0xff);
+        case READ_BASE_1_REG:
+            return card.ready ? 0 : (SIM_FW_CHUNK_SIZE >> 8);
+        case CARD_FW_STATUS0_REG:
+            return card.ready ? (FIRMWARE_READY & 0xff) : 0;
+        case CARD_FW_STATUS1_REG:
+            return card.ready ? (FIRMWARE_READY >> 8) : 0;
+        case IO_PORT_0_REG:
+            return SIM_IOPORT & 0xff;
+        case IO_PORT_1_REG:
+            return (SIM_IOPORT >> 8) & 0xff;
+        case IO_PORT_2_REG:
+            return (SIM_IOPORT >> 16) & 0xff;
+        case HOST_INT_STATUS_REG:
+            return card_int_status();
+        default:
+            return card.fn1[addr & 0xff];
+    }
+}
+
+int sdio_drv_creg_read(int addr, int fn, uint32_t *resp)
+{
+    UBaseType_t mask = card_lock();
+
+    *resp = fn ? card_read_reg(addr) : card.fn0[addr & 0xff];
+
+    card_unlock(mask);
+
+    return 1;
+}
+
+int sdio_drv_creg_write(int addr, int fn, uint8_t data, uint32_t *resp)
+{
+    UBaseType_t mask = card_lock();
+    bool pending;
+
+    if (fn)
+        card.fn1[addr & 0xff] = data;
+    else
+        card.fn0[addr & 0xff] = data;
+    *resp = data;
+
+    pending = card_int_pending();
+    card_unlock(mask);
+
+    card_raise_int(pending);
+
+    return 1;
+}
+
+int sdio_drv_read(uint32_t addr, uint32_t fn, uint32_t bcnt, uint32_t bsize, uint8_t *buf, uint32_t *resp)
+{
+    t_u32 len = bcnt > 1 ? bcnt * bsize : bsize;
+    UBaseType_t mask;
+    int ret = 1;
+
+    mask = card_lock();
+
+    if (addr == REG_PORT)
+        card_read_mp_regs(buf, len);
+    else if (card.ready && addr >= SIM_IOPORT)
+        ret = card_read_port(addr, buf, len);
+    else
+        ret = 0;
+
+    card_unlock(mask);
+
+    if (!ret)
+        sdio_e("Read of 0x%x failed", addr);
+
+    return ret;
+}
+
+static int card_download(const t_u8 *buf, t_u32 len)
+{
+    if (!card.fw_received)
+    {
+        memcpy(&card.fw_header, buf, MIN(len, sizeof(card.fw_header)));
+        if (card.fw_header.magic != WIFI_SIM_FW_MAGIC || card.fw_header.length < sizeof(card.fw_header))
+        {
+            sdio_e("Not a firmware image of the simulation");
+            return 0;
+        }
+        card.fw_header.version[sizeof(card.fw_header.version) - 1] = '\0';
+    }
+
+    card.fw_received += len;
+
+    /* The last chunk is padded to the block size */
+    if (card.fw_received >= card.fw_header.length)
+        card.ready = true;
+
+    return 1;
+}
+
+int sdio_drv_write(uint32_t addr, uint32_t fn, uint32_t bcnt, uint32_t bsize, uint8_t *buf, uint32_t *resp)
+{
+    t_u32 len = bcnt > 1 ? bcnt * bsize : bsize;
+    t_u32 port = addr - SIM_IOPORT;
+    t_u16 size, type;
+    UBaseType_t mask;
+    bool start = false;
+    bool pending;
+
+    if (addr < SIM_IOPORT || port >= MAX_PORT || len < INTF_HEADER_LEN)
+        return 0;
+
+    mask = card_lock();
+    if (!card.ready)
+    {
+        int ret = card_download(buf, len);
+
+        start = card.ready;
+        card_unlock(mask);
+
+        if (start)
+            wifi_sim_fw_start(&card.fw_header);
+        return ret;
+    }
+    if (port != CTRL_PORT)
+        card.dn_ld = true;
+    pending = card_int_pending();
+    card_unlock(mask);
+
+    card_raise_int(pending);
+
+    size = buf[0] | (buf[1] << 8);
+    type = buf[2] | (buf[3] << 8);
+    /* The firmware takes the size of a command from the command itself: some
+     * are sent with no size in their SDIO header (wlan_set_11n_cfg()) */
+    if (port == CTRL_PORT && type == MLAN_TYPE_CMD && len >= INTF_HEADER_LEN + S_DS_GEN)
+        size = INTF_HEADER_LEN + (buf[INTF_HEADER_LEN + 2] | (buf[INTF_HEADER_LEN + 3] << 8));
+    if (size < INTF_HEADER_LEN || size > len)
+    {
+        sdio_e("Invalid packet size %d on port %d", size, port);
+        return 0;
+    }
+
+    if (port == CTRL_PORT && type == MLAN_TYPE_CMD)
+        wifi_sim_fw_command((const HostCmd_DS_COMMAND *)(buf + INTF_HEADER_LEN), size - INTF_HEADER_LEN);
+    else if (port != CTRL_PORT && type == MLAN_TYPE_DATA)
+        wifi_sim_fw_tx(buf + INTF_HEADER_LEN, size - INTF_HEADER_LEN);
+    else
+        sdio_e("Unexpected packet type %d on port %d", type, port);
+
+    return 1;
+}
+
+void sdio_enable_interrupt(void)
+{
+    UBaseType_t mask = card_lock();
+    bool pending;
+
+    card.int_enabled = true;
+    pending          = card_int_pending();
+    card_unlock(mask);
+
+    card_raise_int(pending);
+}
+
+int sdio_drv_init(void (*cd_int)(int))
+{
+    UBaseType_t mask = card_lock();
+
+    /* Power on: the card waits for its firmware */
+    memset(&card, 0, sizeof(card));
+    card.next_port = 1;
+    card.cd_int    = cd_int;
+
+    card_unlock(mask);
+
+    vPortSetInterruptHandler(BOARD_SDIO_CARD_IRQ, card_int_handler);
+
+    sdio_d("Card initialization successful");
+
+    return WM_SUCCESS;
+}
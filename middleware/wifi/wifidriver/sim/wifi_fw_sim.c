@@ -0,0 +1,651 @@
+/** @file wifi_fw_sim.c
+ *
+ *  @brief This file provides the firmware of the simulated wifi card
+ */
+/*
+ *  Copyright 2026 NXP
+ *
+ *  NXP CONFIDENTIAL
+ *  The source code contained or described herein and all documents related to
+ *  the source code ("Materials") are owned by NXP, its
+ *  suppliers and/or its licensors. Title to the Materials remains with NXP,
+ *  its suppliers and/or its licensors. The Materials contain
+ *  trade secrets and proprietary and confidential information of NXP, its
+ *  suppliers and/or its licensors. The Materials are protected by worldwide copyright
+ *  and trade secret laws and treaty provisions. No part of the Materials may be
+ *  used, copied, reproduced, modified, published, uploaded, posted,
+ *  transmitted, distributed, or disclosed in any way without NXP's prior
+ *  express written permission.
+ *
+ *  No license under any patent, copyright, trade secret or other intellectual
+ *  property right is granted to or conferred upon you by disclosure or delivery
+ *  of the Materials, either expressly, by implication, inducement, estoppel or
+ *  otherwise. Any license under such intellectual property rights must be
+ *  express and approved by NXP in writing.
+ *
+ */
+
+#include <wm_os.h>
+#include <wifi.h>
+#include <wifi_sim.h>
+#include <pthread.h>
+
+#include "wifi_sim_internal.h"
+#include "wifi-sdio.h"
+
+/*
+ * The firmware answers the commands of the driver as the SD8801 firmware
+ * does, for the ones the driver needs the answer of: the hardware
+ * specification and the MAC address at initialization, scans, association
+ * and RSSI. The others are acknowledged with their own parameters.
+ *
+ * The networks are seen by a scan on their channel. The association to a
+ * network always succeeds, and is followed by EVENT_PORT_RELEASE once the
+ * WPA2 passphrase given with HostCmd_CMD_SUPPLICANT_PMK is checked, as the
+ * embedded supplicant would do after the 4-way handshake.
+ */
+
+/** Version of the firmware, and of the firmware image */
+#define SIM_FW_VERSION "w8801-sim-1.0"
+/** Noise floor, in dBm */
+#define SIM_NOISE_FLOOR (-96)
+/** Reason of the deauthentication on a wrong passphrase: 4-way handshake timeout */
+#define SIM_REASON_4WAY_HANDSHAKE_TIMEOUT 15
+
+struct sim_network
+{
+    char ssid[MLAN_MAX_SSID_LENGTH + 1];
+    t_u8 bssid[MLAN_MAC_ADDR_LENGTH];
+    t_u8 channel;
+    int rssi;
+    enum wifi_sim_security security;
+    char passphrase[MLAN_MAX_PASSPHRASE_LENGTH + 1];
+};
+
+static const wifi_sim_fw_header_t fw_header = {
+    .magic   = WIFI_SIM_FW_MAGIC,
+    .length  = sizeof(wifi_sim_fw_header_t),
+    .version = SIM_FW_VERSION,
+};
+
+const uint8_t *const wifi_sim_fw_image = (const uint8_t *)&fw_header;
+const size_t wifi_sim_fw_image_len     = sizeof(fw_header);
+
+static struct
+{
+    struct sim_network networks[WIFI_SIM_MAX_NETWORKS];
+    unsigned int num_networks;
+    t_u8 mac_addr[MLAN_MAC_ADDR_LENGTH];
+    /** Passphrase of the last HostCmd_CMD_SUPPLICANT_PMK */
+    char passphrase[MLAN_MAX_PASSPHRASE_LENGTH + 1];
+    bool pmk_set;
+    /** Network associated to, NULL if none */
+    const struct sim_network *assoc;
+    /** Response being built */
+    t_u8 resp[WIFI_SIM_PORT_SIZE - INTF_HEADER_LEN];
+} fw = {
+    .mac_addr = {0x00, 0x50, 0x43, 0x53, 0x49, 0x4d},
+};
+
+static pthread_mutex_t fw_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* As the card, the firmware is shared with the TAP reader thread */
+static UBaseType_t fw_lock(void)
+{
+    UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+
+    pthread_mutex_lock(&fw_mutex);
+    return mask;
+}
+
+static void fw_unlock(UBaseType_t mask)
+{
+    pthread_mutex_unlock(&fw_mutex);
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+int wifi_sim_add_network(
+    const char *ssid, const uint8_t *bssid, uint8_t channel, int rssi, enum wifi_sim_security security, const char *passphrase)
+{
+    struct sim_network *net;
+    UBaseType_t mask;
+
+    if (!ssid || !bssid || strlen(ssid) == 0 || strlen(ssid) > MLAN_MAX_SSID_LENGTH || channel < 1 || channel > 14 ||
+        rssi >= 0 || rssi < -127)
+        return -WM_E_INVAL;
+
+    if (security == WIFI_SIM_SECURITY_WPA2 &&
+        (!passphrase || strlen(passphrase) < MLAN_MIN_PASSPHRASE_LENGTH || strlen(passphrase) > MLAN_MAX_PASSPHRASE_LENGTH))
+        return -WM_E_INVAL;
+
+    mask = fw_lock();
+
+    if (fw.num_networks == WIFI_SIM_MAX_NETWORKS)
+    {
+        fw_unlock(mask);
+        return -WM_E_NOMEM;
+    }
+
+    net = &fw.networks[fw.num_networks++];
+    memset(net, 0, sizeof(*net));
+    strcpy(net->ssid, ssid);
+    memcpy(net->bssid, bssid, MLAN_MAC_ADDR_LENGTH);
+    net->channel  = channel;
+    net->rssi     = rssi;
+    net->security = security;
+    if (security == WIFI_SIM_SECURITY_WPA2)
+        strcpy(net->passphrase, passphrase);
+
+    fw_unlock(mask);
+
+    return WM_SUCCESS;
+}
+
+static void fw_send_event(t_u16 event_id, t_u16 reason_code)
+{
+    t_u8 evt[2 + 1 + 1 + 2 + MLAN_MAC_ADDR_LENGTH];
+
+    /* As Event_Ext_t, without its SDIO header */
+    memset(evt, 0, sizeof(evt));
+    evt[0] = event_id & 0xff;
+    evt[1] = event_id >> 8;
+    evt[2] = 0; /* bss_index */
+    evt[3] = MLAN_BSS_TYPE_STA;
+    evt[4] = reason_code & 0xff;
+    evt[5] = reason_code >> 8;
+    if (fw.assoc)
+        memcpy(&evt[6], fw.assoc->bssid, MLAN_MAC_ADDR_LENGTH);
+
+    if (wifi_sim_card_upload(MLAN_TYPE_EVENT, evt, sizeof(evt), NULL, 0) != WM_SUCCESS)
+        wsim_e("Event 0x%x lost", event_id);
+}
+
+void wifi_sim_fw_start(const wifi_sim_fw_header_t *header)
+{
+    static const t_u8 open_bssid[] = {0x02, 0x53, 0x49, 0x4d, 0x01, 0x06};
+    static const t_u8 wpa2_bssid[] = {0x02, 0x53, 0x49, 0x4d, 0x02, 0x0b};
+
+    wsim_d("Firmware %s started", header->version);
+
+    if (fw.num_networks == 0)
+    {
+        wifi_sim_add_network("nxp_sim_open", open_bssid, 6, -45, WIFI_SIM_SECURITY_NONE, NULL);
+        wifi_sim_add_network("nxp_sim_wpa2", wpa2_bssid, 11, -60, WIFI_SIM_SECURITY_WPA2, "12345678");
+    }
+
+    fw.assoc   = NULL;
+    fw.pmk_set = false;
+    memset(fw.passphrase, 0, sizeof(fw.passphrase));
+
+    if (wifi_sim_net_start() != WM_SUCCESS)
+        wsim_e("Network start failed");
+}
+
+/* TLVs of a command: calls fn for each one, with its value */
+static void fw_for_each_tlv(const t_u8 *tlv, int len, void (*fn)(t_u16 type, const t_u8 *val, t_u16 val_len, void *arg), void *arg)
+{
+    while (len >= (int)sizeof(MrvlIEtypesHeader_t))
+    {
+        const MrvlIEtypesHeader_t *hdr = (const MrvlIEtypesHeader_t *)tlv;
+        t_u16 type                     = wlan_le16_to_cpu(hdr->type);
+        t_u16 val_len                  = wlan_le16_to_cpu(hdr->len);
+
+        if (sizeof(*hdr) + val_len > (unsigned int)len)
+            break;
+
+        fn(type, tlv + sizeof(*hdr), val_len, arg);
+
+        tlv += sizeof(*hdr) + val_len;
+        len -= sizeof(*hdr) + val_len;
+    }
+}
+
+struct scan_filter
+{
+    bool channels[15];
+    bool any_channel;
+    /** Up to 4 SSIDs, none for any */
+    const char *ssids[4];
+    t_u8 ssid_lens[4];
+    unsigned int num_ssids;
+};
+
+static void scan_filter_tlv(t_u16 type, const t_u8 *val, t_u16 val_len, void *arg)
+{
+    struct scan_filter *filter = arg;
+    unsigned int i;
+
+    switch (type)
+    {
+        case TLV_TYPE_CHANLIST:
+            for (i = 0; i + sizeof(ChanScanParamSet_t) <= val_len; i += sizeof(ChanScanParamSet_t))
+            {
+                const ChanScanParamSet_t *chan = (const ChanScanParamSet_t *)(val + i);
+
+                if (chan->chan_number < sizeof(filter->channels))
+                    filter->channels[chan->chan_number] = true;
+            }
+            filter->any_channel = false;
+            break;
+        case TLV_TYPE_WILDCARDSSID:
+            /* max_ssid_length, then the SSID */
+            if (val_len < 1)
+                break;
+            val++;
+            val_len--;
+            /* Fall through */
+        case TLV_TYPE_SSID:
+            if (val_len && filter->num_ssids < ARRAY_SIZE(filter->ssids))
+            {
+                filter->ssids[filter->num_ssids]     = (const char *)val;
+                filter->ssid_lens[filter->num_ssids] = val_len;
+                filter->num_ssids++;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static bool scan_filter_match(const struct scan_filter *filter, const struct sim_network *net)
+{
+    unsigned int i;
+
+    if (!filter->any_channel && !filter->channels[net->channel])
+        return false;
+    if (!filter->num_ssids)
+        return true;
+
+    for (i = 0; i < filter->num_ssids; i++)
+    {
+        if (filter->ssid_lens[i] == strlen(net->ssid) && !memcmp(filter->ssids[i], net->ssid, filter->ssid_lens[i]))
+            return true;
+    }
+
+    return false;
+}
+
+static t_u8 *put_ie(t_u8 *pos, t_u8 id, const void *data, t_u8 len)
+{
+    pos[0] = id;
+    pos[1] = len;
+    memcpy(pos + 2, data, len);
+
+    return pos + 2 + len;
+}
+
+/* BSS descriptor of a scan response: as a beacon, preceded by its size */
+static t_u8 *put_bss_desc(t_u8 *pos, const struct sim_network *net)
+{
+    static const t_u8 rates[]     = {0x82, 0x84, 0x8b, 0x96, 0x0c, 0x12, 0x18, 0x24};
+    static const t_u8 ext_rates[] = {0x30, 0x48, 0x60, 0x6c};
+    /* CCMP, PSK */
+    static const t_u8 rsn[] = {0x01, 0x00, 0x00, 0x0f, 0xac, 0x04, 0x01, 0x00, 0x00, 0x0f, 0xac,
+                               0x04, 0x01, 0x00, 0x00, 0x0f, 0xac, 0x02, 0x00, 0x00};
+    t_u8 *start = pos;
+    t_u16 cap   = 0x0001; /* ESS */
+    t_u16 beacon_period = wlan_cpu_to_le16(100);
+    t_u16 size;
+
+    if (net->security == WIFI_SIM_SECURITY_WPA2)
+        cap |= 0x0010; /* Privacy */
+    cap = wlan_cpu_to_le16(cap);
+
+    pos += sizeof(t_u16);
+    memcpy(pos, net->bssid, MLAN_MAC_ADDR_LENGTH);
+    pos += MLAN_MAC_ADDR_LENGTH;
+    /* RSSI, as a positive value */
+    *pos++ = (t_u8)(-net->rssi);
+    /* Timestamp */
+    memset(pos, 0, 8);
+    pos += 8;
+    memcpy(pos, &beacon_period, sizeof(beacon_period));
+    pos += sizeof(beacon_period);
+    memcpy(pos, &cap, sizeof(cap));
+    pos += sizeof(cap);
+
+    pos = put_ie(pos, SSID, net->ssid, strlen(net->ssid));
+    pos = put_ie(pos, SUPPORTED_RATES, rates, sizeof(rates));
+    pos = put_ie(pos, DS_PARAM_SET, &net->channel, 1);
+    pos = put_ie(pos, EXTENDED_SUPPORTED_RATES, ext_rates, sizeof(ext_rates));
+    if (net->security == WIFI_SIM_SECURITY_WPA2)
+        pos = put_ie(pos, RSN_IE, rsn, sizeof(rsn));
+
+    size     = wlan_cpu_to_le16(pos - start - sizeof(t_u16));
+    memcpy(start, &size, sizeof(size));
+
+    return pos;
+}
+
+static t_u16 fw_scan(const HostCmd_DS_COMMAND *cmd, HostCmd_DS_COMMAND *resp, t_u16 len)
+{
+    static const t_u8 any_bssid[MLAN_MAC_ADDR_LENGTH];
+    const HostCmd_DS_802_11_SCAN *scan = &cmd->params.scan;
+    HostCmd_DS_802_11_SCAN_RSP *scan_rsp = &resp->params.scan_resp;
+    struct scan_filter filter;
+    t_u8 *pos = scan_rsp->bss_desc_and_tlv_buffer;
+    unsigned int i;
+    t_u8 sets = 0;
+    t_u16 size;
+
+    memset(&filter, 0, sizeof(filter));
+    filter.any_channel = true;
+    fw_for_each_tlv(scan->tlv_buffer, (int)len - (S_DS_GEN + sizeof(scan->bss_mode) + sizeof(scan->bssid)),
+                    scan_filter_tlv, &filter);
+
+    for (i = 0; i < fw.num_networks; i++)
+    {
+        const struct sim_network *net = &fw.networks[i];
+
+        if (!scan_filter_match(&filter, net))
+            continue;
+        if (memcmp(scan->bssid, any_bssid, MLAN_MAC_ADDR_LENGTH) &&
+            memcmp(scan->bssid, net->bssid, MLAN_MAC_ADDR_LENGTH))
+            continue;
+
+        pos = put_bss_desc(pos, net);
+        sets++;
+    }
+
+    size = wlan_cpu_to_le16(pos - scan_rsp->bss_desc_and_tlv_buffer);
+    memcpy(&scan_rsp->bss_descript_size, &size, sizeof(size));
+    scan_rsp->number_of_sets = sets;
+
+    return pos - (t_u8 *)resp;
+}
+
+static void supplicant_pmk_tlv(t_u16 type, const t_u8 *val, t_u16 val_len, void *arg)
+{
+    switch (type)
+    {
+        case TLV_TYPE_PASSPHRASE:
+            memset(fw.passphrase, 0, sizeof(fw.passphrase));
+            memcpy(fw.passphrase, val, MIN(val_len, MLAN_MAX_PASSPHRASE_LENGTH));
+            break;
+        case TLV_TYPE_PMK:
+            /* Without PBKDF2, a PMK is taken as right */
+            fw.pmk_set = true;
+            break;
+        default:
+            break;
+    }
+}
+
+static void fw_supplicant_pmk(const HostCmd_DS_COMMAND *cmd, t_u16 len)
+{
+    const HostCmd_DS_802_11_SUPPLICANT_PMK *pmk = &cmd->params.esupplicant_psk;
+
+    if (wlan_le16_to_cpu(pmk->action) != HostCmd_ACT_GEN_SET)
+        return;
+
+    fw.pmk_set = false;
+    fw_for_each_tlv(pmk->tlv_buffer, (int)len - (S_DS_GEN + sizeof(pmk->action) + sizeof(pmk->cache_result)),
+                    supplicant_pmk_tlv, NULL);
+}
+
+static const struct sim_network *fw_find_network(const t_u8 *bssid)
+{
+    unsigned int i;
+
+    for (i = 0; i < fw.num_networks; i++)
+    {
+        if (!memcmp(fw.networks[i].bssid, bssid, MLAN_MAC_ADDR_LENGTH))
+            return &fw.networks[i];
+    }
+
+    return NULL;
+}
+
+static t_u16 fw_associate(const HostCmd_DS_COMMAND *cmd, HostCmd_DS_COMMAND *resp, t_u16 *event, t_u16 *reason)
+{
+    const struct sim_network *net = fw_find_network(cmd->params.associate.peer_sta_addr);
+    IEEEtypes_AssocRsp_t *assoc_rsp = &resp->params.associate_rsp.assoc_rsp;
+    t_u16 cap    = 0x0001;
+    t_u16 status = 0;
+    t_u16 aid    = wlan_cpu_to_le16(0xc001);
+
+    if (!net)
+    {
+        /* Unspecified failure */
+        status = 1;
+    }
+    else
+    {
+        if (net->security == WIFI_SIM_SECURITY_WPA2)
+            cap |= 0x0010;
+
+        /* The 4-way handshake, on a WPA2 network */
+        if (net->security == WIFI_SIM_SECURITY_NONE || fw.pmk_set || !strcmp(fw.passphrase, net->passphrase))
+        {
+            *event = EVENT_PORT_RELEASE;
+        }
+        else
+        {
+            *event  = EVENT_DEAUTHENTICATED;
+            *reason = SIM_REASON_4WAY_HANDSHAKE_TIMEOUT;
+        }
+        fw.assoc = net;
+    }
+
+    cap    = wlan_cpu_to_le16(cap);
+    status = wlan_cpu_to_le16(status);
+    memcpy(&assoc_rsp->capability, &cap, sizeof(cap));
+    memcpy(&assoc_rsp->status_code, &status, sizeof(status));
+    memcpy(&assoc_rsp->a_id, &aid, sizeof(aid));
+
+    return S_DS_GEN + sizeof(cap) + sizeof(status) + sizeof(aid);
+}
+
+static void fw_rssi_info(HostCmd_DS_COMMAND *resp)
+{
+    HostCmd_DS_802_11_RSSI_INFO_RSP *rssi = &resp->params.rssi_info_rsp;
+    t_s16 rssi_dbm = fw.assoc ? fw.assoc->rssi : 0;
+
+    rssi->ndata          = wlan_cpu_to_le16(1);
+    rssi->nbcn           = wlan_cpu_to_le16(1);
+    rssi->data_rssi_last = wlan_cpu_to_le16(rssi_dbm);
+    rssi->data_nf_last   = wlan_cpu_to_le16(SIM_NOISE_FLOOR);
+    rssi->data_rssi_avg  = rssi->data_rssi_last;
+    rssi->data_nf_avg    = rssi->data_nf_last;
+    rssi->bcn_rssi_last  = rssi->data_rssi_last;
+    rssi->bcn_nf_last    = rssi->data_nf_last;
+    rssi->bcn_rssi_avg   = rssi->data_rssi_last;
+    rssi->bcn_nf_avg     = rssi->data_nf_last;
+    rssi->tsf_bcn        = 0;
+}
+
+void wifi_sim_fw_command(const HostCmd_DS_COMMAND *cmd, t_u16 len)
+{
+    HostCmd_DS_COMMAND *resp = (HostCmd_DS_COMMAND *)fw.resp;
+    t_u16 command, resp_len;
+    t_u16 event  = 0;
+    t_u16 reason = 0;
+    UBaseType_t mask;
+
+    if (len < S_DS_GEN || len > sizeof(fw.resp))
+    {
+        wsim_e("Invalid command size %d", len);
+        return;
+    }
+
+    mask = fw_lock();
+
+    command = wlan_le16_to_cpu(cmd->command);
+    wsim_d("Command 0x%x, size %d", command, len);
+
+    /* By default, the response is the command, with its parameters */
+    memcpy(resp, cmd, len);
+    resp_len = len;
+
+    switch (command)
+    {
+        case HostCmd_CMD_GET_HW_SPEC:
+        {
+            HostCmd_DS_GET_HW_SPEC *hw_spec = &resp->params.hw_spec;
+
+            memset(hw_spec, 0, sizeof(*hw_spec));
+            hw_spec->hw_if_version     = wlan_cpu_to_le16(1);
+            hw_spec->num_of_mcast_adr  = wlan_cpu_to_le16(MLAN_MAX_MULTICAST_LIST_SIZE);
+            memcpy(hw_spec->permanent_addr, fw.mac_addr, MLAN_MAC_ADDR_LENGTH);
+            hw_spec->region_code       = wlan_cpu_to_le16(0x10); /* FCC */
+            hw_spec->number_of_antenna = wlan_cpu_to_le16(1);
+            hw_spec->fw_release_number = wlan_cpu_to_le32(0x0e26000e);
+            /* 802.11 b/g, with 802.11n off */
+            hw_spec->fw_cap_info       = wlan_cpu_to_le32(0x00000300);
+            hw_spec->mp_end_port       = wlan_cpu_to_le16(MAX_PORT);
+            resp_len                   = S_DS_GEN + sizeof(*hw_spec);
+            break;
+        }
+        case HostCmd_CMD_VERSION_EXT:
+        {
+            HostCmd_DS_VERSION_EXT *verext = &resp->params.verext;
+
+            memset(verext->version_str, 0, sizeof(verext->version_str));
+            if (verext->version_str_sel == 0)
+                strcpy(verext->version_str, SIM_FW_VERSION);
+            resp_len = S_DS_GEN + sizeof(*verext);
+            break;
+        }
+        case HostCmd_CMD_802_11_MAC_ADDRESS:
+            if (wlan_le16_to_cpu(cmd->params.mac_addr.action) == HostCmd_ACT_GEN_SET)
+                memcpy(fw.mac_addr, cmd->params.mac_addr.mac_addr, MLAN_MAC_ADDR_LENGTH);
+            else
+                memcpy(resp->params.mac_addr.mac_addr, fw.mac_addr, MLAN_MAC_ADDR_LENGTH);
+            break;
+        case HostCmd_CMD_MAC_REG_ACCESS:
+            if (wlan_le16_to_cpu(cmd->params.mac_reg.action) == HostCmd_ACT_GEN_GET)
+                resp->params.mac_reg.value = 0;
+            break;
+        case HostCmd_CMD_802_11_SCAN:
+            resp_len = fw_scan(cmd, resp, len);
+            break;
+        case HostCmd_CMD_SUPPLICANT_PMK:
+            fw_supplicant_pmk(cmd, len);
+            break;
+        case HostCmd_CMD_802_11_ASSOCIATE:
+            resp_len = fw_associate(cmd, resp, &event, &reason);
+            break;
+        case HostCmd_CMD_802_11_DEAUTHENTICATE:
+            fw.assoc = NULL;
+            break;
+        case HostCmd_CMD_RSSI_INFO:
+            fw_rssi_info(resp);
+            resp_len = S_DS_GEN + sizeof(resp->params.rssi_info_rsp);
+            break;
+        default:
+            break;
+    }
+
+    resp->command = wlan_cpu_to_le16(command | HostCmd_RET_BIT);
+    resp->size    = wlan_cpu_to_le16(resp_len);
+    resp->result  = 0;
+
+    if (wifi_sim_card_upload(MLAN_TYPE_CMD, resp, resp_len, NULL, 0) != WM_SUCCESS)
+        wsim_e("Response to command 0x%x lost", command);
+
+    if (event)
+    {
+        fw_send_event(event, reason);
+        if (event == EVENT_DEAUTHENTICATED)
+            fw.assoc = NULL;
+    }
+
+    fw_unlock(mask);
+}
+
+int wifi_sim_link_loss(void)
+{
+    UBaseType_t mask = fw_lock();
+    int ret          = -WM_FAIL;
+
+    if (fw.assoc)
+    {
+        fw_send_event(EVENT_LINK_LOST, 0);
+        fw.assoc = NULL;
+        ret      = WM_SUCCESS;
+    }
+
+    fw_unlock(mask);
+
+    return ret;
+}
+
+void wifi_sim_fw_tx(const t_u8 *txpd, t_u16 len)
+{
+    const TxPD *tx = (const TxPD *)txpd;
+    t_u16 offset, pkt_len;
+    UBaseType_t mask;
+    bool assoc;
+
+    if (len < sizeof(TxPD))
+        return;
+
+    offset  = wlan_le16_to_cpu(tx->tx_pkt_offset);
+    pkt_len = wlan_le16_to_cpu(tx->tx_pkt_length);
+    if (offset + pkt_len > len)
+    {
+        wsim_e("Invalid TxPD: offset %d length %d", offset, pkt_len);
+        return;
+    }
+
+    /* Only the data frames of the station go on the air */
+    if (tx->bss_type != MLAN_BSS_TYPE_STA || wlan_le16_to_cpu(tx->tx_pkt_type) != 0)
+        return;
+
+    mask  = fw_lock();
+    assoc = fw.assoc != NULL;
+    fw_unlock(mask);
+
+    if (assoc)
+        wifi_sim_net_output(txpd + offset, pkt_len);
+}
+
+int wifi_sim_fw_sta_mac(t_u8 *mac)
+{
+    UBaseType_t mask = fw_lock();
+    int ret          = -WM_FAIL;
+
+    if (fw.assoc)
+    {
+        memcpy(mac, fw.mac_addr, MLAN_MAC_ADDR_LENGTH);
+        ret = WM_SUCCESS;
+    }
+
+    fw_unlock(mask);
+
+    return ret;
+}
+
+int wifi_sim_fw_rx(const t_u8 *frame, t_u16 len)
+{
+    RxPD rxpd;
+    UBaseType_t mask;
+    bool deliver;
+
+    if (len < 2 * MLAN_MAC_ADDR_LENGTH + 2)
+        return -WM_E_INVAL;
+
+    mask = fw_lock();
+    /* Frames to the station, or to a group, while associated */
+    deliver = fw.assoc && ((frame[0] & 0x01) || !memcmp(frame, fw.mac_addr, MLAN_MAC_ADDR_LENGTH)) &&
+              memcmp(frame + MLAN_MAC_ADDR_LENGTH, fw.mac_addr, MLAN_MAC_ADDR_LENGTH);
+
+    memset(&rxpd, 0, sizeof(rxpd));
+    rxpd.bss_type      = MLAN_BSS_TYPE_STA;
+    rxpd.rx_pkt_length = wlan_cpu_to_le16(len);
+    rxpd.rx_pkt_offset = wlan_cpu_to_le16(sizeof(rxpd));
+    rxpd.nf            = -SIM_NOISE_FLOOR;
+    rxpd.snr           = fw.assoc ? fw.assoc->rssi - SIM_NOISE_FLOOR : 0;
+    fw_unlock(mask);
+
+    if (!deliver)
+        return -WM_FAIL;
+
+    if (wifi_sim_card_upload(MLAN_TYPE_DATA, &rxpd, sizeof(rxpd), frame, len) != WM_SUCCESS)
+    {
+        wsim_d("Rx frame dropped");
+        return -WM_E_NOMEM;
+    }
+
+    return WM_SUCCESS;
+}
@@ -0,0 +1,92 @@
+/** @file wifi_sim_internal.h
+ *
+ *  @brief  This file provides the interfaces between the parts of the simulated wifi card
+ */
+/*
+ *  Copyright 2026 NXP
+ *
+ *  NXP CONFIDENTIAL
+ *  The source code contained or described herein and all documents related to
+ *  the source code ("Materials") are owned by NXP, its
+ *  suppliers and/or its licensors. Title to the Materials remains with NXP,
+ *  its suppliers and/or its licensors. The Materials contain
+ *  trade secrets and proprietary and confidential information of NXP, its
+ *  suppliers and/or its licensors. The Materials are protected by worldwide copyright
+ *  and trade secret laws and treaty provisions. No part of the Materials may be
+ *  used, copied, reproduced, modified, published, uploaded, posted,
+ *  transmitted, distributed, or disclosed in any way without NXP's prior
+ *  express written permission.
+ *
+ *  No license under any patent, copyright, trade secret or other intellectual
+ *  property right is granted to or conferred upon you by disclosure or delivery
+ *  of the Materials, either expressly, by implication, inducement, estoppel or
+ *  otherwise. Any license under such intellectual property rights must be
+ *  express and approved by NXP in writing.
+ *
+ */
+
+#ifndef _WIFI_SIM_INTERNAL_H_
+#define _WIFI_SIM_INTERNAL_H_
+
+#include <mlan_api.h>
+#include <wmlog.h>
+
+#define wsim_e(...) wmlog_e("wsim", ##__VA_ARGS__)
+
+#ifdef CONFIG_WIFI_SIM_DEBUG
+#define wsim_d(...) wmlog("wsim", ##__VA_ARGS__)
+#else
+#define wsim_d(...)
+#endif /* CONFIG_WIFI_SIM_DEBUG */
+
+/*
+ * The simulation is made of three parts:
+ * - the card (mlan_sdio_sim.c): the sdio_drv_* API on the registers and the
+ *   ports of an SD8801, and the download of the firmware.
+ * - the firmware (wifi_fw_sim.c): commands, events, simulated networks, and
+ *   the data path between the ports of the card and the network.
+ * - the network (wifi_sim_net.c): a TAP interface or the built-in gateway.
+ *
+ * Commands and transmitted frames are handled in the task that writes them
+ * to the card, and so are the answers of the built-in gateway. The frames
+ * of the TAP interface come from its reader thread, outside FreeRTOS.
+ */
+
+/** Firmware image header: the card is ready when it has received length
+ *  bytes, this header included. */
+#define WIFI_SIM_FW_MAGIC (('W' << 0) | ('S' << 8) | ('I' << 16) | ('M' << 24))
+
+typedef MLAN_PACK_START struct
+{
+    t_u32 magic;
+    t_u32 length;
+    char version[32];
+} MLAN_PACK_END wifi_sim_fw_header_t;
+
+/** Largest packet the card holds in a port */
+#define WIFI_SIM_PORT_SIZE 4096
+
+/** Queue a packet for the host: type is MLAN_TYPE_CMD, MLAN_TYPE_EVENT or
+ *  MLAN_TYPE_DATA, and the packet is head followed by body (body may be
+ *  NULL). Raises the card interrupt. */
+int wifi_sim_card_upload(t_u16 type, const void *head, t_u16 head_len, const void *body, t_u16 body_len);
+
+/** Firmware: the card is ready */
+void wifi_sim_fw_start(const wifi_sim_fw_header_t *header);
+/** Firmware: a command written by the host to the control port */
+void wifi_sim_fw_command(const HostCmd_DS_COMMAND *cmd, t_u16 len);
+/** Firmware: a frame written by the host to a data port, starting with its TxPD */
+void wifi_sim_fw_tx(const t_u8 *txpd, t_u16 len);
+/** Firmware: an Ethernet frame received from the network. Returns
+ *  WM_SUCCESS if it is queued for the host, -WM_FAIL if the station does not
+ *  receive it, -WM_E_NOMEM if the card has no room for it. */
+int wifi_sim_fw_rx(const t_u8 *frame, t_u16 len);
+/** Firmware: the MAC address of the station, -WM_FAIL if not associated */
+int wifi_sim_fw_sta_mac(t_u8 *mac);
+
+/** Network: start the TAP reader thread, or the built-in gateway */
+int wifi_sim_net_start(void);
+/** Network: an Ethernet frame sent by the station */
+void wifi_sim_net_output(const t_u8 *frame, t_u16 len);
+
+#endif /* _WIFI_SIM_INTERNAL_H_ */
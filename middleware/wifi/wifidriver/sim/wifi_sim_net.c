@@ -0,0 +1,537 @@
+/** @file wifi_sim_net.c
+ *
+ *  @brief This file provides the network behind the simulated access points
+ */
+/*
+ *  Copyright 2026 NXP
+ *
+ *  NXP CONFIDENTIAL
+ *  The source code contained or described herein and all documents related to
+ *  the source code ("Materials") are owned by NXP, its
+ *  suppliers and/or its licensors. Title to the Materials remains with NXP,
+ *  its suppliers and/or its licensors. The Materials contain
+ *  trade secrets and proprietary and confidential information of NXP, its
+ *  suppliers and/or its licensors. The Materials are protected by worldwide copyright
+ *  and trade secret laws and treaty provisions. No part of the Materials may be
+ *  used, copied, reproduced, modified, published, uploaded, posted,
+ *  transmitted, distributed, or disclosed in any way without NXP's prior
+ *  express written permission.
+ *
+ *  No license under any patent, copyright, trade secret or other intellectual
+ *  property right is granted to or conferred upon you by disclosure or delivery
+ *  of the Materials, either expressly, by implication, inducement, estoppel or
+ *  otherwise. Any license under such intellectual property rights must be
+ *  express and approved by NXP in writing.
+ *
+ */
+
+#include <wm_os.h>
+#include <wifi_sim.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <net/if.h>
+#include <linux/if_tun.h>
+
+#include "wifi_sim_internal.h"
+
+/*
+ * The frames sent by the station go to a TAP interface of the host if one is
+ * set, which makes the station reachable from the host (and iperf, ping or
+ * a DHCP server run there). Else they go to a gateway built in the
+ * simulation, on WIFI_SIM_GATEWAY_IP/24: it answers ARP requests, ICMP echo
+ * requests and DHCP, and drops the rest, which is enough to get an address
+ * and to measure the transmit path.
+ */
+
+#define SIM_ETH_HLEN 14U
+#define ETH_TYPE_IP 0x0800U
+#define ETH_TYPE_ARP 0x0806U
+#define IP_HLEN 20U
+#define IP_PROTO_ICMP 1U
+#define IP_PROTO_UDP 17U
+#define UDP_HLEN 8U
+#define ICMP_ECHO_REQUEST 8U
+#define ICMP_ECHO_REPLY 0U
+#define DHCP_SERVER_PORT 67U
+#define DHCP_CLIENT_PORT 68U
+/** Fixed part of a DHCP message, up to the magic cookie included */
+#define DHCP_HLEN 240U
+#define DHCP_OPTIONS_LEN 64U
+#define DHCP_DISCOVER 1U
+#define DHCP_OFFER 2U
+#define DHCP_REQUEST 3U
+#define DHCP_ACK 5U
+#define DHCP_LEASE_TIME 86400U
+
+/** Largest frame read from the TAP interface */
+#define SIM_TAP_MTU 2048U
+
+/** Identifier of the echo requests of wifi_sim_rx_check() */
+#define RX_CHECK_ID 0x5243U
+/** Payload of the echo request seq: from 16 to RX_CHECK_MAX_LEN bytes, byte i
+ *  is seq + i */
+#define RX_CHECK_LEN(seq) (16U + ((seq)*97U) % 1400U)
+#define RX_CHECK_MAX_LEN 1415U
+/** Requests not yet echoed, below the receive queues of the station (driver
+ *  ring, tcpip mailbox, pbuf pool) so that none is dropped */
+#define RX_CHECK_WINDOW 16U
+/** Time without a reply after which the check ends */
+#define RX_CHECK_TIMEOUT_MS 200U
+
+static const t_u8 gw_mac[MLAN_MAC_ADDR_LENGTH] = {0x02, 0x53, 0x49, 0x4d, 0x00, 0x01};
+/** WIFI_SIM_GATEWAY_IP, and the address leased to the station */
+static const t_u8 gw_ip[4]      = {192, 168, 10, 1};
+static const t_u8 station_ip[4] = {192, 168, 10, 100};
+
+static int tap_fd = -1;
+static bool net_started;
+
+/* Replies to the echo requests of wifi_sim_rx_check(), written by the task
+ * that transmits them (the tcpip thread) */
+static struct
+{
+    volatile unsigned int echoed;
+    unsigned int next_seq;
+    unsigned int mismatched;
+    t_u32 digest;
+} rx_check;
+
+int wifi_sim_set_tap(const char *ifname)
+{
+    struct ifreq ifr;
+    int fd;
+
+    if (strlen(ifname) >= IFNAMSIZ)
+        return -WM_E_INVAL;
+
+    fd = open("/dev/net/tun", O_RDWR);
+    if (fd < 0)
+    {
+        wsim_e("Can't open /dev/net/tun");
+        return -WM_FAIL;
+    }
+
+    memset(&ifr, 0, sizeof(ifr));
+    ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
+    strcpy(ifr.ifr_name, ifname);
+    if (ioctl(fd, TUNSETIFF, &ifr) < 0)
+    {
+        wsim_e("Can't attach to %s", ifname);
+        close(fd);
+        return -WM_FAIL;
+    }
+
+    if (tap_fd >= 0)
+        close(tap_fd);
+    tap_fd = fd;
+
+    return WM_SUCCESS;
+}
+
+static void *tap_reader(void *arg)
+{
+    static t_u8 frame[SIM_TAP_MTU];
+    ssize_t len;
+
+    (void)arg;
+
+    while ((len = read(tap_fd, frame, sizeof(frame))) >= 0)
+    {
+        if (len > 0)
+            wifi_sim_fw_rx(frame, (t_u16)len);
+    }
+
+    wsim_e("TAP interface closed");
+
+    return NULL;
+}
+
+int wifi_sim_net_start(void)
+{
+    if (net_started || tap_fd < 0)
+        return WM_SUCCESS;
+
+    if (xPortCreateSimulatedDeviceThread(tap_reader, NULL) != pdPASS)
+        return -WM_FAIL;
+
+    net_started = true;
+
+    return WM_SUCCESS;
+}
+
+static t_u16 get_be16(const t_u8 *p)
+{
+    return (t_u16)((p[0] << 8) | p[1]);
+}
+
+static void put_be16(t_u8 *p, t_u16 val)
+{
+    p[0] = val >> 8;
+    p[1] = val & 0xff;
+}
+
+static void put_be32(t_u8 *p, t_u32 val)
+{
+    put_be16(p, val >> 16);
+    put_be16(p + 2, val & 0xffff);
+}
+
+/* Internet checksum (RFC 1071) */
+static t_u16 inet_chksum(const t_u8 *data, unsigned int len)
+{
+    t_u32 sum = 0;
+
+    for (; len > 1; data += 2, len -= 2)
+        sum += get_be16(data);
+    if (len)
+        sum += data[0] << 8;
+    while (sum >> 16)
+        sum = (sum & 0xffff) + (sum >> 16);
+
+    return (t_u16)~sum;
+}
+
+static t_u8 *put_eth(t_u8 *pos, const t_u8 *dst, t_u16 type)
+{
+    memcpy(pos, dst, MLAN_MAC_ADDR_LENGTH);
+    memcpy(pos + MLAN_MAC_ADDR_LENGTH, gw_mac, MLAN_MAC_ADDR_LENGTH);
+    put_be16(pos + 2 * MLAN_MAC_ADDR_LENGTH, type);
+
+    return pos + SIM_ETH_HLEN;
+}
+
+/* IPv4 header from the gateway, of a payload of len bytes */
+static t_u8 *put_ip(t_u8 *pos, const t_u8 *dst, t_u8 proto, t_u16 len)
+{
+    memset(pos, 0, IP_HLEN);
+    pos[0] = 0x45;
+    put_be16(pos + 2, IP_HLEN + len);
+    pos[8] = 64; /* TTL */
+    pos[9] = proto;
+    memcpy(pos + 12, gw_ip, 4);
+    memcpy(pos + 16, dst, 4);
+    put_be16(pos + 10, inet_chksum(pos, IP_HLEN));
+
+    return pos + IP_HLEN;
+}
+
+static void gw_arp(const t_u8 *frame, t_u16 len)
+{
+    const t_u8 *arp = frame + SIM_ETH_HLEN;
+    t_u8 reply[SIM_ETH_HLEN + 28];
+    t_u8 *pos;
+
+    /* Ethernet/IPv4 request for the gateway */
+    if (len < SIM_ETH_HLEN + 28 || get_be16(arp) != 1 || get_be16(arp + 2) != ETH_TYPE_IP || get_be16(arp + 6) != 1 ||
+        memcmp(arp + 24, gw_ip, 4))
+        return;
+
+    pos = put_eth(reply, arp + 8, ETH_TYPE_ARP);
+    memcpy(pos, arp, 6);
+    put_be16(pos + 6, 2);
+    memcpy(pos + 8, gw_mac, MLAN_MAC_ADDR_LENGTH);
+    memcpy(pos + 14, gw_ip, 4);
+    memcpy(pos + 18, arp + 8, 10);
+
+    wifi_sim_fw_rx(reply, sizeof(reply));
+}
+
+/* FNV-1a */
+static t_u32 rx_check_hash(t_u32 hash, const t_u8 *data, unsigned int len)
+{
+    while (len--)
+        hash = (hash ^ *data++) * 16777619U;
+
+    return hash;
+}
+
+static bool rx_check_payload(const t_u8 *data, unsigned int len, t_u16 seq)
+{
+    unsigned int i;
+
+    if (len != RX_CHECK_LEN(seq))
+        return false;
+    for (i = 0; i < len; i++)
+    {
+        if (data[i] != (t_u8)(seq + i))
+            return false;
+    }
+
+    return true;
+}
+
+/* A reply of the station to an echo request of wifi_sim_rx_check() */
+static void rx_check_reply(const t_u8 *icmp, t_u16 icmp_len)
+{
+    t_u16 seq = get_be16(icmp + 6);
+
+    if (seq != rx_check.next_seq || !rx_check_payload(icmp + 8, icmp_len - 8, seq))
+        rx_check.mismatched++;
+    rx_check.next_seq = seq + 1U;
+    rx_check.digest   = rx_check_hash(rx_check.digest, icmp + 4, icmp_len - 4);
+    rx_check.echoed++;
+}
+
+static void gw_icmp(const t_u8 *frame, const t_u8 *ip, const t_u8 *icmp, t_u16 icmp_len)
+{
+    static t_u8 reply[SIM_ETH_HLEN + IP_HLEN + SIM_TAP_MTU];
+    t_u8 *pos;
+
+    if (icmp_len >= 8 && icmp[0] == ICMP_ECHO_REPLY && get_be16(icmp + 4) == RX_CHECK_ID)
+    {
+        rx_check_reply(icmp, icmp_len);
+        return;
+    }
+
+    if (icmp_len < 8 || icmp[0] != ICMP_ECHO_REQUEST || icmp_len > SIM_TAP_MTU)
+        return;
+
+    pos = put_eth(reply, frame + MLAN_MAC_ADDR_LENGTH, ETH_TYPE_IP);
+    pos = put_ip(pos, ip + 12, IP_PROTO_ICMP, icmp_len);
+    memcpy(pos, icmp, icmp_len);
+    pos[0] = ICMP_ECHO_REPLY;
+    put_be16(pos + 2, 0);
+    put_be16(pos + 2, inet_chksum(pos, icmp_len));
+
+    wifi_sim_fw_rx(reply, SIM_ETH_HLEN + IP_HLEN + icmp_len);
+}
+
+/* Message type of a DHCP message, 0 if none */
+static t_u8 dhcp_msg_type(const t_u8 *options, unsigned int len)
+{
+    unsigned int i = 0;
+
+    while (i < len && options[i] != 255)
+    {
+        if (options[i] == 0)
+        {
+            i++;
+            continue;
+        }
+        if (i + 2 > len || i + 2 + options[i + 1] > len)
+            break;
+        if (options[i] == 53 && options[i + 1] == 1)
+            return options[i + 2];
+        i += 2 + options[i + 1];
+    }
+
+    return 0;
+}
+
+static t_u8 *put_option(t_u8 *pos, t_u8 code, const void *data, t_u8 len)
+{
+    pos[0] = code;
+    pos[1] = len;
+    memcpy(pos + 2, data, len);
+
+    return pos + 2 + len;
+}
+
+static void gw_dhcp(const t_u8 *dhcp, t_u16 dhcp_len)
+{
+    static const t_u8 broadcast_mac[MLAN_MAC_ADDR_LENGTH] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+    static const t_u8 broadcast_ip[4]                    = {255, 255, 255, 255};
+    static const t_u8 netmask[4]                         = {255, 255, 255, 0};
+    t_u8 reply[SIM_ETH_HLEN + IP_HLEN + UDP_HLEN + DHCP_HLEN + DHCP_OPTIONS_LEN];
+    t_u8 *ip, *udp, *msg, *pos;
+    t_u8 lease[4];
+    t_u8 type;
+
+    /* BOOTREQUEST from an Ethernet client */
+    if (dhcp_len < DHCP_HLEN || dhcp[0] != 1 || dhcp[1] != 1 || dhcp[2] != MLAN_MAC_ADDR_LENGTH)
+        return;
+
+    switch (dhcp_msg_type(dhcp + DHCP_HLEN, dhcp_len - DHCP_HLEN))
+    {
+        case DHCP_DISCOVER:
+            type = DHCP_OFFER;
+            break;
+        case DHCP_REQUEST:
+            type = DHCP_ACK;
+            break;
+        default:
+            return;
+    }
+
+    memset(reply, 0, sizeof(reply));
+    ip  = put_eth(reply, broadcast_mac, ETH_TYPE_IP);
+    udp = ip + IP_HLEN;
+    msg = udp + UDP_HLEN;
+
+    /* BOOTREPLY: xid and chaddr of the request, yiaddr and siaddr */
+    msg[0] = 2;
+    msg[1] = 1;
+    msg[2] = MLAN_MAC_ADDR_LENGTH;
+    memcpy(msg + 4, dhcp + 4, 4);
+    memcpy(msg + 10, dhcp + 10, 2);
+    memcpy(msg + 16, station_ip, 4);
+    memcpy(msg + 20, gw_ip, 4);
+    memcpy(msg + 28, dhcp + 28, 16);
+    memcpy(msg + 236, dhcp + 236, 4);
+
+    put_be32(lease, DHCP_LEASE_TIME);
+    pos = msg + DHCP_HLEN;
+    pos = put_option(pos, 53, &type, 1);
+    pos = put_option(pos, 54, gw_ip, 4);
+    pos = put_option(pos, 51, lease, 4);
+    pos = put_option(pos, 1, netmask, 4);
+    pos = put_option(pos, 3, gw_ip, 4);
+    pos = put_option(pos, 6, gw_ip, 4);
+    *pos++ = 255;
+
+    /* UDP, without checksum */
+    put_be16(udp, DHCP_SERVER_PORT);
+    put_be16(udp + 2, DHCP_CLIENT_PORT);
+    put_be16(udp + 4, pos - udp);
+    put_ip(ip, broadcast_ip, IP_PROTO_UDP, pos - udp);
+
+    wifi_sim_fw_rx(reply, pos - reply);
+}
+
+static void gw_ip_input(const t_u8 *frame, t_u16 len)
+{
+    const t_u8 *ip = frame + SIM_ETH_HLEN;
+    unsigned int hlen;
+    t_u16 total;
+
+    if (len < SIM_ETH_HLEN + IP_HLEN || (ip[0] >> 4) != 4)
+        return;
+
+    hlen  = (ip[0] & 0xf) * 4;
+    total = get_be16(ip + 2);
+    if (hlen < IP_HLEN || total < hlen || SIM_ETH_HLEN + total > len)
+        return;
+
+    if (ip[9] == IP_PROTO_ICMP && !memcmp(ip + 16, gw_ip, 4))
+        gw_icmp(frame, ip, ip + hlen, total - hlen);
+    else if (ip[9] == IP_PROTO_UDP && total >= hlen + UDP_HLEN && get_be16(ip + hlen + 2) == DHCP_SERVER_PORT)
+        gw_dhcp(ip + hlen + UDP_HLEN, total - hlen - UDP_HLEN);
+}
+
+void wifi_sim_net_output(const t_u8 *frame, t_u16 len)
+{
+    if (tap_fd >= 0)
+    {
+        if (write(tap_fd, frame, len) != len)
+            wsim_d("Tx frame dropped");
+        return;
+    }
+
+    if (len < SIM_ETH_HLEN)
+        return;
+
+    switch (get_be16(frame + 2 * MLAN_MAC_ADDR_LENGTH))
+    {
+        case ETH_TYPE_ARP:
+            gw_arp(frame, len);
+            break;
+        case ETH_TYPE_IP:
+            gw_ip_input(frame, len);
+            break;
+        default:
+            break;
+    }
+}
+
+/* Let the station run for a tick, the scheduler being suspended */
+static void rx_check_yield(void)
+{
+    (void)xTaskResumeAll();
+    os_thread_sleep(1);
+    vTaskSuspendAll();
+}
+
+/* Queue the frame of the request seq for the station, once fewer than
+ * RX_CHECK_WINDOW requests wait for their reply and the card has room. The
+ * scheduler is kept suspended in between, so that the driver reads the frames
+ * in bursts instead of one per interrupt: this is what exercises a receive
+ * ring. */
+static int rx_check_send(const t_u8 *frame, t_u16 len, unsigned int seq)
+{
+    unsigned int echoed = rx_check.echoed;
+    unsigned int idle   = 0;
+    int ret;
+
+    while (seq - rx_check.echoed >= RX_CHECK_WINDOW)
+    {
+        if (rx_check.echoed != echoed)
+        {
+            echoed = rx_check.echoed;
+            idle   = 0;
+        }
+        else if (++idle > os_msec_to_ticks(RX_CHECK_TIMEOUT_MS))
+            return -WM_FAIL;
+        rx_check_yield();
+    }
+
+    while ((ret = wifi_sim_fw_rx(frame, len)) == -WM_E_NOMEM)
+        rx_check_yield();
+
+    return ret;
+}
+
+int wifi_sim_rx_check(unsigned int count, struct wifi_sim_rx_check *result)
+{
+    static t_u8 frame[SIM_ETH_HLEN + IP_HLEN + 8 + RX_CHECK_MAX_LEN];
+    t_u8 sta_mac[MLAN_MAC_ADDR_LENGTH];
+    unsigned int seq, i, echoed;
+    t_u8 *icmp, *pos;
+
+    if (tap_fd >= 0 || count > 0x10000U || wifi_sim_fw_sta_mac(sta_mac) != WM_SUCCESS)
+        return -WM_FAIL;
+
+    memset(&rx_check, 0, sizeof(rx_check));
+    rx_check.digest = 2166136261U;
+
+    /* ARP request for the station first, so that it knows the gateway */
+    pos = put_eth(frame, sta_mac, ETH_TYPE_ARP);
+    put_be16(pos, 1);
+    put_be16(pos + 2, ETH_TYPE_IP);
+    pos[4] = MLAN_MAC_ADDR_LENGTH;
+    pos[5] = 4;
+    put_be16(pos + 6, 1);
+    memcpy(pos + 8, gw_mac, MLAN_MAC_ADDR_LENGTH);
+    memcpy(pos + 14, gw_ip, 4);
+    memset(pos + 18, 0, MLAN_MAC_ADDR_LENGTH);
+    memcpy(pos + 24, station_ip, 4);
+    vTaskSuspendAll();
+    if (rx_check_send(frame, SIM_ETH_HLEN + 28, 0) != WM_SUCCESS)
+    {
+        (void)xTaskResumeAll();
+        return -WM_FAIL;
+    }
+
+    for (seq = 0; seq < count; seq++)
+    {
+        t_u16 len = 8 + RX_CHECK_LEN(seq);
+
+        icmp = put_ip(put_eth(frame, sta_mac, ETH_TYPE_IP), station_ip, IP_PROTO_ICMP, len);
+        icmp[0] = ICMP_ECHO_REQUEST;
+        icmp[1] = 0;
+        put_be16(icmp + 2, 0);
+        put_be16(icmp + 4, RX_CHECK_ID);
+        put_be16(icmp + 6, seq);
+        for (i = 8; i < len; i++)
+            icmp[i] = (t_u8)(seq + i - 8);
+        put_be16(icmp + 2, inet_chksum(icmp, len));
+
+        if (rx_check_send(frame, SIM_ETH_HLEN + IP_HLEN + len, seq) != WM_SUCCESS)
+            break;
+    }
+    (void)xTaskResumeAll();
+
+    /* until all the replies are in, or none comes any more */
+    do
+    {
+        echoed = rx_check.echoed;
+        os_thread_sleep(os_msec_to_ticks(RX_CHECK_TIMEOUT_MS));
+    } while (rx_check.echoed != echoed && rx_check.echoed < seq);
+
+    result->sent       = seq;
+    result->echoed     = rx_check.echoed;
+    result->mismatched = rx_check.mismatched;
+    result->digest     = rx_check.digest;
+
+    return WM_SUCCESS;
+}
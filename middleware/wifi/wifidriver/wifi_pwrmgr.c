@@ -114,12 +114,12 @@ int wifi_send_hs_cfg_cmd(mlan_bss_type interface, t_u32 ipv4_addr, t_u16 action,
     mlan_status status = wlan_ops_sta_prepare_cmd((mlan_private *)mlan_adap->priv[0], HostCmd_CMD_802_11_HS_CFG_ENH,
                                                   HostCmd_ACT_GEN_SET, 0, NULL, pdata_buf, cmd);
     /* Construct the ARP filter TLV */
-    arpfilter       = (arpfilter_header *)((uint32_t)cmd + cmd->size);
+    arpfilter       = (arpfilter_header *)((t_u8 *)cmd + cmd->size);
     arpfilter->type = TLV_TYPE_ARP_FILTER;
 
     if (ipv4_addr)
     {
-        entry            = (filter_entry *)((uint32_t)arpfilter + sizeof(arpfilter_header));
+        entry            = (filter_entry *)((t_u8 *)arpfilter + sizeof(arpfilter_header));
         entry->addr_type = ADDR_TYPE_MULTICAST;
         entry->eth_type  = ETHER_TYPE_ANY;
         entry->ipv4_addr = IPV4_ADDR_ANY;
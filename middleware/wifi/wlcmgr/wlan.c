@@ -2794,7 +2794,7 @@ static void cm_main(os_thread_arg_t data)
  * WLAN API
  */
 
-static int send_user_request(enum user_request_type request, int data)
+static int send_user_request(enum user_request_type request, intptr_t data)
 {
     struct wifi_message msg;
 
@@ -3669,7 +3669,7 @@ int wlan_scan_with_opt(wlan_scan_params_v2_t t_wlan_scan_param)
     wlcm_d("got the scan lock (user scan)");
     wlan.is_scan_lock = 1;
 
-    ret = send_user_request(CM_STA_USER_REQUEST_SCAN, (int) wlan_scan_param);
+    ret = send_user_request(CM_STA_USER_REQUEST_SCAN, (intptr_t) wlan_scan_param);
 
     if (ret != WM_SUCCESS)
         os_mem_free(wlan_scan_param);
@@ -969,6 +969,30 @@ static void test_wlan_get_uap_sta_list(int argc, char ** argv)
     os_mem_free(sl);
 }
 
+#ifdef CONFIG_OS_RWLOCK_STATS
+/* Power save lock, taken by every transmitted packet (wlan.c) */
+extern os_rw_lock_t ps_rwlock;
+
+static void test_wlan_ps_lock_stats(int argc, char ** argv)
+{
+    os_rwlock_stats_t stats;
+    bool reset = (argc == 2 && string_equal(argv[1], "reset"));
+
+    if (argc > 2 || (argc == 2 && !reset))
+    {
+        PRINTF("Usage: %s [reset]\r\n", argv[0]);
+        return;
+    }
+
+    os_rwlock_get_stats(&ps_rwlock, &stats, reset);
+    PRINTF("Power save lock:\r\n");
+    PRINTF("\treader: %u fast, %u slow, %u timed out\r\n", (unsigned int) stats.read_fast,
+           (unsigned int) stats.read_slow, (unsigned int) stats.read_fail);
+    PRINTF("\twriter: %u taken, %u waited for readers, %u timed out\r\n", (unsigned int) stats.write,
+           (unsigned int) stats.write_wait, (unsigned int) stats.write_fail);
+}
+#endif
+
 static struct cli_command tests[] = {
     { "wlan-scan", NULL, test_wlan_scan },
     { "wlan-scan-opt", "ssid <ssid> bssid ...", test_wlan_scan_opt },
@@ -984,6 +1008,9 @@ static struct cli_command tests[] = {
     { "wlan-address", NULL, test_wlan_address },
     { "wlan-get-uap-channel", NULL, test_wlan_get_uap_channel },
     { "wlan-get-uap-sta-list", NULL, test_wlan_get_uap_sta_list },
+#ifdef CONFIG_OS_RWLOCK_STATS
+    { "wlan-ps-lock-stats", "[reset]", test_wlan_ps_lock_stats },
+#endif
 };
 
 /* Register our commands with the MTF. */
@@ -138,6 +138,29 @@ typedef struct xHeapStats
 	size_t xNumberOfSuccessfulFrees;		/* The number of calls to vPortFree() that has successfully freed a block of memory. */
 } HeapStats_t;
 
+/* Used to pass information about the allocations of a tag out of
+vPortGetHeapTagStats(), heap_6.c.  The sizes are those of the blocks, the block
+headers and the alignment included. */
+typedef struct xHeapTagStats
+{
+	size_t xCurrentBytes;					/* The bytes of the blocks allocated with the tag and not freed yet. */
+	size_t xPeakBytes;						/* The maximum of xCurrentBytes since the system booted. */
+	size_t xNumberOfAllocations;			/* The number of successful allocations with the tag. */
+	size_t xNumberOfFrees;					/* The number of frees of blocks allocated with the tag. */
+	size_t xNumberOfFailedAllocations;		/* The number of allocations with the tag that have returned NULL. */
+} HeapTagStats_t;
+
+/* Used to pass information about the bins of small blocks out of
+vPortGetHeapBinStats(), heap_6.c. */
+typedef struct xHeapBinStats
+{
+	size_t xBinnedBytes;					/* The bytes of the free blocks held in the bins, counted in the free heap space. */
+	size_t xNumberOfBinnedBlocks;			/* The number of free blocks held in the bins. */
+	size_t xNumberOfBinHits;				/* The number of small allocations taken from a bin. */
+	size_t xNumberOfBinMisses;				/* The number of small allocations that found their bin empty. */
+	size_t xNumberOfBinFlushes;				/* The number of times the bins have been returned to the list of free blocks. */
+} HeapBinStats_t;
+
 /*
  * Used to define multiple heap regions for use by heap_5.c.  This function
  * must be called before any calls to pvPortMalloc() - not creating a task,
@@ -157,6 +180,24 @@ void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEG
  */
 void vPortGetHeapStats( HeapStats_t *pxHeapStats );
 
+/*
+ * heap_6.c: allocates as pvPortMalloc(), and accounts the block under the tag
+ * uxTag, 0 to configHEAP_TAG_COUNT - 1.  pvPortMalloc() allocates with tag 0.
+ */
+void *pvPortMallocTagged( size_t xSize, UBaseType_t uxTag ) PRIVILEGED_FUNCTION;
+
+/*
+ * heap_6.c: returns a HeapTagStats_t structure filled with the accounting of
+ * the tag uxTag.
+ */
+void vPortGetHeapTagStats( UBaseType_t uxTag, HeapTagStats_t *pxHeapTagStats );
+
+/*
+ * heap_6.c: returns a HeapBinStats_t structure filled with information about
+ * the bins of small blocks.
+ */
+void vPortGetHeapBinStats( HeapBinStats_t *pxHeapBinStats );
+
 /*
  * Map to the memory management routines required for the port.
  */
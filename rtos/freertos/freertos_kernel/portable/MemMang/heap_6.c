@@ -0,0 +1,852 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ * Copyright 2026 NXP
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() derived from
+ * heap_4.c, for a heap shared by many small and short lived allocations - the
+ * TCP/IP stack, the TLS library and a network driver, for example.
+ *
+ * - The blocks of up to configHEAP_BIN_MAX_SIZE bytes are freed to a bin per
+ *   size class, a list of the free blocks of that exact size, and allocated
+ *   from it: in constant time, in a short critical section, without searching
+ *   the list of free blocks.  A small block is allocated as a large one when
+ *   its bin is empty.
+ * - The larger blocks are allocated from the list of free blocks, in address
+ *   order, and coalesced with their neighbours when they are freed, as
+ *   heap_4.c does.  When no free block is large enough, the blocks of the bins
+ *   are coalesced back into the list and the list is searched again.
+ * - As heap_5.c, the heap can span several memory regions, see
+ *   vPortDefineHeapRegions().  Without configHEAP_USE_REGIONS, the heap is the
+ *   ucHeap array, as in heap_4.c.
+ * - pvPortMallocTagged() tags the allocation with the caller, and the heap
+ *   accounts the bytes in use, their peak and the allocations of every tag,
+ *   see vPortGetHeapTagStats().  pvPortMalloc() allocates with tag 0.
+ *
+ * Configuration, in FreeRTOSConfig.h:
+ *
+ * configHEAP_BIN_MAX_SIZE - largest allocation, in bytes, served by the bins,
+ * 0 for none.  256 by default.
+ *
+ * configHEAP_TAG_COUNT - number of tags, 1 to 16.  1 by default.
+ *
+ * configHEAP_USE_REGIONS - 1 if the application defines the heap with
+ * vPortDefineHeapRegions() before the first allocation, 0 (the default) for the
+ * ucHeap array of configTOTAL_HEAP_SIZE bytes.
+ *
+ * Set configFRTOS_MEMORY_SCHEME to 6 with this file.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of http://www.FreeRTOS.org
+ * for more information.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_BIN_MAX_SIZE
+	#define configHEAP_BIN_MAX_SIZE		256
+#endif
+
+#ifndef configHEAP_TAG_COUNT
+	#define configHEAP_TAG_COUNT		1
+#endif
+
+#ifndef configHEAP_USE_REGIONS
+	#define configHEAP_USE_REGIONS		0
+#endif
+
+#if( ( configHEAP_TAG_COUNT < 1 ) || ( configHEAP_TAG_COUNT > 16 ) )
+	#error configHEAP_TAG_COUNT must be 1 to 16
+#endif
+
+/* The allocations are traced with the size asked for and their tag, the frees
+with the size of the block and its tag.  traceMALLOC() and traceFREE() are used
+when these are not defined. */
+#ifndef traceHEAP_MALLOC
+	#define traceHEAP_MALLOC( pvAddress, xSize, uxTag ) traceMALLOC( pvAddress, xSize )
+#endif
+
+#ifndef traceHEAP_FREE
+	#define traceHEAP_FREE( pvAddress, xBlockSize, uxTag ) traceFREE( pvAddress, xBlockSize )
+#endif
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE		( ( size_t ) 8 )
+
+/* The top bit of the xBlockSize member of an allocated block is set, the tag
+of the block is held in the 4 bits below it, and the size in the other bits. */
+#define heapTAG_BITS					( ( size_t ) 4 )
+#define heapBLOCK_ALLOCATED_BITMASK		( ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 ) )
+#define heapTAG_SHIFT					( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 - heapTAG_BITS )
+#define heapTAG_BITMASK					( ( ( ( ( size_t ) 1 ) << heapTAG_BITS ) - 1 ) << heapTAG_SHIFT )
+#define heapSIZE_BITMASK				( ~( heapBLOCK_ALLOCATED_BITMASK | heapTAG_BITMASK ) )
+
+/* Allocate the memory for the heap. */
+#if( configHEAP_USE_REGIONS == 0 )
+	#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+		/* The application writer has already defined the array used for the RTOS
+		heap - probably so it can be placed in a special segment or address. */
+		extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+	#else
+		static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+	#endif /* configAPPLICATION_ALLOCATED_HEAP */
+#endif /* configHEAP_USE_REGIONS */
+
+/* Define the linked list structure.  This is used to link free blocks in order
+of their memory address, and the free blocks of a bin. */
+typedef struct A_BLOCK_LINK
+{
+	struct A_BLOCK_LINK *pxNextFreeBlock;	/*<< The next free block in the list. */
+	size_t xBlockSize;						/*<< The size of the free block. */
+} BlockLink_t;
+
+/* The size of the structure placed at the beginning of each allocated memory
+block must by correctly byte aligned. */
+#define heapSTRUCT_SIZE			( ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* Block sizes must not get too small. */
+#define heapMINIMUM_BLOCK_SIZE	( ( size_t ) ( heapSTRUCT_SIZE << 1 ) )
+
+/* Bin n holds the free blocks of n * portBYTE_ALIGNMENT bytes, the header
+included.  The blocks of configHEAP_BIN_MAX_SIZE bytes or less, once the header
+is added, go to the bins. */
+#define heapBIN_MAX_BLOCK_SIZE	( ( heapSTRUCT_SIZE + ( size_t ) configHEAP_BIN_MAX_SIZE + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+#define heapBIN_COUNT			( ( heapBIN_MAX_BLOCK_SIZE / portBYTE_ALIGNMENT ) + 1 )
+#define heapBIN_INDEX( xBlockSize )	( ( xBlockSize ) / portBYTE_ALIGNMENT )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Inserts a block of memory that is being freed into the correct position in
+ * the list of free memory blocks.  The block being freed will be merged with
+ * the block in front it and/or the block behind it if the memory blocks are
+ * adjacent to each other.
+ */
+static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert );
+
+/*
+ * Takes a block of at least xBlockSize bytes out of the list of free blocks,
+ * the first one found from the lowest address, and splits it if it is larger
+ * than required.  Returns NULL if no block is large enough.
+ */
+static BlockLink_t *prvTakeBlockFromFreeList( size_t xBlockSize );
+
+/*
+ * Returns the blocks of the bins to the list of free blocks, where they are
+ * coalesced with their neighbours.
+ */
+static void prvFlushBins( void );
+
+/*
+ * Account a free block of xBlockSize bytes as allocated, with tag uxTag, or an
+ * allocated block as free.
+ */
+static void prvBlockAllocated( BlockLink_t *pxBlock, UBaseType_t uxTag );
+static void prvBlockFreed( size_t xBlockSize, UBaseType_t uxTag );
+
+/*
+ * Called automatically to setup the heap in the ucHeap array the first time
+ * pvPortMalloc() is called, unless the application defines the heap regions.
+ */
+#if( configHEAP_USE_REGIONS == 0 )
+	static void prvHeapInit( void );
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* Create a couple of list links to mark the start and end of the list. */
+static BlockLink_t xStart, *pxEnd = NULL;
+
+/* The free blocks of the bins, a list per size class. */
+static BlockLink_t *pxBins[ heapBIN_COUNT ];
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+number of free bytes remaining, those of the bins included, but says nothing
+about fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+
+static HeapBinStats_t xBinStats;
+static HeapTagStats_t xTagStats[ configHEAP_TAG_COUNT ];
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMallocTagged( size_t xWantedSize, UBaseType_t uxTag )
+{
+BlockLink_t *pxBlock = NULL;
+void *pvReturn = NULL;
+size_t xBlockSize = 0;
+
+	configASSERT( uxTag < configHEAP_TAG_COUNT );
+	if( uxTag >= configHEAP_TAG_COUNT )
+	{
+		uxTag = 0;
+	}
+
+	/* The wanted size is increased so it can contain a BlockLink_t structure
+	in addition to the requested amount of bytes, and rounded up so that
+	blocks are always aligned to the required number of bytes.  The size must
+	leave the allocated bit and the tag bits clear. */
+	if( ( xWantedSize > 0 ) && ( xWantedSize <= ( heapSIZE_BITMASK - heapSTRUCT_SIZE - portBYTE_ALIGNMENT ) ) )
+	{
+		xBlockSize = ( xWantedSize + heapSTRUCT_SIZE + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* A small block is taken from its bin, if the bin is not empty.  The bins
+	are only accessed with the scheduler suspended or in a critical section,
+	by tasks, so the critical section is enough here. */
+	if( ( xBlockSize != 0 ) && ( xBlockSize <= heapBIN_MAX_BLOCK_SIZE ) )
+	{
+		taskENTER_CRITICAL();
+		{
+			pxBlock = pxBins[ heapBIN_INDEX( xBlockSize ) ];
+
+			if( pxBlock != NULL )
+			{
+				pxBins[ heapBIN_INDEX( xBlockSize ) ] = pxBlock->pxNextFreeBlock;
+				xBinStats.xBinnedBytes -= xBlockSize;
+				xBinStats.xNumberOfBinnedBlocks--;
+				xBinStats.xNumberOfBinHits++;
+
+				prvBlockAllocated( pxBlock, uxTag );
+				pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + heapSTRUCT_SIZE );
+				traceHEAP_MALLOC( pvReturn, xWantedSize, uxTag );
+			}
+			else
+			{
+				xBinStats.xNumberOfBinMisses++;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pvReturn == NULL )
+	{
+		vTaskSuspendAll();
+		{
+			/* If this is the first call to malloc then the heap will require
+			initialisation to setup the list of free blocks. */
+			#if( configHEAP_USE_REGIONS == 0 )
+			{
+				if( pxEnd == NULL )
+				{
+					prvHeapInit();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#else
+			{
+				/* vPortDefineHeapRegions() must be called before the first call
+				to pvPortMalloc(). */
+				configASSERT( pxEnd );
+			}
+			#endif
+
+			if( ( xBlockSize != 0 ) && ( xBlockSize <= xFreeBytesRemaining ) )
+			{
+				pxBlock = prvTakeBlockFromFreeList( xBlockSize );
+
+				/* The free bytes may be in the bins: coalesce them and search
+				again. */
+				if( ( pxBlock == NULL ) && ( xBinStats.xNumberOfBinnedBlocks != 0 ) )
+				{
+					prvFlushBins();
+					pxBlock = prvTakeBlockFromFreeList( xBlockSize );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( pxBlock != NULL )
+				{
+					prvBlockAllocated( pxBlock, uxTag );
+					pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + heapSTRUCT_SIZE );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( pvReturn == NULL )
+			{
+				xTagStats[ uxTag ].xNumberOfFailedAllocations++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			traceHEAP_MALLOC( pvReturn, xWantedSize, uxTag );
+		}
+		( void ) xTaskResumeAll();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+	return pvPortMallocTagged( xWantedSize, 0 );
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+uint8_t *puc = ( uint8_t * ) pv;
+BlockLink_t *pxLink;
+size_t xBlockSize;
+UBaseType_t uxTag;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have an BlockLink_t structure immediately
+		before it. */
+		puc -= heapSTRUCT_SIZE;
+
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxLink = ( void * ) puc;
+
+		/* Check the block is actually allocated. */
+		configASSERT( ( pxLink->xBlockSize & heapBLOCK_ALLOCATED_BITMASK ) != 0 );
+		configASSERT( pxLink->pxNextFreeBlock == NULL );
+
+		if( ( pxLink->xBlockSize & heapBLOCK_ALLOCATED_BITMASK ) != 0 )
+		{
+			if( pxLink->pxNextFreeBlock == NULL )
+			{
+				/* The block is being returned to the heap - it is no longer
+				allocated, and has no tag. */
+				xBlockSize = pxLink->xBlockSize & heapSIZE_BITMASK;
+				uxTag = ( UBaseType_t ) ( ( pxLink->xBlockSize & heapTAG_BITMASK ) >> heapTAG_SHIFT );
+				pxLink->xBlockSize = xBlockSize;
+
+				if( xBlockSize <= heapBIN_MAX_BLOCK_SIZE )
+				{
+					/* A small block goes to its bin. */
+					taskENTER_CRITICAL();
+					{
+						pxLink->pxNextFreeBlock = pxBins[ heapBIN_INDEX( xBlockSize ) ];
+						pxBins[ heapBIN_INDEX( xBlockSize ) ] = pxLink;
+						xBinStats.xBinnedBytes += xBlockSize;
+						xBinStats.xNumberOfBinnedBlocks++;
+
+						prvBlockFreed( xBlockSize, uxTag );
+						traceHEAP_FREE( pv, xBlockSize, uxTag );
+					}
+					taskEXIT_CRITICAL();
+				}
+				else
+				{
+					vTaskSuspendAll();
+					{
+						/* Add this block to the list of free blocks. */
+						prvBlockFreed( xBlockSize, uxTag );
+						traceHEAP_FREE( pv, xBlockSize, uxTag );
+						prvInsertBlockIntoFreeList( pxLink );
+					}
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+static void prvBlockAllocated( BlockLink_t *pxBlock, UBaseType_t uxTag )
+{
+HeapTagStats_t *pxTagStats = &( xTagStats[ uxTag ] );
+
+	xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+	if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+	{
+		xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxTagStats->xCurrentBytes += pxBlock->xBlockSize;
+
+	if( pxTagStats->xCurrentBytes > pxTagStats->xPeakBytes )
+	{
+		pxTagStats->xPeakBytes = pxTagStats->xCurrentBytes;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxTagStats->xNumberOfAllocations++;
+	xNumberOfSuccessfulAllocations++;
+
+	/* The block is being returned - it is allocated and owned by the
+	application, carries its tag, and has no "next" block. */
+	pxBlock->xBlockSize |= heapBLOCK_ALLOCATED_BITMASK | ( ( ( size_t ) uxTag ) << heapTAG_SHIFT );
+	pxBlock->pxNextFreeBlock = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBlockFreed( size_t xBlockSize, UBaseType_t uxTag )
+{
+	xFreeBytesRemaining += xBlockSize;
+	xTagStats[ uxTag ].xCurrentBytes -= xBlockSize;
+	xTagStats[ uxTag ].xNumberOfFrees++;
+	xNumberOfSuccessfulFrees++;
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t *prvTakeBlockFromFreeList( size_t xBlockSize )
+{
+BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
+
+	/* Traverse the list from the start	(lowest address) block until one of
+	adequate size is found. */
+	pxPreviousBlock = &xStart;
+	pxBlock = xStart.pxNextFreeBlock;
+	while( ( pxBlock->xBlockSize < xBlockSize ) && ( pxBlock->pxNextFreeBlock != NULL ) )
+	{
+		pxPreviousBlock = pxBlock;
+		pxBlock = pxBlock->pxNextFreeBlock;
+	}
+
+	/* If the end marker was reached then a block of adequate size was not
+	found. */
+	if( pxBlock == pxEnd )
+	{
+		return NULL;
+	}
+
+	/* This block is being returned for use so must be taken out of the list of
+	free blocks. */
+	pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+	/* If the block is larger than required it can be split into two. */
+	if( ( pxBlock->xBlockSize - xBlockSize ) > heapMINIMUM_BLOCK_SIZE )
+	{
+		/* This block is to be split into two.  Create a new block following
+		the number of bytes requested. The void cast is used to prevent byte
+		alignment warnings from the compiler. */
+		pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xBlockSize );
+		configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+		/* Calculate the sizes of two blocks split from the single block. */
+		pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xBlockSize;
+		pxBlock->xBlockSize = xBlockSize;
+
+		/* Insert the new block into the list of free blocks. */
+		prvInsertBlockIntoFreeList( pxNewBlockLink );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvFlushBins( void )
+{
+BlockLink_t *pxBlock;
+size_t xBin;
+
+	/* Called with the scheduler suspended: no task uses the bins meanwhile. */
+	for( xBin = 0; xBin < heapBIN_COUNT; xBin++ )
+	{
+		while( pxBins[ xBin ] != NULL )
+		{
+			pxBlock = pxBins[ xBin ];
+			pxBins[ xBin ] = pxBlock->pxNextFreeBlock;
+			prvInsertBlockIntoFreeList( pxBlock );
+		}
+	}
+
+	xBinStats.xBinnedBytes = 0;
+	xBinStats.xNumberOfBinnedBlocks = 0;
+	xBinStats.xNumberOfBinFlushes++;
+}
+/*-----------------------------------------------------------*/
+
+#if( configHEAP_USE_REGIONS == 0 )
+
+	static void prvHeapInit( void )
+	{
+	HeapRegion_t xHeapRegions[ 2 ];
+
+		/* The heap is the single region of the ucHeap array. */
+		xHeapRegions[ 0 ].pucStartAddress = ucHeap;
+		xHeapRegions[ 0 ].xSizeInBytes = configTOTAL_HEAP_SIZE;
+		xHeapRegions[ 1 ].pucStartAddress = NULL;
+		xHeapRegions[ 1 ].xSizeInBytes = 0;
+
+		vPortDefineHeapRegions( xHeapRegions );
+	}
+
+#endif /* configHEAP_USE_REGIONS */
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert )
+{
+BlockLink_t *pxIterator;
+uint8_t *puc;
+
+	/* Iterate through the list until a block is found that has a higher address
+	than the block being inserted. */
+	for( pxIterator = &xStart; pxIterator->pxNextFreeBlock < pxBlockToInsert; pxIterator = pxIterator->pxNextFreeBlock )
+	{
+		/* Nothing to do here, just iterate to the right position. */
+	}
+
+	/* Do the block being inserted, and the block it is being inserted after
+	make a contiguous block of memory? */
+	puc = ( uint8_t * ) pxIterator;
+	if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
+	{
+		pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
+		pxBlockToInsert = pxIterator;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Do the block being inserted, and the block it is being inserted before
+	make a contiguous block of memory? */
+	puc = ( uint8_t * ) pxBlockToInsert;
+	if( ( puc + pxBlockToInsert->xBlockSize ) == ( uint8_t * ) pxIterator->pxNextFreeBlock )
+	{
+		if( pxIterator->pxNextFreeBlock != pxEnd )
+		{
+			/* Form one big block from the two blocks. */
+			pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
+			pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
+		}
+		else
+		{
+			pxBlockToInsert->pxNextFreeBlock = pxEnd;
+		}
+	}
+	else
+	{
+		pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
+	}
+
+	/* If the block being inserted plugged a gab, so was merged with the block
+	before and the block after, then it's pxNextFreeBlock pointer will have
+	already been set, and should not be set here as that would make it point
+	to itself. */
+	if( pxIterator != pxBlockToInsert )
+	{
+		pxIterator->pxNextFreeBlock = pxBlockToInsert;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
+{
+BlockLink_t *pxFirstFreeBlockInRegion = NULL, *pxPreviousFreeBlock;
+size_t xAlignedHeap;
+size_t xTotalRegionSize, xTotalHeapSize = 0;
+BaseType_t xDefinedRegions = 0;
+size_t xAddress;
+const HeapRegion_t *pxHeapRegion;
+
+	/* Can only call once, before the first allocation! */
+	configASSERT( pxEnd == NULL );
+
+	pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+
+	while( pxHeapRegion->xSizeInBytes > 0 )
+	{
+		xTotalRegionSize = pxHeapRegion->xSizeInBytes;
+
+		/* The size of a block must leave the allocated bit and the tag bits
+		clear. */
+		configASSERT( ( xTotalRegionSize & ~heapSIZE_BITMASK ) == 0 );
+
+		/* Ensure the heap region starts on a correctly aligned boundary. */
+		xAddress = ( size_t ) pxHeapRegion->pucStartAddress;
+		if( ( xAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+		{
+			xAddress += ( portBYTE_ALIGNMENT - 1 );
+			xAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+			/* Adjust the size for the bytes lost to alignment. */
+			xTotalRegionSize -= xAddress - ( size_t ) pxHeapRegion->pucStartAddress;
+		}
+
+		xAlignedHeap = xAddress;
+
+		/* Set xStart if it has not already been set. */
+		if( xDefinedRegions == 0 )
+		{
+			/* xStart is used to hold a pointer to the first item in the list of
+			free blocks.  The void cast is used to prevent compiler warnings. */
+			xStart.pxNextFreeBlock = ( BlockLink_t * ) xAlignedHeap;
+			xStart.xBlockSize = ( size_t ) 0;
+		}
+		else
+		{
+			/* Should only get here if one region has already been added to the
+			heap. */
+			configASSERT( pxEnd != NULL );
+
+			/* Check blocks are passed in with increasing start addresses. */
+			configASSERT( xAddress > ( size_t ) pxEnd );
+		}
+
+		/* Remember the location of the end marker in the previous region, if
+		any. */
+		pxPreviousFreeBlock = pxEnd;
+
+		/* pxEnd is used to mark the end of the list of free blocks and is
+		inserted at the end of the region space. */
+		xAddress = xAlignedHeap + xTotalRegionSize;
+		xAddress -= heapSTRUCT_SIZE;
+		xAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		pxEnd = ( BlockLink_t * ) xAddress;
+		pxEnd->xBlockSize = 0;
+		pxEnd->pxNextFreeBlock = NULL;
+
+		/* To start with there is a single free block in this region that is
+		sized to take up the entire heap region minus the space taken by the
+		free block structure. */
+		pxFirstFreeBlockInRegion = ( BlockLink_t * ) xAlignedHeap;
+		pxFirstFreeBlockInRegion->xBlockSize = xAddress - ( size_t ) pxFirstFreeBlockInRegion;
+		pxFirstFreeBlockInRegion->pxNextFreeBlock = pxEnd;
+
+		/* If this is not the first region that makes up the entire heap space
+		then link the previous region to this region. */
+		if( pxPreviousFreeBlock != NULL )
+		{
+			pxPreviousFreeBlock->pxNextFreeBlock = pxFirstFreeBlockInRegion;
+		}
+
+		xTotalHeapSize += pxFirstFreeBlockInRegion->xBlockSize;
+
+		/* Move onto the next HeapRegion_t structure. */
+		xDefinedRegions++;
+		pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+	}
+
+	xMinimumEverFreeBytesRemaining = xTotalHeapSize;
+	xFreeBytesRemaining = xTotalHeapSize;
+
+	/* Check something was actually defined before it is accessed. */
+	configASSERT( xTotalHeapSize );
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t *pxHeapStats )
+{
+BlockLink_t *pxBlock;
+size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+size_t xBin;
+
+	vTaskSuspendAll();
+	{
+		pxBlock = xStart.pxNextFreeBlock;
+
+		/* pxBlock will be NULL if the heap has not been initialised.  The heap
+		is initialised automatically when the first allocation is made. */
+		if( pxBlock != NULL )
+		{
+			do
+			{
+				/* The end markers of the regions but the last are in the list,
+				with no size. */
+				if( pxBlock->xBlockSize != 0 )
+				{
+					/* Increment the number of blocks and record the largest
+					block seen so far. */
+					xBlocks++;
+
+					if( pxBlock->xBlockSize > xMaxSize )
+					{
+						xMaxSize = pxBlock->xBlockSize;
+					}
+
+					if( pxBlock->xBlockSize < xMinSize )
+					{
+						xMinSize = pxBlock->xBlockSize;
+					}
+				}
+
+				/* Move to the next block in the chain until the last block is
+				reached. */
+				pxBlock = pxBlock->pxNextFreeBlock;
+			} while( pxBlock != pxEnd );
+		}
+
+		/* The blocks of the bins are free blocks too. */
+		for( xBin = 0; xBin < heapBIN_COUNT; xBin++ )
+		{
+			for( pxBlock = pxBins[ xBin ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+			{
+				xBlocks++;
+
+				if( pxBlock->xBlockSize > xMaxSize )
+				{
+					xMaxSize = pxBlock->xBlockSize;
+				}
+
+				if( pxBlock->xBlockSize < xMinSize )
+				{
+					xMinSize = pxBlock->xBlockSize;
+				}
+			}
+		}
+	}
+	xTaskResumeAll();
+
+	pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+	pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+	pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+	taskENTER_CRITICAL();
+	{
+		pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+		pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+		pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+		pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapTagStats( UBaseType_t uxTag, HeapTagStats_t *pxHeapTagStats )
+{
+	configASSERT( uxTag < configHEAP_TAG_COUNT );
+
+	if( uxTag < configHEAP_TAG_COUNT )
+	{
+		taskENTER_CRITICAL();
+		{
+			*pxHeapTagStats = xTagStats[ uxTag ];
+		}
+		taskEXIT_CRITICAL();
+	}
+	else
+	{
+		memset( pxHeapTagStats, 0, sizeof( *pxHeapTagStats ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapBinStats( HeapBinStats_t *pxHeapBinStats )
+{
+	taskENTER_CRITICAL();
+	{
+		*pxHeapBinStats = xBinStats;
+	}
+	taskEXIT_CRITICAL();
+}
@@ -0,0 +1,581 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright 2026 NXP
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the POSIX port.
+ *
+ * Each task is a pthread, which waits on its semaphore while the task is not
+ * running. A context switch posts the semaphore of the next task and waits on
+ * the semaphore of the current one. The tick (SIGALRM) and the simulated
+ * interrupts (SIGUSR1) are signals that only the running task thread doesn't
+ * block, so the signal handlers run in the running task, as an interrupt
+ * handler runs on the stack of the running task on a Cortex-M.
+ *----------------------------------------------------------*/
+
+/* _GNU_SOURCE for pthread_setname_np(). */
+#ifndef _GNU_SOURCE
+	#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define portSIG_TICK			SIGALRM
+#define portSIG_INTERRUPT		SIGUSR1
+
+/* The task stacks allocated by FreeRTOS only hold the Thread_t of the task:
+the task runs on the stack of its thread. */
+#ifndef configPOSIX_THREAD_STACK_SIZE
+	#define configPOSIX_THREAD_STACK_SIZE	( 256U * 1024U )
+#endif
+
+/* Ticks that are not delivered (the process was stopped) are caught up to at
+most one second. */
+#define portMAX_TICKS_CAUGHT_UP	( ( uint64_t ) configTICK_RATE_HZ )
+
+typedef struct THREAD
+{
+	pthread_t xThread;
+	TaskFunction_t pxCode;
+	void *pvParams;
+	/* The task deleted itself: the thread ends instead of waiting. */
+	volatile BaseType_t xDying;
+	/* Posted when the task is switched in. */
+	sem_t xResume;
+	/* Critical nesting of the task while it is switched out. */
+	UBaseType_t uxCriticalNesting;
+} Thread_t;
+
+/* Critical nesting of the running task. */
+static UBaseType_t uxCriticalNesting = 0;
+
+/* Set in a signal handler: interrupts run in the thread of the running task. */
+static __thread BaseType_t xInsideInterrupt = pdFALSE;
+
+/* Context switch requested from an interrupt, done when it returns. */
+static __thread BaseType_t xPendYield = pdFALSE;
+
+static sigset_t xInterruptSignals;
+static sem_t xSchedulerEnd;
+static volatile uint32_t ulPendingInterrupts = 0;
+static volatile BaseType_t xSchedulerRunning = pdFALSE;
+static uint32_t ( *ulInterruptHandlers[ portMAX_INTERRUPTS ] )( void );
+static uint64_t ullTickStartNs;
+static uint64_t ullTicksElapsed;
+
+/*
+ * The tick and simulated interrupt handler.
+ */
+static void prvSignalHandler( int iSignal );
+
+/*
+ * Entry point of the task threads.
+ */
+static void *prvThreadEntry( void *pvParams );
+
+/*-----------------------------------------------------------*/
+
+static Thread_t *prvGetThreadFromTask( TaskHandle_t xTask )
+{
+	/* pxTopOfStack, the first member of the TCB, points just below the
+	Thread_t, at the top of the stack. */
+	StackType_t *pxTopOfStack = *( StackType_t ** ) xTask;
+
+	return ( Thread_t * ) ( pxTopOfStack + 1 );
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvGetTimeNs( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForResume( Thread_t *pxThread )
+{
+	while( sem_wait( &pxThread->xResume ) != 0 )
+	{
+		/* EINTR: a signal blocked by the thread can't interrupt it, but a
+		debugger or a stop signal can. */
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchThread( Thread_t *pxThreadToResume, Thread_t *pxThreadToSuspend )
+{
+BaseType_t xDying;
+
+	if( pxThreadToResume != pxThreadToSuspend )
+	{
+		/* Once the next task runs, the Thread_t of a task that deleted itself
+		can be freed by the idle task: read it before. */
+		pxThreadToSuspend->uxCriticalNesting = uxCriticalNesting;
+		xDying = pxThreadToSuspend->xDying;
+
+		sem_post( &pxThreadToResume->xResume );
+
+		if( xDying != pdFALSE )
+		{
+			pthread_exit( NULL );
+		}
+
+		prvWaitForResume( pxThreadToSuspend );
+		uxCriticalNesting = pxThreadToSuspend->uxCriticalNesting;
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* Called with interrupts disabled. */
+static void prvSwitchContext( void )
+{
+Thread_t *pxThreadToSuspend;
+Thread_t *pxThreadToResume;
+
+	pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+	vTaskSwitchContext();
+	pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+	prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+}
+/*-----------------------------------------------------------*/
+
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+Thread_t *pxThread;
+pthread_attr_t xAttr;
+sigset_t xOldMask;
+int iRet;
+
+	/* The Thread_t takes the top of the stack, pxTopOfStack is left just
+	below it: see prvGetThreadFromTask(). */
+	pxThread = ( Thread_t * ) ( ( ( portPOINTER_SIZE_TYPE ) ( pxTopOfStack + 1 ) - sizeof( Thread_t ) ) & ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) );
+	pxTopOfStack = ( StackType_t * ) pxThread - 1;
+
+	pxThread->pxCode = pxCode;
+	pxThread->pvParams = pvParameters;
+	pxThread->xDying = pdFALSE;
+	pxThread->uxCriticalNesting = 0;
+	sem_init( &pxThread->xResume, 0, 0 );
+
+	pthread_attr_init( &xAttr );
+	pthread_attr_setstacksize( &xAttr, configPOSIX_THREAD_STACK_SIZE );
+
+	/* The thread starts with the interrupts disabled, which it enables when
+	it first runs. */
+	pthread_sigmask( SIG_BLOCK, &xInterruptSignals, &xOldMask );
+	iRet = pthread_create( &pxThread->xThread, &xAttr, prvThreadEntry, pxThread );
+	pthread_sigmask( SIG_SETMASK, &xOldMask, NULL );
+	pthread_attr_destroy( &xAttr );
+
+	configASSERT( iRet == 0 );
+	( void ) iRet;
+
+	return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvThreadEntry( void *pvParams )
+{
+Thread_t *pxThread = ( Thread_t * ) pvParams;
+
+	prvWaitForResume( pxThread );
+
+	/* Name the thread as its task, for the host debugger and profiler
+	(which truncate it to 15 characters). */
+	{
+	char cName[ 16 ];
+
+		strncpy( cName, pcTaskGetName( NULL ), sizeof( cName ) - 1 );
+		cName[ sizeof( cName ) - 1 ] = '\0';
+		pthread_setname_np( pthread_self(), cName );
+	}
+
+	uxCriticalNesting = 0;
+	pthread_sigmask( SIG_UNBLOCK, &xInterruptSignals, NULL );
+
+	pxThread->pxCode( pxThread->pvParams );
+
+	/* As on a Cortex-M, a task must not return from its function: delete it
+	rather than leaving the scheduler in an undefined state. */
+	configASSERT( pdFALSE );
+	vTaskDelete( NULL );
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+void vPortThreadDying( void *pvTaskToDelete, volatile BaseType_t *pxPendYield )
+{
+Thread_t *pxThread = prvGetThreadFromTask( ( TaskHandle_t ) pvTaskToDelete );
+
+	( void ) pxPendYield;
+
+	/* vTaskDelete() yields once out of its critical section: the thread ends
+	then. */
+	pxThread->xDying = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortCancelThread( void *pvTaskToDelete )
+{
+Thread_t *pxThread = prvGetThreadFromTask( ( TaskHandle_t ) pvTaskToDelete );
+
+	/* A task deleted by another task is waiting on its semaphore, which is a
+	cancellation point. A task that deleted itself has ended, or is about to. */
+	if( pxThread->xDying == pdFALSE )
+	{
+		pthread_cancel( pxThread->xThread );
+	}
+
+	pthread_join( pxThread->xThread, NULL );
+	sem_destroy( &pxThread->xResume );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+struct itimerval xTimer;
+Thread_t *pxFirstThread;
+sigset_t xOldMask;
+
+	/* The calling thread never takes an interrupt. */
+	pthread_sigmask( SIG_BLOCK, &xInterruptSignals, &xOldMask );
+
+	sem_init( &xSchedulerEnd, 0, 0 );
+	xSchedulerRunning = pdTRUE;
+
+	ullTickStartNs = prvGetTimeNs();
+	ullTicksElapsed = 0;
+
+	memset( &xTimer, 0, sizeof( xTimer ) );
+	xTimer.it_interval.tv_usec = 1000000L / configTICK_RATE_HZ;
+	xTimer.it_value = xTimer.it_interval;
+	setitimer( ITIMER_REAL, &xTimer, NULL );
+
+	/* Start the first task. */
+	pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+	sem_post( &pxFirstThread->xResume );
+
+	/* Until vTaskEndScheduler(). */
+	while( sem_wait( &xSchedulerEnd ) != 0 )
+	{
+	}
+
+	pthread_sigmask( SIG_SETMASK, &xOldMask, NULL );
+	sem_destroy( &xSchedulerEnd );
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+struct itimerval xTimer;
+Thread_t *pxThread;
+
+	memset( &xTimer, 0, sizeof( xTimer ) );
+	setitimer( ITIMER_REAL, &xTimer, NULL );
+	xSchedulerRunning = pdFALSE;
+
+	/* The tasks are left waiting on their semaphores: xPortStartScheduler()
+	returns, and so does the calling task, never. */
+	portDISABLE_INTERRUPTS();
+	pxThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+	sem_post( &xSchedulerEnd );
+
+	for( ;; )
+	{
+		prvWaitForResume( pxThread );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+	if( xInsideInterrupt != pdFALSE )
+	{
+		xPendYield = pdTRUE;
+	}
+	else
+	{
+		vPortEnterCritical();
+		prvSwitchContext();
+		vPortExitCritical();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortYieldFromISR( void )
+{
+	/* As the PendSV of a Cortex-M, the switch happens when the interrupt
+	returns. */
+	vPortYield();
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+	pthread_sigmask( SIG_BLOCK, &xInterruptSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+	pthread_sigmask( SIG_UNBLOCK, &xInterruptSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	if( xInsideInterrupt == pdFALSE )
+	{
+		if( uxCriticalNesting == 0 )
+		{
+			vPortDisableInterrupts();
+		}
+
+		uxCriticalNesting++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	if( xInsideInterrupt == pdFALSE )
+	{
+		configASSERT( uxCriticalNesting != 0 );
+		uxCriticalNesting--;
+
+		if( uxCriticalNesting == 0 )
+		{
+			vPortEnableInterrupts();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t xPortSetInterruptMask( void )
+{
+sigset_t xOldMask;
+
+	pthread_sigmask( SIG_BLOCK, &xInterruptSignals, &xOldMask );
+
+	return ( UBaseType_t ) sigismember( &xOldMask, portSIG_TICK );
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( UBaseType_t uxMask )
+{
+	if( uxMask == 0 )
+	{
+		vPortEnableInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortIsInsideInterrupt( void )
+{
+	return xInsideInterrupt;
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetInterruptHandler( uint32_t ulInterruptNumber, uint32_t ( *pvHandler )( void ) )
+{
+	configASSERT( ( ulInterruptNumber > portINTERRUPT_TICK ) && ( ulInterruptNumber < portMAX_INTERRUPTS ) );
+
+	if( ( ulInterruptNumber > portINTERRUPT_TICK ) && ( ulInterruptNumber < portMAX_INTERRUPTS ) )
+	{
+		ulInterruptHandlers[ ulInterruptNumber ] = pvHandler;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortGenerateSimulatedInterrupt( uint32_t ulInterruptNumber )
+{
+	configASSERT( ulInterruptNumber < portMAX_INTERRUPTS );
+
+	if( ulInterruptNumber < portMAX_INTERRUPTS )
+	{
+		__atomic_fetch_or( &ulPendingInterrupts, 1UL << ulInterruptNumber, __ATOMIC_SEQ_CST );
+
+		/* Process directed: delivered to the running task as soon as it
+		enables interrupts. Pending signals are merged, the pending mask is
+		not. */
+		kill( getpid(), portSIG_INTERRUPT );
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortCreateSimulatedDeviceThread( void *( *pvThread )( void * ), void *pvParameter )
+{
+pthread_t xThread;
+sigset_t xOldMask;
+int iRet;
+
+	pthread_sigmask( SIG_BLOCK, &xInterruptSignals, &xOldMask );
+	iRet = pthread_create( &xThread, NULL, pvThread, pvParameter );
+	pthread_sigmask( SIG_SETMASK, &xOldMask, NULL );
+
+	if( iRet != 0 )
+	{
+		return pdFAIL;
+	}
+
+	pthread_detach( xThread );
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSignalHandler( int iSignal )
+{
+int iSavedErrno = errno;
+BaseType_t xSwitchRequired = pdFALSE;
+uint64_t ullTicksDue;
+uint32_t ulPending;
+uint32_t ulInterrupt;
+
+	if( xSchedulerRunning == pdFALSE )
+	{
+		/* Raised before the scheduler started, or after it ended: the
+		interrupts stay pending. */
+		return;
+	}
+
+	xInsideInterrupt = pdTRUE;
+
+	if( iSignal == portSIG_TICK )
+	{
+		/* Timer signals merge while the interrupts are disabled: count the
+		ticks from the clock. */
+		ullTicksDue = ( ( prvGetTimeNs() - ullTickStartNs ) * configTICK_RATE_HZ ) / 1000000000ULL;
+
+		if( ullTicksDue <= ullTicksElapsed )
+		{
+			ullTicksDue = ullTicksElapsed + 1U;
+		}
+		else if( ( ullTicksDue - ullTicksElapsed ) > portMAX_TICKS_CAUGHT_UP )
+		{
+			ullTicksElapsed = ullTicksDue - portMAX_TICKS_CAUGHT_UP;
+		}
+
+		while( ullTicksElapsed < ullTicksDue )
+		{
+			ullTicksElapsed++;
+
+			if( xTaskIncrementTick() != pdFALSE )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+		}
+	}
+
+	ulPending = __atomic_exchange_n( &ulPendingInterrupts, 0U, __ATOMIC_SEQ_CST );
+
+	for( ulInterrupt = 0; ulPending != 0U; ulInterrupt++, ulPending >>= 1 )
+	{
+		if( ( ulPending & 1U ) != 0U )
+		{
+			if( ulInterrupt == portINTERRUPT_YIELD )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+			else if( ( ulInterruptHandlers[ ulInterrupt ] != NULL ) && ( ulInterruptHandlers[ ulInterrupt ]() != pdFALSE ) )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+		}
+	}
+
+	xInsideInterrupt = pdFALSE;
+
+	if( ( xSwitchRequired != pdFALSE ) || ( xPendYield != pdFALSE ) )
+	{
+		xPendYield = pdFALSE;
+		prvSwitchContext();
+	}
+
+	errno = iSavedErrno;
+}
+/*-----------------------------------------------------------*/
+
+void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+{
+sigset_t xOldMask;
+sigset_t xWaitMask;
+
+	( void ) xExpectedIdleTime;
+
+	/* As a Cortex-M waits for an interrupt with the interrupts disabled, so
+	that one that happens before the wait ends the wait. The tick is not
+	stopped: the next one ends the wait at the latest. */
+	pthread_sigmask( SIG_BLOCK, &xInterruptSignals, &xOldMask );
+
+	if( eTaskConfirmSleepModeStatus() != eAbortSleep )
+	{
+		xWaitMask = xOldMask;
+		sigdelset( &xWaitMask, portSIG_TICK );
+		sigdelset( &xWaitMask, portSIG_INTERRUPT );
+		sigsuspend( &xWaitMask );
+	}
+
+	pthread_sigmask( SIG_SETMASK, &xOldMask, NULL );
+}
+/*-----------------------------------------------------------*/
+
+/* Run before main(), so that the signals are handled before a task, or a
+simulated device, is created. */
+static void __attribute__( ( constructor ) ) prvPortInit( void )
+{
+struct sigaction xAction;
+
+	sigemptyset( &xInterruptSignals );
+	sigaddset( &xInterruptSignals, portSIG_TICK );
+	sigaddset( &xInterruptSignals, portSIG_INTERRUPT );
+
+	memset( &xAction, 0, sizeof( xAction ) );
+	xAction.sa_handler = prvSignalHandler;
+	xAction.sa_mask = xInterruptSignals;
+	xAction.sa_flags = SA_RESTART;
+	sigaction( portSIG_TICK, &xAction, NULL );
+	sigaction( portSIG_INTERRUPT, &xAction, NULL );
+}
@@ -0,0 +1,164 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright 2026 NXP
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*-----------------------------------------------------------
+ * Port specific definitions for running FreeRTOS as a POSIX (Linux) process.
+ *
+ * Every task runs in its own pthread, and only the thread of the running
+ * task is ever let through: the others wait on a semaphore. Interrupts are
+ * POSIX signals, which only the running task thread doesn't block:
+ * - SIGALRM, from an interval timer, is the tick interrupt.
+ * - SIGUSR1 delivers the simulated interrupts that threads outside FreeRTOS
+ *   (simulated devices) raise with vPortGenerateSimulatedInterrupt().
+ * Disabling interrupts blocks these signals in the running thread.
+ *
+ * Threads created outside FreeRTOS must block SIGALRM and SIGUSR1, which
+ * they do if they are created by a task in a critical section, or by
+ * xPortCreateSimulatedDeviceThread().
+ *
+ * The task stacks allocated by FreeRTOS are not used as the thread stacks,
+ * so that any C library function can be called from a task. But a task that
+ * is switched out while the C library holds a lock (stdio, malloc) blocks
+ * the next task that wants it: such calls must be made in a critical section
+ * or with the scheduler suspended.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions. */
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	unsigned long
+#define portBASE_TYPE	long
+#define portPOINTER_SIZE_TYPE uintptr_t
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+/* The same tick type as the Cortex-M ports, so that the code above the kernel
+behaves the same on the host and on the target. */
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef uint16_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffff
+#else
+	typedef uint32_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+	#define portTICK_TYPE_IS_ATOMIC 1
+#endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+#define portNOP()
+#define portMEMORY_BARRIER()		__sync_synchronize()
+/*-----------------------------------------------------------*/
+
+/* Scheduler utilities. */
+extern void vPortYield( void );
+extern void vPortYieldFromISR( void );
+
+#define portYIELD()									vPortYield()
+#define portEND_SWITCHING_ISR( xSwitchRequired )	if( xSwitchRequired != pdFALSE ) vPortYieldFromISR()
+#define portYIELD_FROM_ISR( x )						portEND_SWITCHING_ISR( x )
+/*-----------------------------------------------------------*/
+
+/* Critical section management. */
+extern void vPortEnterCritical( void );
+extern void vPortExitCritical( void );
+extern void vPortDisableInterrupts( void );
+extern void vPortEnableInterrupts( void );
+extern UBaseType_t xPortSetInterruptMask( void );
+extern void vPortClearInterruptMask( UBaseType_t uxMask );
+extern BaseType_t xPortIsInsideInterrupt( void );
+
+#define portSET_INTERRUPT_MASK_FROM_ISR()		xPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vPortClearInterruptMask(x)
+#define portDISABLE_INTERRUPTS()				vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()					vPortEnableInterrupts()
+#define portENTER_CRITICAL()					vPortEnterCritical()
+#define portEXIT_CRITICAL()						vPortExitCritical()
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+/*-----------------------------------------------------------*/
+
+/* Task deletion: the thread of a task ends with the task. */
+extern void vPortThreadDying( void *pvTaskToDelete, volatile BaseType_t *pxPendYield );
+extern void vPortCancelThread( void *pvTaskToDelete );
+#define portPRE_TASK_DELETE_HOOK( pvTaskToDelete, pxPendYield ) vPortThreadDying( ( pvTaskToDelete ), ( pxPendYield ) )
+#define portCLEAN_UP_TCB( pxTCB ) vPortCancelThread( pxTCB )
+/*-----------------------------------------------------------*/
+
+/* With configUSE_TICKLESS_IDLE, the idle task waits for the next signal, as a
+Cortex-M waits for an interrupt, instead of spinning. The tick keeps going. */
+#ifndef portSUPPRESS_TICKS_AND_SLEEP
+	extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+/*-----------------------------------------------------------*/
+
+/* The generic task selection: there is no count leading zeros to rely on. */
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+/*-----------------------------------------------------------*/
+
+/* Simulated interrupts, numbered as in the Win32 port: the first two are used
+by the port, the application has the others. A handler runs in the thread of
+the running task, with interrupts disabled, and returns pdTRUE when a context
+switch is required. */
+#define portINTERRUPT_YIELD			( 0UL )
+#define portINTERRUPT_TICK			( 1UL )
+#define portMAX_INTERRUPTS			( 32UL )
+
+extern void vPortSetInterruptHandler( uint32_t ulInterruptNumber, uint32_t ( *pvHandler )( void ) );
+/* Can be called from any thread, inside or outside FreeRTOS. */
+extern void vPortGenerateSimulatedInterrupt( uint32_t ulInterruptNumber );
+/* Create a thread outside FreeRTOS (a simulated device), which never receives
+the tick or the simulated interrupts. Returns pdPASS on success. */
+extern BaseType_t xPortCreateSimulatedDeviceThread( void *( *pvThread )( void * ), void *pvParameter );
+/*-----------------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */